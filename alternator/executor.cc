@@ -20,6 +20,7 @@
 #include "service/client_state.hh"
 #include "timestamp.hh"
 #include "types/map.hh"
+#include "types/listlike_partial_deserializing_iterator.hh"
 #include "schema/schema.hh"
 #include "query-request.hh"
 #include "query-result-reader.hh"
@@ -2611,6 +2612,20 @@ static std::optional<attrs_to_get> calculate_attrs_to_get(const rjson::value& re
  * Explicit bool means we can be sure all previous calls are 
  * as before.
  */ 
+// Calls func(attr_name, serialized_value) for each attribute in the serialized
+// ATTRS_COLUMN_NAME map of a result row. Unlike deserializing the map with
+// attrs_type(), it doesn't copy the names and values of all the attributes,
+// most of which are serialized again into JSON right away.
+template <typename Func>
+static void for_each_attr(bytes_view serialized_attrs, Func&& func) {
+    const int count = read_collection_size(serialized_attrs);
+    for (int i = 0; i < count; ++i) {
+        auto name = read_collection_key(serialized_attrs);
+        auto value = read_collection_value_nonnull(serialized_attrs);
+        func(std::string_view(reinterpret_cast<const char*>(name.data()), name.size()), value);
+    }
+}
+
 void executor::describe_single_item(const cql3::selection::selection& selection,
     const std::vector<managed_bytes_opt>& result_row,
     const std::optional<attrs_to_get>& attrs_to_get,
@@ -2632,29 +2647,29 @@ void executor::describe_single_item(const cql3::selection::selection& selection,
                 });
             }
         } else if (cell) {
-            auto deserialized = attrs_type()->deserialize(*cell);
-            auto keys_and_values = value_cast<map_type_impl::native_type>(deserialized);
-            for (auto entry : keys_and_values) {
-                std::string attr_name = value_cast<sstring>(entry.first);
-                if (include_all_embedded_attributes || !attrs_to_get || attrs_to_get->contains(attr_name)) {
-                    bytes value = value_cast<bytes>(entry.second);
-                    rjson::value v = deserialize_item(value);
-                    if (attrs_to_get) {
-                        auto it = attrs_to_get->find(attr_name);
-                        if (it != attrs_to_get->end()) {
-                            // attrs_to_get may have asked for only part of
-                            // this attribute. hierarchy_filter() modifies v,
-                            // and returns false when nothing is to be kept.
-                            if (!hierarchy_filter(v, it->second)) {
-                                continue;
-                            }
-                        }
+          cell->with_linearized([&] (bytes_view linearized_cell) {
+            for_each_attr(linearized_cell, [&] (std::string_view attr_name, bytes_view value) {
+                const attrs_to_get_node* node = nullptr;
+                if (attrs_to_get) {
+                    auto it = attrs_to_get->find(std::string(attr_name));
+                    if (it != attrs_to_get->end()) {
+                        node = &it->second;
+                    } else if (!include_all_embedded_attributes) {
+                        return;
                     }
-                    // item is expected to start empty, and attribute
-                    // names are unique so add() makes sense
-                    rjson::add_with_string_name(item, attr_name, std::move(v));
                 }
-            }
+                rjson::value v = deserialize_item(value);
+                // attrs_to_get may have asked for only part of
+                // this attribute. hierarchy_filter() modifies v,
+                // and returns false when nothing is to be kept.
+                if (node && !hierarchy_filter(v, *node)) {
+                    return;
+                }
+                // item is expected to start empty, and attribute
+                // names are unique so add() makes sense
+                rjson::add_with_string_name(item, attr_name, std::move(v));
+            });
+          });
         }
         ++column_it;
     }
@@ -3859,21 +3874,21 @@ class describe_items_visitor {
                     rjson::add_with_string_name(field, type_to_string((*_column_it)->type), json_key_column_value(bv, **_column_it));
                 }
             } else {
-                auto deserialized = attrs_type()->deserialize(bv);
-                auto keys_and_values = value_cast<map_type_impl::native_type>(deserialized);
-                for (auto entry : keys_and_values) {
-                    std::string attr_name = value_cast<sstring>(entry.first);
-                    if (!_attrs_to_get || _attrs_to_get->contains(attr_name) || _extra_filter_attrs.contains(attr_name)) {
-                        bytes value = value_cast<bytes>(entry.second);
-                        // Even if _attrs_to_get asked to keep only a part of a
-                        // top-level attribute, we keep the entire attribute
-                        // at this stage, because the item filter might still
-                        // need the other parts (it was easier for us to keep
-                        // extra_filter_attrs at top-level granularity). We'll
-                        // filter the unneeded parts after item filtering.
-                        rjson::add_with_string_name(_item, attr_name, deserialize_item(value));
+                for_each_attr(bv, [this] (std::string_view attr_name, bytes_view value) {
+                    if (_attrs_to_get) {
+                        std::string name(attr_name);
+                        if (!_attrs_to_get->contains(name) && !_extra_filter_attrs.contains(name)) {
+                            return;
+                        }
                     }
-                }
+                    // Even if _attrs_to_get asked to keep only a part of a
+                    // top-level attribute, we keep the entire attribute
+                    // at this stage, because the item filter might still
+                    // need the other parts (it was easier for us to keep
+                    // extra_filter_attrs at top-level granularity). We'll
+                    // filter the unneeded parts after item filtering.
+                    rjson::add_with_string_name(_item, attr_name, deserialize_item(value));
+                });
             }
         });
         ++_column_it;
@@ -986,6 +986,9 @@ future<executor::request_return_type> executor::get_records(client_state& client
                 rjson::add(dynamodb, op == cdc::operation::pre_image ? "OldImage" : "NewImage", std::move(item));
                 break;
             }
+            case cdc::operation::pre_image_unknown:
+                // No OldImage to report.
+                break;
             case cdc::operation::update:
                 rjson::add(record, "eventName", "MODIFY");
                 break;
@@ -1033,12 +1036,19 @@ future<executor::request_return_type> executor::get_records(client_state& client
                 // "set to null". Our test test_streams_closed_read
                 // confirms that by "null" they meant not set at all.
             } else {
-                // We could have return the same iterator again, but we did
-                // a search from it until high_ts and found nothing, so we
-                // can also start the next search from high_ts.
-                // TODO: but why? It's simpler just to leave the iterator be.
-                shard_iterator next_iter(iter.table, iter.shard, utils::UUID_gen::min_time_UUID(high_ts.time_since_epoch()), true);
-                rjson::add(ret, "NextShardIterator", iter);
+                // We did a search from the iterator until high_ts and found
+                // nothing, and nothing older than high_ts can still be
+                // written, so the next search starts from high_ts. Returning
+                // the same iterator instead would have each poll of an idle
+                // shard read again the whole window since the last record,
+                // with all the expired rows and tombstones in it.
+                auto high_uuid = utils::UUID_gen::min_time_UUID(high_ts.time_since_epoch());
+                if (!iter.threshold.is_null() && utils::timeuuid_tri_compare(iter.threshold, high_uuid) >= 0) {
+                    rjson::add(ret, "NextShardIterator", iter);
+                } else {
+                    shard_iterator next_iter(iter.table, iter.shard, high_uuid, true);
+                    rjson::add(ret, "NextShardIterator", next_iter);
+                }
             }
             _stats.api_operations.get_records_latency.mark(std::chrono::steady_clock::now() - start_time);
             if (is_big(ret)) {
@@ -251,10 +251,9 @@ static future<> expire_item(service::storage_proxy& proxy,
                             schema_ptr schema,
                             api::timestamp_type ts) {
     // Prepare the row key to delete
-    // NOTICE: the order of columns is guaranteed by the fact that selection::wildcard
-    // is used, which indicates that columns appear in the order defined by
-    // schema::all_columns_in_select_order() - partition key columns goes first,
-    // immediately followed by clustering key columns
+    // NOTICE: the order of columns is guaranteed by the selection built by
+    // scan_ranges_context - partition key columns goes first, immediately
+    // followed by clustering key columns
     std::vector<bytes> exploded_pk;
     const unsigned pk_size = schema->partition_key_size();
     const unsigned ck_size = schema->clustering_key_size();
@@ -514,17 +513,26 @@ struct scan_ranges_context {
         , member(member)
         , internal_client_state(service::client_state::internal_tag())
     {
-        // FIXME: don't read the entire items - read only parts of it.
-        // We must read the key columns (to be able to delete) and also
-        // the requested attribute. If the requested attribute is a map's
-        // member we may be forced to read the entire map - but it would
-        // be good if we can read only the single item of the map - it
-        // should be possible (and a must for issue #7751!).
+        // Read only the key columns (to be able to delete) and the column
+        // holding the expiration time, rather than the entire items.
+        // FIXME: If the requested attribute is a map's member we are forced
+        // to read the entire map - but it would be good if we can read only
+        // the single item of the map - it should be possible (and a must for
+        // issue #7751!).
         lw_shared_ptr<service::pager::paging_state> paging_state = nullptr;
-        auto regular_columns =
-            s->regular_columns() | std::views::transform([] (const column_definition& cdef) { return cdef.id; })
-            | std::ranges::to<query::column_id_vector>();
-        selection = cql3::selection::selection::wildcard(s);
+        std::vector<const column_definition*> columns;
+        for (const column_definition& cdef : s->partition_key_columns()) {
+            columns.push_back(&cdef);
+        }
+        for (const column_definition& cdef : s->clustering_key_columns()) {
+            columns.push_back(&cdef);
+        }
+        query::column_id_vector regular_columns;
+        if (const column_definition* cdef = s->get_column_definition(column_name); cdef && cdef->is_regular()) {
+            columns.push_back(cdef);
+            regular_columns.push_back(cdef->id);
+        }
+        selection = cql3::selection::selection::for_columns(s, std::move(columns));
         query::partition_slice::option_set opts = selection->get_query_options();
         opts.set<query::partition_slice::option::allow_short_read>();
         // It is important that the scan bypass cache to avoid polluting it:
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include "db/system_keyspace.hh"
 #include "db/data_listeners.hh"
+#include "db/hot_key_sampler.hh"
 #include "storage_service.hh"
 #include "compaction/compaction_manager.hh"
 #include "unimplemented.hh"
@@ -1122,6 +1123,40 @@ void set_column_family(http_context& ctx, routes& r, sharded<db::system_keyspace
         });
     });
 
+    cf::get_hot_partitions.set(r, [&ctx] (std::unique_ptr<http::request> req) -> future<json::json_return_type> {
+        auto uuid = get_uuid(req->get_path_param("name"), ctx.db.local());
+        api::req_param<unsigned> list_size(*req, "list_size", 10);
+
+        using entries = db::hot_key_sampler::entries;
+        // A partition is sampled on its owning shard only, so the per-shard lists can simply be concatenated.
+        auto [reads, writes] = co_await ctx.db.map_reduce0([uuid, k = list_size.value] (replica::database& db) {
+            auto& hot_keys = db.find_column_family(uuid).get_stats().hot_keys;
+            return std::make_pair(hot_keys.top_reads(k), hot_keys.top_writes(k));
+        }, std::make_pair(entries(), entries()), [] (std::pair<entries, entries> a, std::pair<entries, entries> b) {
+            std::move(b.first.begin(), b.first.end(), std::back_inserter(a.first));
+            std::move(b.second.begin(), b.second.end(), std::back_inserter(a.second));
+            return a;
+        });
+
+        auto to_records = [k = list_size.value] (entries& e, json::json_list<cf::toppartitions_record>& out) {
+            std::ranges::sort(e, std::greater<>(), &db::hot_key_sampler::entry::count);
+            e.resize(std::min<size_t>(e.size(), k));
+            for (auto& d : e) {
+                cf::toppartitions_record r;
+                r.partition = d.partition;
+                r.count = d.count;
+                r.error = d.error;
+                out.push(r);
+            }
+        };
+        cf::toppartitions_query_results results;
+        results.read_cardinality = reads.size();
+        results.write_cardinality = writes.size();
+        to_records(reads, results.read);
+        to_records(writes, results.write);
+        co_return results;
+    });
+
     cf::force_major_compaction.set(r, [&ctx](std::unique_ptr<http::request> req) -> future<json::json_return_type> {
         auto params = req_params({
             std::pair("name", mandatory::yes),
@@ -1265,6 +1300,7 @@ void unset_column_family(http_context& ctx, routes& r) {
     cf::get_sstable_count_per_level.unset(r);
     cf::get_sstables_for_key.unset(r);
     cf::toppartitions.unset(r);
+    cf::get_hot_partitions.unset(r);
     cf::force_major_compaction.unset(r);
 }
 }
@@ -27,6 +27,16 @@ void set_lsa(http_context& ctx, routes& r) {
             return json::json_return_type(json::json_void());
         });
     });
+
+    httpd::lsa_json::get_synchronous_reclaims.set(r, [](std::unique_ptr<request> req) {
+        return seastar::map_reduce(smp::all_cpus(), [] (unsigned shard) {
+            return smp::submit_to(shard, [] {
+                return logalloc::shard_tracker().statistics().synchronous_reclaims;
+            });
+        }, uint64_t(0), std::plus<uint64_t>()).then([] (uint64_t reclaims) {
+            return json::json_return_type(reclaims);
+        });
+    });
 }
 
 }
@@ -1182,6 +1182,8 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
         res.ttl = tracing::tracing::get_local_tracing_instance().slow_query_record_ttl().count() ;
         res.threshold = tracing::tracing::get_local_tracing_instance().slow_query_threshold().count();
         res.fast = tracing::tracing::get_local_tracing_instance().ignore_trace_events_enabled();
+        res.max_events = tracing::tracing::get_local_tracing_instance().slow_query_max_events();
+        res.failures = tracing::tracing::get_local_tracing_instance().slow_query_log_failures_enabled();
         return res;
     });
 
@@ -1190,9 +1192,11 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
         auto ttl = req->get_query_param("ttl");
         auto threshold = req->get_query_param("threshold");
         auto fast = req->get_query_param("fast");
-        apilog.info("set_slow_query: enable={} ttl={} threshold={} fast={}", enable, ttl, threshold, fast);
+        auto max_events = req->get_query_param("max_events");
+        auto failures = req->get_query_param("failures");
+        apilog.info("set_slow_query: enable={} ttl={} threshold={} fast={} max_events={} failures={}", enable, ttl, threshold, fast, max_events, failures);
         try {
-            return tracing::tracing::tracing_instance().invoke_on_all([enable, ttl, threshold, fast] (auto& local_tracing) {
+            return tracing::tracing::tracing_instance().invoke_on_all([enable, ttl, threshold, fast, max_events, failures] (auto& local_tracing) {
                 if (threshold != "") {
                     local_tracing.set_slow_query_threshold(std::chrono::microseconds(std::stol(threshold.c_str())));
                 }
@@ -1205,6 +1209,12 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
                 if (fast != "") {
                     local_tracing.set_ignore_trace_events(strcasecmp(fast.c_str(), "true") == 0);
                 }
+                if (max_events != "") {
+                    local_tracing.set_slow_query_max_events(std::stoul(max_events.c_str()));
+                }
+                if (failures != "") {
+                    local_tracing.set_slow_query_log_failures(strcasecmp(failures.c_str(), "true") == 0);
+                }
             }).then([] {
                 return make_ready_future<json::json_return_type>(json_void());
             });
@@ -1786,13 +1796,14 @@ void set_snapshot(http_context& ctx, routes& r, sharded<db::snapshot_ctl>& snap_
         auto bucket = req->get_query_param("bucket");
         auto prefix = req->get_query_param("prefix");
         auto snapshot_name = req->get_query_param("snapshot");
+        auto base_prefix = req->get_query_param("base_prefix");
         if (snapshot_name.empty()) {
             // TODO: If missing, snapshot should be taken by scylla, then removed
             throw httpd::bad_param_exception("The snapshot name must be specified");
         }
 
         auto& ctl = snap_ctl.local();
-        auto task_id = co_await ctl.start_backup(std::move(endpoint), std::move(bucket), std::move(prefix), std::move(keyspace), std::move(table), std::move(snapshot_name));
+        auto task_id = co_await ctl.start_backup(std::move(endpoint), std::move(bucket), std::move(prefix), std::move(keyspace), std::move(table), std::move(snapshot_name), std::move(base_prefix));
         co_return json::json_return_type(fmt::to_string(task_id));
     });
 
@@ -6,14 +6,19 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include "api/api.hh"
 #include "api/api_init.hh"
 #include "api/api-doc/system.json.hh"
 #include "api/api-doc/metrics.json.hh"
 #include "replica/database.hh"
 #include "sstables/sstables_manager.hh"
 
+#include <ranges>
 #include <rapidjson/document.h>
+#include <seastar/core/internal/cpu_profiler.hh>
 #include <seastar/core/reactor.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/core/metrics_api.hh>
 #include <seastar/core/relabel_config.hh>
 #include <seastar/http/exception.hh>
@@ -34,6 +39,125 @@ extern "C" void __attribute__((weak)) __llvm_profile_dump();
 extern "C" const char * __attribute__((weak)) __llvm_profile_get_filename();
 extern "C" void __attribute__((weak)) __llvm_profile_reset_counters();
 
+// The time spent by a scheduling group, from the metrics of the scheduler.
+struct scheduling_group_times {
+    uint64_t runtime_ms = 0;
+    uint64_t tasks_processed = 0;
+    uint64_t task_quota_violations_ms = 0;
+    uint64_t waittime_ms = 0;
+    uint64_t starvetime_ms = 0;
+};
+
+using scheduling_group_times_map = std::unordered_map<sstring, scheduling_group_times>;
+
+static scheduling_group_times_map get_scheduling_group_times() {
+    scheduling_group_times_map ret;
+    const auto& values = seastar::metrics::impl::get_value_map();
+    auto add = [&] (std::string_view metric, uint64_t scheduling_group_times::* field) {
+        auto family = values.find(sstring("scheduler_") + metric);
+        if (family == values.end()) {
+            return;
+        }
+        for (const auto& [labels, registered_metric] : family->second) {
+            ret[labels.at("group")].*field += (*registered_metric)().ui();
+        }
+    };
+    add("runtime_ms", &scheduling_group_times::runtime_ms);
+    add("tasks_processed", &scheduling_group_times::tasks_processed);
+    add("time_spent_on_task_quota_violations_ms", &scheduling_group_times::task_quota_violations_ms);
+    add("waittime_ms", &scheduling_group_times::waittime_ms);
+    add("starvetime_ms", &scheduling_group_times::starvetime_ms);
+    return ret;
+}
+
+struct reactor_profile {
+    scheduling_group_times_map groups;
+    // Folded backtraces, outermost frame first, to their number of samples.
+    std::unordered_map<sstring, uint64_t> stacks;
+    uint64_t samples = 0;
+    uint64_t dropped_samples = 0;
+
+    reactor_profile& operator+=(reactor_profile&& o) {
+        for (auto& [name, t] : o.groups) {
+            auto& mine = groups[name];
+            mine.runtime_ms += t.runtime_ms;
+            mine.tasks_processed += t.tasks_processed;
+            mine.task_quota_violations_ms += t.task_quota_violations_ms;
+            mine.waittime_ms += t.waittime_ms;
+            mine.starvetime_ms += t.starvetime_ms;
+        }
+        for (auto& [stack, count] : o.stacks) {
+            stacks[stack] += count;
+        }
+        samples += o.samples;
+        dropped_samples += o.dropped_samples;
+        return *this;
+    }
+};
+
+static sstring fold_backtrace(const simple_backtrace& bt) {
+    sstring ret;
+    for (const auto& f : bt.frames() | std::views::reverse) {
+        if (!ret.empty()) {
+            ret += ";";
+        }
+        ret += f.so->name.empty() ? fmt::format("{:#x}", f.addr) : fmt::format("{}+{:#x}", f.so->name, f.addr);
+    }
+    return ret;
+}
+
+// Profiling changes the settings of the cpu profiler of the reactors, so
+// only one profiling can run at a time. Used on shard 0 only.
+static thread_local semaphore reactor_profile_sem(1);
+
+static future<reactor_profile> profile_reactors(std::chrono::milliseconds duration, std::chrono::microseconds sample_period) {
+    auto units = try_get_units(reactor_profile_sem, 1);
+    if (!units) {
+        throw httpd::bad_request_exception("Reactor profiling is already in progress");
+    }
+
+    std::vector<scheduling_group_times_map> start_times(smp::count);
+    co_await smp::invoke_on_all([&] {
+        start_times[this_shard_id()] = get_scheduling_group_times();
+        if (sample_period.count()) {
+            std::vector<cpu_profiler_trace> discarded;
+            engine().profiler_results(discarded);
+            engine().set_cpu_profiler_period(sample_period);
+            engine().set_cpu_profiler_enabled(true);
+        }
+    });
+
+    co_await seastar::sleep(duration);
+
+    reactor_profile ret;
+    for (unsigned shard = 0; shard < smp::count; ++shard) {
+        ret += co_await smp::submit_to(shard, [&start = start_times[shard], sample_period] {
+            reactor_profile p;
+            p.groups = get_scheduling_group_times();
+            for (auto& [name, t] : p.groups) {
+                if (auto it = start.find(name); it != start.end()) {
+                    t.runtime_ms -= it->second.runtime_ms;
+                    t.tasks_processed -= it->second.tasks_processed;
+                    t.task_quota_violations_ms -= it->second.task_quota_violations_ms;
+                    t.waittime_ms -= it->second.waittime_ms;
+                    t.starvetime_ms -= it->second.starvetime_ms;
+                }
+            }
+            if (sample_period.count()) {
+                engine().set_cpu_profiler_enabled(false);
+                std::vector<cpu_profiler_trace> traces;
+                p.dropped_samples = engine().profiler_results(traces);
+                p.samples = traces.size();
+                for (const auto& trace : traces) {
+                    ++p.stacks[fold_backtrace(trace.user_backtrace)];
+                }
+            }
+            return p;
+        });
+    }
+    co_return ret;
+}
+
 void set_system(http_context& ctx, routes& r) {
     hm::get_metrics_config.set(r, [](const_req req) {
         std::vector<hm::metrics_config> res;
@@ -184,6 +308,39 @@ void set_system(http_context& ctx, routes& r) {
         return make_ready_future<json::json_return_type>(json::json_return_type(json::json_void()));
     }) ;
 
+    hs::get_reactor_profile.set(r, [] (std::unique_ptr<request> req) -> future<json::json_return_type> {
+        api::req_param<std::chrono::milliseconds, unsigned> duration{*req, "duration", std::chrono::milliseconds(10000)};
+        api::req_param<std::chrono::microseconds, unsigned> sample_period{*req, "sample_period", std::chrono::microseconds(1000)};
+
+        apilog.info("Profiling the reactors for {}ms with a sample period of {}us", duration.value.count(), sample_period.value.count());
+        auto profile = co_await smp::submit_to(0, [duration = duration.value, sample_period = sample_period.value] {
+            return profile_reactors(duration, sample_period);
+        });
+
+        hs::reactor_profile res;
+        res.duration_ms = duration.value.count();
+        res.shards = smp::count;
+        res.samples = profile.samples;
+        res.dropped_samples = profile.dropped_samples;
+        for (const auto& [name, t] : profile.groups) {
+            hs::scheduling_group_profile g;
+            g.name = name;
+            g.runtime_ms = t.runtime_ms;
+            g.tasks_processed = t.tasks_processed;
+            g.task_quota_violations_ms = t.task_quota_violations_ms;
+            g.waittime_ms = t.waittime_ms;
+            g.starvetime_ms = t.starvetime_ms;
+            res.scheduling_groups.push(g);
+        }
+        for (const auto& [stack, count] : profile.stacks) {
+            hs::folded_stack f;
+            f.stack = stack;
+            f.count = count;
+            res.stacks.push(f);
+        }
+        co_return res;
+    });
+
     hs::get_highest_supported_sstable_version.set(r, [&ctx] (const_req req) {
         auto& table = ctx.db.local().find_column_family("system", "local");
         return seastar::to_sstring(table.get_sstables_manager().get_highest_supported_format());
@@ -31,6 +31,7 @@
 #include "replica/database.hh"
 #include "cql3/query_processor.hh"
 #include "db/config.hh"
+#include "utils/hashers.hh"
 
 namespace auth {
 
@@ -70,7 +71,14 @@ password_authenticator::password_authenticator(cql3::query_processor& qp, ::serv
     , _migration_manager(mm)
     , _stopped(make_ready_future<>()) 
     , _superuser(default_superuser(qp.db().get_config()))
-{}
+    , _hashing_worker("pwd-hashing", 10, plogger)
+{
+    std::random_device rd;
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (char& c : _digest_key) {
+        c = dist(rd);
+    }
+}
 
 static bool has_salted_hash(const cql3::untyped_result_set_row& row) {
     return !row.get_or<sstring>(SALTED_HASH, "").empty();
@@ -208,6 +216,49 @@ authentication_option_set password_authenticator::alterable_options() const {
     return authentication_option_set{authentication_option::password};
 }
 
+password_authenticator::credentials_digest password_authenticator::digest_credentials(const sstring& password, const sstring& salted_hash) const {
+    sha256_hasher h;
+    h.update(_digest_key.data(), _digest_key.size());
+    h.update(salted_hash.data(), salted_hash.size());
+    // Both are null-terminated, which keeps them apart.
+    h.update(salted_hash.c_str() + salted_hash.size(), 1);
+    h.update(password.data(), password.size());
+    return h.finalize_array();
+}
+
+future<bool> password_authenticator::check_password(const sstring& role_name, const sstring& password, const sstring& salted_hash) const {
+    const auto& cfg = _qp.db().get_config();
+    const auto validity = std::chrono::milliseconds(cfg.credentials_validity_in_ms());
+    const size_t max_entries = cfg.credentials_cache_max_entries();
+    if (validity == std::chrono::milliseconds(0) || max_entries == 0) {
+        _verified_credentials.clear();
+        co_return co_await _hashing_worker.submit([&] { return passwords::check(password, salted_hash); });
+    }
+
+    const auto digest = digest_credentials(password, salted_hash);
+    if (auto it = _verified_credentials.find(role_name); it != _verified_credentials.end()) {
+        if (it->second.digest == digest && it->second.expiry > lowres_clock::now()) {
+            co_return true;
+        }
+        _verified_credentials.erase(it);
+    }
+
+    // Failed attempts aren't remembered, so that guessing passwords stays expensive.
+    if (!co_await _hashing_worker.submit([&] { return passwords::check(password, salted_hash); })) {
+        co_return false;
+    }
+
+    const auto now = lowres_clock::now();
+    if (_verified_credentials.size() >= max_entries) {
+        std::erase_if(_verified_credentials, [now] (const auto& e) { return e.second.expiry <= now; });
+        if (_verified_credentials.size() >= max_entries) {
+            _verified_credentials.clear();
+        }
+    }
+    _verified_credentials.insert_or_assign(role_name, verified_credentials{digest, now + validity});
+    co_return true;
+}
+
 future<authenticated_user> password_authenticator::authenticate(
                 const credentials_map& credentials) const {
     if (!credentials.contains(USERNAME_KEY)) {
@@ -222,7 +273,7 @@ future<authenticated_user> password_authenticator::authenticate(
 
     try {
         const std::optional<sstring> salted_hash = co_await get_password_hash(username);
-        if (!salted_hash || !passwords::check(password, *salted_hash)) {
+        if (!salted_hash || !co_await check_password(username, password, *salted_hash)) {
             throw exceptions::authentication_exception("Username and/or password are incorrect");
         }
         co_return username;
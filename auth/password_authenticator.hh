@@ -10,11 +10,16 @@
 
 #pragma once
 
+#include <array>
+#include <unordered_map>
+
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/lowres_clock.hh>
 
 #include "db/consistency_level_type.hh"
 #include "auth/authenticator.hh"
 #include "service/raft/raft_group0_client.hh"
+#include "utils/alien_worker.hh"
 
 namespace db {
     class config;
@@ -42,6 +47,21 @@ class password_authenticator : public authenticator {
     abort_source _as;
     std::string _superuser;
 
+    // Hashing a password takes milliseconds of CPU on purpose, so it is done
+    // off the reactor.
+    mutable utils::alien_worker _hashing_worker;
+
+    using credentials_digest = std::array<uint8_t, 32>;
+    struct verified_credentials {
+        credentials_digest digest;
+        lowres_clock::time_point expiry;
+    };
+    // The roles whose password was recently verified, so that a storm of
+    // reconnections doesn't hash each one again. Only a keyed digest of the
+    // password and its salted hash is kept: a changed password doesn't match.
+    mutable std::unordered_map<sstring, verified_credentials> _verified_credentials;
+    std::array<char, 16> _digest_key;
+
 public:
     static db::consistency_level consistency_for_user(std::string_view role_name);
     static std::string default_superuser(const db::config&);
@@ -88,6 +108,10 @@ class password_authenticator : public authenticator {
     future<> create_default_if_missing();
 
     sstring update_row_query() const;
+
+    credentials_digest digest_credentials(const sstring& password, const sstring& salted_hash) const;
+
+    future<bool> check_password(const sstring& role_name, const sstring& password, const sstring& salted_hash) const;
 };
 
 }
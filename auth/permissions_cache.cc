@@ -18,20 +18,48 @@ permissions_cache::permissions_cache(const utils::loading_cache_config& c, servi
         : _cache(c, log, [&ser, &log](const key_type& k) {
               log.debug("Refreshing permissions for {}", k.first);
               return ser.get_uncached_permissions(k.first, k.second);
-          }) {
+          })
+        , _snapshot_timer([this] { drop_snapshot(); }) {
+    configure_snapshot(c);
+}
+
+void permissions_cache::drop_snapshot() noexcept {
+    _snapshot.clear();
+    ++_snapshot_generation;
+}
+
+void permissions_cache::configure_snapshot(const utils::loading_cache_config& c) {
+    drop_snapshot();
+    _snapshot_timer.cancel();
+    // The snapshot must not outlive what the loading cache would serve.
+    auto enabled = c.expiry != lowres_clock::duration(0) && c.refresh != lowres_clock::duration(0) && c.max_size != 0;
+    _snapshot_max_size = enabled ? c.max_size : 0;
+    if (enabled) {
+        _snapshot_timer.arm_periodic(std::min(c.expiry, c.refresh));
+    }
 }
 
 bool permissions_cache::update_config(utils::loading_cache_config c) {
+    configure_snapshot(c);
     return _cache.update_config(std::move(c));
 }
 
 void permissions_cache::reset() {
+    drop_snapshot();
     _cache.reset();
 }
 
 future<permission_set> permissions_cache::get(const role_or_anonymous& maybe_role, const resource& r) {
+    if (auto it = _snapshot.find(key_view(&maybe_role, &r)); it != _snapshot.end()) {
+        return make_ready_future<permission_set>(it->second);
+    }
     return do_with(key_type(maybe_role, r), [this](const auto& k) {
-        return _cache.get(k);
+        return _cache.get(k).then([this, &k, generation = _snapshot_generation] (permission_set perms) {
+            if (generation == _snapshot_generation && _snapshot.size() < _snapshot_max_size) {
+                _snapshot.emplace(k, perms);
+            }
+            return perms;
+        });
     });
 }
 
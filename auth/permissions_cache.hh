@@ -13,7 +13,9 @@
 
 #include <fmt/core.h>
 #include <seastar/core/future.hh>
+#include <seastar/core/timer.hh>
 
+#include "absl-flat_hash_map.hh"
 #include "auth/permission.hh"
 #include "auth/resource.hh"
 #include "auth/role_or_anonymous.hh"
@@ -48,13 +50,55 @@ class permissions_cache final {
             utils::tuple_hash>;
 
     using key_type = typename cache_type::key_type;
+    using key_view = std::pair<const role_or_anonymous*, const resource*>;
+
+    struct snapshot_hash {
+        using is_transparent = void;
+        size_t operator()(const key_type& k) const {
+            return utils::tuple_hash()(k);
+        }
+        size_t operator()(const key_view& k) const {
+            return utils::tuple_hash()(*k.first, *k.second);
+        }
+    };
+
+    struct snapshot_eq {
+        using is_transparent = void;
+        static key_view view(const key_type& k) {
+            return {&k.first, &k.second};
+        }
+        static key_view view(const key_view& k) {
+            return k;
+        }
+        bool operator()(const auto& a, const auto& b) const {
+            auto va = view(a);
+            auto vb = view(b);
+            return *va.first == *vb.first && *va.second == *vb.second;
+        }
+    };
 
     cache_type _cache;
 
+    // The permissions of recently checked (role, resource) pairs, so that repeated
+    // checks take a single lookup, instead of going through the loading cache and
+    // updating its LRU and timestamps on every hit. It is dropped every refresh
+    // period: reloaded permissions are picked up within two periods, and hot
+    // entries are still read from the loading cache, keeping them from expiring.
+    flat_hash_map<key_type, permission_set, snapshot_hash, snapshot_eq> _snapshot;
+    size_t _snapshot_max_size = 0;
+    // Bumped whenever the snapshot is dropped, so that permissions loaded before
+    // aren't added to the new one.
+    uint64_t _snapshot_generation = 0;
+    timer<lowres_clock> _snapshot_timer;
+
+    void configure_snapshot(const utils::loading_cache_config&);
+    void drop_snapshot() noexcept;
+
 public:
     explicit permissions_cache(const utils::loading_cache_config&, service&, logging::logger&);
 
     future <> stop() {
+        _snapshot_timer.cancel();
         return _cache.stop();
     }
 
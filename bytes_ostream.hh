@@ -322,8 +322,13 @@ class bytes_ostream {
         return _size == 0;
     }
 
+    // Sizes the first chunk to hold size bytes, up to max_chunk_size(), so
+    // that writing a payload of known size doesn't grow a chain of chunks.
+    // Has no effect once something was written.
     void reserve(size_t size) {
-        // FIXME: implement
+        if (!_current) {
+            _initial_chunk_size = std::max(_initial_chunk_size, size_type(std::min(size, size_t(max_chunk_size())) + sizeof(chunk)));
+        }
     }
 
     void append(const bytes_ostream& o) {
@@ -167,6 +167,7 @@ class cache_mutation_reader final : public mutation_reader::impl {
         return _snp->schema();
     }
     void touch_partition();
+    void insert_populated(rows_entry&) noexcept;
 
     position_in_partition_view to_table_domain(position_in_partition_view query_domain_pos) {
         if (!_read_context.is_reversed()) [[likely]] {
@@ -271,7 +272,7 @@ class cache_mutation_reader final : public mutation_reader::impl {
 inline
 future<> cache_mutation_reader::process_static_row() {
     if (_snp->static_row_continuous()) {
-        _read_context.cache().on_row_hit();
+        _read_context.cache().on_row_hit(_permit);
         static_row sr = _lsa_manager.run_in_read_section([this] {
             return _snp->static_row(_read_context.digest_requested());
         });
@@ -280,7 +281,7 @@ future<> cache_mutation_reader::process_static_row() {
         }
         return make_ready_future<>();
     } else {
-        _read_context.cache().on_row_miss();
+        _read_context.cache().on_row_miss(_permit);
         return ensure_underlying().then([this] {
             return (*_underlying)().then([this] (mutation_fragment_v2_opt&& sr) {
                 if (sr) {
@@ -299,6 +300,20 @@ void cache_mutation_reader::touch_partition() {
     _snp->touch();
 }
 
+// Rows populated by range scans are admitted as probationary, so that a scan
+// doesn't flush the hot set out of the cache. See cache_tracker::insert_probationary().
+// So are all the rows of tables with a low cache priority.
+inline
+void cache_mutation_reader::insert_populated(rows_entry& e) noexcept {
+    if (_schema->caching_options().low_priority()) {
+        _snp->tracker()->insert_low_priority(e);
+    } else if (_read_context.is_range_query()) {
+        _snp->tracker()->insert_probationary(e);
+    } else {
+        _snp->tracker()->insert(e);
+    }
+}
+
 inline
 future<> cache_mutation_reader::fill_buffer() {
     if (_state == state::before_static_row) {
@@ -416,7 +431,7 @@ future<> cache_mutation_reader::read_from_underlying() {
     return consume_mutation_fragments_until(*_underlying,
         [this] { return _state != state::reading_from_underlying || is_buffer_full(); },
         [this] (mutation_fragment_v2 mf) {
-            _read_context.cache().on_row_miss();
+            _read_context.cache().on_row_miss(_permit);
             offer_from_underlying(std::move(mf));
         },
         [this] {
@@ -459,7 +474,7 @@ future<> cache_mutation_reader::read_from_underlying() {
                                         cmp);
                                 if (insert_result.second) {
                                     auto it = insert_result.first;
-                                    _snp->tracker()->insert(*it);
+                                    insert_populated(*it);
                                     auto next = std::next(it);
                                     // Also works in reverse read mode.
                                     // It preserves the continuity of the range the entry falls into.
@@ -479,7 +494,7 @@ future<> cache_mutation_reader::read_from_underlying() {
                                         cmp);
                                 if (insert_result.second) {
                                     clogger.trace("csm {}: L{}: inserted dummy at {}", fmt::ptr(this), __LINE__, _upper_bound);
-                                    _snp->tracker()->insert(*insert_result.first);
+                                    insert_populated(*insert_result.first);
                                     restore_continuity_after_insertion(insert_result.first);
                                 }
                                 if (_read_context.is_reversed()) [[unlikely]] {
@@ -567,7 +582,7 @@ void cache_mutation_reader::maybe_update_continuity() {
                         auto insert_result = rows.insert(std::move(e2), table_cmp);
                         if (insert_result.second) {
                             clogger.trace("csm {}: L{}: inserted dummy at {}", fmt::ptr(this), __LINE__, insert_result.first->position());
-                            _snp->tracker()->insert(*insert_result.first);
+                            insert_populated(*insert_result.first);
                         }
                         clogger.trace("csm {}: set_continuous({}), prev={}, rt={}", fmt::ptr(this), insert_result.first->position(),
                                       _last_row.position(), _current_tombstone);
@@ -595,7 +610,7 @@ void cache_mutation_reader::maybe_update_continuity() {
                         auto insert_result = rows.insert_before_hint(_next_row.get_iterator_in_latest_version(), std::move(e2), table_cmp);
                         if (insert_result.second) {
                             clogger.trace("csm {}: L{}: inserted dummy at {}", fmt::ptr(this), __LINE__, insert_result.first->position());
-                            _snp->tracker()->insert(*insert_result.first);
+                            insert_populated(*insert_result.first);
                             clogger.trace("csm {}: set_continuous({}), prev={}, rt={}", fmt::ptr(this), insert_result.first->position(),
                                           _last_row.position(), _current_tombstone);
                             set_rows_entry_continuous(*insert_result.first);
@@ -642,7 +657,7 @@ void cache_mutation_reader::maybe_add_to_cache(const clustering_row& cr) {
         auto insert_result = mp.mutable_clustered_rows().insert_before_hint(it, std::move(new_entry), cmp);
         it = insert_result.first;
         if (insert_result.second) {
-            _snp->tracker()->insert(*it);
+            insert_populated(*it);
             restore_continuity_after_insertion(it);
         }
 
@@ -707,7 +722,7 @@ bool cache_mutation_reader::maybe_add_to_cache(const range_tombstone_change& rtc
         auto insert_result = mp.mutable_clustered_rows().insert_before_hint(it, std::move(new_entry), cmp);
         it = insert_result.first;
         if (insert_result.second) {
-            _snp->tracker()->insert(*it);
+            insert_populated(*it);
             restore_continuity_after_insertion(it);
         }
 
@@ -911,7 +926,7 @@ void cache_mutation_reader::move_to_range(query::clustering_row_ranges::const_it
                 });
                 auto it = insert_result.first;
                 if (insert_result.second) {
-                    _snp->tracker()->insert(*it);
+                    insert_populated(*it);
                 }
                 _last_row = partition_snapshot_row_weakref(*_snp, it, true);
             } else {
@@ -1002,7 +1017,7 @@ inline
 void cache_mutation_reader::add_to_buffer(const partition_snapshot_row_cursor& row) {
     position_in_partition::less_compare less(*_schema);
     if (!row.dummy()) {
-        _read_context.cache().on_row_hit();
+        _read_context.cache().on_row_hit(_permit);
         if (_read_context.digest_requested()) {
             row.latest_row_prepare_hash();
         }
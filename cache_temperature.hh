@@ -30,3 +30,15 @@ class cache_temperature {
     static cache_temperature invalid() { return cache_temperature(-1.0f); }
     friend struct ser::serializer<cache_temperature>;
 };
+
+// The load of the replica shard which served a read, piggybacked on the read
+// responses with the cache_temperature of the table, so that coordinators
+// balancing reads by cache temperature also avoid busy replicas.
+class replica_load {
+    uint32_t _queued_reads = 0;
+public:
+    replica_load() = default;
+    explicit replica_load(uint32_t queued_reads) : _queued_reads(queued_reads) {}
+    // Reads waiting for admission on the shard.
+    uint32_t queued_reads() const { return _queued_reads; }
+};
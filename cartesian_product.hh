@@ -9,10 +9,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <sys/types.h>
 
 // Single-pass range over cartesian product of vectors.
+//
+// The elements of the product are generated one at a time, in the same
+// vector, which is valid until the iterator is incremented and must not be
+// modified. Only the components which changed since the previous element are
+// copied into it, that is one component for most of the elements, rather
+// than all of them.
 
 // Note:
 //    {a, b, c} x {1, 2} = {{a, 1}, {a, 2}, {b, 1}, {b, 2}, {c, 1}, {c, 2}}
@@ -31,6 +38,8 @@ struct cartesian_product {
         size_t _pos;
         const std::vector<std::vector<T>>* _vec_of_vecs;
         value_type _current;
+        // The components of _current starting at this one are stale.
+        size_t _stale_from = 0;
         std::vector<typename std::vector<T>::const_iterator> _iterators;
     public:
         struct end_tag {};
@@ -46,11 +55,15 @@ struct cartesian_product {
             }
         }
         value_type& operator*() {
-            _current.clear();
-            _current.reserve(_vec_of_vecs->size());
-            for (auto& i : _iterators) {
-                _current.emplace_back(*i);
+            _current.reserve(_iterators.size());
+            for (size_t i = _stale_from; i < _iterators.size(); ++i) {
+                if (i < _current.size()) {
+                    _current[i] = *_iterators[i];
+                } else {
+                    _current.emplace_back(*_iterators[i]);
+                }
             }
+            _stale_from = _iterators.size();
             return _current;
         }
         void operator++() {
@@ -58,6 +71,7 @@ struct cartesian_product {
 
             for (ssize_t i = _iterators.size() - 1; i >= 0; --i) {
                 ++_iterators[i];
+                _stale_from = std::min(_stale_from, size_t(i));
                 if (_iterators[i] != (*_vec_of_vecs)[i].end()) {
                     return;
                 }
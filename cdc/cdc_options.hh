@@ -33,9 +33,22 @@ enum class image_mode : uint8_t {
     full,
 };
 
+/**
+ * Where preimages are read from.
+ * read == a regular read, at the consistency level of the write
+ * cache == the memtables and row cache of the local replica; when the data
+ *          is not resident in memory, a pre_image_unknown row is recorded
+ *          instead of the preimage
+ */
+enum class preimage_source : uint8_t {
+    read,
+    cache,
+};
+
 class options final {
     std::optional<bool> _enabled;
     image_mode _preimage = image_mode::off;
+    cdc::preimage_source _preimage_source = preimage_source::read;
     bool _postimage = false;
     delta_mode _delta_mode = delta_mode::full;
     int _ttl = 86400; // 24h in seconds
@@ -50,6 +63,7 @@ class options final {
     bool is_enabled_set() const { return _enabled.has_value(); }
     bool preimage() const { return _preimage != image_mode::off; }
     bool full_preimage() const { return _preimage == image_mode::full; }
+    cdc::preimage_source get_preimage_source() const { return _preimage_source; }
     bool postimage() const { return _postimage; }
     delta_mode get_delta_mode() const { return _delta_mode; }
     void set_delta_mode(delta_mode m) { _delta_mode = m; }
@@ -58,6 +72,7 @@ class options final {
     void enabled(bool b) { _enabled = b; }
     void preimage(bool b) { preimage(b ? image_mode::on : image_mode::off); }
     void preimage(image_mode m) { _preimage = m; }
+    void set_preimage_source(cdc::preimage_source src) { _preimage_source = src; }
     void postimage(bool b) { _postimage = b; }
     void ttl(int v) { _ttl = v; }
 
@@ -70,6 +85,10 @@ template <> struct fmt::formatter<cdc::image_mode> : fmt::formatter<string_view>
     auto format(cdc::image_mode, fmt::format_context& ctx) const -> decltype(ctx.out());
 };
 
+template <> struct fmt::formatter<cdc::preimage_source> : fmt::formatter<string_view> {
+    auto format(cdc::preimage_source, fmt::format_context& ctx) const -> decltype(ctx.out());
+};
+
 template <> struct fmt::formatter<cdc::delta_mode> : fmt::formatter<string_view> {
     auto format(cdc::delta_mode, fmt::format_context& ctx) const -> decltype(ctx.out());
 };
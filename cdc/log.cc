@@ -28,6 +28,7 @@
 #include "schema/schema_builder.hh"
 #include "service/migration_listener.hh"
 #include "service/storage_proxy.hh"
+#include "schema/schema_registry.hh"
 #include "types/tuple.hh"
 #include "cql3/statements/select_statement.hh"
 #include "cql3/untyped_result_set.hh"
@@ -101,6 +102,14 @@ cdc::stats::stats() {
                         sm::description(format("number of {} preimage queries performed", kind)),
                         {}),
 
+                sm::make_total_operations("preimage_cache_hits_" + kind, counters.preimage_cache_hits,
+                        sm::description(format("number of {} preimages served from memory, for tables with preimage_source 'cache'", kind)),
+                        {}),
+
+                sm::make_total_operations("preimage_cache_misses_" + kind, counters.preimage_cache_misses,
+                        sm::description(format("number of {} preimages recorded as unknown, because the data wasn't resident in memory", kind)),
+                        {}),
+
                 sm::make_total_operations("operations_with_preimage_" + kind, counters.with_preimage_count,
                         sm::description(format("number of {} operations that included preimage", kind)),
                         {}),
@@ -302,6 +311,9 @@ static constexpr std::string_view delta_mode_string_full = "full";
 
 static constexpr std::string_view image_mode_string_full = delta_mode_string_full;
 
+static constexpr std::string_view preimage_source_string_read = "read";
+static constexpr std::string_view preimage_source_string_cache = "cache";
+
 } // anon. namespace
 
 auto fmt::formatter<cdc::delta_mode>::format(cdc::delta_mode m, fmt::format_context& ctx) const
@@ -331,6 +343,18 @@ auto fmt::formatter<cdc::image_mode>::format(cdc::image_mode m, fmt::format_cont
     throw std::logic_error("Impossible value of cdc::image_mode");
 }
 
+auto fmt::formatter<cdc::preimage_source>::format(cdc::preimage_source src, fmt::format_context& ctx) const
+        -> decltype(ctx.out()) {
+    using enum cdc::preimage_source;
+    switch (src) {
+        case read:
+            return fmt::format_to(ctx.out(), preimage_source_string_read);
+        case cache:
+            return fmt::format_to(ctx.out(), preimage_source_string_cache);
+    }
+    throw std::logic_error("Impossible value of cdc::preimage_source");
+}
+
 cdc::options::options(const std::map<sstring, sstring>& map) {
     for (auto& p : map) {
         auto key = p.first;
@@ -358,6 +382,14 @@ cdc::options::options(const std::map<sstring, sstring>& map) {
             } else {
                 throw exceptions::configuration_exception("Invalid value for CDC option \"preimage\": " + p.second);
             }
+        } else if (key == "preimage_source") {
+            if (val == preimage_source_string_cache) {
+                _preimage_source = preimage_source::cache;
+            } else if (val == preimage_source_string_read) {
+                _preimage_source = preimage_source::read;
+            } else {
+                throw exceptions::configuration_exception("Invalid value for CDC option \"preimage_source\": " + p.second);
+            }
         } else if (key == "postimage") {
             if (is_true || is_false) {
                 _postimage = is_true;    
@@ -392,13 +424,18 @@ std::map<sstring, sstring> cdc::options::to_map() const {
         return {};
     }
 
-    return {
+    std::map<sstring, sstring> ret = {
         { "enabled", enabled() ? "true" : "false" },
         { "preimage", fmt::format("{}", _preimage) },
         { "postimage", _postimage ? "true" : "false" },
         { "delta", fmt::format("{}", _delta_mode) },
         { "ttl", std::to_string(_ttl) },
     };
+    // Only listed when set, so that the options of existing tables are described as before.
+    if (_preimage_source != preimage_source::read) {
+        ret.emplace("preimage_source", fmt::format("{}", _preimage_source));
+    }
+    return ret;
 }
 
 sstring cdc::options::to_sstring() const {
@@ -406,8 +443,8 @@ sstring cdc::options::to_sstring() const {
 }
 
 bool cdc::options::operator==(const options& o) const {
-    return enabled() == o.enabled() && _preimage == o._preimage && _postimage == o._postimage && _ttl == o._ttl
-            && _delta_mode == o._delta_mode;
+    return enabled() == o.enabled() && _preimage == o._preimage && _preimage_source == o._preimage_source
+            && _postimage == o._postimage && _ttl == o._ttl && _delta_mode == o._delta_mode;
 }
 
 namespace cdc {
@@ -1467,6 +1504,9 @@ class transformer final : public change_processor {
     // When enabled, process_change will update _clustering_row_states and _static_row_state
     bool _enable_updating_state = false;
 
+    // Set when the preimage couldn't be served from memory, pre_image_unknown rows are generated instead.
+    bool _preimage_unknown = false;
+
     stats::part_type_set _touched_parts;
 
 public:
@@ -1488,6 +1528,14 @@ class transformer final : public change_processor {
     }
 
     void produce_preimage(const clustering_key* ck, const one_kind_column_set& columns_to_include) override {
+        if (_preimage_unknown) {
+            SCYLLA_ASSERT(_builder);
+            auto image_ck = _builder->allocate_new_log_row(operation::pre_image_unknown);
+            if (ck) {
+                _builder->set_clustering_columns(image_ck, *ck);
+            }
+            return;
+        }
         // iff we want full preimage, just ignore the affected columns and include everything. 
         generate_image(operation::pre_image, ck, _schema->cdc_options().full_preimage() ? nullptr : &columns_to_include);
     };
@@ -1599,14 +1647,16 @@ class transformer final : public change_processor {
         return db::timeout_clock::now() + 10s;
     }
 
-    future<lw_shared_ptr<cql3::untyped_result_set>> pre_image_select(
-            service::client_state& client_state,
-            db::consistency_level write_cl,
-            const mutation& m)
-    {
+    struct pre_image_query {
+        lw_shared_ptr<query::read_command> command;
+        dht::partition_range_vector partition_ranges;
+        ::shared_ptr<cql3::selection::selection> selection;
+    };
+
+    std::optional<pre_image_query> make_pre_image_query(const mutation& m) {
         auto& p = m.partition();
         if (p.clustered_rows().empty() && p.static_row().empty()) {
-            return make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>();
+            return std::nullopt;
         }
 
         dht::partition_range_vector partition_ranges{dht::partition_range(m.decorated_key())};
@@ -1682,14 +1732,28 @@ class transformer final : public change_processor {
         auto partition_slice = query::partition_slice(std::move(bounds), std::move(static_columns), std::move(regular_columns), std::move(opts));
         const auto max_result_size = _ctx._proxy.get_max_result_size(partition_slice);
         const auto tombstone_limit = query::tombstone_limit(_ctx._proxy.get_tombstone_limit());
-        auto command = ::make_lw_shared<query::read_command>(_schema->id(), _schema->version(), partition_slice, query::max_result_size(max_result_size), tombstone_limit, query::row_limit(row_limit));
+        auto command = ::make_lw_shared<query::read_command>(_schema->id(), _schema->version(), std::move(partition_slice), query::max_result_size(max_result_size), tombstone_limit, query::row_limit(row_limit));
+
+        return pre_image_query{std::move(command), std::move(partition_ranges), std::move(selection)};
+    }
+
+    future<lw_shared_ptr<cql3::untyped_result_set>> pre_image_select(
+            service::client_state& client_state,
+            db::consistency_level write_cl,
+            const mutation& m)
+    {
+        auto q = make_pre_image_query(m);
+        if (!q) {
+            return make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>();
+        }
 
         const auto select_cl = adjust_cl(write_cl);
 
       try {
-        return _ctx._proxy.query(_schema, std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state)).then(
-                [s = _schema, partition_slice = std::move(partition_slice), selection = std::move(selection)] (service::storage_proxy::coordinator_query_result qr) -> lw_shared_ptr<cql3::untyped_result_set> {
-            return make_lw_shared<cql3::untyped_result_set>(*s, std::move(qr.query_result), *selection, partition_slice);
+        auto command = q->command;
+        return _ctx._proxy.query(_schema, std::move(command), std::move(q->partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state)).then(
+                [s = _schema, command = q->command, selection = std::move(q->selection)] (service::storage_proxy::coordinator_query_result qr) -> lw_shared_ptr<cql3::untyped_result_set> {
+            return make_lw_shared<cql3::untyped_result_set>(*s, std::move(qr.query_result), *selection, command->slice);
         });
       } catch (exceptions::unavailable_exception& e) {
         // `query` can throw `unavailable_exception`, which is seen by clients as ~ "NoHostAvailable". 
@@ -1700,6 +1764,48 @@ class transformer final : public change_processor {
       }
     }
 
+    // Serves the preimage from the memtables and row cache of the local replica, for preimage_source 'cache'.
+    // Resolves to std::nullopt if this node isn't a replica of the partition, or the partition isn't
+    // resident in memory, so serving it would require reading sstables.
+    future<std::optional<lw_shared_ptr<cql3::untyped_result_set>>> resident_pre_image_select(const mutation& m) {
+        auto q = make_pre_image_query(m);
+        if (!q) {
+            return make_ready_future<std::optional<lw_shared_ptr<cql3::untyped_result_set>>>(lw_shared_ptr<cql3::untyped_result_set>());
+        }
+        return resident_pre_image_select(_ctx._proxy.get_db(), _schema, _dk, std::move(*q));
+    }
+
+    // Static, since the transformer is moved while the select is in progress.
+    static future<std::optional<lw_shared_ptr<cql3::untyped_result_set>>> resident_pre_image_select(
+            sharded<replica::database>& db, schema_ptr s, dht::decorated_key dk, pre_image_query q) {
+        auto erm = db.local().find_column_family(s).get_effective_replication_map();
+        const auto token = dk.token();
+        auto replicas = erm->get_replicas(token);
+        if (std::ranges::none_of(replicas, [&] (const locator::host_id& id) { return erm->get_topology().is_me(id); })) {
+            co_return std::nullopt;
+        }
+        const bool with_static_row = !q.command->slice.static_columns.empty();
+        auto result = co_await db.invoke_on(erm->shard_for_reads(*s, token),
+                [gs = global_schema_ptr(s), &dk, &q, with_static_row] (replica::database& db) -> future<foreign_ptr<lw_shared_ptr<query::result>>> {
+            schema_ptr s = gs;
+            auto& table = db.find_column_family(s);
+            // Memtables are always in memory, so it's enough for the cache to have the data of sstables.
+            if (!table.get_row_cache().is_resident(dk, q.command->slice.row_ranges(*s, dk.key()), with_static_row)) {
+                co_return nullptr;
+            }
+            auto [result, temperature] = co_await db.query(s, *q.command, query::result_options::only_result(), q.partition_ranges, nullptr, default_timeout());
+            co_return make_foreign(std::move(result));
+        });
+        if (!result) {
+            co_return std::nullopt;
+        }
+        co_return make_lw_shared<cql3::untyped_result_set>(*s, std::move(result), *q.selection, q.command->slice);
+    }
+
+    void set_preimage_unknown() {
+        _preimage_unknown = true;
+    }
+
     // Note: this assumes that the results are from one partition only
     void load_preimage_results_into_state(lw_shared_ptr<cql3::untyped_result_set> preimage_set, bool static_only) {
         // static row
@@ -1798,15 +1904,49 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
                 return make_ready_future<>();
             }
 
-            transformer trans(_ctxt, s, m.decorated_key());
+            // Shared with the continuations of the preimage select, which may fall back to another select.
+            auto trans = make_lw_shared<transformer>(_ctxt, s, m.decorated_key());
 
             auto f = make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(nullptr);
-            if (s->cdc_options().preimage() || s->cdc_options().postimage()) {
+            if (s->cdc_options().preimage() && s->cdc_options().get_preimage_source() == cdc::preimage_source::cache) {
+                tracing::trace(tr_state, "CDC: Serving preimage for {} from memory", m.decorated_key());
+                f = trans->resident_pre_image_select(m).then_wrapped([this, trans, &mutations, idx, &qs, write_cl, tr_state] (future<std::optional<lw_shared_ptr<cql3::untyped_result_set>>> f) {
+                    auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
+                    if (f.failed()) {
+                        cdc_stats.counters_total.preimage_selects++;
+                        cdc_stats.counters_failed.preimage_selects++;
+                        return make_exception_future<lw_shared_ptr<cql3::untyped_result_set>>(f.get_exception());
+                    }
+                    auto rs = f.get();
+                    if (rs) {
+                        cdc_stats.counters_total.preimage_cache_hits++;
+                        return make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(std::move(*rs));
+                    }
+                    cdc_stats.counters_total.preimage_cache_misses++;
+                    // `mutations` might have been reallocated in the meantime.
+                    auto& m = mutations[idx];
+                    if (!m.schema()->cdc_options().postimage()) {
+                        tracing::trace(tr_state, "CDC: Preimage of {} not resident in memory, recording it as unknown", m.decorated_key());
+                        trans->set_preimage_unknown();
+                        return make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(nullptr);
+                    }
+                    // The postimage is computed from the preimage, so it has to be read anyway.
+                    tracing::trace(tr_state, "CDC: Preimage of {} not resident in memory, selecting it for postimage", m.decorated_key());
+                    return trans->pre_image_select(qs.get_client_state(), write_cl, m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
+                        auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
+                        cdc_stats.counters_total.preimage_selects++;
+                        if (f.failed()) {
+                            cdc_stats.counters_failed.preimage_selects++;
+                        }
+                        return f;
+                    });
+                });
+            } else if (s->cdc_options().preimage() || s->cdc_options().postimage()) {
                 // Note: further improvement here would be to coalesce the pre-image selects into one
                 // iff a batch contains several modifications to the same table. Otoh, batch is rare(?)
                 // so this is premature.
                 tracing::trace(tr_state, "CDC: Selecting preimage for {}", m.decorated_key());
-                f = trans.pre_image_select(qs.get_client_state(), write_cl, m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
+                f = trans->pre_image_select(qs.get_client_state(), write_cl, m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
                     auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
                     cdc_stats.counters_total.preimage_selects++;
                     if (f.failed()) {
@@ -1825,7 +1965,7 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
                 if (rs) {
                     const auto& p = m.partition();
                     const bool static_only = !p.static_row().empty() && p.clustered_rows().empty();
-                    trans.load_preimage_results_into_state(std::move(rs), static_only);
+                    trans->load_preimage_results_into_state(std::move(rs), static_only);
                 }
 
                 const bool preimage = s->cdc_options().preimage();
@@ -1836,12 +1976,12 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
                 if (should_split(m)) {
                     tracing::trace(tr_state, "CDC: Splitting {}", m.decorated_key());
                     details.was_split = true;
-                    process_changes_with_splitting(m, trans, preimage, postimage);
+                    process_changes_with_splitting(m, *trans, preimage, postimage);
                 } else {
                     tracing::trace(tr_state, "CDC: No need to split {}", m.decorated_key());
-                    process_changes_without_splitting(m, trans, preimage, postimage);
+                    process_changes_without_splitting(m, *trans, preimage, postimage);
                 }
-                auto [log_mut, touched_parts] = std::move(trans).finish();
+                auto [log_mut, touched_parts] = std::move(*trans).finish();
                 const int generated_count = log_mut.size();
                 mutations.insert(mutations.end(), std::make_move_iterator(log_mut.begin()), std::make_move_iterator(log_mut.end()));
 
@@ -61,6 +61,8 @@ class stats final {
         uint64_t unsplit_count = 0;
         uint64_t split_count = 0;
         uint64_t preimage_selects = 0;
+        uint64_t preimage_cache_hits = 0;
+        uint64_t preimage_cache_misses = 0;
         uint64_t with_preimage_count = 0;
         uint64_t with_postimage_count = 0;
 
@@ -306,11 +306,38 @@ merge(collection_mutation_view_description a, collection_mutation_view_descripti
     collection_mutation_view_description merged;
     merged.cells.reserve(a.cells.size() + b.cells.size());
 
-    combine(a.cells.begin(), std::remove_if(a.cells.begin(), a.cells.end(), cell_killed(b.tomb)),
-            b.cells.begin(), std::remove_if(b.cells.begin(), b.cells.end(), cell_killed(a.tomb)),
-            std::back_inserter(merged.cells),
-            compare,
-            merge);
+    auto a_begin = a.cells.begin(), a_end = std::remove_if(a.cells.begin(), a.cells.end(), cell_killed(b.tomb));
+    auto b_begin = b.cells.begin(), b_end = std::remove_if(b.cells.begin(), b.cells.end(), cell_killed(a.tomb));
+
+    // Merging a few elements into a large collection (an update of a big map or set) is the common
+    // case. Rather than comparing every element of the large collection, look up the position of each
+    // element of the small one with a binary search and copy the elements in between as they are.
+    auto merge_into_large = [&] (auto large, auto large_end, auto small, auto small_end) {
+        for (; small != small_end; ++small) {
+            auto it = std::lower_bound(large, large_end, *small, compare);
+            std::copy(large, it, std::back_inserter(merged.cells));
+            if (it != large_end && !compare(*small, *it)) {
+                merged.cells.push_back(merge(*it, *small));
+                ++it;
+            } else {
+                merged.cells.push_back(*small);
+            }
+            large = it;
+        }
+        std::copy(large, large_end, std::back_inserter(merged.cells));
+    };
+    constexpr size_t small_merge_ratio = 16;
+    const size_t a_size = a_end - a_begin, b_size = b_end - b_begin;
+    if (b_size * small_merge_ratio < a_size) {
+        merge_into_large(a_begin, a_end, b_begin, b_end);
+    } else if (a_size * small_merge_ratio < b_size) {
+        merge_into_large(b_begin, b_end, a_begin, a_end);
+    } else {
+        combine(a_begin, a_end, b_begin, b_end,
+                std::back_inserter(merged.cells),
+                compare,
+                merge);
+    }
     merged.tomb = std::max(a.tomb, b.tomb);
 
     return merged;
@@ -846,6 +846,14 @@ class compaction {
         return consumer(make_compacting_reader(setup_sstable_reader(), compaction_time, max_purgeable_func(), gc_state));
     }
 
+    // A compaction is a single fiber, reading and writing the whole token range
+    // of its input. It isn't split into sub-range compactions running in
+    // parallel: they would all run on this shard's reactor, and merging,
+    // serialization and compression are what take the time of a large
+    // compaction, so they would only interleave with each other. Waiting for
+    // I/O is already overlapped with that work by the read-ahead of the
+    // sstable readers and the write-behind of the writers. The shard owns its
+    // data, so the work can't be spread to other shards either.
     future<> consume() {
         auto now = gc_clock::now();
         // consume_without_gc_writer(), which uses compacting_reader, is ~3% slower.
@@ -1892,6 +1900,93 @@ future<compaction_result> scrub_sstables_validate_mode(sstables::compaction_desc
     co_return res;
 }
 
+// Whether an input sstable would be rewritten into an identical one, other than for its
+// level: it has no tombstones nor expiring cells to purge, is already in the current format
+// and fits in the size of the output sstables.
+static bool can_pass_through_sstable(const sstables::shared_sstable& sst, const sstables::compaction_descriptor& descriptor, table_state& table_s) {
+    return descriptor.level != int(sst->get_sstable_level())
+        && !sst->is_shared()
+        && sst->get_version() == table_s.get_sstables_manager().get_highest_supported_format()
+        && sst->get_stats_metadata().min_local_deletion_time == std::numeric_limits<int32_t>::max()
+        && sst->data_size() <= descriptor.max_sstable_bytes;
+}
+
+// Whether the compaction would rewrite its input sstables into identical ones, other than for
+// their level, and the output needs no segregation, splitting or cleanup. That is the case of:
+//  - LCS level-ups of one sstable not overlapping the next level,
+//  - reshapes of disjoint sstables into a level, like LCS's of disjoint L0 sstables streamed
+//    by node operations, as long as they are at least half of the size of the output sstables,
+//    so that the level isn't filled with small sstables.
+static bool can_pass_through_sstables(const sstables::compaction_descriptor& descriptor, table_state& table_s) {
+    if (descriptor.owned_ranges
+            || !table_s.schema()->dropped_columns().empty()
+            || table_s.get_compaction_strategy().use_interposer_consumer()) {
+        return false;
+    }
+    switch (descriptor.options.type()) {
+    case compaction_type::Compaction:
+        if (descriptor.sstables.size() != 1) {
+            return false;
+        }
+        break;
+    case compaction_type::Reshape: {
+        auto sorted = descriptor.sstables;
+        std::ranges::sort(sorted, [&s = *table_s.schema()] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_first_decorated_key().tri_compare(s, b->get_first_decorated_key()) < 0;
+        });
+        if (sstable_set_overlapping_count(table_s.schema(), sorted) != 0
+                || std::ranges::any_of(sorted, [&] (const shared_sstable& sst) { return sst->data_size() < descriptor.max_sstable_bytes / 2; })) {
+            return false;
+        }
+        break;
+    }
+    default:
+        return false;
+    }
+    return std::ranges::all_of(descriptor.sstables, [&] (const shared_sstable& sst) {
+        return can_pass_through_sstable(sst, descriptor, table_s);
+    });
+}
+
+// Hard-links the input sstables under the generations of new output sstables and sets their
+// level, instead of reading and writing all of their data.
+static future<compaction_result> pass_through_sstables(sstables::compaction_descriptor descriptor, table_state& table_s) {
+    return seastar::async([descriptor = std::move(descriptor), &table_s] () mutable {
+        auto started_at = db_clock::now();
+        compaction_completion_desc desc;
+        compaction_stats stats;
+        for (auto& sst : descriptor.sstables) {
+            auto new_sst = descriptor.creator(this_shard_id());
+            sst->clone(new_sst->generation()).get();
+            new_sst->load(table_s.schema()->get_sharder(), sstables::sstable_open_config{ .current_shard_as_sstable_owner = true }).get();
+            new_sst->mutate_sstable_level(descriptor.level).get();
+            desc.old_sstables.push_back(sst);
+            desc.new_sstables.push_back(new_sst);
+            desc.ranges_for_cache_invalidation.push_back(dht::partition_range::make({sst->get_first_decorated_key(), true}, {sst->get_last_decorated_key(), true}));
+            stats.start_size += sst->bytes_on_disk();
+            stats.end_size += new_sst->bytes_on_disk();
+            clogger.debug("[{} {}.{} {}] Passing through {} unchanged to {} at level {}", compaction_name(descriptor.options.type()),
+                    table_s.schema()->ks_name(), table_s.schema()->cf_name(), table_s.get_group_id(),
+                    to_string(sst, false), to_string(new_sst, true), descriptor.level);
+        }
+        auto new_sstables = desc.new_sstables;
+
+        if (descriptor.replacer) {
+            descriptor.replacer(std::move(desc));
+        }
+
+        stats.ended_at = db_clock::now();
+        clogger.info("[{} {}.{} {}] Passed through {} sstable(s) unchanged to level {} in {}ms", compaction_name(descriptor.options.type()),
+                table_s.schema()->ks_name(), table_s.schema()->cf_name(), table_s.get_group_id(),
+                new_sstables.size(), descriptor.level,
+                std::chrono::duration_cast<std::chrono::milliseconds>(stats.ended_at - started_at).count());
+        return compaction_result {
+            .new_sstables = std::move(new_sstables),
+            .stats = stats,
+        };
+    });
+}
+
 future<compaction_result>
 compact_sstables(sstables::compaction_descriptor descriptor, compaction_data& cdata, table_state& table_s, compaction_progress_monitor& progress_monitor) {
     if (descriptor.sstables.empty()) {
@@ -1903,6 +1998,9 @@ compact_sstables(sstables::compaction_descriptor descriptor, compaction_data& cd
         // Bypass the usual compaction machinery for dry-mode scrub
         return scrub_sstables_validate_mode(std::move(descriptor), cdata, table_s, progress_monitor);
     }
+    if (can_pass_through_sstables(descriptor, table_s)) {
+        return pass_through_sstables(std::move(descriptor), table_s);
+    }
     return compaction::run(make_compaction(table_s, std::move(descriptor), cdata, progress_monitor));
 }
 
@@ -1918,12 +2016,14 @@ get_fully_expired_sstables(const table_state& table_s, const std::vector<sstable
     auto uncompacting_sstables = get_uncompacting_sstables(table_s, compacting);
     // Get list of uncompacting sstables that overlap the ones being compacted.
     std::vector<sstables::shared_sstable> overlapping = leveled_manifest::overlapping(*table_s.schema(), compacting, uncompacting_sstables);
-    int64_t min_timestamp = std::numeric_limits<int64_t>::max();
+    // SSTables which may contain live data, which the tombstones and expired data
+    // of a candidate could shadow.
+    std::vector<sstables::shared_sstable> live;
 
     for (auto& sstable : overlapping) {
         auto gc_before = sstable->get_gc_before_for_fully_expire(compaction_time, table_s.get_tombstone_gc_state(), table_s.schema());
         if (sstable->get_max_local_deletion_time() >= gc_before) {
-            min_timestamp = std::min(min_timestamp, sstable->get_stats_metadata().min_timestamp);
+            live.push_back(sstable);
         }
     }
 
@@ -1950,13 +2050,26 @@ get_fully_expired_sstables(const table_state& table_s, const std::vector<sstable
             clogger.debug("Adding candidate of generation {} to list of possibly expired sstables", candidate->generation());
             candidates.insert(candidate);
         } else {
-            min_timestamp = std::min(min_timestamp, candidate->get_stats_metadata().min_timestamp);
+            live.push_back(candidate);
         }
     }
 
+    const auto& s = *table_s.schema();
+    auto overlap = [&s] (const sstables::shared_sstable& a, const sstables::shared_sstable& b) {
+        return a->get_first_decorated_key().tri_compare(s, b->get_last_decorated_key()) <= 0
+            && b->get_first_decorated_key().tri_compare(s, a->get_last_decorated_key()) <= 0;
+    };
     auto it = candidates.begin();
     while (it != candidates.end()) {
         auto& candidate = *it;
+        // Only data of sstables overlapping with the candidate in token range can be shadowed by it,
+        // so older sstables with a disjoint token range (e.g. streamed or split ones) don't hold it back.
+        int64_t min_timestamp = std::numeric_limits<int64_t>::max();
+        for (auto& sst : live) {
+            if (overlap(candidate, sst)) {
+                min_timestamp = std::min(min_timestamp, sst->get_stats_metadata().min_timestamp);
+            }
+        }
         // Remove from list any candidate that may contain a tombstone that covers older data.
         if (candidate->get_stats_metadata().max_timestamp >= min_timestamp) {
             it = candidates.erase(it);
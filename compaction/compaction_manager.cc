@@ -14,6 +14,7 @@
 #include "sstables/sstables.hh"
 #include "sstables/sstables_manager.hh"
 #include <memory>
+#include <ranges>
 #include <fmt/ranges.h>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/coroutine.hh>
@@ -1045,9 +1046,16 @@ future<> compaction_manager::postponed_compactions_reevaluation() {
         // for moving the list to be processed into a local.
         auto postponed = std::exchange(_postponed, {});
         try {
-            for (auto it = postponed.begin(); it != postponed.end();) {
-                table_state* t = *it;
-                it = postponed.erase(it);
+            // Postponed compactions compete for the weights that were released, so resubmit the
+            // tables with the largest backlog first: they have the most data waiting to be
+            // compacted, so compacting them does the most to reduce read amplification.
+            auto by_backlog = postponed
+                | std::views::filter([this] (table_state* t) { return _compaction_state.contains(t); })
+                | std::views::transform([] (table_state* t) { return std::pair(t->get_backlog_tracker().backlog(), t); })
+                | std::ranges::to<std::vector>();
+            std::ranges::sort(by_backlog, std::greater<>(), &std::pair<double, table_state*>::first);
+            for (auto [backlog, t] : by_backlog) {
+                postponed.erase(t);
                 // skip reevaluation of a table_state that became invalid post its removal
                 if (!_compaction_state.contains(t)) {
                     continue;
@@ -419,6 +419,11 @@ class compaction_manager {
         return _backlog_manager.backlog();
     }
 
+    // The backlog last seen by the compaction controller, normalized by the available memory.
+    double normalized_backlog() const noexcept {
+        return _last_backlog / available_memory();
+    }
+
     void register_backlog_tracker(compaction_backlog_tracker& backlog_tracker) {
         _backlog_manager.register_backlog_tracker(backlog_tracker);
     }
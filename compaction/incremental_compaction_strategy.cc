@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "sstables/sstables.hh"
+#include "incremental_compaction_strategy.hh"
+#include "size_tiered_backlog_tracker.hh"
+#include "cql3/statements/property_definitions.hh"
+
+#include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+#include <cmath>
+
+namespace sstables {
+
+static int32_t validate_fragment_size_in_mb(const std::map<sstring, sstring>& options) {
+    auto tmp_value = compaction_strategy_impl::get_value(options, incremental_compaction_strategy::FRAGMENT_SIZE_OPTION);
+    auto fragment_size = cql3::statements::property_definitions::to_int(incremental_compaction_strategy::FRAGMENT_SIZE_OPTION, tmp_value,
+            incremental_compaction_strategy::DEFAULT_MAX_FRAGMENT_SIZE_IN_MB);
+    if (fragment_size <= 0) {
+        throw exceptions::configuration_exception(fmt::format("{} value ({}) must be positive", incremental_compaction_strategy::FRAGMENT_SIZE_OPTION, fragment_size));
+    }
+    return fragment_size;
+}
+
+incremental_compaction_strategy::incremental_compaction_strategy(const std::map<sstring, sstring>& options)
+    : compaction_strategy_impl(options)
+    , _options(options)
+    , _fragment_size(uint64_t(validate_fragment_size_in_mb(options)) << 20)
+{}
+
+// options is a map of compaction strategy options and their values.
+// unchecked_options is an analogical map from which already checked options are deleted.
+// This helps making sure that only allowed options are being set.
+void incremental_compaction_strategy::validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options) {
+    size_tiered_compaction_strategy_options::validate(options, unchecked_options);
+    validate_fragment_size_in_mb(options);
+    unchecked_options.erase(FRAGMENT_SIZE_OPTION);
+}
+
+std::vector<incremental_compaction_strategy::run_bucket>
+incremental_compaction_strategy::get_buckets(const std::vector<frozen_sstable_run>& runs, const size_tiered_compaction_strategy_options& options) {
+    // runs sorted by the size of their data files.
+    auto sorted_runs = boost::copy_range<std::vector<std::pair<frozen_sstable_run, uint64_t>>>(runs
+            | boost::adaptors::transformed([] (const frozen_sstable_run& run) { return std::make_pair(run, run->data_size()); }));
+
+    std::sort(sorted_runs.begin(), sorted_runs.end(), [] (auto& i, auto& j) {
+        return i.second < j.second;
+    });
+
+    std::vector<run_bucket> bucket_list;
+    std::vector<double> bucket_average_size_list;
+
+    for (auto& [run, size] : sorted_runs) {
+        // See size_tiered_compaction_strategy::get_buckets(), the same rules apply to whole runs.
+        if (!bucket_list.empty()) {
+            auto& bucket_average_size = bucket_average_size_list.back();
+
+            if ((size > (bucket_average_size * options.bucket_low) && size < (bucket_average_size * options.bucket_high)) ||
+                    (size < options.min_sstable_size && bucket_average_size < options.min_sstable_size)) {
+                auto& bucket = bucket_list.back();
+                auto total_size = bucket.size() * bucket_average_size;
+                auto new_average_size = (total_size + size) / (bucket.size() + 1);
+                auto smallest_run_in_bucket = bucket[0]->data_size();
+
+                if (size < options.min_sstable_size || smallest_run_in_bucket > new_average_size * options.bucket_low) {
+                    bucket.push_back(run);
+                    bucket_average_size = new_average_size;
+                    continue;
+                }
+            }
+        }
+
+        bucket_list.push_back(run_bucket{run});
+        bucket_average_size_list.push_back(size);
+    }
+
+    return bucket_list;
+}
+
+incremental_compaction_strategy::run_bucket
+incremental_compaction_strategy::most_interesting_bucket(std::vector<run_bucket> buckets, size_t min_threshold, size_t max_threshold) {
+    run_bucket* max = nullptr;
+    for (auto& bucket : buckets) {
+        if (bucket.size() < min_threshold) {
+            continue;
+        }
+        bucket.resize(std::min(bucket.size(), max_threshold));
+        // Pick the bucket with more elements, as efficiency of same-tier compactions increases with number of runs.
+        if (!max || max->size() < bucket.size()) {
+            max = &bucket;
+        }
+    }
+    return max ? std::move(*max) : run_bucket();
+}
+
+compaction_descriptor incremental_compaction_strategy::make_descriptor(const run_bucket& bucket) const {
+    std::vector<shared_sstable> sstables;
+    for (auto& run : bucket) {
+        sstables.insert(sstables.end(), run->all().begin(), run->all().end());
+    }
+    return compaction_descriptor(std::move(sstables), compaction_descriptor::default_level, _fragment_size);
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control) {
+    // make local copies so they can't be changed out from under us mid-method
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    auto compaction_time = gc_clock::now();
+
+    auto buckets = get_buckets(control.candidates_as_runs(table_s), _options);
+
+    auto bucket = most_interesting_bucket(buckets, min_threshold, max_threshold);
+    // If we are not enforcing min_threshold explicitly, try any pair of runs in the same tier.
+    if (bucket.empty() && !table_s.compaction_enforce_min_threshold()) {
+        bucket = most_interesting_bucket(buckets, 2, max_threshold);
+    }
+    if (!bucket.empty()) {
+        return make_descriptor(bucket);
+    }
+
+    if (!table_s.tombstone_gc_enabled()) {
+        return compaction_descriptor();
+    }
+
+    // if there is no run to compact in standard way, try compacting a single run whose droppable tombstone
+    // ratio is greater than threshold, preferring the biggest size tiers.
+    for (auto& bucket : buckets | boost::adaptors::reversed) {
+        for (auto& run : bucket) {
+            auto worth_dropping = std::ranges::any_of(run->all(), [&] (const shared_sstable& sst) {
+                return worth_dropping_tombstones(sst, compaction_time, table_s);
+            });
+            if (worth_dropping) {
+                return make_descriptor({run});
+            }
+        }
+    }
+    return compaction_descriptor();
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) {
+    return make_major_compaction_job(std::move(candidates), compaction_descriptor::default_level, _fragment_size);
+}
+
+std::vector<compaction_descriptor>
+incremental_compaction_strategy::get_cleanup_compaction_jobs(table_state& table_s, std::vector<shared_sstable> candidates) const {
+    // Cleanup rewrites each run on its own, so it needs no more temporary space than a regular compaction.
+    std::unordered_map<run_id, std::vector<shared_sstable>> runs;
+    for (auto& sst : candidates) {
+        runs[sst->run_identifier()].push_back(sst);
+    }
+    std::vector<compaction_descriptor> ret;
+    ret.reserve(runs.size());
+    for (auto& [id, sstables] : runs) {
+        ret.push_back(compaction_descriptor(std::move(sstables), compaction_descriptor::default_level, _fragment_size, id));
+    }
+    return ret;
+}
+
+int64_t incremental_compaction_strategy::estimated_pending_compactions(table_state& table_s) const {
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    int64_t n = 0;
+    for (auto& bucket : get_buckets(table_s.main_sstable_set().all_sstable_runs(), _options)) {
+        if (bucket.size() >= min_threshold) {
+            n += std::ceil(double(bucket.size()) / max_threshold);
+        }
+    }
+    return n;
+}
+
+std::unique_ptr<compaction_backlog_tracker::impl> incremental_compaction_strategy::make_backlog_tracker() const {
+    return std::make_unique<size_tiered_backlog_tracker>(_options);
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_config cfg) const {
+    auto desc = size_tiered_compaction_strategy(_options).get_reshaping_job(std::move(input), std::move(schema), cfg);
+    desc.max_sstable_bytes = _fragment_size;
+    return desc;
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <seastar/core/sstring.hh>
+
+#include "compaction_strategy_impl.hh"
+#include "size_tiered_compaction_strategy.hh"
+#include "sstables/sstable_set.hh"
+
+namespace sstables {
+
+// Incremental compaction strategy (ICS) applies the size-tiered policy to
+// sstable runs rather than to individual sstables. Every run is split into
+// fragments of at most sstable_size_in_mb, so compaction can release input
+// fragments as soon as all of their data has been written to output
+// fragments. The temporary space needed by a compaction is therefore bounded
+// by a few fragments per input run, rather than by the size of the input.
+class incremental_compaction_strategy : public compaction_strategy_impl {
+public:
+    static constexpr int32_t DEFAULT_MAX_FRAGMENT_SIZE_IN_MB = 1000;
+    static constexpr auto FRAGMENT_SIZE_OPTION = "sstable_size_in_mb";
+private:
+    size_tiered_compaction_strategy_options _options;
+    uint64_t _fragment_size = uint64_t(DEFAULT_MAX_FRAGMENT_SIZE_IN_MB) << 20;
+
+    using run_bucket = std::vector<frozen_sstable_run>;
+
+    // Group runs of similar size into buckets, following the size-tiered rules.
+    static std::vector<run_bucket> get_buckets(const std::vector<frozen_sstable_run>& runs, const size_tiered_compaction_strategy_options& options);
+
+    static run_bucket most_interesting_bucket(std::vector<run_bucket> buckets, size_t min_threshold, size_t max_threshold);
+
+    compaction_descriptor make_descriptor(const run_bucket& bucket) const;
+public:
+    static void validate_options(const std::map<sstring, sstring>& options, std::map<sstring, sstring>& unchecked_options);
+
+    explicit incremental_compaction_strategy(const std::map<sstring, sstring>& options);
+
+    uint64_t fragment_size() const noexcept {
+        return _fragment_size;
+    }
+
+    virtual compaction_descriptor get_sstables_for_compaction(table_state& table_s, strategy_control& control) override;
+
+    virtual compaction_descriptor get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual std::vector<compaction_descriptor> get_cleanup_compaction_jobs(table_state& table_s, std::vector<shared_sstable> candidates) const override;
+
+    virtual int64_t estimated_pending_compactions(table_state& table_s) const override;
+
+    virtual compaction_strategy_type type() const override {
+        return compaction_strategy_type::incremental;
+    }
+
+    virtual std::unique_ptr<compaction_backlog_tracker::impl> make_backlog_tracker() const override;
+
+    virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, reshape_config cfg) const override;
+};
+
+}
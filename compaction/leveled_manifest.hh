@@ -11,6 +11,7 @@
 #pragma once
 
 #include <algorithm>
+#include <queue>
 
 #include "utils/assert.hh"
 #include "sstables/sstables.hh"
@@ -205,9 +206,11 @@ class leveled_manifest {
             if (score <= TARGET_SCORE) {
                 continue;
             }
-            // before proceeding with a higher level, let's see if L0 is far enough behind to warrant STCS
+            // before proceeding with a higher level, let's see if L0 is far enough behind to warrant STCS.
+            // L0 is only behind if reads have to check many of its sstables, i.e. if it has many sub-levels,
+            // so a burst of sstables with disjoint token ranges doesn't delay the higher levels.
             // TODO: we shouldn't proceed with size tiered strategy if cassandra.disable_stcs_in_l0 is true.
-            if (get_level_size(0) > MAX_COMPACTING_L0) {
+            if (get_level_size(0) > MAX_COMPACTING_L0 && sublevel_count(*_schema, get_level(0)) > MAX_COMPACTING_L0) {
                 auto most_interesting = sstables::size_tiered_compaction_strategy::most_interesting_bucket(get_level(0),
                     _table_s.min_compaction_threshold(), _schema->max_compaction_threshold(), _stcs_options);
                 if (!most_interesting.empty()) {
@@ -366,6 +369,30 @@ class leveled_manifest {
         return overlapped;
     }
 
+    // Returns the number of sub-levels the sstables can be organized into, each
+    // sub-level being a run of sstables that don't overlap each other. That's the
+    // highest number of the sstables a single partition can be found in, so it's
+    // what bounds the read amplification of L0, unlike the number of sstables in
+    // it, which also grows with sstables of disjoint token ranges (e.g. streamed ones).
+    static unsigned sublevel_count(const schema& s, std::vector<sstables::shared_sstable> sstables) {
+        std::ranges::sort(sstables, [&s] (const sstables::shared_sstable& a, const sstables::shared_sstable& b) {
+            return a->get_first_decorated_key().tri_compare(s, b->get_first_decorated_key()) < 0;
+        });
+        // Last keys of the sub-levels, the one ending first on top. An sstable is appended
+        // to that sub-level if it starts after it, otherwise it needs a new sub-level.
+        auto ends_after = [&s] (const dht::decorated_key& a, const dht::decorated_key& b) {
+            return a.tri_compare(s, b) > 0;
+        };
+        std::priority_queue<dht::decorated_key, std::vector<dht::decorated_key>, decltype(ends_after)> sublevel_ends(ends_after);
+        for (auto& sst : sstables) {
+            if (!sublevel_ends.empty() && sublevel_ends.top().tri_compare(s, sst->get_first_decorated_key()) < 0) {
+                sublevel_ends.pop();
+            }
+            sublevel_ends.push(sst->get_last_decorated_key());
+        }
+        return sublevel_ends.size();
+    }
+
     bool worth_promoting_L0_candidates(const std::vector<sstables::shared_sstable>& candidates) const {
         return get_total_bytes(candidates) >= _max_sstable_size_in_bytes;
     }
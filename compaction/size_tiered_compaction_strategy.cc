@@ -211,6 +211,24 @@ size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector
     return std::move(max);
 }
 
+// Returns the candidates which overlap with sst and may hold data older than its tombstones.
+// Such data keeps the tombstones from being purged when sst is compacted alone, so compacting
+// sst would just rewrite them, and would again on the next tombstone compaction of it.
+static std::vector<shared_sstable> purge_blocking_sstables(const schema& s, const shared_sstable& sst, const std::vector<shared_sstable>& candidates) {
+    std::vector<shared_sstable> ret;
+    auto max_timestamp = sst->get_stats_metadata().max_timestamp;
+    for (auto& candidate : candidates) {
+        if (candidate == sst || candidate->get_stats_metadata().min_timestamp > max_timestamp) {
+            continue;
+        }
+        if (candidate->get_first_decorated_key().tri_compare(s, sst->get_last_decorated_key()) <= 0
+                && sst->get_first_decorated_key().tri_compare(s, candidate->get_last_decorated_key()) <= 0) {
+            ret.push_back(candidate);
+        }
+    }
+    return ret;
+}
+
 compaction_descriptor
 size_tiered_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control) {
     // make local copies so they can't be changed out from under us mid-method
@@ -255,7 +273,18 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(table_state& table_
         auto it = std::min_element(sstables.begin(), sstables.end(), [] (auto& i, auto& j) {
             return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
         });
-        return sstables::compaction_descriptor({ *it });
+        // compact it together with the sstables holding back the purge of its tombstones, as long
+        // as that costs no more than rewriting it again, so the tombstones are actually dropped.
+        std::vector<sstables::shared_sstable> input = { *it };
+        auto blocking = purge_blocking_sstables(*table_s.schema(), *it, candidates);
+        uint64_t blocking_size = 0;
+        for (auto& sst : blocking) {
+            blocking_size += sst->data_size();
+        }
+        if (!blocking.empty() && blocking.size() < size_t(max_threshold) && blocking_size <= (*it)->data_size()) {
+            input.insert(input.end(), blocking.begin(), blocking.end());
+        }
+        return sstables::compaction_descriptor(std::move(input));
     }
     return sstables::compaction_descriptor();
 }
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <vector>
 #include <span>
+#include <ranges>
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include "utils/assert.hh"
@@ -24,6 +25,7 @@ template<allow_prefixes AllowPrefixes = allow_prefixes::no>
 class compound_type final {
 private:
     const std::vector<data_type> _types;
+    const std::vector<value_comparator> _comparators;
     const bool _byte_order_equal;
     const bool _byte_order_comparable;
     const bool _is_reversed;
@@ -35,6 +37,7 @@ class compound_type final {
 
     compound_type(std::vector<data_type> types)
         : _types(std::move(types))
+        , _comparators(_types | std::views::transform([] (const data_type& t) { return value_comparator(*t); }) | std::ranges::to<std::vector>())
         , _byte_order_equal(std::all_of(_types.begin(), _types.end(), [] (const auto& t) {
                 return t->is_byte_order_equal();
             }))
@@ -48,6 +51,11 @@ class compound_type final {
         return _types;
     }
 
+    // Comparators of the components, in the order of types().
+    const std::vector<value_comparator>& comparators() const {
+        return _comparators;
+    }
+
     bool is_singular() const {
         return _types.size() == 1;
     }
@@ -250,10 +258,8 @@ class compound_type final {
                 return compare_unsigned(b1, b2);
             }
         }
-        return lexicographical_tri_compare(_types.begin(), _types.end(),
-            begin(b1), end(b1), begin(b2), end(b2), [] (auto&& type, auto&& v1, auto&& v2) {
-                return type->compare(v1, v2);
-            });
+        return lexicographical_tri_compare(_comparators.begin(), _comparators.end(),
+            begin(b1), end(b1), begin(b2), end(b2), tri_compare_with);
     }
     // Returns true iff given prefix has no missing components
     bool is_full(managed_bytes_view v) const {
@@ -61,6 +61,14 @@ std::map<sstring, sstring> compressor::options() const {
     return {};
 }
 
+bytes compressor::train_dictionary(const std::vector<bytes_view>&) const {
+    return bytes();
+}
+
+compressor::ptr_type compressor::with_dictionary(bytes_view) const {
+    throw std::logic_error(format("{} does not support compression dictionaries", name()));
+}
+
 compressor::ptr_type compressor::create(const sstring& name, const opt_getter& opts) {
     if (name.empty()) {
         return {};
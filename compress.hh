@@ -11,10 +11,12 @@
 #include <map>
 #include <optional>
 #include <set>
+#include <vector>
 
 #include <seastar/core/future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
+#include "bytes.hh"
 #include "seastarx.hh"
 
 class compressor {
@@ -50,6 +52,27 @@ class compressor {
      */
     virtual std::map<sstring, sstring> options() const;
 
+    /**
+     * Returns the maximum size of a dictionary this compressor wants to be
+     * trained for the data it compresses, or 0 if it doesn't use dictionaries.
+     */
+    virtual size_t dictionary_size() const {
+        return 0;
+    }
+    /**
+     * Trains a dictionary of at most dictionary_size() bytes from the given
+     * samples. Returns an empty dictionary if the samples are unsuitable
+     * (e.g. too few or too small), in which case the data should be
+     * compressed without a dictionary.
+     */
+    virtual bytes train_dictionary(const std::vector<bytes_view>& samples) const;
+    /**
+     * Returns a compressor which compresses and uncompresses using the given
+     * dictionary. The dictionary is referenced and not copied, so it must
+     * outlive the returned compressor.
+     */
+    virtual shared_ptr<compressor> with_dictionary(bytes_view dictionary) const;
+
     /**
      * Compressor class name.
      */
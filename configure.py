@@ -450,6 +450,7 @@ scylla_tests = set([
     'test/boost/cached_file_test',
     'test/boost/caching_options_test',
     'test/boost/canonical_mutation_test',
+    'test/boost/cache_warmup_test',
     'test/boost/cartesian_product_test',
     'test/boost/castas_fcts_test',
     'test/boost/cdc_generation_test',
@@ -463,6 +464,7 @@ scylla_tests = set([
     'test/boost/commitlog_cleanup_test',
     'test/boost/commitlog_test',
     'test/boost/compaction_group_test',
+    'test/boost/comparable_bytes_test',
     'test/boost/compound_test',
     'test/boost/compress_test',
     'test/boost/config_test',
@@ -536,9 +538,11 @@ scylla_tests = set([
     'test/boost/mvcc_test',
     'test/boost/network_topology_strategy_test',
     'test/boost/nonwrapping_interval_test',
+    'test/boost/object_block_cache_test',
     'test/boost/observable_test',
     'test/boost/partitioner_test',
     'test/boost/per_partition_rate_limit_test',
+    'test/boost/pooled_allocation_test',
     'test/boost/pretty_printers_test',
     'test/boost/querier_cache_test',
     'test/boost/query_processor_test',
@@ -621,6 +625,8 @@ scylla_tests = set([
     'test/perf/memory_footprint_test',
     'test/perf/perf_cache_eviction',
     'test/perf/perf_commitlog',
+    'test/perf/perf_compaction',
+    'test/perf/perf_mixed_workload',
     'test/perf/perf_cql_parser',
     'test/perf/perf_hash',
     'test/perf/perf_mutation',
@@ -641,7 +647,9 @@ perf_tests = set([
     'test/perf/perf_mutation_fragment',
     'test/perf/perf_idl',
     'test/perf/perf_vint',
+    'test/perf/perf_rate_limiter',
     'test/perf/perf_big_decimal',
+    'test/perf/perf_utf8',
 ])
 
 raft_tests = set([
@@ -786,6 +794,7 @@ scylla_raft_core = [
 ]
 
 scylla_core = (['message/messaging_service.cc',
+                'message/rpc_zstd_compressor.cc',
                 'replica/database.cc',
                 'replica/table.cc',
                 'replica/tablets.cc',
@@ -821,6 +830,7 @@ scylla_core = (['message/messaging_service.cc',
                 'row_cache.cc',
                 'schema_mutations.cc',
                 'generic_server.cc',
+                'utils/aligned_buffer_pool.cc',
                 'utils/array-search.cc',
                 'utils/base64.cc',
                 'utils/logalloc.cc',
@@ -840,6 +850,7 @@ scylla_core = (['message/messaging_service.cc',
                 'readers/multishard.cc',
                 'readers/mutation_reader.cc',
                 'readers/mutation_readers.cc',
+                'readers/shared_scan.cc',
                 'mutation_query.cc',
                 'keys.cc',
                 'counters.cc',
@@ -849,6 +860,7 @@ scylla_core = (['message/messaging_service.cc',
                 'sstables/sstables_manager.cc',
                 'sstables/sstable_set.cc',
                 'sstables/storage.cc',
+                'sstables/object_block_cache.cc',
                 'sstables/mx/partition_reversing_data_source.cc',
                 'sstables/mx/reader.cc',
                 'sstables/mx/writer.cc',
@@ -860,6 +872,7 @@ scylla_core = (['message/messaging_service.cc',
                 'compaction/compaction.cc',
                 'compaction/compaction_strategy.cc',
                 'compaction/size_tiered_compaction_strategy.cc',
+                'compaction/incremental_compaction_strategy.cc',
                 'compaction/leveled_compaction_strategy.cc',
                 'compaction/task_manager_module.cc',
                 'compaction/time_window_compaction_strategy.cc',
@@ -897,6 +910,7 @@ scylla_core = (['message/messaging_service.cc',
                 'cql3/expr/expression.cc',
                 'cql3/expr/restrictions.cc',
                 'cql3/expr/prepare_expr.cc',
+                'cql3/expr/prepared_filter.cc',
                 'cql3/functions/user_function.cc',
                 'cql3/functions/functions.cc',
                 'cql3/functions/aggregate_fcts.cc',
@@ -969,6 +983,7 @@ scylla_core = (['message/messaging_service.cc',
                 'utils/uuid.cc',
                 'utils/big_decimal.cc',
                 'types/types.cc',
+                'types/comparable_bytes.cc',
                 'validation.cc',
                 'service/migration_manager.cc',
                 'service/tablet_allocator.cc',
@@ -1006,6 +1021,8 @@ scylla_core = (['message/messaging_service.cc',
                 'db/commitlog/commitlog_replayer.cc',
                 'db/commitlog/commitlog_entry.cc',
                 'db/data_listeners.cc',
+                'db/hot_key_sampler.cc',
+                'db/cache_warmup.cc',
                 'db/functions/function.cc',
                 'db/hints/internal/hint_endpoint_manager.cc',
                 'db/hints/internal/hint_sender.cc',
@@ -1097,6 +1114,7 @@ scylla_core = (['message/messaging_service.cc',
                 'streaming/stream_request.cc',
                 'streaming/stream_summary.cc',
                 'streaming/stream_transfer_task.cc',
+                'streaming/stream_blob.cc',
                 'streaming/stream_receive_task.cc',
                 'streaming/stream_plan.cc',
                 'streaming/progress_info.cc',
@@ -1110,6 +1128,7 @@ scylla_core = (['message/messaging_service.cc',
                 'partition_slice_builder.cc',
                 'init.cc',
                 'utils/lister.cc',
+                'repair/range_summary.cc',
                 'repair/repair.cc',
                 'repair/row_level.cc',
                 'repair/table_check.cc',
@@ -1135,6 +1154,7 @@ scylla_core = (['message/messaging_service.cc',
                 'auth/certificate_authenticator.cc',
                 'tracing/tracing.cc',
                 'tracing/trace_keyspace_helper.cc',
+                'tracing/trace_log_helper.cc',
                 'tracing/trace_state.cc',
                 'tracing/traced_file.cc',
                 'table_helper.cc',
@@ -1142,6 +1162,7 @@ scylla_core = (['message/messaging_service.cc',
                 'tombstone_gc.cc',
                 'utils/disk-error-handler.cc',
                 'utils/hashers.cc',
+                'utils/alien_worker.cc',
                 'utils/aws_sigv4.cc',
                 'duration.cc',
                 'vint-serialization.cc',
@@ -1166,6 +1187,7 @@ scylla_core = (['message/messaging_service.cc',
                 'lang/wasm.cc',
                 'lang/wasm_alien_thread_runner.cc',
                 'lang/wasm_instance_cache.cc',
+                'lang/wasm_module_cache.cc',
                 'service/raft/group0_state_id_handler.cc',
                 'service/raft/group0_state_machine.cc',
                 'service/raft/group0_state_machine_merger.cc',
@@ -1393,6 +1415,7 @@ pure_boost_tests = set([
     'test/boost/map_difference_test',
     'test/boost/nonwrapping_interval_test',
     'test/boost/observable_test',
+    'test/boost/pooled_allocation_test',
     'test/boost/wrapping_interval_test',
     'test/boost/range_tombstone_list_test',
     'test/boost/serialization_test',
@@ -1411,7 +1434,9 @@ tests_not_using_seastar_test_framework = set([
     'test/manual/message',
     'test/perf/memory_footprint_test',
     'test/perf/perf_cache_eviction',
+    'test/perf/perf_compaction',
     'test/perf/perf_cql_parser',
+    'test/perf/perf_mixed_workload',
     'test/perf/perf_hash',
     'test/perf/perf_mutation',
     'test/perf/perf_collection',
@@ -1472,11 +1497,13 @@ deps['test/boost/summary_test'] = ['test/boost/summary_test.cc']
 deps['test/boost/anchorless_list_test'] = ['test/boost/anchorless_list_test.cc']
 deps['test/perf/perf_commitlog'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
 deps['test/perf/perf_row_cache_reads'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
+deps['test/perf/perf_mixed_workload'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
+deps['test/perf/perf_compaction'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc', 'tools/schema_loader.cc', 'tools/read_mutation.cc']
 deps['test/boost/reusable_buffer_test'] = [
     "test/boost/reusable_buffer_test.cc",
     "test/lib/log.cc",
 ]
-deps['test/boost/utf8_test'] = ['utils/utf8.cc', 'test/boost/utf8_test.cc']
+deps['test/boost/utf8_test'] = ['utils/utf8.cc', 'utils/ascii.cc', 'test/boost/utf8_test.cc']
 deps['test/boost/small_vector_test'] = ['test/boost/small_vector_test.cc']
 deps['test/boost/vint_serialization_test'] = ['test/boost/vint_serialization_test.cc', 'vint-serialization.cc', 'bytes.cc']
 deps['test/boost/linearizing_input_stream_test'] = [
@@ -820,9 +820,15 @@ c_cast_prepare_expression(const cast& c, data_dictionary::database db, const sst
     // Using this receiver makes it possible to write things like: (blob)(int)1234
     // Using the original receiver wouldn't work in such cases - it would complain
     // that untyped_constant(1234) isn't a valid blob constant.
+    expression prepared_arg = prepare_expression(c.arg, db, keyspace, schema_opt, cast_type_receiver);
+
+    // Casting a constant only reinterprets its value, so it's a constant of the receiver's type.
+    if (auto* value = as_if<constant>(&prepared_arg)) {
+        return constant(std::move(value->value), receiver->type);
+    }
     return cast{
         .style = cast::cast_style::c,
-        .arg = prepare_expression(c.arg, db, keyspace, schema_opt, cast_type_receiver),
+        .arg = std::move(prepared_arg),
         .type = receiver->type,
     };
 }
@@ -852,10 +858,15 @@ sql_cast_prepare_expression(const cast& c, data_dictionary::database db, const s
     auto fun = functions::get_castas_fctn_as_cql3_function(cast_type, type_of(*prepared_arg));
 
     // We implement the cast to a function_call.
-    return function_call{
-        .func = std::move(fun),
+    function_call fun_call{
+        .func = fun,
         .args = std::vector({*prepared_arg}),
     };
+    // Like other function calls, a cast of a constant can be evaluated now rather than at execution time.
+    if (is<constant>(*prepared_arg) && fun->is_pure() && !fun->requires_thread()) {
+        return constant(evaluate(fun_call, query_options::DEFAULT), fun->return_type());
+    }
+    return fun_call;
 }
 
 std::optional<expression>
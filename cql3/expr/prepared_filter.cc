@@ -0,0 +1,183 @@
+// Copyright (C) 2024-present ScyllaDB
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+#include <seastar/core/byteorder.hh>
+
+#include "prepared_filter.hh"
+#include "expr-utils.hh"
+#include "cql3/selection/selection.hh"
+#include "types/types.hh"
+
+namespace cql3::expr {
+
+extern logging::logger expr_logger;
+
+static bool satisfies(oper_t op, std::strong_ordering cmp) {
+    switch (op) {
+    case oper_t::EQ:
+        return cmp == 0;
+    case oper_t::NEQ:
+        return cmp != 0;
+    case oper_t::LT:
+        return cmp < 0;
+    case oper_t::LTE:
+        return cmp <= 0;
+    case oper_t::GT:
+        return cmp > 0;
+    case oper_t::GTE:
+        return cmp >= 0;
+    default:
+        on_internal_error(expr_logger, fmt::format("prepared_filter: unexpected operator {}", op));
+    }
+}
+
+static int64_t read_integer(bytes_view v) {
+    auto p = reinterpret_cast<const char*>(v.data());
+    switch (v.size()) {
+    case 1:
+        return read_be<int8_t>(p);
+    case 2:
+        return read_be<int16_t>(p);
+    case 4:
+        return read_be<int32_t>(p);
+    default:
+        return read_be<int64_t>(p);
+    }
+}
+
+// Returns the width of serialized values of the type if it can be compared without deserialization,
+// along with whether it compares as a signed integer.
+static std::optional<std::pair<size_t, bool>> fixed_width_comparison(const abstract_type& type, oper_t op) {
+    switch (type.get_kind()) {
+    case abstract_type::kind::byte:
+        return std::pair(1, true);
+    case abstract_type::kind::short_kind:
+        return std::pair(2, true);
+    case abstract_type::kind::int32:
+        return std::pair(4, true);
+    case abstract_type::kind::long_kind:
+    case abstract_type::kind::timestamp:
+        return std::pair(8, true);
+    case abstract_type::kind::uuid:
+    case abstract_type::kind::timeuuid:
+        // Ordering of uuids is not bytewise, but equality is.
+        if (op == oper_t::EQ || op == oper_t::NEQ) {
+            return std::pair(16, false);
+        }
+        return std::nullopt;
+    default:
+        return std::nullopt;
+    }
+}
+
+bool prepared_filter::comparison::is_satisfied_by(managed_bytes_view v) const {
+    if (v.size() != width) [[unlikely]] {
+        return satisfies(op, type->compare(v, managed_bytes_view(value)));
+    }
+    return v.with_linearized([&] (bytes_view bv) {
+        if (is_integer) {
+            return satisfies(op, read_integer(bv) <=> integer_value);
+        }
+        bool equal = managed_bytes_view(bv) == managed_bytes_view(value);
+        return (op == oper_t::EQ) == equal;
+    });
+}
+
+std::optional<prepared_filter::comparison> prepared_filter::prepare_comparison(const expression& e, const query_options& options) const {
+    auto binop = as_if<binary_operator>(&e);
+    if (!binop || !is_compare(binop->op) || binop->order != comparison_order::cql || binop->null_handling != null_handling_style::sql) {
+        return std::nullopt;
+    }
+    auto col = as_if<column_value>(&binop->lhs);
+    if (!col) {
+        return std::nullopt;
+    }
+    // The value must be the same for all rows.
+    if (find_in_expression<column_value>(binop->rhs, [] (const column_value&) { return true; })
+            || find_in_expression<subscript>(binop->rhs, [] (const subscript&) { return true; })
+            || find_in_expression<temporary>(binop->rhs, [] (const temporary&) { return true; })
+            || contains_nonpure_function(binop->rhs)) {
+        return std::nullopt;
+    }
+    auto& type = col->col->type->without_reversed();
+    auto fixed_width = fixed_width_comparison(type, binop->op);
+    if (!fixed_width) {
+        return std::nullopt;
+    }
+    auto value = evaluate(binop->rhs, options).to_managed_bytes_opt();
+    if (!value || value->size() != fixed_width->first) {
+        return std::nullopt;
+    }
+    auto [width, is_integer] = *fixed_width;
+    int64_t integer_value = is_integer ? value->with_linearized(read_integer) : 0;
+    return comparison{
+        .column = col->col,
+        .op = binop->op,
+        .width = width,
+        .is_integer = is_integer,
+        .integer_value = integer_value,
+        .value = std::move(*value),
+        .type = &type,
+    };
+}
+
+prepared_filter::prepared_filter(const expression& e, const query_options& options)
+    : _expr(e)
+{
+    for (auto& factor : boolean_factors(e)) {
+        auto c = prepare_comparison(factor, options);
+        if (!c) {
+            _comparisons.clear();
+            return;
+        }
+        _comparisons.push_back(std::move(*c));
+    }
+    _fast = true;
+}
+
+std::optional<managed_bytes_view> prepared_filter::get_value(size_t i, const evaluation_inputs& inputs) const {
+    auto& cdef = *_comparisons[i].column;
+    switch (cdef.kind) {
+    case column_kind::partition_key:
+        return managed_bytes_view(bytes_view(inputs.partition_key[cdef.id]));
+    case column_kind::clustering_key:
+        if (cdef.id >= inputs.clustering_key.size()) {
+            return std::nullopt;
+        }
+        return managed_bytes_view(bytes_view(inputs.clustering_key[cdef.id]));
+    default: {
+        if (_selection != inputs.selection) [[unlikely]] {
+            _selection_indexes.clear();
+            for (auto& c : _comparisons) {
+                _selection_indexes.push_back(c.column->is_primary_key() ? -1 : inputs.selection->index_of(*c.column));
+            }
+            _selection = inputs.selection;
+        }
+        auto index = _selection_indexes[i];
+        if (index == -1) {
+            throw std::runtime_error(format("Column definition {} does not match any column in the query selection", cdef.name_as_text()));
+        }
+        auto& v = inputs.static_and_regular_columns[index];
+        if (!v) {
+            return std::nullopt;
+        }
+        return managed_bytes_view(*v);
+    }
+    }
+}
+
+bool prepared_filter::is_satisfied_by(const evaluation_inputs& inputs) const {
+    if (!_fast) {
+        return expr::is_satisfied_by(_expr, inputs);
+    }
+    for (size_t i = 0; i < _comparisons.size(); ++i) {
+        auto v = get_value(i, inputs);
+        // A comparison with null is never satisfied.
+        if (!v || !_comparisons[i].is_satisfied_by(*v)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2024-present ScyllaDB
+// SPDX-License-Identifier: AGPL-3.0-or-later
+
+#pragma once
+
+#include "expression.hh"
+#include "evaluate.hh"
+
+namespace cql3 {
+
+class query_options;
+
+namespace selection {
+class selection;
+}
+
+}
+
+namespace cql3::expr {
+
+// A filtering restriction, prepared for evaluation against many rows.
+//
+// Filtering scans evaluate the same restriction against every row they read.
+// When the restriction is a conjunction of comparisons between a column of
+// a fixed-width type (tinyint, smallint, int, bigint, timestamp, and for
+// equality also uuid and timeuuid) and a value which doesn't depend on the
+// row, the values are evaluated and decoded once, up front, and every row
+// is then checked with plain integer comparisons on the serialized cells,
+// without walking the expression tree or copying values.
+//
+// Any other restriction is evaluated with is_satisfied_by().
+class prepared_filter {
+    struct comparison {
+        const column_definition* column;
+        oper_t op;
+        // Width of the serialized value, values of other sizes (e.g. empty) are compared by the type.
+        size_t width;
+        // Whether the value is compared as a big-endian signed integer, rather than for byte equality.
+        bool is_integer;
+        int64_t integer_value;
+        managed_bytes value;
+        const abstract_type* type;
+
+        bool is_satisfied_by(managed_bytes_view v) const;
+    };
+
+    const expression& _expr;
+    std::vector<comparison> _comparisons;
+    bool _fast = false;
+
+    // Positions of the non-primary-key columns of _comparisons in the selection, resolved on first use.
+    mutable const selection::selection* _selection = nullptr;
+    mutable std::vector<int32_t> _selection_indexes;
+
+    std::optional<comparison> prepare_comparison(const expression& e, const query_options& options) const;
+    std::optional<managed_bytes_view> get_value(size_t i, const evaluation_inputs& inputs) const;
+public:
+    // The expression must outlive the prepared_filter.
+    prepared_filter(const expression& e, const query_options& options);
+
+    bool is_satisfied_by(const evaluation_inputs& inputs) const;
+
+    // Whether rows are checked without evaluating the expression.
+    bool is_fast() const noexcept {
+        return _fast;
+    }
+};
+
+}
@@ -22,6 +22,7 @@
 #include "cql3/CqlParser.hpp"
 #include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
+#include "cql3/statements/select_statement.hh"
 #include "cql3/util.hh"
 #include "cql3/untyped_result_set.hh"
 #include "db/config.hh"
@@ -37,6 +38,7 @@ using namespace cql_transport::messages;
 
 logging::logger log("query_processor");
 logging::logger prep_cache_log("prepared_statements_cache");
+logging::logger unprep_cache_log("unprepared_statements_cache");
 logging::logger authorized_prepared_statements_cache_log("authorized_prepared_statements_cache");
 
 const sstring query_processor::CQL_VERSION = "3.3.1";
@@ -73,6 +75,7 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
         , _cql_config(cql_cfg)
         , _prepared_cache(prep_cache_log, _mcfg.prepared_statment_cache_size)
         , _authorized_prepared_cache(std::move(auth_prep_cache_cfg), authorized_prepared_statements_cache_log)
+        , _unprepared_cache(unprep_cache_log, _mcfg.unprepared_statement_cache_size)
         , _auth_prepared_cache_cfg_cb([this] (uint32_t) { (void) _authorized_prepared_cache_config_action.trigger_later(); })
         , _authorized_prepared_cache_config_action([this] { update_authorized_prepared_cache_config(); return make_ready_future<>(); })
         , _authorized_prepared_cache_update_interval_in_ms_observer(_db.get_config().permissions_update_interval_in_ms.observe(_auth_prepared_cache_cfg_cb))
@@ -344,6 +347,26 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
                             [this] { return _prepared_cache.memory_footprint(); },
                             sm::description("Size (in bytes) of the prepared statements cache.")),
 
+                    sm::make_counter(
+                            "unprepared_cache_hits",
+                            [] { return unprepared_statements_cache::shard_stats().hits; },
+                            sm::description("Counts the number of unprepared queries whose statement was found in the unprepared statements cache, and which didn't need to be parsed and prepared.")),
+
+                    sm::make_counter(
+                            "unprepared_cache_misses",
+                            [] { return unprepared_statements_cache::shard_stats().misses; },
+                            sm::description("Counts the number of unprepared queries whose statement wasn't found in the unprepared statements cache.")),
+
+                    sm::make_counter(
+                            "unprepared_cache_evictions",
+                            [] { return unprepared_statements_cache::shard_stats().evictions; },
+                            sm::description("Counts the number of unprepared statements cache entries evictions.")),
+
+                    sm::make_gauge(
+                            "unprepared_cache_size",
+                            [this] { return _unprepared_cache.size(); },
+                            sm::description("A number of entries in the unprepared statements cache.")),
+
                     sm::make_counter(
                             "secondary_index_creates",
                             _cql_stats.secondary_index_creates,
@@ -366,6 +389,12 @@ query_processor::query_processor(service::storage_proxy& proxy, data_dictionary:
                             _cql_stats.secondary_index_rows_read,
                             sm::description("Counts the total number of rows read during CQL requests performed using secondary indexes.")),
 
+                    // secondary_index_covered_reads total count is also included in secondary_index_reads
+                    sm::make_counter(
+                            "secondary_index_covered_reads",
+                            _cql_stats.secondary_index_covered_reads,
+                            sm::description("Counts the total number of CQL read requests performed using secondary indexes which were answered from the index alone, without reading the base table.")),
+
                     // read requests that required ALLOW FILTERING
                     sm::make_counter(
                             "filtered_read_requests",
@@ -522,6 +551,7 @@ future<> query_processor::stop_remote() {
 future<> query_processor::stop() {
     co_await _mnotifier.unregister_listener(_migration_subscriber.get());
     co_await _authorized_prepared_cache.stop();
+    co_await _unprepared_cache.stop();
     co_await _prepared_cache.stop();
 }
 
@@ -564,29 +594,54 @@ query_processor::execute_maybe_with_guard(service::query_state& query_state, ::s
     return execute_with_guard(std::bind_front(exec, std::ref(*this), std::forward<Args>(args)...), std::move(statement), query_state, options);
 }
 
+// Statements whose preparation is worth caching: those which are executed
+// over and over, and whose preparation doesn't depend on more than the query
+// text, keyspace and dialect.
+static bool is_cacheable_unprepared(const cql_statement& statement) {
+    return dynamic_cast<const statements::select_statement*>(&statement)
+        || dynamic_cast<const statements::modification_statement*>(&statement)
+        || dynamic_cast<const statements::batch_statement*>(&statement);
+}
+
 future<::shared_ptr<result_message>>
 query_processor::execute_direct_without_checking_exception_message(const sstring_view& query_string, service::query_state& query_state, dialect d, query_options& options) {
     log.trace("execute_direct: \"{}\"", query_string);
-    tracing::trace(query_state.get_trace_state(), "Parsing a statement");
-    auto p = get_statement(query_string, query_state.get_client_state(), d);
-    auto statement = p->statement;
-    const auto warnings = std::move(p->warnings);
+    auto& client_state = query_state.get_client_state();
+    std::unique_ptr<statements::prepared_statement> owned;
+    statements::prepared_statement::checked_weak_ptr cached;
+    std::optional<prepared_cache_key_type> key;
+    if (_unprepared_cache.enabled()) {
+        key.emplace(compute_id(query_string, client_state.get_raw_keyspace(), d));
+        cached = _unprepared_cache.find(*key);
+    }
+    if (cached) {
+        tracing::trace(query_state.get_trace_state(), "Using the cached statement");
+    } else {
+        tracing::trace(query_state.get_trace_state(), "Parsing a statement");
+        owned = get_statement(query_string, client_state, d);
+        if (key && is_cacheable_unprepared(*owned->statement)) {
+            cached = co_await _unprepared_cache.insert(*key, std::move(owned));
+        }
+    }
+    const statements::prepared_statement& p = owned ? *owned : *cached;
+    auto statement = p.statement;
+    const auto warnings = p.warnings;
     if (statement->get_bound_terms() != options.get_values_count()) {
         const auto msg = format("Invalid amount of bind variables: expected {:d} received {:d}",
                 statement->get_bound_terms(),
                 options.get_values_count());
         throw exceptions::invalid_request_exception(msg);
     }
-    options.prepare(p->bound_names);
+    options.prepare(p.bound_names);
 
     warn(unimplemented::cause::METRICS);
 #if 0
         if (!queryState.getClientState().isInternal)
             metrics.regularStatementsExecuted.inc();
 #endif
-    auto user = query_state.get_client_state().user();
+    auto user = client_state.user();
     tracing::trace(query_state.get_trace_state(), "Processing a statement for authenticated user: {}", user ? (user->name ? *user->name : "anonymous") : "no user authenticated");
-    return execute_maybe_with_guard(query_state, std::move(statement), options, &query_processor::do_execute_direct, std::move(warnings));
+    co_return co_await execute_maybe_with_guard(query_state, std::move(statement), options, &query_processor::do_execute_direct, std::move(warnings));
 }
 
 future<::shared_ptr<result_message>>
@@ -1137,6 +1192,9 @@ void query_processor::migration_subscriber::remove_invalid_prepared_statements(
     _qp->_prepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
         return this->should_invalidate(ks_name, cf_name, stmt);
     });
+    _qp->_unprepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
+        return this->should_invalidate(ks_name, cf_name, stmt);
+    });
 }
 
 bool query_processor::migration_subscriber::should_invalidate(
@@ -11,6 +11,7 @@
 #include "selection/selection.hh"
 #include "stats.hh"
 #include "utils/buffer_view-to-managed_bytes_view.hh"
+#include "utils/small_vector.hh"
 
 namespace cql3 {
 class untyped_result_set;
@@ -25,14 +26,36 @@ class result_generator {
     friend class untyped_result_set;
     template<typename Visitor>
     class query_result_visitor {
+        using key_views = utils::small_vector<bytes_view, 8>;
+
         const schema& _schema;
-        std::vector<bytes> _partition_key;
-        std::vector<bytes> _clustering_key;
+        // Views of the components of the current keys, which the result reader keeps alive.
+        // Only fragmented components, which are unexpected for keys, are copied to the storage.
+        key_views _partition_key;
+        key_views _clustering_key;
+        std::vector<bytes> _partition_key_storage;
+        std::vector<bytes> _clustering_key_storage;
         uint64_t _partition_row_count = 0;
         uint64_t _total_row_count = 0;
         Visitor& _visitor;
         const selection::selection& _selection;
     private:
+        template <typename Key>
+        void explode(const Key& key, key_views& views, std::vector<bytes>& storage) {
+            views.clear();
+            for (managed_bytes_view c : key.components(_schema)) {
+                if (!c.is_linearized()) [[unlikely]] {
+                    storage = key.explode(_schema);
+                    views.clear();
+                    for (auto& b : storage) {
+                        views.push_back(b);
+                    }
+                    return;
+                }
+                views.push_back(c.current_fragment());
+            }
+        }
+
         void accept_cell_value(const column_definition& def, query::result_row_view::iterator_type& i) {
             if (def.is_multi_cell()) {
                 _visitor.accept_value(utils::buffer_view_to_managed_bytes_view(i.next_collection_cell()));
@@ -46,7 +69,7 @@ class result_generator {
             : _schema(s), _visitor(visitor), _selection(select) { }
 
         void accept_new_partition(const partition_key& key, uint64_t row_count) {
-            _partition_key = key.explode(_schema);
+            explode(key, _partition_key, _partition_key_storage);
             accept_new_partition(row_count);
         }
         void accept_new_partition(uint64_t row_count) {
@@ -56,7 +79,7 @@ class result_generator {
 
         void accept_new_row(const clustering_key& key, query::result_row_view static_row,
                             query::result_row_view row) {
-            _clustering_key = key.explode(_schema);
+            explode(key, _clustering_key, _clustering_key_storage);
             accept_new_row(static_row, row);
         }
         void accept_new_row(query::result_row_view static_row, query::result_row_view row) {
@@ -66,11 +89,11 @@ class result_generator {
             for (auto&& def : _selection.get_columns()) {
                 switch (def->kind) {
                 case column_kind::partition_key:
-                    _visitor.accept_value(bytes_view(_partition_key[def->component_index()]));
+                    _visitor.accept_value(_partition_key[def->component_index()]);
                     break;
                 case column_kind::clustering_key:
                     if (_clustering_key.size() > def->component_index()) {
-                        _visitor.accept_value(bytes_view(_clustering_key[def->component_index()]));
+                        _visitor.accept_value(_clustering_key[def->component_index()]);
                     } else {
                         _visitor.accept_value(std::nullopt);
                     }
@@ -93,7 +116,7 @@ class result_generator {
                 auto static_row_iterator = static_row.iterator();
                 for (auto&& def : _selection.get_columns()) {
                     if (def->is_partition_key()) {
-                        _visitor.accept_value(bytes_view(_partition_key[def->component_index()]));
+                        _visitor.accept_value(_partition_key[def->component_index()]);
                     } else if (def->is_static()) {
                         accept_cell_value(*def, static_row_iterator);
                     } else {
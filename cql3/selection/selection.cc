@@ -624,8 +624,8 @@ result_set_builder::restrictions_filter::restrictions_filter(::shared_ptr<const
         uint64_t rows_fetched_for_last_partition)
     : _restrictions(restrictions)
     , _options(options)
-    , _partition_level_filter(_restrictions->get_partition_level_filter())
-    , _clustering_row_level_filter(_restrictions->get_clustering_row_level_filter())
+    , _partition_level_filter(_restrictions->get_partition_level_filter(), options)
+    , _clustering_row_level_filter(_restrictions->get_clustering_row_level_filter(), options)
     , _remaining(remaining)
     , _schema(schema)
     , _per_partition_limit(per_partition_limit)
@@ -647,8 +647,7 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
 
     auto static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
 
-    if (!expr::is_satisfied_by(
-                    _partition_level_filter,
+    if (!_partition_level_filter.is_satisfied_by(
                     expr::evaluation_inputs{
                         .partition_key = partition_key,
                         .clustering_key = clustering_key,
@@ -660,8 +659,7 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
         return false;
     }
 
-    if (!expr::is_satisfied_by(
-                    _clustering_row_level_filter,
+    if (!_clustering_row_level_filter.is_satisfied_by(
                     expr::evaluation_inputs{
                         .partition_key = partition_key,
                         .clustering_key = clustering_key,
@@ -17,6 +17,7 @@
 #include "selector.hh"
 #include "cql3/column_specification.hh"
 #include "cql3/functions/function.hh"
+#include "cql3/expr/prepared_filter.hh"
 #include "exceptions/exceptions.hh"
 #include "unimplemented.hh"
 #include <seastar/core/thread.hh>
@@ -208,8 +209,8 @@ class result_set_builder {
     class restrictions_filter {
         const ::shared_ptr<const restrictions::statement_restrictions> _restrictions;
         const query_options& _options;
-        const expr::expression& _partition_level_filter;
-        const expr::expression& _clustering_row_level_filter;
+        const expr::prepared_filter _partition_level_filter;
+        const expr::prepared_filter _clustering_row_level_filter;
         mutable bool _current_partition_does_not_match = false;
         mutable uint64_t _rows_dropped = 0;
         mutable uint64_t _remaining;
@@ -13,6 +13,7 @@
 #include "db/config.hh"
 #include "db/consistency_level_validations.hh"
 #include "data_dictionary/data_dictionary.hh"
+#include "replica/database.hh"
 #include <seastar/core/execution_stage.hh>
 #include "cas_request.hh"
 #include "cql3/query_processor.hh"
@@ -275,16 +276,29 @@ future<shared_ptr<cql_transport::messages::result_message>> batch_statement::do_
     _stats.statements_in_batches += _statements.size();
 
     auto timeout = db::timeout_clock::now() + get_timeout(query_state.get_client_state(), options);
-    return get_mutations(qp, options, timeout, local, now, query_state).then([this, &qp, &options, timeout, tr_state = query_state.get_trace_state(),
+    auto tablet_info = make_lw_shared<std::optional<locator::tablet_routing_info>>();
+    return get_mutations(qp, options, timeout, local, now, query_state).then([this, &qp, &options, &query_state, timeout, tablet_info, tr_state = query_state.get_trace_state(),
                                                                                                                                permit = query_state.get_permit()] (std::vector<mutation> ms) mutable {
+        // Drivers route a batch by its first statement, so they can learn from
+        // the batch where to send the next ones, if it writes to a single partition.
+        if (ms.size() == 1 && _statements.front().statement->_may_use_token_aware_routing
+                && query_state.get_client_state().is_protocol_extension_set(cql_transport::cql_protocol_extension::TABLETS_ROUTING_V1)) {
+            auto& table = ms.front().schema()->table();
+            if (table.uses_tablets()) {
+                *tablet_info = table.get_effective_replication_map()->check_locality(ms.front().token());
+            }
+        }
         return execute_without_conditions(qp, std::move(ms), options.get_consistency(), timeout, std::move(tr_state), std::move(permit));
-    }).then([] (coordinator_result<> res) {
+    }).then([tablet_info] (coordinator_result<> res) {
         if (!res) {
             return make_ready_future<shared_ptr<cql_transport::messages::result_message>>(
                     seastar::make_shared<cql_transport::messages::result_message::exception>(std::move(res).assume_error()));
         }
-        return make_ready_future<shared_ptr<cql_transport::messages::result_message>>(
-                make_shared<cql_transport::messages::result_message::void_message>());
+        auto result = make_shared<cql_transport::messages::result_message::void_message>();
+        if (*tablet_info) {
+            result->add_tablet_info((*tablet_info)->tablet_replicas, (*tablet_info)->token_range);
+        }
+        return make_ready_future<shared_ptr<cql_transport::messages::result_message>>(std::move(result));
     });
 }
 
@@ -311,6 +325,15 @@ future<coordinator_result<>> batch_statement::execute_without_conditions(
 
     bool mutate_atomic = true;
     if (_type != type::LOGGED) {
+        // The mutations of an unlogged batch are coordinated here, each with
+        // its own write handler, rather than being grouped by replica set and
+        // forwarded to a replica of each set to coordinate them. That would
+        // take a new verb whose receiver coordinates a set of mutations with
+        // the batch's consistency level and reports the per-mutation outcome
+        // back, so that timeouts, hints and write failures are accounted for
+        // as they are here. Clients wanting fewer hops should send batches
+        // which are single-partition (or use a token-aware driver and split
+        // them by token themselves), which is what unlogged batches are best at.
         _stats.batches_pure_unlogged += 1;
         mutate_atomic = false;
     } else {
@@ -128,6 +128,10 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
     if (per_partition_rate_limit_options && !db.features().typed_errors_in_read_rpc) {
         throw exceptions::configuration_exception("Per-partition rate limit is not supported yet by the whole cluster");
     }
+    if (per_partition_rate_limit_options && per_partition_rate_limit_options->get_accounting() == db::per_partition_rate_limit_accounting::sketch
+            && !db.features().per_partition_rate_limit_sketch) {
+        throw exceptions::configuration_exception("Sketch accounting of the per-partition rate limit is not supported yet by the whole cluster");
+    }
 
     auto tombstone_gc_options = get_tombstone_gc_options(schema_extensions);
     validate_tombstone_gc_options(tombstone_gc_options, db, ks_name);
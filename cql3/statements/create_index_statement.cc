@@ -167,6 +167,8 @@ std::vector<::shared_ptr<index_target>> create_index_statement::validate_while_e
         }
     }
 
+    validate_included_columns(*schema, targets);
+
     if (db.existing_index_names(keyspace()).contains(_index_name)) {
         if (!_if_not_exists) {
             throw exceptions::invalid_request_exception("Index already exists");
@@ -326,6 +328,40 @@ void create_index_statement::validate_targets_for_multi_column_index(std::vector
     }
 }
 
+void create_index_statement::validate_included_columns(const schema& schema, const std::vector<::shared_ptr<index_target>>& targets) const
+{
+    auto included = secondary_index::included_columns(_properties->get_raw_options());
+    if (included.empty()) {
+        return;
+    }
+    std::unordered_set<sstring> columns;
+    for (auto& name : included) {
+        auto cd = schema.get_column_definition(to_bytes(name));
+        if (!cd) {
+            throw exceptions::invalid_request_exception(format("No column definition found for included column {}", name));
+        }
+        if (!cd->is_regular()) {
+            throw exceptions::invalid_request_exception(format("Cannot include column {} in the index: only regular columns can be included", name));
+        }
+        if (!columns.emplace(name).second) {
+            throw exceptions::invalid_request_exception(format("Duplicate column {} in the included columns of the index", name));
+        }
+    }
+    for (auto& target : targets) {
+        auto* ident = std::get_if<::shared_ptr<column_identifier>>(&target->value);
+        if (!ident) {
+            continue;
+        }
+        auto cd = schema.get_column_definition((*ident)->name());
+        if (columns.contains(cd->name_as_text())) {
+            throw exceptions::invalid_request_exception(format("Cannot include the indexed column {} in the index", cd->name_as_text()));
+        }
+        if (cd->is_static()) {
+            throw exceptions::invalid_request_exception("Indexes on static columns cannot include other columns");
+        }
+    }
+}
+
 std::optional<create_index_statement::base_schema_with_new_index> create_index_statement::build_index_schema(data_dictionary::database db) const {
     auto targets = validate_while_executing(db);
 
@@ -348,6 +384,8 @@ std::optional<create_index_statement::base_schema_with_new_index> create_index_s
         index_options = _properties->get_options();
     } else {
         kind = schema->is_compound() ? index_metadata_kind::composites : index_metadata_kind::keys;
+        // The only option of a non-CUSTOM index is the list of included columns.
+        index_options = _properties->get_raw_options();
     }
     auto index = make_index_metadata(targets, accepted_name, kind, index_options);
     auto existing_index = schema->find_index_noname(index);
@@ -12,6 +12,7 @@
 #include <seastar/core/print.hh>
 #include "index_prop_defs.hh"
 #include "index/secondary_index.hh"
+#include "cql3/statements/index_target.hh"
 #include "exceptions/exceptions.hh"
 
 void cql3::statements::index_prop_defs::validate() {
@@ -26,8 +27,13 @@ void cql3::statements::index_prop_defs::validate() {
     if (!is_custom && custom_class) {
         throw exceptions::invalid_request_exception("Cannot specify index class for a non-CUSTOM index");
     }
-    if (!is_custom && !_properties.empty()) {
-        throw exceptions::invalid_request_exception("Cannot specify options for a non-CUSTOM index");
+    if (!is_custom) {
+        for (auto& [name, value] : get_raw_options()) {
+            if (name != index_target::include_option_name) {
+                throw exceptions::invalid_request_exception(
+                        format("Cannot specify option {} for a non-CUSTOM index, only {} is supported", name, index_target::include_option_name));
+            }
+        }
     }
     if (get_raw_options().count(
             db::index::secondary_index::custom_index_option_name)) {
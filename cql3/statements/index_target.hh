@@ -22,6 +22,10 @@ namespace statements {
 struct index_target {
     static const sstring target_option_name;
     static const sstring custom_index_option_name;
+    // Comma-separated list of the regular columns stored in the index view,
+    // besides the keys, so that queries selecting only them don't have to
+    // read the base table.
+    static const sstring include_option_name;
     static const boost::regex target_regex;
 
     enum class target_type {
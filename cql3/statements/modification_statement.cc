@@ -416,17 +416,21 @@ modification_statement::execute_with_condition(query_processor& qp, service::que
             );
     }
 
-    std::optional<locator::tablet_routing_info> tablet_info = locator::tablet_routing_info{locator::tablet_replica_set(), std::pair<dht::token, dht::token>()};
+    // An empty replica set adds no routing information to the result.
+    locator::tablet_routing_info tablet_info{locator::tablet_replica_set(), std::pair<dht::token, dht::token>()};
 
     auto&& table = s->table();
     if (_may_use_token_aware_routing && table.uses_tablets() && qs.get_client_state().is_protocol_extension_set(cql_transport::cql_protocol_extension::TABLETS_ROUTING_V1)) {
         auto erm = table.get_effective_replication_map();
-        tablet_info = erm->check_locality(token);
+        // Nothing to tell the driver if the request was routed correctly.
+        if (auto info = erm->check_locality(token)) {
+            tablet_info = std::move(*info);
+        }
     }
 
     return qp.proxy().cas(s, request, request->read_command(qp), request->key(),
             {read_timeout, qs.get_permit(), qs.get_client_state(), qs.get_trace_state()},
-            cl_for_paxos, cl_for_learn, statement_timeout, cas_timeout).then([this, request, tablet_replicas = std::move(tablet_info->tablet_replicas), token_range = tablet_info->token_range] (bool is_applied) {
+            cl_for_paxos, cl_for_learn, statement_timeout, cas_timeout).then([this, request, tablet_replicas = std::move(tablet_info.tablet_replicas), token_range = tablet_info.token_range] (bool is_applied) {
         auto result = request->build_cas_result_set(_metadata, _columns_of_cas_result_set, is_applied);
         result->add_tablet_info(tablet_replicas, token_range);
         return result;
@@ -53,6 +53,7 @@ class select_statement : public cf_statement
         const bool _allow_filtering;
         const statement_subtype _statement_subtype;
         bool _bypass_cache = false;
+        bool _cache_only = false;
     public:
         parameters();
         parameters(orderings_type orderings,
@@ -62,12 +63,14 @@ class select_statement : public cf_statement
             bool is_distinct,
             bool allow_filtering,
             statement_subtype statement_subtype,
-            bool bypass_cache);
+            bool bypass_cache,
+            bool cache_only = false);
         bool is_distinct() const;
         bool allow_filtering() const;
         bool is_json() const;
         bool is_mutation_fragments() const;
         bool bypass_cache() const;
+        bool cache_only() const;
         bool is_prune_materialized_view() const;
         orderings_type const& orderings() const;
     };
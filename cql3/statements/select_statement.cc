@@ -124,12 +124,14 @@ select_statement::parameters::parameters(orderings_type orderings,
                                          bool is_distinct,
                                          bool allow_filtering,
                                          statement_subtype statement_subtype,
-                                         bool bypass_cache)
+                                         bool bypass_cache,
+                                         bool cache_only)
     : _orderings{std::move(orderings)}
     , _is_distinct{is_distinct}
     , _allow_filtering{allow_filtering}
     , _statement_subtype{statement_subtype}
     , _bypass_cache{bypass_cache}
+    , _cache_only{cache_only}
 { }
 
 bool select_statement::parameters::is_distinct() const {
@@ -152,6 +154,10 @@ bool select_statement::parameters::bypass_cache() const {
     return _bypass_cache;
 }
 
+bool select_statement::parameters::cache_only() const {
+    return _cache_only;
+}
+
 bool select_statement::parameters::is_prune_materialized_view() const {
     return _statement_subtype == statement_subtype::PRUNE_MATERIALIZED_VIEW;
 }
@@ -202,8 +208,14 @@ select_statement::select_statement(schema_ptr schema,
 {
     _opts = _selection->get_query_options();
     _opts.set_if<query::partition_slice::option::bypass_cache>(_parameters->bypass_cache());
+    _opts.set_if<query::partition_slice::option::cache_only>(_parameters->cache_only());
     _opts.set_if<query::partition_slice::option::distinct>(_parameters->is_distinct());
     _opts.set_if<query::partition_slice::option::reversed>(_is_reversed);
+    // Without clustering restrictions or a per-partition limit, the slice doesn't
+    // depend on the bound values, so it is made once for all executions.
+    if (_parameters->is_distinct() || (!_restrictions->has_clustering_columns_restriction() && !_per_partition_limit)) {
+        _slice_template = do_make_partition_slice(query_options::DEFAULT);
+    }
 }
 
 db::timeout_clock::duration select_statement::get_timeout(const service::client_state& state, const query_options& options) const {
@@ -264,6 +276,18 @@ const sstring& select_statement::column_family() const {
 
 query::partition_slice
 select_statement::make_partition_slice(const query_options& options) const
+{
+    if (_is_reversed && !_parameters->is_distinct()) {
+        ++_stats.reverse_queries;
+    }
+    if (_slice_template) {
+        return *_slice_template;
+    }
+    return do_make_partition_slice(options);
+}
+
+query::partition_slice
+select_statement::do_make_partition_slice(const query_options& options) const
 {
     query::column_id_vector static_columns;
     query::column_id_vector regular_columns;
@@ -300,7 +324,6 @@ select_statement::make_partition_slice(const query_options& options) const
         for (auto& bound : bounds) {
             bound = query::reverse(bound);
         }
-        ++_stats.reverse_queries;
     }
 
     const uint64_t per_partition_limit = get_inner_loop_limit(get_limit(options, _per_partition_limit),
@@ -1041,6 +1064,32 @@ indexed_table_select_statement::indexed_table_select_statement(schema_ptr schema
         _get_partition_ranges_for_posting_list = [this] (const query_options& options) { return get_partition_ranges_for_global_index_posting_list(options); };
         _get_partition_slice_for_posting_list = [this] (const query_options& options) { return get_partition_slice_for_global_index_posting_list(options); };
     }
+    _covering_selection = make_covering_selection();
+}
+
+::shared_ptr<selection::selection> indexed_table_select_statement::make_covering_selection() const {
+    // The view has one row per indexed row only for indexes on regular
+    // values (a collection index has a row per matching element), and rows
+    // have to come out the way the posting list is read. Restrictions on the
+    // base key, other than the ones the posting list read applies, are
+    // applied by the base table query, so they also need the base table.
+    if (_index.included_columns().empty()
+            || _index.target_type() != cql3::statements::index_target::target_type::regular_values
+            || !_selection->is_trivial() || _selection->is_aggregate() || has_group_by() || _parameters->is_json()
+            || _restrictions_need_filtering || needs_post_query_ordering() || _is_reversed || _per_partition_limit
+            || (!_index.metadata().local() && !_restrictions->partition_key_restrictions_is_empty())
+            || _restrictions->has_clustering_columns_restriction()) {
+        return nullptr;
+    }
+    std::vector<const column_definition*> columns;
+    for (const column_definition* def : _selection->get_columns()) {
+        const column_definition* view_def = _view_schema->get_column_definition(def->name());
+        if (def->is_static() || !view_def || view_def->is_computed() || view_def->is_view_virtual()) {
+            return nullptr;
+        }
+        columns.push_back(view_def);
+    }
+    return selection::selection::for_columns(_view_schema, std::move(columns));
 }
 
 template<typename KeyType>
@@ -1189,6 +1238,10 @@ indexed_table_select_statement::do_execute(query_processor& qp,
     // used to fetch base rows, which go straight to the result set builder.
     // A local, internal copy of query_options is kept in order to keep updating
     // the paging state between requesting data from replicas.
+    if (_covering_selection) {
+        co_return co_await execute_covered_query(qp, state, options, now);
+    }
+
     const bool aggregate = _selection->is_aggregate() || has_group_by();
     if (aggregate) {
         cql3::selection::result_set_builder builder(*_selection, now, *_group_by_cell_indices);
@@ -1337,7 +1390,7 @@ indexed_table_select_statement::read_posting_list(query_processor& qp,
                   service::query_state& state,
                   gc_clock::time_point now,
                   db::timeout_clock::time_point timeout,
-                  bool include_base_clustering_key) const
+                  ::shared_ptr<selection::selection> selection) const
 {
     dht::partition_range_vector partition_ranges = _get_partition_ranges_for_posting_list(options);
     auto partition_slice = _get_partition_slice_for_posting_list(options);
@@ -1356,17 +1409,6 @@ indexed_table_select_statement::read_posting_list(query_processor& qp,
             query::is_first_page::no,
             options.get_timestamp(state));
 
-    std::vector<const column_definition*> columns;
-    for (const column_definition& cdef : _schema->partition_key_columns()) {
-        columns.emplace_back(_view_schema->get_column_definition(cdef.name()));
-    }
-    if (include_base_clustering_key) {
-        for (const column_definition& cdef : _schema->clustering_key_columns()) {
-            columns.emplace_back(_view_schema->get_column_definition(cdef.name()));
-        }
-    }
-    auto selection = selection::selection::for_columns(_view_schema, columns);
-
     int32_t page_size = options.get_page_size();
     if (page_size <= 0 || !service::pager::query_pagers::may_need_paging(*_view_schema, page_size, *cmd, partition_ranges)) {
         return qp.proxy().query_result(_view_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
@@ -1389,6 +1431,50 @@ indexed_table_select_statement::read_posting_list(query_processor& qp,
     }));
 }
 
+::shared_ptr<selection::selection> indexed_table_select_statement::posting_list_selection(bool include_base_clustering_key) const {
+    std::vector<const column_definition*> columns;
+    for (const column_definition& cdef : _schema->partition_key_columns()) {
+        columns.emplace_back(_view_schema->get_column_definition(cdef.name()));
+    }
+    if (include_base_clustering_key) {
+        for (const column_definition& cdef : _schema->clustering_key_columns()) {
+            columns.emplace_back(_view_schema->get_column_definition(cdef.name()));
+        }
+    }
+    return selection::selection::for_columns(_view_schema, std::move(columns));
+}
+
+// Reads the selected columns straight from the index view, when the index
+// includes all of them. The rows of the view are the rows of the base table
+// matching the index restriction, in the order the base table query would
+// return them, and the paging state is the one of the view, like the one
+// the base table query returns.
+future<shared_ptr<cql_transport::messages::result_message>>
+indexed_table_select_statement::execute_covered_query(query_processor& qp,
+                                                      service::query_state& state,
+                                                      const query_options& options,
+                                                      gc_clock::time_point now) const
+{
+    tracing::trace(state.get_trace_state(), "Index {} includes all the selected columns, not reading the base table", _index.metadata().name());
+    ++_stats.secondary_index_covered_reads;
+    auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
+    const uint64_t limit = get_inner_loop_limit(get_limit(options, _limit), false);
+    auto result = co_await read_posting_list(qp, options, limit, state, now, timeout, _covering_selection);
+    if (result.has_error()) {
+        co_return failed_result_to_result_message(std::move(result));
+    }
+    // The columns read from the view are the selected columns of the base
+    // table, in the same order, so only the metadata has to be replaced.
+    const auto& view_rs = result.assume_value()->rs().result_set();
+    auto metadata = ::make_shared<cql3::metadata>(*_selection->get_result_metadata());
+    metadata->maybe_set_paging_state(view_rs.get_metadata().paging_state());
+    auto builder = result_set::builder(std::move(metadata));
+    view_rs.visit(builder);
+    auto rs = std::make_unique<result_set>(std::move(builder).get_result_set());
+    update_stats_rows_read(rs->size());
+    co_return ::make_shared<cql_transport::messages::result_message::rows>(cql3::result(std::move(rs)));
+}
+
 // Note: the partitions keys returned by this function are sorted
 // in token order. See issue #3423.
 future<coordinator_result<std::tuple<dht::partition_range_vector, lw_shared_ptr<const service::pager::paging_state>>>>
@@ -1400,7 +1486,7 @@ indexed_table_select_statement::find_index_partition_ranges(query_processor& qp,
     auto now = gc_clock::now();
     auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
     const uint64_t limit = get_inner_loop_limit(get_limit(options, _limit), _selection->is_aggregate());
-    return read_posting_list(qp, options, limit, state, now, timeout, false).then(utils::result_wrap(
+    return read_posting_list(qp, options, limit, state, now, timeout, posting_list_selection(false)).then(utils::result_wrap(
             [this, &options] (::shared_ptr<cql_transport::messages::result_message::rows> rows) {
         auto rs = cql3::untyped_result_set(rows);
         dht::partition_range_vector partition_ranges;
@@ -1450,7 +1536,7 @@ indexed_table_select_statement::find_index_clustering_rows(query_processor& qp,
     auto now = gc_clock::now();
     auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
     const uint64_t limit = get_inner_loop_limit(get_limit(options, _limit), _selection->is_aggregate());
-    return read_posting_list(qp, options, limit, state, now, timeout, true).then(utils::result_wrap(
+    return read_posting_list(qp, options, limit, state, now, timeout, posting_list_selection(true)).then(utils::result_wrap(
             [this, &options] (::shared_ptr<cql_transport::messages::result_message::rows> rows) {
 
         auto rs = cql3::untyped_result_set(rows);
@@ -2028,6 +2114,17 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
                 "Grouping on clustering columns is not allowed for SELECT DISTINCT queries");
     }
 
+    if (_parameters->cache_only()) {
+        if (!db.features().cache_only_reads) {
+            throw exceptions::invalid_request_exception("CACHE ONLY is not supported until all nodes of the cluster are upgraded");
+        }
+        // Only the residency of whole partitions can be checked up front,
+        // a scan could miss the cache in any of the partitions it reaches.
+        if (restrictions->uses_secondary_indexing() || restrictions->is_key_range()) {
+            throw exceptions::invalid_request_exception("CACHE ONLY is only supported by queries which restrict the whole partition key by equality or IN");
+        }
+    }
+
     ::shared_ptr<cql3::statements::select_statement> stmt;
     auto prepared_attrs = _attrs->prepare(db, keyspace(), column_family());
     prepared_attrs->fill_prepare_context(ctx);
@@ -2067,9 +2164,11 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
             && group_by_cell_indices->empty()   // No GROUP BY
             && db.get_config().enable_parallelized_aggregation()
             && !is_local_table()
-            && !( // Do not parallelize the request if it's single partition read
+            && !( // Do not parallelize the request if it's single partition read, unless asked to
+                  // push the aggregation of (possibly wide) partitions down to their replicas
                 restrictions->partition_key_restrictions_is_all_eq() 
-                && restrictions->partition_key_restrictions_size() == schema->partition_key_size());
+                && restrictions->partition_key_restrictions_size() == schema->partition_key_size()
+                && !db.get_config().enable_parallelized_aggregation_for_single_partition());
     };
 
     if (_parameters->is_prune_materialized_view()) {
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "cql3/statements/raw/select_statement.hh"
+#include "query-request.hh"
 #include "cql3/expr/unset.hh"
 #include "cql3/cql_statement.hh"
 #include "cql3/stats.hh"
@@ -87,7 +88,10 @@ class select_statement : public cql_statement {
     bool _range_scan = false;
     bool _range_scan_no_bypass_cache = false;
     std::unique_ptr<cql3::attributes> _attrs;
+    // Engaged when the partition slice doesn't depend on the bound values.
+    std::optional<query::partition_slice> _slice_template;
 private:
+    query::partition_slice do_make_partition_slice(const query_options& options) const;
     future<shared_ptr<cql_transport::messages::result_message>> process_results_complex(foreign_ptr<lw_shared_ptr<query::result>> results,
         lw_shared_ptr<query::read_command> cmd, const query_options& options, gc_clock::time_point now) const;
 protected :
@@ -185,6 +189,10 @@ class indexed_table_select_statement : public select_statement {
     schema_ptr _view_schema;
     noncopyable_function<dht::partition_range_vector(const query_options&)> _get_partition_ranges_for_posting_list;
     noncopyable_function<query::partition_slice(const query_options&)> _get_partition_slice_for_posting_list;
+    // The columns of the index view answering the query, when the index
+    // includes all the selected columns, so that the base table doesn't have
+    // to be read. Null otherwise.
+    ::shared_ptr<selection::selection> _covering_selection;
 public:
     static constexpr size_t max_base_table_query_concurrency = 4096;
 
@@ -301,7 +309,16 @@ class indexed_table_select_statement : public select_statement {
             service::query_state& state,
             gc_clock::time_point now,
             db::timeout_clock::time_point timeout,
-            bool include_base_clustering_key) const;
+            ::shared_ptr<selection::selection> selection) const;
+
+    ::shared_ptr<selection::selection> posting_list_selection(bool include_base_clustering_key) const;
+    ::shared_ptr<selection::selection> make_covering_selection() const;
+
+    future<shared_ptr<cql_transport::messages::result_message>> execute_covered_query(
+            query_processor& qp,
+            service::query_state& state,
+            const query_options& options,
+            gc_clock::time_point now) const;
 
     dht::partition_range_vector get_partition_ranges_for_local_index_posting_list(const query_options& options) const;
     dht::partition_range_vector get_partition_ranges_for_global_index_posting_list(const query_options& options) const;
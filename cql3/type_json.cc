@@ -369,130 +369,114 @@ template <typename T> static T compose_value(const integer_type_impl<T>& t, byte
     return read_be<T>(reinterpret_cast<const char*>(bv.data()));
 }
 
-static sstring to_json_string_aux(const map_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+static void write_json_string(bytes_ostream& out, std::string_view s) {
+    out.write(s.data(), s.size());
+}
 
-    out << '{';
+static void write_json_aux(const map_type_impl& t, bytes_view bv, bytes_ostream& out) {
+    write_json_string(out, "{");
     auto size = read_collection_size(bv);
     for (int i = 0; i < size; ++i) {
         auto kb = read_collection_key(bv);
         auto vb = read_collection_value_nonnull(bv);
 
         if (i > 0) {
-            out << ", ";
+            write_json_string(out, ", ");
         }
 
         // Valid keys in JSON map must be quoted strings
         sstring string_key = to_json_string(*t.get_keys_type(), kb);
         bool is_unquoted = string_key.empty() || string_key[0] != '"';
         if (is_unquoted) {
-            out << '"';
+            write_json_string(out, "\"");
         }
-        out << string_key;
+        write_json_string(out, string_key);
         if (is_unquoted) {
-            out << '"';
+            write_json_string(out, "\"");
         }
-        out << ": ";
-        out << to_json_string(*t.get_values_type(), vb);
+        write_json_string(out, ": ");
+        write_json_string(*t.get_values_type(), vb, out);
     }
-    out << '}';
-    return std::move(out).str();
+    write_json_string(out, "}");
 }
 
-static sstring to_json_string_aux(const set_type_impl& t, bytes_view bv) {
+static void write_json_aux(const listlike_collection_type_impl& t, bytes_view bv, bytes_ostream& out) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
-    out << '[';
+    write_json_string(out, "[");
     managed_bytes_view mbv(bv);
     std::for_each(llpdi::begin(mbv), llpdi::end(mbv), [&first, &out, &t] (const managed_bytes_view_opt& e) {
         if (first) {
             first = false;
         } else {
-            out << ", ";
+            write_json_string(out, ", ");
         }
         if (e) {
-            out << to_json_string(*t.get_elements_type(), *e);
+            write_json_string(*t.get_elements_type(), *e, out);
         } else {
             // Impossible in sets, but let's not insist here.
-            out << "null";
+            write_json_string(out, "null");
         }
     });
-    out << ']';
-    return std::move(out).str();
+    write_json_string(out, "]");
 }
 
-static sstring to_json_string_aux(const list_type_impl& t, bytes_view bv) {
-    using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
-    bool first = true;
-    out << '[';
-    managed_bytes_view mbv(bv);
-    std::for_each(llpdi::begin(mbv), llpdi::end(mbv), [&first, &out, &t] (const managed_bytes_view_opt& e) {
-        if (first) {
-            first = false;
-        } else {
-            out << ", ";
-        }
-        if (e) {
-            out << to_json_string(*t.get_elements_type(), *e);
-        } else {
-            out << "null";
-        }
-    });
-    out << ']';
-    return std::move(out).str();
-}
-
-static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '[';
+static void write_json_aux(const tuple_type_impl& t, bytes_view bv, bytes_ostream& out) {
+    write_json_string(out, "[");
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            write_json_string(out, ", ");
         }
         if (*vi) {
-            // TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json_string(**ti, **vi, out);
         } else {
-            out << "null";
+            write_json_string(out, "null");
         }
         ++ti;
         ++vi;
     }
 
-    out << ']';
-    return std::move(out).str();
+    write_json_string(out, "]");
 }
 
-static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '{';
+static void write_json_aux(const user_type_impl& t, bytes_view bv, bytes_ostream& out) {
+    write_json_string(out, "{");
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     int i = 0;
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            write_json_string(out, ", ");
         }
-        out << quote_json_string(t.field_name_as_string(i)) << ": ";
+        write_json_string(out, quote_json_string(t.field_name_as_string(i)));
+        write_json_string(out, ": ");
         if (*vi) {
-            //TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json_string(**ti, **vi, out);
         } else {
-            out << "null";
+            write_json_string(out, "null");
         }
         ++ti;
         ++i;
         ++vi;
     }
 
-    out << '}';
-    return std::move(out).str();
+    write_json_string(out, "}");
+}
+
+template <typename CollectionType>
+static sstring to_json_string_aux(const CollectionType& t, bytes_view bv) {
+    bytes_ostream out;
+    write_json_aux(t, bv, out);
+    sstring ret(sstring::initialized_later(), out.size());
+    auto p = ret.begin();
+    for (bytes_view fragment : out) {
+        p = std::copy(fragment.begin(), fragment.end(), p);
+    }
+    return ret;
 }
 
 namespace {
@@ -552,12 +536,35 @@ struct to_json_string_visitor {
         return value_cast<utils::multiprecision_int>(v).str();
     }
 };
+
+// Like to_json_string_visitor, but writes the elements of collections straight
+// to the output rather than to strings of their own.
+struct write_json_string_visitor {
+    bytes_view bv;
+    bytes_ostream& out;
+    void operator()(const reversed_type_impl& t) { write_json_string(*t.underlying_type(), bv, out); }
+    void operator()(const map_type_impl& t) { write_json_aux(t, bv, out); }
+    void operator()(const set_type_impl& t) { write_json_aux(t, bv, out); }
+    void operator()(const list_type_impl& t) { write_json_aux(t, bv, out); }
+    void operator()(const tuple_type_impl& t) { write_json_aux(t, bv, out); }
+    void operator()(const user_type_impl& t) { write_json_aux(t, bv, out); }
+    void operator()(const counter_type_impl& t) { write_json_string(*counter_cell_view::total_value_type(), bv, out); }
+    template <typename T> void operator()(const T& t) { write_json_string(out, to_json_string_visitor{bv}(t)); }
+};
 }
 
 sstring to_json_string(const abstract_type& t, bytes_view bv) {
     return visit(t, to_json_string_visitor{bv});
 }
 
+void write_json_string(const abstract_type& t, bytes_view bv, bytes_ostream& out) {
+    visit(t, write_json_string_visitor{bv, out});
+}
+
+void write_json_string(const abstract_type& t, const managed_bytes_view& mbv, bytes_ostream& out) {
+    visit(t, write_json_string_visitor{linearized(mbv), out});
+}
+
 sstring to_json_string(const abstract_type& t, const managed_bytes_view& mbv) {
     return visit(t, to_json_string_visitor{linearized(mbv)});
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "bytes_ostream.hh"
 #include "types/types.hh"
 #include "utils/rjson.hh"
 
@@ -22,3 +23,16 @@ inline sstring to_json_string(const abstract_type &t, const bytes& b) {
 inline sstring to_json_string(const abstract_type& t, const bytes_opt& b) {
     return b ? to_json_string(t, *b) : "null";
 }
+
+// Appends the JSON representation of the value to out, like to_json_string(),
+// but without building intermediate strings for the elements of collections.
+void write_json_string(const abstract_type& t, bytes_view bv, bytes_ostream& out);
+void write_json_string(const abstract_type& t, const managed_bytes_view& bv, bytes_ostream& out);
+
+inline void write_json_string(const abstract_type& t, const bytes_opt& b, bytes_ostream& out) {
+    if (b) {
+        write_json_string(t, bytes_view(*b), out);
+    } else {
+        out.write("null", 4);
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "cql3/prepared_statements_cache.hh"
+
+namespace cql3 {
+
+/// \brief Cache of the statements of unprepared queries
+///
+/// Maps the text of a query (with the keyspace it was executed in, like the
+/// prepared statements cache) to its prepared statement, so that executing
+/// the same unprepared query again doesn't parse and prepare it again.
+///
+/// It is separate from the prepared statements cache, so that ad-hoc queries
+/// don't evict the statements prepared by the clients, which would have to
+/// prepare them again. Entries are invalidated on schema changes like prepared
+/// statements are.
+class unprepared_statements_cache {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    static stats& shard_stats() {
+        static thread_local stats _stats;
+        return _stats;
+    }
+
+    struct stats_updater {
+        static void inc_hits() noexcept {}
+        static void inc_misses() noexcept {}
+        static void inc_blocks() noexcept {}
+        static void inc_evictions() noexcept {
+            ++shard_stats().evictions;
+        }
+        static void inc_privileged_on_cache_size_eviction() noexcept {}
+        static void inc_unprivileged_on_cache_size_eviction() noexcept {}
+    };
+
+private:
+    using cache_key_type = typename prepared_cache_key_type::cache_key_type;
+    // A query executed only once stays in the unprivileged section, and is
+    // evicted before the queries which are repeated.
+    using cache_type = utils::loading_cache<cache_key_type, prepared_cache_entry, 1, utils::loading_cache_reload_enabled::no, prepared_cache_entry_size, std::hash<cache_key_type>, std::equal_to<cache_key_type>, stats_updater, stats_updater>;
+    using cache_value_ptr = typename cache_type::value_ptr;
+
+public:
+    using key_type = prepared_cache_key_type;
+    using value_type = typename statements::prepared_statement::checked_weak_ptr;
+
+private:
+    size_t _max_size;
+    cache_type _cache;
+
+public:
+    unprepared_statements_cache(logging::logger& logger, size_t size)
+        : _max_size(size)
+        // A zero expiry disables the cache, which can't be sized zero otherwise.
+        , _cache(size, size ? lowres_clock::duration(prepared_statements_cache::entry_expiry) : lowres_clock::duration(0), logger)
+    {}
+
+    // Whether the cache can hold any statement.
+    bool enabled() const noexcept {
+        return _max_size >= prepared_cache_entry_size()(nullptr);
+    }
+
+    value_type find(const key_type& key) {
+        cache_value_ptr vp = _cache.find(key.key());
+        if (vp) {
+            ++shard_stats().hits;
+            return (*vp)->checked_weak_from_this();
+        }
+        ++shard_stats().misses;
+        return value_type();
+    }
+
+    future<value_type> insert(const key_type& key, prepared_cache_entry entry) {
+        return _cache.get_ptr(key.key(), [entry = std::move(entry)] (const cache_key_type&) mutable {
+            return make_ready_future<prepared_cache_entry>(std::move(entry));
+        }).then([] (cache_value_ptr v_ptr) {
+            return make_ready_future<value_type>((*v_ptr)->checked_weak_from_this());
+        });
+    }
+
+    template <typename Pred>
+    requires std::is_invocable_r_v<bool, Pred, ::shared_ptr<cql_statement>>
+    void remove_if(Pred&& pred) {
+        _cache.remove_if([&pred] (const prepared_cache_entry& e) {
+            return pred(e->statement);
+        });
+    }
+
+    size_t size() const {
+        return _cache.size();
+    }
+
+    size_t memory_footprint() const {
+        return _cache.memory_footprint();
+    }
+
+    future<> stop() {
+        return _cache.stop();
+    }
+};
+
+}
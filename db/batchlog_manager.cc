@@ -152,31 +152,12 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
     // max rate is scaled by the number of nodes in the cluster (same as for HHOM - see CASSANDRA-5272).
     auto throttle = _replay_rate / _qp.proxy().get_token_metadata_ptr()->count_normal_token_owners();
     auto limiter = make_lw_shared<utils::rate_limiter>(throttle);
+    // Batches are independent of each other, so they are replayed concurrently,
+    // the scan moving on while up to replay_concurrency of them are in flight.
+    auto concurrency = make_lw_shared<semaphore>(replay_concurrency);
+    auto replays = make_lw_shared<gate>();
 
-    auto batch = [this, limiter](const cql3::untyped_result_set::row& row) -> future<stop_iteration> {
-        auto written_at = row.get_as<db_clock::time_point>("written_at");
-        auto id = row.get_as<utils::UUID>("id");
-        // enough time for the actual write + batchlog entry mutation delivery (two separate requests).
-        auto timeout = get_batch_log_timeout();
-        if (db_clock::now() < written_at + timeout) {
-            blogger.debug("Skipping replay of {}, too fresh", id);
-            return make_ready_future<stop_iteration>(stop_iteration::no);
-        }
-
-        // check version of serialization format
-        if (!row.has("version")) {
-            blogger.warn("Skipping logged batch because of unknown version");
-            return make_ready_future<stop_iteration>(stop_iteration::no);
-        }
-
-        auto version = row.get_as<int32_t>("version");
-        if (version != netw::messaging_service::current_version) {
-            blogger.warn("Skipping logged batch because of incorrect version");
-            return make_ready_future<stop_iteration>(stop_iteration::no);
-        }
-
-        auto data = row.get_blob("data");
-
+    auto replay = [this, limiter] (utils::UUID id, db_clock::time_point written_at, bytes data) -> future<> {
         blogger.debug("Replaying batch {}", id);
 
         auto fms = make_lw_shared<std::deque<canonical_mutation>>();
@@ -254,17 +235,55 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
             auto now = service::client_state(service::client_state::internal_tag()).get_timestamp();
             m.partition().apply_delete(*schema, clustering_key_prefix::make_empty(), tombstone(now, gc_clock::now()));
             return _qp.proxy().mutate_locally(m, tracing::trace_state_ptr(), db::commitlog::force_sync::no);
-        }).then([] { return make_ready_future<stop_iteration>(stop_iteration::no); });
+        });
+    };
+
+    auto batch = [this, concurrency, replays, replay = std::move(replay)] (const cql3::untyped_result_set::row& row) -> future<stop_iteration> {
+        auto written_at = row.get_as<db_clock::time_point>("written_at");
+        auto id = row.get_as<utils::UUID>("id");
+        // enough time for the actual write + batchlog entry mutation delivery (two separate requests).
+        auto timeout = get_batch_log_timeout();
+        if (db_clock::now() < written_at + timeout) {
+            blogger.debug("Skipping replay of {}, too fresh", id);
+            return make_ready_future<stop_iteration>(stop_iteration::no);
+        }
+
+        // check version of serialization format
+        if (!row.has("version")) {
+            blogger.warn("Skipping logged batch because of unknown version");
+            return make_ready_future<stop_iteration>(stop_iteration::no);
+        }
+
+        auto version = row.get_as<int32_t>("version");
+        if (version != netw::messaging_service::current_version) {
+            blogger.warn("Skipping logged batch because of incorrect version");
+            return make_ready_future<stop_iteration>(stop_iteration::no);
+        }
+
+        auto data = row.get_blob("data");
+
+        return get_units(*concurrency, 1).then([replay, replays, id, written_at, data = std::move(data)] (auto units) mutable {
+            // Batches which fail to replay are kept for the next lap, so there is nothing to do about a failure here.
+            (void)with_gate(*replays, [replay, id, written_at, data = std::move(data)] () mutable {
+                return replay(id, written_at, std::move(data));
+            }).handle_exception([id] (std::exception_ptr ep) {
+                blogger.warn("Failed to replay batch {}: {}", id, ep);
+            }).finally([units = std::move(units)] {});
+            return stop_iteration::no;
+        });
     };
 
-    return seastar::with_gate(_gate, [this, batch = std::move(batch)] () mutable {
+    return seastar::with_gate(_gate, [this, batch = std::move(batch), concurrency, replays] () mutable {
         blogger.debug("Started replayAllFailedBatches (cpu {})", this_shard_id());
         return _qp.query_internal(
                 format("SELECT id, data, written_at, version FROM {}.{} BYPASS CACHE", system_keyspace::NAME, system_keyspace::BATCHLOG),
                 db::consistency_level::ONE,
                 {},
                 page_size,
-                std::move(batch)).then([this] {
+                std::move(batch)).finally([concurrency, replays] {
+            // The replays in flight hold units of concurrency.
+            return replays->close();
+        }).then([this] {
             // Replaying batches could have generated tombstones, flush to disk,
             // where they can be compacted away.
             return replica::database::flush_table_on_all_shards(_qp.proxy().get_db(), system_keyspace::NAME, system_keyspace::BATCHLOG);
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "exceptions/exceptions.hh"
+#include "schema/schema.hh"
+#include "serializer.hh"
+#include "utils/i_filter.hh"
+
+namespace db {
+
+/**
+ * \brief Schema extension which represents the `bloom_filter_layout` per-table option.
+ *
+ * Selects how the bloom filters of the table's sstables lay out their bits:
+ * 'classic' (the default, compatible with all versions), 'split_block',
+ * which confines all bits of a key to a single cache line, or 'xor', which
+ * replaces the bloom filter with a smaller XOR filter.
+ */
+class bloom_filter_layout_extension : public schema_extension {
+    utils::filter_layout _layout = utils::filter_layout::classic;
+public:
+    static constexpr auto NAME = "bloom_filter_layout";
+
+    bloom_filter_layout_extension() = default;
+
+    explicit bloom_filter_layout_extension(utils::filter_layout layout)
+        : _layout(layout)
+    {}
+
+    explicit bloom_filter_layout_extension(const std::map<sstring, sstring>& map) {
+        throw exceptions::configuration_exception(format("{} must be a string", NAME));
+    }
+
+    explicit bloom_filter_layout_extension(bytes b) : _layout(parse(deserialize(b)))
+    {}
+
+    explicit bloom_filter_layout_extension(const sstring& s) : _layout(parse(s))
+    {}
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(to_string(_layout));
+    }
+
+    std::string options_to_string() const override {
+        return to_string(_layout);
+    }
+
+    static sstring deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, boost::type<sstring>());
+    }
+
+    utils::filter_layout get_layout() const {
+        return _layout;
+    }
+
+    static utils::filter_layout parse(const sstring& s) {
+        if (s == "classic") {
+            return utils::filter_layout::classic;
+        }
+        if (s == "split_block") {
+            return utils::filter_layout::split_block;
+        }
+        if (s == "xor") {
+            return utils::filter_layout::xor_filter;
+        }
+        throw exceptions::configuration_exception(format("Invalid {} '{}': must be 'classic', 'split_block' or 'xor'", NAME, s));
+    }
+
+    static sstring to_string(utils::filter_layout layout) {
+        switch (layout) {
+        case utils::filter_layout::classic: return "classic";
+        case utils::filter_layout::split_block: return "split_block";
+        case utils::filter_layout::xor_filter: return "xor";
+        }
+        std::abort();
+    }
+};
+
+} // namespace db
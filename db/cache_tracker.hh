@@ -47,6 +47,7 @@ class cache_tracker final {
         uint64_t row_misses;
         uint64_t partition_insertions;
         uint64_t row_insertions;
+        uint64_t row_probationary_insertions;
         uint64_t static_row_insertions;
         uint64_t concurrent_misses_same_key;
         uint64_t partition_merges;
@@ -89,6 +90,7 @@ class cache_tracker final {
     mutation_cleaner _memtable_cleaner;
     mutation_application_stats& _app_stats;
     utils::updateable_value<double> _index_cache_fraction;
+    utils::updateable_value<bool> _scan_resistant_admission{false};
 private:
     void setup_metrics();
 public:
@@ -104,6 +106,19 @@ class cache_tracker final {
     void insert(partition_version&) noexcept;
     void insert(mutation_partition_v2&) noexcept;
     void insert(rows_entry&) noexcept;
+    // Inserts a row populated by a range scan. With scan-resistant admission
+    // enabled, the row goes to the head of the LRU, so it is evicted before
+    // any other row unless it is accessed again: a touch moves it to the
+    // tail, like any other row. This way a scan which doesn't fit in the cache
+    // evicts its own rows instead of the hot set.
+    void insert_probationary(rows_entry&) noexcept;
+    // Inserts a row of a table with a low cache priority (see
+    // caching_options::low_priority()) at the head of the LRU, whatever
+    // read populated it and regardless of scan-resistant admission.
+    void insert_low_priority(rows_entry&) noexcept;
+    // Like insert(cache_entry&), for a new entry of a table with a low cache
+    // priority. The entry must have a single version.
+    void insert_low_priority(cache_entry&);
     void remove(rows_entry&) noexcept;
     // Inserts e such that it will be evicted right before more_recent in the absence of later touches.
     void insert(rows_entry& more_recent, rows_entry& e) noexcept;
@@ -136,6 +151,9 @@ class cache_tracker final {
     const stats& get_stats() const noexcept { return _stats; }
     stats& get_stats() noexcept { return _stats; }
     void set_compaction_scheduling_group(seastar::scheduling_group);
+    void set_scan_resistant_admission(utils::updateable_value<bool> enabled) {
+        _scan_resistant_admission = std::move(enabled);
+    }
     lru& get_lru() { return _lru; }
     cached_file_stats& get_index_cached_file_stats() { return _index_cached_file_stats; }
     partition_index_cache_stats& get_partition_index_cache_stats() { return _partition_index_cache_stats; }
@@ -158,6 +176,23 @@ void cache_tracker::insert(rows_entry& entry) noexcept {
     _lru.add(entry);
 }
 
+inline
+void cache_tracker::insert_probationary(rows_entry& entry) noexcept {
+    if (!_scan_resistant_admission()) {
+        insert(entry);
+        return;
+    }
+    insert_low_priority(entry);
+}
+
+inline
+void cache_tracker::insert_low_priority(rows_entry& entry) noexcept {
+    ++_stats.row_insertions;
+    ++_stats.row_probationary_insertions;
+    ++_stats.rows;
+    _lru.add_probationary(entry);
+}
+
 inline
 void cache_tracker::insert(rows_entry& more_recent, rows_entry& entry) noexcept {
     ++_stats.row_insertions;
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/algorithm/string.hpp>
+#include <fmt/std.h>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/util/file.hh>
+
+#include "db/cache_warmup.hh"
+#include "replica/database.hh"
+#include "utils/lister.hh"
+#include "utils/log.hh"
+
+static logging::logger cwlogger("cache_warmup");
+
+namespace db {
+
+static constexpr std::string_view file_prefix = "hot_partitions-";
+
+cache_warmup::cache_warmup(sharded<replica::database>& db, config cfg)
+    : _db(db)
+    , _cfg(std::move(cfg))
+{}
+
+std::filesystem::path cache_warmup::file_of(shard_id shard) const {
+    return _cfg.directory / fmt::format("{}{}", file_prefix, shard);
+}
+
+future<> cache_warmup::start() {
+    if (_cfg.save_period.count() == 0) {
+        co_return;
+    }
+    co_await recursive_touch_directory(_cfg.directory.native());
+    _done = with_scheduling_group(_cfg.scheduling_group, [this] { return run(); });
+}
+
+future<> cache_warmup::stop() {
+    if (_cfg.save_period.count() == 0) {
+        co_return;
+    }
+    _as.request_abort();
+    co_await std::move(_done);
+    // Save the hot set of this run, in particular before a rolling restart.
+    co_await save();
+}
+
+future<> cache_warmup::run() {
+    try {
+        co_await replay();
+    } catch (...) {
+        cwlogger.warn("Failed to warm up the cache: {}", std::current_exception());
+    }
+    while (!_as.abort_requested()) {
+        try {
+            co_await sleep_abortable(_cfg.save_period, _as);
+        } catch (const sleep_aborted&) {
+            break;
+        }
+        co_await save();
+    }
+}
+
+future<> cache_warmup::save() {
+    // One line per partition: the table id and the hex-encoded partition key.
+    sstring contents;
+    co_await _db.local().get_tables_metadata().for_each_table_gently([&] (table_id id, lw_shared_ptr<replica::table> t) -> future<> {
+        for (auto& dk : t->get_stats().hot_keys.top_read_keys(partitions_per_table)) {
+            contents += fmt::format("{} {}\n", id, to_hex(dk.key().representation()));
+        }
+        co_await coroutine::maybe_yield();
+    });
+
+    // Written under a temporary name and renamed, so that a partially written file is never replayed.
+    auto path = file_of(this_shard_id());
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    std::exception_ptr ex;
+    try {
+        auto f = co_await open_file_dma(tmp_path.native(), open_flags::wo | open_flags::create | open_flags::truncate);
+        auto out = co_await make_file_output_stream(std::move(f));
+        try {
+            co_await out.write(contents.data(), contents.size());
+            co_await out.flush();
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await out.close();
+        if (!ex) {
+            co_await rename_file(tmp_path.native(), path.native());
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        cwlogger.warn("Failed to save hot partitions to {}: {}", path, ex);
+    }
+}
+
+future<> cache_warmup::replay() {
+    std::vector<std::filesystem::path> files;
+    co_await lister::scan_dir(_cfg.directory, lister::dir_entry_types::of<directory_entry_type::regular>(), [&] (std::filesystem::path dir, directory_entry de) {
+        if (de.name.starts_with(file_prefix) && !de.name.ends_with(".tmp")) {
+            files.push_back(dir / de.name);
+        }
+        return make_ready_future<>();
+    });
+
+    uint64_t warmed_up = 0;
+    auto& db = _db.local();
+    for (auto& file : files) {
+        auto contents = co_await util::read_entire_file_contiguous(file);
+        std::vector<std::string_view> lines;
+        boost::split(lines, std::string_view(contents), boost::is_any_of("\n"), boost::token_compress_on);
+        for (auto line : lines) {
+            if (_as.abort_requested()) {
+                co_return;
+            }
+            auto space = line.find(' ');
+            if (space == std::string_view::npos) {
+                continue;
+            }
+            lw_shared_ptr<replica::table> t;
+            partition_key key = partition_key::make_empty();
+            try {
+                t = db.get_tables_metadata().get_table_if_exists(table_id(utils::UUID(line.substr(0, space))));
+                key = partition_key::from_bytes(from_hex(line.substr(space + 1)));
+            } catch (...) {
+                cwlogger.debug("Skipping malformed line in {}: {}", file, std::current_exception());
+                continue;
+            }
+            if (!t) {
+                continue;
+            }
+            auto dk = dht::decorate_key(*t->schema(), std::move(key));
+            // The owner of the partition reads it, every shard reads all the files.
+            if (t->shard_for_reads(dk.token()) != this_shard_id()) {
+                continue;
+            }
+            try {
+                auto holder = t->async_gate().hold();
+                co_await warm_up(*t, dk);
+                ++warmed_up;
+            } catch (...) {
+                cwlogger.debug("Failed to warm up partition {} of {}.{}: {}", dk, t->schema()->ks_name(), t->schema()->cf_name(), std::current_exception());
+            }
+        }
+    }
+    cwlogger.info("Read {} partitions into cache", warmed_up);
+
+    // Files of shards which don't exist anymore won't be saved again.
+    if (this_shard_id() == 0) {
+        for (auto& file : files) {
+            auto shard = file.filename().native().substr(file_prefix.size());
+            if (std::stoul(shard) >= smp::count) {
+                co_await remove_file(file.native());
+            }
+        }
+    }
+}
+
+future<> cache_warmup::warm_up(replica::table& t, const dht::decorated_key& dk) {
+    auto s = t.schema();
+    auto permit = co_await t.streaming_read_concurrency_semaphore().obtain_permit(s, "cache_warmup", t.estimate_read_memory_cost(), db::no_timeout, {});
+    auto pr = dht::partition_range::make_singular(dk);
+    auto rd = t.make_reader_v2(s, std::move(permit), pr, s->full_slice());
+    std::exception_ptr ex;
+    try {
+        // Reading populates the cache.
+        co_await rd.consume_pausable([] (mutation_fragment_v2) { return stop_iteration::no; });
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await rd.close();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+}
+
+} // namespace db
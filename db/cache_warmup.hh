@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/sharded.hh>
+
+#include "dht/decorated_key.hh"
+#include "seastarx.hh"
+
+namespace replica {
+class database;
+class table;
+}
+
+namespace db {
+
+// Warms up the row cache after a restart with the partitions which were hot before it.
+//
+// Every save_period, and when stopped, each shard writes the keys of the partitions
+// most read from the cache of each table, as sampled by the table's hot_key_sampler,
+// to its file in the directory. On start, every shard reads the files of all shards
+// of the previous run, since the sharding may have changed since, and reads the
+// partitions it owns into cache. The partitions are read in the background, in the
+// given scheduling group and under the streaming read concurrency semaphore, so
+// that warming up yields to user reads and doesn't delay the startup.
+class cache_warmup : public peering_sharded_service<cache_warmup> {
+public:
+    struct config {
+        std::filesystem::path directory;
+        // 0 disables saving and warming up.
+        std::chrono::seconds save_period;
+        seastar::scheduling_group scheduling_group;
+    };
+
+    static constexpr unsigned partitions_per_table = 64;
+
+private:
+    sharded<replica::database>& _db;
+    config _cfg;
+    abort_source _as;
+    future<> _done = make_ready_future<>();
+
+    std::filesystem::path file_of(shard_id shard) const;
+    future<> run();
+    future<> replay();
+    future<> warm_up(replica::table& t, const dht::decorated_key& dk);
+public:
+    cache_warmup(sharded<replica::database>& db, config cfg);
+
+    future<> start();
+    future<> stop();
+
+    // Writes the hot partitions of this shard.
+    future<> save();
+};
+
+} // namespace db
@@ -109,6 +109,8 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
     c.extensions = &cfg.extensions();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.use_vectored_writes = cfg.commitlog_use_vectored_writes();
+    c.entry_compression_threshold = size_t(cfg.commitlog_compression_threshold_in_kb()) * 1024;
     c.allow_going_over_size_limit = !cfg.commitlog_use_hard_size_limit();
 
     if (cfg.commitlog_flush_threshold_in_mb() >= 0) {
@@ -382,6 +384,7 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         uint64_t segments_created = 0;
         uint64_t segments_destroyed = 0;
         uint64_t pending_flushes = 0;
+        uint64_t pending_writes = 0;
         uint64_t flush_limit_exceeded = 0;
         uint64_t buffer_list_bytes = 0;
         // size on disk, actually used - i.e. containing data (allocate+cycle)
@@ -866,6 +869,9 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         return _file.known_size();
     }
 
+    size_t entry_compression_threshold() const {
+        return _segment_manager->cfg.entry_compression_threshold;
+    }
     bool is_schema_version_known(schema_ptr s) {
         return _known_schema_versions.contains(s->version());
     }
@@ -1024,6 +1030,14 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         co_return me;
     }
 
+    static std::vector<iovec> to_iovec(fragmented_temporary_buffer::view view) {
+        std::vector<iovec> iov;
+        for (auto fragment : view) {
+            iov.push_back(iovec{const_cast<char*>(reinterpret_cast<const char*>(fragment.data())), fragment.size()});
+        }
+        return iov;
+    }
+
     /**
      * Allocate a new buffer
      */
@@ -1187,10 +1201,18 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
             co_await coroutine::switch_to(_segment_manager->cfg.sched_group);
 
+            const bool vectored = _segment_manager->cfg.use_vectored_writes;
+
             for (;;) {
                 auto current = *view.begin();
                 try {
-                    auto bytes = co_await _file.dma_write(off, current.data(), current.size());
+                    scope_increment_counter pending(_segment_manager->totals.pending_writes);
+                    // In vectored mode, all fragments of the buffer are handed to
+                    // the reactor as a single write instead of one submission per
+                    // fragment.
+                    auto bytes = vectored
+                        ? co_await _file.dma_write(off, to_iovec(view))
+                        : co_await _file.dma_write(off, current.data(), current.size());
                     _segment_manager->totals.bytes_written += bytes;
                     _segment_manager->totals.active_size_on_disk += bytes;
                     ++_segment_manager->totals.cycle_count;
@@ -2104,6 +2126,9 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
         sm::make_gauge("pending_flushes", totals.pending_flushes,
                        sm::description("Holds number of currently pending flushes. See the related flush_limit_exceeded metric.")),
 
+        sm::make_gauge("pending_writes", totals.pending_writes,
+                       sm::description("Holds number of currently in-flight segment write submissions.")),
+
         sm::make_gauge("pending_allocations", [this] { return pending_allocations(); },
                        sm::description("Holds number of currently pending allocations. "
                                        "A non-zero value indicates that we have a bottleneck in the disk write flow.")),
@@ -3061,6 +3086,7 @@ future<db::rp_handle> db::commitlog::add_entry(const cf_id_type& id, const commi
             return _writer.schema()->id();
         }
         size_t size(segment& seg) override {
+            _writer.set_compression_threshold(seg.entry_compression_threshold());
             _writer.set_with_schema(!seg.is_schema_version_known(_writer.schema()));
             return _writer.size();
         }
@@ -3116,6 +3142,7 @@ db::commitlog::add_entries(std::vector<commitlog_entry_writer> entry_writers, db
                 if (!known) {
                     _known.emplace(i->schema()->version());
                 }
+                i->set_compression_threshold(seg.entry_compression_threshold());
                 i->set_with_schema(!known);
                 res += i->size();
             }
@@ -3125,6 +3152,7 @@ db::commitlog::add_entries(std::vector<commitlog_entry_writer> entry_writers, db
         size_t size(segment& seg, size_t i) override {
             auto& w = _writers.at(i);
             if (_sizes_computed != &seg) {
+                w.set_compression_threshold(seg.entry_compression_threshold());
                 w.set_with_schema(seg.is_schema_version_known(w.schema())); 
             }
             return w.size();
@@ -107,9 +107,14 @@ class commitlog {
         std::string fname_prefix = descriptor::FILENAME_PREFIX;
 
         bool use_o_dsync = false;
+        // Submit each buffer cycle as a single vectored write.
+        bool use_vectored_writes = false;
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = true;
         bool allow_fragmented_entries = false;
+        // Entries of mutations at least this large are compressed, 0 disables
+        // entry compression. See commitlog_entry_writer::set_compression_threshold().
+        size_t entry_compression_threshold = 0;
 
         // The base segment ID to use.
         // The segment IDs of newly allocated segments will be issued sequentially
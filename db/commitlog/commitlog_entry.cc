@@ -11,8 +11,84 @@
 #include "idl/commitlog.dist.hh"
 #include "idl/commitlog.dist.impl.hh"
 
+#include <lz4.h>
+
+#include <seastar/core/byteorder.hh>
 #include <seastar/core/simple-stream.hh>
 
+// A compressed entry starts with a magic number in place of the size of the
+// serialized commitlog_entry, which can't be that large, followed by the size
+// of the uncompressed entry. The uncompressed entry follows, compressed in
+// chunks of compression_chunk_size bytes (the last one may be shorter), each
+// of them prefixed by its compressed size:
+//
+//   magic : u32 | size : u32 | (compressed size : u32 | LZ4 block)[]
+//
+// so that neither compression nor decompression needs the whole entry to be
+// contiguous in memory.
+static constexpr uint32_t compressed_entry_magic = 0xfffffffd;
+static constexpr size_t compression_chunk_size = 64 * 1024;
+
+static bytes_ostream compress_entry(const bytes_ostream& raw) {
+    bytes_ostream out;
+    ser::serialize(out, compressed_entry_magic);
+    ser::serialize(out, uint32_t(raw.size()));
+
+    auto chunk = std::make_unique<char[]>(compression_chunk_size);
+    size_t chunk_size = 0;
+    auto compress_chunk = [&] {
+        auto bound = LZ4_compressBound(chunk_size);
+        auto dst = reinterpret_cast<char*>(out.write_place_holder(sizeof(uint32_t) + bound));
+        auto len = LZ4_compress_default(chunk.get(), dst + sizeof(uint32_t), chunk_size, bound);
+        if (len <= 0) {
+            throw std::runtime_error("commitlog: failed to compress entry");
+        }
+        write_le<uint32_t>(dst, len);
+        out.remove_suffix(bound - len);
+        chunk_size = 0;
+    };
+    for (bytes_view frag : raw) {
+        while (!frag.empty()) {
+            auto n = std::min(frag.size(), compression_chunk_size - chunk_size);
+            std::copy_n(reinterpret_cast<const char*>(frag.data()), n, chunk.get() + chunk_size);
+            chunk_size += n;
+            frag.remove_prefix(n);
+            if (chunk_size == compression_chunk_size) {
+                compress_chunk();
+            }
+        }
+    }
+    if (chunk_size) {
+        compress_chunk();
+    }
+    return out;
+}
+
+// Reads the entry after the magic number.
+template<typename Input>
+static fragmented_temporary_buffer decompress_entry(Input& in) {
+    auto size = ser::deserialize(in, boost::type<uint32_t>());
+    const auto max_compressed_size = size_t(LZ4_compressBound(compression_chunk_size));
+    auto compressed = std::make_unique<char[]>(max_compressed_size);
+    std::vector<temporary_buffer<char>> chunks;
+    chunks.reserve((size + compression_chunk_size - 1) / compression_chunk_size);
+    for (size_t done = 0; done < size;) {
+        auto chunk_size = std::min<size_t>(size - done, compression_chunk_size);
+        auto len = ser::deserialize(in, boost::type<uint32_t>());
+        if (len > max_compressed_size) {
+            throw std::runtime_error(format("commitlog: corrupt compressed entry, chunk of {} bytes", len));
+        }
+        in.read(compressed.get(), len);
+        temporary_buffer<char> chunk(chunk_size);
+        if (LZ4_decompress_safe(compressed.get(), chunk.get_write(), len, chunk_size) != int(chunk_size)) {
+            throw std::runtime_error("commitlog: corrupt compressed entry");
+        }
+        chunks.emplace_back(std::move(chunk));
+        done += chunk_size;
+    }
+    return fragmented_temporary_buffer(std::move(chunks), size);
+}
+
 template<typename Output>
 void commitlog_entry_writer::serialize(Output& out) const {
     [this, wr = ser::writer_of_commitlog_entry<Output>(out)] () mutable {
@@ -25,18 +101,45 @@ void commitlog_entry_writer::serialize(Output& out) const {
 }
 
 void commitlog_entry_writer::compute_size() {
+    _compressed = nullptr;
+    if (_compression_threshold && mutation_size() >= _compression_threshold) {
+        bytes_ostream raw;
+        serialize(raw);
+        auto compressed = compress_entry(raw);
+        if (compressed.size() <= raw.size() - raw.size() / 8) {
+            _size = compressed.size();
+            _compressed = make_lw_shared<const bytes_ostream>(std::move(compressed));
+        } else {
+            _size = raw.size();
+        }
+        return;
+    }
     seastar::measuring_output_stream ms;
     serialize(ms);
     _size = ms.size();
 }
 
 void commitlog_entry_writer::write(ostream& out) const {
+    if (_compressed) {
+        for (bytes_view frag : *_compressed) {
+            out.write(reinterpret_cast<const char*>(frag.data()), frag.size());
+        }
+        return;
+    }
     serialize(out);
 }
 
 commitlog_entry_reader::commitlog_entry_reader(const fragmented_temporary_buffer& buffer)
     : _ce([&] {
     auto in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(buffer).begin(), buffer.size_bytes());
+    if (buffer.size_bytes() >= 2 * sizeof(uint32_t)) {
+        auto header = in;
+        if (ser::deserialize(header, boost::type<uint32_t>()) == compressed_entry_magic) {
+            auto raw = decompress_entry(header);
+            auto raw_in = seastar::fragmented_memory_input_stream(fragmented_temporary_buffer::view(raw).begin(), raw.size_bytes());
+            return ser::deserialize(raw_in, boost::type<commitlog_entry>());
+        }
+    }
     return ser::deserialize(in, boost::type<commitlog_entry>());
 }())
 {
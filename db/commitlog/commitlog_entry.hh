@@ -11,6 +11,7 @@
 #include "utils/assert.hh"
 #include <optional>
 
+#include "bytes_ostream.hh"
 #include "commitlog_types.hh"
 #include "mutation/frozen_mutation.hh"
 #include "schema/schema_fwd.hh"
@@ -92,6 +93,10 @@ class commitlog_entry_writer {
     bool _with_schema = true;
     size_t _size = std::numeric_limits<size_t>::max();
     force_sync _sync;
+    size_t _compression_threshold = 0;
+    // The serialized compressed entry, if compressing it was worth it.
+    // Shared, since the writer is copied by the commitlog before it's sized.
+    lw_shared_ptr<const bytes_ostream> _compressed;
 private:
     template<typename Output>
     void serialize(Output&) const;
@@ -106,6 +111,17 @@ class commitlog_entry_writer {
             compute_size();
         }
     }
+    // Entries of mutations of at least threshold bytes are written compressed
+    // with LZ4, if that makes them at least 1/8 smaller. 0 disables compression.
+    // commitlog_entry_reader decompresses them transparently.
+    void set_compression_threshold(size_t threshold) {
+        if (std::exchange(_compression_threshold, threshold) != threshold && _size != std::numeric_limits<size_t>::max()) {
+            compute_size();
+        }
+    }
+    bool compressed() const {
+        return bool(_compressed);
+    }
     bool with_schema() const {
         return _with_schema;
     }
@@ -11,12 +11,16 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <map>
 #include <unordered_map>
 #include <ranges>
 #include <boost/range/adaptor/map.hpp>
 
 #include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
 
 #include "commitlog.hh"
 #include "commitlog_replayer.hh"
@@ -79,7 +83,19 @@ class db::commitlog_replayer::impl {
         return _column_mappings.stop();
     }
 
-    future<> process(stats*, commitlog::buffer_and_replay_position buf_rp) const;
+    // A mutation of a replayed entry, to be applied on the shards owning it.
+    struct replayed_entry {
+        frozen_mutation fm;
+        // Owned by the _column_mappings of the replaying shard, which outlive
+        // the replay.
+        const column_mapping* cm;
+        replay_position rp;
+    };
+
+    class mutation_batches;
+
+    future<> process(stats*, mutation_batches&, commitlog::buffer_and_replay_position buf_rp) const;
+    future<> apply(replica::database& db, const replayed_entry& e) const;
     future<stats> recover(const commitlog::descriptor&, const commitlog::replay_state&) const;
 
     typedef std::unordered_map<table_id, replay_position> rp_map;
@@ -115,6 +131,85 @@ class db::commitlog_replayer::impl {
     shard_rp_map _min_pos;
 };
 
+// Batches the mutations of the entries of a segment by the shard owning them,
+// so that decoding the segment on the replaying shard isn't held by a
+// round-trip to the owning shard for every entry. Batches are sent once they
+// grow above max_batch_bytes, and up to max_batches_in_flight of them are
+// applied concurrently, which also bounds the memory of the replay.
+class db::commitlog_replayer::impl::mutation_batches {
+    static constexpr size_t max_batch_bytes = 128 * 1024;
+    static constexpr size_t max_batches_in_flight = 16;
+
+    struct batch {
+        std::vector<lw_shared_ptr<const replayed_entry>> entries;
+        size_t bytes = 0;
+    };
+
+    const impl& _impl;
+    stats& _stats;
+    std::vector<batch> _batches;
+    semaphore _in_flight{max_batches_in_flight};
+    gate _gate;
+
+    future<> apply(seastar::shard_id shard, batch b) {
+        uint64_t applied = 0;
+        try {
+            applied = co_await _impl._db.invoke_on(shard, [this, &b] (replica::database& db) -> future<uint64_t> {
+                uint64_t applied = 0;
+                for (auto& e : b.entries) {
+                    try {
+                        co_await _impl.apply(db, *e);
+                        ++applied;
+                    } catch (...) {
+                        // TODO: write mutation to file like origin.
+                        rlogger.warn("error replaying: {}", std::current_exception());
+                    }
+                }
+                co_return applied;
+            });
+        } catch (...) {
+            rlogger.warn("error replaying {} mutations on shard {}: {}", b.entries.size(), shard, std::current_exception());
+        }
+        _stats.applied_mutations += applied;
+        _stats.invalid_mutations += b.entries.size() - applied;
+    }
+
+    future<> send(seastar::shard_id shard) {
+        auto units = co_await get_units(_in_flight, 1);
+        auto b = std::exchange(_batches[shard], batch{});
+        // Waited for in flush().
+        (void)with_gate(_gate, [this, shard, b = std::move(b), units = std::move(units)] () mutable {
+            return apply(shard, std::move(b)).finally([units = std::move(units)] {});
+        });
+    }
+public:
+    mutation_batches(const impl& impl, stats& s)
+        : _impl(impl)
+        , _stats(s)
+        , _batches(smp::count)
+    {}
+
+    future<> add(seastar::shard_id shard, lw_shared_ptr<const replayed_entry> e) {
+        auto& b = _batches[shard];
+        b.bytes += e->fm.representation().size();
+        b.entries.push_back(std::move(e));
+        if (b.bytes >= max_batch_bytes) {
+            return send(shard);
+        }
+        return make_ready_future<>();
+    }
+
+    // Sends the partial batches and waits for all of them to be applied.
+    future<> flush() {
+        for (seastar::shard_id shard = 0; shard < _batches.size(); ++shard) {
+            if (!_batches[shard].entries.empty()) {
+                co_await send(shard);
+            }
+        }
+        co_await _gate.close();
+    }
+};
+
 db::commitlog_replayer::impl::impl(seastar::sharded<replica::database>& db, seastar::sharded<db::system_keyspace>& sys_ks)
     : _db(db)
     , _sys_ks(sys_ks)
@@ -182,25 +277,31 @@ db::commitlog_replayer::impl::recover(const commitlog::descriptor& d, const comm
     }
 
     auto s = make_lw_shared<stats>();
+    auto batches = make_lw_shared<mutation_batches>(*this, *s);
     auto& exts = _db.local().extensions();
 
     return db::commitlog::read_log_file(rpstate, f, d.filename_prefix,
-            std::bind(&impl::process, this, s.get(), std::placeholders::_1),
-            p, &exts).then_wrapped([s](future<> f) {
-        try {
-            f.get();
-        } catch (commitlog::segment_data_corruption_error& e) {
-            s->corrupt_bytes += e.bytes();
-        } catch (commitlog::segment_truncation& e) {
-            s->truncated_at = e.position();
-        } catch (...) {
-            throw;
-        }
-        return make_ready_future<stats>(*s);
+            [this, s, batches] (commitlog::buffer_and_replay_position buf_rp) {
+                return process(s.get(), *batches, std::move(buf_rp));
+            },
+            p, &exts).then_wrapped([s, batches] (future<> f) {
+        // The batches must be applied also if the reading fails.
+        return batches->flush().then([s, f = std::move(f)] () mutable {
+            try {
+                f.get();
+            } catch (commitlog::segment_data_corruption_error& e) {
+                s->corrupt_bytes += e.bytes();
+            } catch (commitlog::segment_truncation& e) {
+                s->truncated_at = e.position();
+            } catch (...) {
+                throw;
+            }
+            return make_ready_future<stats>(*s);
+        });
     });
 }
 
-future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_replay_position buf_rp) const {
+future<> db::commitlog_replayer::impl::process(stats* s, mutation_batches& batches, commitlog::buffer_and_replay_position buf_rp) const {
     auto&& buf = buf_rp.buffer;
     auto&& rp = buf_rp.position;
     try {
@@ -247,56 +348,15 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
             co_return;
         }
 
-      auto apply = [&] (seastar::shard_id shard) {
-        return _db.invoke_on(shard, [this, &fm, &src_cm, rp] (replica::database& db) mutable -> future<> {
-            // TODO: might need better verification that the deserialized mutation
-            // is schema compatible. My guess is that just applying the mutation
-            // will not do this.
-            auto& cf = db.find_column_family(fm.column_family_id());
-
-            if (rlogger.is_enabled(logging::log_level::debug)) {
-                rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
-                        cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
-            }
-            if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
-                throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
-                        fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
-            }
-            // Removed forwarding "new" RP. Instead give none/empty.
-            // This is what origin does, and it should be fine.
-            // The end result should be that once sstables are flushed out
-            // their "replay_position" attribute will be empty, which is
-            // lower than anything the new session will produce.
-            if (cf.schema()->version() != fm.schema_version()) {
-                auto& local_cm = _column_mappings.local().map;
-                auto cm_it = local_cm.try_emplace(fm.schema_version(), src_cm).first;
-                const column_mapping& cm = cm_it->second;
-                mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
-                converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
-                fm.partition().accept(cm, v);
-                return do_with(std::move(m), [&db, &cf] (const mutation& m) {
-                    return db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
-                });
-            } else {
-                return db.apply_in_memory(fm, cf.schema(), db::rp_handle(), db::no_timeout);
-            }
-        }).then_wrapped([s] (future<> f) {
-            try {
-                f.get();
-                s->applied_mutations++;
-            } catch (...) {
-                s->invalid_mutations++;
-                // TODO: write mutation to file like origin.
-                rlogger.warn("error replaying: {}", std::current_exception());
-            }
-        });
-      };
         auto shards = table.get_effective_replication_map()->shard_for_writes(schema, token);
         if (shards.empty()) {
             rlogger.debug("no shard for token {} in table {}", token, uuid);
             s->skipped_mutations++;
-        } else {
-            co_await seastar::parallel_for_each(shards, apply);
+            co_return;
+        }
+        auto e = make_lw_shared<const replayed_entry>(std::move(cer).mutation(), &src_cm, rp);
+        for (auto shard : shards) {
+            co_await batches.add(shard, e);
         }
     } catch (replica::no_such_column_family&) {
         // No such CF now? Origin just ignores this.
@@ -307,6 +367,39 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
     }
 }
 
+future<> db::commitlog_replayer::impl::apply(replica::database& db, const replayed_entry& e) const {
+    // TODO: might need better verification that the deserialized mutation
+    // is schema compatible. My guess is that just applying the mutation
+    // will not do this.
+    auto& fm = e.fm;
+    auto& cf = db.find_column_family(fm.column_family_id());
+
+    if (rlogger.is_enabled(logging::log_level::debug)) {
+        rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
+                cf.schema()->ks_name(), cf.schema()->cf_name(), e.rp);
+    }
+    if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
+        throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
+                fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), e.rp, *err));
+    }
+    // Removed forwarding "new" RP. Instead give none/empty.
+    // This is what origin does, and it should be fine.
+    // The end result should be that once sstables are flushed out
+    // their "replay_position" attribute will be empty, which is
+    // lower than anything the new session will produce.
+    if (cf.schema()->version() != fm.schema_version()) {
+        auto& local_cm = _column_mappings.local().map;
+        auto cm_it = local_cm.try_emplace(fm.schema_version(), *e.cm).first;
+        const column_mapping& cm = cm_it->second;
+        mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
+        converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
+        fm.partition().accept(cm, v);
+        co_await db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
+    } else {
+        co_await db.apply_in_memory(fm, cf.schema(), db::rp_handle(), db::no_timeout);
+    }
+}
+
 db::commitlog_replayer::commitlog_replayer(seastar::sharded<replica::database>& db, seastar::sharded<db::system_keyspace>& sys_ks)
     : _impl(std::make_unique<impl>(db, sys_ks))
 {}
@@ -356,29 +449,38 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
         auto totals = co_await map_reduce(smp::all_cpus(), [&](unsigned id) -> future<impl::stats> {
             co_return co_await smp::submit_to(id, [&] () -> future<impl::stats> {
                 impl::stats total;
-                std::unordered_map<unsigned, commitlog::replay_state> states;
-                // TODO: or something. For now, we do this serialized per shard,
-                // to reduce mutation congestion. We could probably (says avi)
-                // do 2 segments in parallel or something, but lets use this first.
+                // The segments of the same origin shard are replayed in order,
+                // as fragmented entries may span them, sharing its replay state.
+                // The segments of different origin shards, which end up here
+                // when the shard count changed, are replayed concurrently.
+                // The decoding of a segment overlaps with the application of
+                // its mutations on the shards owning them (see mutation_batches).
+                std::map<unsigned, std::vector<const commitlog::descriptor*>> by_origin;
                 auto range = map.equal_range(id);
                 for (auto& [id, d] : std::ranges::subrange(range.first, range.second)) {
-                    auto f = d.filename();
-                    rlogger.debug("Replaying {}", f);
-                    auto stats = co_await _impl->recover(d, states[replay_position(d).shard_id()]);
-                    if (stats.corrupt_bytes != 0) {
-                        rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
-                    }
-                    if (stats.truncated_at != 0) {
-                        rlogger.warn("Truncated file: {} at position {}.", f, stats.truncated_at);
-                    }
-                    rlogger.debug("Log replay of {} complete, {} replayed mutations ({} invalid, {} skipped)"
-                                    , f
-                                    , stats.applied_mutations
-                                    , stats.invalid_mutations
-                                    , stats.skipped_mutations
-                    );
-                    total += stats;
+                    by_origin[replay_position(d).shard_id()].push_back(&d);
                 }
+                co_await coroutine::parallel_for_each(by_origin, [&] (auto& origin) -> future<> {
+                    commitlog::replay_state state;
+                    for (auto* d : origin.second) {
+                        auto f = d->filename();
+                        rlogger.debug("Replaying {}", f);
+                        auto stats = co_await _impl->recover(*d, state);
+                        if (stats.corrupt_bytes != 0) {
+                            rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
+                        }
+                        if (stats.truncated_at != 0) {
+                            rlogger.warn("Truncated file: {} at position {}.", f, stats.truncated_at);
+                        }
+                        rlogger.debug("Log replay of {} complete, {} replayed mutations ({} invalid, {} skipped)"
+                                        , f
+                                        , stats.applied_mutations
+                                        , stats.invalid_mutations
+                                        , stats.skipped_mutations
+                        );
+                        total += stats;
+                    }
+                });
                 co_return total;
             });
         }, impl::stats(), std::plus<impl::stats>());
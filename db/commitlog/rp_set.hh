@@ -38,6 +38,12 @@ class rp_set {
         }
         h.release();
     }
+    void put(rp_set&& other) {
+        for (auto& [id, count] : other._usage) {
+            _usage[id] += count;
+        }
+        other._usage.clear();
+    }
 
     size_t size() const {
         return _usage.size();
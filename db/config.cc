@@ -27,6 +27,7 @@
 #include "cdc/cdc_extension.hh"
 #include "tombstone_gc_extension.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/bloom_filter_layout_extension.hh"
 #include "db/tags/extension.hh"
 #include "config.hh"
 #include "extensions.hh"
@@ -420,8 +421,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The directory where hints files are stored if hinted handoff is enabled.")
     , view_hints_directory(this, "view_hints_directory", value_status::Used, "",
         "The directory where materialized-view updates are stored while a view replica is unreachable.")
-    , saved_caches_directory(this, "saved_caches_directory", value_status::Unused, "",
-        "The directory location where table key and row caches are stored.")
+    , saved_caches_directory(this, "saved_caches_directory", value_status::Used, "",
+        "The directory location where table key and row caches, and compiled WASM UDF modules are stored.")
     /**
     * @Group Commonly used properties
     * @GroupDescription Properties most frequently used when configuring Scylla.
@@ -567,6 +568,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Total space used for commitlogs. If the used space goes above this value, Scylla rounds up to the next nearest segment multiple and flushes memtables to disk for the oldest commitlog segments, removing those log segments. This reduces the amount of data to replay on startup, and prevents infrequently-updated tables from indefinitely keeping commitlog segments. A small total commitlog space tends to cause more flush activity on less-active tables.\n"
         "\n"
         "Related information: Configuring memtable throughput")
+    , commitlog_relog_memtable_max_size_in_kb(this, "commitlog_relog_memtable_max_size_in_kb", liveness::LiveUpdate, value_status::Used, 64,
+        "When the commitlog asks for the memtables keeping its oldest segments to be flushed, a memtable of a table written so rarely that it holds less than this is written again to the commitlog instead, which releases the old segments without creating a tiny sstable. Memtables holding data older than commitlog_max_data_lifetime_in_seconds are always flushed. (0 disables)")
     /* Note: Unused. Retained for upgrade compat. Deprecate and remove in a cycle or two. */
     , commitlog_reuse_segments(this, "commitlog_reuse_segments", value_status::Unused, true,
         "Whether or not to reuse commitlog segments when finished instead of deleting them. Can improve commitlog latency on some file systems.\n")
@@ -574,10 +577,15 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Threshold for commitlog disk usage. When used disk space goes above this value, Scylla initiates flushes of memtables to disk for the oldest commitlog segments, removing those log segments. Adjusting this affects disk usage vs. write latency. Default is (approximately) commitlog_total_space_in_mb - <num shards>*commitlog_segment_size_in_mb.")
     , commitlog_use_o_dsync(this, "commitlog_use_o_dsync", value_status::Used, true,
         "Whether or not to use O_DSYNC mode for commitlog segments IO. Can improve commitlog latency on some file systems.\n")
+    , commitlog_use_vectored_writes(this, "commitlog_use_vectored_writes", value_status::Used, false,
+        "Whether or not to submit each commitlog buffer as a single vectored write instead of one write per buffer fragment. Reduces the number of IO submissions per commitlog cycle.\n")
     , commitlog_use_hard_size_limit(this, "commitlog_use_hard_size_limit", value_status::Used, true,
         "Whether or not to use a hard size limit for commitlog disk usage. Default is true. Enabling this can cause latency spikes, whereas the default can lead to occasional disk usage peaks.\n")
     , commitlog_use_fragmented_entries(this, "commitlog_use_fragmented_entries", value_status::Used, true,
         "Whether or not to allow commitlog entries to fragment across segments, allowing for larger entry sizes.\n")
+    , commitlog_compression_threshold_in_kb(this, "commitlog_compression_threshold_in_kb", value_status::Used, 0,
+        "Compress commitlog entries of mutations at least this large (in KB) with LZ4, if that makes them smaller. Reduces the commitlog write bandwidth and disk usage of large text and blob writes, at the cost of CPU. 0 disables compression. "
+        "Segments with compressed entries can't be replayed by versions which don't support them, so this should stay disabled until downgrades are no longer needed.\n")
     /**
     * @Group Compaction settings
     * @GroupDescription Related information: Configuring compaction
@@ -640,6 +648,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Throttles streaming I/O to the specified total throughput (in MiBs/s) across the entire system. Streaming I/O includes the one performed by repair and both RBNO and legacy topology operations such as adding or removing a node. Setting the value to 0 disables stream throttling.")
     , stream_plan_ranges_fraction(this, "stream_plan_ranges_fraction", liveness::LiveUpdate, value_status::Used, 0.1,
         "Specify the fraction of ranges to stream in a single stream plan. Value is between 0 and 1.")
+    , enable_file_stream(this, "enable_file_stream", liveness::LiveUpdate, value_status::Used, true,
+        "Stream the sstables of migrating tablets as files rather than as mutations, when they lie within the tablet range and both replicas store them locally.")
     , trickle_fsync(this, "trickle_fsync", value_status::Unused, false,
         "When doing sequential writing, enabling this option tells fsync to force the operating system to flush the dirty buffers at a set interval trickle_fsync_interval_in_kb. Enable this parameter to avoid sudden dirty buffer flushing from impacting read latencies. Recommended to use on SSDs, but not on HDDs.")
     , trickle_fsync_interval_in_kb(this, "trickle_fsync_interval_in_kb", value_status::Unused, 10240,
@@ -720,6 +730,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Duration after which Cassandra should save the counter cache (keys only). Caches are saved to saved_caches_directory.")
     , counter_cache_keys_to_save(this, "counter_cache_keys_to_save", value_status::Unused, 0,
         "Number of keys from the counter cache to save. When disabled all keys are saved.")
+    , enable_counter_update_coalescing(this, "enable_counter_update_coalescing", liveness::LiveUpdate, value_status::Used, true,
+        "Merge the counter updates of a partition which arrive at its leader replica while another update of the partition is being applied, and apply them together, with a single lock acquisition and read before write.")
     /**
     * @Group Tombstone settings
     * @GroupDescription When executing a scan, within or across a partition, tombstones must be kept in memory to allow returning them to the coordinator. The coordinator uses them to ensure other replicas know about the deleted rows. Workloads that generate numerous tombstones may cause performance problems and exhaust the server heap. See Cassandra anti-patterns: Queues and queue-like datasets. Adjust these thresholds only if you understand the impact and want to scan more tombstones. Additionally, you can adjust these thresholds at runtime using the StorageServiceMBean.
@@ -737,6 +749,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , group0_tombstone_gc_refresh_interval_in_ms(this, "group0_tombstone_gc_refresh_interval_in_ms", value_status::Used,
               std::chrono::duration_cast<std::chrono::milliseconds>(60min).count(),
               "The interval in milliseconds at which we update the time point for safe tombstone expiration in group0 tables.")
+    , raft_log_group_commit_window_in_us(this, "raft_log_group_commit_window_in_us", liveness::LiveUpdate, value_status::Used, 0,
+        "Maximum time in microseconds a Raft log append waits for appends of other Raft groups on the same shard, so that they are persisted in a single write to system.raft. 0 persists every append on its own.")
     /**
     * @Group Network timeout settings
     */
@@ -748,6 +762,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The time that the coordinator waits for counter writes to complete.")
     , cas_contention_timeout_in_ms(this, "cas_contention_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 1000,
         "The time that the coordinator continues to retry a CAS (compare and set) operation that contends with other proposals for the same row.")
+    , cas_skip_empty_proposal(this, "cas_skip_empty_proposal", liveness::LiveUpdate, value_status::Used, true,
+        "Complete a CAS (compare and set) operation which doesn't apply an update - a serial read, or a conditional update whose condition isn't met - right after the prepare round, skipping the accept and learn rounds of an empty update, when the prepare round found no other round in progress and all the replicas agreeing on the current value.")
+    , speculative_retry_per_replica(this, "speculative_retry_per_replica", liveness::LiveUpdate, value_status::Used, false,
+        "For tables with a percentile speculative_retry, compute the time after which a read is retried on an additional replica from the latencies of each of the replicas read from, rather than from the latencies of the whole table. A read is then retried when one of its replicas is slower than it usually is, while a replica which is always slower than the others doesn't trigger retries of most reads.")
     , truncate_request_timeout_in_ms(this, "truncate_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 60000,
         "The time that the coordinator waits for truncates (remove all data from a table) to complete. The long default value allows for a snapshot to be taken before removing the data. If auto_snapshot is disabled (not recommended), you can reduce this time.")
     , write_request_timeout_in_ms(this, "write_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 2000,
@@ -779,6 +797,18 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "* all: All traffic is compressed.\n"
         "* dc: Traffic between data centers is compressed.\n"
         "* none: No compression.")
+    , internode_compression_zstd_connections(this, "internode_compression_zstd_connections", value_status::Used, "",
+        "A comma-separated list of the classes of internode connections which, when compressed (see internode_compression), are compressed with zstd rather than LZ4, if the other node supports it. The classes are: gossip, streaming, statement, statement-ack and mapreduce. zstd compresses better than LZ4 at a higher CPU cost, so it suits connections carrying bulk data, e.g. streaming, or statement when only the connections between data centers are compressed, rather than latency sensitive ones.")
+    , internode_compression_zstd_level(this, "internode_compression_zstd_level", value_status::Used, 3,
+        "The zstd compression level of the internode connections compressed with zstd.")
+    , internode_compression_zstd_dictionary(this, "internode_compression_zstd_dictionary", value_status::Used, "",
+        "The path of a zstd dictionary (e.g. trained with `zstd --train` on samples of mutations) used by the internode connections compressed with zstd. A connection uses the dictionary only if the nodes on both of its sides have the same one, and LZ4 otherwise.")
+    , internode_streaming_connections(this, "internode_streaming_connections", value_status::Used, 1,
+        "The number of connections from each shard to each other node over which the bulk data of streaming, repair and hints is spread. A single TCP connection per shard may not saturate a fast network link, e.g. when bootstrapping or decommissioning a node.")
+    , internode_write_coalescing_window_in_us(this, "internode_write_coalescing_window_in_us", liveness::LiveUpdate, value_status::Used, 0,
+        "The time in microseconds during which a coordinator shard gathers the mutations it sends to the same replica, to send them in a single message rather than one message for each. Each mutation is still acknowledged on its own. 0 disables the coalescing. Mutations forwarded to other replicas in the same data center are never coalesced.")
+    , internode_write_coalescing_max_bytes(this, "internode_write_coalescing_max_bytes", liveness::LiveUpdate, value_status::Used, 64 * 1024,
+        "The size of the coalesced mutations (see internode_write_coalescing_window_in_us) after which they are sent to the replica without waiting for the end of the window.")
     , inter_dc_tcp_nodelay(this, "inter_dc_tcp_nodelay", value_status::Used, false,
         "Enable or disable tcp_nodelay for inter-data center communication. When disabled larger, but fewer, network packets are sent. This reduces overhead from the TCP protocol itself. However, if cross data-center responses are blocked, it will increase latency.")
     , streaming_socket_timeout_in_ms(this, "streaming_socket_timeout_in_ms", value_status::Unused, 0,
@@ -831,6 +861,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Enable or disable keepalive on client connections (CQL native, Redis and the maintenance socket).")
     , cache_hit_rate_read_balancing(this, "cache_hit_rate_read_balancing", value_status::Used, true,
         "This boolean controls whether the replicas for read query will be chosen based on cache hit ratio.")
+    , read_latency_read_balancing(this, "read_latency_read_balancing", liveness::LiveUpdate, value_status::Used, false,
+        "Prefer the replicas which completed the recent reads of this coordinator faster when choosing the replicas for a single partition read, rather than the closest ones by the snitch only. This node, if it is a replica, is still preferred over the others, and the replicas of the local datacenter over the remote ones. Cache hit ratio based balancing, if enabled, is applied to the replicas ordered this way.")
+    , coalesce_concurrent_reads(this, "coalesce_concurrent_reads", liveness::LiveUpdate, value_status::Used, false,
+        "Let a single partition read which is identical to a read already in progress on the same shard - the same partition, columns, restrictions, limits and consistency level, issued in the same second - wait for the result of that read rather than being executed again, to lower the cost of many clients reading the same hot partition at once. The coalesced read may not see the writes which completed after the read it waits for was issued. Traced reads aren't coalesced.")
     /**
     * @Group Advanced fault detection settings
     * @GroupDescription Settings to handle poorly performing or failing nodes.
@@ -847,6 +881,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Related information: About hinted handoff writes")
     , max_hinted_handoff_concurrency(this, "max_hinted_handoff_concurrency", liveness::LiveUpdate, value_status::Used, 0,
         "Maximum concurrency allowed for sending hints. The concurrency is divided across shards and rounded up if not divisible by the number of shards. By default (or when set to 0), concurrency of 8*shard_count will be used.")
+    , hinted_handoff_replay_batch_size(this, "hinted_handoff_replay_batch_size", liveness::LiveUpdate, value_status::Used, 1,
+        "Maximum number of hints replayed together. Hints in a batch which target the same partition are merged and sent as a single mutation. The default of 1 sends every hint on its own.")
     , hinted_handoff_throttle_in_kb(this, "hinted_handoff_throttle_in_kb", value_status::Unused, 1024,
         "Maximum throttle per delivery thread in kilobytes per second. This rate reduces proportionally to the number of nodes in the cluster. For example, if there are two nodes in the cluster, each delivery thread will use the maximum rate. If there are three, each node will throttle to half of the maximum, since the two nodes are expected to deliver hints simultaneously.")
     , max_hint_window_in_ms(this, "max_hint_window_in_ms", value_status::Used, 10800000,
@@ -910,6 +946,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Refresh interval for permissions cache (if enabled). After this interval, cache entries become eligible for refresh. An async reload is scheduled every permissions_update_interval_in_ms time period and the old value is returned until it completes. If permissions_validity_in_ms has a non-zero value, then this property must also have a non-zero value. It's recommended to set this value to be at least 3 times smaller than the permissions_validity_in_ms.")
     , permissions_cache_max_entries(this, "permissions_cache_max_entries", liveness::LiveUpdate, value_status::Used, 1000,
         "Maximum cached permission entries. Must have a non-zero value if permissions caching is enabled (see a permissions_validity_in_ms description).")
+    , credentials_validity_in_ms(this, "credentials_validity_in_ms", liveness::LiveUpdate, value_status::Used, 2000,
+        "How long the password authenticator remembers a successfully verified password of a role, so that clients reconnecting with the same credentials don't have the password hashed again. Verifying a password is expensive on purpose, and connection storms would otherwise stall the shards. The entry is dropped when the password of the role changes. Set to 0 to disable.")
+    , credentials_cache_max_entries(this, "credentials_cache_max_entries", liveness::LiveUpdate, value_status::Used, 1000,
+        "Maximum number of verified passwords remembered by each shard (see credentials_validity_in_ms).")
     , server_encryption_options(this, "server_encryption_options", value_status::Used, {/*none*/},
         "Enable or disable inter-node encryption. You must also generate keys and provide the appropriate key and trust store locations and passwords. The available options are:\n"
         "* internode_encryption: (Default: none) Enable or disable encryption of inter-node communication using the TLS_RSA_WITH_AES_128_CBC_SHA cipher suite for authentication, key exchange, and encryption of data transfers. The available inter-node options are:\n"
@@ -954,6 +994,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The SSL port for encrypted communication. Unused unless enabled in encryption_options.")
     , enable_in_memory_data_store(this, "enable_in_memory_data_store", value_status::Used, false, "Enable in memory mode (system tables are always persisted).")
     , enable_cache(this, "enable_cache", value_status::Used, true, "Enable cache.")
+    , cache_warmup_save_period_in_s(this, "cache_warmup_save_period_in_s", value_status::Used, 300,
+        "Period, in seconds, in which the keys of the hottest partitions of every table are saved to a subdirectory of saved_caches_directory. On startup, these partitions are read into the cache in the background. Set to 0 to disable.")
     , enable_commitlog(this, "enable_commitlog", value_status::Used, true, "Enable commitlog.")
     , volatile_system_keyspace_for_testing(this, "volatile_system_keyspace_for_testing", value_status::Used, false, "Don't persist system keyspace - testing only!")
     , api_port(this, "api_port", value_status::Used, 10000, "Http Rest API port.")
@@ -977,6 +1019,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             " This can reduce the amount of data repair has to process.")
     , repair_partition_count_estimation_ratio(this, "repair_partition_count_estimation_ratio", liveness::LiveUpdate, value_status::Used, 0.1,
         "Specify the fraction of partitions written by repair out of the total partitions. The value is currently only used for bloom filter estimation. Value is between 0 and 1.")
+    , repair_range_summary_leaves(this, "repair_range_summary_leaves", liveness::LiveUpdate, value_status::Used, 256,
+        "Before syncing a range row by row, repair compares a hash tree summary of the range on all the replicas, made of this many sub-ranges, and syncs only the sub-ranges which differ. Set to 0 to sync the whole range row by row.")
     , ring_delay_ms(this, "ring_delay_ms", value_status::Used, 30 * 1000, "Time a node waits to hear from other nodes before joining the ring in milliseconds. Same as -Dcassandra.ring_delay_ms in cassandra.")
     , shadow_round_ms(this, "shadow_round_ms", value_status::Used, 300 * 1000, "The maximum gossip shadow round time. Can be used to reduce the gossip feature check time during node boot up.")
     , fd_max_interval_ms(this, "fd_max_interval_ms", value_status::Used, 2 * 1000, "The maximum failure_detector interval time in milliseconds. Interval larger than the maximum will be ignored. Larger cluster may need to increase the default.")
@@ -985,8 +1029,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , developer_mode(this, "developer_mode", value_status::Used, DEVELOPER_MODE_DEFAULT, "Relax environment checks. Setting to true can reduce performance and reliability significantly.")
     , skip_wait_for_gossip_to_settle(this, "skip_wait_for_gossip_to_settle", value_status::Used, -1, "An integer to configure the wait for gossip to settle. -1: wait normally, 0: do not wait at all, n: wait for at most n polls. Same as -Dcassandra.skip_wait_for_gossip_to_settle in cassandra.")
     , force_gossip_generation(this, "force_gossip_generation", liveness::LiveUpdate, value_status::Used, -1 , "Force gossip to use the generation number provided by user.")
+    , gossip_full_digest_period(this, "gossip_full_digest_period", liveness::LiveUpdate, value_status::Used, 10, "Gossip sends a live node only the endpoint digests which changed since the last message to it, and the full list of digests in every that many messages, so a node which missed an update catches up. Set to 1 to always send the full list.")
     , experimental_features(this, "experimental_features", value_status::Used, {}, experimental_features_help_string())
     , lsa_reclamation_step(this, "lsa_reclamation_step", value_status::Used, 1, "Minimum number of segments to reclaim in a single step.")
+    , lsa_huge_pages(this, "lsa_huge_pages", value_status::Used, false, "Back the memory of LSA segments (used by the cache and memtables) with transparent huge pages, reducing TLB misses on nodes with a lot of memory. To back all memory with huge pages reserved at startup, use the --hugepages option instead.")
     , prometheus_port(this, "prometheus_port", value_status::Used, 9180, "Prometheus port, set to zero to disable.")
     , prometheus_address(this, "prometheus_address", value_status::Used, {/* listen_address */}, "Prometheus listening address, defaulting to listen_address if not explicitly set.")
     , prometheus_prefix(this, "prometheus_prefix", value_status::Used, "scylla", "Set the prefix of the exported Prometheus metrics. Changing this will break Scylla's dashboard compatibility, do not change unless you know what you are doing.")
@@ -994,9 +1040,13 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , abort_on_lsa_bad_alloc(this, "abort_on_lsa_bad_alloc", value_status::Used, false, "Abort when allocation in LSA region fails.")
     , murmur3_partitioner_ignore_msb_bits(this, "murmur3_partitioner_ignore_msb_bits", value_status::Used, default_murmur3_partitioner_ignore_msb_bits, "Number of most significant token bits to ignore in murmur3 partitioner; increase for very large clusters.")
     , unspooled_dirty_soft_limit(this, "unspooled_dirty_soft_limit", value_status::Used, 0.6, "Soft limit of unspooled dirty memory expressed as a portion of the hard limit.")
+    , unspooled_dirty_table_budget(this, "unspooled_dirty_table_budget", value_status::Used, 0.5, "Budget of unspooled dirty memory of each table, expressed as a portion of the hard limit."
+        " Past the soft limit, writes to the tables over their budget are delayed and their memtables are flushed first, so that a table written to faster than it can be flushed doesn't get the writes to all tables throttled. 1 disables the budgets.")
+    , delay_memtable_flush_on_compaction_backlog(this, "delay_memtable_flush_on_compaction_backlog", liveness::LiveUpdate, value_status::Used, true, "When compaction falls behind, let memtables grow past the unspooled dirty soft limit, up to half way to the hard limit, before flushing them, to write fewer and larger sstables.")
     , sstable_summary_ratio(this, "sstable_summary_ratio", value_status::Used, 0.0005, "Enforces that 1 byte of summary is written for every N (2000 by default)"
         "bytes written to data file. Value must be between 0 and 1.")
     , components_memory_reclaim_threshold(this, "components_memory_reclaim_threshold", liveness::LiveUpdate, value_status::Used, .2, "Ratio of available memory for all in-memory components of SSTables in a shard beyond which the memory will be reclaimed from components until it falls back under the threshold. Currently, this limit is only enforced for bloom filters.")
+    , defer_sstable_bloom_filter_loading(this, "defer_sstable_bloom_filter_loading", value_status::Used, false, "Don't read the bloom filters of SSTables when their tables are loaded on startup; load them in the background, at maintenance priority, as memory allows (see components_memory_reclaim_threshold). Shortens the startup of nodes with many SSTables, but until its filter is loaded, every single-partition read touches the SSTable.")
     , large_memory_allocation_warning_threshold(this, "large_memory_allocation_warning_threshold", value_status::Used, size_t(1) << 20, "Warn about memory allocations above this size; set to zero to disable.")
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
     , enable_keyspace_column_family_metrics(this, "enable_keyspace_column_family_metrics", value_status::Used, false, "Enable per keyspace and per column family metrics reporting.")
@@ -1005,8 +1055,24 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, ENABLE_SSTABLE_KEY_VALIDATION, "Enable validation of partition and clustering keys monotonicity"
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
+    , sstable_key_validation_ratio(this, "sstable_key_validation_ratio", liveness::LiveUpdate, value_status::Used, 1.0,
+        "Fraction of the partitions of written sstables whose clustering keys are validated, when enable_sstable_key_validation is set."
+        " The other partitions only have their partition keys and fragment kinds validated, which is much cheaper, so a small fraction allows enabling key validation in production.")
+    , enable_sstable_promoted_index_summary(this, "enable_sstable_promoted_index_summary", liveness::LiveUpdate, value_status::Used, false,
+        "Write a summary of the promoted index of wide partitions into a PromotedIndexSummary component of new sstables, which is loaded when they are opened."
+        " Slice reads of wide partitions then binary search over a few adjacent promoted index blocks, instead of over blocks spread over the whole promoted index.")
+    , enable_sstable_postings(this, "enable_sstable_postings", liveness::LiveUpdate, value_status::Used, false,
+        "Write the posting lists of the indexed columns of tables into a Postings component of new sstables: for each value of a column, the partitions holding it."
+        " Columns with more than a thousand values in an sstable are left out.")
+    , enable_sstable_summary_downsampling(this, "enable_sstable_summary_downsampling", liveness::LiveUpdate, value_status::Used, false,
+        "Downsample the summary of sstables loaded with a summary more than twice as large as sstable_summary_ratio allows, e.g. sstables written with a higher ratio or imported from Cassandra."
+        " This bounds the memory resident summaries use, at the cost of reading larger index pages.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Used, true, "Enable cpu scheduling.")
     , view_building(this, "view_building", value_status::Used, true, "Enable view building; should only be set to false when the node is experience issues due to view building.")
+    , view_update_batch_delay_in_ms(this, "view_update_batch_delay_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+            "Hold background updates to remote view replicas for up to this long, merging the updates of the same view partition, generated by writes to different base partitions, into a single write. 0 disables batching.")
+    , view_update_batch_max_size_in_kb(this, "view_update_batch_max_size_in_kb", liveness::LiveUpdate, value_status::Used, 128,
+            "Send a batch of merged view updates as soon as the updates merged into it reach this size.")
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , enable_sstables_md_format(this, "enable_sstables_md_format", value_status::Unused, true, "Enable SSTables 'md' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , sstable_format(this, "sstable_format", value_status::Used, "me", "Default sstable file format", {"md", "me"})
@@ -1038,6 +1104,15 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "Start killing reads after their collective memory consumption goes above $normal_limit * $multiplier.")
     , reader_concurrency_semaphore_cpu_concurrency(this, "reader_concurrency_semaphore_cpu_concurrency", liveness::LiveUpdate, value_status::Used, 1,
             "Admit new reads while there are less than this number of requests that need CPU.")
+    , reader_concurrency_semaphore_cache_admission_lane(this, "reader_concurrency_semaphore_cache_admission_lane", liveness::LiveUpdate, value_status::Used, false,
+            "Admit single-partition reads which can be served fully from the row cache without waiting behind the reads going to disk. "
+            "Such reads are still limited by the memory of the reader concurrency semaphore.")
+    , reader_concurrency_semaphore_io_cost_delay_us(this, "reader_concurrency_semaphore_io_cost_delay_us", liveness::LiveUpdate, value_status::Used, 0,
+            "Prefer admitting reads with a low estimated disk I/O cost: each index or data page a queued read is estimated to read from disk "
+            "delays its admission by this many microseconds, compared to the reads queued after it. Reads are admitted in FIFO order when 0.")
+    , querier_cache_lookup_by_position(this, "querier_cache_lookup_by_position", liveness::LiveUpdate, value_status::Used, false,
+            "When a page of a paged query finds no saved reader of its query on the replica, reuse the saved reader of another query "
+            "of the same table and with the same slice, which stopped where the page starts, e.g. the previous page of the same scan sent by another coordinator.")
     , view_update_reader_concurrency_semaphore_serialize_limit_multiplier(this, "view_update_reader_concurrency_semaphore_serialize_limit_multiplier", liveness::LiveUpdate, value_status::Used, 2,
             "Start serializing view update reads after their collective memory consumption goes above $normal_limit * $multiplier.")
     , view_update_reader_concurrency_semaphore_kill_limit_multiplier(this, "view_update_reader_concurrency_semaphore_kill_limit_multiplier", liveness::LiveUpdate, value_status::Used, 4,
@@ -1046,6 +1121,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "Admit new view update reads while there are less than this number of requests that need CPU.")
     , maintenance_reader_concurrency_semaphore_count_limit(this, "maintenance_reader_concurrency_semaphore_count_limit", liveness::LiveUpdate, value_status::Used, 10,
             "Allow up to this many maintenance (e.g. streaming and repair) reads per shard to progress at the same time.")
+    , batch_workload_shares(this, "batch_workload_shares", liveness::LiveUpdate, value_status::Used, 0,
+            "Run the requests of sessions whose service level has the batch workload type in a scheduling group of their own, with this many CPU and I/O shares (regular statements have 1000), "
+            "so batch workloads can be capped without hurting the latency of interactive ones. 0 runs them together with regular statements. "
+            "Switching between 0 and a non-zero value requires a restart, other changes take effect immediately.")
+    , enable_shared_scans(this, "enable_shared_scans", liveness::LiveUpdate, value_status::Used, false,
+            "Let concurrent range scans of the same token range of a table, reading the same columns and clustering ranges, share the reads of the underlying sstables and memtables.")
+    , shared_scan_window_size_in_kb(this, "shared_scan_window_size_in_kb", liveness::LiveUpdate, value_status::Used, 1024,
+            "The amount of data a shared scan buffers for the scans lagging behind. Scans which fall further behind continue reading on their own.")
     , twcs_max_window_count(this, "twcs_max_window_count", liveness::LiveUpdate, value_status::Used, 50,
             "The maximum number of compaction windows allowed when making use of TimeWindowCompactionStrategy. A setting of 0 effectively disables the restriction.")
     , initial_sstable_loading_concurrency(this, "initial_sstable_loading_concurrency", value_status::Used, 4u,
@@ -1062,6 +1145,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Time period in seconds after which unused schema versions will be evicted from the local schema registry cache. Default is 1 second.")
     , max_concurrent_requests_per_shard(this, "max_concurrent_requests_per_shard", liveness::LiveUpdate, value_status::Used, std::numeric_limits<uint32_t>::max(),
         "Maximum number of concurrent requests a single shard can handle before it starts shedding extra load. By default, no requests will be shed.")
+    , cql_queueing_delay_target_ms(this, "cql_queueing_delay_target_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "Target for the time CQL requests wait in a shard before being processed, in milliseconds. When the delay of the requests stays above "
+        "the target for a whole interval of 100ms, the shard sheds new requests of interactive workloads with an Overloaded error until "
+        "the delay goes below the target again. 0 disables it.")
     , cdc_dont_rewrite_streams(this, "cdc_dont_rewrite_streams", value_status::Used, false,
             "Disable rewriting streams from cdc_streams_descriptions to cdc_streams_descriptions_v2. Should not be necessary, but the procedure is expensive and prone to failures; this config option is left as a backdoor in case some user requires manual intervention.")
     , strict_allow_filtering(this, "strict_allow_filtering", liveness::LiveUpdate, value_status::Used, strict_allow_filtering_default(), "Match Cassandra in requiring ALLOW FILTERING on slow queries. Can be true, false, or warn. When false, Scylla accepts some slow queries even without ALLOW FILTERING that Cassandra rejects. Warn is same as false, but with warning.")
@@ -1083,6 +1170,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "Make the system.config table UPDATEable.")
     , enable_parallelized_aggregation(this, "enable_parallelized_aggregation", liveness::LiveUpdate, value_status::Used, true,
             "Use on a new, parallel algorithm for performing aggregate queries.")
+    , enable_parallelized_aggregation_for_single_partition(this, "enable_parallelized_aggregation_for_single_partition", liveness::LiveUpdate, value_status::Used, false,
+            "Also use the parallel algorithm for aggregate queries reading a single partition. The aggregation then runs on a replica of the partition, "
+            "which returns only the aggregated values rather than all rows, at the cost of an extra hop for small partitions.")
     , cql_duplicate_bind_variable_names_refer_to_same_variable(this, "cql_duplicate_bind_variable_names_refer_to_same_variable", liveness::LiveUpdate, value_status::Used, true,
             "A bind variable that appears twice in a CQL query refers to a single variable (if false, no name matching is performed).")
     , alternator_port(this, "alternator_port", value_status::Used, 0, "Alternator API port.")
@@ -1138,16 +1228,34 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Keep SSTable index pages in the global cache after a SSTable read. Expected to improve performance for workloads with big partitions, but may degrade performance for workloads with small partitions. The amount of memory usable by index cache is limited with ``index_cache_fraction``.")
     , index_cache_fraction(this, "index_cache_fraction", liveness::LiveUpdate, value_status::Used, 0.2,
         "The maximum fraction of cache memory permitted for use by index cache. Clamped to the [0.0; 1.0] range. Must be small enough to not deprive the row cache of memory, but should be big enough to fit a large fraction of the index. The default value 0.2 means that at least 80\% of cache memory is reserved for the row cache, while at most 20\% is usable by the index cache.")
+    , cache_scan_resistant_admission(this, "cache_scan_resistant_admission", liveness::LiveUpdate, value_status::Used, true,
+        "Insert the rows which range scans populate the cache with at the head of the cache's LRU, so that they are evicted first unless they are read again. Prevents scans of data which doesn't fit in the cache from evicting the hot set.")
     , consistent_cluster_management(this, "consistent_cluster_management", value_status::Deprecated, true, "Use RAFT for cluster management and DDL.")
     , force_gossip_topology_changes(this, "force_gossip_topology_changes", value_status::Used, false, "Force gossip-based topology operations in a fresh cluster. Only the first node in the cluster must use it. The rest will fall back to gossip-based operations anyway. This option should be used only for testing.")
     , wasm_cache_memory_fraction(this, "wasm_cache_memory_fraction", value_status::Used, 0.01, "Maximum total size of all WASM instances stored in the cache as fraction of total shard memory.")
     , wasm_cache_timeout_in_ms(this, "wasm_cache_timeout_in_ms", value_status::Used, 5000, "Time after which an instance is evicted from the cache.")
     , wasm_cache_instance_size_limit(this, "wasm_cache_instance_size_limit", value_status::Used, 1024*1024, "Instances with size above this limit will not be stored in the cache.")
+    , wasm_module_cache_enabled(this, "wasm_module_cache_enabled", value_status::Used, true, "Store the compiled modules of WASM UDFs in a subdirectory of saved_caches_directory, so that they aren't compiled again after a restart.")
     , wasm_udf_yield_fuel(this, "wasm_udf_yield_fuel", value_status::Used, 100000, "Wasmtime fuel a WASM UDF can consume before yielding.")
     , wasm_udf_total_fuel(this, "wasm_udf_total_fuel", value_status::Used, 100000000, "Wasmtime fuel a WASM UDF can consume before termination.")
     , wasm_udf_memory_limit(this, "wasm_udf_memory_limit", value_status::Used, 2*1024*1024, "How much memory each WASM UDF can allocate at most.")
     , relabel_config_file(this, "relabel_config_file", value_status::Used, "", "Optionally, read relabel config from file.")
     , object_storage_config_file(this, "object_storage_config_file", value_status::Used, "", "Optionally, read object-storage endpoints config from file.")
+    , object_storage_cache_directory(this, "object_storage_cache_directory", liveness::MustRestart, value_status::Used, "",
+        "Directory, preferably on a fast local disk, where blocks read from sstables on object storage are cached. The cached blocks survive restarts. Empty disables the cache.")
+    , object_storage_cache_size_in_mb(this, "object_storage_cache_size_in_mb", liveness::MustRestart, value_status::Used, 0,
+        "The size of the local cache of blocks of sstables on object storage, shared evenly by the shards. 0 disables the cache.")
+    , object_storage_cache_pin_index(this, "object_storage_cache_pin_index", liveness::MustRestart, value_status::Used, true,
+        "Keep the cached blocks of the Index and Summary components of sstables on object storage in the local cache for as long as the sstables live, instead of evicting them.")
+    , tracing_backend(this, "tracing_backend", value_status::Used, "keyspace",
+        "Where the tracing records are written. keyspace: to the tables of the system_traces keyspace. log: to rotating local files in tracing_log_directory, "
+        "which are much cheaper to write and can be read through the system.trace_log_sessions and system.trace_log_events virtual tables.", {"keyspace", "log"})
+    , tracing_log_directory(this, "tracing_log_directory", liveness::MustRestart, value_status::Used, "",
+        "The directory where the tracing records are written when tracing_backend is log.")
+    , tracing_log_segment_size_in_mb(this, "tracing_log_segment_size_in_mb", liveness::MustRestart, value_status::Used, 32,
+        "The size of a segment file of the tracing log, after which the shard writing it starts a new one.")
+    , tracing_log_segments_per_shard(this, "tracing_log_segments_per_shard", liveness::MustRestart, value_status::Used, 8,
+        "The number of segment files of the tracing log kept per shard, the oldest ones are removed.")
     , live_updatable_config_params_changeable_via_cql(this, "live_updatable_config_params_changeable_via_cql", liveness::MustRestart, value_status::Used, true, "If set to true, configuration parameters defined with LiveUpdate can be updated in runtime via CQL (by updating system.config virtual table), otherwise they can't.")
     , auth_superuser_name(this, "auth_superuser_name", value_status::Used, "",
         "Initial authentication super username. Ignored if authentication tables already contain a super user.")
@@ -1165,6 +1273,11 @@ db::config::config(std::shared_ptr<db::extensions> exts)
          "Allows target tablet size to be configured. Defaults to 5G (in bytes). Maintaining tablets at reasonable sizes is important to be able to " \
          "redistribute load. A higher value means tablet migration throughput can be reduced. A lower value may cause number of tablets to increase significantly, " \
          "potentially resulting in performance drawbacks.")
+    , target_tablet_ops_per_second(this, "target_tablet_ops_per_second", liveness::LiveUpdate, value_status::Used, 0,
+         "Allows splitting tables whose tablets serve too many requests. Tables whose tablets serve on average more than twice this many reads and "
+         "writes per second (summed over replicas) are split, regardless of their size, and tables whose tablets serve less than half of it "
+         "aren't merged, so that hot tables keep enough tablets to spread their load over the shards. 0 disables it, the tablet count is then "
+         "driven by target_tablet_size_in_bytes only.")
     , replication_strategy_warn_list(this, "replication_strategy_warn_list", liveness::LiveUpdate, value_status::Used, {locator::replication_strategy_type::simple}, "Controls which replication strategies to warn about when creating/altering a keyspace. Doesn't affect the pre-existing keyspaces.")
     , replication_strategy_fail_list(this, "replication_strategy_fail_list", liveness::LiveUpdate, value_status::Used, {}, "Controls which replication strategies are disallowed to be used when creating/altering a keyspace. Doesn't affect the pre-existing keyspaces.")
     , service_levels_interval(this, "service_levels_interval_ms", liveness::LiveUpdate, value_status::Used, 10000, "Controls how often service levels module polls configuration table")
@@ -1195,6 +1308,10 @@ void db::config::add_per_partition_rate_limit_extension() {
     _extensions->add_schema_extension<db::per_partition_rate_limit_extension>(db::per_partition_rate_limit_extension::NAME);
 }
 
+void db::config::add_bloom_filter_layout_extension() {
+    _extensions->add_schema_extension<db::bloom_filter_layout_extension>(db::bloom_filter_layout_extension::NAME);
+}
+
 void db::config::add_tags_extension() {
     _extensions->add_schema_extension<db::tags_extension>(db::tags_extension::NAME);
 }
@@ -1213,6 +1330,7 @@ void db::config::setup_directories() {
     maybe_in_workdir(hints_directory, "hints");
     maybe_in_workdir(view_hints_directory, "view_hints");
     maybe_in_workdir(saved_caches_directory, "saved_caches");
+    maybe_in_workdir(tracing_log_directory, "tracing_log");
 }
 
 void db::config::maybe_in_workdir(named_value<sstring>& to, const char* sub) {
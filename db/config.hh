@@ -136,6 +136,7 @@ class config final : public utils::config_file {
     // For testing only
     void add_cdc_extension();
     void add_per_partition_rate_limit_extension();
+    void add_bloom_filter_layout_extension();
     void add_tags_extension();
     void add_tombstone_gc_extension();
 
@@ -212,11 +213,14 @@ class config final : public utils::config_file {
     named_value<uint32_t> commitlog_sync_batch_window_in_ms;
     named_value<uint32_t> commitlog_max_data_lifetime_in_seconds;
     named_value<int64_t> commitlog_total_space_in_mb;
+    named_value<uint32_t> commitlog_relog_memtable_max_size_in_kb;
     named_value<bool> commitlog_reuse_segments; // unused. retained for upgrade compat
     named_value<int64_t> commitlog_flush_threshold_in_mb;
     named_value<bool> commitlog_use_o_dsync;
+    named_value<bool> commitlog_use_vectored_writes;
     named_value<bool> commitlog_use_hard_size_limit;
     named_value<bool> commitlog_use_fragmented_entries;
+    named_value<uint32_t> commitlog_compression_threshold_in_kb;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
     named_value<uint32_t> in_memory_compaction_limit_in_mb;
@@ -240,6 +244,7 @@ class config final : public utils::config_file {
     named_value<uint32_t> inter_dc_stream_throughput_outbound_megabits_per_sec;
     named_value<uint32_t> stream_io_throughput_mb_per_sec;
     named_value<double> stream_plan_ranges_fraction;
+    named_value<bool> enable_file_stream;
     named_value<bool> trickle_fsync;
     named_value<uint32_t> trickle_fsync_interval_in_kb;
     named_value<bool> auto_bootstrap;
@@ -262,15 +267,19 @@ class config final : public utils::config_file {
     named_value<uint32_t> counter_cache_size_in_mb;
     named_value<uint32_t> counter_cache_save_period;
     named_value<uint32_t> counter_cache_keys_to_save;
+    named_value<bool> enable_counter_update_coalescing;
     named_value<uint32_t> tombstone_warn_threshold;
     named_value<uint32_t> tombstone_failure_threshold;
     named_value<uint64_t> query_tombstone_page_limit;
     named_value<uint64_t> query_page_size_in_bytes;
     named_value<uint32_t> group0_tombstone_gc_refresh_interval_in_ms;
+    named_value<uint32_t> raft_log_group_commit_window_in_us;
     named_value<uint32_t> range_request_timeout_in_ms;
     named_value<uint32_t> read_request_timeout_in_ms;
     named_value<uint32_t> counter_write_request_timeout_in_ms;
     named_value<uint32_t> cas_contention_timeout_in_ms;
+    named_value<bool> cas_skip_empty_proposal;
+    named_value<bool> speculative_retry_per_replica;
     named_value<uint32_t> truncate_request_timeout_in_ms;
     named_value<uint32_t> write_request_timeout_in_ms;
     named_value<uint32_t> request_timeout_in_ms;
@@ -278,6 +287,12 @@ class config final : public utils::config_file {
     named_value<uint32_t> internode_send_buff_size_in_bytes;
     named_value<uint32_t> internode_recv_buff_size_in_bytes;
     named_value<sstring> internode_compression;
+    named_value<sstring> internode_compression_zstd_connections;
+    named_value<int> internode_compression_zstd_level;
+    named_value<sstring> internode_compression_zstd_dictionary;
+    named_value<uint32_t> internode_streaming_connections;
+    named_value<uint32_t> internode_write_coalescing_window_in_us;
+    named_value<uint32_t> internode_write_coalescing_max_bytes;
     named_value<bool> inter_dc_tcp_nodelay;
     named_value<uint32_t> streaming_socket_timeout_in_ms;
     named_value<bool> start_native_transport;
@@ -295,11 +310,14 @@ class config final : public utils::config_file {
     named_value<bool> start_rpc;
     named_value<bool> rpc_keepalive;
     named_value<bool> cache_hit_rate_read_balancing;
+    named_value<bool> read_latency_read_balancing;
+    named_value<bool> coalesce_concurrent_reads;
     named_value<double> dynamic_snitch_badness_threshold;
     named_value<uint32_t> dynamic_snitch_reset_interval_in_ms;
     named_value<uint32_t> dynamic_snitch_update_interval_in_ms;
     named_value<hinted_handoff_enabled_type> hinted_handoff_enabled;
     named_value<uint32_t> max_hinted_handoff_concurrency;
+    named_value<uint32_t> hinted_handoff_replay_batch_size;
     named_value<uint32_t> hinted_handoff_throttle_in_kb;
     named_value<uint32_t> max_hint_window_in_ms;
     named_value<uint32_t> max_hints_delivery_threads;
@@ -314,12 +332,15 @@ class config final : public utils::config_file {
     named_value<uint32_t> permissions_validity_in_ms;
     named_value<uint32_t> permissions_update_interval_in_ms;
     named_value<uint32_t> permissions_cache_max_entries;
+    named_value<uint32_t> credentials_validity_in_ms;
+    named_value<uint32_t> credentials_cache_max_entries;
     named_value<string_map> server_encryption_options;
     named_value<string_map> client_encryption_options;
     named_value<string_map> alternator_encryption_options;
     named_value<uint32_t> ssl_storage_port;
     named_value<bool> enable_in_memory_data_store;
     named_value<bool> enable_cache;
+    named_value<uint32_t> cache_warmup_save_period_in_s;
     named_value<bool> enable_commitlog;
     named_value<bool> volatile_system_keyspace_for_testing;
     named_value<uint16_t> api_port;
@@ -340,6 +361,7 @@ class config final : public utils::config_file {
     named_value<bool> enable_compacting_data_for_streaming_and_repair;
     named_value<bool> enable_tombstone_gc_for_streaming_and_repair;
     named_value<double> repair_partition_count_estimation_ratio;
+    named_value<uint32_t> repair_range_summary_leaves;
     named_value<uint32_t> ring_delay_ms;
     named_value<uint32_t> shadow_round_ms;
     named_value<uint32_t> fd_max_interval_ms;
@@ -348,8 +370,10 @@ class config final : public utils::config_file {
     named_value<bool> developer_mode;
     named_value<int32_t> skip_wait_for_gossip_to_settle;
     named_value<int32_t> force_gossip_generation;
+    named_value<uint32_t> gossip_full_digest_period;
     named_value<std::vector<enum_option<experimental_features_t>>> experimental_features;
     named_value<size_t> lsa_reclamation_step;
+    named_value<bool> lsa_huge_pages;
     named_value<uint16_t> prometheus_port;
     named_value<sstring> prometheus_address;
     named_value<sstring> prometheus_prefix;
@@ -357,16 +381,25 @@ class config final : public utils::config_file {
     named_value<bool> abort_on_lsa_bad_alloc;
     named_value<unsigned> murmur3_partitioner_ignore_msb_bits;
     named_value<double> unspooled_dirty_soft_limit;
+    named_value<double> unspooled_dirty_table_budget;
+    named_value<bool> delay_memtable_flush_on_compaction_backlog;
     named_value<double> sstable_summary_ratio;
     named_value<double> components_memory_reclaim_threshold;
+    named_value<bool> defer_sstable_bloom_filter_loading;
     named_value<size_t> large_memory_allocation_warning_threshold;
     named_value<bool> enable_deprecated_partitioners;
     named_value<bool> enable_keyspace_column_family_metrics;
     named_value<bool> enable_node_aggregated_table_metrics;
     named_value<bool> enable_sstable_data_integrity_check;
     named_value<bool> enable_sstable_key_validation;
+    named_value<double> sstable_key_validation_ratio;
+    named_value<bool> enable_sstable_promoted_index_summary;
+    named_value<bool> enable_sstable_postings;
+    named_value<bool> enable_sstable_summary_downsampling;
     named_value<bool> cpu_scheduler;
     named_value<bool> view_building;
+    named_value<uint32_t> view_update_batch_delay_in_ms;
+    named_value<uint32_t> view_update_batch_max_size_in_kb;
     named_value<bool> enable_sstables_mc_format;
     named_value<bool> enable_sstables_md_format;
     named_value<sstring> sstable_format;
@@ -383,10 +416,16 @@ class config final : public utils::config_file {
     named_value<uint32_t> reader_concurrency_semaphore_serialize_limit_multiplier;
     named_value<uint32_t> reader_concurrency_semaphore_kill_limit_multiplier;
     named_value<uint32_t> reader_concurrency_semaphore_cpu_concurrency;
+    named_value<bool> reader_concurrency_semaphore_cache_admission_lane;
+    named_value<uint32_t> reader_concurrency_semaphore_io_cost_delay_us;
+    named_value<bool> querier_cache_lookup_by_position;
     named_value<uint32_t> view_update_reader_concurrency_semaphore_serialize_limit_multiplier;
     named_value<uint32_t> view_update_reader_concurrency_semaphore_kill_limit_multiplier;
     named_value<uint32_t> view_update_reader_concurrency_semaphore_cpu_concurrency;
     named_value<int> maintenance_reader_concurrency_semaphore_count_limit;
+    named_value<uint32_t> batch_workload_shares;
+    named_value<bool> enable_shared_scans;
+    named_value<uint32_t> shared_scan_window_size_in_kb;
     named_value<uint32_t> twcs_max_window_count;
     named_value<unsigned> initial_sstable_loading_concurrency;
     named_value<bool> enable_3_1_0_compatibility_mode;
@@ -396,11 +435,13 @@ class config final : public utils::config_file {
     named_value<unsigned> user_defined_function_contiguous_allocation_limit_bytes;
     named_value<uint32_t> schema_registry_grace_period;
     named_value<uint32_t> max_concurrent_requests_per_shard;
+    named_value<uint32_t> cql_queueing_delay_target_ms;
     named_value<bool> cdc_dont_rewrite_streams;
     named_value<tri_mode_restriction> strict_allow_filtering;
     named_value<tri_mode_restriction> strict_is_not_null_in_views;
     named_value<bool> enable_cql_config_updates;
     named_value<bool> enable_parallelized_aggregation;
+    named_value<bool> enable_parallelized_aggregation_for_single_partition;
     named_value<bool> cql_duplicate_bind_variable_names_refer_to_same_variable;
 
     named_value<uint16_t> alternator_port;
@@ -442,6 +483,7 @@ class config final : public utils::config_file {
 
     named_value<bool> cache_index_pages;
     named_value<double> index_cache_fraction;
+    named_value<bool> cache_scan_resistant_admission;
 
     named_value<bool> consistent_cluster_management;
     named_value<bool> force_gossip_topology_changes;
@@ -449,11 +491,19 @@ class config final : public utils::config_file {
     named_value<double> wasm_cache_memory_fraction;
     named_value<uint32_t> wasm_cache_timeout_in_ms;
     named_value<size_t> wasm_cache_instance_size_limit;
+    named_value<bool> wasm_module_cache_enabled;
     named_value<uint64_t> wasm_udf_yield_fuel;
     named_value<uint64_t> wasm_udf_total_fuel;
     named_value<size_t> wasm_udf_memory_limit;
     named_value<sstring> relabel_config_file;
     named_value<sstring> object_storage_config_file;
+    named_value<sstring> object_storage_cache_directory;
+    named_value<uint64_t> object_storage_cache_size_in_mb;
+    named_value<bool> object_storage_cache_pin_index;
+    named_value<sstring> tracing_backend;
+    named_value<sstring> tracing_log_directory;
+    named_value<unsigned> tracing_log_segment_size_in_mb;
+    named_value<unsigned> tracing_log_segments_per_shard;
     // wasm_udf_reserved_memory is static because the options in db::config
     // are parsed using seastar::app_template, while this option is used for
     // configuring the Seastar memory subsystem.
@@ -477,6 +527,7 @@ class config final : public utils::config_file {
 
     named_value<int> tablets_initial_scale_factor;
     named_value<uint64_t> target_tablet_size_in_bytes;
+    named_value<uint64_t> target_tablet_ops_per_second;
 
     named_value<std::vector<enum_option<replication_strategy_restriction_t>>> replication_strategy_warn_list;
     named_value<std::vector<enum_option<replication_strategy_restriction_t>>> replication_strategy_fail_list;
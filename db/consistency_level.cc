@@ -315,7 +315,14 @@ filter_for_query(consistency_level cl,
                 cf->set_hit_rate(ep, ht.rate);
                 return max_hit_rate;
             } else {
-                return std::min(float(ht.rate), max_hit_rate); // calculation below cannot work with hit rate 1
+                auto rate = std::min(float(ht.rate), max_hit_rate); // calculation below cannot work with hit rate 1
+                // Reads queued for admission on a replica will wait whatever
+                // its cache, so count them as misses: a replica with
+                // queued_reads_per_miss_doubling queued reads gets the work
+                // of a replica with twice its miss rate.
+                constexpr float queued_reads_per_miss_doubling = 50;
+                auto miss_rate = (1 - rate) * (1 + ht.queued_reads / queued_reads_per_miss_doubling);
+                return std::max(1 - miss_rate, 0.0f);
             }
         };
 
@@ -17,6 +17,7 @@
 #include <seastar/core/file-types.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/coroutine/as_future.hh>
 #include <seastar/core/print.hh>
 #include <seastar/core/seastar.hh>
 
@@ -38,6 +39,8 @@
 #include "utils/error_injection.hh"
 #include "converting_mutation_partition_applier.hh"
 #include "gc_clock.hh"
+#include "compaction/compaction_garbage_collector.hh"
+#include "tombstone_gc.hh"
 
 // STD.
 #include <ranges>
@@ -283,70 +286,82 @@ future<> hint_sender::send_one_mutation(frozen_mutation_and_schema m) {
     });
 }
 
+std::optional<frozen_mutation_and_schema> hint_sender::get_mutation_to_send(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf,
+        db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
+    try {
+        auto m = this->get_mutation(ctx_ptr, buf);
+        gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
+
+        // The hint is too old - drop it.
+        //
+        // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
+        // (last_modification - manager::hints_timer_period) old.
+        if (const auto now = gc_clock::now().time_since_epoch(); now - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
+            manager_logger.debug("send_hints(): the hint is too old, skipping it, "
+                "secs since file last modification {}, gc_grace_sec {}, hints_flush_period {}",
+                now - secs_since_file_mod, gc_grace_sec, manager::hints_flush_period);
+            return std::nullopt;
+        }
+        return m;
+
+    // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
+    } catch (replica::no_such_column_family& e) {
+        manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
+        ++this->shard_stats().discarded;
+    } catch (replica::no_such_keyspace& e) {
+        manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
+        ++this->shard_stats().discarded;
+    } catch (no_column_mapping& e) {
+        manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
+        ++this->shard_stats().discarded;
+    } catch (...) {
+        auto eptr = std::current_exception();
+        manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, eptr);
+        ++this->shard_stats().send_errors;
+        throw;
+    }
+    return std::nullopt;
+}
+
+void hint_sender::on_hint_sent(lw_shared_ptr<send_one_file_ctx> ctx_ptr, db::replay_position rp, bool failed) {
+    // Information about the error was already printed somewhere higher.
+    // We just need to account in the ctx that sending of this hint has failed.
+    if (!failed) {
+        ctx_ptr->on_hint_send_success(rp);
+        auto new_bound = ctx_ptr->get_replayed_bound();
+        // Segments from other shards are replayed first and are considered to be "before" replay position 0.
+        // Update the sent upper bound only if it is a local segment.
+        if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
+            _sent_upper_bound_rp = new_bound;
+            notify_replay_waiters();
+        }
+    } else {
+        ctx_ptr->on_hint_send_failure(rp);
+    }
+}
+
 future<> hint_sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
     return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto units) mutable {
         ctx_ptr->mark_hint_as_in_progress(rp);
 
         // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
         auto h = ctx_ptr->file_send_gate.hold();
-        (void)std::invoke([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
-            try {
-                auto m = this->get_mutation(ctx_ptr, buf);
-                gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
-
-                // The hint is too old - drop it.
-                //
-                // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
-                // (last_modification - manager::hints_timer_period) old.
-                if (const auto now = gc_clock::now().time_since_epoch(); now - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
-                    manager_logger.debug("send_hints(): the hint is too old, skipping it, "
-                        "secs since file last modification {}, gc_grace_sec {}, hints_flush_period {}",
-                        now - secs_since_file_mod, gc_grace_sec, manager::hints_flush_period);
-                    return make_ready_future<>();
-                }
-
-                const auto mutation_size = m.fm.representation().size();
-                return this->send_one_mutation(std::move(m)).then([this, ctx_ptr, mutation_size] {
-                    ++this->shard_stats().sent_total;
-                    this->shard_stats().sent_hints_bytes_total += mutation_size;
-                }).handle_exception([this, ctx_ptr] (auto eptr) {
-                    manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
-                    ++this->shard_stats().send_errors;
-                    return make_exception_future<>(std::move(eptr));
-                });
-
-            // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
-            } catch (replica::no_such_column_family& e) {
-                manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (replica::no_such_keyspace& e) {
-                manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (no_column_mapping& e) {
-                manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
-                ++this->shard_stats().discarded;
-            } catch (...) {
-                auto eptr = std::current_exception();
-                manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, eptr);
+        (void)futurize_invoke([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
+            auto m = get_mutation_to_send(ctx_ptr, buf, rp, secs_since_file_mod, fname);
+            if (!m) {
+                return make_ready_future<>();
+            }
+            const auto mutation_size = m->fm.representation().size();
+            return this->send_one_mutation(std::move(*m)).then([this, ctx_ptr, mutation_size] {
+                ++this->shard_stats().sent_total;
+                this->shard_stats().sent_hints_bytes_total += mutation_size;
+            }).handle_exception([this, ctx_ptr] (auto eptr) {
+                manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
                 ++this->shard_stats().send_errors;
                 return make_exception_future<>(std::move(eptr));
-            }
-            return make_ready_future<>();
+            });
         }).then_wrapped([this, units = std::move(units), rp, ctx_ptr, h = std::move(h)] (future<>&& f) {
-            // Information about the error was already printed somewhere higher.
-            // We just need to account in the ctx that sending of this hint has failed.
-            if (!f.failed()) {
-                ctx_ptr->on_hint_send_success(rp);
-                auto new_bound = ctx_ptr->get_replayed_bound();
-                // Segments from other shards are replayed first and are considered to be "before" replay position 0.
-                // Update the sent upper bound only if it is a local segment.
-                if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
-                    _sent_upper_bound_rp = new_bound;
-                    notify_replay_waiters();
-                }
-            } else {
-                ctx_ptr->on_hint_send_failure(rp);
-            }
+            on_hint_sent(ctx_ptr, rp, f.failed());
             f.ignore_ready_future();
         });
     }).handle_exception([ctx_ptr, rp] (auto eptr) {
@@ -355,6 +370,103 @@ future<> hint_sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fr
     });
 }
 
+future<> hint_sender::batch_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
+    // Bounds the memory held by a batch which wasn't accounted in the resource manager yet.
+    static constexpr size_t max_batch_bytes = 1024 * 1024;
+
+    ctx_ptr->mark_hint_as_in_progress(rp);
+    std::optional<frozen_mutation_and_schema> m;
+    try {
+        m = get_mutation_to_send(ctx_ptr, buf, rp, secs_since_file_mod, fname);
+    } catch (...) {
+        on_hint_sent(ctx_ptr, rp, true);
+        co_return;
+    }
+    if (!m) {
+        on_hint_sent(ctx_ptr, rp, false);
+        co_return;
+    }
+    ctx_ptr->batch_bytes += m->fm.representation().size();
+    ctx_ptr->batch.push_back(batched_hint{std::move(*m), rp});
+    if (ctx_ptr->batch.size() >= ctx_ptr->max_batch_size || ctx_ptr->batch_bytes >= max_batch_bytes) {
+        co_await send_batch(ctx_ptr);
+    }
+}
+
+future<> hint_sender::send_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr) {
+    struct partition_hints {
+        schema_ptr s;
+        std::optional<frozen_mutation> fm;
+        std::optional<mutation> merged;
+        std::vector<db::replay_position> rps;
+        size_t bytes = 0;
+    };
+
+    auto batch = std::exchange(ctx_ptr->batch, {});
+    auto batch_bytes = std::exchange(ctx_ptr->batch_bytes, 0);
+
+    std::vector<partition_hints> partitions;
+    std::unordered_map<table_schema_version, std::unordered_map<partition_key, size_t, partition_key::hashing, partition_key::equality>> index;
+    for (auto& h : batch) {
+        auto& s = h.mutation.s;
+        const auto mutation_size = h.mutation.fm.representation().size();
+        auto& by_key = index.try_emplace(s->version(), 0, partition_key::hashing(*s), partition_key::equality(*s)).first->second;
+        auto [it, inserted] = by_key.try_emplace(h.mutation.fm.key(), partitions.size());
+        if (inserted) {
+            partitions.push_back(partition_hints{.s = s, .fm = std::move(h.mutation.fm)});
+        } else {
+            auto& p = partitions[it->second];
+            if (!p.merged) {
+                p.merged = p.fm->unfreeze(p.s);
+                p.fm.reset();
+            }
+            p.merged->apply(h.mutation.fm.unfreeze(s));
+        }
+        auto& p = partitions[it->second];
+        p.rps.push_back(h.rp);
+        p.bytes += mutation_size;
+    }
+    batch.clear();
+
+    auto units_fut = co_await coroutine::as_future(_resource_manager.get_send_units_for(batch_bytes));
+    if (units_fut.failed()) {
+        manager_logger.trace("send_batch(): Hmmm. Something bad had happened: {}", units_fut.get_exception());
+        for (auto& p : partitions) {
+            for (auto rp : p.rps) {
+                ctx_ptr->on_hint_send_failure(rp);
+            }
+        }
+        co_return;
+    }
+
+    // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
+    (void)do_with(std::move(partitions), units_fut.get(), ctx_ptr->file_send_gate.hold(), [this, ctx_ptr] (std::vector<partition_hints>& partitions, auto&, auto&) {
+        return parallel_for_each(partitions, [this, ctx_ptr] (partition_hints& p) {
+            if (p.merged) {
+                // Drop the data of the merged hints which is covered by tombstones of
+                // newer ones, so it isn't replayed. Nothing is purged, the tombstones
+                // themselves still have to reach the destination.
+                p.merged->partition().compact_for_compaction(*p.s, never_gc, p.merged->decorated_key(),
+                        gc_clock::time_point::min(), tombstone_gc_state(nullptr));
+            }
+            auto fm = p.merged ? freeze(*p.merged) : std::move(*p.fm);
+            return send_one_mutation(frozen_mutation_and_schema{std::move(fm), p.s}).then_wrapped([this, ctx_ptr, &p] (future<> f) {
+                const bool failed = f.failed();
+                if (failed) {
+                    manager_logger.trace("send_batch(): failed to send to {}: {}", end_point_key(), f.get_exception());
+                    ++this->shard_stats().send_errors;
+                } else {
+                    this->shard_stats().sent_total += p.rps.size();
+                    this->shard_stats().sent_hints_bytes_total += p.bytes;
+                }
+                for (auto rp : p.rps) {
+                    on_hint_sent(ctx_ptr, rp, failed);
+                }
+            });
+        });
+    });
+}
+
 void hint_sender::notify_replay_waiters() noexcept {
     if (!_foreign_segments_to_replay.empty()) {
         manager_logger.trace("[{}] notify_replay_waiters(): not notifying because there are still {} foreign segments to replay", end_point_key(), _foreign_segments_to_replay.size());
@@ -464,7 +576,8 @@ void hint_sender::rewind_sent_replay_position_to(db::replay_position rp) {
 bool hint_sender::send_one_file(const sstring& fname) {
     timespec last_mod = get_last_file_modification(fname).get();
     gc_clock::duration secs_since_file_mod = std::chrono::seconds(last_mod.tv_sec);
-    lw_shared_ptr<send_one_file_ctx> ctx_ptr = make_lw_shared<send_one_file_ctx>(_last_schema_ver_to_column_mapping);
+    lw_shared_ptr<send_one_file_ctx> ctx_ptr = make_lw_shared<send_one_file_ctx>(_last_schema_ver_to_column_mapping,
+            std::max(_db.get_config().hinted_handoff_replay_batch_size(), 1u));
 
     try {
         commitlog::read_log_file(fname, manager::FILENAME_PREFIX, [this, secs_since_file_mod, &fname, ctx_ptr] (commitlog::buffer_and_replay_position buf_rp) -> future<> {
@@ -498,6 +611,9 @@ bool hint_sender::send_one_file(const sstring& fname) {
                     //   hints in a segment".
                     co_await sleep(std::chrono::milliseconds(100));
                     continue;
+                } else if (ctx_ptr->max_batch_size > 1) {
+                    co_await batch_one_hint(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
+                    break;
                 } else {
                     co_await send_one_hint(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
                     break;
@@ -513,6 +629,11 @@ bool hint_sender::send_one_file(const sstring& fname) {
         ctx_ptr->segment_replay_failed = true;
     }
 
+    // send what's left of the last batch, even if reading the file failed, as the batched hints are accounted as in progress
+    if (!ctx_ptr->batch.empty()) {
+        send_batch(ctx_ptr).get();
+    }
+
     // wait till all background hints sending is complete
     ctx_ptr->file_send_gate.close().get();
 
@@ -73,12 +73,23 @@ class hint_sender {
         state::ep_state_left_the_ring,
         state::draining>>;
 
+    // A hint waiting to be sent as part of a batch.
+    struct batched_hint {
+        frozen_mutation_and_schema mutation;
+        db::replay_position rp;
+    };
+
     struct send_one_file_ctx {
-        send_one_file_ctx(std::unordered_map<table_schema_version, column_mapping>& last_schema_ver_to_column_mapping)
+        send_one_file_ctx(std::unordered_map<table_schema_version, column_mapping>& last_schema_ver_to_column_mapping, size_t max_batch_size)
             : schema_ver_to_column_mapping(last_schema_ver_to_column_mapping)
+            , max_batch_size(max_batch_size)
         {}
         std::unordered_map<table_schema_version, column_mapping>& schema_ver_to_column_mapping;
         seastar::gate file_send_gate;
+        // Hints are sent one by one if max_batch_size is 1, see batch_one_hint().
+        const size_t max_batch_size;
+        std::vector<batched_hint> batch;
+        size_t batch_bytes = 0;
         std::optional<db::replay_position> first_failed_rp;
         std::optional<db::replay_position> last_succeeded_rp;
         std::set<db::replay_position> in_progress_rps;
@@ -207,6 +218,34 @@ class hint_sender {
     /// \return future that resolves when next hint may be sent
     future<> send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
 
+    /// \brief Restore the mutation of a hint read from the file, unless the hint should be dropped.
+    ///
+    /// Hints older than the gc grace period of their table, and hints of dropped tables, are dropped.
+    ///
+    /// \return the mutation to send, or std::nullopt if the hint is dropped
+    std::optional<frozen_mutation_and_schema> get_mutation_to_send(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf,
+            db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
+
+    /// \brief Add one hint read from the file to the current batch, sending the batch if it is full.
+    ///
+    /// Like send_one_hint(), but hints are accumulated in the file sending context and sent by send_batch().
+    /// Used when hinted_handoff_replay_batch_size is greater than 1.
+    ///
+    /// \return future that resolves when the next hint may be read
+    future<> batch_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
+
+    /// \brief Send the hints batched so far in the file sending context.
+    ///
+    /// Hints to the same partition of the same table (and schema version) are merged into a single mutation,
+    /// so each partition is written only once. The batch is accounted in the resource manager as a single hint
+    /// of its total size.
+    ///
+    /// \return future that resolves when the batch has been handed over for sending
+    future<> send_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr);
+
+    /// \brief Account the result of sending the hint at \ref rp in the file sending context.
+    void on_hint_sent(lw_shared_ptr<send_one_file_ctx> ctx_ptr, db::replay_position rp, bool failed);
+
     /// \brief Send all hint from a single file and delete it after it has been successfully sent.
     /// Send all hints from the given file. If we failed to send the current segment we will pick up in the next
     /// iteration from where we left in this one.
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "db/hot_key_sampler.hh"
+
+namespace db {
+
+void hot_key_sampler::maybe_rotate() {
+    auto now = lowres_clock::now();
+    if (now - _window_start < window) {
+        return;
+    }
+    // If more than a full window passed since the last sample, the current summary is stale as well.
+    if (now - _window_start < 2 * window) {
+        _previous = std::move(_current);
+    } else {
+        _previous = summary{};
+    }
+    _current = summary{};
+    _window_start = now;
+}
+
+void hot_key_sampler::record(top_k summary::*which, const schema_ptr& s, const dht::decorated_key& key) {
+    maybe_rotate();
+    (_current.*which).append(toppartitions_item_key(s, key));
+}
+
+hot_key_sampler::top_k::results hot_key_sampler::merged_top(top_k summary::*which, unsigned k) const {
+    // Rotation only happens when sampling, so account for windows which expired since.
+    auto age = lowres_clock::now() - _window_start;
+    top_k merged(2 * capacity);
+    if (age < window) {
+        merged.append((_previous.*which).top(capacity));
+    }
+    if (age < 2 * window) {
+        merged.append((_current.*which).top(capacity));
+    }
+    return merged.top(k);
+}
+
+std::vector<dht::decorated_key> hot_key_sampler::top_read_keys(unsigned k) const {
+    std::vector<dht::decorated_key> ret;
+    for (auto& r : merged_top(&summary::reads, k)) {
+        ret.push_back(r.item.key);
+    }
+    return ret;
+}
+
+hot_key_sampler::entries hot_key_sampler::top(top_k summary::*which, unsigned k) const {
+    entries ret;
+    for (auto& r : merged_top(which, k)) {
+        ret.push_back(entry{
+            .partition = sstring(r.item),
+            .count = uint64_t(r.count) * sample_period,
+            .error = uint64_t(r.error) * sample_period,
+        });
+    }
+    return ret;
+}
+
+} // namespace db
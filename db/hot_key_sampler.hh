@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/core/lowres_clock.hh>
+
+#include "db/data_listeners.hh"
+
+namespace db {
+
+// Always-on, low-overhead sampler of the hottest partitions of a table on a shard.
+//
+// Unlike toppartitions_query, which is installed on demand for a given duration,
+// this sampler runs continuously: one in every sample_period reads (served by the
+// row cache) and writes (applied to memtables) is fed into a space-saving top-k
+// summary. The summary is rotated every window, and the hottest keys are reported
+// over the last complete window and the current one, so a hot partition shows up
+// within seconds and a cooled-down one is forgotten after two windows.
+class hot_key_sampler {
+public:
+    using top_k = toppartitions_data_listener::top_k;
+
+    static constexpr unsigned sample_period = 64;
+    static constexpr size_t capacity = 64;
+    static constexpr lowres_clock::duration window = std::chrono::seconds(10);
+
+    struct entry {
+        sstring partition;
+        // Estimated number of operations, i.e. sampled count scaled by sample_period.
+        uint64_t count;
+        uint64_t error;
+    };
+    using entries = std::vector<entry>;
+
+private:
+    struct summary {
+        top_k reads{capacity};
+        top_k writes{capacity};
+    };
+    summary _current;
+    summary _previous;
+    lowres_clock::time_point _window_start = lowres_clock::now();
+    unsigned _read_countdown = sample_period;
+    unsigned _write_countdown = sample_period;
+
+    void maybe_rotate();
+    void record(top_k summary::*which, const schema_ptr& s, const dht::decorated_key& key);
+    top_k::results merged_top(top_k summary::*which, unsigned k) const;
+    entries top(top_k summary::*which, unsigned k) const;
+public:
+    void on_read(const schema_ptr& s, const dht::decorated_key& key) {
+        if (--_read_countdown) [[likely]] {
+            return;
+        }
+        _read_countdown = sample_period;
+        record(&summary::reads, s, key);
+    }
+
+    void on_write(const schema_ptr& s, const dht::decorated_key& key) {
+        if (--_write_countdown) [[likely]] {
+            return;
+        }
+        _write_countdown = sample_period;
+        record(&summary::writes, s, key);
+    }
+
+    // Like on_write(), but only decorates the key if the write is sampled.
+    void on_write(const schema_ptr& s, const partition_key& key) {
+        if (--_write_countdown) [[likely]] {
+            return;
+        }
+        _write_countdown = sample_period;
+        record(&summary::writes, s, dht::decorate_key(*s, key));
+    }
+
+    // Returns the k hottest partitions, hottest first.
+    entries top_reads(unsigned k) const {
+        return top(&summary::reads, k);
+    }
+    entries top_writes(unsigned k) const {
+        return top(&summary::writes, k);
+    }
+
+    // Returns the keys of the k most read partitions, hottest first.
+    std::vector<dht::decorated_key> top_read_keys(unsigned k) const;
+};
+
+} // namespace db
@@ -36,19 +36,44 @@ large_data_handler::large_data_handler(uint64_t partition_threshold_bytes, uint6
         partition_threshold_bytes, row_threshold_bytes, cell_threshold_bytes, rows_count_threshold, _collection_elements_count_threshold);
 }
 
-future<large_data_handler::partition_above_threshold> large_data_handler::maybe_record_large_partitions(const sstables::sstable& sst, const sstables::key& key, uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) {
+large_data_handler::partition_above_threshold large_data_handler::maybe_record_large_partitions(const sstables::sstable& sst, const sstables::key& key, uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) {
     SCYLLA_ASSERT(running());
     partition_above_threshold above_threshold{partition_size > _partition_threshold_bytes, rows > _rows_count_threshold};
     static_assert(std::is_same_v<decltype(above_threshold.size), bool>);
     _stats.partitions_bigger_than_threshold += above_threshold.size; // increment if true
     if (above_threshold.size || above_threshold.rows) [[unlikely]] {
-        return with_sem([&sst, &key, partition_size, rows, range_tombstones, dead_rows, this] {
-            return record_large_partitions(sst, key, partition_size, rows, range_tombstones, dead_rows);
-        }).then([above_threshold] {
-            return above_threshold;
-        });
+        schedule_record(record_large_partitions(sst, key, partition_size, rows, range_tombstones, dead_rows));
+    }
+    return above_threshold;
+}
+
+void large_data_handler::schedule_record(record_writer writer) {
+    if (!writer) {
+        return;
+    }
+    if (auto units = try_get_units(_sem, 1)) {
+        write_record(std::move(writer), std::move(*units));
+    } else if (_pending_records.size() < max_pending_records) {
+        _pending_records.push_back(std::move(writer));
+    } else {
+        ++_stats.records_dropped;
+        static thread_local logger::rate_limit rate_limit{std::chrono::seconds(10)};
+        large_data_logger.log(log_level::warn, rate_limit, "Dropping large data records, {} are already waiting to be written", _pending_records.size());
     }
-    return make_ready_future<partition_above_threshold>();
+}
+
+void large_data_handler::write_record(record_writer writer, semaphore_units<> units) {
+    // Discarded purposefully, errors are logged by the writer. The units are
+    // passed on to the next pending record, so stop() waits for all of them.
+    (void)futurize_invoke(std::move(writer)).handle_exception([] (std::exception_ptr ep) {
+        large_data_logger.warn("Failed to write a large data record: {}", ep);
+    }).finally([this, units = std::move(units)] () mutable {
+        if (!_pending_records.empty()) {
+            auto next = std::move(_pending_records.front());
+            _pending_records.pop_front();
+            write_record(std::move(next), std::move(units));
+        }
+    });
 }
 
 void large_data_handler::start() {
@@ -58,7 +83,7 @@ void large_data_handler::start() {
 future<> large_data_handler::stop() {
     if (running()) {
         _running = false;
-        large_data_logger.info("Waiting for {} background handlers", max_concurrency - _sem.available_units());
+        large_data_logger.info("Waiting for {} background handlers and {} pending records", max_concurrency - _sem.available_units(), _pending_records.size());
         co_await _sem.wait(max_concurrency);
     }
 }
@@ -144,10 +169,10 @@ cql_table_large_data_handler::cql_table_large_data_handler(gms::feature_service&
 {}
 
 template <typename... Args>
-future<> cql_table_large_data_handler::try_record(std::string_view large_table, const sstables::sstable& sst,  const sstables::key& partition_key, int64_t size,
+large_data_handler::record_writer cql_table_large_data_handler::try_record(std::string_view large_table, const sstables::sstable& sst,  const sstables::key& partition_key, int64_t size,
         std::string_view desc, std::string_view extra_path, const std::vector<sstring> &extra_fields, Args&&... args) const {
     if (!_sys_ks) {
-        return make_ready_future<>();
+        return {};
     }
 
     sstring extra_fields_str;
@@ -165,37 +190,40 @@ future<> cql_table_large_data_handler::try_record(std::string_view large_table,
     std::string pk_str = key_to_str(partition_key.to_partition_key(s), s);
     auto timestamp = db_clock::now();
     large_data_logger.warn("Writing large {} {}/{}: {} ({} bytes) to {}", desc, ks_name, cf_name, extra_path, size, sstable_name);
-    return _sys_ks->execute_cql(req, ks_name, cf_name, sstable_name, size, pk_str, timestamp, args...)
-            .discard_result()
-            .handle_exception([ks_name, cf_name, large_table, sstable_name] (std::exception_ptr ep) {
-                large_data_logger.warn("Failed to add a record to system.large_{}s: ks = {}, table = {}, sst = {} exception = {}",
-                        large_table, ks_name, cf_name, sstable_name, ep);
-            })
-            .finally([ p = _sys_ks ] {});
+    return [sys_ks = _sys_ks, req, ks_name, cf_name, large_table = sstring(large_table), sstable_name, size, pk_str = std::move(pk_str), timestamp,
+            ...args = std::forward<Args>(args)] () {
+        return sys_ks->execute_cql(req, ks_name, cf_name, sstable_name, size, pk_str, timestamp, args...)
+                .discard_result()
+                .handle_exception([ks_name, cf_name, large_table, sstable_name] (std::exception_ptr ep) {
+                    large_data_logger.warn("Failed to add a record to system.large_{}s: ks = {}, table = {}, sst = {} exception = {}",
+                            large_table, ks_name, cf_name, sstable_name, ep);
+                })
+                .finally([sys_ks] {});
+    };
 }
 
-future<> cql_table_large_data_handler::record_large_partitions(const sstables::sstable& sst, const sstables::key& key,
+large_data_handler::record_writer cql_table_large_data_handler::record_large_partitions(const sstables::sstable& sst, const sstables::key& key,
         uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) const {
     return _record_large_partitions(sst, key, partition_size, rows, range_tombstones, dead_rows);
 }
 
-future<> cql_table_large_data_handler::internal_record_large_partitions(const sstables::sstable& sst, const sstables::key& key,
+large_data_handler::record_writer cql_table_large_data_handler::internal_record_large_partitions(const sstables::sstable& sst, const sstables::key& key,
         uint64_t partition_size, uint64_t rows) const {
     return try_record("partition", sst, key, int64_t(partition_size), "partition", "", {"rows"}, data_value((int64_t)rows));
 }
 
-future<> cql_table_large_data_handler::internal_record_large_partitions_all_data(const sstables::sstable& sst, const sstables::key& key,
+large_data_handler::record_writer cql_table_large_data_handler::internal_record_large_partitions_all_data(const sstables::sstable& sst, const sstables::key& key,
         uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) const {
     return try_record("partition", sst, key, int64_t(partition_size), "partition", "", {"rows", "range_tombstones", "dead_rows"},
                 data_value((int64_t)rows), data_value((int64_t)range_tombstones), data_value((int64_t)dead_rows));
 }
 
-future<> cql_table_large_data_handler::record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+large_data_handler::record_writer cql_table_large_data_handler::record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
         const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const {
     return _record_large_cells(sst, partition_key, clustering_key, cdef, cell_size, collection_elements);
 }
 
-future<> cql_table_large_data_handler::internal_record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+large_data_handler::record_writer cql_table_large_data_handler::internal_record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
         const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const {
     auto column_name = cdef.name_as_text();
     std::string_view cell_type = cdef.is_atomic() ? "cell" : "collection";
@@ -210,7 +238,7 @@ future<> cql_table_large_data_handler::internal_record_large_cells(const sstable
     }
 }
 
-future<> cql_table_large_data_handler::internal_record_large_cells_and_collections(const sstables::sstable& sst, const sstables::key& partition_key,
+large_data_handler::record_writer cql_table_large_data_handler::internal_record_large_cells_and_collections(const sstables::sstable& sst, const sstables::key& partition_key,
         const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const {
     auto column_name = cdef.name_as_text();
     std::string_view cell_type = cdef.is_atomic() ? "cell" : "collection";
@@ -225,7 +253,7 @@ future<> cql_table_large_data_handler::internal_record_large_cells_and_collectio
     }
 }
 
-future<> cql_table_large_data_handler::record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
+large_data_handler::record_writer cql_table_large_data_handler::record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
         const clustering_key_prefix* clustering_key, uint64_t row_size) const {
     static const std::vector<sstring> extra_fields{"clustering_key"};
     if (clustering_key) {
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <cstdint>
+#include <deque>
+#include <seastar/util/noncopyable_function.hh>
 #include "schema/schema_fwd.hh"
 #include "system_keyspace.hh"
 #include "sstables/shared_sstable.hh"
@@ -28,8 +30,14 @@ class large_data_handler {
 public:
     struct stats {
         int64_t partitions_bigger_than_threshold = 0; // number of large partition updates exceeding threshold_bytes
+        uint64_t records_dropped = 0; // number of records not written because too many were pending
     };
 
+protected:
+    // Writes a record to the system tables. It owns all it needs, so that it
+    // can be called after the SSTable writer has moved on.
+    using record_writer = noncopyable_function<future<>()>;
+
 private:
     // Assuming:
     // * there is at most one log entry every 1MB
@@ -41,6 +49,15 @@ class large_data_handler {
     static constexpr size_t max_concurrency = 16;
     semaphore _sem{max_concurrency};
 
+    // Records waiting for one of the above units. The SSTable writers never
+    // wait for a record to be written: records queue up here instead, and
+    // are dropped past the limit, when the system tables can't keep up.
+    static constexpr size_t max_pending_records = 1024;
+    std::deque<record_writer> _pending_records;
+
+    void schedule_record(record_writer writer);
+    void write_record(record_writer writer, semaphore_units<> units);
+
     // A convenience function for using the above semaphore. Unlike the global with_semaphore, this will not wait on the
     // future returned by func. The objective is for the future returned by func to run in parallel with whatever the
     // caller is doing, but limit how far behind we can get.
@@ -77,37 +94,33 @@ class large_data_handler {
     void start();
     future<> stop();
 
-    future<bool> maybe_record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
+    // The maybe_record_large_*() functions return whether the data is above
+    // the thresholds. Records are written in the background.
+    bool maybe_record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, uint64_t row_size) {
         SCYLLA_ASSERT(running());
         if (__builtin_expect(row_size > _row_threshold_bytes, false)) {
-            return with_sem([&sst, &partition_key, clustering_key, row_size, this] {
-                return record_large_rows(sst, partition_key, clustering_key, row_size);
-            }).then([] {
-                return true;
-            });
+            schedule_record(record_large_rows(sst, partition_key, clustering_key, row_size));
+            return true;
         }
-        return make_ready_future<bool>(false);
+        return false;
     }
 
     struct partition_above_threshold {
         bool size = false;
         bool rows = false;
     };
-    future<partition_above_threshold> maybe_record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key,
+    partition_above_threshold maybe_record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key,
             uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows);
 
-    future<bool> maybe_record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+    bool maybe_record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) {
         SCYLLA_ASSERT(running());
         if (__builtin_expect(cell_size > _cell_threshold_bytes || collection_elements > _collection_elements_count_threshold, false)) {
-            return with_sem([&sst, &partition_key, clustering_key, &cdef, cell_size, collection_elements, this] {
-                return record_large_cells(sst, partition_key, clustering_key, cdef, cell_size, collection_elements);
-            }).then([] {
-                return true;
-            });
+            schedule_record(record_large_cells(sst, partition_key, clustering_key, cdef, cell_size, collection_elements));
+            return true;
         }
-        return make_ready_future<bool>(false);
+        return false;
     }
 
     future<> maybe_delete_large_data_entries(sstables::shared_sstable sst);
@@ -136,18 +149,19 @@ class large_data_handler {
     void unplug_system_keyspace() noexcept;
 
 protected:
-    virtual future<> record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+    // The record_large_*() functions only use their arguments before returning.
+    virtual record_writer record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const = 0;
-    virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const = 0;
+    virtual record_writer record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const = 0;
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const = 0;
-    virtual future<> record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) const = 0;
+    virtual record_writer record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) const = 0;
 };
 
 class cql_table_large_data_handler : public large_data_handler {
     gms::feature_service& _feat;
-    std::function<future<> (const sstables::sstable& sst, const sstables::key& partition_key,
+    std::function<record_writer (const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements)> _record_large_cells;
-    std::function<future<> (const sstables::sstable& sst, const sstables::key& partition_key,
+    std::function<record_writer (const sstables::sstable& sst, const sstables::key& partition_key,
             uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows)> _record_large_partitions;
     std::optional<std::any> _large_collection_detection_listener;
     std::optional<std::any> _range_tombstone_and_dead_rows_detection_listener;
@@ -169,46 +183,46 @@ class cql_table_large_data_handler : public large_data_handler {
             utils::updateable_value<uint32_t> collection_elements_count_threshold);
 
 protected:
-    virtual future<> record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) const override;
+    virtual record_writer record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) const override;
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const override;
-    virtual future<> record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+    virtual record_writer record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const override;
-    virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const override;
+    virtual record_writer record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const override;
 
 private:
-    future<> internal_record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+    record_writer internal_record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const;
-    future<> internal_record_large_cells_and_collections(const sstables::sstable& sst, const sstables::key& partition_key,
+    record_writer internal_record_large_cells_and_collections(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const;
-    future<> internal_record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows) const;
-    future<> internal_record_large_partitions_all_data(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows,
+    record_writer internal_record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows) const;
+    record_writer internal_record_large_partitions_all_data(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows,
             uint64_t dead_rows, uint64_t range_tombstones) const;
 
 private:
     template <typename... Args>
-    future<> try_record(std::string_view large_table, const sstables::sstable& sst,  const sstables::key& partition_key, int64_t size,
+    record_writer try_record(std::string_view large_table, const sstables::sstable& sst,  const sstables::key& partition_key, int64_t size,
             std::string_view desc, std::string_view extra_path, const std::vector<sstring> &extra_fields, Args&&... args) const;
 };
 
 class nop_large_data_handler : public large_data_handler {
 public:
     nop_large_data_handler();
-    virtual future<> record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) const override {
-        return make_ready_future<>();
+    virtual record_writer record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows, uint64_t range_tombstones, uint64_t dead_rows) const override {
+        return {};
     }
 
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const override {
         return make_ready_future<>();
     }
 
-    virtual future<> record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+    virtual record_writer record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
         const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size, uint64_t collection_elements) const override {
-        return make_ready_future<>();
+        return {};
     }
 
-    virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
+    virtual record_writer record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, uint64_t row_size) const override {
-        return make_ready_future<>();
+        return {};
     }
 };
 
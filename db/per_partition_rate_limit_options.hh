@@ -19,14 +19,25 @@ using namespace seastar;
 
 namespace db {
 
+// How the rate limiter counts the operations of a table.
+enum class per_partition_rate_limit_accounting {
+    // A hash table of counters, which tracks a limited number of partitions.
+    hash_table,
+    // A count-min sketch, which has a fixed footprint regardless of the number
+    // of partitions, at the cost of overestimating the counts of cold partitions.
+    sketch,
+};
+
 class per_partition_rate_limit_options final {
 private:
     static const char* max_writes_per_second_key;
     static const char* max_reads_per_second_key;
+    static const char* accounting_key;
 
 private:
     std::optional<uint32_t> _max_writes_per_second;
     std::optional<uint32_t> _max_reads_per_second;
+    per_partition_rate_limit_accounting _accounting = per_partition_rate_limit_accounting::hash_table;
 
 public:
     per_partition_rate_limit_options() = default;
@@ -59,6 +70,14 @@ class per_partition_rate_limit_options final {
     inline std::optional<uint32_t> get_max_reads_per_second() const {
         return _max_reads_per_second;
     }
+
+    inline void set_accounting(per_partition_rate_limit_accounting v) {
+        _accounting = v;
+    }
+
+    inline per_partition_rate_limit_accounting get_accounting() const {
+        return _accounting;
+    }
 };
 
 }
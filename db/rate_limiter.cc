@@ -39,15 +39,27 @@
 // time window. This strategy is also known as "lossy counting".
 //
 // Both mechanisms 1) and 2) are implemented in a lazy manner.
+//
+// Tables can choose to have their operations counted in a count-min sketch
+// instead: `sketch_depth` rows of counters, each indexed by a different hash
+// of the (label, token). An operation raises the counters of its partition
+// which are below the new estimate (conservative update), and the estimate is
+// the minimum of them. Unlike the hashmap, the sketch never fails to track
+// a partition, so it keeps working with any number of distinct partitions,
+// at the cost of overestimating the cold partitions which share all of their
+// counters with hot ones. The same two mechanisms apply to the sketch
+// counters, except halving, which is done eagerly on the whole sketch.
 
 namespace db {
 
 static constexpr size_t hash_bits = 16;
 static constexpr size_t entry_count = 1 << hash_bits;
 static constexpr size_t bucket_size = 10000;
-
+static constexpr size_t sketch_width = 1 << rate_limiter_base::sketch_width_bits;
 
 void rate_limiter_base::on_timer() noexcept {
+    sketch_halve();
+
     _time_window_history.pop_back();
     _time_window_history.insert(_time_window_history.begin(), time_window_entry {
         .entries_active = _current_entries_in_time_window,
@@ -139,6 +151,10 @@ rate_limiter_base::entry* rate_limiter_base::get_entry(uint32_t label, uint64_t
 }
 
 size_t rate_limiter_base::compute_hash(uint32_t label, uint64_t token) noexcept {
+    return compute_hash128(label, token)[0];
+}
+
+std::array<uint64_t, 2> rate_limiter_base::compute_hash128(uint32_t label, uint64_t token) noexcept {
     // The map key is a tuple (token, key) + salt
     // The key is hashed with murmur hash for good hash quality
 
@@ -154,7 +170,50 @@ size_t rate_limiter_base::compute_hash(uint32_t label, uint64_t token) noexcept
 
     std::array<uint64_t, 2> out;
     utils::murmur_hash::hash3_x64_128(key.data(), key_length, 0, out);
-    return out[0];
+    return out;
+}
+
+uint32_t rate_limiter_base::sketch_increase_and_get(uint32_t label, uint64_t token) noexcept {
+    if (_sketch.front().empty()) [[unlikely]] {
+        try {
+            for (auto& row : _sketch) {
+                row.resize(sketch_width);
+            }
+        } catch (...) {
+            // Like a failed allocation of an entry, admit the operation.
+            _sketch = {};
+            ++_metrics.failed_allocations;
+            return 0;
+        }
+    }
+    ++_metrics.sketch_updates;
+
+    // The indexes of the rows are derived from a single 128-bit hash
+    // (double hashing), so there is no need to compute one per row.
+    const auto hash = compute_hash128(label, token);
+    static constexpr uint32_t max_count = (1 << op_count_bits) - 1;
+    std::array<uint32_t*, sketch_depth> counters;
+    uint32_t estimate = max_count;
+    for (size_t i = 0; i < sketch_depth; i++) {
+        counters[i] = &_sketch[i][(hash[0] + i * hash[1]) % sketch_width];
+        // Counters below the current bucket are expired, like empty entries.
+        estimate = std::min(estimate, std::max(*counters[i], _current_bucket));
+    }
+    estimate = std::min(estimate + 1, max_count);
+    for (auto* c : counters) {
+        *c = std::max(*c, estimate);
+    }
+    return estimate;
+}
+
+void rate_limiter_base::sketch_halve() noexcept {
+    // A branch-free pass over contiguous rows, which the compiler vectorizes.
+    const uint32_t decrease = _current_bucket;
+    for (auto& row : _sketch) {
+        for (auto& c : row) {
+            c = c > decrease ? (c - decrease) / 2 : 0;
+        }
+    }
 }
 
 void rate_limiter_base::entry_refresh(rate_limiter_base::entry& b) noexcept {
@@ -211,6 +270,9 @@ void rate_limiter_base::register_metrics() {
         sm::make_counter("probe_count", _metrics.probe_count,
                 sm::description("Number of probes made during lookups.")),
 
+        sm::make_counter("sketch_updates", _metrics.sketch_updates,
+                sm::description("Number of operations counted in the count-min sketch.")),
+
         sm::make_gauge("load_factor", [&] {
                     uint32_t occupied_entry_count = _current_entries_in_time_window;
                     for (const auto& twe : _time_window_history) {
@@ -230,22 +292,32 @@ rate_limiter_base::rate_limiter_base()
     register_metrics();
 }
 
-uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token) noexcept {
+uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token, accounting acc) noexcept {
     // Assign a label if not done yet
     if (l._label == 0) {
         l._label = _next_label++;
     }
 
-    entry* b = get_entry(l._label, token);
-    if (!b) {
-        // We failed to allocate a entry for this partition. This means that
-        // we won't track hit count for this partition during this time window.
-        // Assume that it's OK to admit the operation.
-        return 0;
+    uint32_t count;
+    if (acc == accounting::sketch) {
+        count = sketch_increase_and_get(l._label, token);
+        if (!count) {
+            return 0;
+        }
+    } else {
+        entry* b = get_entry(l._label, token);
+        if (!b) {
+            // We failed to allocate a entry for this partition. This means that
+            // we won't track hit count for this partition during this time window.
+            // Assume that it's OK to admit the operation.
+            return 0;
+        }
+
+        // Protect from wrap-around
+        b->op_count = std::min<uint32_t>((1 << op_count_bits) - 1, b->op_count + 1);
+        count = b->op_count;
     }
 
-    // Protect from wrap-around
-    b->op_count = std::min<uint32_t>((1 << op_count_bits) - 1, b->op_count + 1);
     ++_current_ops_in_bucket;
     if (_current_ops_in_bucket >= bucket_size) {
         // Every `bucket_size` operations, virtually decrement all entries
@@ -255,20 +327,21 @@ uint64_t rate_limiter_base::increase_and_get_counter(label& l, uint64_t token) n
         _current_ops_in_bucket -= bucket_size;
     }
 
-    return b->op_count - _current_bucket;
+    return count - _current_bucket;
 }
 
 
 rate_limiter_base::can_proceed rate_limiter_base::account_operation(
         label& l, uint64_t token, uint64_t limit,
-        const db::per_partition_rate_limit::info& rate_limit_info) noexcept {
+        const db::per_partition_rate_limit::info& rate_limit_info,
+        accounting acc) noexcept {
 
     if (std::holds_alternative<std::monostate>(rate_limit_info)) {
         // Rate limiting turned off
         return can_proceed::yes;
     }
 
-    const uint64_t count = increase_and_get_counter(l, token);
+    const uint64_t count = increase_and_get_counter(l, token, acc);
 
     if (auto* info = std::get_if<db::per_partition_rate_limit::account_and_enforce>(&rate_limit_info)) {
         // On each time window change we halve the entry counts, therefore
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <chrono>
@@ -20,6 +21,7 @@
 
 #include "utils/chunked_vector.hh"
 #include "db/per_partition_rate_limit_info.hh"
+#include "db/per_partition_rate_limit_options.hh"
 
 // A data structure used to implement per-partition rate limiting. It accounts
 // operations and enforces limits when it is detected that the operation rate
@@ -32,12 +34,18 @@ class rate_limiter_base {
     static constexpr size_t op_count_bits = 20;
     static constexpr size_t time_window_bits = 12;
 
+    static constexpr size_t sketch_depth = 4;
+    static constexpr size_t sketch_width_bits = 16;
+
+    using accounting = per_partition_rate_limit_accounting;
+
 private:
     struct metrics {
         uint64_t allocations_on_empty = 0;
         uint64_t successful_lookups = 0;
         uint64_t failed_allocations = 0;
         uint64_t probe_count = 0;
+        uint64_t sketch_updates = 0;
     };
 
     // Represents a piece of the hashmap storage.
@@ -101,12 +109,23 @@ class rate_limiter_base {
     utils::chunked_vector<entry> _entries;
     std::vector<time_window_entry> _time_window_history;
 
+    // The rows of the count-min sketch, allocated on first use. Like the
+    // entries, the counters are virtually decremented by `_current_bucket`,
+    // but they are halved eagerly on each time window change.
+    std::array<std::vector<uint32_t>, sketch_depth> _sketch;
+
     metrics _metrics;
     seastar::metrics::metric_groups _metric_group;
 
 private:
     entry* get_entry(uint32_t label, uint64_t token) noexcept;
     size_t compute_hash(uint32_t label, uint64_t token) noexcept;
+    std::array<uint64_t, 2> compute_hash128(uint32_t label, uint64_t token) noexcept;
+
+    // Increments the sketch counters of given (label, token) and returns
+    // the estimated number of operations, before the lossy counting decrement.
+    uint32_t sketch_increase_and_get(uint32_t label, uint64_t token) noexcept;
+    void sketch_halve() noexcept;
 
     void entry_refresh(entry& b) noexcept;
     bool entry_is_empty(const entry& b) noexcept;
@@ -128,7 +147,7 @@ class rate_limiter_base {
     // (For testing purposes only)
     // Increments the counter for given (label, token) and returns
     // the new value of the counter.
-    uint64_t increase_and_get_counter(label& l, uint64_t token) noexcept;
+    uint64_t increase_and_get_counter(label& l, uint64_t token, accounting acc = accounting::hash_table) noexcept;
 
     // Increments the counter for given (label, token).
     // If the counter indicates that the partition is over the limit,
@@ -140,8 +159,13 @@ class rate_limiter_base {
     //
     // The probability is calculated in such a way that statistically
     // only `limit` operations per second are admitted.
+    //
+    // The `acc` parameter selects the structure the operations are counted in.
+    // The sketch never fails to track a partition, but may overestimate
+    // the rate of a partition which shares its counters with hot ones.
     can_proceed account_operation(label& l, uint64_t token, uint64_t limit,
-            const db::per_partition_rate_limit::info& rate_limit_info) noexcept;
+            const db::per_partition_rate_limit::info& rate_limit_info,
+            accounting acc = accounting::hash_table) noexcept;
 };
 
 template<typename ClockType>
@@ -24,6 +24,7 @@
 #include "interval.hh"
 #include "mutation/mutation_fragment.hh"
 #include "sstables/sstables.hh"
+#include "sstables/hyperloglog.hh"
 #include "replica/database.hh"
 
 #include "db/size_estimates_virtual_reader.hh"
@@ -159,6 +160,17 @@ static dht::partition_range as_ring_position_range(dht::token_range& r) {
     return dht::partition_range(std::move(start_bound), std::move(end_bound), r.is_singular());
 }
 
+/**
+ * Returns the estimator of the number of partitions in the sstable, if it has one we can read.
+ */
+static std::optional<hll::HyperLogLog> cardinality_of(const sstables::sstable& sst) {
+    try {
+        return hll::HyperLogLog::from_bytes(sst.get_compaction_metadata().cardinality.elements);
+    } catch (const std::runtime_error&) {
+        return std::nullopt;
+    }
+}
+
 /**
  * Add a new range_estimates for the specified range, considering the sstables associated with `cf`.
  */
@@ -175,10 +187,39 @@ static system_keyspace::range_estimates estimate(const replica::column_family& c
         [&] (auto&& rng) { ranges.push_back(std::move(rng)); });
     for (auto&& r : ranges) {
         auto rp_range = as_ring_position_range(r);
+        int64_t range_count = 0;
+        // A partition present in several sstables is counted once for each of
+        // them. Scale the sum down by how much the sstables overlap, that is,
+        // by the ratio of the number of partitions in their union to the sum
+        // of their numbers of partitions, as estimated by their cardinality
+        // estimators. These cover whole sstables, so the overlap within the
+        // range is assumed to be the same as that of the whole sstables.
+        std::optional<hll::HyperLogLog> keys;
+        double keys_sum = 0;
+        bool can_deduplicate = true;
         for (auto&& sstable : cf.select_sstables(rp_range)) {
-            count += sstable->estimated_keys_for_range(r);
+            range_count += sstable->estimated_keys_for_range(r);
             hist.merge(sstable->get_stats_metadata().estimated_partition_size);
+            if (!can_deduplicate) {
+                continue;
+            }
+            auto c = cardinality_of(*sstable);
+            if (!c || (keys && keys->registerSize() != c->registerSize())) {
+                can_deduplicate = false;
+                continue;
+            }
+            keys_sum += c->estimate();
+            if (keys) {
+                keys->merge(*c);
+            } else {
+                keys = std::move(c);
+            }
+        }
+        if (range_count > 0 && can_deduplicate && keys && keys_sum > 0) {
+            auto ratio = std::min(1.0, keys->estimate() / keys_sum);
+            range_count = std::max(int64_t(1), std::llround(range_count * ratio));
         }
+        count += range_count;
     }
     return {cf.schema(), r.start, r.end, count, count > 0 ? hist.mean() : 0};
 }
@@ -106,7 +106,9 @@ class snapshot_ctl : public peering_sharded_service<snapshot_ctl> {
      */
     future<> clear_snapshot(sstring tag, std::vector<sstring> keyspace_names, sstring cf_name);
 
-    future<tasks::task_id> start_backup(sstring endpoint, sstring bucket, sstring prefix, sstring keyspace, sstring table, sstring snapshot_name);
+    // Backs up a snapshot of a table. When the base_prefix of a previous
+    // backup is given, the sstables it already holds are copied from it.
+    future<tasks::task_id> start_backup(sstring endpoint, sstring bucket, sstring prefix, sstring keyspace, sstring table, sstring snapshot_name, sstring base_prefix = "");
 
     future<std::unordered_map<sstring, db_snapshot_details>> get_snapshot_details();
 
@@ -7,6 +7,9 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <sstream>
+#include <boost/algorithm/string/trim.hpp>
+#include <seastar/util/file.hh>
 #include "utils/lister.hh"
 #include "utils/s3/client.hh"
 #include "replica/database.hh"
@@ -15,6 +18,8 @@
 #include "db/snapshot/backup_task.hh"
 #include "schema/schema_fwd.hh"
 #include "sstables/sstables.hh"
+#include "sstables/open_info.hh"
+#include "sstables/exceptions.hh"
 #include "utils/error_injection.hh"
 
 extern logging::logger snap_log;
@@ -26,6 +31,7 @@ backup_task_impl::backup_task_impl(tasks::task_manager::module_ptr module,
                                    shared_ptr<s3::client> client,
                                    sstring bucket,
                                    sstring prefix,
+                                   sstring base_prefix,
                                    sstring ks,
                                    std::filesystem::path snapshot_dir) noexcept
     : tasks::task_manager::task::impl(module, tasks::task_id::create_random_id(), 0, "node", ks, "", "", tasks::task_id::create_null_id())
@@ -33,6 +39,7 @@ backup_task_impl::backup_task_impl(tasks::task_manager::module_ptr module,
     , _client(std::move(client))
     , _bucket(std::move(bucket))
     , _prefix(std::move(prefix))
+    , _base_prefix(std::move(base_prefix))
     , _snapshot_dir(std::move(snapshot_dir)) {
 }
 
@@ -48,22 +55,112 @@ tasks::is_abortable backup_task_impl::is_abortable() const noexcept {
     return tasks::is_abortable::yes;
 }
 
+// The manifest is a line per component: "<file name> <size> <sstable digest>".
+// It is written after all the components are uploaded, so it only lists
+// components which are complete in the bucket.
+sstring backup_task_impl::manifest_name(const sstring& prefix) const {
+    return fmt::format("/{}/{}/backup.manifest", _bucket, prefix);
+}
+
+future<backup_task_impl::manifest> backup_task_impl::read_manifest(const sstring& prefix) const {
+    manifest ret;
+    temporary_buffer<char> buf;
+    try {
+        buf = co_await _client->get_object_contiguous(manifest_name(prefix));
+    } catch (const storage_io_error& e) {
+        if (e.code().value() != ENOENT) {
+            throw;
+        }
+        co_return ret;
+    }
+    std::istringstream in(std::string(buf.get(), buf.size()));
+    std::string name, digest;
+    uint64_t size;
+    while (in >> name >> size >> digest) {
+        ret.emplace(name, manifest_entry{size, digest});
+    }
+    co_return ret;
+}
+
+// Components of an sstable never change, so a component is known to be in
+// the bucket already if it is listed by a manifest with the same size and the
+// same digest of its sstable. Components of sstables without a digest, and
+// files which aren't sstable components, are always uploaded.
 void backup_task_impl::do_backup() {
     if (!file_exists(_snapshot_dir.native()).get()) {
         throw std::invalid_argument(fmt::format("snapshot does not exist at {}", _snapshot_dir.native()));
     }
 
+    auto uploaded = read_manifest(_prefix).get();
+    auto base = _base_prefix.empty() ? manifest{} : read_manifest(_base_prefix).get();
+
+    std::vector<sstring> components;
+    std::unordered_map<sstring, sstring> digests;
+    auto generation_of = [this] (const sstring& name) -> std::optional<sstring> {
+        try {
+            return fmt::to_string(sstables::parse_path(_snapshot_dir / name, "", "").generation);
+        } catch (...) {
+            return std::nullopt;
+        }
+    };
+    {
+        auto snapshot_dir_lister = directory_lister(_snapshot_dir, lister::dir_entry_types::of<directory_entry_type::regular>());
+        auto close_snapshot_dir_lister = deferred_close(snapshot_dir_lister);
+        while (auto component_ent = snapshot_dir_lister.get().get()) {
+            components.push_back(component_ent->name);
+            try {
+                if (sstables::parse_path(_snapshot_dir / component_ent->name, "", "").component == sstables::component_type::Digest) {
+                    auto digest = read_entire_file_contiguous(_snapshot_dir / component_ent->name).get();
+                    digests.emplace(*generation_of(component_ent->name), boost::trim_copy(digest));
+                }
+            } catch (const malformed_sstable_exception&) {
+                // Not an sstable component
+            }
+        }
+    }
+
+    // The manifest of the backup lists the components of the previous backups
+    // to the same prefix too, which are still there.
+    manifest backed_up = uploaded;
+    unsigned nr_uploaded = 0, nr_copied = 0, nr_skipped = 0;
+    // Large objects can't be copied with a single request.
+    constexpr uint64_t max_copy_size = 5ull << 30;
+
     gate uploads;
     auto wait = defer([&uploads] { uploads.close().get(); });
 
-    auto snapshot_dir_lister = directory_lister(_snapshot_dir, lister::dir_entry_types::of<directory_entry_type::regular>());
-    auto close_snapshot_dir_lister = deferred_close(snapshot_dir_lister);
+    for (auto& name : components) {
+        auto component_name = _snapshot_dir / name;
+        auto destination = fmt::format("/{}/{}/{}", _bucket, _prefix, name);
+        auto generation = generation_of(name);
+        auto digest = generation ? digests.find(*generation) : digests.end();
+        std::optional<manifest_entry> entry;
+        if (digest != digests.end()) {
+            entry.emplace(file_size(component_name.native()).get(), digest->second);
+        }
+        auto listed = [&entry, &name] (const manifest& m) {
+            auto it = m.find(name);
+            return entry && it != m.end() && it->second == *entry;
+        };
+
+        if (listed(uploaded)) {
+            snap_log.trace("Skip {}, already in {}", component_name.native(), destination);
+            nr_skipped++;
+            continue;
+        }
 
-    while (auto component_ent = snapshot_dir_lister.get().get()) {
         auto gh = uploads.hold();
-        auto component_name = _snapshot_dir / component_ent->name;
-        auto destination = fmt::format("/{}/{}/{}", _bucket, _prefix, component_ent->name);
-        snap_log.trace("Upload {} to {}", component_name.native(), destination);
+        future<> f = make_ready_future<>();
+        if (listed(base) && entry->size <= max_copy_size) {
+            auto source = fmt::format("/{}/{}/{}", _bucket, _base_prefix, name);
+            snap_log.trace("Copy {} to {}", source, destination);
+            nr_copied++;
+            f = _client->copy_object(std::move(source), destination);
+        } else {
+            snap_log.trace("Upload {} to {}", component_name.native(), destination);
+            nr_uploaded++;
+            f = _client->upload_file(component_name, destination);
+        }
         // Start uploading in the background. The caller waits for these fibers
         // with the _uploads gate.
         // Parallelism is implicitly controlled in two ways:
@@ -71,7 +168,11 @@ void backup_task_impl::do_backup() {
         //  - http::client::max_connections limitation
         // FIXME -- s3::client is not abortable yet, but when it will be, need to
         // propagate impl::_as abort requests into upload_file's fibers
-        std::ignore = _client->upload_file(component_name, destination).handle_exception([comp = component_name] (auto ex) {
+        std::ignore = std::move(f).then([&backed_up, &name, entry] {
+            if (entry) {
+                backed_up[name] = *entry;
+            }
+        }).handle_exception([comp = component_name] (auto ex) {
             snap_log.error("Error uploading {}: {}", comp.native(), ex);
             std::rethrow_exception(ex);
         }).finally([gh = std::move(gh)] {});
@@ -82,6 +183,16 @@ void backup_task_impl::do_backup() {
         }).get();
         impl::_as.check();
     }
+
+    wait.cancel();
+    uploads.close().get();
+
+    sstring contents;
+    for (auto& [name, entry] : backed_up) {
+        contents += fmt::format("{} {} {}\n", name, entry.size, entry.digest);
+    }
+    _client->put_object(manifest_name(_prefix), temporary_buffer<char>(contents.data(), contents.size())).get();
+    snap_log.info("Backup of {}: uploaded {}, copied {}, skipped {} components", _snapshot_dir.native(), nr_uploaded, nr_copied, nr_skipped);
 }
 
 future<> backup_task_impl::run() {
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <filesystem>
+#include <unordered_map>
 #include "tasks/task_manager.hh"
 
 namespace s3 { class client; }
@@ -24,8 +25,21 @@ class backup_task_impl : public tasks::task_manager::task::impl {
     shared_ptr<s3::client> _client;
     sstring _bucket;
     sstring _prefix;
+    sstring _base_prefix;
     std::filesystem::path _snapshot_dir;
     std::exception_ptr _ex;
+
+    // The components uploaded to a prefix, by file name, with their sizes and
+    // the digests of the sstables they belong to.
+    struct manifest_entry {
+        uint64_t size;
+        sstring digest;
+        bool operator==(const manifest_entry&) const = default;
+    };
+    using manifest = std::unordered_map<sstring, manifest_entry>;
+
+    sstring manifest_name(const sstring& prefix) const;
+    future<manifest> read_manifest(const sstring& prefix) const;
     void do_backup();
 
 protected:
@@ -37,6 +51,7 @@ class backup_task_impl : public tasks::task_manager::task::impl {
                      shared_ptr<s3::client> cln,
                      sstring bucket,
                      sstring prefix,
+                     sstring base_prefix,
                      sstring ks,
                      std::filesystem::path snapshot_dir) noexcept;
 
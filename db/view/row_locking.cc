@@ -16,6 +16,8 @@ row_locker::row_locker(schema_ptr s)
     : _schema(s)
     , _two_level_locks(1, decorated_key_hash(), decorated_key_equals_comparator(this))
 {
+    _free_partition_nodes.reserve(max_free_nodes);
+    _free_row_nodes.reserve(max_free_nodes);
 }
 
 void row_locker::upgrade(schema_ptr new_schema) {
@@ -26,6 +28,52 @@ void row_locker::upgrade(schema_ptr new_schema) {
     _schema = new_schema;
 }
 
+row_locker::two_level_lock_map::iterator
+row_locker::get_partition_lock(const dht::decorated_key& pk) {
+    auto i = _two_level_locks.find(pk);
+    if (i != _two_level_locks.end()) {
+        return i;
+    }
+    if (_free_partition_nodes.empty()) {
+        return _two_level_locks.try_emplace(pk, this).first;
+    }
+    auto node = std::move(_free_partition_nodes.back());
+    _free_partition_nodes.pop_back();
+    node.key() = pk;
+    return _two_level_locks.insert(std::move(node)).position;
+}
+
+row_locker::two_level_lock::row_lock_map::iterator
+row_locker::get_row_lock(two_level_lock::row_lock_map& row_locks, const clustering_key_prefix& ck) {
+    auto i = row_locks.find(ck);
+    if (i != row_locks.end()) {
+        return i;
+    }
+    if (_free_row_nodes.empty()) {
+        return row_locks.try_emplace(ck, lock_type()).first;
+    }
+    auto node = std::move(_free_row_nodes.back());
+    _free_row_nodes.pop_back();
+    node.key() = ck;
+    return row_locks.insert(std::move(node)).position;
+}
+
+void row_locker::erase_partition_lock(two_level_lock_map::iterator i) noexcept {
+    if (_free_partition_nodes.size() < max_free_nodes) {
+        _free_partition_nodes.push_back(_two_level_locks.extract(i));
+    } else {
+        _two_level_locks.erase(i);
+    }
+}
+
+void row_locker::erase_row_lock(two_level_lock::row_lock_map& row_locks, two_level_lock::row_lock_map::iterator i) noexcept {
+    if (_free_row_nodes.size() < max_free_nodes) {
+        _free_row_nodes.push_back(row_locks.extract(i));
+    } else {
+        row_locks.erase(i);
+    }
+}
+
 row_locker::lock_holder::lock_holder()
     : _locker(nullptr)
     , _partition(nullptr)
@@ -71,7 +119,7 @@ future<row_locker::lock_holder>
 row_locker::lock_pk(const dht::decorated_key& pk, bool exclusive, db::timeout_clock::time_point timeout, stats& stats) {
     mylog.debug("taking {} lock on entire partition {}", (exclusive ? "exclusive" : "shared"), pk);
     auto tracker = latency_stats_tracker(exclusive ? stats.exclusive_partition : stats.shared_partition);
-    auto i = _two_level_locks.try_emplace(pk, this).first;
+    auto i = get_partition_lock(pk);
     auto f = exclusive ? i->second._partition_lock.write_lock(timeout) : i->second._partition_lock.read_lock(timeout);
     // Note: we rely on the fact that &i->first, the pointer to a key, never
     // becomes invalid (as long as the item is actually in the hash table),
@@ -88,7 +136,7 @@ row_locker::lock_ck(const dht::decorated_key& pk, const clustering_key_prefix& c
     auto tracker = latency_stats_tracker(exclusive ? stats.exclusive_row : stats.shared_row);
     auto ck = cpk;
     // Create a two-level lock entry for the partition if it doesn't exist already.
-    auto i = _two_level_locks.try_emplace(pk, this).first;
+    auto i = get_partition_lock(pk);
     // The two-level lock entry we've just created is guaranteed to be kept alive as long as it's locked.
     // Initiating read locking in the background below ensures that even if the two-level lock is currently
     // write-locked, releasing the write-lock will synchronously engage any waiting
@@ -96,7 +144,7 @@ row_locker::lock_ck(const dht::decorated_key& pk, const clustering_key_prefix& c
     future<lock_type::holder> lock_partition = i->second._partition_lock.hold_read_lock(timeout);
     return lock_partition.then([this, pk = &i->first, row_locks = &i->second._row_locks, ck = std::move(ck), exclusive, tracker = std::move(tracker), timeout] (auto lock1) mutable {
         // Create a row_lock entry if it doesn't exist already.
-        auto j = row_locks->try_emplace(std::move(ck), lock_type()).first;
+        auto j = get_row_lock(*row_locks, ck);
         auto* cpk = &j->first;
         auto& row_lock = j->second;
         // Like to the two-level lock entry above, the row_lock entry we've just created
@@ -170,7 +218,7 @@ row_locker::unlock(const dht::decorated_key* pk, bool partition_exclusive,
             }
             if (!lock.locked()) {
                 mylog.debug("Erasing lock object for row {} in partition {}", *cpk, *pk);
-                pli->second._row_locks.erase(rli);
+                erase_row_lock(pli->second._row_locks, rli);
             }
         }
         mylog.debug("releasing {} lock for entire partition {}", (partition_exclusive ? "exclusive" : "shared"), *pk);
@@ -182,7 +230,7 @@ row_locker::unlock(const dht::decorated_key* pk, bool partition_exclusive,
         }
         if (!lock.locked()) {
             mylog.debug("Erasing lock object for partition {}", *pk);
-            _two_level_locks.erase(pli);
+            erase_partition_lock(pli);
         }
      }
 }
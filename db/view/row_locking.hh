@@ -19,7 +19,9 @@
 // row_locker could release its shared-pointer to the old schema, and take
 // the new.
 
+#include <map>
 #include <unordered_map>
+#include <vector>
 
 #include <seastar/core/rwlock.hh>
 #include <seastar/core/future.hh>
@@ -91,7 +93,8 @@ class row_locker {
                 return clustering_key_prefix::less_compare(*locker->_schema)(k1, k2);
             }
         };
-        std::map<clustering_key_prefix, lock_type, clustering_key_prefix_less> _row_locks;
+        using row_lock_map = std::map<clustering_key_prefix, lock_type, clustering_key_prefix_less>;
+        row_lock_map _row_locks;
         two_level_lock(row_locker* locker)
             : _row_locks(locker) { }
     };
@@ -107,7 +110,20 @@ class row_locker {
             return k1.equal(*locker->_schema, k2);
         }
     };
-    std::unordered_map<dht::decorated_key, two_level_lock, decorated_key_hash, decorated_key_equals_comparator> _two_level_locks;
+    using two_level_lock_map = std::unordered_map<dht::decorated_key, two_level_lock, decorated_key_hash, decorated_key_equals_comparator>;
+    two_level_lock_map _two_level_locks;
+    // Nodes of the lock entries which were erased, kept for reuse by the
+    // entries of the next locked keys. Most keys are locked by one writer at
+    // a time, so without them every lock would allocate (and free) a hash
+    // table node and a row map node. At most max_free_nodes are kept, and the
+    // vectors are reserved upfront so that releasing a lock doesn't allocate.
+    static constexpr size_t max_free_nodes = 64;
+    std::vector<two_level_lock_map::node_type> _free_partition_nodes;
+    std::vector<two_level_lock::row_lock_map::node_type> _free_row_nodes;
+    two_level_lock_map::iterator get_partition_lock(const dht::decorated_key& pk);
+    two_level_lock::row_lock_map::iterator get_row_lock(two_level_lock::row_lock_map& row_locks, const clustering_key_prefix& ck);
+    void erase_partition_lock(two_level_lock_map::iterator i) noexcept;
+    void erase_row_lock(two_level_lock::row_lock_map& row_locks, two_level_lock::row_lock_map::iterator i) noexcept;
     void unlock(const dht::decorated_key* pk, bool partition_exclusive, const clustering_key_prefix* cpk, bool row_exclusive);
 public:
     // row_locker needs to know the column_family's schema because key
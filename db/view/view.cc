@@ -41,6 +41,7 @@
 #include "db/view/view_builder.hh"
 #include "db/view/view_updating_consumer.hh"
 #include "db/view/view_update_generator.hh"
+#include "db/view/view_update_batcher.hh"
 #include "db/system_keyspace_view_types.hh"
 #include "db/system_keyspace.hh"
 #include "db/system_distributed_keyspace.hh"
@@ -280,6 +281,8 @@ void stats::register_stats() {
                     {_cf_label, _ks_label}),
             ms::make_total_operations("view_updates_failed_remote", view_updates_failed_remote, ms::description("Number of updates (mutations) that failed to be pushed to remote view replicas"),
                     {_cf_label, _ks_label}),
+            ms::make_total_operations("view_updates_coalesced_remote", view_updates_coalesced_remote, ms::description("Number of updates (mutations) to remote view replicas that were merged into another update of the same view partition"),
+                    {_cf_label, _ks_label}),
             ms::make_total_operations("view_updates_pushed_local", view_updates_pushed_local, ms::description("Number of updates (mutations) pushed to local view replicas"),
                     {_cf_label, _ks_label}),
             ms::make_total_operations("view_updates_failed_local", view_updates_failed_local, ms::description("Number of updates (mutations) that failed to be pushed to local view replicas"),
@@ -1824,6 +1827,107 @@ static future<> apply_to_remote_endpoints(service::storage_proxy& proxy, locator
     }
 }
 
+bool view_update_batcher::batch::can_merge(const update& u) const {
+    return mut.s->version() == u.mut.s->version()
+            && mut.fm.key().equal(*mut.s, u.mut.fm.key())
+            && target == u.target
+            && pending_endpoints == u.pending_endpoints
+            && allow_hints == u.allow_hints;
+}
+
+view_update_batcher::view_update_batcher(sharded<service::storage_proxy>& proxy, utils::updateable_value<uint32_t> delay_in_ms,
+        utils::updateable_value<uint32_t> max_size_in_kb)
+    : _proxy(proxy)
+    , _delay_in_ms(std::move(delay_in_ms))
+    , _max_size_in_kb(std::move(max_size_in_kb))
+    , _timer([this] { flush(); })
+{}
+
+void view_update_batcher::add(update u, db::view::stats& stats, replica::cf_stats& cf_stats) {
+    auto key = std::make_pair(u.mut.s->id(), u.view_token);
+    auto it = _batches.find(key);
+    if (it != _batches.end() && !it->second.can_merge(u)) {
+        // The view partition moved to other replicas, or its schema changed, since the batch was started.
+        send(std::move(it->second));
+        _batches.erase(it);
+        it = _batches.end();
+    }
+    auto size = u.mut.fm.representation().size();
+    if (it == _batches.end()) {
+        it = _batches.emplace(key, batch{
+            .ermp = std::move(u.ermp),
+            .target = u.target,
+            .pending_endpoints = std::move(u.pending_endpoints),
+            .mut = std::move(u.mut),
+            .merged = std::nullopt,
+            .view_token = u.view_token,
+            .allow_hints = u.allow_hints,
+            .units = {},
+            .stats = &stats,
+            .cf_stats = &cf_stats,
+        }).first;
+    } else {
+        auto& b = it->second;
+        if (!b.merged) {
+            b.merged = b.mut.fm.unfreeze(b.mut.s);
+        }
+        b.merged->apply(u.mut.fm.unfreeze(u.mut.s));
+        stats.view_updates_coalesced_remote += u.pending_endpoints.size() + 1;
+    }
+    auto& b = it->second;
+    b.units.push_back(std::move(u.units));
+    ++b.updates;
+    b.size += size;
+    if (b.size >= size_t(_max_size_in_kb()) * 1024) {
+        send(std::move(b));
+        _batches.erase(it);
+    } else if (!_timer.armed()) {
+        _timer.arm(std::chrono::milliseconds(_delay_in_ms()));
+    }
+}
+
+void view_update_batcher::flush() {
+    _timer.cancel();
+    auto batches = std::exchange(_batches, {});
+    for (auto& [_, b] : batches) {
+        send(std::move(b));
+    }
+}
+
+void view_update_batcher::drop() noexcept {
+    _timer.cancel();
+    _batches.clear();
+}
+
+void view_update_batcher::send(batch b) {
+    if (b.merged) {
+        b.mut.fm = freeze(*b.merged);
+        b.merged.reset();
+    }
+    size_t updates_pushed_remote = b.updates * (b.pending_endpoints.size() + 1);
+    auto s = b.mut.s;
+    auto target = b.target;
+    auto view_token = b.view_token;
+    // The merged updates come from different base partitions, and batched
+    // updates aren't traced, so there's no base token to report.
+    (void)apply_to_remote_endpoints(_proxy.local(), std::move(b.ermp), b.target, std::move(b.pending_endpoints), std::move(b.mut),
+            dht::token(), view_token, b.allow_hints, tracing::trace_state_ptr()).then_wrapped(
+            [&proxy = _proxy, s = std::move(s), target, view_token, updates_pushed_remote, updates = b.updates, stats = b.stats, cf_stats = b.cf_stats,
+             units = std::move(b.units)] (future<>&& f) mutable {
+        units.clear();
+        proxy.local().update_view_update_backlog();
+        if (f.failed()) {
+            stats->view_updates_failed_remote += updates_pushed_remote;
+            cf_stats->total_view_updates_failed_remote += updates_pushed_remote;
+            auto ep = f.get_exception();
+            static thread_local logger::rate_limit view_update_error_rate_limit(std::chrono::seconds(4));
+            vlogger.log(log_level::warn, view_update_error_rate_limit,
+                "Error applying {} merged view updates to {} (view: {}.{}, view token: {}): {}",
+                updates, target, s->ks_name(), s->cf_name(), view_token, ep);
+        }
+    });
+}
+
 static bool should_update_synchronously(const schema& s) {
     auto tag_opt = db::find_tag(s, db::SYNCHRONOUS_VIEW_UPDATES_TAG_KEY);
     if (!tag_opt.has_value()) {
@@ -1955,6 +2059,18 @@ future<> view_update_generator::mutate_MV(
             size_t updates_pushed_remote = remote_endpoints.size() + 1;
             stats.view_updates_pushed_remote += updates_pushed_remote;
             cf_stats.total_view_updates_pushed_remote += updates_pushed_remote;
+            if (!apply_update_synchronously && !tr_state && _update_batcher->enabled()) {
+                _update_batcher->add(view_update_batcher::update{
+                    .ermp = std::move(view_ermp),
+                    .target = *target_endpoint,
+                    .pending_endpoints = std::move(remote_endpoints),
+                    .mut = std::move(mut),
+                    .view_token = view_token,
+                    .allow_hints = allow_hints,
+                    .units = std::move(sem_units),
+                }, stats, cf_stats);
+                co_return co_await std::move(local_view_update);
+            }
             schema_ptr s = mut.s;
             future<> remote_view_update = apply_to_remote_endpoints(_proxy.local(), std::move(view_ermp), *target_endpoint, std::move(remote_endpoints), std::move(mut), base_token, view_token, allow_hints, tr_state).then_wrapped(
                 [s = std::move(s), &stats, &cf_stats, tr_state, base_token, view_token, target_endpoint, updates_pushed_remote,
@@ -2800,6 +2916,95 @@ void view_builder::init_virtual_table() {
 }
 
 // Called in the context of a seastar::thread.
+// The view updates of the batches flushed by a build step which are being
+// sent to the view replicas. Waiting for the view replicas to acknowledge
+// the updates of each partition before reading the next one would leave
+// both the base and the view replicas mostly idle, so up to
+// max_concurrent_flushes batches are sent at once. The memory they use is
+// still bounded by the view update semaphore.
+//
+// If a flush fails, the step is rewound to the partition of that flush, so
+// that retrying the step rebuilds the views from there, as it would have if
+// the flushes had been waited for one by one.
+class view_builder::pending_flushes {
+    struct flush {
+        dht::decorated_key key;
+        future<> done;
+    };
+    std::deque<flush> _flushes;
+    std::optional<dht::decorated_key> _failed_key;
+    std::exception_ptr _error;
+
+    // Must be called in a seastar thread.
+    void wait_for_oldest() {
+        auto f = std::move(_flushes.front());
+        _flushes.pop_front();
+        try {
+            f.done.get();
+        } catch (...) {
+            if (!_error) {
+                _error = std::current_exception();
+                _failed_key = std::move(f.key);
+            }
+        }
+    }
+
+    // Must be called in a seastar thread.
+    void drain(build_step& step) {
+        while (!_flushes.empty()) {
+            wait_for_oldest();
+        }
+        if (_failed_key) {
+            step.current_key = std::move(*_failed_key);
+            _failed_key.reset();
+            for (auto& vs : step.build_status) {
+                if (vs.next_token && *vs.next_token > step.current_token()) {
+                    vs.next_token = step.current_token();
+                }
+            }
+        }
+    }
+
+public:
+    pending_flushes() = default;
+    pending_flushes(pending_flushes&&) = delete;
+
+    ~pending_flushes() {
+        SCYLLA_ASSERT(_flushes.empty());
+    }
+
+    // Must be called in a seastar thread.
+    void add(build_step& step, dht::decorated_key key, future<> done) {
+        _flushes.push_back(flush{std::move(key), std::move(done)});
+        if (_flushes.size() > max_concurrent_flushes) {
+            wait_for_oldest();
+        }
+        if (_error) {
+            wait(step);
+        }
+    }
+
+    // Waits for all the pending flushes and throws the error of the first
+    // one which failed, if any.
+    // Must be called in a seastar thread.
+    void wait(build_step& step) {
+        drain(step);
+        if (auto ep = std::exchange(_error, nullptr)) {
+            std::rethrow_exception(std::move(ep));
+        }
+    }
+
+    // Like wait(), but leaves the error to the caller, which is already
+    // failing the step.
+    // Must be called in a seastar thread.
+    void wait_on_error(build_step& step) {
+        drain(step);
+        if (auto ep = std::exchange(_error, nullptr)) {
+            vlogger.debug("Flushing view updates of build step failed: {}", ep);
+        }
+    }
+};
+
 class view_builder::consumer {
 public:
     struct built_views {
@@ -2831,6 +3036,7 @@ class view_builder::consumer {
     view_builder& _builder;
     shared_ptr<view_update_generator> _gen;
     build_step& _step;
+    pending_flushes& _flushes;
     built_views _built_views;
     gc_clock::time_point _now;
     std::vector<view_ptr> _views_to_build;
@@ -2846,10 +3052,11 @@ class view_builder::consumer {
     // beyond our limit on mutation size (by default 32 MB).
     size_t _fragments_memory_usage = 0;
 public:
-    consumer(view_builder& builder, shared_ptr<view_update_generator> gen, build_step& step, gc_clock::time_point now)
+    consumer(view_builder& builder, shared_ptr<view_update_generator> gen, build_step& step, pending_flushes& flushes, gc_clock::time_point now)
             : _builder(builder)
             , _gen(std::move(gen))
             , _step(step)
+            , _flushes(flushes)
             , _built_views{step}
             , _now(now) {
         if (!step.current_key.key().is_empty(*_step.reader.schema())) {
@@ -2882,6 +3089,8 @@ class view_builder::consumer {
             // In the system tables, we set first_token = next_token to signal the completion of the build
             // process in case of a restart.
             if (it->next_token && *it->next_token <= it->first_token && _step.current_token() >= it->first_token) {
+                // The view is built only once the updates of all its partitions were sent.
+                _flushes.wait(_step);
                 _built_views.views.push_back(std::move(*it));
                 it = _step.build_status.erase(it);
             } else {
@@ -2957,15 +3166,16 @@ class view_builder::consumer {
             auto reader = make_mutation_reader_from_fragments(_step.reader.schema(), _builder._permit, std::move(_fragments));
             auto close_reader = defer([&reader] { reader.close().get(); });
             reader.upgrade_schema(base_schema);
-            _gen->populate_views(
+            auto done = _gen->populate_views(
                     *_step.base,
                     std::move(views),
                     _step.current_token(),
                     std::move(reader),
-                    _now).get();
+                    _now);
             close_reader.cancel();
             _fragments.clear();
             _fragments_memory_usage = 0;
+            _flushes.add(_step, _step.current_key, std::move(done));
         }
     }
 
@@ -2978,6 +3188,7 @@ class view_builder::consumer {
     // Must be called in a seastar thread.
     built_views consume_end_of_stream() {
         inject_failure("view_builder_consume_end_of_stream");
+        _flushes.wait(_step);
         if (vlogger.is_enabled(log_level::debug)) {
             auto view_names = boost::copy_range<std::vector<sstring>>(
                     _views_to_build | boost::adaptors::transformed([](auto v) {
@@ -3015,8 +3226,16 @@ void view_builder::execute(build_step& step, exponential_backoff_retry r) {
             step.pslice,
             batch_size,
             query::max_partitions);
-    auto consumer = compact_for_query_v2<view_builder::consumer>(compaction_state, view_builder::consumer{*this, _vug.shared_from_this(), step, now});
-    auto built = step.reader.consume_in_thread(std::move(consumer));
+    pending_flushes flushes;
+    auto consumer = compact_for_query_v2<view_builder::consumer>(compaction_state, view_builder::consumer{*this, _vug.shared_from_this(), step, flushes, now});
+    auto built = [&] {
+        try {
+            return step.reader.consume_in_thread(std::move(consumer));
+        } catch (...) {
+            flushes.wait_on_error(step);
+            throw;
+        }
+    }();
     if (auto ds = std::move(*compaction_state).detach_state()) {
         if (ds->current_tombstone) {
             step.reader.unpop_mutation_fragment(mutation_fragment_v2(*step.reader.schema(), step.reader.permit(), std::move(*ds->current_tombstone)));
@@ -64,6 +64,8 @@ class view_update_generator;
  * We aim to be resource-conscious. On a given shard, at any given moment, we consume at most
  * from one reader. We also strive for fairness, in that each build step inserts entries for
  * the views of a different base. Each build step reads and generates updates for batch_size rows.
+ * The updates of up to max_concurrent_flushes partitions (or memory batches) of a step are sent to
+ * the view replicas at once, rather than waiting for each partition before reading the next.
  *
  * We lack a controller, which could potentially allow us to go faster (to execute multiple steps at
  * the same time, or consume more rows per batch), and also which would apply backpressure, so we
@@ -193,6 +195,9 @@ class view_builder final : public service::migration_listener::only_view_notific
     // collected batch_memory_max bytes, we can process the rows read so far.
     static constexpr size_t batch_size = 128;
     static constexpr size_t batch_memory_max = 1024*1024;
+    // The number of flushed batches of a build step whose view updates are
+    // sent to the view replicas at once.
+    static constexpr size_t max_concurrent_flushes = 16;
 
     replica::database& get_db() noexcept { return _db; }
 
@@ -278,6 +283,7 @@ class view_builder final : public service::migration_listener::only_view_notific
     future<std::unordered_map<locator::host_id, sstring>> view_status(sstring ks_name, sstring view_name) const;
 
     struct consumer;
+    class pending_flushes;
 };
 
 }
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <vector>
+
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+#include "db/timeout_clock.hh"
+#include "dht/token.hh"
+#include "gms/inet_address.hh"
+#include "inet_address_vectors.hh"
+#include "locator/abstract_replication_strategy.hh"
+#include "mutation/frozen_mutation.hh"
+#include "mutation/mutation.hh"
+#include "utils/updateable_value.hh"
+
+namespace replica {
+struct cf_stats;
+}
+
+namespace service {
+class storage_proxy;
+struct allow_hints_tag;
+using allow_hints = bool_class<allow_hints_tag>;
+}
+
+namespace db::view {
+
+class stats;
+
+// Coalesces the background updates of a view partition, generated by writes
+// to different base partitions, which are headed for the same view replicas.
+//
+// Every update sent to a remote view replica costs a MUTATION RPC and a write
+// response handler, which for views with few, hot partitions (e.g. a view
+// keyed by a low-cardinality column) dominate the cost of the update itself
+// and keep units of the view update semaphore - and so the view update
+// backlog - high. The batcher holds such updates for up to the configured
+// delay, merges the updates of the same view partition into one mutation,
+// and sends it as a single write, once the delay passes or the merged
+// mutation reaches the configured size.
+//
+// Only updates whose result isn't waited for are batched: a failure of a
+// merged write is accounted for every update merged into it.
+class view_update_batcher {
+public:
+    struct update {
+        locator::effective_replication_map_ptr ermp;
+        gms::inet_address target;
+        inet_address_vector_topology_change pending_endpoints;
+        frozen_mutation_and_schema mut;
+        dht::token view_token;
+        service::allow_hints allow_hints;
+        // Released once the update is sent.
+        lw_shared_ptr<db::timeout_semaphore_units> units;
+    };
+
+private:
+    struct batch {
+        locator::effective_replication_map_ptr ermp;
+        gms::inet_address target;
+        inet_address_vector_topology_change pending_endpoints;
+        frozen_mutation_and_schema mut;
+        // Engaged once another update is merged into mut.
+        std::optional<mutation> merged;
+        dht::token view_token;
+        service::allow_hints allow_hints;
+        std::vector<lw_shared_ptr<db::timeout_semaphore_units>> units;
+        db::view::stats* stats;
+        replica::cf_stats* cf_stats;
+        size_t updates = 0;
+        size_t size = 0;
+
+        bool can_merge(const update& u) const;
+    };
+
+    sharded<service::storage_proxy>& _proxy;
+    utils::updateable_value<uint32_t> _delay_in_ms;
+    utils::updateable_value<uint32_t> _max_size_in_kb;
+    std::map<std::pair<table_id, dht::token>, batch> _batches;
+    timer<> _timer;
+
+    void send(batch b);
+public:
+    view_update_batcher(sharded<service::storage_proxy>& proxy, utils::updateable_value<uint32_t> delay_in_ms,
+            utils::updateable_value<uint32_t> max_size_in_kb);
+
+    bool enabled() const noexcept {
+        return _delay_in_ms() > 0;
+    }
+
+    void add(update u, db::view::stats& stats, replica::cf_stats& cf_stats);
+
+    // Sends all the pending batches.
+    void flush();
+
+    // Drops all the pending batches, without sending them.
+    void drop() noexcept;
+};
+
+} // namespace db::view
@@ -13,6 +13,8 @@
 #include <boost/range/adaptor/map.hpp>
 #include "replica/database.hh"
 #include "view_update_generator.hh"
+#include "db/view/view_update_batcher.hh"
+#include "db/config.hh"
 #include "utils/error_injection.hh"
 #include "db/view/view_updating_consumer.hh"
 #include "sstables/sstables.hh"
@@ -99,6 +101,9 @@ view_update_generator::view_update_generator(replica::database& db, sharded<serv
         : _db(db)
         , _proxy(proxy)
         , _progress_tracker(std::make_unique<progress_tracker>())
+        , _update_batcher(std::make_unique<view_update_batcher>(proxy,
+                utils::updateable_value<uint32_t>(_db.get_config().view_update_batch_delay_in_ms),
+                utils::updateable_value<uint32_t>(_db.get_config().view_update_batch_max_size_in_kb)))
         , _early_abort_subscription(as.subscribe([this] () noexcept { do_abort(); }))
 {
     setup_metrics();
@@ -243,11 +248,13 @@ void view_update_generator::do_abort() noexcept {
 }
 
 future<> view_update_generator::drain() {
+    _update_batcher->drop();
     return _proxy.local().abort_view_writes();
 }
 
 future<> view_update_generator::stop() {
     _db.unplug_view_update_generator();
+    _update_batcher->drop();
     do_abort();
     return std::move(_started).then([this] {
         _registration_sem.broken();
@@ -52,6 +52,7 @@ namespace db::view {
 
 class stats;
 struct view_and_base;
+class view_update_batcher;
 struct wait_for_all_updates_tag {};
 using wait_for_all_updates = bool_class<wait_for_all_updates_tag>;
 
@@ -71,6 +72,7 @@ class view_update_generator : public async_sharded_service<view_update_generator
     metrics::metric_groups _metrics;
     class progress_tracker;
     std::unique_ptr<progress_tracker> _progress_tracker;
+    std::unique_ptr<view_update_batcher> _update_batcher;
     optimized_optional<abort_source::subscription> _early_abort_subscription;
     void do_abort() noexcept;
 public:
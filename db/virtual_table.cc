@@ -37,6 +37,18 @@ bool virtual_table::contains_key(const dht::partition_range& pr, const dht::deco
     return pr.contains(dk, dht::ring_position_comparator(*_s));
 }
 
+bool virtual_table::may_contain_rows(const query_restrictions& qr, const dht::decorated_key& dk, const clustering_key_prefix& prefix) const {
+    // Comparing with the prefix ignores the components past it, so the keys
+    // which start with the prefix compare equal with it. Inclusiveness of the
+    // bounds is ignored, which may only make the result true when it could
+    // have been false.
+    auto cmp = clustering_key_prefix::prefix_equal_tri_compare(*_s);
+    return std::ranges::any_of(qr.slice().row_ranges(*_s, dk.key()), [&] (const query::clustering_range& r) {
+        return (!r.start() || cmp(prefix, r.start()->value()) >= 0)
+            && (!r.end() || cmp(prefix, r.end()->value()) <= 0);
+    });
+}
+
 mutation_source memtable_filling_virtual_table::as_mutation_source() {
     return mutation_source([this] (schema_ptr s,
         reader_permit permit,
@@ -53,6 +65,23 @@ mutation_source memtable_filling_virtual_table::as_mutation_source() {
             my_units(reader_permit::resource_units&& units) : units(std::move(units)), memory_used(0) {}
         };
 
+        struct my_query_restrictions : public query_restrictions {
+            const dht::partition_range& pr;
+            query::partition_slice unreversed_slice;
+
+            my_query_restrictions(const schema& s, const dht::partition_range& pr, const query::partition_slice& slice)
+                : pr(pr)
+                , unreversed_slice(slice.is_reversed() ? query::reverse_slice(s, slice) : slice)
+            { }
+
+            const dht::partition_range& partition_range() const override {
+                return pr;
+            }
+            const query::partition_slice& slice() const override {
+                return unreversed_slice;
+            }
+        };
+
         auto units = make_lw_shared<my_units>(permit.consume_memory(0));
 
         auto populate = [this, mt = make_lw_shared<replica::memtable>(schema()), s, units, range, slice, trace_state, fwd, fwd_mr] () mutable {
@@ -62,7 +91,10 @@ mutation_source memtable_filling_virtual_table::as_mutation_source() {
                 units->memory_used = mt->occupancy().used_space();
             };
 
-            return execute(mutation_sink).then([this, mt, s, units, &range, &slice, &trace_state, &fwd, &fwd_mr] () {
+            // range and slice are kept alive by populate, which is kept alive by the reader.
+            auto qr = std::make_unique<my_query_restrictions>(*s, range, slice);
+            auto f = execute(mutation_sink, *qr);
+            return f.then([this, mt, s, units, &range, &slice, &trace_state, &fwd, &fwd_mr, qr = std::move(qr)] () {
                 auto rd = mt->as_data_source().make_reader_v2(s, units->units.permit(), range, slice, trace_state, fwd, fwd_mr);
 
                 if (!_shard_aware) {
@@ -108,12 +140,14 @@ mutation_source streaming_virtual_table::as_mutation_source() {
             // Valid until handle.is_terminated(), which is set to true when the
             // queue_reader dies.
             const dht::partition_range* pr;
+            const query::partition_slice* slice;
             mutation_reader::forwarding fwd_mr;
 
-            my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, queue_reader_handle_v2&& handle)
+            my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, const query::partition_slice* slice, queue_reader_handle_v2&& handle)
                 : result_collector(s, p)
                 , handle(std::move(handle))
                 , pr(pr)
+                , slice(slice)
             { }
 
             // result_collector
@@ -128,10 +162,16 @@ mutation_source streaming_virtual_table::as_mutation_source() {
                 }
                 return *pr;
             }
+            const query::partition_slice& slice() const override {
+                if (handle.is_terminated()) {
+                    throw std::runtime_error("read abandoned");
+                }
+                return *slice;
+            }
         };
 
         auto reader_and_handle = make_queue_reader_v2(table_schema, permit);
-        auto consumer = std::make_unique<my_result_collector>(table_schema, permit, &pr, std::move(reader_and_handle.second));
+        auto consumer = std::make_unique<my_result_collector>(table_schema, permit, &pr, &slice, std::move(reader_and_handle.second));
         auto f = execute(permit, *consumer, *consumer);
 
         // It is safe to discard this future because:
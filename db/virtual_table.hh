@@ -33,8 +33,20 @@ class virtual_table {
     class query_restrictions {
     public:
         virtual const dht::partition_range& partition_range() const = 0;
+        // The slice of the query, in the order of the table's schema even
+        // for reversed queries.
+        virtual const query::partition_slice& slice() const = 0;
     };
 
+protected:
+    // Whether the query may select rows of the partition whose clustering
+    // key starts with the given prefix. May return true when it doesn't,
+    // so allows skipping the production of rows (or of a group of rows
+    // sharing a prefix) which are known not to be selected.
+    bool may_contain_rows(const query_restrictions&, const dht::decorated_key&, const clustering_key_prefix&) const;
+
+public:
+
     explicit virtual_table(schema_ptr s) : _s(std::move(s)) {}
     virtual ~virtual_table() = default;
 
@@ -47,7 +59,8 @@ class virtual_table {
 };
 
 // Produces results by filling a memtable on each read.
-// Use when the amount of data is not significant relative to shard's memory size.
+// Use when the amount of data is not significant relative to shard's memory size,
+// larger tables should be streaming_virtual_table.
 class memtable_filling_virtual_table : public virtual_table {
 public:
     using virtual_table::virtual_table;
@@ -99,7 +112,9 @@ class result_collector {
 //
 //  - avoid emitting partitions for which this_shard_owns() returns false.
 //
-//  - avoid emitting partitions which fall outside result_collector::partition_range().
+//  - avoid emitting partitions which fall outside query_restrictions::partition_range().
+//
+//  - avoid emitting rows for which may_contain_rows() returns false.
 //
 class streaming_virtual_table : public virtual_table {
 public:
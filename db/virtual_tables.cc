@@ -31,7 +31,10 @@
 #include "schema/schema_builder.hh"
 #include "service/raft/raft_group_registry.hh"
 #include "service/storage_service.hh"
+#include "tracing/trace_log_helper.hh"
 #include "types/list.hh"
+#include "types/map.hh"
+#include "types/set.hh"
 #include "types/types.hh"
 #include "utils/build_id.hh"
 #include "utils/log.hh"
@@ -205,16 +208,21 @@ class token_ring_table : public streaming_virtual_table {
                 continue;
             }
 
+            // Describing the ring of every table is expensive with many tables, so
+            // skip the tables whose rows aren't selected.
+            auto selects_table = [&] (const sstring& table_name) {
+                return may_contain_rows(qr, dk, clustering_key_prefix::from_single_value(*_s, data_value(table_name).serialize_nonnull()));
+            };
             if (_db.find_keyspace(e.name).get_replication_strategy().uses_tablets()) {
                 co_await _db.get_tables_metadata().for_each_table_gently([&, this] (table_id, lw_shared_ptr<replica::table> table) -> future<> {
-                    if (table->schema()->ks_name() != e.name) {
+                    if (table->schema()->ks_name() != e.name || !selects_table(table->schema()->cf_name())) {
                         co_return;
                     }
                     const auto& table_name = table->schema()->cf_name();
                     std::vector<dht::token_range_endpoints> ranges = co_await _ss.describe_ring_for_table(e.name, table_name);
                     co_await emit_ring(result, e.key, table_name, std::move(ranges));
                 });
-            } else {
+            } else if (selects_table("<ALL>")) {
                 std::vector<dht::token_range_endpoints> ranges = co_await _ss.describe_ring(e.name);
                 co_await emit_ring(result, e.key, "<ALL>", std::move(ranges));
             }
@@ -299,6 +307,108 @@ class snapshots_table : public streaming_virtual_table {
     }
 };
 
+class hot_partitions_table : public streaming_virtual_table {
+    distributed<replica::database>& _db;
+public:
+    explicit hot_partitions_table(distributed<replica::database>& db)
+            : streaming_virtual_table(build_schema())
+            , _db(db)
+    {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "hot_partitions");
+        return schema_builder(system_keyspace::NAME, "hot_partitions", std::make_optional(id))
+            .with_column("keyspace_name", utf8_type, column_kind::partition_key)
+            .with_column("table_name", utf8_type, column_kind::clustering_key)
+            .with_column("operation", utf8_type, column_kind::clustering_key)
+            .with_column("shard", int32_type, column_kind::clustering_key)
+            .with_column("partition", utf8_type, column_kind::clustering_key)
+            .with_column("count", long_type)
+            .with_column("error", long_type)
+            .set_comment("Lists the hottest partitions of each table on each shard, as continuously sampled over the last few seconds.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    dht::decorated_key make_partition_key(const sstring& name) {
+        return dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(name).serialize_nonnull()));
+    }
+
+    clustering_key make_clustering_key(sstring table_name, sstring operation, int32_t shard, sstring partition) {
+        return clustering_key::from_exploded(*_s, {
+            data_value(std::move(table_name)).serialize_nonnull(),
+            data_value(std::move(operation)).serialize_nonnull(),
+            data_value(shard).serialize_nonnull(),
+            data_value(std::move(partition)).serialize_nonnull()
+        });
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        struct decorated_keyspace_name {
+            schema_ptr s;
+            dht::decorated_key key;
+
+            auto operator<=>(const decorated_keyspace_name& o) const {
+                return key.tri_compare(*o.s, o.key);
+            }
+        };
+
+        struct hot_partition {
+            sstring ks;
+            sstring cf;
+            sstring operation;
+            int32_t shard;
+            db::hot_key_sampler::entry entry;
+        };
+        using hot_partitions = std::vector<hot_partition>;
+
+        auto all = co_await _db.map_reduce0([] (replica::database& db) {
+            hot_partitions ret;
+            db.get_tables_metadata().for_each_table([&] (table_id, lw_shared_ptr<replica::table> t) {
+                auto& hot_keys = t->get_stats().hot_keys;
+                auto add = [&] (sstring operation, db::hot_key_sampler::entries entries) {
+                    for (auto& e : entries) {
+                        ret.push_back(hot_partition{t->schema()->ks_name(), t->schema()->cf_name(), operation, int32_t(this_shard_id()), std::move(e)});
+                    }
+                };
+                add("read", hot_keys.top_reads(db::hot_key_sampler::capacity));
+                add("write", hot_keys.top_writes(db::hot_key_sampler::capacity));
+            });
+            return ret;
+        }, hot_partitions(), [] (hot_partitions a, hot_partitions b) {
+            std::move(b.begin(), b.end(), std::back_inserter(a));
+            return a;
+        });
+
+        // Rows are emitted in clustering order, which matches the natural order of the clustering columns.
+        using rows_map = std::map<std::tuple<sstring, sstring, int32_t, sstring>, db::hot_key_sampler::entry>;
+        std::map<decorated_keyspace_name, rows_map> keyspaces;
+        for (auto& hp : all) {
+            auto dk = make_partition_key(hp.ks);
+            if (!this_shard_owns(dk) || !contains_key(qr.partition_range(), dk)) {
+                continue;
+            }
+            auto key = std::make_tuple(std::move(hp.cf), std::move(hp.operation), hp.shard, hp.entry.partition);
+            keyspaces[decorated_keyspace_name(_s, dk)].emplace(std::move(key), std::move(hp.entry));
+        }
+        for (const auto& [ks_data, rows] : keyspaces) {
+            co_await result.emit_partition_start(ks_data.key);
+
+            for (const auto& [key, e] : rows) {
+                auto& [table_name, operation, shard, partition] = key;
+                clustering_row cr(make_clustering_key(table_name, operation, shard, partition));
+                set_cell(cr.cells(), "count", int64_t(e.count));
+                set_cell(cr.cells(), "error", int64_t(e.error));
+                co_await result.emit_row(std::move(cr));
+            }
+
+            co_await result.emit_partition_end();
+        }
+    }
+};
+
 class protocol_servers_table : public memtable_filling_virtual_table {
 private:
     service::storage_service& _ss;
@@ -374,6 +484,21 @@ class runtime_info_table : public memtable_filling_virtual_table {
         return std::nullopt;
     }
 
+    // Some of the values are computed over all the tables of all shards, so
+    // only those which are queried are.
+    std::optional<dht::decorated_key> maybe_make_key(sstring key, const query_restrictions& qr) {
+        auto dk = maybe_make_key(std::move(key));
+        if (dk && contains_key(qr.partition_range(), *dk)) {
+            return dk;
+        }
+        return std::nullopt;
+    }
+
+    bool selects_generic_item(const sstring& item, const query_restrictions& qr) const {
+        return _generic_key && contains_key(qr.partition_range(), *_generic_key)
+            && may_contain_rows(qr, *_generic_key, clustering_key_prefix::from_single_value(*_s, data_value(item).serialize_nonnull()));
+    }
+
     void do_add_partition(std::function<void(mutation)>& mutation_sink, dht::decorated_key key, std::vector<std::pair<sstring, sstring>> rows) {
         mutation m(schema(), std::move(key));
         for (auto&& [ckey, cvalue] : rows) {
@@ -383,27 +508,27 @@ class runtime_info_table : public memtable_filling_virtual_table {
         mutation_sink(std::move(m));
     }
 
-    void add_partition(std::function<void(mutation)>& mutation_sink, sstring key, sstring value) {
-        if (_generic_key) {
+    void add_partition(std::function<void(mutation)>& mutation_sink, const query_restrictions& qr, sstring key, sstring value) {
+        if (selects_generic_item(key, qr)) {
             do_add_partition(mutation_sink, *_generic_key, {{key, std::move(value)}});
         }
     }
 
-    void add_partition(std::function<void(mutation)>& mutation_sink, sstring key, std::initializer_list<std::pair<sstring, sstring>> rows) {
-        auto dk = maybe_make_key(std::move(key));
+    void add_partition(std::function<void(mutation)>& mutation_sink, const query_restrictions& qr, sstring key, std::initializer_list<std::pair<sstring, sstring>> rows) {
+        auto dk = maybe_make_key(std::move(key), qr);
         if (dk) {
             do_add_partition(mutation_sink, std::move(*dk), std::move(rows));
         }
     }
 
-    future<> add_partition(std::function<void(mutation)>& mutation_sink, sstring key, std::function<future<sstring>()> value_producer) {
-        if (_generic_key) {
+    future<> add_partition(std::function<void(mutation)>& mutation_sink, const query_restrictions& qr, sstring key, std::function<future<sstring>()> value_producer) {
+        if (selects_generic_item(key, qr)) {
             do_add_partition(mutation_sink, *_generic_key, {{key, co_await value_producer()}});
         }
     }
 
-    future<> add_partition(std::function<void(mutation)>& mutation_sink, sstring key, std::function<future<std::vector<std::pair<sstring, sstring>>>()> value_producer) {
-        auto dk = maybe_make_key(std::move(key));
+    future<> add_partition(std::function<void(mutation)>& mutation_sink, const query_restrictions& qr, sstring key, std::function<future<std::vector<std::pair<sstring, sstring>>>()> value_producer) {
+        auto dk = maybe_make_key(std::move(key), qr);
         if (dk) {
             do_add_partition(mutation_sink, std::move(*dk), co_await value_producer());
         }
@@ -463,22 +588,22 @@ class runtime_info_table : public memtable_filling_virtual_table {
             .build();
     }
 
-    future<> execute(std::function<void(mutation)> mutation_sink) override {
-        co_await add_partition(mutation_sink, "gossip_active", [this] () -> future<sstring> {
+    future<> execute(std::function<void(mutation)> mutation_sink, const query_restrictions& qr) override {
+        co_await add_partition(mutation_sink, qr, "gossip_active", [this] () -> future<sstring> {
             return _ss.is_gossip_running().then([] (bool running){
                 return format("{}", running);
             });
         });
-        co_await add_partition(mutation_sink, "load", [this] () -> future<sstring> {
+        co_await add_partition(mutation_sink, qr, "load", [this] () -> future<sstring> {
             return map_reduce_tables<int64_t>([] (replica::table& tbl) {
                 return tbl.get_stats().live_disk_space_used;
             }).then([] (int64_t load) {
                 return format("{}", load);
             });
         });
-        add_partition(mutation_sink, "uptime", format("{} seconds", std::chrono::duration_cast<std::chrono::seconds>(engine().uptime()).count()));
-        add_partition(mutation_sink, "trace_probability", format("{:.2}", tracing::tracing::get_local_tracing_instance().get_trace_probability()));
-        co_await add_partition(mutation_sink, "memory", [this] () {
+        add_partition(mutation_sink, qr, "uptime", format("{} seconds", std::chrono::duration_cast<std::chrono::seconds>(engine().uptime()).count()));
+        add_partition(mutation_sink, qr, "trace_probability", format("{:.2}", tracing::tracing::get_local_tracing_instance().get_trace_probability()));
+        co_await add_partition(mutation_sink, qr, "memory", [this] () {
             struct stats {
                 // take the pre-reserved memory into account, as seastar only returns
                 // the stats of memory managed by the seastar allocator, but we instruct
@@ -502,7 +627,7 @@ class runtime_info_table : public memtable_filling_virtual_table {
                         {"free", format("{}", s.free)}};
             });
         });
-        co_await add_partition(mutation_sink, "memtable", [this] () {
+        co_await add_partition(mutation_sink, qr, "memtable", [this] () {
             struct stats {
                 uint64_t total = 0;
                 uint64_t free = 0;
@@ -525,7 +650,7 @@ class runtime_info_table : public memtable_filling_virtual_table {
                         {"entries", format("{}", s.entries)}};
             });
         });
-        co_await add_partition(mutation_sink, "cache", [this] () {
+        co_await add_partition(mutation_sink, qr, "cache", [this] () {
             struct stats {
                 uint64_t total = 0;
                 uint64_t free = 0;
@@ -573,7 +698,7 @@ class runtime_info_table : public memtable_filling_virtual_table {
                         {"requests_recent", format("{}", static_cast<uint64_t>(s.requests_moving_average.mean_rate))}};
             });
         });
-        co_await add_partition(mutation_sink, "incremental_backup_enabled", [this] () {
+        co_await add_partition(mutation_sink, qr, "incremental_backup_enabled", [this] () {
             return _db.map_reduce0([] (replica::database& db) {
                 return boost::algorithm::any_of(db.get_keyspaces(), [] (const auto& id_and_ks) {
                     return id_and_ks.second.incremental_backups_enabled();
@@ -970,6 +1095,181 @@ class raft_state_table : public streaming_virtual_table {
     }
 };
 
+static db_clock::time_point to_db_clock(std::chrono::system_clock::time_point tp) {
+    return db_clock::time_point(std::chrono::duration_cast<db_clock::duration>(tp.time_since_epoch()));
+}
+
+static int32_t to_int32_micros(std::chrono::microseconds d) {
+    return std::min<int64_t>(d.count(), std::numeric_limits<int32_t>::max());
+}
+
+// Rows produced in any order, collected to be emitted in the order of the
+// schema. The memory they use is accounted to the permit of the read.
+class sorted_rows {
+    schema_ptr _s;
+    reader_permit::resource_units _units;
+    using rows_map = std::map<clustering_key, clustering_row, clustering_key::less_compare>;
+    std::map<dht::decorated_key, rows_map, dht::decorated_key::less_comparator> _partitions;
+public:
+    sorted_rows(schema_ptr s, reader_permit permit)
+        : _s(s)
+        , _units(permit.consume_memory(0))
+        , _partitions(dht::decorated_key::less_comparator(s))
+    { }
+
+    void add(const dht::decorated_key& dk, clustering_row cr) {
+        _units.add(_units.permit().consume_memory(cr.memory_usage(*_s)));
+        auto& rows = _partitions.try_emplace(dk, clustering_key::less_compare(*_s)).first->second;
+        auto ck = cr.key();
+        rows.insert_or_assign(std::move(ck), std::move(cr));
+    }
+
+    future<> emit(result_collector& result) {
+        for (auto& [dk, rows] : _partitions) {
+            co_await result.emit_partition_start(dk);
+            for (auto& [ck, cr] : rows) {
+                co_await result.emit_row(std::move(cr));
+            }
+            co_await result.emit_partition_end();
+        }
+    }
+};
+
+// The session records of the tracing log (see tracing_backend), the columns
+// are the ones of system_traces.sessions. Every read goes over all of the
+// log, so it's best restricted to a session_id; only the selected sessions
+// are kept in memory.
+class trace_log_sessions_table : public streaming_virtual_table {
+    const db::config& _cfg;
+public:
+    explicit trace_log_sessions_table(const db::config& cfg)
+            : streaming_virtual_table(build_schema())
+            , _cfg(cfg)
+    {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "trace_log_sessions");
+        return schema_builder(system_keyspace::NAME, "trace_log_sessions", std::make_optional(id))
+            .with_column("session_id", uuid_type, column_kind::partition_key)
+            .with_column("client", inet_addr_type)
+            .with_column("command", utf8_type)
+            .with_column("coordinator", inet_addr_type)
+            .with_column("duration", int32_type)
+            .with_column("parameters", map_type_impl::get_instance(utf8_type, utf8_type, false))
+            .with_column("request", utf8_type)
+            .with_column("request_size", int32_type)
+            .with_column("response_size", int32_type)
+            .with_column("started_at", timestamp_type)
+            .with_column("username", utf8_type)
+            .with_column("tables", set_type_impl::get_instance(utf8_type, false))
+            .with_column("shard", int32_type)
+            .set_comment("Tracing sessions written to the local tracing log")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        sorted_rows rows(_s, permit);
+        co_await tracing::read_trace_log(std::filesystem::path(_cfg.tracing_log_directory()), [this, &rows, &qr] (tracing::trace_log_record rec) {
+            auto* session = std::get_if<tracing::trace_log_session>(&rec);
+            if (!session) {
+                return make_ready_future<>();
+            }
+            auto dk = dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(session->session_id).serialize_nonnull()));
+            if (!this_shard_owns(dk) || !contains_key(qr.partition_range(), dk)) {
+                return make_ready_future<>();
+            }
+
+            clustering_row cr(clustering_key::make_empty());
+            set_cell(cr.cells(), "client", session->client);
+            set_cell(cr.cells(), "command", tracing::type_to_string(session->command));
+            set_cell(cr.cells(), "coordinator", session->coordinator);
+            set_cell(cr.cells(), "duration", to_int32_micros(session->duration));
+            map_type_impl::native_type parameters;
+            for (auto& [key, value] : session->parameters) {
+                parameters.emplace_back(key, value);
+            }
+            set_cell(cr.cells(), "parameters", make_map_value(schema()->get_column_definition("parameters")->type, std::move(parameters)));
+            set_cell(cr.cells(), "request", session->request);
+            set_cell(cr.cells(), "request_size", int32_t(session->request_size));
+            set_cell(cr.cells(), "response_size", int32_t(session->response_size));
+            set_cell(cr.cells(), "started_at", to_db_clock(session->started_at));
+            set_cell(cr.cells(), "username", session->username);
+            set_type_impl::native_type tables;
+            for (auto& table : session->tables) {
+                tables.emplace_back(table);
+            }
+            set_cell(cr.cells(), "tables", make_set_value(schema()->get_column_definition("tables")->type, std::move(tables)));
+            set_cell(cr.cells(), "shard", int32_t(session->shard));
+            rows.add(dk, std::move(cr));
+            return make_ready_future<>();
+        });
+        co_await rows.emit(result);
+    }
+};
+
+// The event records of the tracing log (see tracing_backend), the columns
+// are the ones of system_traces.events. Every read goes over all of the log,
+// so it's best restricted to a session_id; only the selected events are kept
+// in memory.
+class trace_log_events_table : public streaming_virtual_table {
+    const db::config& _cfg;
+public:
+    explicit trace_log_events_table(const db::config& cfg)
+            : streaming_virtual_table(build_schema())
+            , _cfg(cfg)
+    {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "trace_log_events");
+        return schema_builder(system_keyspace::NAME, "trace_log_events", std::make_optional(id))
+            .with_column("session_id", uuid_type, column_kind::partition_key)
+            .with_column("event_id", timeuuid_type, column_kind::clustering_key)
+            .with_column("activity", utf8_type)
+            .with_column("source", inet_addr_type)
+            .with_column("source_elapsed", int32_type)
+            .with_column("thread", utf8_type)
+            .with_column("scylla_parent_id", long_type)
+            .with_column("scylla_span_id", long_type)
+            .set_comment("Tracing events written to the local tracing log")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        sorted_rows rows(_s, permit);
+        co_await tracing::read_trace_log(std::filesystem::path(_cfg.tracing_log_directory()), [this, &rows, &qr] (tracing::trace_log_record rec) {
+            auto* event = std::get_if<tracing::trace_log_event>(&rec);
+            if (!event) {
+                return make_ready_future<>();
+            }
+            auto dk = dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(event->session_id).serialize_nonnull()));
+            if (!this_shard_owns(dk) || !contains_key(qr.partition_range(), dk)) {
+                return make_ready_future<>();
+            }
+            auto ck = clustering_key::from_single_value(*schema(), data_value(timeuuid_native_type{event->event_id}).serialize_nonnull());
+            if (!may_contain_rows(qr, dk, ck)) {
+                return make_ready_future<>();
+            }
+
+            clustering_row cr(std::move(ck));
+            set_cell(cr.cells(), "activity", event->activity);
+            set_cell(cr.cells(), "source", event->source);
+            set_cell(cr.cells(), "source_elapsed", to_int32_micros(event->elapsed));
+            set_cell(cr.cells(), "thread", event->thread);
+            set_cell(cr.cells(), "scylla_parent_id", int64_t(event->parent_id.get_id()));
+            set_cell(cr.cells(), "scylla_span_id", int64_t(event->my_span_id.get_id()));
+            rows.add(dk, std::move(cr));
+            return make_ready_future<>();
+        });
+        co_await rows.emit(result);
+    }
+};
+
 }
 
 future<> initialize_virtual_tables(
@@ -997,12 +1297,15 @@ future<> initialize_virtual_tables(
     co_await add_table(std::make_unique<cluster_status_table>(dist_ss, dist_gossiper));
     co_await add_table(std::make_unique<token_ring_table>(db, ss));
     co_await add_table(std::make_unique<snapshots_table>(dist_db));
+    co_await add_table(std::make_unique<hot_partitions_table>(dist_db));
     co_await add_table(std::make_unique<protocol_servers_table>(ss));
     co_await add_table(std::make_unique<runtime_info_table>(dist_db, ss));
     co_await add_table(std::make_unique<versions_table>());
     co_await add_table(std::make_unique<db_config_table>(cfg));
     co_await add_table(std::make_unique<clients_table>(ss));
     co_await add_table(std::make_unique<raft_state_table>(dist_raft_gr));
+    co_await add_table(std::make_unique<trace_log_sessions_table>(cfg));
+    co_await add_table(std::make_unique<trace_log_events_table>(cfg));
 
     db.find_column_family(system_keyspace::size_estimates()).set_virtual_reader(mutation_source(db::size_estimates::virtual_reader(db, sys_ks.local())));
     db.find_column_family(system_keyspace::v3::views_builds_in_progress()).set_virtual_reader(mutation_source(db::view::build_progress_virtual_reader(db)));
@@ -7,6 +7,7 @@
  */
 
 #include "utils/assert.hh"
+#include <map>
 #include <unordered_set>
 
 #include <seastar/core/abort_source.hh>
@@ -629,9 +630,17 @@ future<> endpoint_worker::notify_fiber() noexcept {
             endpoint_liveness.marked_alive = alive;
 
             try {
-                co_await coroutine::parallel_for_each(listeners.begin(), listeners.end(), [this, endpoint = _id, alive] (const listener_info& listener) {
-                    return _fd._parent.container().invoke_on(listener.shard, [listener = listener.id, endpoint, alive] (failure_detector& fd) {
-                        return fd._impl->mark(listener, endpoint, alive);
+                // Send a single message to each shard, which notifies all the listeners of that shard,
+                // rather than one message per listener.
+                std::map<seastar::shard_id, std::vector<listener_id>> listeners_by_shard;
+                for (auto& listener : listeners) {
+                    listeners_by_shard[listener.shard].push_back(listener.id);
+                }
+                co_await coroutine::parallel_for_each(listeners_by_shard, [this, endpoint = _id, alive] (const auto& shard_listeners) {
+                    return _fd._parent.container().invoke_on(shard_listeners.first, [&listeners = shard_listeners.second, endpoint, alive] (failure_detector& fd) {
+                        return coroutine::parallel_for_each(listeners, [&fd, endpoint, alive] (listener_id listener) {
+                            return fd._impl->mark(listener, endpoint, alive);
+                        });
                     });
                 });
             } catch (...) {
@@ -64,12 +64,12 @@ class endpoint_state {
         update_is_normal();
     }
 
-    // Valid only on shard 0
+    // Valid only on shard 0, other shards only see the generation change.
     heart_beat_state& get_heart_beat_state() noexcept {
         return _heart_beat_state;
     }
 
-    // Valid only on shard 0
+    // Valid only on shard 0, other shards only see the generation change.
     const heart_beat_state& get_heart_beat_state() const noexcept {
         return _heart_beat_state;
     }
@@ -144,6 +144,12 @@ class feature_service final : public peering_sharded_service<feature_service> {
     // have it or none, otherwise we can get partial failures on writes.
     gms::feature fragmented_commitlog_entries { *this, "FRAGMENTED_COMMITLOG_ENTRIES"sv };
     gms::feature maintenance_tenant { *this, "MAINTENANCE_TENANT"sv };
+    gms::feature file_stream { *this, "FILE_STREAM"sv };
+    gms::feature repair_range_summary { *this, "REPAIR_RANGE_SUMMARY"sv };
+    gms::feature per_partition_rate_limit_sketch { *this, "PER_PARTITION_RATE_LIMIT_SKETCH"sv };
+    gms::feature mutation_batch_verb { *this, "MUTATION_BATCH_VERB"sv };
+    gms::feature cache_only_reads { *this, "CACHE_ONLY_READS"sv };
+    gms::feature xxh3_digest { *this, "XXH3_DIGEST"sv };
 
     // A feature just for use in tests. It must not be advertised unless
     // the "features_enable_test_feature" injection is enabled.
@@ -165,6 +165,20 @@ void gossiper::do_sort(utils::chunked_vector<gossip_digest>& g_digest_list) cons
     }
 }
 
+static gossip_digest_syn merge_syn_msgs(gossip_digest_syn older, gossip_digest_syn newer) {
+    auto digests = newer.get_gossip_digests();
+    std::unordered_set<inet_address> endpoints;
+    for (auto& d : digests) {
+        endpoints.insert(d.get_endpoint());
+    }
+    for (auto& d : older.get_gossip_digests()) {
+        if (!endpoints.contains(d.get_endpoint())) {
+            digests.push_back(d);
+        }
+    }
+    return gossip_digest_syn(newer.cluster_id(), newer.partioner(), std::move(digests), newer.group0_id());
+}
+
 // Depends on
 // - no external dependency
 future<> gossiper::handle_syn_msg(msg_addr from, gossip_digest_syn syn_msg) {
@@ -193,11 +207,11 @@ future<> gossiper::handle_syn_msg(msg_addr from, gossip_digest_syn syn_msg) {
 
     syn_msg_pending& p = _syn_handlers[from.addr];
     if (p.pending) {
-        // The latest syn message from peer has the latest information, so
-        // it is safe to drop the previous syn message and keep the latest
-        // one only.
+        // The latest syn message from peer has the latest information, but
+        // it may carry only the digests which changed since the previous
+        // one, so keep the digests of the previous one it doesn't have.
         logger.debug("Queue gossip syn msg from node {}, syn_msg={}", from, syn_msg);
-        p.syn_msg = std::move(syn_msg);
+        p.syn_msg = p.syn_msg ? merge_syn_msgs(std::move(*p.syn_msg), std::move(syn_msg)) : std::move(syn_msg);
         co_return;
     }
 
@@ -758,6 +772,7 @@ future<> gossiper::remove_endpoint(inet_address endpoint, permit_id pid) {
     });
     _syn_handlers.erase(endpoint);
     _ack_handlers.erase(endpoint);
+    _sent_digests.erase(endpoint);
     quarantine_endpoint(endpoint);
     logger.info("Removed endpoint {}", endpoint);
 
@@ -1160,9 +1175,12 @@ void gossiper::run() {
                     _endpoints_to_talk_with.pop_front();
                     logger.debug("Talk to live nodes: {}", live_nodes);
                     for (auto& ep: live_nodes) {
-                        (void)with_gate(_background_msg, [this, message, ep] () mutable {
-                            return do_gossip_to_live_member(message, ep).handle_exception([] (auto ep) {
-                                logger.trace("Failed to send gossip to live members: {}", ep);
+                        gossip_digest_syn syn(get_cluster_name(), get_partitioner_name(), make_gossip_digest_for(ep, g_digests), get_group0_id());
+                        (void)with_gate(_background_msg, [this, syn = std::move(syn), ep] () mutable {
+                            return do_gossip_to_live_member(std::move(syn), ep).handle_exception([this, ep] (auto e) {
+                                // The peer may have missed the changes, send it everything next time.
+                                _sent_digests.erase(ep);
+                                logger.trace("Failed to send gossip to live members: {}", e);
                             });
                         });
                     }
@@ -1350,13 +1368,64 @@ void gossiper::make_random_gossip_digest(utils::chunked_vector<gossip_digest>& g
     }
 }
 
+utils::chunked_vector<gossip_digest> gossiper::make_gossip_digest_for(inet_address ep, const utils::chunked_vector<gossip_digest>& g_digests) {
+    auto period = _gcfg.full_digest_period();
+    auto& sent = _sent_digests[ep];
+    if (period > 1 && !sent.digests.empty() && ++sent.syns_since_full < period) {
+        utils::chunked_vector<gossip_digest> delta;
+        for (auto& d : g_digests) {
+            auto v = std::make_pair(d.get_generation(), d.get_max_version());
+            auto [it, inserted] = sent.digests.try_emplace(d.get_endpoint(), v);
+            if (inserted || it->second != v) {
+                it->second = v;
+                delta.push_back(d);
+            }
+        }
+        // An empty syn is a shadow round request, so never send one.
+        if (!delta.empty()) {
+            logger.trace("Sending {} out of {} digests to {}", delta.size(), g_digests.size(), ep);
+            return delta;
+        }
+    }
+    sent.digests.clear();
+    sent.syns_since_full = 0;
+    for (auto& d : g_digests) {
+        sent.digests.emplace(d.get_endpoint(), std::make_pair(d.get_generation(), d.get_max_version()));
+    }
+    return g_digests;
+}
+
+// Whether the states differ at most in their heart beat version and update
+// timestamp, which are only valid on shard 0.
+static bool only_heart_beat_differs(const endpoint_state& a, const endpoint_state& b) noexcept {
+    if (a.get_heart_beat_state().get_generation() != b.get_heart_beat_state().get_generation()) {
+        return false;
+    }
+    const auto& a_states = a.get_application_state_map();
+    const auto& b_states = b.get_application_state_map();
+    if (a_states.size() != b_states.size()) {
+        return false;
+    }
+    // Within a generation, the version of an application state identifies its value.
+    return std::ranges::all_of(a_states, [&] (const auto& x) {
+        auto it = b_states.find(x.first);
+        return it != b_states.end() && it->second.version() == x.second.version();
+    });
+}
+
 future<> gossiper::replicate(inet_address ep, endpoint_state es, permit_id pid) {
     verify_permit(ep, pid);
+    es.update_is_normal();
+    // Most changes are heart beats, which other shards have no use for. Skip
+    // copying the whole state to every one of them.
+    if (auto cur = get_endpoint_state_ptr(ep); cur && only_heart_beat_differs(*cur, es)) {
+        _endpoint_state_map[ep] = make_endpoint_state_ptr(std::move(es));
+        co_return;
+    }
     // First pass: replicate the new endpoint_state on all shards.
     // Use foreign_ptr<std::unique_ptr> to ensure destroy on remote shards on exception
     std::vector<foreign_ptr<endpoint_state_ptr>> ep_states;
     ep_states.resize(smp::count);
-    es.update_is_normal();
     auto p = make_foreign(make_endpoint_state_ptr(std::move(es)));
     const auto *eps = p.get();
     ep_states[this_shard_id()] = std::move(p);
@@ -1816,6 +1885,7 @@ future<> gossiper::mark_dead(inet_address addr, endpoint_state_ptr state, permit
         data.live.erase(addr);
         data.unreachable[addr] = now();
     });
+    _sent_digests.erase(addr);
     logger.info("InetAddress {}/{} is now DOWN, status = {}", state->get_host_id(), addr, get_gossip_status(*state));
     co_await do_on_dead_notifications(addr, std::move(state), pid);
 }
@@ -1824,6 +1894,8 @@ future<> gossiper::handle_major_state_change(inet_address ep, endpoint_state eps
     verify_permit(ep, pid);
 
     endpoint_state_ptr eps_old = get_endpoint_state_ptr(ep);
+    // A restarted node lost what it was sent before.
+    _sent_digests.erase(ep);
 
     if (!is_dead_state(eps) && !is_in_shadow_round()) {
         if (_endpoint_state_map.contains(ep))  {
@@ -72,6 +72,10 @@ struct gossip_config {
     uint32_t skip_wait_for_gossip_to_settle = -1;
     utils::updateable_value<uint32_t> failure_detector_timeout_ms;
     utils::updateable_value<int32_t> force_gossip_generation;
+    // Send the full digest list in every that many syn messages to a live
+    // peer, and only the digests which changed since the last syn in the others.
+    // 0 or 1 sends the full list every time.
+    utils::updateable_value<uint32_t> full_digest_period;
 };
 
 struct loaded_endpoint_state {
@@ -229,6 +233,13 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
 
     std::list<std::vector<inet_address>> _endpoints_to_talk_with;
 
+    // The digests sent to each live peer since the last full digest list.
+    struct sent_digests {
+        std::unordered_map<inet_address, std::pair<generation_type, version_type>> digests;
+        uint32_t syns_since_full = 0;
+    };
+    std::unordered_map<inet_address, sent_digests> _sent_digests;
+
     /* live member set */
     std::unordered_set<inet_address> _live_endpoints;
     uint64_t _live_endpoints_version = 0;
@@ -382,6 +393,16 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
      */
     void make_random_gossip_digest(utils::chunked_vector<gossip_digest>& g_digests) const;
 
+    /**
+     * Returns the digests to send to a live peer: only the ones which changed
+     * since the previous syn to it, or all of them every full_digest_period
+     * syns, so a peer which missed an update eventually catches up.
+     *
+     * @param ep the peer.
+     * @param g_digests the full list of Gossip Digests.
+     */
+    utils::chunked_vector<gossip_digest> make_gossip_digest_for(inet_address ep, const utils::chunked_vector<gossip_digest>& g_digests);
+
 public:
     /**
      * Handles switching the endpoint's state from REMOVING_TOKEN to REMOVED_TOKEN
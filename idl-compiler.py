@@ -308,7 +308,13 @@ class ClassDef(ASTBase):
 template <typename Output>
 void serializer<{full_name}>::write(Output& buf, const {full_name}& obj) {{""")
         if not self.final:
-            fprintln(cout, f"""  {SETSIZE}(buf, obj);""")
+            size = fixed_serialized_size(self)
+            if size is not None:
+                # The size is the same for all objects, no need to serialize
+                # the object twice to measure it.
+                fprintln(cout, f"""  {SERIALIZER}(buf, {SIZETYPE}({size}));""")
+            else:
+                fprintln(cout, f"""  {SETSIZE}(buf, obj);""")
         for member in self.members:
             if isinstance(member, ClassDef) or isinstance(member, EnumDef):
                 continue
@@ -859,6 +865,7 @@ def flat_type(t):
 
 
 local_types = {}
+local_enums = {}
 local_writable_types = {}
 rpc_verbs = {}
 
@@ -894,6 +901,55 @@ def get_template_name(lst):
     return lst["template_name"] if not isinstance(lst, str) and len(lst) > 1 else None
 
 
+# Sizes of the serialized forms of the types with a built-in serializer of a
+# fixed size (see serializer.hh).
+fixed_size_types = {
+    'bool': 1,
+    'int8_t': 1,
+    'uint8_t': 1,
+    'int16_t': 2,
+    'uint16_t': 2,
+    'int': 4,
+    'int32_t': 4,
+    'uint32_t': 4,
+    'int64_t': 8,
+    'uint64_t': 8,
+}
+
+
+def find_local_type(types, name):
+    return types.get(name) or next((t for t in types.values() if t.ns_qualified_name() == name), None)
+
+
+def fixed_serialized_size(t):
+    '''Returns the size of the serialized form of a type if it's the same for
+    all values of the type, None otherwise or if it can't be told.
+
+    Only integers, and enums and classes defined in the current IDL file whose
+    members all have a fixed size, are known to have one.'''
+    if isinstance(t, ClassDef):
+        if t.stub or t.template_params or t.parent_template_params:
+            return None
+        size = 0 if t.final else 4 # size_type
+        for m in get_members(t):
+            member_size = fixed_serialized_size(m.type)
+            if member_size is None:
+                return None
+            size += member_size
+        return size
+    if not isinstance(t, BasicType):
+        return None
+    if t.name in fixed_size_types:
+        return fixed_size_types[t.name]
+    enum = find_local_type(local_enums, t.name)
+    if enum:
+        return fixed_size_types.get(enum.underlying_type)
+    cls = find_local_type(local_types, t.name)
+    if cls:
+        return fixed_serialized_size(cls)
+    return None
+
+
 def is_vector(t):
     return isinstance(t, TemplateType) and (t.name == "std::vector" or t.name == "utils::chunked_vector")
 
@@ -1340,6 +1396,11 @@ def register_local_type(cls):
     local_types[cls.name] = cls
 
 
+def register_local_enum(enum):
+    global local_enums
+    local_enums[enum.name] = enum
+
+
 def register_writable_local_type(cls):
     global local_writable_types
     global stubs
@@ -1662,7 +1723,7 @@ def handle_types(tree):
         elif isinstance(obj, RpcVerb):
             register_rpc_verb(obj)
         elif isinstance(obj, EnumDef):
-            pass
+            register_local_enum(obj)
         elif isinstance(obj, NamespaceDef):
             handle_types(obj.members)
         elif isinstance(obj, Include):
@@ -9,3 +9,7 @@
 class cache_temperature final {
     uint8_t get_serialized_temperature();
 };
+
+class replica_load final {
+    uint32_t queued_reads();
+};
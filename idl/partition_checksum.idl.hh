@@ -149,3 +149,4 @@ struct repair_flush_hints_batchlog_response {
 
 verb [[with_client_info]] repair_update_system_table (repair_update_system_table_request req [[ref]]) -> repair_update_system_table_response;
 verb [[with_client_info]] repair_flush_hints_batchlog (repair_flush_hints_batchlog_request req [[ref]]) -> repair_flush_hints_batchlog_response;
+verb [[with_client_info]] repair_get_range_summary (uint32_t repair_meta_id, uint32_t leaves_count, unsigned dst_cpu_id) -> std::vector<repair_hash>;
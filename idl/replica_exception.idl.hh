@@ -23,12 +23,16 @@ class stale_topology_exception {
 class abort_requested_exception {
 };
 
+class not_cached_exception {
+};
+
 struct exception_variant {
     std::variant<replica::unknown_exception,
             replica::no_exception,
             replica::rate_limit_exception,
             replica::stale_topology_exception,
-            replica::abort_requested_exception
+            replica::abort_requested_exception,
+            replica::not_cached_exception
     > reason;
 };
 
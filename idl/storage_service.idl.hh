@@ -20,6 +20,7 @@ struct global_tablet_id final {
 struct table_load_stats final {
     uint64_t size_in_bytes;
     int64_t split_ready_seq_number;
+    double ops_per_second [[version 6.3.0]];
 };
 
 struct load_stats final {
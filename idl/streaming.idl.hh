@@ -11,6 +11,7 @@
 #include "idl/uuid.idl.hh"
 
 #include "streaming/stream_fwd.hh"
+#include "streaming/stream_blob.hh"
 
 namespace streaming {
 
@@ -55,4 +56,32 @@ enum class stream_mutation_fragments_cmd : uint8_t {
     end_of_stream,
 };
 
+enum class stream_blob_cmd : uint8_t {
+    error,
+    data,
+    end_of_stream,
+};
+
+struct stream_blob_meta {
+    streaming::plan_id ops_id;
+    ::table_id table;
+    sstring filename;
+    uint32_t dst_shard_id;
+};
+
+struct stream_files_request {
+    streaming::plan_id ops_id;
+    ::table_id table;
+    dht::token_range range;
+    uint32_t src_shard_id;
+    uint32_t dst_shard_id;
+};
+
+struct stream_files_response {
+    bool streamed;
+    uint64_t stream_bytes;
+};
+
+verb [[with_client_info, cancellable]] tablet_stream_files (streaming::stream_files_request req) -> streaming::stream_files_response;
+
 }
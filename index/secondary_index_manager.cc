@@ -23,19 +23,44 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
 
 namespace secondary_index {
 
+std::vector<sstring> included_columns(const index_options_map& options) {
+    std::vector<sstring> columns;
+    auto it = options.find(cql3::statements::index_target::include_option_name);
+    if (it == options.end()) {
+        return columns;
+    }
+    std::vector<std::string> names;
+    boost::split(names, it->second, boost::is_any_of(","));
+    for (auto& name : names) {
+        boost::trim(name);
+        if (!name.empty()) {
+            columns.emplace_back(std::move(name));
+        }
+    }
+    return columns;
+}
+
 index::index(const sstring& target_column, const index_metadata& im)
     : _im{im}
     , _target_type{cql3::statements::index_target::from_target_string(target_column)}
     , _target_column{cql3::statements::index_target::column_name_from_target_string(target_column)}
+    , _included_columns{secondary_index::included_columns(im.options())}
 {}
 
 bool index::depends_on(const column_definition& cdef) const {
     return cdef.name_as_text() == _target_column;
 }
 
+bool index::includes(const column_definition& cdef) const {
+    return std::ranges::find(_included_columns, cdef.name_as_text()) != _included_columns.end();
+}
+
 index::supports_expression_v index::supports_expression(const column_definition& cdef, const cql3::expr::oper_t op) const {
     using target_type = cql3::statements::index_target::target_type;
     auto collection_yes = supports_expression_v::from_bool_collection(true);
@@ -295,8 +320,26 @@ view_ptr secondary_index_manager::create_view_for_index(const index_metadata& im
         }
     }
 
+    // Included columns are stored in the index view, so that queries which
+    // select only them, and the keys, can be answered from the view alone.
+    auto included = included_columns(im.options());
+    auto is_included = [&] (const column_definition& def) {
+        return std::ranges::find(included, def.name_as_text()) != included.end();
+    };
+    for (auto& name : included) {
+        const auto* def = schema->get_column_definition(to_bytes(name));
+        if (!def || !def->is_regular()) {
+            throw exceptions::invalid_request_exception(format("Cannot include column {} in index {}: not a regular column of {}",
+                    name, im.name(), schema->cf_name()));
+        }
+        builder.with_column(def->name(), def->type, column_kind::regular_column);
+    }
+
     if (index_target->is_primary_key()) {
         for (auto& def : schema->regular_columns()) {
+            if (is_included(def)) {
+                continue;
+            }
             db::view::create_virtual_column(builder, def.name(), def.type);
         }
     }
@@ -320,7 +363,7 @@ view_ptr secondary_index_manager::create_view_for_index(const index_metadata& im
 std::vector<index_metadata> secondary_index_manager::get_dependent_indices(const column_definition& cdef) const {
     return boost::copy_range<std::vector<index_metadata>>(_indices
            | boost::adaptors::map_values
-           | boost::adaptors::filtered([&] (auto& index) { return index.depends_on(cdef); })
+           | boost::adaptors::filtered([&] (auto& index) { return index.depends_on(cdef) || index.includes(cdef); })
            | boost::adaptors::transformed([&] (auto& index) { return index.metadata(); }));
 }
 
@@ -49,10 +49,15 @@ sstring get_available_index_name(
         const std::set<sstring>& existing_names,
         std::function<bool(std::string_view, std::string_view)> has_schema);
 
+/// Returns the regular columns which the index stores in its view besides the
+/// keys (the include option of the index), in the order they were listed.
+std::vector<sstring> included_columns(const index_options_map& options);
+
 class index {
     index_metadata _im;
     cql3::statements::index_target::target_type _target_type;
     sstring _target_column;
+    std::vector<sstring> _included_columns;
 public:
     index(const sstring& target_column, const index_metadata& im);
     bool depends_on(const column_definition& cdef) const;
@@ -84,6 +89,10 @@ class index {
     cql3::statements::index_target::target_type target_type() const {
         return _target_type;
     }
+    const std::vector<sstring>& included_columns() const {
+        return _included_columns;
+    }
+    bool includes(const column_definition& cdef) const;
 };
 
 class secondary_index_manager {
@@ -24,6 +24,9 @@ manager::manager(config cfg)
             // Other shards will get this pointer in .start()
             _engine = std::make_shared<rust::Box<wasmtime::Engine>>(wasmtime::create_engine(cfg.wasm->udf_memory_limit));
             _alien_runner = std::make_shared<wasm::alien_thread_runner>();
+            if (cfg.wasm->module_cache_directory) {
+                _module_cache = std::make_shared<wasm::module_cache>(*cfg.wasm->module_cache_directory);
+            }
         }
         _instance_cache.emplace(cfg.wasm->cache_size, cfg.wasm->cache_instance_size, cfg.wasm->cache_timer_period);
     }
@@ -31,9 +34,14 @@ manager::manager(config cfg)
 
 future<> manager::start() {
     if (this_shard_id() == 0) {
+        // Read the precompiled modules before the schema is loaded, so that no shard needs to compile them.
+        if (_module_cache) {
+            co_await _module_cache->load();
+        }
         co_await container().invoke_on_others([this] (auto& m) {
             m._engine = this->_engine;
             m._alien_runner = this->_alien_runner;
+            m._module_cache = this->_module_cache;
         });
     }
 }
@@ -61,7 +69,7 @@ future<manager::context> manager::create(sstring language, sstring name, const s
        // FIXME: need better way to test wasm compilation without real_database()
        auto wasm_ctx = wasm::context(**_engine, std::move(name), *_instance_cache, wasm_yield_fuel, wasm_total_fuel);
        try {
-            co_await ::wasm::precompile(*_alien_runner, wasm_ctx, arg_names, std::move(script));
+            co_await ::wasm::precompile(*_alien_runner, wasm_ctx, arg_names, std::move(script), _module_cache.get());
        } catch (const wasm::exception& we) {
            throw exceptions::invalid_request_exception(we.what());
        }
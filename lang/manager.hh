@@ -12,6 +12,7 @@
 #include "rust/wasmtime_bindings.hh"
 #include "lang/wasm_instance_cache.hh"
 #include "lang/wasm_alien_thread_runner.hh"
+#include "lang/wasm_module_cache.hh"
 #include "cql3/functions/user_function.hh"
 
 namespace wasm {
@@ -24,6 +25,8 @@ class manager : public seastar::peering_sharded_service<manager> {
     std::shared_ptr<rust::Box<wasmtime::Engine>> _engine;
     std::optional<wasm::instance_cache> _instance_cache;
     std::shared_ptr<wasm::alien_thread_runner> _alien_runner;
+    // Shared by all shards, read-only after start().
+    std::shared_ptr<wasm::module_cache> _module_cache;
 
 public:
     const uint64_t wasm_yield_fuel;
@@ -41,6 +44,8 @@ class manager : public seastar::peering_sharded_service<manager> {
         std::chrono::milliseconds cache_timer_period;
         uint64_t yield_fuel;
         uint64_t total_fuel;
+        // Where precompiled modules are stored across restarts, if set.
+        std::optional<std::filesystem::path> module_cache_directory;
     };
     struct lua_config {
         unsigned max_bytes;
@@ -216,28 +216,50 @@ struct from_val_visitor {
     }
 };
 
-seastar::future<> precompile(alien_thread_runner& alien_runner, context& ctx, const std::vector<sstring>& arg_names, std::string script) {
-    seastar::promise<rust::Box<wasmtime::Module>> done;
-    alien_runner.submit(done, [&engine_ptr = ctx.engine_ptr, script = std::move(script)] {
-        return wasmtime::create_module(engine_ptr, rust::Str(script.data(), script.size()));
-    });
-
-    ctx.module = co_await done.get_future();
-    std::exception_ptr ex;
+// After precompiling the module, we try creating a store, an instance and a function with it to make sure it's valid.
+// If we succeed, we drop them and keep the module, knowing that we will be able to create them again for UDF execution.
+static std::exception_ptr validate_module(context& ctx) {
     try {
-        // After precompiling the module, we try creating a store, an instance and a function with it to make sure it's valid.
-        // If we succeed, we drop them and keep the module, knowing that we will be able to create them again for UDF execution.
         ctx.module.value()->compile(ctx.engine_ptr);
         auto store = wasmtime::create_store(ctx.engine_ptr, ctx.total_fuel, ctx.yield_fuel);
         auto inst = create_instance(ctx.engine_ptr, **ctx.module, *store);
         create_func(*inst, *store, ctx.function_name);
         ctx.module.value()->release();
     } catch (const rust::Error& e) {
-        ex = std::make_exception_ptr(wasm::exception(format("Compilation failed: {}", e.what())));
+        ctx.module.value()->release();
+        return std::make_exception_ptr(wasm::exception(format("Compilation failed: {}", e.what())));
     }
-    if (ex) {
+    return nullptr;
+}
+
+seastar::future<> precompile(alien_thread_runner& alien_runner, context& ctx, const std::vector<sstring>& arg_names, std::string script, const module_cache* modules) {
+    sstring key;
+    if (modules) {
+        key = module_cache::make_key(script);
+        if (auto precompiled = modules->find(key)) {
+            ctx.module = wasmtime::create_module_from_precompiled(rust::Slice<const uint8_t>(reinterpret_cast<const uint8_t*>(precompiled->get()), precompiled->size()));
+            if (auto ex = validate_module(ctx)) {
+                wasm_logger.info("Precompiled module of {} is not usable, compiling it again: {}", ctx.function_name, ex);
+            } else {
+                co_return;
+            }
+        }
+    }
+
+    seastar::promise<rust::Box<wasmtime::Module>> done;
+    alien_runner.submit(done, [&engine_ptr = ctx.engine_ptr, script = std::move(script)] {
+        return wasmtime::create_module(engine_ptr, rust::Str(script.data(), script.size()));
+    });
+
+    ctx.module = co_await done.get_future();
+    if (auto ex = validate_module(ctx)) {
         co_await coroutine::return_exception_ptr(std::move(ex));
     }
+    // Only one shard stores the module, all of them compile it.
+    if (modules && this_shard_id() == 0) {
+        auto precompiled = ctx.module.value()->precompiled();
+        co_await modules->store(std::move(key), temporary_buffer<char>(reinterpret_cast<const char*>(precompiled.data()), precompiled.size()));
+    }
 }
 seastar::future<bytes_opt> run_script(context& ctx, wasmtime::Store& store, wasmtime::Instance& instance, wasmtime::Func& func, const std::vector<data_type>& arg_types, std::span<const bytes_opt> params, data_type return_type, bool allow_null_input) {
     wasm_logger.debug("Running function {}", ctx.function_name);
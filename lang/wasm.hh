@@ -15,6 +15,7 @@
 #include "rust/wasmtime_bindings.hh"
 #include "lang/wasm_instance_cache.hh"
 #include "lang/wasm_alien_thread_runner.hh"
+#include "lang/wasm_module_cache.hh"
 #include "db/config.hh"
 
 namespace wasm {
@@ -45,7 +46,9 @@ struct context {
     context(wasmtime::Engine& engine_ptr, std::string name, instance_cache& cache, uint64_t yield_fuel, uint64_t total_fuel);
 };
 
-seastar::future<> precompile(alien_thread_runner& alien_runner, context& ctx, const std::vector<sstring>& arg_names, std::string script);
+// Compiles the script into ctx.module. If modules is set, the module is taken from there
+// if it was stored before, and stored there otherwise.
+seastar::future<> precompile(alien_thread_runner& alien_runner, context& ctx, const std::vector<sstring>& arg_names, std::string script, const module_cache* modules = nullptr);
 
 seastar::future<bytes_opt> run_script(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, std::span<const bytes_opt> params, data_type return_type, bool allow_null_input);
 
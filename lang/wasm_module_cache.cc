@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "lang/wasm_module_cache.hh"
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/coroutine/exception.hh>
+#include <seastar/util/file.hh>
+#include <xxhash.h>
+#include <fmt/std.h>
+#include "utils/lister.hh"
+#include "utils/log.hh"
+
+extern logging::logger wasm_logger;
+
+namespace wasm {
+
+static constexpr std::string_view module_file_extension = ".cwasm";
+
+module_cache::module_cache(std::filesystem::path dir)
+    : _dir(std::move(dir))
+{}
+
+std::filesystem::path module_cache::path_of(const sstring& key) const {
+    return _dir / (key + sstring(module_file_extension));
+}
+
+sstring module_cache::make_key(std::string_view script) {
+    auto hash = XXH3_128bits(script.data(), script.size());
+    return format("{:016x}{:016x}", hash.high64, hash.low64);
+}
+
+future<> module_cache::load() {
+    co_await recursive_touch_directory(_dir.native());
+    co_await lister::scan_dir(_dir, lister::dir_entry_types::of<directory_entry_type::regular>(), [this] (std::filesystem::path dir, directory_entry de) -> future<> {
+        auto name = std::filesystem::path(de.name);
+        if (name.extension() != module_file_extension) {
+            co_return;
+        }
+        try {
+            auto contents = co_await util::read_entire_file_contiguous(dir / name);
+            _modules.emplace(sstring(name.stem().native()), temporary_buffer<char>(contents.data(), contents.size()));
+        } catch (...) {
+            wasm_logger.warn("Failed to read precompiled module {}: {}", dir / name, std::current_exception());
+        }
+    });
+    wasm_logger.info("Read {} precompiled modules from {}", _modules.size(), _dir.native());
+}
+
+const temporary_buffer<char>* module_cache::find(const sstring& key) const {
+    auto it = _modules.find(key);
+    return it == _modules.end() ? nullptr : &it->second;
+}
+
+future<> module_cache::store(sstring key, temporary_buffer<char> precompiled) const {
+    // Written under a temporary name and renamed, so that a partially written module is never read.
+    auto path = path_of(key);
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    std::exception_ptr ex;
+    try {
+        auto f = co_await open_file_dma(tmp_path.native(), open_flags::wo | open_flags::create | open_flags::truncate);
+        auto out = co_await make_file_output_stream(std::move(f));
+        try {
+            co_await out.write(precompiled.get(), precompiled.size());
+            co_await out.flush();
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await out.close();
+        if (!ex) {
+            co_await rename_file(tmp_path.native(), path.native());
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        wasm_logger.warn("Failed to store precompiled module {}: {}", path, ex);
+    }
+}
+
+}
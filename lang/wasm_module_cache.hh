@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+#include <seastar/core/future.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include "seastarx.hh"
+
+namespace wasm {
+
+// On-disk cache of precompiled WASM modules.
+//
+// Compiling a module may take seconds, and every WASM UDF is compiled again
+// on each shard whenever the schema is loaded, e.g. after a restart. The cache
+// stores the precompiled modules in a directory, keyed by a hash of the source
+// of the module. The precompiled code also records the version and configuration
+// of the wasmtime engine which produced it, and the engine refuses to load code
+// produced by an incompatible one, in which case the module is compiled and
+// stored again.
+//
+// All the modules in the directory are read into memory by load(), on startup,
+// so that shards don't read the directory when loading the schema.
+class module_cache {
+    std::filesystem::path _dir;
+    std::unordered_map<sstring, temporary_buffer<char>> _modules;
+
+    std::filesystem::path path_of(const sstring& key) const;
+public:
+    explicit module_cache(std::filesystem::path dir);
+
+    static sstring make_key(std::string_view script);
+
+    // Reads the modules stored in the directory, creating it if needed.
+    future<> load();
+
+    // Returns the precompiled module read by load(), or nullptr.
+    // Safe to call from any shard, since the contents don't change after load().
+    const temporary_buffer<char>* find(const sstring& key) const;
+
+    // Writes the precompiled module to the directory, to be read on the next load().
+    // Failures are logged and ignored.
+    future<> store(sstring key, temporary_buffer<char> precompiled) const;
+};
+
+}
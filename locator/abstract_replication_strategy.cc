@@ -498,6 +498,44 @@ auto vnode_effective_replication_map::clone_data_gently() const -> future<std::u
     co_return std::move(result);
 }
 
+future<> vnode_effective_replication_map::build_natural_endpoints() {
+    std::vector<inet_address_vector_replica_set> natural_endpoints;
+    auto resolve = [&] (const token& key_token) {
+        const auto it = _replication_map.find(key_token);
+        if (it == _replication_map.end()) {
+            return false;
+        }
+        inet_address_vector_replica_set endpoints;
+        endpoints.reserve(it->second.size());
+        for (const auto& host_id : it->second) {
+            // See resolve_endpoints() for the empty host_id.
+            auto endpoint = host_id ? _tmptr->get_endpoint_for_host_id_if_known(host_id) : std::make_optional(_tmptr->get_topology().my_address());
+            if (!endpoint) {
+                return false;
+            }
+            endpoints.push_back(*endpoint);
+        }
+        natural_endpoints.push_back(std::move(endpoints));
+        return true;
+    };
+
+    if (!_rs->natural_endpoints_depend_on_token()) {
+        if (resolve(default_replication_map_key)) {
+            _natural_endpoints = std::move(natural_endpoints);
+        }
+        co_return;
+    }
+    const auto& sorted_tokens = _tmptr->sorted_tokens();
+    natural_endpoints.reserve(sorted_tokens.size());
+    for (const auto& t : sorted_tokens) {
+        if (!resolve(t)) {
+            co_return;
+        }
+        co_await coroutine::maybe_yield();
+    }
+    _natural_endpoints = std::move(natural_endpoints);
+}
+
 host_id_vector_replica_set vnode_effective_replication_map::do_get_replicas(const token& tok,
     bool is_vnode) const
 {
@@ -511,6 +549,10 @@ host_id_vector_replica_set vnode_effective_replication_map::do_get_replicas(cons
 inet_address_vector_replica_set vnode_effective_replication_map::do_get_natural_endpoints(const token& tok,
     bool is_vnode) const
 {
+    if (!_natural_endpoints.empty()) {
+        // The index of a vnode token is found the same way as the index of the vnode owning a token.
+        return _rs->natural_endpoints_depend_on_token() ? _natural_endpoints[_tmptr->first_token_index(tok)] : _natural_endpoints.front();
+    }
     return resolve_endpoints<inet_address_vector_replica_set>(do_get_replicas(tok, is_vnode), *_tmptr);
 }
 
@@ -538,6 +580,7 @@ vnode_effective_replication_map::~vnode_effective_replication_map() {
             _factory->submit_background_work(clear_gently(std::move(_replication_map),
                 std::move(_pending_endpoints),
                 std::move(_read_endpoints),
+                std::move(_natural_endpoints),
                 std::move(_tmptr)));
         } catch (...) {
             // ignore
@@ -584,6 +627,7 @@ future<vnode_effective_replication_map_ptr> effective_replication_map_factory::c
     } else {
         new_erm = co_await calculate_effective_replication_map(std::move(rs), std::move(tmptr));
     }
+    co_await new_erm->build_natural_endpoints();
     co_return insert_effective_replication_map(std::move(new_erm), std::move(key));
 }
 
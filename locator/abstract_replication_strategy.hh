@@ -323,6 +323,11 @@ class vnode_effective_replication_map : public enable_shared_from_this<vnode_eff
     ring_mapping _pending_endpoints;
     ring_mapping _read_endpoints;
     std::unordered_set<locator::host_id> _dirty_endpoints;
+    // The natural endpoints of each vnode, indexed like the sorted tokens of _tmptr
+    // (a single entry if they don't depend on the token), so that get_natural_endpoints()
+    // doesn't have to look up the replicas in _replication_map and resolve each of them.
+    // Empty until built by build_natural_endpoints().
+    std::vector<inet_address_vector_replica_set> _natural_endpoints;
     std::optional<factory_key> _factory_key = std::nullopt;
     effective_replication_map_factory* _factory = nullptr;
 
@@ -362,6 +367,10 @@ class vnode_effective_replication_map : public enable_shared_from_this<vnode_eff
     // since future_state requires T to be no_throw_move_constructible.
     future<std::unique_ptr<cloned_data>> clone_data_gently() const;
 
+    // Resolves the replicas of all vnodes to their endpoints up front, for get_natural_endpoints().
+    // Leaves them to be resolved on each lookup if some replica isn't known to the token metadata.
+    future<> build_natural_endpoints();
+
     // get_primary_ranges() returns the list of "primary ranges" for the given
     // endpoint. "Primary ranges" are the ranges that the node is responsible
     // for storing replica primarily, which means this is the first node
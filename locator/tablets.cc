@@ -502,6 +502,7 @@ resize_decision::seq_number_t resize_decision::next_sequence_number() const {
 table_load_stats& table_load_stats::operator+=(const table_load_stats& s) noexcept {
     size_in_bytes = size_in_bytes + s.size_in_bytes;
     split_ready_seq_number = std::min(split_ready_seq_number, s.split_ready_seq_number);
+    ops_per_second += s.ops_per_second;
     return *this;
 }
 
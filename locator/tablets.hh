@@ -282,6 +282,9 @@ struct table_load_stats {
     // all replicas have completed splitting, which happens when they all store the
     // seq number of the current split decision.
     resize_decision::seq_number_t split_ready_seq_number = std::numeric_limits<resize_decision::seq_number_t>::max();
+    // Reads and writes per second served by the replicas of the table, as a
+    // 5-minute moving average, summed over all replicas.
+    double ops_per_second = 0;
 
     table_load_stats& operator+=(const table_load_stats& s) noexcept;
     friend table_load_stats operator+(table_load_stats a, const table_load_stats& b) {
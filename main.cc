@@ -62,10 +62,16 @@
 #include "repair/row_level.hh"
 #include <cstdio>
 #include <seastar/core/file.hh>
+#include <seastar/util/file.hh>
 #include <unistd.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <charconv>
+#include <filesystem>
 #include "tracing/tracing.hh"
 #include <seastar/core/prometheus.hh>
 #include "message/messaging_service.hh"
@@ -79,6 +85,7 @@
 
 #include "db/view/view_update_generator.hh"
 #include "service/cache_hitrate_calculator.hh"
+#include "db/cache_warmup.hh"
 #include "compaction/compaction_manager.hh"
 #include "sstables/sstables.hh"
 #include "gms/feature_service.hh"
@@ -105,6 +112,7 @@
 #include "tools/entry_point.hh"
 #include "test/perf/entry_point.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/bloom_filter_layout_extension.hh"
 #include "lang/manager.hh"
 #include "sstables/sstables_manager.hh"
 #include "db/virtual_tables.hh"
@@ -174,6 +182,10 @@ struct convert<::object_storage_endpoint_param> {
         ep.endpoint = node["name"].as<std::string>();
         ep.config.port = node["port"].as<unsigned>();
         ep.config.use_https = node["https"].as<bool>(false);
+        ep.config.download_part_size = node["download_part_size"].as<size_t>(ep.config.download_part_size);
+        ep.config.download_concurrency = node["download_concurrency"].as<unsigned>(ep.config.download_concurrency);
+        ep.config.upload_max_part_size = node["upload_max_part_size"].as<size_t>(ep.config.upload_max_part_size);
+        ep.config.upload_concurrency = node["upload_concurrency"].as<unsigned>(ep.config.upload_concurrency);
         if (node["aws_region"] || std::getenv("AWS_DEFAULT_REGION")) {
             ep.config.aws.emplace();
 
@@ -421,6 +433,73 @@ static void tcp_timestamps_sanity() {
     }
 }
 
+// The NUMA node of a CPU, or -1 if it isn't known (e.g. without NUMA support).
+static int numa_node_of_cpu(unsigned cpu) {
+    std::error_code ec;
+    for (auto& entry : std::filesystem::directory_iterator(fmt::format("/sys/devices/system/cpu/cpu{}", cpu), ec)) {
+        auto name = entry.path().filename().string();
+        int node;
+        if (name.starts_with("node") && std::from_chars(name.data() + 4, name.data() + name.size(), node).ec == std::errc()) {
+            return node;
+        }
+    }
+    return -1;
+}
+
+// The NUMA node holding the page of addr, or -1 if it isn't known.
+static int numa_node_of_address(void* addr) {
+    int node = -1;
+    if (::syscall(SYS_get_mempolicy, &node, nullptr, 0, addr, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+struct numa_placement {
+    int cpu = -1;
+    int cpu_node = -1;
+    int memory_node = -1;
+};
+
+static numa_placement local_numa_placement() {
+    numa_placement p;
+    p.cpu = ::sched_getcpu();
+    if (p.cpu >= 0) {
+        p.cpu_node = numa_node_of_cpu(p.cpu);
+    }
+    // Seastar binds the memory of a shard to the node of its CPU (see
+    // --mbind), so a fresh allocation tells where the shard's memory is.
+    auto page = std::make_unique<char[]>(4096);
+    page[0] = 0;
+    p.memory_node = numa_node_of_address(page.get());
+    return p;
+}
+
+static thread_local seastar::metrics::metric_groups numa_metrics;
+
+// Exposes where each shard runs and where its memory is, and warns when
+// they aren't on the same node: accesses to remote memory, and the
+// traffic between the sockets they bring, make multi-socket machines
+// slower and less predictable.
+static void numa_placement_sanity() {
+    smp::invoke_on_all([] {
+        auto p = local_numa_placement();
+        startlog.debug("Shard {} runs on CPU {} of NUMA node {}, its memory is on NUMA node {}", this_shard_id(), p.cpu, p.cpu_node, p.memory_node);
+        if (p.cpu_node >= 0 && p.memory_node >= 0 && p.cpu_node != p.memory_node) {
+            startlog.warn("Shard {} runs on NUMA node {} but its memory is on NUMA node {}. "
+                          "For better performance, run with --mbind and with thread affinity enabled.",
+                          this_shard_id(), p.cpu_node, p.memory_node);
+        }
+        namespace sm = seastar::metrics;
+        numa_metrics.add_group("numa", {
+            sm::make_gauge("cpu_node", [node = p.cpu_node] { return node; },
+                    sm::description("The NUMA node of the CPU the shard runs on, -1 if unknown.")),
+            sm::make_gauge("memory_node", [node = p.memory_node] { return node; },
+                    sm::description("The NUMA node of the memory of the shard, -1 if unknown.")),
+        });
+    }).get();
+}
+
 static void
 verify_seastar_io_scheduler(const boost::program_options::variables_map& opts, bool developer_mode) {
     auto note_bad_conf = [developer_mode] (sstring cause) {
@@ -642,6 +721,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
     ext->add_schema_extension<db::paxos_grace_seconds_extension>(db::paxos_grace_seconds_extension::NAME);
     ext->add_schema_extension<tombstone_gc_extension>(tombstone_gc_extension::NAME);
     ext->add_schema_extension<db::per_partition_rate_limit_extension>(db::per_partition_rate_limit_extension::NAME);
+    ext->add_schema_extension<db::bloom_filter_layout_extension>(db::bloom_filter_layout_extension::NAME);
 
     auto cfg = make_lw_shared<db::config>(ext);
     auto init = app.get_options_description().add_options();
@@ -792,6 +872,10 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             adjust_and_verify_rlimit(cfg->developer_mode());
             verify_adequate_memory_per_shard(cfg->developer_mode());
             verify_seastar_io_scheduler(opts, cfg->developer_mode());
+            numa_placement_sanity();
+            auto stop_numa_metrics = defer_verbose_shutdown("NUMA metrics", [] {
+                smp::invoke_on_all([] { numa_metrics.clear(); }).get();
+            });
             if (cfg->partitioner() != "org.apache.cassandra.dht.Murmur3Partitioner") {
                 if (cfg->enable_deprecated_partitioners()) {
                     startlog.warn("The partitioner {} is deprecated and will be removed in a future version."
@@ -833,6 +917,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             };
             auto background_reclaim_scheduling_group = make_sched_group("background_reclaim", "bgre", 50);
             auto maintenance_scheduling_group = make_sched_group("streaming", "strm", 200);
+            auto cache_warmup_scheduling_group = make_sched_group("cache_warmup", "cwrm", 50);
 
             smp::invoke_on_all([&cfg, background_reclaim_scheduling_group] {
                 logalloc::tracker::config st_cfg;
@@ -841,6 +926,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 st_cfg.lsa_reclamation_step = cfg->lsa_reclamation_step();
                 st_cfg.background_reclaim_sched_group = background_reclaim_scheduling_group;
                 st_cfg.sanitizer_report_backtrace = cfg->sanitizer_report_backtrace();
+                st_cfg.use_huge_pages = cfg->lsa_huge_pages();
                 logalloc::shard_tracker().configure(st_cfg);
             }).get();
 
@@ -1030,6 +1116,9 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             utils::directories::set dir_set;
             dir_set.add(cfg->commitlog_directory());
             dir_set.add(cfg->schema_commitlog_directory());
+            if (cfg->tracing_backend() == "log") {
+                dir_set.add(cfg->tracing_log_directory());
+            }
             dirs.emplace(cfg->developer_mode());
             dirs->create_and_verify(std::move(dir_set)).get();
 
@@ -1079,6 +1168,16 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             dbcfg.memory_compaction_scheduling_group = make_sched_group("mem_compaction", "mcmp", 1000);
             dbcfg.streaming_scheduling_group = maintenance_scheduling_group;
             dbcfg.statement_scheduling_group = make_sched_group("statement", "stmt", 1000);
+            if (cfg->cpu_scheduler() && cfg->batch_workload_shares()) {
+                dbcfg.batch_statement_scheduling_group = make_sched_group("batch_statement", "bstm", cfg->batch_workload_shares());
+            }
+            auto batch_workload_shares_observer = cfg->batch_workload_shares.observe([sg = dbcfg.batch_statement_scheduling_group] (uint32_t shares) {
+                if (sg && shares) {
+                    (void)smp::invoke_on_all([sg = *sg, shares] () mutable {
+                        sg.set_shares(shares);
+                    });
+                }
+            });
             dbcfg.memtable_scheduling_group = make_sched_group("memtable", "mt", 1000);
             dbcfg.memtable_to_cache_scheduling_group = make_sched_group("memtable_to_cache", "mt2c", 200);
             dbcfg.gossip_scheduling_group = make_sched_group("gossip", "gms", 1000);
@@ -1133,6 +1232,9 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     .cache_timer_period = std::chrono::milliseconds(cfg->wasm_cache_timeout_in_ms()),
                     .yield_fuel = cfg->wasm_udf_yield_fuel(),
                     .total_fuel = cfg->wasm_udf_total_fuel(),
+                    .module_cache_directory = cfg->wasm_module_cache_enabled()
+                            ? std::make_optional(std::filesystem::path(cfg->saved_caches_directory()) / "wasm")
+                            : std::nullopt,
                 };
             }
 
@@ -1212,7 +1314,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             cql_config.start(std::ref(*cfg)).get();
 
             supervisor::notify("starting query processor");
-            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560};
+            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560, memory::stats().total_memory() / 2560};
             debug::the_query_processor = &qp;
             auto local_data_dict = seastar::sharded_parameter([] (const replica::database& db) { return db.as_data_dictionary(); }, std::ref(db));
 
@@ -1232,7 +1334,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
 
             supervisor::notify("creating tracing");
             sharded<tracing::tracing>& tracing = tracing::tracing::tracing_instance();
-            tracing.start(sstring("trace_keyspace_helper")).get();
+            tracing.start(sstring(cfg->tracing_backend() == "log" ? "trace_log_helper" : "trace_keyspace_helper")).get();
             auto destroy_tracing = defer_verbose_shutdown("tracing instance", [&tracing] {
                 tracing.stop().get();
             });
@@ -1374,6 +1476,12 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             } else if (compress_what == "dc") {
                 mscfg.compress = netw::messaging_service::compress_what::dc;
             }
+            mscfg.zstd_compressed_connections = utils::split_comma_separated_list(cfg->internode_compression_zstd_connections());
+            mscfg.zstd_compression_level = cfg->internode_compression_zstd_level();
+            mscfg.streaming_connections = cfg->internode_streaming_connections();
+            if (!cfg->internode_compression_zstd_dictionary().empty()) {
+                mscfg.zstd_compression_dictionary = util::read_entire_file_contiguous(std::filesystem::path(cfg->internode_compression_zstd_dictionary())).get();
+            }
 
             if (encrypt == "all") {
                 mscfg.encrypt = netw::messaging_service::encrypt_what::all;
@@ -1395,6 +1503,10 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     {default_scheduling_group(), "$system"},
                     {dbcfg.streaming_scheduling_group, "$maintenance", false}
             };
+            if (dbcfg.batch_statement_scheduling_group) {
+                // Nodes which don't know this tenant serve it as $user.
+                scfg.statement_tenants.push_back({*dbcfg.batch_statement_scheduling_group, "$batch"});
+            }
             scfg.streaming = dbcfg.streaming_scheduling_group;
             scfg.gossip = dbcfg.gossip_scheduling_group;
 
@@ -1462,6 +1574,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 gcfg.group0_id = group0_id;
                 gcfg.failure_detector_timeout_ms = cfg->failure_detector_timeout_in_ms;
                 gcfg.force_gossip_generation = cfg->force_gossip_generation;
+                gcfg.full_digest_period = cfg->gossip_full_digest_period;
                 return gcfg;
             });
 
@@ -2073,6 +2186,18 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             );
             cf_cache_hitrate_calculator.local().run_on(this_shard_id());
 
+            supervisor::notify("starting cache warmup");
+            static sharded<db::cache_warmup> cache_warmup;
+            cache_warmup.start(std::ref(db), db::cache_warmup::config{
+                .directory = std::filesystem::path(cfg->saved_caches_directory()) / "row_cache",
+                .save_period = std::chrono::seconds(cfg->cache_warmup_save_period_in_s()),
+                .scheduling_group = cache_warmup_scheduling_group,
+            }).get();
+            cache_warmup.invoke_on_all(&db::cache_warmup::start).get();
+            auto stop_cache_warmup = defer_verbose_shutdown("cache warmup", [] {
+                cache_warmup.stop().get();
+            });
+
             supervisor::notify("starting view update backlog broker");
             static sharded<service::view_update_backlog_broker> view_backlog_broker;
             view_backlog_broker.start(std::ref(proxy), std::ref(gossiper)).get();
@@ -37,6 +37,7 @@
 #include "repair/repair.hh"
 #include "streaming/stream_reason.hh"
 #include "streaming/stream_mutation_fragments_cmd.hh"
+#include "streaming/stream_blob.hh"
 #include "cache_temperature.hh"
 #include "raft/raft.hh"
 #include "service/raft/group0_fwd.hh"
@@ -108,6 +109,7 @@
 #include <seastar/rpc/lz4_compressor.hh>
 #include <seastar/rpc/lz4_fragmented_compressor.hh>
 #include <seastar/rpc/multi_algo_compressor_factory.hh>
+#include "message/rpc_zstd_compressor.hh"
 #include "partition_range_compat.hh"
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/indirected.hpp>
@@ -160,6 +162,17 @@ const size_t PER_SHARD_CONNECTION_COUNT = 2;
 // Counts per tenant connection types
 const size_t PER_TENANT_CONNECTION_COUNT = 3;
 
+// The class of the connections of a client index, as named in
+// config::zstd_compressed_connections.
+static std::string_view connection_class(unsigned idx) {
+    static constexpr std::array<std::string_view, PER_TENANT_CONNECTION_COUNT> tenant_connection_classes = {"statement", "statement-ack", "mapreduce"};
+    switch (idx) {
+    case 0: return "gossip";
+    case 1: return "streaming";
+    default: return tenant_connection_classes[(idx - PER_SHARD_CONNECTION_COUNT) % PER_TENANT_CONNECTION_COUNT];
+    }
+}
+
 bool operator==(const msg_addr& x, const msg_addr& y) noexcept {
     // Ignore cpu id for now since we do not really support shard to shard connections
     return x.addr == y.addr;
@@ -334,7 +347,7 @@ void messaging_service::do_start_listen() {
     bool listen_to_bc = _cfg.listen_on_broadcast_address && _cfg.ip != broadcast_address;
     rpc::server_options so;
     if (_cfg.compress != compress_what::none) {
-        so.compressor_factory = &compressor_factory;
+        so.compressor_factory = _server_compressor_factory.get();
     }
     so.load_balancing_algorithm = server_socket::load_balancing_algorithm::port;
 
@@ -427,10 +440,16 @@ messaging_service::messaging_service(config cfg, scheduling_config scfg, std::sh
     : _cfg(std::move(cfg))
     , _rpc(new rpc_protocol_wrapper(serializer { }))
     , _credentials_builder(credentials ? std::make_unique<seastar::tls::credentials_builder>(*credentials) : nullptr)
-    , _clients(PER_SHARD_CONNECTION_COUNT + scfg.statement_tenants.size() * PER_TENANT_CONNECTION_COUNT)
+    , _stripe_clients_idx(PER_SHARD_CONNECTION_COUNT + scfg.statement_tenants.size() * PER_TENANT_CONNECTION_COUNT)
+    , _clients(_stripe_clients_idx + std::max(_cfg.streaming_connections, 1u) - 1)
     , _scheduling_config(scfg)
     , _scheduling_info_for_connection_index(initial_scheduling_info())
     , _feature_service(feature_service)
+    , _zstd_compressor_factory(std::make_unique<zstd_rpc_compressor_factory>(_cfg.zstd_compression_level, _cfg.zstd_compression_dictionary))
+    , _server_compressor_factory(std::make_unique<rpc::multi_algo_compressor_factory>(std::vector<const rpc::compressor::factory*>{
+            &lz4_fragmented_compressor_factory, &lz4_compressor_factory, _zstd_compressor_factory.get()}))
+    , _zstd_client_compressor_factory(std::make_unique<rpc::multi_algo_compressor_factory>(std::vector<const rpc::compressor::factory*>{
+            _zstd_compressor_factory.get(), &lz4_fragmented_compressor_factory, &lz4_compressor_factory}))
 {
     _rpc->set_logger(&rpc_logger);
 
@@ -617,6 +636,7 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::REPAIR_GET_FULL_ROW_HASHES_WITH_RPC_STREAM:
     case messaging_verb::REPAIR_UPDATE_SYSTEM_TABLE:
     case messaging_verb::REPAIR_FLUSH_HINTS_BATCHLOG:
+    case messaging_verb::REPAIR_GET_RANGE_SUMMARY:
     case messaging_verb::NODE_OPS_CMD:
     case messaging_verb::HINT_MUTATION:
     case messaging_verb::TABLET_STREAM_FILES:
@@ -626,6 +646,7 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
         return 1;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
+    case messaging_verb::MUTATION_BATCH:
     case messaging_verb::READ_DATA:
     case messaging_verb::READ_MUTATION_DATA:
     case messaging_verb::READ_DIGEST:
@@ -827,15 +848,37 @@ gms::inet_address messaging_service::get_public_endpoint_for(const gms::inet_add
     return i != _preferred_to_endpoint.end() ? i->second : ip;
 }
 
+// The verbs carrying bulk data, which are spread over the striped streaming
+// connections (see config::streaming_connections). Those opening an RPC
+// stream keep using the connection the stream was opened on, so the order of
+// its fragments is kept. Hints are applied in any order.
+static bool is_striped_verb(messaging_verb verb) {
+    switch (verb) {
+    case messaging_verb::STREAM_MUTATION_FRAGMENTS:
+    case messaging_verb::STREAM_BLOB:
+    case messaging_verb::REPAIR_GET_ROW_DIFF_WITH_RPC_STREAM:
+    case messaging_verb::REPAIR_PUT_ROW_DIFF_WITH_RPC_STREAM:
+    case messaging_verb::REPAIR_GET_FULL_ROW_HASHES_WITH_RPC_STREAM:
+    case messaging_verb::HINT_MUTATION:
+        return true;
+    default:
+        return false;
+    }
+}
+
 shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::get_rpc_client(messaging_verb verb, msg_addr id) {
     SCYLLA_ASSERT(!_shutting_down);
     if (_cfg.maintenance_mode) {
         on_internal_error(mlogger, "This node is in maintenance mode, it shouldn't contact other nodes");
     }
     auto idx = get_rpc_client_idx(verb);
-    auto it = _clients[idx].find(id);
+    // Stripe 0 is the regular connection of the verb.
+    auto stripes = _clients.size() - _stripe_clients_idx + 1;
+    auto stripe = stripes > 1 && is_striped_verb(verb) ? _next_stripe++ % stripes : 0;
+    auto& clients = stripe ? _clients[_stripe_clients_idx + stripe - 1] : _clients[idx];
+    auto it = clients.find(id);
 
-    if (it != _clients[idx].end()) {
+    if (it != clients.end()) {
         auto c = it->second.rpc_client;
         if (!c->error()) {
             return c;
@@ -843,7 +886,7 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
         // The 'dead_only' it should be true, because we're interested in
         // dropping the errored socket, but since it's errored anyway (the
         // above if) it's false to save unneeded second c->error() call
-        find_and_remove_client(_clients[idx], id, [] (const auto&) { return true; });
+        find_and_remove_client(clients, id, [] (const auto&) { return true; });
     }
 
     auto my_host_id = _cfg.id;
@@ -923,7 +966,8 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
     // send keepalive messages each minute if connection is idle, drop connection after 10 failures
     opts.keepalive = std::optional<net::tcp_keepalive_params>({60s, 60s, 10});
     if (must_compress) {
-        opts.compressor_factory = &compressor_factory;
+        opts.compressor_factory = std::ranges::contains(_cfg.zstd_compressed_connections, connection_class(idx))
+                ? _zstd_client_compressor_factory.get() : &compressor_factory;
     }
     opts.tcp_nodelay = must_tcp_nodelay;
     opts.reuseaddr = true;
@@ -945,7 +989,7 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
     // are independent of topology, so there's no point in dropping it later after we learn
     // the topology (so we always set `topology_ignored` to `false` in that case).
     bool topology_ignored = idx != TOPOLOGY_INDEPENDENT_IDX && topology_status.has_value() && *topology_status == false;
-    auto res = _clients[idx].emplace(id, shard_info(std::move(client), topology_ignored));
+    auto res = clients.emplace(id, shard_info(std::move(client), topology_ignored));
     SCYLLA_ASSERT(res.second);
     it = res.first;
     uint32_t src_cpu_id = this_shard_id();
@@ -1041,6 +1085,36 @@ future<> messaging_service::unregister_stream_mutation_fragments() {
     return unregister_handler(messaging_verb::STREAM_MUTATION_FRAGMENTS);
 }
 
+rpc::sink<int32_t> messaging_service::make_sink_for_stream_blob(rpc::source<streaming::stream_blob_cmd, bytes>& source) {
+    return source.make_sink<netw::serializer, int32_t>();
+}
+
+future<std::tuple<rpc::sink<streaming::stream_blob_cmd, bytes>, rpc::source<int32_t>>>
+messaging_service::make_sink_and_source_for_stream_blob(streaming::stream_blob_meta meta, msg_addr id) {
+    using value_type = std::tuple<rpc::sink<streaming::stream_blob_cmd, bytes>, rpc::source<int32_t>>;
+    if (is_shutting_down()) {
+        co_await coroutine::return_exception(rpc::closed_error());
+    }
+    auto rpc_client = get_rpc_client(messaging_verb::STREAM_BLOB, id);
+    auto sink = co_await rpc_client->make_stream_sink<netw::serializer, streaming::stream_blob_cmd, bytes>();
+    auto rpc_handler = rpc()->make_client<rpc::source<int32_t> (streaming::stream_blob_meta, rpc::sink<streaming::stream_blob_cmd, bytes>)>(messaging_verb::STREAM_BLOB);
+    auto source_fut = co_await coroutine::as_future(rpc_handler(*rpc_client, std::move(meta), sink));
+    if (source_fut.failed()) {
+        auto ex = source_fut.get_exception();
+        co_await sink.close();
+        co_return coroutine::exception(std::move(ex));
+    }
+    co_return value_type(std::move(sink), source_fut.get());
+}
+
+void messaging_service::register_stream_blob(std::function<future<rpc::sink<int32_t>> (const rpc::client_info& cinfo, streaming::stream_blob_meta meta, rpc::source<streaming::stream_blob_cmd, bytes> source)>&& func) {
+    register_handler(this, messaging_verb::STREAM_BLOB, std::move(func));
+}
+
+future<> messaging_service::unregister_stream_blob() {
+    return unregister_handler(messaging_verb::STREAM_BLOB);
+}
+
 template<class SinkType, class SourceType>
 future<std::tuple<rpc::sink<SinkType>, rpc::source<SourceType>>>
 do_make_sink_source(messaging_verb verb, uint32_t repair_meta_id, shard_id dst_shard_id, shared_ptr<messaging_service::rpc_protocol_client_wrapper> rpc_client, std::unique_ptr<messaging_service::rpc_protocol_wrapper>& rpc) {
@@ -37,6 +37,8 @@
 namespace streaming {
     class prepare_message;
     enum class stream_mutation_fragments_cmd : uint8_t;
+    enum class stream_blob_cmd : uint8_t;
+    struct stream_blob_meta;
 }
 
 namespace gms {
@@ -202,7 +204,9 @@ enum class messaging_verb : int32_t {
     TABLE_LOAD_STATS = 72,
     JOIN_NODE_QUERY = 73,
     TASKS_GET_CHILDREN = 74,
-    LAST = 75,
+    REPAIR_GET_RANGE_SUMMARY = 75,
+    MUTATION_BATCH = 76,
+    LAST = 77,
 };
 
 } // namespace netw
@@ -290,6 +294,15 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
         uint16_t ssl_port = 0;
         encrypt_what encrypt = encrypt_what::none;
         compress_what compress = compress_what::none;
+        // The classes of connections ("gossip", "streaming", "statement",
+        // "statement-ack" and "mapreduce") which, when compressed, offer zstd.
+        std::vector<sstring> zstd_compressed_connections;
+        int zstd_compression_level = 3;
+        // The contents of the dictionary for zstd compression, if any.
+        sstring zstd_compression_dictionary;
+        // The number of connections to each node, from each shard, over which the
+        // verbs carrying bulk data of streaming, repair and hints are spread.
+        unsigned streaming_connections = 1;
         tcp_nodelay_what tcp_nodelay = tcp_nodelay_what::all;
         bool listen_on_broadcast_address = false;
         size_t rpc_memory_limit = 1'000'000;
@@ -334,7 +347,11 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     ::shared_ptr<seastar::tls::server_credentials> _credentials;
     std::unique_ptr<seastar::tls::credentials_builder> _credentials_builder;
     std::array<std::unique_ptr<rpc_protocol_server_wrapper>, 2> _server_tls;
+    // The index in _clients of the first of the additional striped streaming
+    // connections, which follow the connections of the verb groups.
+    size_t _stripe_clients_idx;
     std::vector<clients_map> _clients;
+    unsigned _next_stripe = 0;
     uint64_t _dropped_messages[static_cast<int32_t>(messaging_verb::LAST)] = {};
     bool _shutting_down = false;
     connection_drop_signal_t _connection_dropped;
@@ -342,6 +359,11 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     std::vector<scheduling_info_for_connection_index> _scheduling_info_for_connection_index;
     std::vector<tenant_connection_index> _connection_index_for_tenant;
     gms::feature_service& _feature_service;
+    std::unique_ptr<rpc::compressor::factory> _zstd_compressor_factory;
+    // Accepts both LZ4 and zstd.
+    std::unique_ptr<rpc::compressor::factory> _server_compressor_factory;
+    // Offers zstd, then LZ4.
+    std::unique_ptr<rpc::compressor::factory> _zstd_client_compressor_factory;
 
     struct connection_ref;
     std::unordered_multimap<locator::host_id, connection_ref> _host_connections;
@@ -400,6 +422,13 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     rpc::sink<int32_t> make_sink_for_stream_mutation_fragments(rpc::source<frozen_mutation_fragment, rpc::optional<streaming::stream_mutation_fragments_cmd>>& source);
     future<std::tuple<rpc::sink<frozen_mutation_fragment, streaming::stream_mutation_fragments_cmd>, rpc::source<int32_t>>> make_sink_and_source_for_stream_mutation_fragments(table_schema_version schema_id, streaming::plan_id plan_id, table_id cf_id, uint64_t estimated_partitions, streaming::stream_reason reason, service::session_id session, msg_addr id);
 
+    // Wrapper for STREAM_BLOB
+    // The receiver of STREAM_BLOB sends a status code to the sender once the file is written. 0 means successful, -1 means error.
+    void register_stream_blob(std::function<future<rpc::sink<int32_t>> (const rpc::client_info& cinfo, streaming::stream_blob_meta meta, rpc::source<streaming::stream_blob_cmd, bytes> source)>&& func);
+    future<> unregister_stream_blob();
+    rpc::sink<int32_t> make_sink_for_stream_blob(rpc::source<streaming::stream_blob_cmd, bytes>& source);
+    future<std::tuple<rpc::sink<streaming::stream_blob_cmd, bytes>, rpc::source<int32_t>>> make_sink_and_source_for_stream_blob(streaming::stream_blob_meta meta, msg_addr id);
+
     // Wrapper for REPAIR_GET_ROW_DIFF_WITH_RPC_STREAM
     future<std::tuple<rpc::sink<repair_hash_with_cmd>, rpc::source<repair_row_on_wire_with_cmd>>> make_sink_and_source_for_repair_get_row_diff_with_rpc_stream(uint32_t repair_meta_id, shard_id dst_cpu_id, msg_addr id);
     rpc::sink<repair_row_on_wire_with_cmd> make_sink_for_repair_get_row_diff_with_rpc_stream(rpc::source<repair_hash_with_cmd>& source);
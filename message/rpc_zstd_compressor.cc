@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <concepts>
+#include <stdexcept>
+#include <vector>
+
+#include <zstd.h>
+#include <fmt/format.h>
+
+#include "message/rpc_zstd_compressor.hh"
+#include "utils/xx_hasher.hh"
+
+namespace netw {
+
+struct zstd_rpc_compressor_factory::dictionary {
+    std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> cdict{nullptr, &ZSTD_freeCDict};
+    std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)> ddict{nullptr, &ZSTD_freeDDict};
+};
+
+static size_t check_zstd(size_t ret, const char* what) {
+    if (ZSTD_isError(ret)) {
+        throw std::runtime_error(fmt::format("{} failed: {}", what, ZSTD_getErrorName(ret)));
+    }
+    return ret;
+}
+
+// Compression is synchronous, so the connections of a shard share a
+// compression and a decompression context.
+static ZSTD_CCtx* shard_cctx() {
+    static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    if (!cctx) {
+        throw std::bad_alloc();
+    }
+    return cctx.get();
+}
+
+static ZSTD_DCtx* shard_dctx() {
+    static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    if (!dctx) {
+        throw std::bad_alloc();
+    }
+    return dctx.get();
+}
+
+template <typename Buf>
+static void for_each_fragment(Buf& buf, std::invocable<const char*, size_t> auto&& f) {
+    size_t left = buf.size;
+    auto visit = [&] (temporary_buffer<char>& b) {
+        auto n = std::min(b.size(), left);
+        left -= n;
+        f(b.get(), n);
+    };
+    if (auto* b = std::get_if<temporary_buffer<char>>(&buf.bufs)) {
+        visit(*b);
+    } else {
+        for (auto& b : std::get<std::vector<temporary_buffer<char>>>(buf.bufs)) {
+            visit(b);
+        }
+    }
+}
+
+// Collects the output of a (de)compression stream in chunks of at most
+// snd_buf::chunk_size bytes, so that large messages don't need large
+// contiguous allocations.
+class chunked_output {
+    std::vector<temporary_buffer<char>> _chunks;
+    size_t _size = 0;
+    // How much output is still expected, used to size the chunks.
+    size_t _expected;
+public:
+    ZSTD_outBuffer out{nullptr, 0, 0};
+
+    chunked_output(size_t head_space, size_t expected) : _expected(head_space + expected) {
+        next();
+        out.pos = head_space;
+    }
+
+    void next() {
+        if (!_chunks.empty()) {
+            _size += out.pos;
+            _expected -= std::min(_expected, out.pos);
+        }
+        _chunks.emplace_back(std::clamp(_expected, size_t(1), size_t(rpc::snd_buf::chunk_size)));
+        out = ZSTD_outBuffer{_chunks.back().get_write(), _chunks.back().size(), 0};
+    }
+
+    void ensure_space() {
+        if (out.pos == out.size) {
+            next();
+        }
+    }
+
+    template <typename Buf>
+    Buf finish() && {
+        _chunks.back().trim(out.pos);
+        _size += out.pos;
+        if (_chunks.size() == 1) {
+            return Buf(std::move(_chunks.front()));
+        }
+        Buf ret;
+        ret.size = _size;
+        ret.bufs = std::move(_chunks);
+        return ret;
+    }
+};
+
+class zstd_rpc_compressor final : public rpc::compressor {
+    int _level;
+    std::shared_ptr<const zstd_rpc_compressor_factory::dictionary> _dictionary;
+    sstring _name;
+public:
+    zstd_rpc_compressor(int level, std::shared_ptr<const zstd_rpc_compressor_factory::dictionary> dictionary, sstring name)
+        : _level(level)
+        , _dictionary(std::move(dictionary))
+        , _name(std::move(name))
+    { }
+
+    virtual rpc::snd_buf compress(size_t head_space, rpc::snd_buf data) override {
+        auto* cctx = shard_cctx();
+        check_zstd(ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters), "ZSTD_CCtx_reset");
+        if (_dictionary) {
+            check_zstd(ZSTD_CCtx_refCDict(cctx, _dictionary->cdict.get()), "ZSTD_CCtx_refCDict");
+        } else {
+            check_zstd(ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, _level), "ZSTD_CCtx_setParameter");
+        }
+        check_zstd(ZSTD_CCtx_setPledgedSrcSize(cctx, data.size), "ZSTD_CCtx_setPledgedSrcSize");
+
+        chunked_output output(head_space, ZSTD_compressBound(data.size));
+        auto compress = [&] (const char* p, size_t n, ZSTD_EndDirective mode) {
+            ZSTD_inBuffer in{p, n, 0};
+            for (;;) {
+                output.ensure_space();
+                auto left = check_zstd(ZSTD_compressStream2(cctx, &output.out, &in, mode), "ZSTD_compressStream2");
+                if (mode == ZSTD_e_end ? left == 0 : in.pos == in.size) {
+                    break;
+                }
+            }
+        };
+        for_each_fragment(data, [&] (const char* p, size_t n) {
+            compress(p, n, ZSTD_e_continue);
+        });
+        compress(nullptr, 0, ZSTD_e_end);
+        return std::move(output).finish<rpc::snd_buf>();
+    }
+
+    virtual rpc::rcv_buf decompress(rpc::rcv_buf data) override {
+        auto* dctx = shard_dctx();
+        check_zstd(ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters), "ZSTD_DCtx_reset");
+        if (_dictionary) {
+            check_zstd(ZSTD_DCtx_refDDict(dctx, _dictionary->ddict.get()), "ZSTD_DCtx_refDDict");
+        }
+
+        // The compressing side pledges the size of the message, which is
+        // recorded in the frame header.
+        size_t expected = rpc::snd_buf::chunk_size;
+        for_each_fragment(data, [&, first = true] (const char* p, size_t n) mutable {
+            if (std::exchange(first, false)) {
+                auto content_size = ZSTD_getFrameContentSize(p, n);
+                if (content_size != ZSTD_CONTENTSIZE_UNKNOWN && content_size != ZSTD_CONTENTSIZE_ERROR) {
+                    expected = content_size;
+                }
+            }
+        });
+
+        chunked_output output(0, expected);
+        size_t left = 1;
+        for_each_fragment(data, [&] (const char* p, size_t n) {
+            ZSTD_inBuffer in{p, n, 0};
+            while (left) {
+                output.ensure_space();
+                left = check_zstd(ZSTD_decompressStream(dctx, &output.out, &in), "ZSTD_decompressStream");
+                if (in.pos == in.size && output.out.pos < output.out.size) {
+                    break;
+                }
+            }
+        });
+        if (left) {
+            throw std::runtime_error("zstd RPC compressor: truncated message");
+        }
+        return std::move(output).finish<rpc::rcv_buf>();
+    }
+
+    virtual sstring name() const override {
+        return _name;
+    }
+};
+
+zstd_rpc_compressor_factory::zstd_rpc_compressor_factory(int level, std::string_view dictionary)
+    : _level(level)
+    , _name("ZSTD")
+{
+    if (dictionary.empty()) {
+        return;
+    }
+    auto d = std::make_shared<struct dictionary>();
+    d->cdict.reset(ZSTD_createCDict(dictionary.data(), dictionary.size(), level));
+    d->ddict.reset(ZSTD_createDDict(dictionary.data(), dictionary.size()));
+    if (!d->cdict || !d->ddict) {
+        throw std::runtime_error("zstd RPC compressor: failed to load the dictionary");
+    }
+    _dictionary = std::move(d);
+    xx_hasher h;
+    h.update(dictionary.data(), dictionary.size());
+    _name = fmt::format("ZSTD_DICT_{:016x}", h.finalize_uint64());
+}
+
+zstd_rpc_compressor_factory::~zstd_rpc_compressor_factory() = default;
+
+std::unique_ptr<rpc::compressor> zstd_rpc_compressor_factory::negotiate(sstring feature, bool is_server) const {
+    if (feature != _name) {
+        return nullptr;
+    }
+    return std::make_unique<zstd_rpc_compressor>(_level, _dictionary, _name);
+}
+
+} // namespace netw
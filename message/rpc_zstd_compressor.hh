@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include <seastar/core/sstring.hh>
+#include <seastar/rpc/rpc_types.hh>
+
+#include "seastarx.hh"
+
+namespace netw {
+
+// Zstd compression of RPC connections, optionally with a dictionary.
+//
+// Each message is compressed as a single zstd frame. Both sides of a connection
+// have to use the same dictionary, so the name of the algorithm, which is what
+// the connection negotiates, identifies the dictionary, and nodes with
+// different dictionaries fall back to another algorithm they both support.
+class zstd_rpc_compressor_factory : public rpc::compressor::factory {
+public:
+    struct dictionary;
+private:
+    int _level;
+    std::shared_ptr<const dictionary> _dictionary;
+    sstring _name;
+public:
+    // An empty dictionary compresses without one.
+    explicit zstd_rpc_compressor_factory(int level, std::string_view dictionary = {});
+    ~zstd_rpc_compressor_factory();
+
+    virtual const sstring& supported() const override {
+        return _name;
+    }
+    virtual std::unique_ptr<rpc::compressor> negotiate(sstring feature, bool is_server) const override;
+};
+
+} // namespace netw
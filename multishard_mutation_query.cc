@@ -366,6 +366,15 @@ mutation_reader read_context::create_reader(
 
     rm.state = reader_state::used;
 
+    // Range scans can share their reads with concurrent scans of the same
+    // range. Readers recreated after eviction can join a shared scan too, if
+    // another scan happens to start at the same position.
+    auto& db = _db.local();
+    if (db.get_config().enable_shared_scans() && !fwd_mr && !rm.rparts->range->is_singular()) {
+        return db.get_querier_cache().get_shared_scans().make_reader(table.as_mutation_source(), std::move(schema), rm.rparts->permit,
+                *rm.rparts->range, *rm.rparts->slice, std::move(trace_state), size_t(db.get_config().shared_scan_window_size_in_kb()) * 1024);
+    }
+
     return table.as_mutation_source().make_reader_v2(std::move(schema), rm.rparts->permit, *rm.rparts->range, *rm.rparts->slice,
             std::move(trace_state), streamed_mutation::forwarding::no, fwd_mr);
 }
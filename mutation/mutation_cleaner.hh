@@ -16,9 +16,9 @@
 class mutation_cleaner;
 
 class mutation_cleaner_impl final {
-    using snapshot_list = boost::intrusive::slist<partition_snapshot,
-        boost::intrusive::member_hook<partition_snapshot, boost::intrusive::slist_member_hook<>, &partition_snapshot::_cleaner_hook>,
-                boost::intrusive::cache_last<true>>;
+    using snapshot_list = boost::intrusive::list<partition_snapshot,
+        boost::intrusive::member_hook<partition_snapshot, boost::intrusive::list_member_hook<>, &partition_snapshot::_cleaner_hook>,
+        boost::intrusive::constant_time_size<false>>;
     struct worker {
         condition_variable cv;
         snapshot_list snapshots;
@@ -64,6 +64,8 @@ class mutation_cleaner_impl final {
     bool empty() const noexcept { return _versions.empty(); }
     future<> drain();
     void merge_and_destroy(partition_snapshot&) noexcept;
+    void prioritize(partition_snapshot&) noexcept;
+    mutation_application_stats& app_stats() noexcept { return _app_stats; }
     void set_scheduling_group(seastar::scheduling_group sg) {
         _scheduling_group = sg;
         _worker_state->cv.broadcast();
@@ -99,6 +101,15 @@ void mutation_cleaner_impl::destroy_gently(partition_version& v) noexcept {
     }
 }
 
+inline
+void mutation_cleaner_impl::prioritize(partition_snapshot& ps) noexcept {
+    auto& snapshots = _worker_state->snapshots;
+    if (&snapshots.front() != &ps) {
+        snapshots.erase(snapshots.iterator_to(ps));
+        snapshots.push_front(ps);
+    }
+}
+
 inline
 void mutation_cleaner_impl::merge_and_destroy(partition_snapshot& ps) noexcept {
     if (ps.slide_to_oldest() == stop_iteration::yes || (!_worker_state->merging_paused && merge_some(ps) == stop_iteration::yes)) {
@@ -203,6 +214,17 @@ class mutation_cleaner final {
         return _impl->merge_and_destroy(ps);
     }
 
+    // Makes the snapshot the next one to be merged.
+    // The snapshot must be waiting for merging in this cleaner, after merge_and_destroy().
+    // Reads of the partition have to merge its versions on the fly until then.
+    void prioritize(partition_snapshot& ps) noexcept {
+        _impl->prioritize(ps);
+    }
+
+    mutation_application_stats& app_stats() noexcept {
+        return _impl->app_stats();
+    }
+
     // Ensures the cleaner isn't doing any version merging while
     // the returned guard object is alive.
     //
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <algorithm>
+
 #include "mutation/mutation_fragment_stream_validator.hh"
 #include "utils/to_string.hh"
 #include "seastarx.hh"
@@ -231,6 +233,7 @@ void mutation_fragment_stream_validator::reset(const mutation_fragment& mf) {
 namespace {
 
 bool on_validation_error(seastar::logger& l, const mutation_fragment_stream_validating_filter& zis, mutation_fragment_stream_validator::validation_result res) {
+    ++mutation_fragment_stream_validation_stats::shard_stats().errors;
     if (!zis.raise_errors()) {
         l.error("[validator {} for {}] {}", fmt::ptr(&zis), zis.full_name(), res.what());
         return false;
@@ -271,6 +274,7 @@ mutation_fragment_stream_validating_filter::mutation_fragment_stream_validating_
     : _validator(s)
     , _name_storage(std::move(name_value))
     , _validation_level(level)
+    , _partition_validation_level(level)
     , _raise_errors(raise_errors)
 {
     if (name_literal) {
@@ -311,6 +315,26 @@ mutation_fragment_stream_validating_filter::mutation_fragment_stream_validating_
     : mutation_fragment_stream_validating_filter(name, {}, s, level, raise_errors)
 { }
 
+void mutation_fragment_stream_validating_filter::set_full_validation_ratio(double ratio) {
+    _full_validation_ratio = std::clamp(ratio, 0.0, 1.0);
+}
+
+void mutation_fragment_stream_validating_filter::on_partition_start() {
+    if (_validation_level < mutation_fragment_stream_validation_level::clustering_key) {
+        return;
+    }
+    auto& stats = mutation_fragment_stream_validation_stats::shard_stats();
+    if (_full_validation_credit >= 1.0) {
+        _full_validation_credit -= 1.0;
+        _partition_validation_level = _validation_level;
+        ++stats.partitions_fully_validated;
+    } else {
+        _partition_validation_level = mutation_fragment_stream_validation_level::partition_key;
+        ++stats.partitions_partially_validated;
+    }
+    _full_validation_credit += _full_validation_ratio;
+}
+
 bool mutation_fragment_stream_validating_filter::operator()(mutation_fragment_v2::kind kind, position_in_partition_view pos,
         std::optional<tombstone> new_current_tombstone) {
     std::optional<mutation_fragment_stream_validator::validation_result> res;
@@ -319,7 +343,13 @@ bool mutation_fragment_stream_validating_filter::operator()(mutation_fragment_v2
 
     if (_validation_level == mutation_fragment_stream_validation_level::none) {
         return true;
-    } else if (_validation_level >= mutation_fragment_stream_validation_level::clustering_key) {
+    }
+    if (kind == mutation_fragment_v2::kind::partition_start) {
+        on_partition_start();
+    }
+    // The position of a partition start isn't compared to the previous one,
+    // so partitions validated at different levels can follow each other.
+    if (_partition_validation_level >= mutation_fragment_stream_validation_level::clustering_key) {
         res = _validator(kind, pos, new_current_tombstone);
     } else {
         res = _validator(kind, new_current_tombstone);
@@ -170,6 +170,21 @@ class mutation_fragment_stream_validator {
     }
 };
 
+/// Per-shard counters of the validating filters.
+struct mutation_fragment_stream_validation_stats {
+    // Partitions validated at the configured level.
+    uint64_t partitions_fully_validated = 0;
+    // Partitions which weren't sampled for full validation, and were only
+    // validated at the partition key level.
+    uint64_t partitions_partially_validated = 0;
+    uint64_t errors = 0;
+
+    static mutation_fragment_stream_validation_stats& shard_stats() {
+        static thread_local mutation_fragment_stream_validation_stats stats;
+        return stats;
+    }
+};
+
 struct invalid_mutation_fragment_stream : public std::runtime_error {
     explicit invalid_mutation_fragment_stream(std::runtime_error e);
 };
@@ -180,17 +195,32 @@ struct invalid_mutation_fragment_stream : public std::runtime_error {
 /// If the `abort_on_internal_error` configuration option is set, it will
 /// abort instead.
 /// Implements the FlattenedConsumerFilter concept.
+///
+/// Validating the clustering keys costs a key comparison per fragment, which
+/// is too much to always pay in production. The filter can instead fully
+/// validate only a fraction of the partitions (\ref set_full_validation_ratio()),
+/// evenly spaced in the stream, and validate the rest at
+/// `mutation_fragment_stream_validation_level::partition_key` at most, which
+/// costs a comparison per partition.
 class mutation_fragment_stream_validating_filter {
     mutation_fragment_stream_validator _validator;
     sstring _name_storage;
     std::string_view _name_view; // always valid
     mutation_fragment_stream_validation_level _validation_level;
+    // The level the current partition is validated at.
+    mutation_fragment_stream_validation_level _partition_validation_level;
+    double _full_validation_ratio = 1.0;
+    // Accumulates the ratio for each partition, a partition is fully
+    // validated each time it reaches 1.
+    double _full_validation_credit = 1.0;
     bool _raise_errors;
 
 private:
     mutation_fragment_stream_validating_filter(const char* name_literal, sstring name_value, const schema& s,
             mutation_fragment_stream_validation_level level, bool raise_errors);
 
+    void on_partition_start();
+
 public:
     /// Constructor.
     ///
@@ -207,6 +237,14 @@ class mutation_fragment_stream_validating_filter {
 
     bool raise_errors() const { return _raise_errors; }
 
+    /// Fully validate only the given fraction (0-1) of the partitions.
+    ///
+    /// Only has an effect if the validation level is
+    /// `mutation_fragment_stream_validation_level::clustering_key`. Takes effect
+    /// from the next partition, the first partition is always fully validated.
+    void set_full_validation_ratio(double ratio);
+    double full_validation_ratio() const { return _full_validation_ratio; }
+
     const mutation_fragment_stream_validator& validator() const { return  _validator; }
 
     bool operator()(const dht::decorated_key& dk);
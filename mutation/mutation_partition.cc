@@ -720,7 +720,8 @@ void appending_hash<row>::operator()(Hasher& h, const row& cells, const schema&
                 if (cell_and_hash->hash) {
                     feed_hash(h, *cell_and_hash->hash);
                 } else {
-                    Hasher cellh;
+                    // Must match the hashes cached by prepare_hash().
+                    query::default_hasher cellh;
                     feed_hash(cellh, cell_and_hash->cell.as_atomic_cell(def), def);
                     feed_hash(h, cellh.finalize_uint64());
                 }
@@ -734,7 +735,7 @@ void appending_hash<row>::operator()(Hasher& h, const row& cells, const schema&
                 if (cell_and_hash->hash) {
                     feed_hash(h, *cell_and_hash->hash);
                 } else {
-                    Hasher cellh;
+                    query::default_hasher cellh;
                     feed_hash(cellh, cm, def);
                     feed_hash(h, cellh.finalize_uint64());
                 }
@@ -1093,12 +1093,17 @@ struct mutation_application_stats {
     uint64_t row_writes = 0;
     uint64_t rows_compacted_with_tombstones = 0;
     uint64_t rows_dropped_by_tombstones = 0;
+    // Reads of partition entries, and the versions they had to merge.
+    uint64_t partition_reads = 0;
+    uint64_t partition_versions_read = 0;
 
     mutation_application_stats& operator+=(const mutation_application_stats& other) {
         row_hits += other.row_hits;
         row_writes += other.row_writes;
         rows_compacted_with_tombstones += other.rows_compacted_with_tombstones;
         rows_dropped_by_tombstones += other.rows_dropped_by_tombstones;
+        partition_reads += other.partition_reads;
+        partition_versions_read += other.partition_versions_read;
         return *this;
     }
 };
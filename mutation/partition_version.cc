@@ -425,9 +425,17 @@ void partition_entry::apply(logalloc::region& r,
            const mutation_partition& mp,
            const schema& mp_schema,
            mutation_application_stats& app_stats) {
-    auto mp_v1 = mutation_partition(mp_schema, mp);
-    mp_v1.make_fully_continuous();
-    apply(r, c, s, mutation_partition_v2(mp_schema, std::move(mp_v1)), mp_schema, app_stats);
+    apply(r, c, s, mutation_partition(mp_schema, mp), mp_schema, app_stats);
+}
+
+void partition_entry::apply(logalloc::region& r,
+           mutation_cleaner& c,
+           const schema& s,
+           mutation_partition&& mp,
+           const schema& mp_schema,
+           mutation_application_stats& app_stats) {
+    mp.make_fully_continuous();
+    apply(r, c, s, mutation_partition_v2(mp_schema, std::move(mp)), mp_schema, app_stats);
 }
 
 void partition_entry::apply(logalloc::region& r, mutation_cleaner& cleaner, const schema& s, mutation_partition_v2&& mp, const schema& mp_schema,
@@ -657,9 +665,32 @@ void partition_entry::upgrade(logalloc::region& r, schema_ptr to, mutation_clean
     });
 }
 
+void partition_entry::on_read(mutation_cleaner& cleaner) noexcept {
+    auto& stats = cleaner.app_stats();
+    ++stats.partition_reads;
+    if (!_version) {
+        return;
+    }
+    ++stats.partition_versions_read;
+    for (partition_version* v = _version->next(); v; v = v->next()) {
+        ++stats.partition_versions_read;
+        // Older versions are referenced by the snapshots of reads in progress,
+        // and by the snapshots waiting for the cleaner to merge them. Reads
+        // have to merge the versions on the fly until the cleaner gets to
+        // them, so the cleaner merges the partitions which are read first.
+        if (v->is_referenced()) {
+            auto& snp = partition_snapshot::container_of(v->_backref);
+            if (snp._cleaner_hook.is_linked()) {
+                snp.cleaner().prioritize(snp);
+            }
+        }
+    }
+}
+
 partition_snapshot_ptr partition_entry::read(logalloc::region& r,
     mutation_cleaner& cleaner, cache_tracker* tracker, partition_snapshot::phase_type phase)
 {
+    on_read(cleaner);
     if (_snapshot) {
         if (_snapshot->_phase == phase) {
             return _snapshot->shared_from_this();
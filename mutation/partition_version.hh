@@ -17,7 +17,7 @@
 #include "utils/chunked_vector.hh"
 
 #include <boost/intrusive/parent_from_member.hpp>
-#include <boost/intrusive/slist.hpp>
+#include <boost/intrusive/list.hpp>
 
 class static_row;
 
@@ -360,7 +360,7 @@ class partition_snapshot : public enable_lw_shared_from_this<partition_snapshot>
     logalloc::region* _region;
     mutation_cleaner* _cleaner;
     cache_tracker* _tracker;
-    boost::intrusive::slist_member_hook<> _cleaner_hook;
+    boost::intrusive::list_member_hook<> _cleaner_hook;
     std::optional<apply_resume> _version_merging_state;
     bool _locked = false;
     friend class partition_entry;
@@ -618,6 +618,15 @@ class partition_entry {
                const schema& mp_schema,
                mutation_application_stats& app_stats);
 
+    // Like the above, but takes the rows and cells of mp rather than
+    // copying them, which avoids a copy of the whole mutation on the write path.
+    void apply(logalloc::region&,
+               mutation_cleaner&,
+               const schema& s,
+               mutation_partition&& mp,
+               const schema& mp_schema,
+               mutation_application_stats& app_stats);
+
     // Adds mutation_partition represented by "pe" to the one represented
     // by this entry.
     // This entry must be evictable.
@@ -697,6 +706,9 @@ class partition_entry {
         mutation_cleaner&,
         cache_tracker*,
         partition_snapshot::phase_type phase = partition_snapshot::default_phase);
+private:
+    void on_read(mutation_cleaner&) noexcept;
+public:
 
     class printer {
         const partition_entry& _partition_entry;
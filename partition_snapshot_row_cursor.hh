@@ -314,8 +314,11 @@ class partition_snapshot_row_cursor final {
     // When throws, the cursor is invalidated and its position is not changed.
     bool advance(bool keep) {
         memory::on_alloc_point();
-        version_heap_less_compare heap_less(*this);
         SCYLLA_ASSERT(iterators_valid());
+        if (!_reversed && _heap.empty() && _current_row.size() == 1) [[likely]] {
+            return advance_in_single_version(keep);
+        }
+        version_heap_less_compare heap_less(*this);
         for (auto&& curr : _current_row) {
             if (!keep && curr.unique_owner) {
                 mutation_partition::rows_type::key_grabber kg(curr.it);
@@ -365,6 +368,45 @@ class partition_snapshot_row_cursor final {
         return recreate_current_row();
     }
 
+    // Fast path of advance() for forward cursors when only one version has entries
+    // ahead of the cursor, which is the common case for cold, fully merged partitions.
+    // Equivalent to advance() but steps the iterator in place, without maintaining the heap.
+    bool advance_in_single_version(bool keep) {
+        position_in_version& curr = _current_row[0];
+        if (!keep && curr.unique_owner) {
+            mutation_partition::rows_type::key_grabber kg(curr.it);
+            kg.release(current_deleter<rows_entry>());
+        } else {
+            ++curr.it;
+            if (curr.it) {
+                curr.continuous = curr.it->continuous();
+                curr.rt = curr.it->range_tombstone();
+            }
+        }
+        if (!curr.it) {
+            _current_row.clear();
+            return recreate_current_row();
+        }
+        if (curr.version_no == 0) {
+            _latest_it = curr.it;
+        }
+        memory::on_alloc_point();
+        rows_entry& e = *curr.it;
+        if (_digest_requested) {
+            e.row().cells().prepare_hash(*curr.schema, column_kind::regular_column);
+        }
+        _dummy = bool(e.dummy());
+        _continuous = _background_continuity || bool(curr.continuous);
+        _range_tombstone = _background_rt;
+        _range_tombstone_for_row = _background_rt;
+        _range_tombstone_for_row.apply(e.range_tombstone());
+        if (curr.continuous) {
+            _range_tombstone.apply(curr.rt);
+        }
+        _position = position_in_partition(e.position());
+        return true;
+    }
+
     bool is_in_latest_version() const noexcept { return at_a_row() && _current_row[0].version_no == 0; }
 
 public:
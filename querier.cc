@@ -214,6 +214,46 @@ static std::unique_ptr<querier_base> find_querier(querier_cache::index& index, q
     return ptr;
 }
 
+static bool slices_match(const schema& s, const query::partition_slice& a, const query::partition_slice& b) {
+    // The specific ranges are not compared, the page's slice has a specific
+    // range for the partition the previous page stopped in. This is checked
+    // by clustering_position_matches().
+    const auto cmp = clustering_key_prefix::prefix_equal_tri_compare(s);
+    return a.options.mask() == b.options.mask()
+        && a.static_columns == b.static_columns
+        && a.regular_columns == b.regular_columns
+        && a.partition_row_limit() == b.partition_row_limit()
+        && std::ranges::equal(a.default_row_ranges(), b.default_row_ranges(),
+                [&cmp] (const query::clustering_range& x, const query::clustering_range& y) { return x.equal(y, cmp); });
+}
+
+// Finds the querier of another query which can continue from where the page
+// starts: the same table and schema version, the same semaphore and slice, a
+// matching range, and a position matching the start of the page.
+// The index is scanned, this is only done on a miss by key.
+static std::unique_ptr<querier_base> find_querier_by_position(querier_cache::index& index, const schema& s,
+        dht::partition_ranges_view ranges, const query::partition_slice& slice, reader_concurrency_semaphore& current_sem,
+        tracing::trace_state_ptr trace_state) {
+    const auto it = std::find_if(index.begin(), index.end(), [&] (const querier_cache::index::value_type& e) {
+        auto& q = *e.second;
+        if (q.schema().version() != s.version() || &q.permit().semaphore() != &current_sem
+                || !slices_match(s, q.slice(), slice) || !ranges_match(s, q.ranges(), ranges)) {
+            return false;
+        }
+        // Queriers which didn't read anything yet match any position, these
+        // are not compatible with a page continuing another query.
+        const auto pos_opt = q.current_position();
+        return pos_opt && ring_position_matches(s, ranges.front(), slice, *pos_opt) && clustering_position_matches(s, slice, *pos_opt);
+    });
+    if (it == index.end()) {
+        return nullptr;
+    }
+    tracing::trace(trace_state, "Found cached querier of query {} matching the position of the page", it->first);
+    auto ptr = std::move(it->second);
+    index.erase(it);
+    return ptr;
+}
+
 querier_cache::querier_cache(is_user_semaphore_func is_user_semaphore_func, std::chrono::seconds entry_ttl)
     : _entry_ttl(entry_ttl), _is_user_semaphore_func(is_user_semaphore_func) {
 }
@@ -330,10 +370,15 @@ std::optional<Querier> querier_cache::lookup_querier(
         const query::partition_slice& slice,
         reader_concurrency_semaphore& current_sem,
         tracing::trace_state_ptr trace_state,
-        db::timeout_clock::time_point timeout) {
+        db::timeout_clock::time_point timeout,
+        lookup_by_position by_position) {
     auto base_ptr = find_querier(index, key, ranges, trace_state);
     auto& stats = _stats;
     ++stats.lookups;
+    if (!base_ptr && by_position && _lookup_by_position()) {
+        base_ptr = find_querier_by_position(index, s, ranges, slice, current_sem, trace_state);
+        stats.position_hits += bool(base_ptr);
+    }
     if (!base_ptr) {
         ++stats.misses;
         return std::nullopt;
@@ -405,7 +450,7 @@ std::optional<querier> querier_cache::lookup_data_querier(query_id key,
         reader_concurrency_semaphore& current_sem,
         tracing::trace_state_ptr trace_state,
         db::timeout_clock::time_point timeout) {
-    return lookup_querier<querier>(_data_querier_index, key, s, range, slice, current_sem, std::move(trace_state), timeout);
+    return lookup_querier<querier>(_data_querier_index, key, s, range, slice, current_sem, std::move(trace_state), timeout, lookup_by_position::yes);
 }
 
 std::optional<querier> querier_cache::lookup_mutation_querier(query_id key,
@@ -415,7 +460,7 @@ std::optional<querier> querier_cache::lookup_mutation_querier(query_id key,
         reader_concurrency_semaphore& current_sem,
         tracing::trace_state_ptr trace_state,
         db::timeout_clock::time_point timeout) {
-    return lookup_querier<querier>(_mutation_querier_index, key, s, range, slice, current_sem, std::move(trace_state), timeout);
+    return lookup_querier<querier>(_mutation_querier_index, key, s, range, slice, current_sem, std::move(trace_state), timeout, lookup_by_position::yes);
 }
 
 std::optional<shard_mutation_querier> querier_cache::lookup_shard_mutation_querier(query_id key,
@@ -426,7 +471,7 @@ std::optional<shard_mutation_querier> querier_cache::lookup_shard_mutation_queri
         tracing::trace_state_ptr trace_state,
         db::timeout_clock::time_point timeout) {
     return lookup_querier<shard_mutation_querier>(_shard_mutation_querier_index, key, s, ranges, slice, current_sem,
-            std::move(trace_state), timeout);
+            std::move(trace_state), timeout, lookup_by_position::no);
 }
 
 future<> querier_base::close() noexcept {
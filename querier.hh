@@ -13,6 +13,8 @@
 #include "mutation/mutation_compactor.hh"
 #include "reader_concurrency_semaphore.hh"
 #include "readers/mutation_source.hh"
+#include "readers/multi_range.hh"
+#include "readers/shared_scan.hh"
 #include "full_position.hh"
 
 #include <boost/intrusive/set.hpp>
@@ -93,6 +95,21 @@ class querier_base {
         , _qr_config(std::move(config))
     { }
 
+    // Reads all of `ranges` through a single reader, fast-forwarding it from
+    // one range to the next. The ranges have to be strictly monotonic and
+    // have to outlive the querier.
+    querier_base(schema_ptr schema, reader_permit permit, const dht::partition_range_vector& ranges,
+            query::partition_slice slice, const mutation_source& ms, tracing::trace_state_ptr trace_ptr,
+            querier_config config)
+        : _schema(std::move(schema))
+        , _permit(std::move(permit))
+        , _range(make_lw_shared<const dht::partition_range>(ranges.front().start(), ranges.back().end()))
+        , _slice(std::make_unique<const query::partition_slice>(std::move(slice)))
+        , _reader(make_flat_multi_range_reader(_schema, _permit, ms, ranges, *_slice, std::move(trace_ptr), mutation_reader::forwarding::no))
+        , _query_ranges(ranges)
+        , _qr_config(std::move(config))
+    { }
+
     querier_base(querier_base&&) = default;
     querier_base& operator=(querier_base&&) = default;
 
@@ -110,6 +127,10 @@ class querier_base {
         return _slice->is_reversed();
     }
 
+    const query::partition_slice& slice() const {
+        return *_slice;
+    }
+
     virtual std::optional<full_position_view> current_position() const = 0;
 
     dht::partition_ranges_view ranges() const {
@@ -165,6 +186,17 @@ class querier : public querier_base {
         , _compaction_state(make_lw_shared<compact_for_query_state_v2>(*schema, gc_clock::time_point{}, *_slice, 0, 0)) {
     }
 
+    querier(const mutation_source& ms,
+            schema_ptr schema,
+            reader_permit permit,
+            const dht::partition_range_vector& ranges,
+            query::partition_slice slice,
+            tracing::trace_state_ptr trace_ptr,
+            querier_config config = {})
+        : querier_base(schema, permit, ranges, std::move(slice), ms, std::move(trace_ptr), std::move(config))
+        , _compaction_state(make_lw_shared<compact_for_query_state_v2>(*schema, gc_clock::time_point{}, *_slice, 0, 0)) {
+    }
+
     bool are_limits_reached() const {
         return  _compaction_state->are_limits_reached();
     }
@@ -315,6 +347,9 @@ class querier_cache {
         // The number of queries dropped due to scheduling group mismatch
         // between semaphores
         uint64_t scheduling_group_mismatches = 0;
+        // The subset of lookups that missed by key, but found the querier of
+        // another query by position.
+        uint64_t position_hits = 0;
     };
 
     using index = std::unordered_multimap<query_id, std::unique_ptr<querier_base>>;
@@ -328,6 +363,8 @@ class querier_cache {
     stats _stats;
     gate _closing_gate;
     is_user_semaphore_func _is_user_semaphore_func;
+    shared_scan_registry _shared_scans;
+    utils::updateable_value<bool> _lookup_by_position{false};
 
 private:
     template <typename Querier>
@@ -339,6 +376,8 @@ class querier_cache {
             std::chrono::seconds ttl,
             tracing::trace_state_ptr trace_state);
 
+    using lookup_by_position = bool_class<class lookup_by_position_tag>;
+
     template <typename Querier>
     std::optional<Querier> lookup_querier(
         querier_cache::index& index,
@@ -348,7 +387,8 @@ class querier_cache {
         const query::partition_slice& slice,
         reader_concurrency_semaphore& current_sem,
         tracing::trace_state_ptr trace_state,
-        db::timeout_clock::time_point timeout);
+        db::timeout_clock::time_point timeout,
+        lookup_by_position by_position);
 
 public:
     querier_cache(is_user_semaphore_func is_user_semaphore_func, std::chrono::seconds entry_ttl = default_entry_ttl);
@@ -379,6 +419,12 @@ class querier_cache {
     /// The found querier is checked for a matching position and schema version.
     /// The start position of the querier is checked against the start position
     /// of the page using the `range' and `slice'.
+    ///
+    /// If lookup by position is enabled (see \ref set_lookup_by_position())
+    /// and there is no querier for `key`, e.g. because the page was sent by a
+    /// coordinator which didn't know the query id of the previous pages, the
+    /// querier of another query of the same table, with the same slice, whose
+    /// range and position match those of the page is used, if there is one.
     std::optional<querier> lookup_data_querier(query_id key,
             const schema& s,
             const dht::partition_range& range,
@@ -400,7 +446,9 @@ class querier_cache {
 
     /// Lookup a shard mutation querier in the cache.
     ///
-    /// See \ref lookup_data_querier().
+    /// See \ref lookup_data_querier(). Only `key` is used for finding the
+    /// querier: the queriers of the shards of a multishard read have to belong
+    /// to the same query.
     std::optional<shard_mutation_querier> lookup_shard_mutation_querier(query_id key,
             const schema& s,
             const dht::partition_range_vector& ranges,
@@ -414,6 +462,13 @@ class querier_cache {
     /// Applies only to entries inserted after the change.
     void set_entry_ttl(std::chrono::seconds entry_ttl);
 
+    /// Enable looking up queriers by position on a miss by key.
+    ///
+    /// See \ref lookup_data_querier().
+    void set_lookup_by_position(utils::updateable_value<bool> enabled) {
+        _lookup_by_position = std::move(enabled);
+    }
+
     /// Evict a querier.
     ///
     /// Return true if a querier was evicted and false otherwise (if the cache
@@ -428,6 +483,19 @@ class querier_cache {
     const stats& get_stats() const {
         return _stats;
     }
+
+    /// The shared scans of the shard.
+    ///
+    /// The readers of shared scans are saved in the cache between pages like
+    /// any other, the registry only keeps track of the shared scans which can
+    /// still be joined.
+    shared_scan_registry& get_shared_scans() noexcept {
+        return _shared_scans;
+    }
+
+    const shared_scan_registry& get_shared_scans() const noexcept {
+        return _shared_scans;
+    }
 };
 
 } // namespace query
@@ -175,6 +175,9 @@ class partition_slice {
         // is a lot of dead rows. This flag is needed during rolling upgrades to support
         // old coordinators which do not tolerate pages with no live rows.
         allow_mutation_read_page_without_live_row,
+        // The read must be served by the cache alone: a replica which would
+        // have to read sstables fails it with replica::not_cached_exception.
+        cache_only,
     };
     using option_set = enum_set<super_enum<option,
         option::send_clustering_key,
@@ -190,7 +193,8 @@ class partition_slice {
         option::bypass_cache,
         option::always_return_static_content,
         option::range_scan_data_variant,
-        option::allow_mutation_read_page_without_live_row>>;
+        option::allow_mutation_read_page_without_live_row,
+        option::cache_only>>;
     clustering_row_ranges _row_ranges;
 public:
     column_id_vector static_columns; // TODO: consider using bitmap
@@ -150,6 +150,9 @@ class reader_permit::impl
         // Must be cleared on all code-paths, otherwise it will keep the permit alive in perpetuity.
         reader_permit_opt permit_keepalive;
         std::optional<reader_concurrency_semaphore::inactive_read> ir;
+        reader_concurrency_semaphore::admission_hints hints;
+        // Permits in the admission queue are ordered by this, see enqueue_waiter().
+        std::chrono::steady_clock::time_point admission_key;
     };
 
 private:
@@ -173,27 +176,63 @@ class reader_permit::impl
     size_t _requested_memory = 0;
     uint64_t _oom_kills = 0;
     tracing::trace_state_ptr _trace_ptr;
+    // Start of the current wait on the semaphore and of the current need_cpu
+    // (but not awaits) period, when traced, for accounting their time to the
+    // read_cost of the trace session.
+    std::chrono::steady_clock::time_point _semaphore_wait_start;
+    std::chrono::steady_clock::time_point _need_cpu_start;
 
     // Not strictly related to the permit.
     // Used by the semaphore to to manage the permit.
     auxiliary_data _aux_data;
 
 private:
+    void start_cost_timer(std::chrono::steady_clock::time_point& start) noexcept {
+        if (_trace_ptr) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+    void stop_cost_timer(std::chrono::steady_clock::time_point& start, std::chrono::microseconds tracing::read_cost::* counter) noexcept {
+        if (start == std::chrono::steady_clock::time_point{}) {
+            return;
+        }
+        if (_trace_ptr) {
+            _trace_ptr->get_read_cost().*counter += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        }
+        start = {};
+    }
+    void start_semaphore_wait() noexcept {
+        start_cost_timer(_semaphore_wait_start);
+    }
+    void stop_semaphore_wait() noexcept {
+        stop_cost_timer(_semaphore_wait_start, &tracing::read_cost::semaphore_wait_time);
+    }
+    void start_need_cpu() noexcept {
+        start_cost_timer(_need_cpu_start);
+    }
+    void stop_need_cpu() noexcept {
+        stop_cost_timer(_need_cpu_start, &tracing::read_cost::need_cpu_time);
+    }
+
     void on_permit_need_cpu() {
         _semaphore.on_permit_need_cpu();
         _marked_as_need_cpu = true;
+        start_need_cpu();
     }
     void on_permit_not_need_cpu() {
         _semaphore.on_permit_not_need_cpu();
         _marked_as_need_cpu = false;
+        stop_need_cpu();
     }
     void on_permit_awaits() {
         _semaphore.on_permit_awaits();
         _marked_as_awaits = true;
+        stop_need_cpu();
     }
     void on_permit_not_awaits() {
         _semaphore.on_permit_not_awaits();
         _marked_as_awaits = false;
+        start_need_cpu();
     }
     void on_permit_active() {
         if (_need_cpu_branches) {
@@ -228,6 +267,7 @@ class reader_permit::impl
 
         auto ex = named_semaphore_timed_out(_semaphore._name);
         _ex = std::make_exception_ptr(ex);
+        stop_semaphore_wait();
 
         switch (_state) {
             case state::waiting_for_admission:
@@ -334,20 +374,28 @@ class reader_permit::impl
         return _aux_data;
     }
 
+    const auxiliary_data& aux_data() const {
+        return _aux_data;
+    }
+
     void on_waiting_for_admission() {
         on_permit_inactive(reader_permit::state::waiting_for_admission);
+        start_semaphore_wait();
     }
 
     void on_waiting_for_memory() {
         on_permit_inactive(reader_permit::state::waiting_for_memory);
+        start_semaphore_wait();
     }
 
     void on_waiting_for_execution() {
         on_permit_inactive(reader_permit::state::waiting_for_execution);
+        start_semaphore_wait();
     }
 
     void on_admission() {
         SCYLLA_ASSERT(_state != reader_permit::state::active_await);
+        stop_semaphore_wait();
         on_permit_active();
         consume(_base_resources);
         _base_resources_consumed = true;
@@ -355,12 +403,14 @@ class reader_permit::impl
 
     void on_granted_memory() {
         if (_state == reader_permit::state::waiting_for_memory) {
+            stop_semaphore_wait();
             on_permit_active();
         }
         consume({0, std::exchange(_requested_memory, 0)});
     }
 
     void on_executing() {
+        stop_semaphore_wait();
         on_permit_active();
     }
 
@@ -495,7 +545,16 @@ class reader_permit::impl
             // Create a continuation trace point
             tracing::trace(trace_ptr, "Continuing paged query, previous page's trace session is {}", _trace_ptr->session_id());
         }
+        const bool in_need_cpu = _need_cpu_start != std::chrono::steady_clock::time_point{};
+        stop_need_cpu();
         _trace_ptr = std::move(trace_ptr);
+        if (in_need_cpu) {
+            start_need_cpu();
+        }
+    }
+
+    tracing::read_cost* read_cost() const noexcept {
+        return _trace_ptr ? &_trace_ptr->get_read_cost() : nullptr;
     }
 
     void check_abort() {
@@ -659,6 +718,10 @@ void reader_permit::set_max_result_size(query::max_result_size s) {
     _impl->set_max_result_size(std::move(s));
 }
 
+tracing::read_cost* reader_permit::read_cost() const noexcept {
+    return _impl->read_cost();
+}
+
 void reader_permit::on_start_sstable_read() noexcept {
     _impl->on_start_sstable_read();
 }
@@ -845,6 +908,8 @@ static void do_dump_reader_permit_diagnostics(std::ostream& os, const reader_con
             "reads_queued_because_memory_resources: {}\n"
             "reads_queued_because_count_resources: {}\n"
             "reads_queued_with_eviction: {}\n"
+            "reads_admitted_via_cache_lane: {}\n"
+            "reads_queued_ahead_by_io_cost: {}\n"
             "total_permits: {}\n"
             "current_permits: {}\n"
             "need_cpu_permits: {}\n"
@@ -867,6 +932,8 @@ static void do_dump_reader_permit_diagnostics(std::ostream& os, const reader_con
             stats.reads_queued_because_memory_resources,
             stats.reads_queued_because_count_resources,
             stats.reads_queued_with_eviction,
+            stats.reads_admitted_via_cache_lane,
+            stats.reads_queued_ahead_by_io_cost,
             stats.total_permits,
             stats.current_permits,
             stats.need_cpu_permits,
@@ -928,9 +995,22 @@ reader_concurrency_semaphore::inactive_read_handle::operator=(inactive_read_hand
     return *this;
 }
 
-void reader_concurrency_semaphore::wait_queue::push_to_admission_queue(reader_permit::impl& p) {
+bool reader_concurrency_semaphore::wait_queue::push_to_admission_queue(reader_permit::impl& p) {
+    p.unlink();
+    // The queue is ordered by the admission key. Keys are mostly increasing,
+    // so look for the place of the permit from the back.
+    auto it = _admission_queue.end();
+    while (it != _admission_queue.begin() && std::prev(it)->aux_data().admission_key > p.aux_data().admission_key) {
+        --it;
+    }
+    const bool ahead = it != _admission_queue.end();
+    _admission_queue.insert(it, p);
+    return ahead;
+}
+
+void reader_concurrency_semaphore::wait_queue::push_to_cache_admission_queue(reader_permit::impl& p) {
     p.unlink();
-    _admission_queue.push_back(p);
+    _cache_admission_queue.push_back(p);
 }
 
 void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permit::impl& p) {
@@ -939,10 +1019,12 @@ void reader_concurrency_semaphore::wait_queue::push_to_memory_queue(reader_permi
 }
 
 reader_permit::impl& reader_concurrency_semaphore::wait_queue::front() {
-    if (_memory_queue.empty()) {
-        return _admission_queue.front();
-    } else {
+    if (!_memory_queue.empty()) {
         return _memory_queue.front();
+    } else if (!_cache_admission_queue.empty()) {
+        return _cache_admission_queue.front();
+    } else {
+        return _admission_queue.front();
     }
 }
 
@@ -1080,6 +1162,14 @@ reader_concurrency_semaphore::reader_concurrency_semaphore(
                                                " When the queue is full, excessive reads are shed to avoid overload."),
                                {class_label(_name)}),
 
+                sm::make_counter("reads_admitted_via_cache_lane", _stats.reads_admitted_via_cache_lane,
+                               sm::description("Counts the number of reads admitted via the cache lane, without waiting for count resources."),
+                               {class_label(_name)}),
+
+                sm::make_counter("reads_queued_ahead_by_io_cost", _stats.reads_queued_ahead_by_io_cost,
+                               sm::description("Counts the number of reads queued for admission ahead of reads queued before them, due to their lower estimated I/O cost."),
+                               {class_label(_name)}),
+
                 sm::make_gauge("disk_reads", _stats.disk_reads,
                                sm::description("Holds the number of currently active disk read operations. "),
                                {class_label(_name)}),
@@ -1340,7 +1430,14 @@ future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit::impl& permi
     auto fut = ad.pr.get_future();
     if (wait == wait_on::admission) {
         permit.on_waiting_for_admission();
-        _wait_list.push_to_admission_queue(permit);
+        if (ad.hints.lane == admission_lane::cache) {
+            _wait_list.push_to_cache_admission_queue(permit);
+        } else {
+            // Each unit of I/O cost delays the read, as if it was queued later.
+            // With no delay this is FIFO order.
+            ad.admission_key = std::chrono::steady_clock::now() + std::chrono::microseconds(uint64_t(_io_cost_delay_us()) * ad.hints.io_cost);
+            _stats.reads_queued_ahead_by_io_cost += _wait_list.push_to_admission_queue(permit);
+        }
         ++_stats.reads_enqueued_for_admission;
     } else {
         permit.on_waiting_for_memory();
@@ -1406,6 +1503,17 @@ reader_concurrency_semaphore::can_admit_read(const reader_permit::impl& permit)
         return {can_admit::no, reason::need_cpu_permits};
     }
 
+    if (permit.aux_data().hints.lane == admission_lane::cache) {
+        // Count resources are not considered, these are what the reads going
+        // to disk hold, while they wait for it. Special case: when no memory
+        // is consumed, admit the read regardless of its estimate, like
+        // has_available_units() does.
+        if (_resources.memory < permit.base_resources().memory && _resources.memory != _initial_resources.memory) {
+            return {_inactive_reads.empty() ? can_admit::no : can_admit::maybe, reason::memory_resources};
+        }
+        return {can_admit::yes, reason::all_ok};
+    }
+
     if (!has_available_units(permit.base_resources())) {
         auto reason = _resources.memory >= permit.base_resources().memory ? reason::count_resources : reason::memory_resources;
         if (_inactive_reads.empty()) {
@@ -1453,9 +1561,13 @@ future<> reader_concurrency_semaphore::do_wait_admission(reader_permit::impl& pe
     const auto [admit, why] = can_admit_read(permit);
     ++(_stats.*stats_table[static_cast<int>(why)]);
     tracing::trace(permit.trace_state(), "[reader concurrency semaphore {}] {}", _name, result_as_string[static_cast<int>(why)]);
-    if (admit != can_admit::yes || !_wait_list.empty()) {
+    // Permits of the cache lane only queue behind permits of the cache lane
+    // and those waiting for memory.
+    const bool cache_lane = permit.aux_data().hints.lane == admission_lane::cache;
+    const bool has_waiters_ahead = cache_lane ? _wait_list.has_waiters_ahead_of_cache_lane() : !_wait_list.empty();
+    if (admit != can_admit::yes || has_waiters_ahead) {
         auto fut = enqueue_waiter(permit, wait_on::admission);
-        if (admit == can_admit::yes && !_wait_list.empty()) {
+        if (admit == can_admit::yes && has_waiters_ahead) {
             // This is a contradiction: the semaphore could admit waiters yet it has waiters.
             // Normally, the semaphore should admit waiters as soon as it can.
             // So at any point in time, there should either be no waiters, or it
@@ -1472,6 +1584,7 @@ future<> reader_concurrency_semaphore::do_wait_admission(reader_permit::impl& pe
 
     permit.on_admission();
     ++_stats.reads_admitted;
+    _stats.reads_admitted_via_cache_lane += cache_lane;
     if (permit.aux_data().func) {
         return with_ready_permit(permit);
     }
@@ -1490,6 +1603,7 @@ void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
             } else {
                 permit.on_admission();
                 ++_stats.reads_admitted;
+                _stats.reads_admitted_via_cache_lane += permit.aux_data().hints.lane == admission_lane::cache;
             }
             if (permit.aux_data().func) {
                 permit.unlink();
@@ -1592,17 +1706,24 @@ void reader_concurrency_semaphore::on_permit_not_awaits() noexcept {
     --_stats.awaits_permits;
 }
 
+// Permits of the cache lane don't consume count resources.
+static reader_resources base_resources_for(const reader_concurrency_semaphore::admission_hints& hints, size_t memory) {
+    return {hints.lane == reader_concurrency_semaphore::admission_lane::cache ? 0 : 1, static_cast<ssize_t>(memory)};
+}
+
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(schema_ptr schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
-    auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, admission_hints hints) {
+    auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), base_resources_for(hints, memory), timeout, std::move(trace_ptr));
+    permit->aux_data().hints = hints;
     return do_wait_admission(*permit).then([permit] () mutable {
         return std::move(permit);
     });
 }
 
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr) {
-    auto permit = reader_permit(*this, std::move(schema), std::move(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, admission_hints hints) {
+    auto permit = reader_permit(*this, std::move(schema), std::move(op_name), base_resources_for(hints, memory), timeout, std::move(trace_ptr));
+    permit->aux_data().hints = hints;
     return do_wait_admission(*permit).then([permit] () mutable {
         return std::move(permit);
     });
@@ -1619,8 +1740,9 @@ reader_permit reader_concurrency_semaphore::make_tracking_only_permit(schema_ptr
 }
 
 future<> reader_concurrency_semaphore::with_permit(schema_ptr schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func) {
-    auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout, std::move(trace_ptr));
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func, admission_hints hints) {
+    auto permit = reader_permit(*this, std::move(schema), std::string_view(op_name), base_resources_for(hints, memory), timeout, std::move(trace_ptr));
+    permit->aux_data().hints = hints;
     permit->aux_data().func = std::move(func);
     permit->aux_data().permit_keepalive = permit;
     return do_wait_admission(*permit);
@@ -1690,12 +1812,33 @@ void reader_concurrency_semaphore::foreach_permit(noncopyable_function<void(cons
 class tracking_file_impl : public file_impl {
     file _tracked_file;
     reader_permit _permit;
+    tracked_file_kind _kind;
+
+    void account_read(size_t size) noexcept {
+        auto* cost = _permit.read_cost();
+        if (!cost) {
+            return;
+        }
+        switch (_kind) {
+        case tracked_file_kind::data:
+            ++cost->data_reads;
+            cost->data_bytes_read += size;
+            break;
+        case tracked_file_kind::index:
+            ++cost->index_reads;
+            cost->index_bytes_read += size;
+            break;
+        case tracked_file_kind::other:
+            break;
+        }
+    }
 
 public:
-    tracking_file_impl(file file, reader_permit permit)
+    tracking_file_impl(file file, reader_permit permit, tracked_file_kind kind)
         : file_impl(*get_file_impl(file))
         , _tracked_file(std::move(file))
-        , _permit(std::move(permit)) {
+        , _permit(std::move(permit))
+        , _kind(kind) {
     }
 
     tracking_file_impl(const tracking_file_impl&) = delete;
@@ -1757,13 +1900,14 @@ class tracking_file_impl : public file_impl {
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent* intent) override {
         return _permit.request_memory(range_size).then([this, offset, range_size, intent] (reader_permit::resource_units units) {
-            return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, intent).then([units = std::move(units)] (temporary_buffer<uint8_t> buf) mutable {
+            return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, intent).then([this, units = std::move(units)] (temporary_buffer<uint8_t> buf) mutable {
+                account_read(buf.size());
                 return make_ready_future<temporary_buffer<uint8_t>>(make_tracked_temporary_buffer(std::move(buf), std::move(units)));
             });
         });
     }
 };
 
-file make_tracked_file(file f, reader_permit p) {
-    return file(make_shared<tracking_file_impl>(f, std::move(p)));
+file make_tracked_file(file f, reader_permit p, tracked_file_kind kind) {
+    return file(make_shared<tracking_file_impl>(f, std::move(p), kind));
 }
@@ -63,10 +63,39 @@ using mutation_reader_opt = optimized_optional<mutation_reader>;
 /// The semaphore also acts as an execution stage for reads. This
 /// functionality is exposed via \ref with_permit() and \ref
 /// with_ready_permit().
+///
+/// Reads known to be served from memory (e.g. from the row cache) can be
+/// admitted via the cache lane (see \ref admission_lane). Such reads don't
+/// consume count resources and are admitted ahead of, and regardless of, the
+/// reads waiting for count resources. So when the count resources are held by
+/// reads stalled on disk, reads served from memory don't queue behind them.
+/// They are still subject to the memory limits and to the CPU concurrency
+/// limit.
+///
+/// Reads waiting for admission can be ordered by their estimated I/O cost
+/// (see \ref admission_hints::io_cost), so that under overload many cheap
+/// reads complete instead of a few expensive ones. Each unit of cost delays a
+/// read in the admission queue by the configured delay, measured from when it
+/// was queued (see \ref set_io_cost_delay()). This ages the expensive reads:
+/// once they waited for long enough, they are admitted ahead of the cheap ones
+/// queued after them, so they don't starve. With a delay of 0 (the default),
+/// reads are admitted in FIFO order.
 class reader_concurrency_semaphore {
 public:
     using resources = reader_resources;
 
+    enum class admission_lane {
+        disk, // the read may go to disk, admitted by count and memory
+        cache, // the read is known to be served from memory, admitted by memory only
+    };
+
+    /// What the creator of a permit knows about the read, used by admission.
+    struct admission_hints {
+        admission_lane lane = admission_lane::disk;
+        // The estimated disk I/O of the read, in page reads.
+        uint64_t io_cost = 0;
+    };
+
     friend class reader_permit;
 
     enum class evict_reason {
@@ -110,6 +139,10 @@ class reader_concurrency_semaphore {
         uint64_t reads_queued_because_count_resources = 0;
         // Total number of reads enqueued to be maybe admitted after evicting some inactive reads
         uint64_t reads_queued_with_eviction = 0;
+        // Total number of reads admitted via the cache lane.
+        uint64_t reads_admitted_via_cache_lane = 0;
+        // Total number of reads queued for admission ahead of reads queued before them, due to their lower I/O cost.
+        uint64_t reads_queued_ahead_by_io_cost = 0;
         // Total number of permits created so far.
         uint64_t total_permits = 0;
         // Current number of permits.
@@ -166,13 +199,22 @@ class reader_concurrency_semaphore {
     struct wait_queue {
         // Stores entries for permits waiting to be admitted.
         permit_list_type _admission_queue;
+        // Stores entries for permits waiting to be admitted via the cache lane.
+        // These are admitted before those in _admission_queue.
+        permit_list_type _cache_admission_queue;
         // Stores entries for serialized permits waiting to obtain memory.
         permit_list_type _memory_queue;
     public:
         bool empty() const {
-            return _admission_queue.empty() && _memory_queue.empty();
+            return _admission_queue.empty() && _cache_admission_queue.empty() && _memory_queue.empty();
         }
-        void push_to_admission_queue(reader_permit::impl& p);
+        // Are there waiters that a cache lane permit has to queue behind?
+        bool has_waiters_ahead_of_cache_lane() const {
+            return !_cache_admission_queue.empty() || !_memory_queue.empty();
+        }
+        // Returns whether p was queued ahead of permits already in the queue.
+        bool push_to_admission_queue(reader_permit::impl& p);
+        void push_to_cache_admission_queue(reader_permit::impl& p);
         void push_to_memory_queue(reader_permit::impl& p);
         reader_permit::impl& front();
         const reader_permit::impl& front() const;
@@ -190,6 +232,7 @@ class reader_concurrency_semaphore {
     utils::updateable_value<uint32_t> _serialize_limit_multiplier;
     utils::updateable_value<uint32_t> _kill_limit_multiplier;
     utils::updateable_value<uint32_t> _cpu_concurrency;
+    utils::updateable_value<uint32_t> _io_cost_delay_us{0};
     stats _stats;
     std::optional<seastar::metrics::metric_groups> _metrics;
     bool _stopped = false;
@@ -418,8 +461,13 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<reader_permit> obtain_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
-    future<reader_permit> obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr);
+    ///
+    /// Pass admission_lane::cache in the hints only for reads known to be
+    /// served from memory, see \ref admission_lane.
+    future<reader_permit> obtain_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            admission_hints hints = {});
+    future<reader_permit> obtain_permit(schema_ptr schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr,
+            admission_hints hints = {});
 
     /// Make a tracking only permit
     ///
@@ -456,7 +504,11 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<> with_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func);
+    ///
+    /// Pass admission_lane::cache in the hints only for reads known to be
+    /// served from memory, see \ref admission_lane.
+    future<> with_permit(schema_ptr schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, tracing::trace_state_ptr trace_ptr, read_func func,
+            admission_hints hints = {});
 
     /// Run the function through the semaphore's execution stage with a pre-admitted permit
     ///
@@ -497,6 +549,12 @@ class reader_concurrency_semaphore {
     /// Use 0 for unlimited.
     std::string dump_diagnostics(unsigned max_lines = 0) const;
 
+    /// Set by how much each unit of estimated I/O cost delays a read waiting
+    /// for admission, in microseconds. See \ref admission_hints::io_cost.
+    void set_io_cost_delay(utils::updateable_value<uint32_t> delay_us) {
+        _io_cost_delay_us = std::move(delay_us);
+    }
+
     void set_max_queue_length(size_t size) {
         _max_queue_length = size;
     }
@@ -182,6 +182,11 @@ class reader_permit {
     void on_start_sstable_read() noexcept;
     void on_finish_sstable_read() noexcept;
 
+    /// The read_cost of the trace session of the read, if it is traced.
+    ///
+    /// The resources used by the read are accounted to it.
+    tracing::read_cost* read_cost() const noexcept;
+
     uintptr_t id() { return reinterpret_cast<uintptr_t>(_impl.get()); }
 };
 
@@ -269,7 +274,15 @@ inline temporary_buffer<char> make_new_tracked_temporary_buffer(size_t size, rea
     return temporary_buffer<char>(buf.get_write(), buf.size(), make_object_deleter(buf.release(), permit.consume_memory(size)));
 }
 
-file make_tracked_file(file f, reader_permit p);
+/// The kind of a tracked file, for accounting the reads from it to the
+/// read_cost of the permit.
+enum class tracked_file_kind {
+    data,
+    index,
+    other,
+};
+
+file make_tracked_file(file f, reader_permit p, tracked_file_kind kind = tracked_file_kind::other);
 
 class tracking_allocator_base {
     reader_permit _permit;
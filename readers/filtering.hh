@@ -33,6 +33,8 @@ class filtering_reader : public mutation_reader::impl {
                         }
                     }
                     push_mutation_fragment(std::move(mf));
+                    // The rest of the partition passes the filter too.
+                    _rd.move_buffer_content_to(*this, std::mem_fn(&mutation_fragment_v2::is_partition_start));
                     return make_ready_future<>();
                 }).then([this] {
                     _end_of_stream = _rd.is_end_of_stream();
@@ -705,9 +705,14 @@ class shard_reader_v2 : public mutation_reader::impl {
     const mutation_reader::forwarding _fwd_mr;
     std::optional<future<>> _read_ahead;
     foreign_ptr<std::unique_ptr<evictable_reader_v2>> _reader;
+    // Number of buffers filled on the remote shard by each fill, see adjust_buffer_depth().
+    unsigned _buffer_depth = 1;
+
+    static constexpr unsigned max_buffer_depth = 16;
 
 private:
     future<> do_fill_buffer();
+    void adjust_buffer_depth(bool waited_for_read_ahead);
 
 public:
     shard_reader_v2(
@@ -791,6 +796,32 @@ future<> shard_reader_v2::close() noexcept {
     }
 }
 
+// Fills up to depth buffers of the remote reader in one go.
+// Deeper fills stop early when the semaphore of the remote shard is low on memory,
+// so the read-ahead of large scans doesn't crowd out other reads on that shard.
+static future<> fill_remote_buffer(evictable_reader_v2& reader, unsigned depth) {
+    co_await reader.fill_buffer();
+    auto& semaphore = reader.permit().semaphore();
+    for (unsigned i = 1; i < depth && !reader.is_end_of_stream(); ++i) {
+        if (semaphore.available_resources().memory < semaphore.initial_resources().memory / 2) {
+            break;
+        }
+        co_await reader.fill_buffer();
+    }
+}
+
+// Adapts the depth of remote fills to the rate at which the buffers are consumed.
+// If the consumer had to wait for the read-ahead, the shard doesn't keep up and
+// the depth is doubled. Otherwise it decays slowly, settling around the depth
+// at which read-aheads complete just in time.
+void shard_reader_v2::adjust_buffer_depth(bool waited_for_read_ahead) {
+    if (waited_for_read_ahead) {
+        _buffer_depth = std::min(_buffer_depth * 2, max_buffer_depth);
+    } else if (_buffer_depth > 1) {
+        --_buffer_depth;
+    }
+}
+
 future<> shard_reader_v2::do_fill_buffer() {
     struct reader_and_buffer_fill_result {
         foreign_ptr<std::unique_ptr<evictable_reader_v2>> reader;
@@ -799,7 +830,7 @@ future<> shard_reader_v2::do_fill_buffer() {
 
     auto res = co_await std::invoke([&] () -> future<remote_fill_buffer_result_v2> {
         if (!_reader) {
-            reader_and_buffer_fill_result res = co_await smp::submit_to(_shard, coroutine::lambda([this, gs = global_schema_ptr(_schema)] () -> future<reader_and_buffer_fill_result> {
+            reader_and_buffer_fill_result res = co_await smp::submit_to(_shard, coroutine::lambda([this, gs = global_schema_ptr(_schema), depth = _buffer_depth] () -> future<reader_and_buffer_fill_result> {
                 auto ms = mutation_source([lifecycle_policy = _lifecycle_policy.get()] (
                             schema_ptr s,
                             reader_permit permit,
@@ -843,7 +874,7 @@ future<> shard_reader_v2::do_fill_buffer() {
                 try {
                     tracing::trace(_trace_state, "Creating shard reader on shard: {}", this_shard_id());
                     reader_permit::need_cpu_guard ncpu_guard{rreader->permit()};
-                    co_await rreader->fill_buffer();
+                    co_await fill_remote_buffer(*rreader, depth);
                     auto res = remote_fill_buffer_result_v2(rreader->detach_buffer(), rreader->is_end_of_stream());
                     co_return reader_and_buffer_fill_result{std::move(rreader), std::move(res)};
                 } catch (...) {
@@ -855,9 +886,9 @@ future<> shard_reader_v2::do_fill_buffer() {
             _reader = std::move(res.reader);
             co_return std::move(res.result);
         } else {
-            co_return co_await smp::submit_to(_shard, coroutine::lambda([this] () -> future<remote_fill_buffer_result_v2>  {
+            co_return co_await smp::submit_to(_shard, coroutine::lambda([this, depth = _buffer_depth] () -> future<remote_fill_buffer_result_v2>  {
                 reader_permit::need_cpu_guard ncpu_guard{_reader->permit()};
-                co_await _reader->fill_buffer();
+                co_await fill_remote_buffer(*_reader, depth);
                 co_return remote_fill_buffer_result_v2(_reader->detach_buffer(), _reader->is_end_of_stream());
             }));
         }
@@ -875,7 +906,9 @@ future<> shard_reader_v2::fill_buffer() {
     // FIXME: want to move this to the inner scopes but it makes clang miscompile the code.
     reader_permit::awaits_guard guard(_permit);
     if (_read_ahead) {
+        const bool waited = !_read_ahead->available();
         co_await *std::exchange(_read_ahead, std::nullopt);
+        adjust_buffer_depth(waited);
         co_return;
     }
     if (!is_buffer_empty()) {
@@ -1001,15 +1034,19 @@ void multishard_combining_reader_v2::on_partition_range_change(const dht::partit
     auto token = pr.start() ? pr.start()->value().token() : dht::minimum_token();
     _current_shard = _sharder.shard_for_reads(token);
 
-    auto sharder = dht::ring_position_range_sharder(_sharder, pr);
-
-    auto next = sharder.next(*_schema);
-
-    // The first value of `next` is thrown away, as it is the ring range of the current shard.
+    // Walk the shard boundaries within the range, as ring_position_range_sharder
+    // would, but without building the sub-ranges, as only the first token
+    // of each shard is needed.
     // We only want to do a full round, until we get back to the shard we started from (`_current_shard`).
-    // We stop earlier if the sharder has no ranges for the remaining shards.
-    for (next = sharder.next(*_schema); next && next->shard != _current_shard; next = sharder.next(*_schema)) {
-        _shard_selection_min_heap.push_back(shard_and_token{next->shard, next->ring_range.start()->value().token()});
+    // We stop earlier if the range ends before the boundary of the next shard.
+    auto in_range = [&] (const dht::token& boundary) {
+        return !boundary.is_maximum()
+                && (!pr.end() || dht::ring_position::starting_at(boundary).less_compare(*_schema, pr.end()->value()));
+    };
+    for (auto next = _sharder.next_shard_for_reads(token);
+            next && in_range(next->token) && next->shard != _current_shard;
+            next = _sharder.next_shard_for_reads(next->token)) {
+        _shard_selection_min_heap.push_back(*next);
         boost::push_heap(_shard_selection_min_heap);
     }
 }
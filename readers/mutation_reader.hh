@@ -377,6 +377,30 @@ class mutation_reader final {
             }
         }
 
+        // Moves the fragments at the front of the buffer to `other`, up to the
+        // first one for which stop() returns true, or to the end of the buffer.
+        // Returns true iff stopped at a fragment.
+        //
+        // Cheaper than popping and pushing the fragments one by one, as the
+        // memory usage of each fragment is computed once and the buffer of
+        // `other` grows once.
+        template <typename StopPredicate>
+        requires std::is_invocable_r_v<bool, StopPredicate, const mutation_fragment_v2&>
+        bool move_buffer_content_to(impl& other, StopPredicate&& stop) {
+            auto end = std::find_if(_buffer.begin(), _buffer.end(), stop);
+            auto n = std::distance(_buffer.begin(), end);
+            seastar::memory::on_alloc_point(); // for exception safety tests
+            other._buffer.reserve(other._buffer.size() + n);
+            for (auto it = _buffer.begin(); it != end; ++it) {
+                auto memory_usage = it->memory_usage();
+                other._buffer.emplace_back(std::move(*it));
+                other._buffer_size += memory_usage;
+                _buffer_size -= memory_usage;
+            }
+            _buffer.erase(_buffer.begin(), end);
+            return !_buffer.empty();
+        }
+
         void check_abort() {
             _permit.check_abort();
         }
@@ -636,6 +660,13 @@ class mutation_reader final {
     void move_buffer_content_to(impl& other) {
         _impl->move_buffer_content_to(other);
     }
+    // Moves the fragments at the front of the buffer to `other`, up to the
+    // first one for which stop() returns true. See impl::move_buffer_content_to().
+    template <typename StopPredicate>
+    requires std::is_invocable_r_v<bool, StopPredicate, const mutation_fragment_v2&>
+    bool move_buffer_content_to(impl& other, StopPredicate&& stop) {
+        return _impl->move_buffer_content_to(other, std::forward<StopPredicate>(stop));
+    }
 
     // Causes this reader to conform to s.
     // Multiple calls of upgrade_schema() compose, effects of prior calls on the stream are preserved.
@@ -525,9 +525,7 @@ class flat_multi_range_mutation_reader : public mutation_reader::impl {
     virtual future<> fill_buffer() override {
         return do_until([this] { return is_end_of_stream() || !is_buffer_empty(); }, [this] {
             return _reader.fill_buffer().then([this] () {
-                while (!_reader.is_buffer_empty()) {
-                    push_mutation_fragment(_reader.pop_mutation_fragment());
-                }
+                _reader.move_buffer_content_to(*this);
                 if (!_reader.is_end_of_stream()) {
                     return make_ready_future<>();
                 }
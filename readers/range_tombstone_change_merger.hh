@@ -36,17 +36,35 @@ class range_tombstone_change_merger {
 private:
     std::vector<stream_tombstone> _tombstones;
     tombstone _current_tombstone;
+    // The max of the tombstones of the streams, valid if _max_tombstone_valid.
+    // Most changes don't lower the max, so it is kept up to date by apply()
+    // and recomputed only when the stream holding it is lowered or removed,
+    // instead of scanning all the streams on every change.
+    mutable tombstone _max_tombstone;
+    mutable bool _max_tombstone_valid = true;
 
 private:
-    const stream_tombstone* get_tombstone() const {
-        const stream_tombstone* max_tomb{nullptr};
-
-        for (const auto& tomb : _tombstones) {
-            if (!max_tomb || tomb.tombstone > max_tomb->tombstone) {
-                max_tomb = &tomb;
+    tombstone max_tombstone() const {
+        if (!_max_tombstone_valid) {
+            _max_tombstone = {};
+            for (const auto& tomb : _tombstones) {
+                _max_tombstone = std::max(_max_tombstone, tomb.tombstone);
             }
+            _max_tombstone_valid = true;
+        }
+        return _max_tombstone;
+    }
+
+    void on_lowered(tombstone old_tomb) {
+        if (old_tomb == _max_tombstone) {
+            _max_tombstone_valid = false;
+        }
+    }
+
+    void on_raised(tombstone new_tomb) {
+        if (_max_tombstone_valid && new_tomb > _max_tombstone) {
+            _max_tombstone = new_tomb;
         }
-        return max_tomb;
     }
 
 public:
@@ -57,11 +75,17 @@ class range_tombstone_change_merger {
         if (it == _tombstones.end()) {
             if (tomb) {
                 _tombstones.push_back({stream_id, tomb});
+                on_raised(tomb);
             }
         } else {
             if (tomb) {
+                if (tomb < it->tombstone) {
+                    on_lowered(it->tombstone);
+                }
                 it->tombstone = tomb;
+                on_raised(tomb);
             } else {
+                on_lowered(it->tombstone);
                 auto last = _tombstones.end() - 1;
                 if (it != last) {
                     std::swap(*it, *last);
@@ -72,26 +96,23 @@ class range_tombstone_change_merger {
     }
 
     std::optional<tombstone> get() {
-        const auto* tomb = get_tombstone();
-        if (tomb && tomb->tombstone == _current_tombstone) {
+        const auto tomb = max_tombstone();
+        if (tomb && tomb == _current_tombstone) {
             return {};
         } else {
-            _current_tombstone = tomb ? tomb->tombstone : tombstone();
+            _current_tombstone = tomb;
             return _current_tombstone;
         }
     }
 
     tombstone peek() const {
-        const stream_tombstone* tomb = get_tombstone();
-        if (tomb) {
-            return tomb->tombstone;
-        } else {
-            return {};
-        }
+        return max_tombstone();
     }
 
     void clear() {
         _tombstones.clear();
         _current_tombstone = {};
+        _max_tombstone = {};
+        _max_tombstone_valid = true;
     }
 };
@@ -0,0 +1,414 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <deque>
+
+#include <seastar/core/condition-variable.hh>
+#include <seastar/coroutine/as_future.hh>
+#include <seastar/coroutine/exception.hh>
+
+#include "readers/empty_v2.hh"
+#include "readers/mutation_source.hh"
+#include "readers/shared_scan.hh"
+#include "reader_concurrency_semaphore.hh"
+#include "query-request.hh"
+
+static bool same_slice(const schema& s, const query::partition_slice& a, const query::partition_slice& b) {
+    auto cmp = clustering_key_prefix::prefix_equal_tri_compare(s);
+    auto same_range = [&cmp] (const query::clustering_range& x, const query::clustering_range& y) {
+        return x.equal(y, cmp);
+    };
+    return !a.get_specific_ranges() && !b.get_specific_ranges()
+            && a.options.mask() == b.options.mask()
+            && a.partition_row_limit() == b.partition_row_limit()
+            && a.static_columns == b.static_columns
+            && a.regular_columns == b.regular_columns
+            && std::ranges::equal(a.default_row_ranges(), b.default_row_ranges(), same_range);
+}
+
+// The underlying reader of a shared scan, along with the window of the
+// fragments read by it, which weren't consumed by all the attached readers.
+//
+// The underlying reader uses a tracking-only permit of its own: it outlives
+// any of the readers attached to it, which might be evicted, time out, or
+// finish at any point.
+class shared_scan : public enable_lw_shared_from_this<shared_scan> {
+    shared_scan_registry& _registry;
+    schema_ptr _schema;
+    reader_permit _permit;
+    const dht::partition_range _range;
+    const query::partition_slice _slice;
+    const size_t _window_size;
+    mutation_reader _reader;
+    std::deque<mutation_fragment_v2> _window;
+    // The index, in the stream of the underlying reader, of _window.front().
+    uint64_t _window_start = 0;
+    size_t _window_memory = 0;
+    bool _filling = false;
+    condition_variable _filled;
+    std::exception_ptr _ex;
+    std::vector<shared_scan_reader*> _readers;
+    bool _registered = false;
+
+private:
+    void unregister() noexcept;
+    void detach(shared_scan_reader& r) noexcept;
+    void detach_lagging_readers(const shared_scan_reader& filler) noexcept;
+
+public:
+    shared_scan(shared_scan_registry& registry, mutation_source ms, schema_ptr schema, reader_permit permit, const dht::partition_range& pr,
+            const query::partition_slice& ps, tracing::trace_state_ptr trace_state, size_t window_size)
+        : _registry(registry)
+        , _schema(std::move(schema))
+        , _permit(permit.semaphore().make_tracking_only_permit(_schema, "shared-scan", db::no_timeout, trace_state))
+        , _range(pr)
+        , _slice(ps)
+        , _window_size(window_size)
+        , _reader(ms.make_reader_v2(_schema, _permit, _range, _slice, std::move(trace_state), streamed_mutation::forwarding::no,
+                mutation_reader::forwarding::no)) {
+        _registry._scans.push_back(this);
+        _registered = true;
+    }
+
+    ~shared_scan() {
+        unregister();
+    }
+
+    bool can_join(const schema& s, reader_permit& permit, const dht::partition_range& pr, const query::partition_slice& ps) {
+        return _window_start == 0 && !_ex && s.version() == _schema->version() && &permit.semaphore() == &_permit.semaphore()
+                && _range.equal(pr, dht::ring_position_comparator(s)) && same_slice(s, _slice, ps);
+    }
+
+    void attach(shared_scan_reader& r) {
+        _readers.push_back(&r);
+    }
+
+    // Closes the underlying reader once the last reader left.
+    future<> leave(shared_scan_reader& r) noexcept;
+
+    const mutation_fragment_v2* get(uint64_t index) const noexcept {
+        return index - _window_start < _window.size() ? &_window[index - _window_start] : nullptr;
+    }
+
+    bool is_end_of_stream(uint64_t index) const noexcept {
+        return _reader.is_end_of_stream() && _reader.is_buffer_empty() && index == _window_start + _window.size();
+    }
+
+    // Reads more fragments into the window, or waits for the reader which
+    // is already doing so.
+    future<> fill(shared_scan_reader& r);
+
+    // Drops the fragments consumed by all the attached readers.
+    void trim() noexcept;
+};
+
+// A reader attached to a shared scan.
+class shared_scan_reader : public mutation_reader::impl {
+    friend class shared_scan;
+
+    mutation_source _ms;
+    const dht::partition_range& _pr;
+    const query::partition_slice& _ps;
+    tracing::trace_state_ptr _trace_state;
+    position_in_partition::tri_compare _tri_cmp;
+
+    lw_shared_ptr<shared_scan> _scan;
+    // The index of the next fragment to be consumed from the window.
+    uint64_t _index = 0;
+    bool _skip_partition = false;
+
+    // The position the reader left off at, tracked like in the evictable
+    // reader, to continue from there once detached from the shared scan.
+    std::optional<dht::decorated_key> _last_pkey;
+    position_in_partition _next_position_in_partition = position_in_partition::for_partition_start();
+    std::optional<dht::partition_range> _range_override;
+    std::optional<query::partition_slice> _slice_override;
+
+    // The own reader, created once detached from the shared scan.
+    mutation_reader_opt _reader;
+
+private:
+    void push(const mutation_fragment_v2& mf);
+    mutation_reader create_reader();
+    future<> fill_buffer_from_reader();
+
+public:
+    shared_scan_reader(lw_shared_ptr<shared_scan> scan, mutation_source ms, schema_ptr schema,
+            reader_permit permit, const dht::partition_range& pr, const query::partition_slice& ps, tracing::trace_state_ptr trace_state)
+        : impl(std::move(schema), std::move(permit))
+        , _ms(std::move(ms))
+        , _pr(pr)
+        , _ps(ps)
+        , _trace_state(std::move(trace_state))
+        , _tri_cmp(*_schema)
+        , _scan(std::move(scan)) {
+        _scan->attach(*this);
+    }
+
+    uint64_t index() const noexcept {
+        return _index;
+    }
+
+    virtual future<> fill_buffer() override;
+    virtual future<> next_partition() override;
+    virtual future<> fast_forward_to(const dht::partition_range&) override {
+        throw_with_backtrace<std::bad_function_call>();
+    }
+    virtual future<> fast_forward_to(position_range) override {
+        throw_with_backtrace<std::bad_function_call>();
+    }
+    virtual future<> close() noexcept override;
+};
+
+void shared_scan::unregister() noexcept {
+    if (_registered) {
+        std::erase(_registry._scans, this);
+        _registered = false;
+    }
+}
+
+void shared_scan::detach(shared_scan_reader& r) noexcept {
+    std::erase(_readers, &r);
+    ++_registry._stats.detached_readers;
+    // The reader calling detach() is attached as well and holds a reference
+    // to the scan, so this isn't the last one.
+    r._scan = nullptr;
+}
+
+void shared_scan::detach_lagging_readers(const shared_scan_reader& filler) noexcept {
+    while (_window_memory >= _window_size) {
+        auto it = std::ranges::min_element(_readers, std::less<>{}, std::mem_fn(&shared_scan_reader::index));
+        // Readers at the end of the window are waiting for the fill, and
+        // there is nothing more to drop for them.
+        if (it == _readers.end() || *it == &filler || !get((*it)->index())) {
+            return;
+        }
+        detach(**it);
+        trim();
+    }
+}
+
+future<> shared_scan::leave(shared_scan_reader& r) noexcept {
+    std::erase(_readers, &r);
+    if (!_readers.empty()) {
+        trim();
+        co_return;
+    }
+    unregister();
+    _window.clear();
+    co_await _reader.close();
+}
+
+future<> shared_scan::fill(shared_scan_reader& r) {
+    if (_ex) {
+        co_await coroutine::return_exception_ptr(_ex);
+    }
+    if (_filling) {
+        co_await _filled.wait();
+        if (_ex) {
+            co_await coroutine::return_exception_ptr(_ex);
+        }
+        co_return;
+    }
+    detach_lagging_readers(r);
+
+    _filling = true;
+    auto f = co_await coroutine::as_future(_reader.fill_buffer());
+    _filling = false;
+    if (f.failed()) {
+        _ex = f.get_exception();
+        unregister();
+    } else {
+        while (!_reader.is_buffer_empty()) {
+            auto mf = _reader.pop_mutation_fragment();
+            _window_memory += mf.memory_usage();
+            _window.push_back(std::move(mf));
+        }
+    }
+    _filled.broadcast();
+    if (_ex) {
+        co_await coroutine::return_exception_ptr(_ex);
+    }
+}
+
+void shared_scan::trim() noexcept {
+    if (_readers.empty()) {
+        return;
+    }
+    auto min_index = (*std::ranges::min_element(_readers, std::less<>{}, std::mem_fn(&shared_scan_reader::index)))->index();
+    while (_window_start < min_index && !_window.empty()) {
+        _window_memory -= _window.front().memory_usage();
+        _window.pop_front();
+        ++_window_start;
+    }
+    // Readers joining now would miss the dropped fragments.
+    if (_window_start) {
+        unregister();
+    }
+}
+
+void shared_scan_reader::push(const mutation_fragment_v2& mf) {
+    switch (mf.mutation_fragment_kind()) {
+        case mutation_fragment_v2::kind::partition_start:
+            _last_pkey = mf.as_partition_start().key();
+            _next_position_in_partition = position_in_partition::for_static_row();
+            break;
+        case mutation_fragment_v2::kind::static_row:
+            _next_position_in_partition = position_in_partition::before_all_clustered_rows();
+            break;
+        case mutation_fragment_v2::kind::clustering_row:
+        case mutation_fragment_v2::kind::range_tombstone_change:
+            _next_position_in_partition = position_in_partition::after_key(*_schema, mf.position());
+            break;
+        case mutation_fragment_v2::kind::partition_end:
+            _next_position_in_partition = position_in_partition::for_partition_start();
+            break;
+    }
+    push_mutation_fragment(*_schema, _permit, mf);
+}
+
+mutation_reader shared_scan_reader::create_reader() {
+    const dht::partition_range* range = &_pr;
+    const query::partition_slice* slice = &_ps;
+
+    if (_last_pkey) {
+        bool partition_range_is_inclusive = true;
+
+        switch (_next_position_in_partition.region()) {
+        case partition_region::partition_start:
+        case partition_region::partition_end:
+            partition_range_is_inclusive = false;
+            break;
+        case partition_region::static_row:
+            break;
+        case partition_region::clustered: {
+            _slice_override = _ps;
+            auto ranges = _slice_override->default_row_ranges();
+            query::trim_clustering_row_ranges_to(*_schema, ranges, _next_position_in_partition);
+            _slice_override->clear_ranges();
+            _slice_override->set_range(*_schema, _last_pkey->key(), std::move(ranges));
+            slice = &*_slice_override;
+            break;
+        }
+        }
+
+        if (_pr.is_singular() && !partition_range_is_inclusive) {
+            return make_empty_flat_reader_v2(_schema, _permit);
+        }
+
+        _range_override = dht::partition_range({dht::partition_range::bound(*_last_pkey, partition_range_is_inclusive)}, _pr.end());
+        range = &*_range_override;
+    }
+
+    return _ms.make_reader_v2(_schema, _permit, *range, *slice, _trace_state, streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+}
+
+future<> shared_scan_reader::fill_buffer_from_reader() {
+    if (!_reader) {
+        _reader = create_reader();
+        // Continue the partition the reader left off in, skipping its header.
+        // The partition might have been removed since, in which case the
+        // partition is closed first. Like with the evictable reader, the
+        // tombstone state is reset, as the range tombstones read by the shared
+        // scan might not exist anymore.
+        if (_last_pkey && _next_position_in_partition.region() != partition_region::partition_start) {
+            auto mf = co_await (*_reader)();
+            if (mf && mf->is_partition_start() && mf->as_partition_start().key().equal(*_schema, *_last_pkey)) {
+                if (_next_position_in_partition.region() == partition_region::clustered
+                        && _tri_cmp(_next_position_in_partition, position_in_partition::before_all_clustered_rows()) > 0) {
+                    push_mutation_fragment(*_schema, _permit, range_tombstone_change{position_in_partition_view::before_key(_next_position_in_partition), {}});
+                }
+                auto next = co_await _reader->peek();
+                if (next && next->is_static_row() && _next_position_in_partition.region() == partition_region::clustered) {
+                    _reader->pop_mutation_fragment();
+                }
+            } else {
+                push_mutation_fragment(*_schema, _permit, partition_end{});
+                if (mf) {
+                    _reader->unpop_mutation_fragment(std::move(*mf));
+                }
+            }
+        }
+    }
+    co_await _reader->fill_buffer();
+    _reader->move_buffer_content_to(*this);
+    _end_of_stream = _reader->is_end_of_stream() && _reader->is_buffer_empty();
+}
+
+future<> shared_scan_reader::fill_buffer() {
+    while (_scan && !is_buffer_full() && !is_end_of_stream()) {
+        if (auto* mf = _scan->get(_index)) {
+            ++_index;
+            if (_skip_partition && !mf->is_partition_start()) {
+                continue;
+            }
+            _skip_partition = false;
+            push(*mf);
+        } else if (_scan->is_end_of_stream(_index)) {
+            _end_of_stream = true;
+        } else if (!is_buffer_empty()) {
+            break;
+        } else {
+            // Holds the scan alive, in case this reader is detached while
+            // waiting for the scan to be filled.
+            auto scan = _scan;
+            co_await scan->fill(*this);
+        }
+    }
+    if (_scan) {
+        _scan->trim();
+        co_return;
+    }
+    if (is_buffer_empty() && !is_end_of_stream()) {
+        co_await fill_buffer_from_reader();
+    }
+}
+
+future<> shared_scan_reader::next_partition() {
+    clear_buffer_to_next_partition();
+    if (!is_buffer_empty() || _next_position_in_partition.region() == partition_region::partition_start) {
+        co_return;
+    }
+    _next_position_in_partition = position_in_partition::for_partition_start();
+    if (_scan) {
+        _skip_partition = true;
+    } else if (_reader) {
+        co_await _reader->next_partition();
+    }
+}
+
+future<> shared_scan_reader::close() noexcept {
+    if (_reader) {
+        co_await _reader->close();
+    }
+    if (auto scan = std::move(_scan)) {
+        co_await scan->leave(*this);
+    }
+}
+
+mutation_reader shared_scan_registry::make_reader(
+        mutation_source ms,
+        schema_ptr schema,
+        reader_permit permit,
+        const dht::partition_range& pr,
+        const query::partition_slice& ps,
+        tracing::trace_state_ptr trace_state,
+        size_t window_size) {
+    lw_shared_ptr<shared_scan> scan;
+    auto it = std::ranges::find_if(_scans, [&] (shared_scan* s) { return s->can_join(*schema, permit, pr, ps); });
+    if (it != _scans.end()) {
+        scan = (*it)->shared_from_this();
+        ++_stats.joined_readers;
+    } else {
+        scan = make_lw_shared<shared_scan>(*this, ms, schema, permit, pr, ps, trace_state, window_size);
+        ++_stats.scans;
+    }
+    return make_mutation_reader<shared_scan_reader>(std::move(scan), std::move(ms), std::move(schema), std::move(permit), pr, ps,
+            std::move(trace_state));
+}
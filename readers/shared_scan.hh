@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "dht/i_partitioner_fwd.hh"
+#include "readers/mutation_reader_fwd.hh"
+#include "readers/mutation_reader.hh"
+#include "schema/schema_fwd.hh"
+#include "seastarx.hh"
+
+class reader_permit;
+class mutation_source;
+
+namespace tracing {
+class trace_state_ptr;
+}
+
+namespace query {
+class partition_slice;
+}
+
+class shared_scan;
+
+/// The shared scans of a shard.
+///
+/// Concurrent scans of the same partition range of a table, reading the same
+/// slice, can share a single underlying reader, instead of each reading the
+/// same sstable and memtable data on its own. The fragments read by the shared
+/// reader are kept in a window, from which each of the scans copies them at
+/// its own pace, until all of them have consumed it.
+///
+/// A scan can only join a shared scan which didn't drop any fragment from its
+/// window yet, i.e. while the shared scan still holds the start of the range.
+/// The window is bounded: when it grows above its size limit, the scans
+/// lagging behind are detached from the shared scan. They continue with a
+/// reader of their own, from the position they left off at, so a scan which is
+/// paused for long (e.g. between pages) doesn't hold up the others.
+class shared_scan_registry {
+public:
+    struct stats {
+        // The number of shared scans started.
+        uint64_t scans = 0;
+        // The number of readers which joined an already started shared scan.
+        uint64_t joined_readers = 0;
+        // The number of readers which were detached from their shared scan,
+        // for lagging too far behind the others.
+        uint64_t detached_readers = 0;
+    };
+
+private:
+    std::vector<shared_scan*> _scans;
+    stats _stats;
+
+    friend class shared_scan;
+
+public:
+    shared_scan_registry() = default;
+    shared_scan_registry(const shared_scan_registry&) = delete;
+    shared_scan_registry& operator=(const shared_scan_registry&) = delete;
+
+    /// Creates a reader for the given range and slice, joining a compatible
+    /// shared scan if there is one, or starting one otherwise.
+    ///
+    /// The window of the shared scan is bounded to window_size bytes (the
+    /// window of a joined scan keeps its original bound).
+    /// Parameters passed by reference have to be kept alive while the reader is
+    /// alive.
+    mutation_reader make_reader(
+            mutation_source ms,
+            schema_ptr schema,
+            reader_permit permit,
+            const dht::partition_range& pr,
+            const query::partition_slice& ps,
+            tracing::trace_state_ptr trace_state,
+            size_t window_size);
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <unordered_set>
+
 #include "redis/command_factory.hh"
 #include "service/storage_proxy.hh"
 #include "redis/commands.hh"
@@ -35,6 +37,14 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "hgetall", commands::hgetall },
         { "hdel", commands::hdel },
         { "hexists", commands::hexists },
+        { "hmget", commands::hmget },
+        { "zadd", commands::zadd },
+        { "zrem", commands::zrem },
+        { "zscore", commands::zscore },
+        { "zcard", commands::zcard },
+        { "zcount", commands::zcount },
+        { "zrange", commands::zrange },
+        { "zrangebyscore", commands::zrangebyscore },
     };
     auto&& command = _commands.find(req._command);
     if (command != _commands.end()) {
@@ -45,4 +55,12 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
     return commands::unknown(proxy, req, options, permit);
 }
 
+bool command_factory::is_read_only(const request& req) {
+    static thread_local const std::unordered_set<bytes> read_only_commands = {
+        "ping", "echo", "get", "exists", "ttl", "strlen", "hget", "hgetall", "hexists", "hmget",
+        "zscore", "zcard", "zcount", "zrange", "zrangebyscore",
+    };
+    return read_only_commands.contains(req._command);
+}
+
 }
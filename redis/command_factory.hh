@@ -22,5 +22,8 @@ class command_factory {
     command_factory() {}
     ~command_factory() {}
     static seastar::future<redis_message> create_execute(service::storage_proxy&, request&, redis::redis_options&, service_permit);
+    // Whether the command only reads, so it can run concurrently with the other
+    // read-only commands a client pipelines.
+    static bool is_read_only(const request&);
 };
 }
@@ -16,6 +16,10 @@
 #include "redis/mutation_utils.hh"
 #include "redis/lolwut.hh"
 #include "redis/keyspace_utils.hh"
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <seastar/core/coroutine.hh>
 
 namespace redis {
 
@@ -107,25 +111,51 @@ future<redis_message> hget(service::storage_proxy& proxy, request& req, redis::r
     });
 }
 
+future<redis_message> hmget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto fields = std::vector<bytes>(req._args.begin() + 1, req._args.end());
+    return redis::read_hashes(proxy, options, req._args[0], fields, permit).then([fields] (auto result) {
+        std::vector<std::optional<bytes>> values;
+        values.reserve(fields.size());
+        for (auto& field : fields) {
+            auto it = result->find(field);
+            values.push_back(it != result->end() ? std::optional(it->second) : std::nullopt);
+        }
+        return redis_message::make_array_result(values);
+    });
+}
+
 future<redis_message> hset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
-    if (req.arguments_size() != 3) {
+    if (req.arguments_size() < 3 || req.arguments_size() % 2 != 1) {
         throw wrong_number_of_arguments_exception(req._command);
     }
-    return redis::write_hashes(proxy, options, std::move(req._args[0]), std::move(req._args[1]), std::move(req._args[2]), 0, permit).then([] {
-        return redis_message::one();
+    std::vector<std::pair<bytes, bytes>> fields;
+    for (size_t i = 1; i < req.arguments_size(); i += 2) {
+        fields.emplace_back(std::move(req._args[i]), std::move(req._args[i + 1]));
+    }
+    // The number of new fields is replied, so the existing ones are read
+    // first, which isn't atomic with the write.
+    auto names = fields | std::views::keys | std::ranges::to<std::set<bytes>>();
+    auto existing = co_await redis::read_hashes(proxy, options, req._args[0], std::vector<bytes>(names.begin(), names.end()), permit);
+    auto new_fields = std::ranges::count_if(names, [&] (const bytes& name) {
+        return !existing->contains(name);
     });
+    co_await redis::write_hashes(proxy, options, std::move(req._args[0]), std::move(fields), 0, permit);
+    co_return co_await redis_message::number(new_fields);
 }
 
 future<redis_message> hdel(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() < 2) {
         throw wrong_number_of_arguments_exception(req._command);
     }
-    //FIXME: We should return the count of the actually deleted fields.
+    // The number of deleted fields is replied, so the existing ones are read
+    // first, which isn't atomic with the delete.
     auto fields = std::vector<bytes>(req._args.begin() + 1, req._args.end());
-    auto size = fields.size();
-    return redis::delete_fields(proxy, options, std::move(req._args[0]), std::move(fields), permit).then([size] {
-        return redis_message::number(size);
-    });
+    auto existing = co_await redis::read_hashes(proxy, options, req._args[0], fields, permit);
+    co_await redis::delete_fields(proxy, options, std::move(req._args[0]), std::move(fields), permit);
+    co_return co_await redis_message::number(existing->size());
 }
 
 future<redis_message> hexists(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
@@ -137,6 +167,202 @@ future<redis_message> hexists(service::storage_proxy& proxy, request& req, redis
     });
 }
 
+static double parse_score(const bytes& b) {
+    double score;
+    try {
+        size_t parsed;
+        auto str = std::string(reinterpret_cast<const char*>(b.data()), b.size());
+        score = std::stod(str, &parsed);
+        if (parsed != str.size()) {
+            throw invalid_float_exception();
+        }
+    } catch (...) {
+        throw invalid_float_exception();
+    }
+    if (std::isnan(score)) {
+        throw invalid_float_exception();
+    }
+    return score;
+}
+
+// Parses the bound of a range of scores, which is exclusive if prefixed with
+// '(', and unset if unbounded.
+static std::optional<score_bound> parse_score_bound(const bytes& b, bool is_min) {
+    if (!b.empty() && b[0] == int8_t('(')) {
+        return score_bound{parse_score(bytes(b.data() + 1, b.size() - 1)), false};
+    }
+    auto score = parse_score(b);
+    if (std::isinf(score) && (score < 0) == is_min) {
+        return std::nullopt;
+    }
+    return score_bound{score, true};
+}
+
+static long parse_integer(const bytes& b) {
+    try {
+        size_t parsed;
+        auto str = std::string(reinterpret_cast<const char*>(b.data()), b.size());
+        auto value = std::stol(str, &parsed);
+        if (parsed == str.size()) {
+            return value;
+        }
+    } catch (...) {
+    }
+    throw invalid_integer_exception();
+}
+
+static bool is_option(const bytes& b, std::string_view option) {
+    return std::ranges::equal(b, option, [] (int8_t a, char b) { return ::tolower(a) == b; });
+}
+
+static bytes format_score(double score) {
+    return to_bytes(fmt::to_string(score));
+}
+
+static std::vector<bytes> make_zset_reply(const zset_entries& entries, size_t first, size_t count, bool with_scores) {
+    std::vector<bytes> items;
+    for (size_t i = first; i < std::min(entries.size(), first + count); ++i) {
+        items.push_back(entries[i].first);
+        if (with_scores) {
+            items.push_back(format_score(entries[i].second));
+        }
+    }
+    return items;
+}
+
+future<redis_message> zadd(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 3 || req.arguments_size() % 2 != 1) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    // The last score of a member given more than once wins.
+    std::map<bytes, double> scores;
+    for (size_t i = 1; i < req.arguments_size(); i += 2) {
+        scores.insert_or_assign(req._args[i + 1], parse_score(req._args[i]));
+    }
+    // The rows of the old scores have to be deleted, so those are read first,
+    // which isn't atomic with the write.
+    auto members = scores | std::views::keys | std::ranges::to<std::vector<bytes>>();
+    auto old_scores = co_await redis::read_zset_scores(proxy, options, req._args[0], members, permit);
+    auto new_members = std::ranges::count_if(members, [&] (const bytes& member) {
+        return !old_scores->contains(member);
+    });
+    co_await redis::write_zset(proxy, options, std::move(req._args[0]), scores, *old_scores, permit);
+    co_return co_await redis_message::number(new_members);
+}
+
+future<redis_message> zrem(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto members = std::vector<bytes>(req._args.begin() + 1, req._args.end());
+    auto scores = co_await redis::read_zset_scores(proxy, options, req._args[0], members, permit);
+    if (!scores->empty()) {
+        co_await redis::delete_zset_members(proxy, options, std::move(req._args[0]), *scores, permit);
+    }
+    co_return co_await redis_message::number(scores->size());
+}
+
+future<redis_message> zscore(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 2) {
+        throw wrong_arguments_exception(2, req.arguments_size(), req._command);
+    }
+    return redis::read_zset_scores(proxy, options, req._args[0], {req._args[1]}, permit).then([] (auto result) {
+        if (!result->empty()) {
+            return redis_message::make_strings_result(format_score(result->begin()->second));
+        }
+        return redis_message::nil();
+    });
+}
+
+future<redis_message> zcard(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 1) {
+        throw wrong_arguments_exception(1, req.arguments_size(), req._command);
+    }
+    return redis::read_zset_scores(proxy, options, req._args[0], {}, permit).then([] (auto result) {
+        return redis_message::number(result->size());
+    });
+}
+
+future<redis_message> zcount(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 3) {
+        throw wrong_arguments_exception(3, req.arguments_size(), req._command);
+    }
+    auto min = parse_score_bound(req._args[1], true);
+    auto max = parse_score_bound(req._args[2], false);
+    return redis::read_zset_range(proxy, options, req._args[0], min, max, query::row_limit::max, permit).then([] (auto result) {
+        return redis_message::number(result->size());
+    });
+}
+
+future<redis_message> zrange(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 3 && req.arguments_size() != 4) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto start = parse_integer(req._args[1]);
+    auto stop = parse_integer(req._args[2]);
+    bool with_scores = false;
+    if (req.arguments_size() == 4) {
+        if (!is_option(req._args[3], "withscores")) {
+            throw syntax_error_exception();
+        }
+        with_scores = true;
+    }
+    // Negative indexes count from the end, which needs the whole sorted set.
+    auto row_limit = start >= 0 && stop >= 0 ? query::row_limit(uint64_t(stop) + 1) : query::row_limit::max;
+    auto entries = co_await redis::read_zset_range(proxy, options, req._args[0], std::nullopt, std::nullopt, row_limit, permit);
+    const long size = entries->size();
+    if (start < 0) {
+        start = std::max(start + size, 0L);
+    }
+    if (stop < 0) {
+        stop += size;
+    }
+    auto items = start <= stop ? make_zset_reply(*entries, start, stop - start + 1, with_scores) : std::vector<bytes>();
+    co_return co_await redis_message::make_array_result(items);
+}
+
+future<redis_message> zrangebyscore(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 3) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto min = parse_score_bound(req._args[1], true);
+    auto max = parse_score_bound(req._args[2], false);
+    bool with_scores = false;
+    size_t offset = 0;
+    std::optional<size_t> count;
+    for (size_t i = 3; i < req.arguments_size(); ++i) {
+        if (is_option(req._args[i], "withscores")) {
+            with_scores = true;
+        } else if (is_option(req._args[i], "limit") && i + 2 < req.arguments_size()) {
+            auto o = parse_integer(req._args[i + 1]);
+            auto c = parse_integer(req._args[i + 2]);
+            // A negative offset returns nothing, a negative count all the
+            // members from the offset.
+            offset = std::max(o, 0L);
+            if (o < 0) {
+                count = 0;
+            } else if (c >= 0) {
+                count = c;
+            } else {
+                count = std::nullopt;
+            }
+            i += 2;
+        } else {
+            throw syntax_error_exception();
+        }
+    }
+    if (count == 0) {
+        std::vector<bytes> none;
+        co_return co_await redis_message::make_array_result(none);
+    }
+    // The range is read as a slice of the partition, which stops at the last
+    // member requested.
+    auto row_limit = count ? query::row_limit(offset + *count) : query::row_limit::max;
+    auto entries = co_await redis::read_zset_range(proxy, options, req._args[0], min, max, row_limit, permit);
+    auto items = make_zset_reply(*entries, offset, count.value_or(entries->size()), with_scores);
+    co_return co_await redis_message::make_array_result(items);
+}
+
 future<redis_message> set(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() != 2 && req.arguments_size() != 4) {
         throw invalid_arguments_exception(req._command);
@@ -47,3 +47,18 @@ class invalid_db_index_exception : public redis_exception {
 public:
     invalid_db_index_exception() : redis_exception("DB index is out of range") {}
 };
+
+class invalid_float_exception : public redis_exception {
+public:
+    invalid_float_exception() : redis_exception("value is not a valid float") {}
+};
+
+class invalid_integer_exception : public redis_exception {
+public:
+    invalid_integer_exception() : redis_exception("value is not an integer or out of range") {}
+};
+
+class syntax_error_exception : public redis_exception {
+public:
+    syntax_error_exception() : redis_exception("syntax error") {}
+};
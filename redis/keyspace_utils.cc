@@ -117,20 +117,20 @@ schema_ptr sets_schema(sstring ks_name) {
     return builder.build(schema_builder::compact_storage::yes);
 }
 
-schema_ptr zsets_schema(sstring ks_name) {
-     schema_builder builder(generate_legacy_id(ks_name, redis::ZSETs), ks_name, redis::ZSETs,
+schema_ptr zset_members_schema(sstring ks_name) {
+     schema_builder builder(generate_legacy_id(ks_name, redis::ZSET_MEMBERs), ks_name, redis::ZSET_MEMBERs,
      // partition key
      {{"pkey", utf8_type}},
      // clustering key
-     {{"ckey", double_type}},
+     {{"ckey", utf8_type}},
      // regular columns
-     {{"data", utf8_type}},
+     {{"data", double_type}},
      // static columns
      {},
      // regular column name type
      utf8_type,
      // comment
-     "save ZSETs for redis"
+     "save the scores of the members of ZSETs for redis"
     );
     builder.set_gc_grace_seconds(0);
     builder.with(schema_builder::compact_storage::yes);
@@ -138,6 +138,28 @@ schema_ptr zsets_schema(sstring ks_name) {
     return builder.build(schema_builder::compact_storage::yes);
 }
 
+// The members of a sorted set ordered by score, so that ranges of scores are
+// read as slices of the partition. Rows have no cells, only a row marker.
+schema_ptr zset_scores_schema(sstring ks_name) {
+     schema_builder builder(generate_legacy_id(ks_name, redis::ZSET_SCOREs), ks_name, redis::ZSET_SCOREs,
+     // partition key
+     {{"pkey", utf8_type}},
+     // clustering key
+     {{"score", double_type}, {"member", utf8_type}},
+     // regular columns
+     {},
+     // static columns
+     {},
+     // regular column name type
+     utf8_type,
+     // comment
+     "save the members of ZSETs ordered by score for redis"
+    );
+    builder.set_gc_grace_seconds(0);
+    builder.with_version(db::system_keyspace::generate_schema_version(builder.uuid()));
+    return builder.build();
+}
+
 future<> create_keyspace_if_not_exists_impl(seastar::sharded<service::storage_proxy>& proxy, data_dictionary::database db, seastar::sharded<service::migration_manager>& mm, db::config& config, int default_replication_factor) {
     SCYLLA_ASSERT(this_shard_id() == 0);
     auto keyspace_replication_strategy_options = config.redis_keyspace_replication_strategy_options();
@@ -155,7 +177,8 @@ future<> create_keyspace_if_not_exists_impl(seastar::sharded<service::storage_pr
                              table{redis::LISTs, lists_schema},
                              table{redis::SETs, sets_schema},
                              table{redis::HASHes, hashes_schema},
-                             table{redis::ZSETs, zsets_schema}};
+                             table{redis::ZSET_MEMBERs, zset_members_schema},
+                             table{redis::ZSET_SCOREs, zset_scores_schema}};
 
     auto ks_names =
             std::views::iota(0u, config.redis_database_count()) |
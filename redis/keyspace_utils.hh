@@ -34,7 +34,10 @@ static constexpr auto STRINGs         = "STRINGs";
 static constexpr auto LISTs           = "LISTs";
 static constexpr auto HASHes          = "HASHes";
 static constexpr auto SETs            = "SETs";
-static constexpr auto ZSETs           = "ZSETs";
+// Sorted sets are stored twice: in ZSET_MEMBERs, mapping the members to their
+// scores like HASHes, and in ZSET_SCOREs, ordered by score.
+static constexpr auto ZSET_MEMBERs    = "ZSET_MEMBERs";
+static constexpr auto ZSET_SCOREs     = "ZSET_SCOREs";
 
 seastar::future<> maybe_create_keyspace(seastar::sharded<service::storage_proxy>& proxy, data_dictionary::database db, seastar::sharded<service::migration_manager>& mm, db::config& cfg, seastar::sharded<gms::gossiper>& g);
 
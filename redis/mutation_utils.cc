@@ -38,21 +38,70 @@ atomic_cell make_cell(const schema_ptr schema,
 }  
 
 
-future<> write_hashes(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& field, bytes&& data, long ttl, service_permit permit) {
+future<> write_hashes(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<std::pair<bytes, bytes>>&& fields, long ttl, service_permit permit) {
     db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
 
     auto schema = get_schema(proxy, options.get_keyspace_name(), redis::HASHes);
     const column_definition& column = *schema->get_column_definition(redis::DATA_COLUMN_NAME);
     auto pkey = partition_key::from_single_value(*schema, key);
-    auto ckey = clustering_key::from_single_value(*schema, field);
     auto m = mutation(schema, std::move(pkey));
-    auto cell = make_cell(schema, *(column.type.get()), data, ttl);
-    m.set_clustered_cell(ckey, column, std::move(cell));
+    for (auto& [field, data] : fields) {
+        auto ckey = clustering_key::from_single_value(*schema, field);
+        auto cell = make_cell(schema, *(column.type.get()), data, ttl);
+        m.set_clustered_cell(ckey, column, std::move(cell));
+    }
 
     auto write_consistency_level = options.get_write_consistency_level();
     return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
 }
 
+static clustering_key make_zset_score_key(const schema& schema, double score, const bytes& member) {
+    return clustering_key::from_exploded(schema, std::vector<bytes>{double_type->decompose(score), member});
+}
+
+future<> write_zset(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, const std::map<bytes, double>& scores, const std::map<bytes, double>& old_scores, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    auto members_schema = get_schema(proxy, options.get_keyspace_name(), redis::ZSET_MEMBERs);
+    auto scores_schema = get_schema(proxy, options.get_keyspace_name(), redis::ZSET_SCOREs);
+    const column_definition& column = *members_schema->get_column_definition(redis::DATA_COLUMN_NAME);
+    auto members_m = mutation(members_schema, partition_key::from_single_value(*members_schema, key));
+    auto scores_m = mutation(scores_schema, partition_key::from_single_value(*scores_schema, key));
+    auto ts = api::new_timestamp();
+    auto clk = gc_clock::now();
+    for (auto& [member, score] : scores) {
+        // The row of the old score of the member is in another place of the
+        // partition, so it has to be deleted.
+        if (auto it = old_scores.find(member); it != old_scores.end()) {
+            if (it->second == score) {
+                continue;
+            }
+            scores_m.partition().apply_delete(*scores_schema, make_zset_score_key(*scores_schema, it->second, member), tombstone { ts, clk });
+        }
+        members_m.set_clustered_cell(clustering_key::from_single_value(*members_schema, member), column,
+                atomic_cell::make_live(*column.type, ts, column.type->decompose(score), atomic_cell::collection_member::no));
+        scores_m.partition().clustered_row(*scores_schema, make_zset_score_key(*scores_schema, score, member)).apply(row_marker(ts));
+    }
+
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::vector<mutation> {std::move(members_m), std::move(scores_m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+
+future<> delete_zset_members(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, const std::map<bytes, double>& scores, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    auto members_schema = get_schema(proxy, options.get_keyspace_name(), redis::ZSET_MEMBERs);
+    auto scores_schema = get_schema(proxy, options.get_keyspace_name(), redis::ZSET_SCOREs);
+    auto members_m = mutation(members_schema, partition_key::from_single_value(*members_schema, key));
+    auto scores_m = mutation(scores_schema, partition_key::from_single_value(*scores_schema, key));
+    auto t = tombstone { api::new_timestamp(), gc_clock::now() };
+    for (auto& [member, score] : scores) {
+        members_m.partition().apply_delete(*members_schema, clustering_key::from_single_value(*members_schema, member), t);
+        scores_m.partition().apply_delete(*scores_schema, make_zset_score_key(*scores_schema, score, member), t);
+    }
+
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::vector<mutation> {std::move(members_m), std::move(scores_m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+
 
 mutation make_mutation(service::storage_proxy& proxy, const redis_options& options, bytes&& key, bytes&& data, long ttl) {
     auto schema = get_schema(proxy, options.get_keyspace_name(), redis::STRINGs);
@@ -83,7 +132,7 @@ mutation make_tombstone(service::storage_proxy& proxy, const redis_options& opti
 future<> delete_objects(service::storage_proxy& proxy, redis::redis_options& options, std::vector<bytes>&& keys, service_permit permit) {
     db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
     auto write_consistency_level = options.get_write_consistency_level();
-    std::vector<sstring> tables { redis::STRINGs, redis::LISTs, redis::HASHes, redis::SETs, redis::ZSETs }; 
+    std::vector<sstring> tables { redis::STRINGs, redis::LISTs, redis::HASHes, redis::SETs, redis::ZSET_MEMBERs, redis::ZSET_SCOREs }; 
     auto remove = [&proxy, timeout, write_consistency_level, permit, &options, keys = std::move(keys)] (const sstring& cf_name) {
         return parallel_for_each(keys.begin(), keys.end(), [&proxy, timeout, write_consistency_level, &options, permit, cf_name] (const bytes& key) {
             auto m = make_tombstone(proxy, options, cf_name, key);
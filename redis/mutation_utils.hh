@@ -7,6 +7,7 @@
  */
 
 #pragma once
+#include <map>
 #include <vector>
 #include <seastar/core/future.hh>
 #include "bytes.hh"
@@ -23,9 +24,13 @@ namespace redis {
 
 class redis_options;
 
-future<> write_hashes(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& field, bytes&& data, long ttl, service_permit permit);
+future<> write_hashes(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<std::pair<bytes, bytes>>&& fields, long ttl, service_permit permit);
 future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& data, long ttl, service_permit permit);
 future<> delete_objects(service::storage_proxy& proxy, redis::redis_options& options, std::vector<bytes>&& keys, service_permit permit);
 future<> delete_fields(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& fields, service_permit permit);
+// Sets the scores of the members, given their current scores.
+future<> write_zset(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, const std::map<bytes, double>& scores, const std::map<bytes, double>& old_scores, service_permit permit);
+// Deletes the members, given their current scores.
+future<> delete_zset_members(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, const std::map<bytes, double>& scores, service_permit permit);
 
 }
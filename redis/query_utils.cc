@@ -15,11 +15,27 @@
 #include "partition_slice_builder.hh"
 #include "query-result-reader.hh"
 #include "gc_clock.hh"
+#include "types/types.hh"
 #include "service_permit.hh"
 #include "redis/keyspace_utils.hh"
+#include <set>
 
 namespace redis {
 
+static future<service::storage_proxy::coordinator_query_result> query_partition(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit,
+        schema_ptr schema, const query::partition_slice& ps, query::row_limit row_limit) {
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    const auto max_tombstones = proxy.get_tombstone_limit();
+    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, row_limit, query::partition_limit(1), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto partition_range = dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey)));
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.emplace_back(std::move(partition_range));
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()});
+}
+
 class strings_result_builder {
     lw_shared_ptr<strings_result> _data;
     const query::partition_slice& _partition_slice;
@@ -67,16 +83,7 @@ future<lw_shared_ptr<strings_result>> read_strings(service::storage_proxy& proxy
 }
 
 future<lw_shared_ptr<strings_result>> query_strings(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps) {
-    const auto max_result_size = proxy.get_max_result_size(ps);
-    const auto max_tombstones = proxy.get_tombstone_limit();
-    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, query::row_limit(1), query::partition_limit(1), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
-    auto pkey = partition_key::from_single_value(*schema, key);
-    auto partition_range = dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey)));
-    dht::partition_range_vector partition_ranges;
-    partition_ranges.emplace_back(std::move(partition_range));
-    auto read_consistency_level = options.get_read_consistency_level();
-    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
-    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema] (auto qr) {
+    return query_partition(proxy, options, key, permit, schema, ps, query::row_limit(1)).then([ps, schema] (auto qr) {
         return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
             auto pd = make_lw_shared<strings_result>();
             v.consume(ps, strings_result_builder(pd, schema, ps));
@@ -143,17 +150,29 @@ future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy
     return query_hashes(proxy, options, key, permit, schema, ps);
 }
 
+// Reads the given fields of the partition, which are all read if fields is empty.
+static future<lw_shared_ptr<std::map<bytes, bytes>>> read_fields(service::storage_proxy& proxy, const redis_options& options, const sstring& cf_name, const bytes& key, const std::vector<bytes>& fields, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), cf_name);
+    // The ranges of the slice have to be sorted and distinct.
+    std::vector<query::clustering_range> ranges;
+    for (auto& field : std::set<bytes>(fields.begin(), fields.end())) {
+        ranges.push_back(query::clustering_range::make_singular(clustering_key::from_single_value(*schema, field)));
+    }
+    auto ps = ranges.empty()
+        ? partition_slice_builder(*schema).build()
+        : partition_slice_builder(*schema).with_ranges(std::move(ranges)).build();
+    return query_hashes(proxy, options, key, permit, schema, ps);
+}
+
+future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, const std::vector<bytes>& fields, service_permit permit) {
+    if (fields.empty()) {
+        return make_ready_future<lw_shared_ptr<std::map<bytes, bytes>>>(make_lw_shared<std::map<bytes, bytes>>());
+    }
+    return read_fields(proxy, options, redis::HASHes, key, fields, permit);
+}
+
 future<lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps) {
-    const auto max_result_size = proxy.get_max_result_size(ps);
-    const auto max_tombstones = proxy.get_tombstone_limit();
-    query::read_command cmd(schema->id(), schema->version(), ps, max_result_size, max_tombstones, query::row_limit::max, query::partition_limit(1), gc_clock::now(), std::nullopt, query_id::create_null_id(), query::is_first_page::no);
-    auto pkey = partition_key::from_single_value(*schema, key);
-    auto partition_range = dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey)));
-    dht::partition_range_vector partition_ranges;
-    partition_ranges.emplace_back(std::move(partition_range));
-    auto read_consistency_level = options.get_read_consistency_level();
-    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
-    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema] (auto qr) {
+    return query_partition(proxy, options, key, permit, schema, ps, query::row_limit::max).then([ps, schema] (auto qr) {
         return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
             auto pd = make_lw_shared<std::map<bytes, bytes>>();
             v.consume(ps, hashes_result_builder(pd, schema, ps));
@@ -162,4 +181,58 @@ future<lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_prox
     });
 }
 
+future<lw_shared_ptr<std::map<bytes, double>>> read_zset_scores(service::storage_proxy& proxy, const redis_options& options, const bytes& key, const std::vector<bytes>& members, service_permit permit) {
+    return read_fields(proxy, options, redis::ZSET_MEMBERs, key, members, permit).then([] (lw_shared_ptr<std::map<bytes, bytes>> fields) {
+        auto scores = make_lw_shared<std::map<bytes, double>>();
+        for (auto& [member, score] : *fields) {
+            scores->emplace(member, value_cast<double>(double_type->deserialize_value(score)));
+        }
+        return scores;
+    });
+}
+
+class zset_result_builder {
+    lw_shared_ptr<zset_entries> _data;
+public:
+    explicit zset_result_builder(lw_shared_ptr<zset_entries> data)
+        : _data(data)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {}
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        // The clustering key is (score, member).
+        auto components = key.explode();
+        _data->emplace_back(std::move(components[1]), value_cast<double>(double_type->deserialize_value(components[0])));
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {}
+};
+
+future<lw_shared_ptr<zset_entries>> read_zset_range(service::storage_proxy& proxy, const redis_options& options, const bytes& key, std::optional<score_bound> min, std::optional<score_bound> max, query::row_limit row_limit, service_permit permit) {
+    if (min && max && (min->value > max->value || (min->value == max->value && !(min->inclusive && max->inclusive)))) {
+        return make_ready_future<lw_shared_ptr<zset_entries>>(make_lw_shared<zset_entries>());
+    }
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::ZSET_SCOREs);
+    // The bounds are prefixes of the clustering key, so they include or
+    // exclude all the members with the score of the bound.
+    auto make_bound = [&schema] (const std::optional<score_bound>& b) -> std::optional<query::clustering_range::bound> {
+        if (!b) {
+            return std::nullopt;
+        }
+        return query::clustering_range::bound(clustering_key_prefix::from_single_value(*schema, double_type->decompose(b->value)), b->inclusive);
+    };
+    auto ps = partition_slice_builder(*schema)
+        .with_range(query::clustering_range(make_bound(min), make_bound(max)))
+        .build();
+    return query_partition(proxy, options, key, permit, schema, ps, row_limit).then([ps, schema] (auto qr) {
+        return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
+            auto pd = make_lw_shared<zset_entries>();
+            v.consume(ps, zset_result_builder(pd));
+            return pd;
+        });
+    });
+}
+
 }
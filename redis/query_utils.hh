@@ -40,6 +40,21 @@ seastar::future<seastar::lw_shared_ptr<strings_result>> query_strings(service::s
 
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const bytes&, service_permit);
+seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const std::vector<bytes>&, service_permit);
 seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
 
+// The members of a sorted set with their scores, in the order of the scores.
+using zset_entries = std::vector<std::pair<bytes, double>>;
+
+// A bound of a range of scores, unset for an unbounded range.
+struct score_bound {
+    double value;
+    bool inclusive;
+};
+
+// Reads the scores of the given members of the sorted set, or of all of them if members is empty.
+seastar::future<seastar::lw_shared_ptr<std::map<bytes, double>>> read_zset_scores(service::storage_proxy&, const redis_options&, const bytes&, const std::vector<bytes>&, service_permit);
+// Reads the members of the sorted set in the given range of scores, as a slice of the partition.
+seastar::future<seastar::lw_shared_ptr<zset_entries>> read_zset_range(service::storage_proxy&, const redis_options&, const bytes&, std::optional<score_bound>, std::optional<score_bound>, query::row_limit, service_permit);
+
 }
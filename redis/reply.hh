@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
 #include "bytes.hh"
 #include <seastar/core/sharded.hh>
 #include <seastar/core/shared_ptr.hh>
@@ -68,6 +70,27 @@ class redis_message final {
         }
         return make_ready_future<redis_message>(m);
     }
+    static seastar::future<redis_message> make_array_result(std::vector<bytes>& items) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", items.size()));
+        for (auto& item : items) {
+            write_bytes(m, item);
+        }
+        return make_ready_future<redis_message>(m);
+    }
+    // Missing items are replied as nil.
+    static seastar::future<redis_message> make_array_result(std::vector<std::optional<bytes>>& items) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", items.size()));
+        for (auto& item : items) {
+            if (item) {
+                write_bytes(m, *item);
+            } else {
+                m->append_static("$-1\r\n");
+            }
+        }
+        return make_ready_future<redis_message>(m);
+    }
     static seastar::future<redis_message> make_strings_result(bytes result) {
         auto m = make_lw_shared<scattered_message<char>> ();
         write_bytes(m, result);
@@ -10,6 +10,7 @@
 
 #include "redis/request.hh"
 #include "redis/reply.hh"
+#include "redis/command_factory.hh"
 
 #include "db/consistency_level_type.hh"
 
@@ -72,56 +73,116 @@ redis_server::connection::~connection() {
 
 thread_local redis_server::connection::execution_stage_type redis_server::connection::_process_request_stage {"redis_transport", &connection::process_request_one};
 
-future<redis_server::result> redis_server::connection::process_request_internal() {
-    return _process_request_stage(this, _parser.get_request(), seastar::ref(_options), empty_service_permit());
+future<redis_server::result> redis_server::connection::process_request_internal(redis::request&& request) {
+    return _process_request_stage(this, std::move(request), seastar::ref(_options), empty_service_permit());
+}
+
+future<> redis_server::connection::write_message(lw_shared_ptr<scattered_message<char>> m) {
+    return _write_buf.write(std::move(*m)).then([this] {
+        if (--_queued_replies) {
+            return make_ready_future<>();
+        }
+        return _write_buf.flush();
+    });
 }
 
 void redis_server::connection::write_reply(const redis_exception& e)
 {
+    ++_queued_replies;
     _ready_to_respond = _ready_to_respond.then([this, exception_message = e.what_message()] () mutable {
         return redis_message::exception(exception_message).then([this] (auto&& result) {
-            auto m = result.message();
-            return _write_buf.write(std::move(*m)).then([this] {
-                return _write_buf.flush();
-            });
+            return write_message(result.message());
         });
     });
 }
 
 void redis_server::connection::write_reply(redis_server::result result)
 {
+    ++_queued_replies;
     _ready_to_respond = _ready_to_respond.then([this, result = std::move(result)] () mutable {
-        auto m = result.make_message();
-        return _write_buf.write(std::move(*m)).then([this] {
-            return _write_buf.flush();
+        return write_message(result.make_message());
+    });
+}
+
+void redis_server::connection::write_reply(future<redis_server::result> result)
+{
+    // The reply takes its place among the others now, so it's written in
+    // the order of the commands, whichever order they finish in.
+    ++_queued_replies;
+    _ready_to_respond = _ready_to_respond.then([this, result = std::move(result)] () mutable {
+        return std::move(result).then_wrapped([this] (future<redis_server::result> f) {
+            if (!f.failed()) {
+                return write_message(f.get().make_message());
+            }
+            sstring message;
+            try {
+                std::rethrow_exception(f.get_exception());
+            } catch (redis_exception& e) {
+                message = e.what_message();
+            } catch (std::exception& e) {
+                message = e.what();
+            } catch (...) {
+                message = "Unknown exception";
+            }
+            return redis_message::exception(message).then([this] (auto&& result) {
+                return write_message(result.message());
+            });
         });
     });
 }
 
+future<> redis_server::connection::wait_for_reads() {
+    if (!_reads_in_flight.get_count()) {
+        return make_ready_future<>();
+    }
+    return _reads_in_flight.close().then([this] {
+        _reads_in_flight = seastar::gate();
+    });
+}
+
 future<> redis_server::connection::process_request() {
     _parser.init();
     return _read_buf.consume(_parser).then([this] {
         if (_parser.eof()) {
             return make_ready_future<>();
         }
+        const bool parse_failed = _parser.failed();
+        auto request = std::move(_parser.get_request());
         ++_server._stats._requests_serving;
         _pending_requests_gate.enter();
         utils::latency_counter lc;
         lc.start();
         auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
-        return process_request_internal().then([this, leave = std::move(leave), lc = std::move(lc)] (auto&& result) mutable {
+        auto account = [this] (utils::latency_counter& lc) {
             --_server._stats._requests_serving;
+            ++_server._stats._requests_served;
+            _server._stats._requests.mark(lc.stop().latency());
+            _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
+        };
+
+        // Pipelined read-only commands run concurrently: the next command is
+        // parsed without waiting for them to finish.
+        if (!parse_failed && redis::command_factory::is_read_only(request)) {
+            auto f = process_request_internal(std::move(request)).finally(
+                    [this, leave = std::move(leave), lc = std::move(lc), account, holder = _reads_in_flight.hold()] () mutable {
+                account(lc);
+            });
+            write_reply(std::move(f));
+            return make_ready_future<>();
+        }
+
+        return wait_for_reads().then([this, request = std::move(request)] () mutable {
+            return process_request_internal(std::move(request));
+        }).then([this, parse_failed, leave = std::move(leave), lc = std::move(lc), account] (auto&& result) mutable {
             try {
-                if (_parser.failed()) {
+                if (parse_failed) {
                     logging.error("request parse failed");
                     const auto e = redis_exception("unknown command ''");
                     write_reply(std::move(e));
                 }else{
                     write_reply(std::move(result));
                 }
-                ++_server._stats._requests_served;
-                _server._stats._requests.mark(lc.stop().latency());
-                _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
+                account(lc);
             } catch (...) {
                 logging.error("request processing failed: {}", std::current_exception());
             }
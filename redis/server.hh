@@ -78,6 +78,14 @@ class redis_server : public generic_server::server {
         socket_address _server_addr;
         redis_protocol_parser _parser;
         redis::redis_options _options;
+        // The read-only commands which are still running. Other commands
+        // wait for them, so every command sees the effects of the ones
+        // pipelined before it.
+        seastar::gate _reads_in_flight;
+        // The replies waiting to be written. The output is flushed only after
+        // the last of them, so the replies to pipelined commands are sent
+        // together.
+        size_t _queued_replies = 0;
 
         using execution_stage_type = inheriting_concrete_execution_stage<
                 future<redis_server::result>,
@@ -94,9 +102,12 @@ class redis_server : public generic_server::server {
         void handle_error(future<>&& f) override;
         void write_reply(const redis_exception&);
         void write_reply(redis_server::result result);
+        void write_reply(future<redis_server::result> result);
     private:
         future<result> process_request_one(redis::request&& request, redis::redis_options&, service_permit permit);
-        future<result> process_request_internal();
+        future<result> process_request_internal(redis::request&& request);
+        future<> wait_for_reads();
+        future<> write_message(lw_shared_ptr<scattered_message<char>> m);
     };
 
     virtual shared_ptr<generic_server::connection> make_connection(socket_address server_addr, connected_socket&& fd, socket_address addr) override;
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <numeric>
+
+#include "repair/range_summary.hh"
+#include "utils/xx_hasher.hh"
+
+repair_range_summary::splitter::splitter(dht::token_range range, size_t leaves_count)
+    : _range(std::move(range))
+{
+    auto is_key = [] (const std::optional<dht::token_range::bound>& b) {
+        return b && b->value()._kind == dht::token_kind::key;
+    };
+    uint64_t lo = is_key(_range.start()) ? _range.start()->value().unbias() : 0;
+    uint64_t hi = is_key(_range.end()) ? _range.end()->value().unbias() : std::numeric_limits<uint64_t>::max();
+    if (leaves_count <= 1 || hi <= lo) {
+        return;
+    }
+    uint64_t step = (hi - lo) / leaves_count;
+    if (step == 0) {
+        return;
+    }
+    _boundaries.reserve(leaves_count - 1);
+    for (size_t i = 1; i < leaves_count; ++i) {
+        _boundaries.push_back(dht::token::bias(lo + step * i));
+    }
+}
+
+size_t repair_range_summary::splitter::leaf_of(const dht::token& t) const {
+    return std::lower_bound(_boundaries.begin(), _boundaries.end(), t) - _boundaries.begin();
+}
+
+dht::token_range repair_range_summary::splitter::leaves_range(size_t first, size_t last) const {
+    auto start = first == 0 ? _range.start() : dht::token_range::bound(_boundaries[first - 1], false);
+    auto end = last + 1 >= leaves_count() ? _range.end() : dht::token_range::bound(_boundaries[last], true);
+    return dht::token_range(std::move(start), std::move(end));
+}
+
+static repair_hash combine(const repair_hash& left, const repair_hash& right) {
+    xx_hasher h;
+    h.update(reinterpret_cast<const char*>(&left.hash), sizeof(left.hash));
+    h.update(reinterpret_cast<const char*>(&right.hash), sizeof(right.hash));
+    return repair_hash(h.finalize_uint64());
+}
+
+repair_range_summary repair_range_summary::build(const std::vector<repair_hash>& leaves) {
+    if (leaves.empty()) {
+        return repair_range_summary();
+    }
+    size_t width = std::bit_ceil(leaves.size());
+    std::vector<repair_hash> nodes(2 * width - 1);
+    std::copy(leaves.begin(), leaves.end(), nodes.begin() + width - 1);
+    for (size_t i = width - 1; i-- > 0;) {
+        nodes[i] = combine(nodes[2 * i + 1], nodes[2 * i + 2]);
+    }
+    return repair_range_summary(std::move(nodes));
+}
+
+std::vector<size_t> repair_range_summary::differing_leaves(const std::vector<repair_range_summary>& summaries, size_t leaves_count) {
+    std::vector<size_t> ret;
+    if (summaries.empty()) {
+        return ret;
+    }
+    auto size = summaries.front()._nodes.size();
+    auto expected_size = leaves_count ? 2 * std::bit_ceil(leaves_count) - 1 : 0;
+    bool same_shape = size == expected_size && std::ranges::all_of(summaries, [size] (const repair_range_summary& s) {
+        return s._nodes.size() == size;
+    });
+    if (!same_shape) {
+        ret.resize(leaves_count);
+        std::iota(ret.begin(), ret.end(), 0);
+        return ret;
+    }
+    auto first_leaf = size / 2;
+    auto differs = [&] (size_t node) {
+        return std::ranges::any_of(summaries, [&] (const repair_range_summary& s) {
+            return s._nodes[node] != summaries.front()._nodes[node];
+        });
+    };
+    // Depth-first, visiting left children first, so leaves are found in order.
+    std::vector<size_t> stack;
+    if (size && differs(0)) {
+        stack.push_back(0);
+    }
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        if (node >= first_leaf) {
+            if (node - first_leaf < leaves_count) {
+                ret.push_back(node - first_leaf);
+            }
+            continue;
+        }
+        for (auto child : {2 * node + 2, 2 * node + 1}) {
+            if (differs(child)) {
+                stack.push_back(child);
+            }
+        }
+    }
+    return ret;
+}
+
+std::vector<std::pair<size_t, size_t>> merge_leaves_into_runs(const std::vector<size_t>& leaves, size_t max_runs) {
+    std::vector<std::pair<size_t, size_t>> runs;
+    for (auto leaf : leaves) {
+        if (!runs.empty() && runs.back().second + 1 == leaf) {
+            runs.back().second = leaf;
+        } else {
+            runs.emplace_back(leaf, leaf);
+        }
+    }
+    max_runs = std::max<size_t>(max_runs, 1);
+    while (runs.size() > max_runs) {
+        size_t best = 0;
+        for (size_t i = 1; i + 1 < runs.size(); ++i) {
+            if (runs[i + 1].first - runs[i].second < runs[best + 1].first - runs[best].second) {
+                best = i;
+            }
+        }
+        runs[best].second = runs[best + 1].second;
+        runs.erase(runs.begin() + best + 1);
+    }
+    return runs;
+}
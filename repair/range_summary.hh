@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "dht/i_partitioner_fwd.hh"
+#include "dht/token.hh"
+#include "repair/hash.hh"
+
+// Merkle tree summary of the rows of a token range.
+//
+// The range is split into leaves of about equal token width, the hashes of
+// the rows of each leaf are combined into the leaf hash, and the leaves are
+// summarized by a binary hash tree. Nodes whose summaries of a range have
+// the same root hold the same rows in the range. Otherwise, only the
+// sub-ranges of the leaves which differ need to be synced row by row.
+class repair_range_summary {
+public:
+    // Splits a range into the leaves of its summary. Leaf i covers the tokens
+    // in (boundaries[i - 1], boundaries[i]], the first and last leaves are
+    // bounded by the range itself.
+    class splitter {
+        dht::token_range _range;
+        std::vector<dht::token> _boundaries;
+    public:
+        // Ranges too narrow to be split into leaves_count leaves get fewer.
+        splitter(dht::token_range range, size_t leaves_count);
+
+        size_t leaves_count() const noexcept {
+            return _boundaries.size() + 1;
+        }
+
+        size_t leaf_of(const dht::token& t) const;
+
+        // The range covered by the leaves first to last, inclusive.
+        dht::token_range leaves_range(size_t first, size_t last) const;
+    };
+
+private:
+    // Complete binary tree in heap layout: the root is at 0, the children of
+    // node i are at 2i + 1 and 2i + 2. The leaves are padded with empty hashes
+    // to a power of two.
+    std::vector<repair_hash> _nodes;
+public:
+    repair_range_summary() = default;
+    explicit repair_range_summary(std::vector<repair_hash> nodes) : _nodes(std::move(nodes)) {}
+
+    static repair_range_summary build(const std::vector<repair_hash>& leaves);
+
+    const std::vector<repair_hash>& nodes() const noexcept {
+        return _nodes;
+    }
+
+    repair_hash root() const {
+        return _nodes.empty() ? repair_hash() : _nodes.front();
+    }
+
+    // Walks the trees top-down, descending only into the nodes where any of
+    // the summaries differ, and returns the indexes of the differing leaves
+    // in increasing order. All the summaries must be built from the same
+    // number of leaves, or else all the leaves are considered different.
+    static std::vector<size_t> differing_leaves(const std::vector<repair_range_summary>& summaries, size_t leaves_count);
+};
+
+// Merges the leaves into runs of adjacent leaves, and then merges the runs
+// separated by the smallest gaps until at most max_runs are left.
+// Returns the runs as inclusive [first, last] pairs.
+std::vector<std::pair<size_t, size_t>> merge_leaves_into_runs(const std::vector<size_t>& leaves, size_t max_runs);
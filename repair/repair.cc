@@ -755,6 +755,7 @@ void repair_stats::add(const repair_stats& o) {
     round_nr += o.round_nr;
     round_nr_fast_path_already_synced += o.round_nr_fast_path_already_synced;
     round_nr_fast_path_same_combined_hashes += o.round_nr_fast_path_same_combined_hashes;
+    round_nr_fast_path_same_summary += o.round_nr_fast_path_same_summary;
     round_nr_slow_path += o.round_nr_slow_path;
     rpc_call_nr += o.rpc_call_nr;
     tx_hashes_nr += o.tx_hashes_nr;
@@ -792,10 +793,11 @@ sstring repair_stats::get_stats() {
             row_from_disk_rows_per_sec[x.first] = 0;
         }
     }
-    return seastar::format("round_nr={}, round_nr_fast_path_already_synced={}, round_nr_fast_path_same_combined_hashes={}, round_nr_slow_path={}, rpc_call_nr={}, tx_hashes_nr={}, rx_hashes_nr={}, duration={} seconds, tx_row_nr={}, rx_row_nr={}, tx_row_bytes={}, rx_row_bytes={}, row_from_disk_bytes={}, row_from_disk_nr={}, row_from_disk_bytes_per_sec={} MiB/s, row_from_disk_rows_per_sec={} Rows/s, tx_row_nr_peer={}, rx_row_nr_peer={}",
+    return seastar::format("round_nr={}, round_nr_fast_path_already_synced={}, round_nr_fast_path_same_combined_hashes={}, round_nr_fast_path_same_summary={}, round_nr_slow_path={}, rpc_call_nr={}, tx_hashes_nr={}, rx_hashes_nr={}, duration={} seconds, tx_row_nr={}, rx_row_nr={}, tx_row_bytes={}, rx_row_bytes={}, row_from_disk_bytes={}, row_from_disk_nr={}, row_from_disk_bytes_per_sec={} MiB/s, row_from_disk_rows_per_sec={} Rows/s, tx_row_nr_peer={}, rx_row_nr_peer={}",
             round_nr,
             round_nr_fast_path_already_synced,
             round_nr_fast_path_same_combined_hashes,
+            round_nr_fast_path_same_summary,
             round_nr_slow_path,
             rpc_call_nr,
             tx_hashes_nr,
@@ -2433,7 +2435,18 @@ future<> repair::tablet_repair_task_impl::run() {
         });
 
 
-        rs.container().invoke_on_all([&idx, id, metas = _metas, parent_data, reason = _reason, tables = _tables, ranges_parallelism = _ranges_parallelism] (repair_service& rs) -> future<> {
+        // Flush hints and batchlog once for all the tablets, like a vnode
+        // repair does for all its ranges, rather than before each tablet,
+        // which made each tablet wait for all nodes to flush.
+        auto flush_participants = std::list<gms::inet_address>(participants.begin(), participants.end());
+        auto my_address = rs._db.local().get_token_metadata().get_topology().my_address();
+        if (!participants.contains(my_address)) {
+            flush_participants.push_front(my_address);
+        }
+        bool hints_batchlog_flushed = flush_hints(rs, id, rs._db.local(), _keyspace, _tables, {}, std::move(flush_participants)).get();
+
+        rs.container().invoke_on_all([&idx, id, metas = _metas, parent_data, reason = _reason, ranges_parallelism = _ranges_parallelism,
+                hints_batchlog_flushed] (repair_service& rs) -> future<> {
             std::exception_ptr error;
             for (auto& m : metas) {
                 if (m.master_shard_id != this_shard_id()) {
@@ -2460,10 +2473,6 @@ future<> repair::tablet_repair_task_impl::run() {
                 auto data_centers = std::vector<sstring>();
                 auto hosts = std::vector<sstring>();
                 auto ignore_nodes = std::unordered_set<gms::inet_address>();
-                auto my_address = erm->get_topology().my_address();
-                auto participants = std::list<gms::inet_address>(m.neighbors.all.begin(), m.neighbors.all.end());
-                participants.push_front(my_address);
-                bool hints_batchlog_flushed = co_await flush_hints(rs, id, rs._db.local(), m.keyspace_name, tables, ignore_nodes, participants);
                 bool small_table_optimization = false;
 
                 auto task_impl_ptr = seastar::make_shared<repair::shard_repair_task_impl>(rs._repair_module, tasks::task_id::create_random_id(),
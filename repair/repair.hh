@@ -113,6 +113,7 @@ class repair_stats {
     uint64_t round_nr = 0;
     uint64_t round_nr_fast_path_already_synced = 0;
     uint64_t round_nr_fast_path_same_combined_hashes= 0;
+    uint64_t round_nr_fast_path_same_summary = 0;
     uint64_t round_nr_slow_path = 0;
 
     uint64_t rpc_call_nr = 0;
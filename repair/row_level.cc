@@ -35,6 +35,7 @@
 #include <random>
 #include <optional>
 #include <boost/intrusive/list.hpp>
+#include <boost/range/irange.hpp>
 #include "gms/i_endpoint_state_change_subscriber.hh"
 #include "gms/gossiper.hh"
 #include "repair/row_level.hh"
@@ -61,6 +62,7 @@
 #include "repair/row.hh"
 #include "repair/writer.hh"
 #include "repair/reader.hh"
+#include "repair/range_summary.hh"
 #include "compaction/compaction_manager.hh"
 #include "utils/xx_hasher.hh"
 
@@ -86,6 +88,8 @@ enum class repair_state : uint16_t {
     get_estimated_partitions_finished,
     set_estimated_partitions_started,
     set_estimated_partitions_finished,
+    get_range_summary_started,
+    get_range_summary_finished,
     get_sync_boundary_started,
     get_sync_boundary_finished,
     get_combined_row_hash_started,
@@ -260,7 +264,7 @@ static uint64_t get_random_seed() {
 }
 
 repair_hash repair_hasher::do_hash_for_mf(const decorated_key_with_hash& dk_with_hash, const mutation_fragment& mf) {
-    xx_hasher h(_seed);
+    buffered_xx_hasher h(_seed);
     feed_hash(h, mf, *_schema);
     feed_hash(h, dk_with_hash.hash.hash);
     return repair_hash(h.finalize_uint64());
@@ -1095,6 +1099,54 @@ class repair_meta {
         cur_rows.push_back(std::move(r));
     }
 
+    repair_reader::read_strategy choose_read_strategy() const {
+        if (_repair_master || _same_sharding_config || _is_tablet) {
+            rlogger.debug("repair_reader: meta_id={}, _repair_master={}, _same_sharding_config={},"
+                          "read_strategy {} is chosen",
+               _repair_meta_id, _repair_master, _same_sharding_config,
+               repair_reader::read_strategy::local);
+            return repair_reader::read_strategy::local;
+        }
+
+        // multishard_filter means load all the data in the range and apply
+        // filter by master shard on top, discarding partitions from other shards.
+        // multishard_split means split the range into multiple subranges,
+        // each containing only the required data from the master shard.
+        // For situations with a sparse data set spread across numerous ranges,
+        // the overhead from continuously switching between these ranges,
+        // specifically during the fast_forward_to function on the multishard_reader,
+        // can become the main factor in performance.
+        // Similarly, with multishard_filter, reading all the partitions within
+        // the range can lead to the next_partition cost dominating the overall cost.
+        // The heuristic here chooses the strategy with minimal such cost.
+        // Note that with multishard_filter we don't read entire partitions which
+        // can be a huge waste. We only fill the buffer inside
+        // mutation_reader, if a partition is found to belong to the incorrect
+        // master shard, we call next_partition(), which effectively clears
+        // the buffer until the next partition is reached.
+
+        if (!_local_range_estimation) {
+            // this should not normally happen since the master
+            // calls get_estimated_partitions before get_sync_boundary
+            rlogger.warn("repair_reader: meta_id={}, no _local_range_estimation, "
+                         "read_strategy {} is chosen",
+                _repair_meta_id, repair_reader::read_strategy::multishard_split);
+            return repair_reader::read_strategy::multishard_split;
+        }
+
+        const auto read_strategy =
+            _local_range_estimation->partitions_count <= _local_range_estimation->master_subranges_count
+            ? repair_reader::read_strategy::multishard_filter
+            : repair_reader::read_strategy::multishard_split;
+        rlogger.debug("repair_reader: meta_id={}, _local_range_estimation: partitions_count={}, "
+                      "master_subranges_count={}, read_strategy {} is chosen",
+            _repair_meta_id,
+            _local_range_estimation->partitions_count,
+            _local_range_estimation->master_subranges_count,
+            read_strategy);
+        return read_strategy;
+    }
+
     // Read rows from sstable until the size of rows exceeds _max_row_buf_size  - current_size
     // This reads rows from where the reader left last time into _row_buf
     // _current_sync_boundary or _last_sync_boundary have no effect on the reader neither.
@@ -1116,53 +1168,7 @@ class repair_meta {
                 _remote_sharder,
                 _master_node_shard_config.shard,
                 _seed,
-                std::invoke([this]() {
-                    if (_repair_master || _same_sharding_config || _is_tablet) {
-                        rlogger.debug("repair_reader: meta_id={}, _repair_master={}, _same_sharding_config={},"
-                                      "read_strategy {} is chosen",
-                           _repair_meta_id, _repair_master, _same_sharding_config,
-                           repair_reader::read_strategy::local);
-                        return repair_reader::read_strategy::local;
-                    }
-
-                    // multishard_filter means load all the data in the range and apply
-                    // filter by master shard on top, discarding partitions from other shards.
-                    // multishard_split means split the range into multiple subranges,
-                    // each containing only the required data from the master shard.
-                    // For situations with a sparse data set spread across numerous ranges,
-                    // the overhead from continuously switching between these ranges,
-                    // specifically during the fast_forward_to function on the multishard_reader,
-                    // can become the main factor in performance.
-                    // Similarly, with multishard_filter, reading all the partitions within
-                    // the range can lead to the next_partition cost dominating the overall cost.
-                    // The heuristic here chooses the strategy with minimal such cost.
-                    // Note that with multishard_filter we don't read entire partitions which
-                    // can be a huge waste. We only fill the buffer inside
-                    // mutation_reader, if a partition is found to belong to the incorrect
-                    // master shard, we call next_partition(), which effectively clears
-                    // the buffer until the next partition is reached.
-
-                    if (!_local_range_estimation) {
-                        // this should not normally happen since the master
-                        // calls get_estimated_partitions before get_sync_boundary
-                        rlogger.warn("repair_reader: meta_id={}, no _local_range_estimation, "
-                                     "read_strategy {} is chosen",
-                            _repair_meta_id, repair_reader::read_strategy::multishard_split);
-                        return repair_reader::read_strategy::multishard_split;
-                    }
-
-                    const auto read_strategy =
-                        _local_range_estimation->partitions_count <= _local_range_estimation->master_subranges_count
-                        ? repair_reader::read_strategy::multishard_filter
-                        : repair_reader::read_strategy::multishard_split;
-                    rlogger.debug("repair_reader: meta_id={}, _local_range_estimation: partitions_count={}, "
-                                  "master_subranges_count={}, read_strategy {} is chosen",
-                        _repair_meta_id,
-                        _local_range_estimation->partitions_count,
-                        _local_range_estimation->master_subranges_count,
-                        read_strategy);
-                    return read_strategy;
-                }),
+                choose_read_strategy(),
                 _compaction_time);
         }
         try {
@@ -1186,6 +1192,59 @@ class repair_meta {
         co_return value_type(std::move(cur_rows), new_rows_size);
     }
 
+    // Compute the repair_range_summary of the rows in _range, with the same
+    // row hashes as the row level sync uses. A reader of its own is used, so
+    // the reader for the row level sync is not disturbed.
+    future<std::vector<repair_hash>> get_range_summary(uint32_t leaves_count) {
+        auto gate_held = _gate.hold();
+        repair_range_summary::splitter splitter(_range, leaves_count);
+        std::vector<repair_hash> leaves(splitter.leaves_count());
+        _db.local().get_reader_concurrency_semaphore().unregister_inactive_read(std::move(_fake_inactive_read_handle));
+        repair_reader reader(_db,
+            _db.local().find_column_family(_schema->id()),
+            _schema,
+            _permit,
+            _range,
+            _remote_sharder,
+            _master_node_shard_config.shard,
+            _seed,
+            choose_read_strategy(),
+            _compaction_time);
+        std::exception_ptr ex;
+        try {
+            while (true) {
+                _gate.check();
+                mutation_fragment_opt mfopt = co_await reader.read_mutation_fragment();
+                if (!mfopt) {
+                    break;
+                }
+                auto& mf = *mfopt;
+                if (mf.is_partition_start()) {
+                    auto& start = mf.as_partition_start();
+                    reader.set_current_dk(start.key());
+                    if (!start.partition_tombstone()) {
+                        continue;
+                    }
+                } else if (mf.is_end_of_partition()) {
+                    reader.clear_current_dk();
+                    continue;
+                }
+                auto& dk_with_hash = *reader.get_current_dk();
+                leaves[splitter.leaf_of(dk_with_hash.dk.token())].add(_repair_hasher.do_hash_for_mf(dk_with_hash, mf));
+                co_await coroutine::maybe_yield();
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await reader.close();
+        if (ex) {
+            co_await coroutine::return_exception_ptr(std::move(ex));
+        }
+        auto summary = repair_range_summary::build(leaves);
+        rlogger.debug("get_range_summary: meta_id={}, range={}, leaves={}, root={}", _repair_meta_id, _range, leaves.size(), summary.root());
+        co_return summary.nodes();
+    }
+
     future<> clear_row_buf() {
         return utils::clear_gently(_row_buf);
     }
@@ -1621,6 +1680,25 @@ class repair_meta {
         rm->set_repair_state_for_local_node(repair_state::set_estimated_partitions_finished);
     }
 
+    // RPC API
+    future<repair_range_summary> repair_get_range_summary(gms::inet_address remote_node, uint32_t leaves_count, shard_id dst_cpu_id) {
+        if (remote_node == myip()) {
+            co_return repair_range_summary(co_await get_range_summary(leaves_count));
+        }
+        stats().rpc_call_nr++;
+        auto nodes = co_await ser::partition_checksum_rpc_verbs::send_repair_get_range_summary(&_messaging, msg_addr(remote_node), _repair_meta_id, leaves_count, dst_cpu_id);
+        co_return repair_range_summary(std::move(nodes));
+    }
+
+    // RPC handler
+    static future<std::vector<repair_hash>> repair_get_range_summary_handler(repair_service& rs, gms::inet_address from, uint32_t repair_meta_id, uint32_t leaves_count) {
+        auto rm = rs.get_repair_meta(from, repair_meta_id);
+        rm->set_repair_state_for_local_node(repair_state::get_range_summary_started);
+        auto nodes = co_await rm->get_range_summary(leaves_count);
+        rm->set_repair_state_for_local_node(repair_state::get_range_summary_finished);
+        co_return nodes;
+    }
+
     // RPC API
     // Return the largest sync point contained in the _row_buf , current _row_buf checksum, and the _row_buf size
     future<get_sync_boundary_response>
@@ -2450,6 +2528,14 @@ future<> repair_service::init_ms_handlers() {
             return repair_meta::repair_set_estimated_partitions_handler(local_repair, from, repair_meta_id, estimated_partitions);
         });
     });
+    ser::partition_checksum_rpc_verbs::register_repair_get_range_summary(&ms, [this] (const rpc::client_info& cinfo, uint32_t repair_meta_id, uint32_t leaves_count, shard_id dst_cpu_id) {
+        auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
+        auto shard = get_dst_shard_id(src_cpu_id, dst_cpu_id);
+        auto from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
+        return container().invoke_on(shard, [from, repair_meta_id, leaves_count] (repair_service& local_repair) mutable {
+            return repair_meta::repair_get_range_summary_handler(local_repair, from, repair_meta_id, leaves_count);
+        });
+    });
     ms.register_repair_get_diff_algorithms([] (const rpc::client_info& cinfo) {
         return make_ready_future<std::vector<row_level_diff_detect_algorithm>>(suportted_diff_detect_algorithms());
     });
@@ -2482,6 +2568,7 @@ future<> repair_service::uninit_ms_handlers() {
         ms.unregister_repair_get_estimated_partitions(),
         ms.unregister_repair_set_estimated_partitions(),
         ms.unregister_repair_get_diff_algorithms(),
+        ser::partition_checksum_rpc_verbs::unregister_repair_get_range_summary(&ms),
         ser::partition_checksum_rpc_verbs::unregister_repair_update_system_table(&ms),
         ser::partition_checksum_rpc_verbs::unregister_repair_flush_hints_batchlog(&ms)
         ).discard_result();
@@ -2916,23 +3003,203 @@ class row_level_repair {
         co_return;
     }
 
+private:
+    // Start a repair master for the range on this node and the followers,
+    // run func with it, and stop it everywhere. Throws if the repair failed.
+    void with_repair_master(const dht::token_range& range, row_level_diff_detect_algorithm algorithm, size_t max_row_buf_size,
+            gc_clock::time_point compaction_time, noncopyable_function<void (repair_meta&)> func) {
+        auto repair_meta_id = _shard_task.rs.get_next_repair_meta_id().get();
+        auto& cf = _shard_task.db.local().find_column_family(_table_id);
+        auto& sharder = cf.get_effective_replication_map()->get_sharder(*(cf.schema()));
+        auto master_node_shard_config = shard_config {
+                this_shard_id(),
+                sharder.shard_count(),
+                sharder.sharding_ignore_msb()
+        };
+        auto s = cf.schema();
+        auto schema_version = s->version();
+        bool table_dropped = false;
+
+        auto permit = _shard_task.db.local().obtain_reader_permit(_shard_task.db.local().find_column_family(_table_id), "repair-meta", db::no_timeout, {}).get();
+
+        repair_meta master(_shard_task.rs,
+                _shard_task.db.local().find_column_family(_table_id),
+                s,
+                std::move(permit),
+                range,
+                algorithm,
+                max_row_buf_size,
+                _seed,
+                repair_master::yes,
+                repair_meta_id,
+                _shard_task.reason(),
+                std::move(master_node_shard_config),
+                _all_live_peer_nodes,
+                _all_live_peer_nodes.size(),
+                _all_live_peer_shards,
+                this,
+                compaction_time);
+        auto auto_stop_master = defer([&master] {
+            try {
+                master.stop().get();
+            } catch (...) {
+                std::exception_ptr ep = std::current_exception();
+                rlogger.warn("Failed auto-stopping Row Level Repair (Master): {}. Ignored.", ep);
+            }
+        });
+
+        rlogger.debug(">>> Started Row Level Repair (Master): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, schema_version={}, range={}, seed={}, max_row_buf_size={}",
+                master.myip(), _all_live_peer_nodes, master.repair_meta_id(), _shard_task.get_keyspace(), _cf_name, schema_version, range, _seed, max_row_buf_size);
+
+        std::exception_ptr ex = nullptr;
+        std::vector<repair_node_state> nodes_to_stop;
+        nodes_to_stop.reserve(master.all_nodes().size());
+        try {
+            parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
+                const auto& node = ns.node;
+                ns.state = repair_state::row_level_start_started;
+                co_await master.repair_row_level_start(node, _shard_task.get_keyspace(), _cf_name, range, schema_version, _shard_task.reason(), compaction_time, ns.shard);
+                ns.state = repair_state::row_level_start_finished;
+                nodes_to_stop.push_back(ns);
+            })).get();
+
+            func(master);
+        } catch (replica::no_such_column_family& e) {
+            table_dropped = true;
+            rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
+                    _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, range, e);
+            _failed = true;
+        } catch (std::exception& e) {
+            rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
+                    _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, range, e);
+            // In case the repair process fail, we need to call repair_row_level_stop to clean up repair followers
+            _failed = true;
+            ex = std::current_exception();
+        }
+
+        parallel_for_each(nodes_to_stop, coroutine::lambda([&] (repair_node_state& ns) -> future<> {
+            auto node = ns.node;
+            master.set_repair_state(repair_state::row_level_stop_started, node);
+            co_await master.repair_row_level_stop(node, _shard_task.get_keyspace(), _cf_name, range, ns.shard);
+            master.set_repair_state(repair_state::row_level_stop_finished, node);
+        })).get();
+
+        _shard_task.update_statistics(master.stats());
+        if (_failed) {
+            if (table_dropped) {
+                throw replica::no_such_column_family(_shard_task.get_keyspace(),  _cf_name);
+            } else {
+                throw nested_exception(std::make_exception_ptr(std::runtime_error(fmt::format("Failed to repair for keyspace={}, cf={}, range={}", _shard_task.get_keyspace(),
+                                        _cf_name, range))), std::move(ex));
+            }
+        }
+        rlogger.debug("<<< Finished Row Level Repair (Master): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, range={}, tx_hashes_nr={}, rx_hashes_nr={}, tx_row_nr={}, rx_row_nr={}, row_from_disk_bytes={}, row_from_disk_nr={}",
+                master.myip(), _all_live_peer_nodes, master.repair_meta_id(), _shard_task.get_keyspace(), _cf_name, range, master.stats().tx_hashes_nr, master.stats().rx_hashes_nr, master.stats().tx_row_nr, master.stats().rx_row_nr, master.stats().row_from_disk_bytes, master.stats().row_from_disk_nr);
+    }
+
+    // Sync the rows of the range of the master with the followers, round by round.
+    void sync_rows(repair_meta& master) {
+        _estimated_partitions = 0;
+        _common_sync_boundary = std::nullopt;
+        _skipped_sync_boundary = std::nullopt;
+
+        parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
+            const auto& node = ns.node;
+            ns.state = repair_state::get_estimated_partitions_started;
+            uint64_t partitions = co_await master.repair_get_estimated_partitions(node, ns.shard);
+            ns.state = repair_state::get_estimated_partitions_finished;
+            rlogger.trace("Get repair_get_estimated_partitions for node={}, estimated_partitions={}", node, partitions);
+            _estimated_partitions += partitions;
+        })).get();
+
+        if (!master.all_nodes().empty()) {
+            // Use the average number of partitions, instead of the sum
+            // of the partitions, as the estimated partitions in a
+            // given range. The bigger the estimated partitions, the
+            // more memory bloom filter for the sstable would consume.
+            _estimated_partitions /= master.all_nodes().size();
+
+            // In addition, estimate the difference between nodes is
+            // less than the specified ratio for regular repair.
+            // Underestimation will not be a big problem since those
+            // sstables produced by repair will go through off-strategy
+            // later anyway. The worst case is that we have a worse
+            // false positive ratio than expected temporarily when the
+            // sstable is still in maintenance set.
+            //
+            // To save memory and have less different conditions, we
+            // use the estimation for RBNO repair as well.
+
+            _estimated_partitions *= _shard_task.db.local().get_config().repair_partition_count_estimation_ratio();
+        }
+
+        parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
+            const auto& node = ns.node;
+            rlogger.trace("Get repair_set_estimated_partitions for node={}, estimated_partitions={}", node, _estimated_partitions);
+            ns.state = repair_state::set_estimated_partitions_started;
+            co_await master.repair_set_estimated_partitions(node, _estimated_partitions, ns.shard);
+            ns.state = repair_state::set_estimated_partitions_finished;
+        })).get();
+
+        while (true) {
+            auto status = negotiate_sync_boundary(master);
+            if (status == op_status::next_round) {
+                continue;
+            } else if (status == op_status::all_done) {
+                break;
+            }
+            status = get_missing_rows_from_follower_nodes(master);
+            if (status == op_status::next_round) {
+                continue;
+            }
+            send_missing_rows_to_follower_nodes(master);
+        }
+    }
+
+    // Maximum number of sub-ranges synced separately after comparing the
+    // range summaries. Each needs its own start and stop of the followers.
+    static constexpr size_t max_summary_sync_ranges = 16;
+
+    // Compare the repair_range_summary of _range on all the nodes and
+    // return the sub-ranges which differ, to be synced row by row.
+    // Returns no ranges if the nodes hold the same rows in the range.
+    dht::token_range_vector get_ranges_to_sync(row_level_diff_detect_algorithm algorithm, size_t max_row_buf_size,
+            gc_clock::time_point compaction_time, uint32_t leaves_count) {
+        repair_range_summary::splitter splitter(_range, leaves_count);
+        std::vector<repair_range_summary> summaries;
+        with_repair_master(_range, algorithm, max_row_buf_size, compaction_time, [&] (repair_meta& master) {
+            // The followers choose how to read the range based on the estimation.
+            parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
+                ns.state = repair_state::get_estimated_partitions_started;
+                co_await master.repair_get_estimated_partitions(ns.node, ns.shard);
+                ns.state = repair_state::get_estimated_partitions_finished;
+            })).get();
+            summaries.resize(master.all_nodes().size());
+            parallel_for_each(boost::irange(size_t(0), master.all_nodes().size()), coroutine::lambda([&] (size_t idx) -> future<> {
+                auto& ns = master.all_nodes()[idx];
+                ns.state = repair_state::get_range_summary_started;
+                summaries[idx] = co_await master.repair_get_range_summary(ns.node, leaves_count, ns.shard);
+                ns.state = repair_state::get_range_summary_finished;
+            })).get();
+        });
+        auto leaves = repair_range_summary::differing_leaves(summaries, splitter.leaves_count());
+        dht::token_range_vector ranges;
+        if (!leaves.empty()) {
+            for (auto [first, last] : merge_leaves_into_runs(leaves, max_summary_sync_ranges)) {
+                ranges.push_back(splitter.leaves_range(first, last));
+            }
+        }
+        rlogger.debug("repair[{}]: keyspace={}, cf={}, range={}, leaves={}, differing_leaves={}, ranges_to_sync={}",
+                _shard_task.global_repair_id.uuid(), _shard_task.get_keyspace(), _cf_name, _range, splitter.leaves_count(), leaves.size(), ranges);
+        return ranges;
+    }
+
 public:
     future<> run() {
         return seastar::async([this] {
             _shard_task.check_in_abort_or_shutdown();
-            auto repair_meta_id = _shard_task.rs.get_next_repair_meta_id().get();
             auto algorithm = get_common_diff_detect_algorithm(_shard_task.messaging.local(), _all_live_peer_nodes);
             auto max_row_buf_size = get_max_row_buf_size(algorithm);
-            auto& cf = _shard_task.db.local().find_column_family(_table_id);
-            auto& sharder = cf.get_effective_replication_map()->get_sharder(*(cf.schema()));
-            auto master_node_shard_config = shard_config {
-                    this_shard_id(),
-                    sharder.shard_count(),
-                    sharder.sharding_ignore_msb()
-            };
-            auto s = cf.schema();
-            auto schema_version = s->version();
-            bool table_dropped = false;
 
             auto& mem_sem = _shard_task.rs.memory_sem();
             auto max = _shard_task.rs.max_repair_memory();
@@ -2944,131 +3211,27 @@ class row_level_repair {
             rlogger.trace("repair[{}]: Finished to get memory budget, wanted={}, available={}, max_repair_memory={}",
                     _shard_task.global_repair_id.uuid(), wanted, mem_sem.current(), max);
 
-            auto permit = _shard_task.db.local().obtain_reader_permit(_shard_task.db.local().find_column_family(_table_id), "repair-meta", db::no_timeout, {}).get();
-
             auto compaction_time = gc_clock::now();
 
-            repair_meta master(_shard_task.rs,
-                    _shard_task.db.local().find_column_family(_table_id),
-                    s,
-                    std::move(permit),
-                    _range,
-                    algorithm,
-                    max_row_buf_size,
-                    _seed,
-                    repair_master::yes,
-                    repair_meta_id,
-                    _shard_task.reason(),
-                    std::move(master_node_shard_config),
-                    _all_live_peer_nodes,
-                    _all_live_peer_nodes.size(),
-                    _all_live_peer_shards,
-                    this,
-                    compaction_time);
-            auto auto_stop_master = defer([&master] {
-                try {
-                    master.stop().get();
-                } catch (...) {
-                    std::exception_ptr ep = std::current_exception();
-                    rlogger.warn("Failed auto-stopping Row Level Repair (Master): {}. Ignored.", ep);
-                }
-            });
-
-            rlogger.debug(">>> Started Row Level Repair (Master): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, schema_version={}, range={}, seed={}, max_row_buf_size={}",
-                    master.myip(), _all_live_peer_nodes, master.repair_meta_id(), _shard_task.get_keyspace(), _cf_name, schema_version, _range, _seed, max_row_buf_size);
-
-            std::exception_ptr ex = nullptr;
-            std::vector<repair_node_state> nodes_to_stop;
-            nodes_to_stop.reserve(master.all_nodes().size());
-            try {
-                parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
-                    const auto& node = ns.node;
-                    ns.state = repair_state::row_level_start_started;
-                    co_await master.repair_row_level_start(node, _shard_task.get_keyspace(), _cf_name, _range, schema_version, _shard_task.reason(), compaction_time, ns.shard);
-                    ns.state = repair_state::row_level_start_finished;
-                    nodes_to_stop.push_back(ns);
-                    ns.state = repair_state::get_estimated_partitions_started;
-                    uint64_t partitions = co_await master.repair_get_estimated_partitions(node, ns.shard);
-                    ns.state = repair_state::get_estimated_partitions_finished;
-                    rlogger.trace("Get repair_get_estimated_partitions for node={}, estimated_partitions={}", node, partitions);
-                    _estimated_partitions += partitions;
-                })).get();
-
-                if (!master.all_nodes().empty()) {
-                    // Use the average number of partitions, instead of the sum
-                    // of the partitions, as the estimated partitions in a
-                    // given range. The bigger the estimated partitions, the
-                    // more memory bloom filter for the sstable would consume.
-                    _estimated_partitions /= master.all_nodes().size();
-
-                    // In addition, estimate the difference between nodes is
-                    // less than the specified ratio for regular repair.
-                    // Underestimation will not be a big problem since those
-                    // sstables produced by repair will go through off-strategy
-                    // later anyway. The worst case is that we have a worse
-                    // false positive ratio than expected temporarily when the
-                    // sstable is still in maintenance set.
-                    //
-                    // To save memory and have less different conditions, we
-                    // use the estimation for RBNO repair as well.
-
-                    _estimated_partitions *= _shard_task.db.local().get_config().repair_partition_count_estimation_ratio();
+            // Compare the summaries of the range first, and skip the row
+            // level sync for the parts of the range where they agree.
+            auto& db = _shard_task.db.local();
+            uint32_t leaves_count = db.features().repair_range_summary ? db.get_config().repair_range_summary_leaves() : 0;
+            auto ranges = dht::token_range_vector{_range};
+            if (leaves_count > 1 && !_all_live_peer_nodes.empty()) {
+                ranges = get_ranges_to_sync(algorithm, max_row_buf_size, compaction_time, leaves_count);
+                if (ranges.empty()) {
+                    repair_stats stats;
+                    stats.round_nr_fast_path_same_summary++;
+                    _shard_task.update_statistics(stats);
                 }
-
-                parallel_for_each(master.all_nodes(), coroutine::lambda([&] (repair_node_state& ns) -> future<> {
-                    const auto& node = ns.node;
-                    rlogger.trace("Get repair_set_estimated_partitions for node={}, estimated_partitions={}", node, _estimated_partitions);
-                    ns.state = repair_state::set_estimated_partitions_started;
-                    co_await master.repair_set_estimated_partitions(node, _estimated_partitions, ns.shard);
-                    ns.state = repair_state::set_estimated_partitions_finished;
-                })).get();
-
-                while (true) {
-                    auto status = negotiate_sync_boundary(master);
-                    if (status == op_status::next_round) {
-                        continue;
-                    } else if (status == op_status::all_done) {
-                        break;
-                    }
-                    status = get_missing_rows_from_follower_nodes(master);
-                    if (status == op_status::next_round) {
-                        continue;
-                    }
-                    send_missing_rows_to_follower_nodes(master);
-                }
-            } catch (replica::no_such_column_family& e) {
-                table_dropped = true;
-                rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
-                        _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, _range, e);
-                _failed = true;
-            } catch (std::exception& e) {
-                rlogger.warn("repair[{}]: shard={}, keyspace={}, cf={}, range={}, got error in row level repair: {}",
-                        _shard_task.global_repair_id.uuid(), this_shard_id(), _shard_task.get_keyspace(), _cf_name, _range, e);
-                // In case the repair process fail, we need to call repair_row_level_stop to clean up repair followers
-                _failed = true;
-                ex = std::current_exception();
-            }
-
-            parallel_for_each(nodes_to_stop, coroutine::lambda([&] (repair_node_state& ns) -> future<> {
-                auto node = ns.node;
-                master.set_repair_state(repair_state::row_level_stop_started, node);
-                co_await master.repair_row_level_stop(node, _shard_task.get_keyspace(), _cf_name, _range, ns.shard);
-                master.set_repair_state(repair_state::row_level_stop_finished, node);
-            })).get();
-
-            _shard_task.update_statistics(master.stats());
-            if (_failed) {
-                if (table_dropped) {
-                    throw replica::no_such_column_family(_shard_task.get_keyspace(),  _cf_name);
-                } else {
-                    throw nested_exception(std::make_exception_ptr(std::runtime_error(fmt::format("Failed to repair for keyspace={}, cf={}, range={}", _shard_task.get_keyspace(),
-                                            _cf_name, _range))), std::move(ex));
-                }
-            } else {
-                update_system_repair_table().get();
             }
-            rlogger.debug("<<< Finished Row Level Repair (Master): local={}, peers={}, repair_meta_id={}, keyspace={}, cf={}, range={}, tx_hashes_nr={}, rx_hashes_nr={}, tx_row_nr={}, rx_row_nr={}, row_from_disk_bytes={}, row_from_disk_nr={}",
-                    master.myip(), _all_live_peer_nodes, master.repair_meta_id(), _shard_task.get_keyspace(), _cf_name, _range, master.stats().tx_hashes_nr, master.stats().rx_hashes_nr, master.stats().tx_row_nr, master.stats().rx_row_nr, master.stats().row_from_disk_bytes, master.stats().row_from_disk_nr);
+            for (auto& range : ranges) {
+                with_repair_master(range, algorithm, max_row_buf_size, compaction_time, [this] (repair_meta& master) {
+                    sync_rows(master);
+                });
+            }
+            update_system_repair_table().get();
         });
     }
 };
@@ -7,6 +7,7 @@
  */
 
 #include <algorithm>
+#include <span>
 
 #include <fmt/ranges.h>
 #include <fmt/std.h>
@@ -28,6 +29,7 @@
 #include <seastar/core/seastar.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/coroutine/as_future.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/metrics.hh>
@@ -229,6 +231,7 @@ void database::setup_scylla_memory_diagnostics_producer() {
                 {"system", _system_read_concurrency_sem},
                 {"compaction", _compaction_concurrency_sem},
                 {"view update", _view_update_read_concurrency_sem},
+                {"batch", _batch_read_concurrency_sem},
         };
         for (const auto& [name, sem] : semaphores) {
             const auto initial_res = sem.initial_resources();
@@ -322,7 +325,7 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _cfg(cfg)
     // Allow system tables a pool of 10 MB memory to write, but never block on other regions.
     , _system_dirty_memory_manager(*this, 10 << 20, cfg.unspooled_dirty_soft_limit(), default_scheduling_group())
-    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.50, cfg.unspooled_dirty_soft_limit(), dbcfg.statement_scheduling_group)
+    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.50, cfg.unspooled_dirty_soft_limit(), dbcfg.statement_scheduling_group, cfg.unspooled_dirty_table_budget())
     , _dbcfg(dbcfg)
     , _flush_sg(dbcfg.memtable_scheduling_group)
     , _memtable_controller(make_flush_controller(_cfg, _flush_sg, [this, limit = float(_dirty_memory_manager.throttle_threshold())] {
@@ -372,6 +375,15 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
             _cfg.view_update_reader_concurrency_semaphore_kill_limit_multiplier,
             _cfg.view_update_reader_concurrency_semaphore_cpu_concurrency,
             reader_concurrency_semaphore::register_metrics::yes)
+    , _batch_read_concurrency_sem(
+            utils::updateable_value<int>(max_count_concurrent_batch_reads),
+            max_memory_concurrent_batch_reads(),
+            "batch",
+            max_inactive_batch_queue_length(),
+            _cfg.reader_concurrency_semaphore_serialize_limit_multiplier,
+            _cfg.reader_concurrency_semaphore_kill_limit_multiplier,
+            _cfg.reader_concurrency_semaphore_cpu_concurrency,
+            reader_concurrency_semaphore::register_metrics::yes)
     , _row_cache_tracker(_cfg.index_cache_fraction.operator utils::updateable_value<double>(), cache_tracker::register_metrics::yes)
     , _apply_stage("db_apply", &database::do_apply)
     , _version(empty_version)
@@ -405,6 +417,10 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     setup_metrics();
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    _row_cache_tracker.set_scan_resistant_admission(_cfg.cache_scan_resistant_admission);
+    _read_concurrency_sem.set_io_cost_delay(_cfg.reader_concurrency_semaphore_io_cost_delay_us);
+    _batch_read_concurrency_sem.set_io_cost_delay(_cfg.reader_concurrency_semaphore_io_cost_delay_us);
+    _querier_cache.set_lookup_by_position(_cfg.querier_cache_lookup_by_position);
 
     setup_scylla_memory_diagnostics_producer();
     if (_dbcfg.sstables_format) {
@@ -528,6 +544,10 @@ database::setup_metrics() {
                        sm::description(seastar::format("Holds the current number of requests blocked due to reaching the memory quota ({}B). "
                                        "Non-zero value indicates that our bottleneck is memory and more specifically - the memory quota allocated for the \"database\" component.", _dirty_memory_manager.throttle_threshold()))),
 
+        sm::make_counter("requests_blocked_memory_budget", [this] { return _dirty_memory_manager.region_group().budget_blocked_requests_counter(); },
+                       sm::description("Holds the number of requests delayed because their table used more than its share of the memory quota, "
+                                       "while the quota was under pressure. Such requests aren't counted in requests_blocked_memory.")),
+
         sm::make_counter("clustering_filter_count", _cf_stats.clustering_filter_count,
                        sm::description("Counts bloom filter invocations.")),
 
@@ -561,10 +581,19 @@ database::setup_metrics() {
         sm::make_counter("total_writes_rate_limited", _stats->total_writes_rate_limited,
                        sm::description("Counts write operations which were rejected on the replica side because the per-partition limit was reached.")),
 
+        sm::make_counter("total_writes_expired", _stats->total_writes_expired,
+                       sm::description("Counts write operations which were dropped without being applied because their timeout passed before the replica started working on them. "
+                                       "Such writes are also counted in total_writes_timedout.")),
 
         sm::make_counter("total_reads_rate_limited", _stats->total_reads_rate_limited,
                        sm::description("Counts read operations which were rejected on the replica side because the per-partition limit was reached.")),
 
+        sm::make_counter("total_reads_expired", _stats->total_reads_expired,
+                       sm::description("Counts read operations which were dropped without being executed because their timeout passed before the replica started working on them.")),
+
+        sm::make_counter("total_reads_not_cached", _stats->total_reads_not_cached,
+                       sm::description("Counts CACHE ONLY read operations which were rejected because their data wasn't fully in the cache.")),
+
         sm::make_current_bytes("view_update_backlog", [this] { return get_view_update_backlog().get_current_bytes(); },
                        sm::description("Holds the current size in bytes of the pending view updates for all tables")),
 
@@ -574,6 +603,9 @@ database::setup_metrics() {
         sm::make_counter("querier_cache_misses", _querier_cache.get_stats().misses,
                        sm::description("Counts querier cache lookups that failed to find a cached querier")),
 
+        sm::make_counter("querier_cache_position_hits", _querier_cache.get_stats().position_hits,
+                       sm::description("Counts querier cache lookups that found no querier for their query, but reused the querier of another query with a matching position")),
+
         sm::make_counter("querier_cache_drops", _querier_cache.get_stats().drops,
                        sm::description("Counts querier cache lookups that found a cached querier but had to drop it")),
 
@@ -590,6 +622,15 @@ database::setup_metrics() {
         sm::make_gauge("querier_cache_population", _querier_cache.get_stats().population,
                        sm::description("The number of entries currently in the querier cache.")),
 
+        sm::make_counter("shared_scans", _querier_cache.get_shared_scans().get_stats().scans,
+                       sm::description("Counts the shared scans started, see enable_shared_scans.")),
+
+        sm::make_counter("shared_scan_joined_readers", _querier_cache.get_shared_scans().get_stats().joined_readers,
+                       sm::description("Counts range scans which joined an already started shared scan, instead of reading on their own.")),
+
+        sm::make_counter("shared_scan_detached_readers", _querier_cache.get_shared_scans().get_stats().detached_readers,
+                       sm::description("Counts range scans which lagged too far behind their shared scan, and continued reading on their own.")),
+
     });
 
     // Registering all the metrics with a single call causes the stack size to blow up.
@@ -597,6 +638,9 @@ database::setup_metrics() {
         sm::make_gauge("total_result_bytes", [this] { return get_result_memory_limiter().total_used_memory(); },
                        sm::description("Holds the current amount of memory used for results.")),
 
+        sm::make_counter("coalesced_counter_updates", _stats->coalesced_counter_updates,
+                       sm::description("Counts counter updates which were merged into a pending update of the same partition on the leader replica.")),
+
         sm::make_counter("short_data_queries", _stats->short_data_queries,
                        sm::description("The rate of data queries (data or digest reads) that returned less rows than requested due to result size limiting.")),
 
@@ -625,6 +669,9 @@ database::setup_metrics() {
             sm::description("Number of large partitions exceeding compaction_large_partition_warning_threshold_mb. "
                 "Large partitions have performance impact and should be avoided, check the documentation for details.")),
 
+        sm::make_counter("large_data_records_dropped", [this] { return _large_data_handler->stats().records_dropped; },
+            sm::description("Number of records of large partitions, rows and cells which weren't written to the system tables, because too many were waiting to be written.")),
+
         sm::make_total_operations("total_view_updates_pushed_local", _cf_stats.total_view_updates_pushed_local,
                 sm::description("Total number of view updates generated for tables and applied locally.")),
 
@@ -674,17 +721,19 @@ do_parse_schema_tables(distributed<service::storage_proxy>& proxy, const sstring
     using namespace db::schema_tables;
 
     auto rs = co_await db::system_keyspace::query(proxy.local().get_db(), db::schema_tables::NAME, cf_name);
-    auto names = std::set<sstring>();
+    // Split the table into the partitions of the keyspaces, rather than
+    // reading each of them again.
+    auto rows = std::map<sstring, std::vector<query::result_set_row>>();
     for (auto& r : rs->rows()) {
         auto keyspace_name = r.template get_nonnull<sstring>("keyspace_name");
-        names.emplace(keyspace_name);
-    }
-    co_await coroutine::parallel_for_each(names.begin(), names.end(), [&] (sstring name) mutable -> future<> {
-        if (is_system_keyspace(name)) {
-            co_return;
+        if (!is_system_keyspace(keyspace_name)) {
+            rows[keyspace_name].push_back(r);
         }
-
-        auto v = co_await read_schema_partition_for_keyspace(proxy, cf_name, name);
+        co_await coroutine::maybe_yield();
+    }
+    co_await coroutine::parallel_for_each(rows.begin(), rows.end(), [&] (auto& keyspace_rows) mutable -> future<> {
+        auto& [name, ks_rows] = keyspace_rows;
+        auto v = schema_result_value_type{name, make_lw_shared<query::result_set>(rs->schema(), std::move(ks_rows))};
         try {
             co_await func(v);
         } catch (...) {
@@ -783,7 +832,7 @@ database::init_commitlog() {
                 return;
             }
             // Initiate a background flush. Waited upon in `stop()`.
-            (void)_tables_metadata.get_table(id).flush(pos);
+            (void)_tables_metadata.get_table(id).release_commitlog_segments(pos);
         }).release(); // we have longer life time than CL. Ignore reg anchor
 
         _cfg.commitlog_max_data_lifetime_in_seconds.observe([this](uint32_t max_time) {
@@ -865,6 +914,7 @@ void database::init_schema_commitlog() {
     c.mode = db::commitlog::sync_mode::BATCH;
     c.extensions = &_cfg.extensions();
     c.use_o_dsync = _cfg.commitlog_use_o_dsync();
+    c.use_vectored_writes = _cfg.commitlog_use_vectored_writes();
     c.allow_going_over_size_limit = true; // for lower latency
     if (features().fragmented_commitlog_entries) {
         c.allow_fragmented_entries = true;
@@ -1264,6 +1314,8 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.data_listeners = &db.data_listeners();
     cfg.enable_compacting_data_for_streaming_and_repair = db_config.enable_compacting_data_for_streaming_and_repair;
     cfg.enable_tombstone_gc_for_streaming_and_repair = db_config.enable_tombstone_gc_for_streaming_and_repair;
+    cfg.commitlog_relog_memtable_max_size_in_kb = db_config.commitlog_relog_memtable_max_size_in_kb;
+    cfg.commitlog_max_data_lifetime_in_seconds = db_config.commitlog_max_data_lifetime_in_seconds;
 
     return cfg;
 }
@@ -1429,9 +1481,10 @@ std::optional<db::rate_limiter::can_proceed> database::account_coordinator_opera
         db::per_partition_rate_limit::account_and_enforce account_and_enforce_info,
         db::operation_type op_type) {
 
-    std::optional<uint32_t> table_limit = tbl.schema()->per_partition_rate_limit_options().get_max_ops_per_second(op_type);
+    const auto& opts = tbl.schema()->per_partition_rate_limit_options();
+    std::optional<uint32_t> table_limit = opts.get_max_ops_per_second(op_type);
     db::rate_limiter::label& lbl = tbl.get_rate_limiter_label_for_op_type(op_type);
-    return _rate_limiter.account_operation(lbl, dht::token::to_int64(token), *table_limit, account_and_enforce_info);
+    return _rate_limiter.account_operation(lbl, dht::token::to_int64(token), *table_limit, account_and_enforce_info, opts.get_accounting());
 }
 
 static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
@@ -1447,6 +1500,7 @@ static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
     }
 
     auto table_limit = *cf.schema()->per_partition_rate_limit_options().get_max_reads_per_second();
+    auto accounting = cf.schema()->per_partition_rate_limit_options().get_accounting();
     can_proceed ret = can_proceed::yes;
 
     auto& read_label = cf.get_rate_limiter_label_for_reads();
@@ -1455,7 +1509,7 @@ static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
             continue;
         }
         auto token = dht::token::to_int64(ranges.front().start()->value().token());
-        if (limiter.account_operation(read_label, token, table_limit, rate_limit_info) == db::rate_limiter::can_proceed::no) {
+        if (limiter.account_operation(read_label, token, table_limit, rate_limit_info, accounting) == db::rate_limiter::can_proceed::no) {
             // Don't return immediately - account all ranges first
             ret = can_proceed::no;
         }
@@ -1464,9 +1518,69 @@ static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
     return ret;
 }
 
+// Whether the read of the partition is fully resident in the cache, so it
+// won't go to disk. Memtables are always in memory, so it's enough for the
+// cache to have the data of the sstables.
+static bool is_resident_in_cache(column_family& cf, const schema& s, const query::partition_slice& slice, const dht::partition_range& range) {
+    if (!range.is_singular() || !range.start()->value().has_key()) {
+        return false;
+    }
+    const auto dk = range.start()->value().as_decorated_key();
+    const bool with_static_row = !slice.static_columns.empty();
+    return cf.get_row_cache().is_resident(dk, slice.row_ranges(s, dk.key()), with_static_row);
+}
+
+// Whether a read with the cache_only option can be served by the cache: all
+// its ranges have to be fully resident partitions. Reversed slices are checked
+// with their clustering ranges in table order.
+// The check is done before admission, so the data can still be evicted
+// before the read gets to it, in which case it is read from disk.
+static bool can_serve_from_cache_only(column_family& cf, const schema& s, const query::partition_slice& slice, std::span<const dht::partition_range> ranges) {
+    if (!slice.options.contains(query::partition_slice::option::cache_only)) {
+        return true;
+    }
+    if (!cf.cache_enabled()) {
+        return false;
+    }
+    auto is_resident = [&] (const schema& table_schema, const query::partition_slice& table_slice) {
+        return std::ranges::all_of(ranges, [&] (const dht::partition_range& range) {
+            return is_resident_in_cache(cf, table_schema, table_slice, range);
+        });
+    };
+    return slice.is_reversed() ? is_resident(*cf.schema(), query::reverse_slice(s, slice)) : is_resident(s, slice);
+}
+
+// Chooses the admission lane of a read: reads of a single partition which is
+// fully resident in the cache don't go to disk, so they don't have to wait
+// behind the reads which do.
+// The I/O cost of the other reads is estimated if admission is to use it.
+static reader_concurrency_semaphore::admission_hints make_admission_hints(const db::config& cfg, column_family& cf, const schema& s,
+        const query::partition_slice& slice, const dht::partition_range_vector& ranges) {
+    using admission_lane = reader_concurrency_semaphore::admission_lane;
+    auto is_resident = [&] {
+        if (!cfg.reader_concurrency_semaphore_cache_admission_lane() || !cf.cache_enabled()
+                || slice.options.contains(query::partition_slice::option::bypass_cache) || slice.is_reversed()) {
+            return false;
+        }
+        return ranges.size() == 1 && is_resident_in_cache(cf, s, slice, ranges.front());
+    };
+    if (is_resident()) {
+        return {.lane = admission_lane::cache};
+    }
+    if (!cfg.reader_concurrency_semaphore_io_cost_delay_us()) {
+        return {};
+    }
+    return {.io_cost = cf.estimate_read_io_cost(ranges)};
+}
+
 future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
 database::query(schema_ptr query_schema, const query::read_command& cmd, query::result_options opts, const dht::partition_range_vector& ranges,
                 tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout, db::per_partition_rate_limit::info rate_limit_info) {
+    if (timeout <= db::timeout_clock::now()) {
+        // The coordinator gave up on this read already, don't waste a permit on it.
+        ++_stats->total_reads_expired;
+        co_await coroutine::return_exception(timed_out_error{});
+    }
     column_family& cf = find_column_family(cmd.cf_id);
 
     if (account_singular_ranges_to_rate_limit(_rate_limiter, cf, ranges, _dbcfg, rate_limit_info) == db::rate_limiter::can_proceed::no) {
@@ -1474,6 +1588,11 @@ database::query(schema_ptr query_schema, const query::read_command& cmd, query::
         co_await coroutine::return_exception(replica::rate_limit_exception());
     }
 
+    if (!can_serve_from_cache_only(cf, *query_schema, cmd.slice, ranges)) {
+        ++_stats->total_reads_not_cached;
+        co_await coroutine::return_exception(replica::not_cached_exception());
+    }
+
     auto& semaphore = get_reader_concurrency_semaphore();
     auto max_result_size = cmd.max_result_size ? *cmd.max_result_size : get_query_max_result_size();
 
@@ -1502,7 +1621,8 @@ database::query(schema_ptr query_schema, const query::read_command& cmd, query::
             querier_opt->permit().set_trace_state(trace_state);
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
-            f = co_await coroutine::as_future(semaphore.with_permit(query_schema, "data-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func));
+            const auto hints = make_admission_hints(_cfg, cf, *query_schema, cmd.slice, ranges);
+            f = co_await coroutine::as_future(semaphore.with_permit(query_schema, "data-query", cf.estimate_read_memory_cost(), timeout, trace_state, read_func, hints));
         }
 
         if (!f.failed()) {
@@ -1533,11 +1653,19 @@ database::query(schema_ptr query_schema, const query::read_command& cmd, query::
 future<std::tuple<reconcilable_result, cache_temperature>>
 database::query_mutations(schema_ptr query_schema, const query::read_command& cmd, const dht::partition_range& range,
                           tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
+    if (timeout <= db::timeout_clock::now()) {
+        ++_stats->total_reads_expired;
+        co_await coroutine::return_exception(timed_out_error{});
+    }
     const auto short_read_allwoed = query::short_read(cmd.slice.options.contains<query::partition_slice::option::allow_short_read>());
     auto& semaphore = get_reader_concurrency_semaphore();
     auto max_result_size = cmd.max_result_size ? *cmd.max_result_size : get_query_max_result_size();
-    auto accounter = co_await get_result_memory_limiter().new_mutation_read(max_result_size, short_read_allwoed);
     column_family& cf = find_column_family(cmd.cf_id);
+    if (!can_serve_from_cache_only(cf, *query_schema, cmd.slice, std::span(&range, 1))) {
+        ++_stats->total_reads_not_cached;
+        co_await coroutine::return_exception(replica::not_cached_exception());
+    }
+    auto accounter = co_await get_result_memory_limiter().new_mutation_read(max_result_size, short_read_allwoed);
 
     std::optional<query::querier> querier_opt;
     reconcilable_result result;
@@ -1607,6 +1735,9 @@ query::max_result_size database::get_query_max_result_size() const {
 }
 
 reader_concurrency_semaphore& database::get_reader_concurrency_semaphore() {
+    if (_dbcfg.batch_statement_scheduling_group && current_scheduling_group() == *_dbcfg.batch_statement_scheduling_group) {
+        return _batch_read_concurrency_sem;
+    }
     switch (classify_request(_dbcfg)) {
         case request_class::user: return _read_concurrency_sem;
         case request_class::system: return _system_read_concurrency_sem;
@@ -1637,7 +1768,7 @@ future<> database::clear_inactive_reads_for_tablet(table_id table, dht::token_ra
 }
 
 future<> database::foreach_reader_concurrency_semaphore(std::function<future<>(reader_concurrency_semaphore&)> func) {
-    for (auto* sem : {&_read_concurrency_sem, &_streaming_concurrency_sem, &_compaction_concurrency_sem, &_system_read_concurrency_sem, &_view_update_read_concurrency_sem}) {
+    for (auto* sem : {&_read_concurrency_sem, &_streaming_concurrency_sem, &_compaction_concurrency_sem, &_system_read_concurrency_sem, &_view_update_read_concurrency_sem, &_batch_read_concurrency_sem}) {
         co_await func(*sem);
     }
 }
@@ -1662,6 +1793,67 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
     auto m = fm.unfreeze(m_schema);
     m.upgrade(cf.schema());
 
+    if (!_cfg.enable_counter_update_coalescing()) {
+        co_return co_await read_modify_write_counters(cf, std::move(m), timeout, std::move(trace_state));
+    }
+
+    // Updates of a hot partition would otherwise each wait for the counter
+    // cell locks and then read the partition again. Instead, the updates which
+    // arrive while one is being applied are merged - their deltas add up - and
+    // applied together, as soon as it's done. Every update merged into a batch
+    // gets the resulting mutation, which holds the counter shards of all of
+    // them, to replicate. This is safe, as counter shards merge idempotently.
+    auto key = counter_update_queue_key(cf.schema()->id(), to_bytes(m.key().representation()));
+    auto it = _counter_update_queues.find(key);
+    if (it == _counter_update_queues.end()) {
+        _counter_update_queues.emplace(key, counter_update_queue{});
+        auto finish = defer([this, &key] () noexcept { finish_counter_update(key); });
+        co_return co_await read_modify_write_counters(cf, std::move(m), timeout, std::move(trace_state));
+    }
+
+    auto& queue = it->second;
+    if (queue.next) {
+        if (queue.next->m.schema() != m.schema()) {
+            // Applied on their own, the cell locks still serialize the updates.
+            co_return co_await read_modify_write_counters(cf, std::move(m), timeout, std::move(trace_state));
+        }
+        tracing::trace(trace_state, "Merging counter update into a pending one");
+        ++_stats->coalesced_counter_updates;
+        queue.next->m.apply(std::move(m));
+        queue.next->timeout = std::max(queue.next->timeout, timeout);
+        co_return co_await queue.next->done.get_shared_future(timeout);
+    }
+
+    auto batch = make_lw_shared<counter_update_batch>(std::move(m), timeout);
+    queue.next = batch;
+    tracing::trace(trace_state, "Waiting for the pending counter update of the partition");
+    co_await queue.next_turn.get_future();
+
+    auto finish = defer([this, &key] () noexcept { finish_counter_update(key); });
+    try {
+        auto result = co_await read_modify_write_counters(cf, std::move(batch->m), batch->timeout, std::move(trace_state));
+        batch->done.set_value(result);
+        co_return result;
+    } catch (...) {
+        batch->done.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+void database::finish_counter_update(const counter_update_queue_key& key) noexcept {
+    auto it = _counter_update_queues.find(key);
+    auto& queue = it->second;
+    if (!queue.next) {
+        _counter_update_queues.erase(it);
+        return;
+    }
+    // The next batch is sealed, further updates are merged into a new one.
+    queue.next = nullptr;
+    std::exchange(queue.next_turn, promise<>()).set_value();
+}
+
+future<mutation> database::read_modify_write_counters(column_family& cf, mutation m, db::timeout_clock::time_point timeout,
+                                                      tracing::trace_state_ptr trace_state) {
     // prepare partition slice
     query::column_id_vector static_columns;
     static_columns.reserve(m.partition().static_row().size());
@@ -1916,11 +2108,26 @@ future<> database::do_apply(schema_ptr s, const frozen_mutation& m, tracing::tra
     auto uuid = m.column_family_id();
     auto& cf = find_column_family(uuid);
 
+    // The write may have waited in the apply stage (or behind the view update
+    // lock below) past its timeout, nobody waits for it anymore.
+    auto check_expired = [&] {
+        if (timeout <= db::timeout_clock::now()) {
+            ++_stats->total_writes_timedout;
+            ++_stats->total_writes_expired;
+            return true;
+        }
+        return false;
+    };
+    if (check_expired()) {
+        co_await coroutine::return_exception(timed_out_error{});
+    }
+
     if (!std::holds_alternative<std::monostate>(rate_limit_info) && can_apply_per_partition_rate_limit(*s, db::operation_type::write)) {
         auto table_limit = *s->per_partition_rate_limit_options().get_max_writes_per_second();
         auto& write_label = cf.get_rate_limiter_label_for_writes();
         auto token = dht::token::to_int64(dht::get_token(*s, m.key()));
-        if (_rate_limiter.account_operation(write_label, token, table_limit, rate_limit_info) == db::rate_limiter::can_proceed::no) {
+        auto accounting = s->per_partition_rate_limit_options().get_accounting();
+        if (_rate_limiter.account_operation(write_label, token, table_limit, rate_limit_info, accounting) == db::rate_limiter::can_proceed::no) {
             ++_stats->total_writes_rate_limited;
             co_await coroutine::return_exception(replica::rate_limit_exception());
         }
@@ -1947,6 +2154,9 @@ future<> database::do_apply(schema_ptr s, const frozen_mutation& m, tracing::tra
             co_await coroutine::return_exception_ptr(std::move(ex));
         }
         lock = lock_f.get();
+        if (check_expired()) {
+            co_await coroutine::return_exception(timed_out_error{});
+        }
     }
 
     // purposefully manually "inlined" apply_with_commitlog call here to reduce # coroutine
@@ -2014,6 +2224,7 @@ void database::update_write_metrics_for_timed_out_write() {
     ++_stats->total_writes;
     ++_stats->total_writes_failed;
     ++_stats->total_writes_timedout;
+    ++_stats->total_writes_expired;
 }
 
 future<> database::apply(schema_ptr s, const frozen_mutation& m, tracing::trace_state_ptr tr_state, db::commitlog::force_sync sync, db::timeout_clock::time_point timeout, db::per_partition_rate_limit::info rate_limit_info) {
@@ -2258,6 +2469,7 @@ future<> database::stop() {
     co_await _compaction_concurrency_sem.stop();
     co_await _system_read_concurrency_sem.stop();
     co_await _view_update_read_concurrency_sem.stop();
+    co_await _batch_read_concurrency_sem.stop();
     dblog.info("Joining memtable update action");
     co_await _update_memtable_flush_static_shares_action.join();
 }
@@ -2360,9 +2572,10 @@ future<> database::snapshot_table_on_all_shards(sharded<database>& sharded_db, s
     auto table_shards = co_await get_table_on_all_shards(sharded_db, uuid);
     co_await table::snapshot_on_all_shards(sharded_db, table_shards, tag);
     if (snap_views) {
-        for (const auto& vp : table_shards->views()) {
-            co_await snapshot_table_on_all_shards(sharded_db, ks_name, vp->cf_name(), tag, db::snapshot_ctl::snap_views::no, skip_flush);
-        }
+        auto views = table_shards->views();
+        co_await coroutine::parallel_for_each(views, [&] (const view_ptr& vp) {
+            return snapshot_table_on_all_shards(sharded_db, ks_name, vp->cf_name(), tag, db::snapshot_ctl::snap_views::no, skip_flush);
+        });
     }
 }
 
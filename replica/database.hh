@@ -63,6 +63,7 @@
 #include "utils/cross-shard-barrier.hh"
 #include "sstables/generation_type.hh"
 #include "db/rate_limiter.hh"
+#include "db/hot_key_sampler.hh"
 #include "db/operation_type.hh"
 #include "locator/tablets.hh"
 #include "utils/serialized_action.hh"
@@ -339,6 +340,8 @@ extern const ssize_t new_reader_base_cost;
 struct table_stats {
     /** Number of times flush has resulted in the memtable being switched out. */
     int64_t memtable_switch_count = 0;
+    /** Number of memtables written again to the commitlog instead of being flushed. */
+    int64_t memtable_relog_count = 0;
     /** Estimated number of tasks pending for this column family */
     int64_t pending_flushes = 0;
     int64_t live_disk_space_used = 0;
@@ -351,6 +354,8 @@ struct table_stats {
     int64_t memtable_range_tombstone_reads = 0;
     int64_t memtable_row_tombstone_reads = 0;
     int64_t tablet_count = 0;
+    /** Number of reads serving several partition keys through a single reader */
+    int64_t multi_key_reads = 0;
     mutation_application_stats memtable_app_stats;
     utils::timed_rate_moving_average_summary_and_histogram reads{256};
     utils::timed_rate_moving_average_summary_and_histogram writes{256};
@@ -361,6 +366,7 @@ struct table_stats {
     utils::timed_rate_moving_average_and_histogram tombstone_scanned;
     utils::timed_rate_moving_average_and_histogram live_scanned;
     utils::estimated_histogram estimated_coordinator_read;
+    db::hot_key_sampler hot_keys;
 };
 
 using storage_options = data_dictionary::storage_options;
@@ -419,18 +425,24 @@ class table : public enable_lw_shared_from_this<table>
         unsigned x_log2_compaction_groups{0};
         utils::updateable_value<bool> enable_compacting_data_for_streaming_and_repair;
         utils::updateable_value<bool> enable_tombstone_gc_for_streaming_and_repair;
+        utils::updateable_value<uint32_t> commitlog_relog_memtable_max_size_in_kb{0};
+        utils::updateable_value<uint32_t> commitlog_max_data_lifetime_in_seconds{0};
     };
 
     using snapshot_details = db::snapshot_ctl::table_snapshot_details;
     struct cache_hit_rate {
         cache_temperature rate;
         lowres_clock::time_point last_updated;
+        // Rolling estimate of the reads queued on the replica, from the
+        // replica_load of its read responses.
+        float queued_reads = 0;
     };
 private:
     schema_ptr _schema;
     config _config;
     locator::effective_replication_map_ptr _erm;
     lw_shared_ptr<const storage_options> _storage_opts;
+    dirty_memory_manager_logalloc::memory_budget _dirty_memory_budget;
     memtable_table_shared_data _memtable_shared_data;
     mutable table_stats _stats;
     mutable db::view::stats _view_stats;
@@ -441,6 +453,12 @@ class table : public enable_lw_shared_from_this<table>
     template<typename... Args>
     void do_apply(compaction_group& cg, db::rp_handle&&, Args&&... args);
 
+    // Writes the content of the only memtable of the group to the commitlog
+    // again and releases its older commitlog entries, if it is small enough
+    // for this to be cheaper than writing a tiny sstable. Returns false if
+    // the memtable needs to be flushed instead.
+    future<bool> try_relog_memtable(compaction_group& cg);
+
     lw_shared_ptr<memtable_list> make_memory_only_memtable_list();
     lw_shared_ptr<memtable_list> make_memtable_list(compaction_group& cg);
 
@@ -924,6 +942,10 @@ class table : public enable_lw_shared_from_this<table>
     void start();
     future<> stop();
     future<> flush(std::optional<db::replay_position> = {});
+    // Releases the commitlog segments up to pos kept by the memtables of the
+    // table, on request of the commitlog. Small memtables are written to the
+    // commitlog again rather than flushed, see try_relog_memtable().
+    future<> release_commitlog_segments(db::replay_position pos);
     future<> clear(); // discards memtable(s) without flushing them to disk.
     future<db::replay_position> discard_sstables(db_clock::time_point);
 
@@ -1070,6 +1092,7 @@ class table : public enable_lw_shared_from_this<table>
     }
 
     void set_hit_rate(gms::inet_address addr, cache_temperature rate);
+    void set_replica_load(gms::inet_address addr, replica_load load);
     cache_hit_rate get_my_hit_rate() const;
     cache_hit_rate get_hit_rate(const gms::gossiper& g, gms::inet_address addr);
     void drop_hit_rate(gms::inet_address addr);
@@ -1172,6 +1195,12 @@ class table : public enable_lw_shared_from_this<table>
 
     size_t estimate_read_memory_cost() const;
 
+    // Estimates the disk I/O of reading the given ranges from the sstables,
+    // in the number of reads of index and data pages. Partitions filtered out by
+    // the bloom filter and partition index pages in the index cache don't count.
+    // Range scans count a page per sstable overlapping with the range.
+    uint64_t estimate_read_io_cost(const dht::partition_range_vector& ranges) const;
+
 private:
     future<row_locker::lock_holder> do_push_view_replica_updates(shared_ptr<db::view::view_update_generator> gen, schema_ptr s, mutation m, db::timeout_clock::time_point timeout, mutation_source source,
             tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, query::partition_slice::option_set custom_opts) const;
@@ -1252,6 +1281,10 @@ class table : public enable_lw_shared_from_this<table>
     // snapshot (list of sstables) will include all the data written up to the time it was taken.
     future<utils::chunked_vector<sstables::entry_descriptor>> clone_tablet_storage(locator::tablet_id tid);
 
+    // Moves the given sstables from the upload directory into the table, under new generations,
+    // and adds them to it. Used to load the sstables of a tablet received as files.
+    future<> load_uploaded_sstables(std::vector<sstables::entry_descriptor> descs);
+
     friend class compaction_group;
 };
 
@@ -1352,6 +1385,8 @@ struct database_config {
     seastar::scheduling_group compaction_scheduling_group;
     seastar::scheduling_group memory_compaction_scheduling_group;
     seastar::scheduling_group statement_scheduling_group;
+    // Statements of batch workloads, if they are separated from the others.
+    std::optional<seastar::scheduling_group> batch_statement_scheduling_group;
     seastar::scheduling_group streaming_scheduling_group;
     seastar::scheduling_group gossip_scheduling_group;
     seastar::scheduling_group commitlog_scheduling_group;
@@ -1427,11 +1462,14 @@ class database : public peering_sharded_service<database> {
     replica::cf_stats _cf_stats;
     static constexpr size_t max_count_concurrent_reads{100};
     static constexpr size_t max_count_concurrent_view_update_reads{50};
+    static constexpr size_t max_count_concurrent_batch_reads{50};
     size_t max_memory_concurrent_reads() { return _dbcfg.available_memory * 0.02; }
     size_t max_memory_concurrent_view_update_reads() { return _dbcfg.available_memory * 0.01; }
+    size_t max_memory_concurrent_batch_reads() { return _dbcfg.available_memory * 0.01; }
     // Assume a queued read takes up 1kB of memory, and allow 2% of memory to be filled up with such reads.
     size_t max_inactive_queue_length() { return _dbcfg.available_memory * 0.02 / 1000; }
     size_t max_inactive_view_update_queue_length() { return _dbcfg.available_memory * 0.01 / 1000; }
+    size_t max_inactive_batch_queue_length() { return _dbcfg.available_memory * 0.01 / 1000; }
     // They're rather heavyweight, so limit more
     static constexpr size_t max_count_streaming_concurrent_reads{10};
     size_t max_memory_streaming_concurrent_reads() { return _dbcfg.available_memory * 0.02; }
@@ -1450,9 +1488,16 @@ class database : public peering_sharded_service<database> {
         uint64_t total_writes_failed = 0;
         uint64_t total_writes_timedout = 0;
         uint64_t total_writes_rate_limited = 0;
+        // Writes and reads whose deadline passed before the replica started
+        // working on them, e.g. while waiting in a queue.
+        uint64_t total_writes_expired = 0;
         uint64_t total_reads = 0;
         uint64_t total_reads_failed = 0;
         uint64_t total_reads_rate_limited = 0;
+        uint64_t total_reads_expired = 0;
+        uint64_t total_reads_not_cached = 0;
+
+        uint64_t coalesced_counter_updates = 0;
 
         uint64_t short_data_queries = 0;
         uint64_t short_mutation_queries = 0;
@@ -1484,6 +1529,9 @@ class database : public peering_sharded_service<database> {
 
     // The view update read concurrency semaphore used for view updates coming from user writes.
     reader_concurrency_semaphore _view_update_read_concurrency_sem;
+    // The read concurrency semaphore of user reads running in the batch statement
+    // scheduling group, so they don't queue up behind, or ahead of, interactive reads.
+    reader_concurrency_semaphore _batch_read_concurrency_sem;
     db::timeout_semaphore _view_update_concurrency_sem{max_memory_pending_view_updates()};
 
     cache_tracker _row_cache_tracker;
@@ -1576,6 +1624,25 @@ class database : public peering_sharded_service<database> {
 
     future<mutation> do_apply_counter_update(column_family& cf, const frozen_mutation& fm, schema_ptr m_schema, db::timeout_clock::time_point timeout,
                                              tracing::trace_state_ptr trace_state);
+    future<mutation> read_modify_write_counters(column_family& cf, mutation m, db::timeout_clock::time_point timeout,
+                                                tracing::trace_state_ptr trace_state);
+
+    // Counter updates of a partition which arrived while another update of
+    // the partition was being applied, to be applied together once it's done.
+    struct counter_update_batch {
+        mutation m;
+        db::timeout_clock::time_point timeout;
+        shared_promise<with_clock<db::timeout_clock>, mutation> done;
+    };
+    // Exists while an update of the partition is being applied.
+    struct counter_update_queue {
+        lw_shared_ptr<counter_update_batch> next;
+        // Resolved when the update being applied is done, for next to be applied.
+        promise<> next_turn;
+    };
+    using counter_update_queue_key = std::pair<table_id, bytes>;
+    std::unordered_map<counter_update_queue_key, counter_update_queue, utils::tuple_hash> _counter_update_queues;
+    void finish_counter_update(const counter_update_queue_key& key) noexcept;
 
     template<typename Future>
     Future update_write_metrics(Future&& f);
@@ -1628,6 +1695,7 @@ class database : public peering_sharded_service<database> {
     }
 
     seastar::scheduling_group get_streaming_scheduling_group() const { return _dbcfg.streaming_scheduling_group; }
+    std::optional<seastar::scheduling_group> get_batch_statement_scheduling_group() const { return _dbcfg.batch_statement_scheduling_group; }
 
     compaction_manager& get_compaction_manager() {
         return _compaction_manager;
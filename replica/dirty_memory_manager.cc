@@ -5,6 +5,8 @@
 #include "utils/assert.hh"
 #include "dirty_memory_manager.hh"
 #include "database.hh" // for memtable_list
+#include "compaction/compaction_manager.hh"
+#include "db/config.hh"
 #include <seastar/core/metrics_api.hh>
 #include <seastar/util/later.hh>
 #include <seastar/core/sleep.hh>
@@ -61,13 +63,32 @@ dirty_memory_manager_logalloc::size_tracked_region* region_group::get_largest_re
     return _regions.empty() ? nullptr : _regions.top();
 }
 
+dirty_memory_manager_logalloc::size_tracked_region* region_group::get_largest_region_over_budget() noexcept {
+    if (_cfg.unspooled_budget_limit == std::numeric_limits<size_t>::max()) {
+        return nullptr;
+    }
+    size_tracked_region* largest = nullptr;
+    for (size_tracked_region* r : _regions) {
+        auto b = r->_budget;
+        if (!b || b->_unspooled_total_memory <= _cfg.unspooled_budget_limit || !r->evictable_occupancy().total_space()) {
+            continue;
+        }
+        if (!largest || (b == largest->_budget
+                ? r->evictable_occupancy().total_space() > largest->evictable_occupancy().total_space()
+                : b->_unspooled_total_memory > largest->_budget->_unspooled_total_memory)) {
+            largest = r;
+        }
+    }
+    return largest;
+}
+
 void
 region_group::add(logalloc::region* child_r) {
     auto child = static_cast<size_tracked_region*>(child_r);
     SCYLLA_ASSERT(!child->_heap_handle);
     child->_heap_handle = std::make_optional(_regions.push(child));
     region_group_binomial_group_sanity_check(_regions);
-    update_unspooled(child_r->occupancy().total_space());
+    update_unspooled(child_r, child_r->occupancy().total_space());
 }
 
 void
@@ -76,7 +97,7 @@ region_group::del(logalloc::region* child_r) {
     if (child->_heap_handle) {
         _regions.erase(*std::exchange(child->_heap_handle, std::nullopt));
         region_group_binomial_group_sanity_check(_regions);
-        update_unspooled(-child_r->occupancy().total_space());
+        update_unspooled(child_r, -child_r->occupancy().total_space());
     }
 }
 
@@ -108,6 +129,34 @@ region_group::execute_one() {
     req->allocate();
 }
 
+void
+region_group::execute_one(memory_budget& budget) {
+    auto req = std::move(budget._blocked_requests.front());
+    budget._blocked_requests.pop_front();
+    // Round robin between the budgets.
+    budget._blocked_hook.unlink();
+    if (!budget._blocked_requests.empty()) {
+        _blocked_budgets.push_back(budget);
+    }
+    req->allocate();
+}
+
+memory_budget* region_group::budget_permitted_to_execute() noexcept {
+    if (!execution_permitted()) {
+        return nullptr;
+    }
+    for (auto it = _blocked_budgets.begin(); it != _blocked_budgets.end();) {
+        auto& budget = *it++;
+        if (budget._blocked_requests.empty()) {
+            // All of its requests timed out.
+            budget._blocked_hook.unlink();
+        } else if (!over_budget(budget)) {
+            return &budget;
+        }
+    }
+    return nullptr;
+}
+
 future<>
 region_group::start_releaser(scheduling_group deferred_work_sg) {
     return with_scheduling_group(deferred_work_sg, std::bind(&region_group::release_queued_allocations, this));
@@ -118,6 +167,9 @@ future<> region_group::release_queued_allocations() {
         if (!_blocked_requests.empty() && execution_permitted()) {
             execute_one();
             co_await coroutine::maybe_yield();
+        } else if (auto budget = budget_permitted_to_execute()) {
+            execute_one(*budget);
+            co_await coroutine::maybe_yield();
         } else {
             // We want `rl` to hold for the call to _relief.wait(), but not to wait
             // for the future to resolve, hence the inner lambda.
@@ -191,6 +243,23 @@ void region_group::update_unspooled(ssize_t delta) {
     }
 }
 
+void region_group::update_budget(logalloc::region* r, ssize_t delta) noexcept {
+    auto budget = static_cast<size_tracked_region*>(r)->_budget;
+    if (!budget) {
+        return;
+    }
+    bool was_over = budget->_unspooled_total_memory > _cfg.unspooled_budget_limit;
+    budget->_unspooled_total_memory += delta;
+    if (was_over && budget->_unspooled_total_memory <= _cfg.unspooled_budget_limit && budget->_blocked_hook.is_linked()) {
+        _relief.signal();
+    }
+}
+
+void region_group::update_unspooled(logalloc::region* r, ssize_t delta) {
+    update_budget(r, delta);
+    update_unspooled(delta);
+}
+
 future<>
 region_group::shutdown() noexcept {
     _shutdown_requested = true;
@@ -198,7 +267,7 @@ region_group::shutdown() noexcept {
     return std::move(_releaser);
 }
 
-void region_group::on_request_expiry::operator()(std::unique_ptr<allocating_function>& func) noexcept {
+void on_request_expiry::operator()(std::unique_ptr<allocating_function>& func) noexcept {
     func->fail(std::make_exception_ptr(blocked_requests_timed_out_error{_name}));
 }
 
@@ -208,12 +277,13 @@ future<flush_permit> flush_permit::reacquire_sstable_write_permit() && {
     return _manager->get_flush_permit(std::move(_background_permit));
 }
 
-dirty_memory_manager::dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg)
+dirty_memory_manager::dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg, double table_budget)
     : _db(&db)
     , _region_group("memtable (unspooled)", dirty_memory_manager_logalloc::reclaim_config{
             .unspooled_hard_limit = threshold / 2,
             .unspooled_soft_limit = threshold * soft_limit / 2,
             .real_hard_limit = threshold,
+            .unspooled_budget_limit = table_budget < 1 ? size_t(threshold * table_budget / 2) : std::numeric_limits<size_t>::max(),
             .start_reclaiming = std::bind_front(&dirty_memory_manager::start_reclaiming, this)
       }, deferred_work_sg)
     , _flush_serializer(1)
@@ -268,6 +338,10 @@ future<> dirty_memory_manager::flush_when_needed() {
                 if (!this->has_pressure() || _db_shutdown_requested) {
                     return make_ready_future<>();
                 }
+                if (unspooled_dirty_memory() <= flush_threshold()) {
+                    // Compaction is behind and memory allows, wait for the memtables to grow.
+                    return sleep(10ms);
+                }
                 // There are many criteria that can be used to select what is the best memtable to
                 // flush. Most of the time we want some coordination with the commitlog to allow us to
                 // release commitlog segments as early as we can.
@@ -275,8 +349,13 @@ future<> dirty_memory_manager::flush_when_needed() {
                 // But during pressure condition, we'll just pick the CF that holds the largest
                 // memtable. The advantage of doing this is that this is objectively the one that will
                 // release the biggest amount of memory and is less likely to be generating tiny
-                // SSTables.
-                memtable& candidate_memtable = memtable::from_region(*(this->_region_group.get_largest_region()));
+                // SSTables. Tables over their budget go first, so that the flushes of the tables
+                // within theirs aren't premature.
+                auto* candidate_region = this->_region_group.get_largest_region_over_budget();
+                if (!candidate_region) {
+                    candidate_region = this->_region_group.get_largest_region();
+                }
+                memtable& candidate_memtable = memtable::from_region(*candidate_region);
                 memtable_list& mtlist = *(candidate_memtable.get_memtable_list());
 
                 if (!candidate_memtable.region().evictable_occupancy()) {
@@ -305,6 +384,20 @@ future<> dirty_memory_manager::flush_when_needed() {
     });
 }
 
+size_t dirty_memory_manager::flush_threshold() const noexcept {
+    auto soft_limit = _region_group.unspooled_soft_limit_threshold();
+    auto hard_limit = _region_group.unspooled_throttle_threshold();
+    if (!_db || hard_limit <= soft_limit || !_db->get_config().delay_memtable_flush_on_compaction_backlog()) {
+        return soft_limit;
+    }
+    auto backlog = _db->get_compaction_manager().normalized_backlog();
+    if (compaction_controller::backlog_disabled(backlog) || backlog <= flush_delay_min_backlog) {
+        return soft_limit;
+    }
+    auto delay = std::min(1.0, (backlog - flush_delay_min_backlog) / (flush_delay_max_backlog - flush_delay_min_backlog));
+    return soft_limit + (hard_limit - soft_limit) * flush_delay_max_headroom * delay;
+}
+
 void dirty_memory_manager::start_reclaiming() noexcept {
     _should_flush.signal();
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <boost/intrusive/list.hpp>
 #include <boost/intrusive/parent_from_member.hpp>
 #include <boost/heap/binomial_heap.hpp>
 #include <seastar/core/condition-variable.hh>
@@ -26,6 +27,7 @@ namespace replica {
 namespace dirty_memory_manager_logalloc {
 
 class size_tracked_region;
+class memory_budget;
 
 struct region_evictable_occupancy_ascending_less_comparator {
     bool operator()(size_tracked_region* r1, size_tracked_region* r2) const;
@@ -40,6 +42,8 @@ using region_heap = boost::heap::binomial_heap<size_tracked_region*,
 class size_tracked_region : public logalloc::region {
 public:
     std::optional<region_heap::handle_type> _heap_handle;
+    // The budget the unspooled memory of the region is accounted to, if any.
+    memory_budget* _budget = nullptr;
 };
 
 // The region_group class keeps track of two memory use counts:
@@ -93,21 +97,82 @@ struct reclaim_config {
     size_t unspooled_hard_limit = std::numeric_limits<size_t>::max();
     size_t unspooled_soft_limit = unspooled_hard_limit;
     size_t real_hard_limit = std::numeric_limits<size_t>::max();
+    // Unspooled memory a memory_budget may use while the group is above its
+    // soft limit. See memory_budget.
+    size_t unspooled_budget_limit = std::numeric_limits<size_t>::max();
     reclaim_start_callback start_reclaiming = [] () noexcept {};
     reclaim_stop_callback stop_reclaiming = [] () noexcept {};
 };
 
+struct allocating_function {
+    virtual ~allocating_function() = default;
+    virtual void allocate() = 0;
+    virtual void fail(std::exception_ptr) = 0;
+};
+
+class on_request_expiry {
+    class blocked_requests_timed_out_error : public timed_out_error {
+        const sstring _msg;
+    public:
+        explicit blocked_requests_timed_out_error(sstring name)
+            : _msg(std::move(name) + ": timed out") {}
+        virtual const char* what() const noexcept override {
+            return _msg.c_str();
+        }
+    };
+
+    sstring _name;
+public:
+    explicit on_request_expiry(sstring name) : _name(std::move(name)) {}
+    void operator()(std::unique_ptr<allocating_function>&) noexcept;
+};
+
+// Accounts the unspooled memory of a subset of the regions of a region_group,
+// typically the memtables of a table, whose writes should be isolated from
+// the writes to the other regions.
+//
+// The unspooled memory of the regions pointing to the budget (see
+// size_tracked_region::_budget) is accounted to it. While the region group is
+// above its soft limit, writes to a budget which is above
+// reclaim_config::unspooled_budget_limit are delayed, and its regions are
+// flushed first, so that a table written to faster than it can be flushed
+// doesn't push the group to its hard limit, throttling the writes to all the
+// other tables.
+class memory_budget {
+    size_t _unspooled_total_memory = 0;
+    // Requests delayed because of this budget only, they are released
+    // after the requests blocked on the whole group.
+    expiring_fifo<std::unique_ptr<allocating_function>, on_request_expiry, db::timeout_clock> _blocked_requests;
+    boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> _blocked_hook;
+    uint64_t _blocked_requests_counter = 0;
+
+    friend class region_group;
+public:
+    explicit memory_budget(sstring name = "(unnamed memory budget)")
+        : _blocked_requests(on_request_expiry{std::move(name)})
+    { }
+    memory_budget(memory_budget&&) = delete;
+
+    size_t unspooled_memory_used() const noexcept {
+        return _unspooled_total_memory;
+    }
+
+    size_t blocked_requests() const noexcept {
+        return _blocked_requests.size();
+    }
+
+    uint64_t blocked_requests_counter() const noexcept {
+        return _blocked_requests_counter;
+    }
+};
+
 // A container for memtables. Called "region_group" for historical
 // reasons. Receives updates about memtable size change via the
 // LSA region_listener interface.
 class region_group : public logalloc::region_listener {
     using region_heap = dirty_memory_manager_logalloc::region_heap;
 public:
-    struct allocating_function {
-        virtual ~allocating_function() = default;
-        virtual void allocate() = 0;
-        virtual void fail(std::exception_ptr) = 0;
-    };
+    using allocating_function = dirty_memory_manager_logalloc::allocating_function;
 private:
     template <typename Func>
     struct concrete_allocating_function : public allocating_function {
@@ -127,22 +192,6 @@ class region_group : public logalloc::region_listener {
         }
     };
 
-    class on_request_expiry {
-        class blocked_requests_timed_out_error : public timed_out_error {
-            const sstring _msg;
-        public:
-            explicit blocked_requests_timed_out_error(sstring name)
-                : _msg(std::move(name) + ": timed out") {}
-            virtual const char* what() const noexcept override {
-                return _msg.c_str();
-            }
-        };
-
-        sstring _name;
-    public:
-        explicit on_request_expiry(sstring name) : _name(std::move(name)) {}
-        void operator()(std::unique_ptr<allocating_function>&) noexcept;
-    };
 private:
     reclaim_config _cfg;
 
@@ -169,6 +218,14 @@ class region_group : public logalloc::region_listener {
 
     uint64_t _blocked_requests_counter = 0;
 
+    // Budgets with requests blocked because they are over their limit,
+    // released in a round robin.
+    boost::intrusive::list<memory_budget,
+            boost::intrusive::member_hook<memory_budget, boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>, &memory_budget::_blocked_hook>,
+            boost::intrusive::constant_time_size<false>> _blocked_budgets;
+
+    uint64_t _budget_blocked_requests_counter = 0;
+
     size_t _unspooled_total_memory = 0;
 
     region_heap _regions;
@@ -212,6 +269,9 @@ class region_group : public logalloc::region_listener {
         if (_under_unspooled_soft_pressure) {
             _under_unspooled_soft_pressure = false;
             _cfg.stop_reclaiming();
+            if (!_blocked_budgets.empty()) {
+                _relief.signal();
+            }
         }
     }
 
@@ -224,14 +284,23 @@ class region_group : public logalloc::region_listener {
     }
 
     void execute_one();
+    void execute_one(memory_budget& budget);
+
+    bool over_budget(const memory_budget& budget) const noexcept {
+        return _under_unspooled_soft_pressure && budget._unspooled_total_memory > _cfg.unspooled_budget_limit;
+    }
+    // A budget with requests which may be released, if any.
+    memory_budget* budget_permitted_to_execute() noexcept;
+    void update_budget(logalloc::region* r, ssize_t delta) noexcept;
 public:
     size_t unspooled_throttle_threshold() const noexcept {
         return _cfg.unspooled_hard_limit;
     }
-private:
+
     size_t unspooled_soft_limit_threshold() const noexcept {
         return _cfg.unspooled_soft_limit;
     }
+private:
 
     bool reclaimer_can_block() const;
     future<> start_releaser(scheduling_group deferered_work_sg);
@@ -267,6 +336,9 @@ class region_group : public logalloc::region_listener {
         return _unspooled_total_memory;
     }
     void update_unspooled(ssize_t delta);
+    // Like update_unspooled(ssize_t), also accounting the delta to the
+    // budget of the region.
+    void update_unspooled(logalloc::region* r, ssize_t delta);
 
     // It would be easier to call update, but it is unfortunately broken in boost versions up to at
     // least 1.59.
@@ -280,7 +352,7 @@ class region_group : public logalloc::region_listener {
     //    the full update cycle even then.
     virtual void increase_usage(logalloc::region* r, ssize_t delta) override { // From region_listener
         _regions.increase(*static_cast<size_tracked_region*>(r)->_heap_handle);
-        update_unspooled(delta);
+        update_unspooled(r, delta);
     }
 
     virtual void decrease_evictable_usage(logalloc::region* r) override { // From region_listener
@@ -289,7 +361,7 @@ class region_group : public logalloc::region_listener {
 
     virtual void decrease_usage(logalloc::region* r, ssize_t delta) override { // From region_listener
         decrease_evictable_usage(r);
-        update_unspooled(delta);
+        update_unspooled(r, delta);
     }
 
     //
@@ -308,17 +380,25 @@ class region_group : public logalloc::region_listener {
     // region_groups.
     //
     // When timeout is reached first, the returned future is resolved with timed_out_error exception.
+    //
+    // If a budget is given, the function is also delayed while the budget is over its limit (see
+    // memory_budget), behind the other requests of the budget only.
     template <typename Func>
     // We disallow future-returning functions here, because otherwise memory may be available
     // when we start executing it, but no longer available in the middle of the execution.
     requires (!is_future<std::invoke_result_t<Func>>::value)
-    futurize_t<std::invoke_result_t<Func>> run_when_memory_available(Func&& func, db::timeout_clock::time_point timeout);
+    futurize_t<std::invoke_result_t<Func>> run_when_memory_available(Func&& func, db::timeout_clock::time_point timeout, memory_budget* budget = nullptr);
 
     // returns a pointer to the largest region (in terms of memory usage) that sits below this
     // region group. This includes the regions owned by this region group as well as all of its
     // children.
     size_tracked_region* get_largest_region() noexcept;
 
+    // Returns a pointer to the largest evictable region of the budget which is the most over
+    // reclaim_config::unspooled_budget_limit, or nullptr if no budget with evictable regions is
+    // over it.
+    size_tracked_region* get_largest_region_over_budget() noexcept;
+
     // Shutdown is mandatory for every user who has set a threshold
     // Can be called at most once.
     future<> shutdown() noexcept;
@@ -326,6 +406,11 @@ class region_group : public logalloc::region_listener {
     size_t blocked_requests() const noexcept;
 
     uint64_t blocked_requests_counter() const noexcept;
+
+    // Requests which were delayed because their budget was over its limit.
+    uint64_t budget_blocked_requests_counter() const noexcept {
+        return _budget_blocked_requests_counter;
+    }
 private:
     // Returns true if and only if constraints of this group are not violated.
     // That's taking into account any constraints imposed by enclosing (parent) groups.
@@ -423,6 +508,22 @@ class dirty_memory_manager {
         return _region_group.over_unspooled_soft_limit();
     }
 
+    // Normalized compaction backlog (see compaction_manager::normalized_backlog())
+    // from which flushes are delayed, and at which they are delayed the most.
+    static constexpr double flush_delay_min_backlog = 1.5;
+    static constexpr double flush_delay_max_backlog = 10;
+    // Fraction of the room between the soft and hard limits memtables may
+    // grow into when flushes are delayed the most.
+    static constexpr double flush_delay_max_headroom = 0.5;
+
+    // Unspooled memory above which memtables are flushed under soft pressure.
+    //
+    // Past the soft limit, the largest memtable is flushed. When compaction
+    // is behind, the sstables flushed are added to its backlog, so while
+    // memory allows, let the memtables grow a bit larger first: fewer and
+    // larger sstables are written, which reduces write amplification.
+    size_t flush_threshold() const noexcept;
+
     unsigned _extraneous_flushes = 0;
 
     seastar::metrics::metric_groups _metrics;
@@ -463,7 +564,13 @@ class dirty_memory_manager {
     //
     // We then set the soft limit to 80 % of the unspooled dirty hard limit, which is equal to 40 % of
     // the user-supplied threshold.
-    dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg);
+    //
+    // Table Budget
+    // ------------
+    // Past the soft limit, the tables using more than table_budget of the unspooled dirty hard limit
+    // have their writes delayed and their memtables flushed first (see memory_budget), so that the
+    // pressure is put on the tables which cause it. A table_budget of 1 or more disables it.
+    dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg, double table_budget = 1);
     dirty_memory_manager()
         : _db(nullptr)
         , _region_group("memtable (unspooled)",
@@ -487,13 +594,13 @@ class dirty_memory_manager {
 
     void revert_potentially_cleaned_up_memory(logalloc::region* from, int64_t delta) {
         _region_group.update_real(-delta);
-        _region_group.update_unspooled(delta);
+        _region_group.update_unspooled(from, delta);
         _dirty_bytes_released_pre_accounted -= delta;
     }
 
     void account_potentially_cleaned_up_memory(logalloc::region* from, int64_t delta) {
         _region_group.update_real(delta);
-        _region_group.update_unspooled(-delta);
+        _region_group.update_unspooled(from, -delta);
         _dirty_bytes_released_pre_accounted += delta;
     }
 
@@ -563,20 +670,32 @@ template <typename Func>
 // when we start executing it, but no longer available in the middle of the execution.
 requires (!is_future<std::invoke_result_t<Func>>::value)
 futurize_t<std::invoke_result_t<Func>>
-region_group::run_when_memory_available(Func&& func, db::timeout_clock::time_point timeout) {
+region_group::run_when_memory_available(Func&& func, db::timeout_clock::time_point timeout, memory_budget* budget) {
     bool blocked = 
         !_blocked_requests.empty()
         || under_unspooled_pressure()
         || _under_real_pressure;
 
-    if (!blocked) {
+    bool budget_blocked = !blocked && budget
+        && (!budget->_blocked_requests.empty() || over_budget(*budget));
+
+    if (!blocked && !budget_blocked) {
         return futurize_invoke(func);
     }
 
     auto fn = std::make_unique<concrete_allocating_function<Func>>(std::forward<Func>(func));
     auto fut = fn->get_future();
-    _blocked_requests.push_back(std::move(fn), timeout);
-    ++_blocked_requests_counter;
+    if (budget_blocked) {
+        budget->_blocked_requests.push_back(std::move(fn), timeout);
+        ++budget->_blocked_requests_counter;
+        if (!budget->_blocked_hook.is_linked()) {
+            _blocked_budgets.push_back(*budget);
+        }
+        ++_budget_blocked_requests_counter;
+    } else {
+        _blocked_requests.push_back(std::move(fn), timeout);
+        ++_blocked_requests_counter;
+    }
 
     return fut;
 }
@@ -376,6 +376,9 @@ future<> table_populator::process_subdir(sharded<sstables::sstable_directory>& d
         .enable_dangerous_direct_import_of_cassandra_counters = _db.local().get_config().enable_dangerous_direct_import_of_cassandra_counters(),
         .allow_loading_materialized_view = true,
         .garbage_collect = true,
+        .sstable_open_config = {
+            .defer_bloom_filter_loading = _db.local().get_config().defer_sstable_bloom_filter_loading(),
+        },
     };
     co_await distributed_loader::process_sstable_dir(directory, flags);
 
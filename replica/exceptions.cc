@@ -23,6 +23,8 @@ exception_variant try_encode_replica_exception(std::exception_ptr eptr) {
         return e;
     } catch (abort_requested_exception&) {
         return abort_requested_exception();
+    } catch (not_cached_exception&) {
+        return not_cached_exception();
     } catch (...) {
         return no_exception{};
     }
@@ -64,6 +64,17 @@ class stale_topology_exception final : public replica_exception {
     virtual const char* what() const noexcept override { return _message.c_str(); }
 };
 
+// Thrown by reads with the cache_only option, the data of which isn't all
+// in the cache.
+class not_cached_exception final : public replica_exception {
+public:
+    not_cached_exception() noexcept
+            : replica_exception()
+    { }
+
+    virtual const char* what() const noexcept override { return "data not cached"; }
+};
+
 using abort_requested_exception = seastar::abort_requested_exception;
 
 struct exception_variant {
@@ -71,7 +82,8 @@ struct exception_variant {
             no_exception,
             rate_limit_exception,
             stale_topology_exception,
-            abort_requested_exception
+            abort_requested_exception,
+            not_cached_exception
     > reason;
 
     exception_variant()
@@ -15,6 +15,7 @@
 #include "mutation/mutation_partition_view.hh"
 #include "readers/empty_v2.hh"
 #include "readers/forwardable_v2.hh"
+#include "readers/from_mutations_v2.hh"
 #include "sstables/types.hh"
 
 namespace replica {
@@ -107,6 +108,60 @@ void memtable::memtable_encoding_stats_collector::update(const ::schema& s, cons
     update(s, dr.cells(), column_kind::regular_column);
 }
 
+void memtable::update_clustering_bounds(const ::schema& s, const mutation_partition& mp) {
+    _has_partition_tombstones |= bool(mp.partition_tombstone());
+    position_in_partition::less_compare less(s);
+    std::optional<position_in_partition_view> min;
+    std::optional<position_in_partition_view> max;
+    auto extend = [&] (position_in_partition_view start, position_in_partition_view end) {
+        if (!min || less(start, *min)) {
+            min = start;
+        }
+        if (!max || less(*max, end)) {
+            max = end;
+        }
+    };
+    for (auto&& row_entry : mp.clustered_rows()) {
+        if (!row_entry.dummy()) {
+            extend(row_entry.position(), position_in_partition_view::after_all_prefixed(row_entry.key()));
+        }
+    }
+    for (auto&& rt : mp.row_tombstones()) {
+        extend(rt.tombstone().position(), rt.tombstone().end_position());
+    }
+    if (!min) {
+        return;
+    }
+    // The bounds outlive mp, which may be allocated in the memtable region.
+    with_allocator(standard_allocator(), [&] {
+        if (!_clustering_bounds) {
+            _clustering_bounds.emplace(position_in_partition(*min), position_in_partition(*max));
+            return;
+        }
+        if (less(*min, _clustering_bounds->start())) {
+            _clustering_bounds->set_start(position_in_partition(*min));
+        }
+        if (less(_clustering_bounds->end(), *max)) {
+            _clustering_bounds->set_end(position_in_partition(*max));
+        }
+    });
+}
+
+bool memtable::may_contain_rows(const query::clustering_row_ranges& ranges, bool reversed) const {
+    if (_has_partition_tombstones) {
+        return true;
+    }
+    if (!_clustering_bounds) {
+        return false;
+    }
+    return std::ranges::any_of(ranges, [&] (const query::clustering_range& r) {
+        auto range = reversed ? query::reverse(r) : r;
+        return _clustering_bounds->overlaps(*_schema,
+            position_in_partition_view::for_range_start(range),
+            position_in_partition_view::for_range_end(range));
+    });
+}
+
 void memtable::memtable_encoding_stats_collector::update(const ::schema& s, const mutation_partition& mp) {
     update(mp.partition_tombstone());
     update(s, mp.static_row().get(), column_kind::static_column);
@@ -131,6 +186,7 @@ memtable::memtable(schema_ptr schema, dirty_memory_manager& dmm,
         , _table_shared_data(table_shared_data)
         , partitions(dht::raw_token_less_comparator{})
         , _table_stats(table_stats) {
+    _budget = table_shared_data.dirty_memory_budget;
     logalloc::region::listen(&dmm.region_group());
 }
 
@@ -230,7 +286,7 @@ memtable::find_or_create_partition(const dht::decorated_key& key) {
 
     // call lower_bound so we have a hint for the insert, just in case.
     partitions_type::bound_hint hint;
-    auto i = partitions.lower_bound(key, dht::ring_position_comparator(*_schema), hint);
+    auto i = partitions.lower_bound(key, memtable_entry_comparator(*_schema), hint);
     if (i == partitions.end() || !hint.match) {
         partitions_type::iterator entry = partitions.emplace_before(i,
                 key.token().raw(), hint,
@@ -250,21 +306,21 @@ memtable::find_or_create_partition(const dht::decorated_key& key) {
 
 bool
 memtable::contains_partition(const dht::decorated_key& key) const {
-    return partitions.find(key, dht::ring_position_comparator(*_schema)) != partitions.end();
+    return partitions.find(key, memtable_entry_comparator(*_schema)) != partitions.end();
 }
 
 boost::iterator_range<memtable::partitions_type::const_iterator>
 memtable::slice(const dht::partition_range& range) const {
     if (query::is_single_partition(range)) {
         const query::ring_position& pos = range.start()->value();
-        auto i = partitions.find(pos, dht::ring_position_comparator(*_schema));
+        auto i = partitions.find(pos, memtable_entry_comparator(*_schema));
         if (i != partitions.end()) {
             return boost::make_iterator_range(i, std::next(i));
         } else {
             return boost::make_iterator_range(i, i);
         }
     } else {
-        auto cmp = dht::ring_position_comparator(*_schema);
+        auto cmp = memtable_entry_comparator(*_schema);
 
         auto i1 = range.start()
                   ? (range.start()->is_inclusive()
@@ -293,7 +349,7 @@ class iterator_reader {
     size_t _last_partition_count = 0;
 
     memtable::partitions_type::iterator lookup_end() {
-        auto cmp = dht::ring_position_comparator(*_memtable->_schema);
+        auto cmp = memtable_entry_comparator(*_memtable->_schema);
         return _range->end()
             ? (_range->end()->is_inclusive()
                 ? _memtable->partitions.upper_bound(_range->end()->value(), cmp)
@@ -303,7 +359,7 @@ class iterator_reader {
     void update_iterators() {
         // We must be prepared that iterators may get invalidated during compaction.
         auto current_reclaim_counter = _memtable->reclaim_counter();
-        auto cmp = dht::ring_position_comparator(*_memtable->_schema);
+        auto cmp = memtable_entry_comparator(*_memtable->_schema);
         if (_last) {
             if (current_reclaim_counter != _last_reclaim_counter ||
                   _last_partition_count != _memtable->partition_count()) {
@@ -716,8 +772,21 @@ memtable::make_flat_reader_opt(schema_ptr query_schema,
     bool is_reversed = slice.is_reversed();
     if (query::is_single_partition(range) && !fwd_mr) {
         const query::ring_position& pos = range.start()->value();
+        // Like sstables skipped by their clustering key metadata, a memtable which
+        // has the partition but no data in the queried ranges only contributes
+        // the partition start and end, which are cheaper to make than a snapshot reader.
+        if (_schema->clustering_key_size() && slice.static_columns.empty()
+                && !may_contain_rows(slice.row_ranges(*query_schema, *pos.key()), is_reversed)) {
+            bool found = _table_shared_data.read_section(*this, [&] {
+                return partitions.find(pos, memtable_entry_comparator(*_schema)) != partitions.end();
+            });
+            if (!found) {
+                return {};
+            }
+            return make_mutation_reader_from_mutations_v2(query_schema, std::move(permit), mutation(query_schema, pos.as_decorated_key()), slice, fwd);
+        }
         auto snp = _table_shared_data.read_section(*this, [&] () -> partition_snapshot_ptr {
-            auto i = partitions.find(pos, dht::ring_position_comparator(*_schema));
+            auto i = partitions.find(pos, memtable_entry_comparator(*_schema));
             if (i != partitions.end()) {
                 upgrade_entry(*i);
                 return i->snapshot(*this);
@@ -764,6 +833,11 @@ memtable::update(db::rp_handle&& h) {
     _rp_set.put(std::move(h));
 }
 
+void
+memtable::update(db::rp_set&& rps) {
+    _rp_set.put(std::move(rps));
+}
+
 future<>
 memtable::apply(memtable& mt, reader_permit permit) {
     if (auto reader_opt = mt.make_flat_reader_opt(_schema, std::move(permit), query::full_partition_range, _schema->full_slice())) {
@@ -779,10 +853,12 @@ memtable::apply(memtable& mt, reader_permit permit) {
 
 void
 memtable::apply(const mutation& m, db::rp_handle&& h) {
+    _table_stats.hot_keys.on_write(_schema, m.decorated_key());
     with_allocator(allocator(), [this, &m] {
         _table_shared_data.allocating_section(*this, [&, this] {
             auto& p = find_or_create_partition(m.decorated_key());
             _stats_collector.update(*m.schema(), m.partition());
+            update_clustering_bounds(*m.schema(), m.partition());
             p.apply(region(), cleaner(), *_schema, m.partition(), *m.schema(), _table_stats.memtable_app_stats);
         });
     });
@@ -791,6 +867,7 @@ memtable::apply(const mutation& m, db::rp_handle&& h) {
 
 void
 memtable::apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_handle&& h) {
+    _table_stats.hot_keys.on_write(_schema, m.key());
     with_allocator(allocator(), [this, &m, &m_schema] {
         _table_shared_data.allocating_section(*this, [&, this] {
             auto& p = find_or_create_partition_slow(m.key());
@@ -798,6 +875,7 @@ memtable::apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_han
             partition_builder pb(*m_schema, mp);
             m.partition().accept(*m_schema, pb);
             _stats_collector.update(*m_schema, mp);
+            update_clustering_bounds(*m_schema, mp);
             p.apply(region(), cleaner(), *_schema, std::move(mp), *m_schema, _table_stats.memtable_app_stats);
         });
     });
@@ -89,6 +89,25 @@ class memtable_entry {
     friend dht::ring_position_view ring_position_view_to_compare(const memtable_entry& mt) { return mt._key; }
 };
 
+// Orders memtable entries by their ring position.
+//
+// The partitions of a memtable are already bucketed by the raw value of their
+// token, so the entries a key is compared with have, almost always, the same
+// token. A write to a partition which is already in the memtable compares its
+// key with an equal one, which is checked by comparing the serialized keys,
+// before falling back to comparing them component by component.
+struct memtable_entry_comparator : public dht::ring_position_comparator {
+    using dht::ring_position_comparator::ring_position_comparator;
+    using dht::ring_position_comparator::operator();
+
+    std::strong_ordering operator()(const memtable_entry& e, const dht::decorated_key& key) const {
+        if (e.key().token() == key.token() && e.key().key().representation() == key.key().representation()) {
+            return std::strong_ordering::equal;
+        }
+        return dht::ring_position_comparator::operator()(e, key);
+    }
+};
+
 }
 
 namespace replica {
@@ -97,6 +116,8 @@ namespace replica {
 struct memtable_table_shared_data {
     logalloc::allocating_section read_section;
     logalloc::allocating_section allocating_section;
+    // The budget the memtables of the table are accounted to, if any.
+    dirty_memory_manager_logalloc::memory_budget* dirty_memory_budget = nullptr;
 };
 
 class dirty_memory_manager;
@@ -107,7 +128,7 @@ struct table_stats;
 class memtable final : public enable_lw_shared_from_this<memtable>, private dirty_memory_manager_logalloc::size_tracked_region {
 public:
     using partitions_type = double_decker<int64_t, memtable_entry,
-                            dht::raw_token_less_comparator, dht::ring_position_comparator,
+                            dht::raw_token_less_comparator, memtable_entry_comparator,
                             16, bplus::key_search::linear>;
 private:
     dirty_memory_manager& _dirty_mgr;
@@ -119,6 +140,7 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
     size_t nr_partitions = 0;
     db::replay_position _replay_position;
     db::rp_set _rp_set;
+    gc_clock::time_point _creation_time = gc_clock::now();
     // mutation source to which reads fall-back after mark_flushed()
     // so that memtable contents can be moved away while there are
     // still active readers. This is needed for this mutation_source
@@ -180,7 +202,22 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
         }
     } _stats_collector;
 
+    // The clustering positions of the rows and range tombstones written to
+    // the memtable, so that reads of other clustering ranges can skip it, like
+    // sstables are skipped by their min/max clustering key metadata.
+    // Disengaged while no clustered data was written.
+    std::optional<position_range> _clustering_bounds;
+    // Partition tombstones apply to all clustering ranges.
+    bool _has_partition_tombstones = false;
+
+    void update_clustering_bounds(const ::schema& s, const mutation_partition& mp);
+    // Returns false if none of the rows and range tombstones written to the
+    // memtable fall within the given ranges, which are reversed if the query is.
+    bool may_contain_rows(const query::clustering_row_ranges& ranges, bool reversed) const;
+
     void update(db::rp_handle&&);
+    // Adds back replay positions taken with get_and_discard_rp_set().
+    void update(db::rp_set&&);
     friend class ::row_cache;
     friend class memtable_entry;
     friend class flush_reader;
@@ -320,6 +357,11 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
     db::rp_set get_and_discard_rp_set() noexcept {
         return std::exchange(_rp_set, {});
     }
+    // When the memtable started receiving writes. Its oldest data
+    // was written to the commitlog no earlier than that.
+    gc_clock::time_point creation_time() const noexcept {
+        return _creation_time;
+    }
     friend class iterator_reader;
 
     dirty_memory_manager& get_dirty_memory_manager() noexcept {
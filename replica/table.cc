@@ -47,9 +47,11 @@
 #include "gms/feature_service.hh"
 #include "db/config.hh"
 #include "db/commitlog/commitlog.hh"
+#include "db/commitlog/commitlog_entry.hh"
 #include "utils/lister.hh"
 #include "dht/token.hh"
 #include "dht/i_partitioner.hh"
+#include "dht/auto_refreshing_sharder.hh"
 #include "replica/global_table_ptr.hh"
 #include "locator/tablets.hh"
 
@@ -1202,6 +1204,22 @@ table::clone_tablet_storage(locator::tablet_id tid) {
     co_return ret;
 }
 
+future<> table::load_uploaded_sstables(std::vector<sstables::entry_descriptor> descs) {
+    auto holder = async_gate().hold();
+    dht::auto_refreshing_sharder sharder(shared_from_this());
+    std::vector<sstables::shared_sstable> ssts;
+    ssts.reserve(descs.size());
+    for (auto& desc : descs) {
+        auto sst = get_sstables_manager().make_sstable(_schema, get_storage_options(), desc.generation, sstables::sstable_state::upload,
+                desc.version, desc.format);
+        // As with intra-node migration, the tablet sharder still points to the leaving replica at this stage.
+        co_await sst->load(sharder, sstables::sstable_open_config{ .current_shard_as_sstable_owner = true });
+        co_await sst->pick_up_from_upload(sstables::sstable_state::normal, calculate_generation_for_new_table());
+        ssts.push_back(std::move(sst));
+    }
+    co_await add_sstables_and_update_cache(ssts);
+}
+
 void table::update_stats_for_new_sstable(const sstables::shared_sstable& sst) noexcept {
     _stats.live_disk_space_used += sst->bytes_on_disk();
     _stats.total_disk_space_used += sst->bytes_on_disk();
@@ -1617,12 +1635,16 @@ void table::set_metrics() {
     if (_config.enable_metrics_reporting) {
         _metrics.add_group("column_family", {
                 ms::make_counter("memtable_switch", ms::description("Number of times flush has resulted in the memtable being switched out"), _stats.memtable_switch_count)(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_relogs", ms::description("Number of times a small memtable was written again to the commitlog instead of being flushed, to release old commitlog segments"), _stats.memtable_relog_count)(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_partition_writes", [this] () { return _stats.memtable_partition_insertions + _stats.memtable_partition_hits; }, ms::description("Number of write operations performed on partitions in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_partition_hits", _stats.memtable_partition_hits, ms::description("Number of times a write operation was issued on an existing partition in memtables"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("multi_key_reads", _stats.multi_key_reads, ms::description("Number of reads which served several partition keys through a single reader"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_writes", _stats.memtable_app_stats.row_writes, ms::description("Number of row writes performed in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_rows_dropped_by_tombstones", _stats.memtable_app_stats.rows_dropped_by_tombstones, ms::description("Number of rows dropped in memtables by a tombstone write"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_rows_compacted_with_tombstones", _stats.memtable_app_stats.rows_compacted_with_tombstones, ms::description("Number of rows scanned during write of a tombstone for the purpose of compaction in memtables"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_partition_reads", _stats.memtable_app_stats.partition_reads, ms::description("Number of reads of partitions in memtables"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_partition_versions_read", _stats.memtable_app_stats.partition_versions_read, ms::description("Number of partition versions merged by reads of partitions in memtables. Divided by memtable_partition_reads, gives the average number of versions per read"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_range_tombstone_reads", _stats.memtable_range_tombstone_reads, ms::description("Number of range tombstones read from memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_tombstone_reads", _stats.memtable_row_tombstone_reads, ms::description("Number of row tombstones read from memtables"))(cf)(ks),
                 ms::make_gauge("pending_tasks", ms::description("Estimated number of tasks pending for this column family"), _stats.pending_flushes)(cf)(ks),
@@ -2330,6 +2352,8 @@ table::table(schema_ptr schema, config config, lw_shared_ptr<const storage_optio
     , _config(std::move(config))
     , _erm(std::move(erm))
     , _storage_opts(std::move(sopts))
+    , _dirty_memory_budget(format("{}.{} memtables", _schema->ks_name(), _schema->cf_name()))
+    , _memtable_shared_data{.dirty_memory_budget = &_dirty_memory_budget}
     , _view_stats(format("{}_{}_view_replica_update", _schema->ks_name(), _schema->cf_name()),
                          keyspace_label(_schema->ks_name()),
                          column_family_label(_schema->cf_name())
@@ -2353,6 +2377,7 @@ table::table(schema_ptr schema, config config, lw_shared_ptr<const storage_optio
         tlogger.warn("Writes disabled, column family no durable.");
     }
 
+    _cache.set_hot_key_sampler(&_stats.hot_keys);
     recalculate_tablet_count_stats();
     set_metrics();
 }
@@ -2382,7 +2407,9 @@ locator::table_load_stats tablet_storage_group_manager::table_load_stats(std::fu
 }
 
 locator::table_load_stats table::table_load_stats(std::function<bool(const locator::tablet_map&, locator::global_tablet_id)> tablet_filter) const noexcept {
-    return _sg_manager->table_load_stats(std::move(tablet_filter));
+    auto stats = _sg_manager->table_load_stats(std::move(tablet_filter));
+    stats.ops_per_second = _stats.reads().rate().rates[1] + _stats.writes().rate().rates[1];
+    return stats;
 }
 
 future<> tablet_storage_group_manager::handle_tablet_split_completion(const locator::tablet_map& old_tmap, const locator::tablet_map& new_tmap) {
@@ -2613,23 +2640,11 @@ logalloc::occupancy_stats table::occupancy() const {
 }
 
 
+// The manifest lists all the sstables of the table, of which there may be
+// hundreds of thousands, so it's written as it's generated rather than built
+// in memory first.
 future<>
 table::seal_snapshot(sstring jsondir, std::vector<snapshot_file_set> file_sets) {
-    std::ostringstream ss;
-    int n = 0;
-    ss << "{" << std::endl << "\t\"files\" : [ ";
-    for (const auto& fsp : file_sets) {
-      for (const auto& rf : *fsp) {
-        if (n++ > 0) {
-            ss << ", ";
-        }
-        ss << "\"" << rf << "\"";
-        co_await coroutine::maybe_yield();
-      }
-    }
-    ss << " ]" << std::endl << "}" << std::endl;
-
-    auto json = ss.str();
     auto jsonfile = jsondir + "/manifest.json";
 
     tlogger.debug("Storing manifest {}", jsonfile);
@@ -2639,7 +2654,15 @@ table::seal_snapshot(sstring jsondir, std::vector<snapshot_file_set> file_sets)
     auto out = co_await make_file_output_stream(std::move(f));
     std::exception_ptr ex;
     try {
-        co_await out.write(json.c_str(), json.size());
+        co_await out.write("{\n\t\"files\" : [ ");
+        int n = 0;
+        for (const auto& fsp : file_sets) {
+            for (const auto& rf : *fsp) {
+                co_await out.write(fmt::format("{}\"{}\"", n++ > 0 ? ", " : "", rf));
+                co_await coroutine::maybe_yield();
+            }
+        }
+        co_await out.write(" ]\n}\n");
         co_await out.flush();
     } catch (...) {
         ex = std::current_exception();
@@ -2878,6 +2901,108 @@ future<> table::flush(std::optional<db::replay_position> pos) {
     _flush_rp = std::max(_flush_rp, fp);
 }
 
+future<> table::release_commitlog_segments(db::replay_position pos) {
+    if (pos < _flush_rp) {
+        co_return;
+    }
+    auto op = _pending_flushes_phaser.start();
+    auto fp = _highest_rp;
+    co_await parallel_foreach_compaction_group([this] (compaction_group& cg) -> future<> {
+        bool relogged = false;
+        try {
+            relogged = co_await try_relog_memtable(cg);
+        } catch (...) {
+            tlogger.warn("Failed to relog memtable of {}.{}, flushing it: {}", _schema->ks_name(), _schema->cf_name(), std::current_exception());
+        }
+        if (!relogged) {
+            co_await cg.flush();
+        }
+    });
+    _flush_rp = std::max(_flush_rp, fp);
+}
+
+future<bool> table::try_relog_memtable(compaction_group& cg) {
+    // Gives up, and flushes, if the commitlog has no room for the entries,
+    // which may only be made by flushes.
+    static constexpr auto relog_timeout = std::chrono::seconds(1);
+
+    const uint64_t max_size = uint64_t(_config.commitlog_relog_memtable_max_size_in_kb()) * 1024;
+    auto memtables = cg.memtables();
+    // Only the active memtable can gain the new entries. Counter tables are
+    // left alone, replaying their entries twice isn't known to be safe.
+    if (!max_size || !_commitlog || _schema->is_counter() || memtables->size() != 1 || !memtables->may_flush()) {
+        co_return false;
+    }
+    auto mt = memtables->back();
+    // Relogging renews the data in the commitlog, so the memtable has to be
+    // flushed eventually for the data to leave it in time.
+    const auto max_age = std::chrono::seconds(_config.commitlog_max_data_lifetime_in_seconds());
+    if (mt->empty() || mt->occupancy().used_space() > max_size
+            || (max_age.count() && gc_clock::now() - mt->creation_time() >= max_age)) {
+        co_return false;
+    }
+
+    auto holder = cg.async_gate().hold();
+    // Once the memtable is gone from the list, it was flushed or cleared, and
+    // the entries it kept are (or are about to be) discarded.
+    auto in_memtables = [&] {
+        return std::ranges::find(*memtables, mt) != memtables->end();
+    };
+
+    // Writes which happen from now on keep their own entries in the memtable.
+    auto old_rps = mt->get_and_discard_rp_set();
+    std::vector<db::rp_handle> handles;
+    std::exception_ptr ex;
+    try {
+        auto s = mt->schema();
+        auto timeout = db::timeout_clock::now() + relog_timeout;
+        auto reader = mt->make_flat_reader(s, compaction_concurrency_semaphore().make_tracking_only_permit(s, "try_relog_memtable()", db::no_timeout, {}));
+        std::exception_ptr read_ex;
+        try {
+            while (auto m = co_await read_mutation_from_mutation_reader(reader)) {
+                auto fm = freeze(*m);
+                commitlog_entry_writer cew(s, fm, db::commitlog::force_sync::no);
+                handles.push_back(co_await _commitlog->add_entry(_schema->id(), cew, timeout));
+            }
+        } catch (...) {
+            read_ex = std::current_exception();
+        }
+        co_await reader.close();
+        if (read_ex) {
+            std::rethrow_exception(std::move(read_ex));
+        }
+        // The old entries may only go once the new ones are durable.
+        co_await _commitlog->sync_all_segments();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+
+    if (!in_memtables()) {
+        // The new entries are released with the handles.
+        _commitlog->discard_completed_segments(_schema->id(), old_rps);
+        co_return true;
+    }
+    if (ex) {
+        mt->update(std::move(old_rps));
+        tlogger.debug("Failed to relog memtable of {}.{}: {}", _schema->ks_name(), _schema->cf_name(), ex);
+        co_return false;
+    }
+    try {
+        for (auto& h : handles) {
+            db::replay_position rp = h;
+            mt->update(std::move(h));
+            _highest_rp = std::max(_highest_rp, rp);
+        }
+    } catch (...) {
+        mt->update(std::move(old_rps));
+        throw;
+    }
+    _commitlog->discard_completed_segments(_schema->id(), old_rps);
+    _stats.memtable_relog_count++;
+    tlogger.debug("Relogged memtable of {}.{} ({} entries) to release old commitlog segments", _schema->ks_name(), _schema->cf_name(), handles.size());
+    co_return true;
+}
+
 bool storage_group::can_flush() const {
     return std::ranges::any_of(compaction_groups(), std::mem_fn(&compaction_group::can_flush));
 }
@@ -3158,12 +3283,43 @@ size_t table::estimate_read_memory_cost() const {
     return new_reader_base_cost;
 }
 
+uint64_t table::estimate_read_io_cost(const dht::partition_range_vector& ranges) const {
+    uint64_t cost = 0;
+    for (const auto& range : ranges) {
+        auto sstables = _sstables->select(range);
+        if (!range.is_singular() || !range.start()->value().has_key()) {
+            cost += sstables.size();
+            continue;
+        }
+        const auto& pos = range.start()->value();
+        auto hk = sstables::sstable::make_hashed_key(*_schema, *pos.key());
+        dht::ring_position_comparator cmp(*_schema);
+        for (const auto& sst : sstables) {
+            if (cmp(pos, sst->get_first_decorated_key()) < 0 || cmp(pos, sst->get_last_decorated_key()) > 0 || !sst->filter_has_key(hk)) {
+                continue;
+            }
+            // The data page, plus the index page unless it's cached.
+            cost += sst->is_index_page_cached(pos) ? 1 : 2;
+        }
+    }
+    return cost;
+}
+
 void table::set_hit_rate(gms::inet_address addr, cache_temperature rate) {
     auto& e = _cluster_cache_hit_rates[addr];
     e.rate = rate;
     e.last_updated = lowres_clock::now();
 }
 
+void table::set_replica_load(gms::inet_address addr, replica_load load) {
+    // The hit rate comes with the same response and seeds the entry.
+    auto it = _cluster_cache_hit_rates.find(addr);
+    if (it != _cluster_cache_hit_rates.end()) {
+        constexpr float alpha = 0.25;
+        it->second.queued_reads += alpha * (float(load.queued_reads()) - it->second.queued_reads);
+    }
+}
+
 table::cache_hit_rate table::get_my_hit_rate() const {
     return cache_hit_rate { _global_cache_hit_rate, lowres_clock::now()};
 }
@@ -3239,7 +3395,7 @@ future<> table::apply(const mutation& m, db::rp_handle&& h, db::timeout_clock::t
     auto holder = cg.async_gate().hold();
     return dirty_memory_region_group().run_when_memory_available([this, &m, h = std::move(h), &cg, holder = std::move(holder)] () mutable {
         do_apply(cg, std::move(h), m);
-    }, timeout);
+    }, timeout, &_dirty_memory_budget);
 }
 
 template void table::do_apply(compaction_group& cg, db::rp_handle&&, const mutation&);
@@ -3254,7 +3410,7 @@ future<> table::apply(const frozen_mutation& m, schema_ptr m_schema, db::rp_hand
 
     return dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h), &cg, holder = std::move(holder)]() mutable {
         do_apply(cg, std::move(h), m, m_schema);
-    }, timeout);
+    }, timeout, &_dirty_memory_budget);
 }
 
 template void table::do_apply(compaction_group& cg, db::rp_handle&&, const frozen_mutation&, const schema_ptr&);
@@ -3293,6 +3449,27 @@ write_memtable_to_sstable(memtable& mt, sstables::shared_sstable sst) {
     }
 }
 
+// Point lookups of several partitions (multi-key reads) can be served by a
+// single reader fast-forwarded from key to key, instead of creating a reader
+// per key. This lets the sstable readers advance their index cursors forward
+// and share the index pages they have already loaded, and selects the
+// sstables only once. The reader requires the keys in ring order.
+static bool is_ascending_multi_key_read(const schema& s, const dht::partition_range_vector& ranges) {
+    if (ranges.size() < 2) {
+        return false;
+    }
+    dht::ring_position_comparator cmp(s);
+    for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+        if (!it->is_singular()) {
+            return false;
+        }
+        if (it != ranges.begin() && cmp(std::prev(it)->start()->value(), it->start()->value()) >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 future<lw_shared_ptr<query::result>>
 table::query(schema_ptr query_schema,
         reader_permit permit,
@@ -3327,12 +3504,22 @@ table::query(schema_ptr query_schema,
         querier_opt = std::move(*saved_querier);
     }
 
+    // A querier reading several ranges at once can't be looked up for the
+    // next page, so only unpaged reads are batched.
+    const bool multi_key_read = !querier_opt && !cmd.query_uuid && is_ascending_multi_key_read(*query_schema, partition_ranges);
+
     while (!qs.done()) {
         auto&& range = *qs.current_partition_range++;
 
         if (!querier_opt) {
             query::querier_base::querier_config conf(_config.tombstone_warn_threshold);
-            querier_opt = query::querier(as_mutation_source(), query_schema, permit, range, qs.cmd.slice, trace_state, conf);
+            if (multi_key_read) {
+                querier_opt = query::querier(as_mutation_source(), query_schema, permit, partition_ranges, qs.cmd.slice, trace_state, conf);
+                qs.current_partition_range = qs.range_end;
+                ++_stats.multi_key_reads;
+            } else {
+                querier_opt = query::querier(as_mutation_source(), query_schema, permit, range, qs.cmd.slice, trace_state, conf);
+            }
         }
         auto& q = *querier_opt;
 
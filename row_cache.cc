@@ -16,6 +16,7 @@
 #include <seastar/coroutine/as_future.hh>
 #include <seastar/util/defer.hh>
 #include "replica/memtable.hh"
+#include "db/hot_key_sampler.hh"
 #include <boost/version.hpp>
 #include <sys/sdt.h>
 #include "read_context.hh"
@@ -154,10 +155,13 @@ cache_tracker::setup_metrics() {
         sm::make_counter("dummy_row_hits", sm::description("total number of dummy rows touched by reads in cache"), _stats.dummy_row_hits),
         sm::make_counter("row_misses", sm::description("total number of rows needed by reads and missing in cache"), _stats.row_misses),
         sm::make_counter("row_insertions", sm::description("total number of rows added to cache"), _stats.row_insertions),
+        sm::make_counter("row_probationary_insertions", sm::description("total number of rows added to cache by range scans or of tables with a low cache priority, at the head of the LRU"), _stats.row_probationary_insertions),
         sm::make_counter("row_evictions", sm::description("total number of rows evicted from cache"), _stats.row_evictions),
         sm::make_counter("row_removals", sm::description("total number of invalidated rows"), _stats.row_removals),
         sm::make_counter("rows_dropped_by_tombstones", _app_stats.rows_dropped_by_tombstones, sm::description("Number of rows dropped in cache by a tombstone write")),
         sm::make_counter("rows_compacted_with_tombstones", _app_stats.rows_compacted_with_tombstones, sm::description("Number of rows scanned during write of a tombstone for the purpose of compaction in cache")),
+        sm::make_counter("partition_reads", _app_stats.partition_reads, sm::description("total number of reads of cached partitions")),
+        sm::make_counter("partition_versions_read", _app_stats.partition_versions_read, sm::description("total number of partition versions merged by reads of cached partitions. Divided by partition_reads, gives the average number of versions per read")),
         sm::make_counter("static_row_insertions", sm::description("total number of static rows added to cache"), _stats.static_row_insertions),
         sm::make_counter("concurrent_misses_same_key", sm::description("total number of operation with misses same key"), _stats.concurrent_misses_same_key),
         sm::make_counter("partition_merges", sm::description("total number of partitions merged"), _stats.partition_merges),
@@ -227,6 +231,17 @@ void cache_tracker::insert(cache_entry& entry) {
     _region.allocator().invalidate_references();
 }
 
+void cache_tracker::insert_low_priority(cache_entry& entry) {
+    for (partition_version& pv : entry.partition().versions_from_oldest()) {
+        for (rows_entry& row : pv.partition().clustered_rows()) {
+            insert_low_priority(row);
+        }
+    }
+    ++_stats.partition_insertions;
+    ++_stats.partitions;
+    _region.allocator().invalidate_references();
+}
+
 void cache_tracker::on_partition_erase() noexcept {
     --_stats.partitions;
     ++_stats.partition_removals;
@@ -494,26 +509,38 @@ void cache_tracker::clear_continuity(cache_entry& ce) noexcept {
     ce.set_continuous(false);
 }
 
-void row_cache::on_partition_hit() {
+void row_cache::on_partition_hit(const reader_permit& permit) {
     _tracker.on_partition_hit();
+    if (auto* cost = permit.read_cost()) {
+        ++cost->cache_partition_hits;
+    }
 }
 
-void row_cache::on_partition_miss() {
+void row_cache::on_partition_miss(const reader_permit& permit) {
     _tracker.on_partition_miss();
+    if (auto* cost = permit.read_cost()) {
+        ++cost->cache_partition_misses;
+    }
 }
 
-void row_cache::on_row_hit() {
+void row_cache::on_row_hit(const reader_permit& permit) {
     _stats.hits.mark();
     _tracker.on_row_hit();
+    if (auto* cost = permit.read_cost()) {
+        ++cost->cache_row_hits;
+    }
 }
 
 void row_cache::on_mispopulate() {
     _tracker.on_mispopulate();
 }
 
-void row_cache::on_row_miss() {
+void row_cache::on_row_miss(const reader_permit& permit) {
     _stats.misses.mark();
     _tracker.on_row_miss();
+    if (auto* cost = permit.read_cost()) {
+        ++cost->cache_row_misses;
+    }
 }
 
 void row_cache::on_static_row_insert() {
@@ -572,7 +599,7 @@ class range_populating_reader {
                         return make_ready_future<mutation_reader_opt>(std::nullopt);
                     });
                 }
-                _cache.on_partition_miss();
+                _cache.on_partition_miss(_read_context.permit());
                 const partition_start& ps = mfopt->as_partition_start();
                 const dht::decorated_key& key = ps.key();
                 if (_reader.creation_phase() == _cache.phase_of(key)) {
@@ -623,7 +650,7 @@ class scanning_and_populating_reader final : public mutation_reader::impl {
 private:
     mutation_reader read_from_entry(cache_entry& ce) {
         _cache.upgrade_entry(ce);
-        _cache.on_partition_hit();
+        _cache.on_partition_hit(_read_context->permit());
         return ce.read(_cache, *_read_context);
     }
 
@@ -786,6 +813,9 @@ row_cache::make_reader_opt(schema_ptr s,
     if (query::is_single_partition(range) && !fwd_mr) {
         tracing::trace(trace_state, "Querying cache for range {} and slice {}",
                 range, seastar::value_of([&slice] { return slice.get_all_ranges(); }));
+        if (_hot_keys) {
+            _hot_keys->on_read(_schema, range.start()->value().as_decorated_key());
+        }
         auto mr = _read_section(_tracker.region(), [&] () -> mutation_reader_opt {
             dht::ring_position_comparator cmp(*_schema);
             auto&& pos = range.start()->value();
@@ -794,13 +824,13 @@ row_cache::make_reader_opt(schema_ptr s,
             if (hint.match) {
                 cache_entry& e = *i;
                 upgrade_entry(e);
-                on_partition_hit();
+                on_partition_hit(permit);
                 return e.read(*this, make_context());
             } else if (i->continuous()) {
                 return {};
             } else {
                 tracing::trace(trace_state, "Range {} not found in cache", range);
-                on_partition_miss();
+                on_partition_miss(permit);
                 return make_mutation_reader<single_partition_populating_reader>(*this, make_context());
             }
         });
@@ -955,7 +985,11 @@ void row_cache::populate(const mutation& m, const previous_entry_pointer* previo
     do_find_or_create_entry(m.decorated_key(), previous, [&] (auto i, const partitions_type::bound_hint& hint) {
         partitions_type::iterator entry = _partitions.emplace_before(i, m.decorated_key().token().raw(), hint,
                 m.schema(), m.decorated_key(), m.partition());
-        _tracker.insert(*entry);
+        if (_schema->caching_options().low_priority()) {
+            _tracker.insert_low_priority(*entry);
+        } else {
+            _tracker.insert(*entry);
+        }
         entry->set_continuous(i->continuous());
         upgrade_entry(*entry);
         return entry;
@@ -1164,6 +1198,39 @@ void row_cache::refresh_snapshot() {
     _underlying = _snapshot_source();
 }
 
+bool row_cache::is_resident(const dht::decorated_key& dk, const query::clustering_row_ranges& ranges, bool with_static_row) {
+    return _read_section(_tracker.region(), [&] {
+        dht::ring_position_comparator cmp(*_schema);
+        partitions_type::bound_hint hint;
+        auto i = _partitions.lower_bound(dk, cmp, hint);
+        if (!hint.match) {
+            // Continuity of the next entry tells whether there are no partitions before it.
+            return i != _partitions.end() && i->continuous();
+        }
+        // The continuity of a snapshot is the union of continuity of its versions,
+        // so a range is complete if it's complete in any of them.
+        auto complete_in_any_version = [&] (auto&& complete) {
+            for (partition_version& pv : i->partition().versions_from_oldest()) {
+                if (complete(pv.partition(), *pv.get_schema())) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        if (with_static_row && !complete_in_any_version([] (const mutation_partition_v2& p, const schema&) {
+                return p.static_row_continuous();
+            })) {
+            return false;
+        }
+        return std::ranges::all_of(ranges, [&] (const query::clustering_range& r) {
+            auto pr = position_range::from_range(r);
+            return complete_in_any_version([&] (const mutation_partition_v2& p, const schema& s) {
+                return p.check_continuity(s, pr, is_continuous::yes);
+            });
+        });
+    });
+}
+
 void row_cache::touch(const dht::decorated_key& dk) {
  _read_section(_tracker.region(), [&] {
     auto i = _partitions.find(dk, dht::ring_position_comparator(*_schema));
@@ -37,6 +37,8 @@ class memtable_entry;
 
 namespace tracing { class trace_state_ptr; }
 
+namespace db { class hot_key_sampler; }
+
 namespace cache {
 
 class autoupdating_underlying_reader;
@@ -217,6 +219,7 @@ class row_cache final {
 private:
     cache_tracker& _tracker;
     stats _stats{};
+    db::hot_key_sampler* _hot_keys = nullptr;
     schema_ptr _schema;
     partitions_type _partitions; // Cached partitions are complete.
 
@@ -263,10 +266,10 @@ class row_cache final {
     logalloc::allocating_section _read_section;
     mutation_reader create_underlying_reader(cache::read_context&, mutation_source&, const dht::partition_range&);
     mutation_reader make_scanning_reader(const dht::partition_range&, std::unique_ptr<cache::read_context>);
-    void on_partition_hit();
-    void on_partition_miss();
-    void on_row_hit();
-    void on_row_miss();
+    void on_partition_hit(const reader_permit& permit);
+    void on_partition_miss(const reader_permit& permit);
+    void on_row_hit(const reader_permit& permit);
+    void on_row_miss(const reader_permit& permit);
     void on_static_row_insert();
     void on_mispopulate();
     void upgrade_entry(cache_entry&);
@@ -408,7 +411,15 @@ class row_cache final {
     mutation_reader make_nonpopulating_reader(schema_ptr s, reader_permit permit, const dht::partition_range& range,
             const query::partition_slice& slice, tracing::trace_state_ptr ts);
 
+    // Returns true iff the given clustering ranges of the partition, and its static row
+    // if with_static_row is set, are complete in cache, or the partition is known to be absent,
+    // so that reading them doesn't need to go to the underlying mutation source.
+    bool is_resident(const dht::decorated_key& dk, const query::clustering_row_ranges& ranges, bool with_static_row);
+
     const stats& stats() const { return _stats; }
+
+    // Samples single-partition reads served by this cache.
+    void set_hot_key_sampler(db::hot_key_sampler* sampler) noexcept { _hot_keys = sampler; }
 public:
     // Populate cache from given mutation, which must be fully continuous.
     // Intended to be used only in tests.
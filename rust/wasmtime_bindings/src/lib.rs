@@ -39,7 +39,9 @@ mod ffi {
 
         type Module;
         fn create_module(engine: &mut Engine, script: &str) -> Result<Box<Module>>;
+        fn create_module_from_precompiled(precompiled: &[u8]) -> Result<Box<Module>>;
         fn raw_size(self: &Module) -> usize;
+        fn precompiled(self: &Module) -> &[u8];
         fn is_compiled(self: &Module) -> bool;
         fn compile(self: &mut Module, engine: &mut Engine) -> Result<()>;
         fn release(self: &mut Module);
@@ -152,10 +154,24 @@ fn create_module(engine: &mut Engine, script: &str) -> Result<Box<Module>> {
     Ok(module)
 }
 
+// Creates a module from the result of `create_module`, as returned by `Module::precompiled`.
+// The bytes are only validated by `compile`, which fails if they were produced by an
+// incompatible version or configuration of wasmtime.
+fn create_module_from_precompiled(precompiled: &[u8]) -> Result<Box<Module>> {
+    Ok(Box::new(Module {
+        serialized_module: precompiled.to_vec(),
+        wasmtime_module: None,
+        references: 0,
+    }))
+}
+
 impl Module {
     fn raw_size(&self) -> usize {
         self.serialized_module.len()
     }
+    fn precompiled(&self) -> &[u8] {
+        &self.serialized_module
+    }
     fn is_compiled(&self) -> bool {
         self.wasmtime_module.is_some()
     }
@@ -163,7 +179,8 @@ impl Module {
         if self.is_compiled() {
             return Ok(());
         }
-        // `deserialize` is safe because we put the result of `precompile_module` as input.
+        // `deserialize` is safe because we put the result of `precompile_module` as input,
+        // either directly or as stored by Scylla in its module cache.
         let module = unsafe {
             wasmtime::Module::deserialize(&engine.wasmtime_engine, &self.serialized_module)
                 .map_err(|e| anyhow!("Deserialization failed: {:?}", e))?
@@ -25,7 +25,8 @@ class caching_options {
     sstring _key_cache;
     sstring _row_cache;
     bool _enabled = true;
-    caching_options(sstring k, sstring r, bool enabled);
+    bool _low_priority = false;
+    caching_options(sstring k, sstring r, bool enabled, bool low_priority = false);
 
     friend class schema;
     caching_options();
@@ -34,6 +35,14 @@ class caching_options {
         return _enabled;
     }
 
+    // Rows of a table with a low cache priority ('priority': 'low') are
+    // admitted as probationary, see cache_tracker::insert_low_priority(),
+    // so that a big table which is rarely read again doesn't evict the rows
+    // of the other tables.
+    bool low_priority() const {
+        return _low_priority;
+    }
+
     std::map<sstring, sstring> to_map() const;
 
     sstring to_sstring() const;
@@ -27,6 +27,7 @@
 #include "cdc/cdc_extension.hh"
 #include "tombstone_gc_extension.hh"
 #include "db/paxos_grace_seconds_extension.hh"
+#include "db/bloom_filter_layout_extension.hh"
 #include "utils/rjson.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_extension.hh"
@@ -1424,6 +1425,12 @@ schema_ptr schema_builder::build(schema::raw_schema& new_raw) {
             dynamic_pointer_cast<db::paxos_grace_seconds_extension>(it->second)->get_paxos_grace_seconds();
     }
 
+    // cache `bloom_filter_layout` value for fast access through the schema object
+    if (auto it = new_raw._extensions.find(db::bloom_filter_layout_extension::NAME); it != new_raw._extensions.end()) {
+        new_raw._bloom_filter_layout =
+            dynamic_pointer_cast<db::bloom_filter_layout_extension>(it->second)->get_layout();
+    }
+
     // cache the `per_partition_rate_limit` parameters for fast access through the schema object.
     if (auto it = new_raw._extensions.find(db::per_partition_rate_limit_extension::NAME); it != new_raw._extensions.end()) {
         new_raw._per_partition_rate_limit_options =
@@ -1482,6 +1489,11 @@ schema_builder& schema_builder::with_per_partition_rate_limit_options(const db::
     return *this;
 }
 
+schema_builder& schema_builder::set_bloom_filter_layout(utils::filter_layout layout) {
+    add_extension(db::bloom_filter_layout_extension::NAME, ::make_shared<db::bloom_filter_layout_extension>(layout));
+    return *this;
+}
+
 schema_builder& schema_builder::set_paxos_grace_seconds(int32_t seconds) {
     add_extension(db::paxos_grace_seconds_extension::NAME, ::make_shared<db::paxos_grace_seconds_extension>(seconds));
     return *this;
@@ -31,6 +31,7 @@
 #include "timestamp.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_options.hh"
+#include "utils/i_filter.hh"
 #include "schema_fwd.hh"
 
 namespace dht {
@@ -585,6 +586,7 @@ class schema final : public enable_lw_shared_from_this<schema> {
         cf_type _type = cf_type::standard;
         int32_t _gc_grace_seconds = DEFAULT_GC_GRACE_SECONDS;
         std::optional<int32_t> _paxos_grace_seconds;
+        utils::filter_layout _bloom_filter_layout = utils::filter_layout::classic;
         double _crc_check_chance = 1;
         db::per_partition_rate_limit_options _per_partition_rate_limit_options;
         int32_t _min_compaction_threshold = DEFAULT_MIN_COMPACTION_THRESHOLD;
@@ -724,6 +726,10 @@ class schema final : public enable_lw_shared_from_this<schema> {
 
     gc_clock::duration paxos_grace_seconds() const;
 
+    utils::filter_layout bloom_filter_layout() const {
+        return _raw._bloom_filter_layout;
+    }
+
     double crc_check_chance() const {
         return _raw._crc_check_chance;
     }
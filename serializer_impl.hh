@@ -510,6 +510,7 @@ class deserialized_bytes_proxy {
     [[gnu::always_inline]]
     operator bytes_ostream() && {
         bytes_ostream v;
+        v.reserve(_stream.size());
         _stream.copy_to(v);
         return v;
     }
@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <optional>
+
+#include "mutation/frozen_mutation.hh"
+#include "tracing/tracing.hh"
+#include "db/per_partition_rate_limit_info.hh"
+
+namespace service {
+
+// One of the mutations a coordinator shard sends to a replica in a single
+// MUTATION_BATCH message. Each of them is acknowledged on its own, with
+// MUTATION_DONE or MUTATION_FAILED, as if it was sent with MUTATION.
+struct batched_mutation {
+    frozen_mutation fm;
+    uint64_t response_id;
+    std::optional<tracing::trace_info> trace_info;
+    db::per_partition_rate_limit::info rate_limit_info;
+};
+
+} // namespace service
@@ -13,6 +13,7 @@
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/smp.hh>
+#include <bit>
 #include <stdexcept>
 
 #include "db/consistency_level.hh"
@@ -34,11 +35,15 @@
 #include "tracing/trace_state.hh"
 #include "tracing/tracing.hh"
 #include "types/types.hh"
+#include "types/tuple.hh"
+#include "utils/fragment_range.hh"
+#include "utils/multiprecision_int.hh"
 #include "service/storage_proxy.hh"
 
 #include "cql3/column_identifier.hh"
 #include "cql3/cql_config.hh"
 #include "cql3/query_options.hh"
+#include "cql3/result_generator.hh"
 #include "cql3/result_set.hh"
 #include "cql3/selection/raw_selector.hh"
 #include "cql3/selection/selection.hh"
@@ -360,6 +365,319 @@ static shared_ptr<cql3::selection::selection> mock_selection(
     return cql3::selection::selection::from_selectors(db.as_data_dictionary(), schema, schema->ks_name(), std::move(prepared_selectors));
 }
 
+// Computes the aggregates of a mapreduce_request natively, rather than with
+// the selectors of the mock selection, when all of them are count(*), or
+// count, sum, avg, min or max of a single column of a fixed-width numeric
+// type (min and max only of the integer types, the order of the floating
+// point types isn't the order of their values).
+//
+// The selectors call the state function of each aggregate for each row, on
+// serialized values - e.g. avg() of an int column deserializes and
+// reserializes a tuple of a varint and a bigint for every row. Here, the
+// values are decoded into blocks of native values, which are aggregated with
+// simple loops over each block, and the states are serialized once at the
+// end. They are serialized in the format of the states of the reducible
+// aggregates, so they are merged with the results of the other shards and
+// nodes as before.
+//
+// Fed with the rows of the pages by cql3::result_generator::visit().
+class native_aggregates {
+public:
+    static constexpr size_t block_size = 256;
+private:
+    enum class aggregate_kind { count_rows, count, sum, avg, min, max };
+    // The native type the values of a column are decoded to, none if the
+    // column is only counted.
+    enum class value_kind { none, int8, int16, int32, int64, float32, float64 };
+
+    struct column {
+        value_kind kind = value_kind::none;
+        // The values of the current block, of the integer or of the floating
+        // point types.
+        std::vector<int64_t> ints;
+        std::vector<float> floats;
+        std::vector<double> doubles;
+        uint64_t non_null = 0;
+    };
+
+    struct aggregate {
+        aggregate_kind kind;
+        int column = -1;
+        uint64_t count = 0;
+        __int128 int_sum = 0;
+        float float_sum = 0;
+        double double_sum = 0;
+        std::optional<int64_t> int_extremum;
+    };
+
+    std::vector<column> _columns;
+    // The index in _columns of each column of the selection, -1 if none.
+    std::vector<int> _selected_columns;
+    std::vector<aggregate> _aggregates;
+    uint64_t _rows = 0;
+    size_t _block_rows = 0;
+    size_t _next_selected = 0;
+    bool _failed = false;
+
+    static value_kind value_kind_of(const abstract_type& t) {
+        if (t.is_counter() || &t == long_type.get()) {
+            return value_kind::int64;
+        } else if (&t == int32_type.get()) {
+            return value_kind::int32;
+        } else if (&t == short_type.get()) {
+            return value_kind::int16;
+        } else if (&t == byte_type.get()) {
+            return value_kind::int8;
+        } else if (&t == float_type.get()) {
+            return value_kind::float32;
+        } else if (&t == double_type.get()) {
+            return value_kind::float64;
+        }
+        return value_kind::none;
+    }
+
+    static bool is_integer(value_kind k) {
+        return k != value_kind::none && k != value_kind::float32 && k != value_kind::float64;
+    }
+
+    // Wire is the integer type the value is serialized as.
+    template <typename T, typename Wire, typename Value>
+    void decode(managed_bytes_view v, std::vector<Value>& values) {
+        if (v.size_bytes() != sizeof(Wire)) {
+            // E.g. an empty value. Rare, left to the generic path.
+            _failed = true;
+            return;
+        }
+        values.push_back(std::bit_cast<T>(read_simple_exactly<Wire>(v)));
+    }
+
+    void flush_block() {
+        for (auto& a : _aggregates) {
+            if (a.column < 0 || a.kind == aggregate_kind::count) {
+                continue;
+            }
+            auto& c = _columns[a.column];
+            switch (a.kind) {
+            case aggregate_kind::sum:
+            case aggregate_kind::avg:
+                if (c.kind == value_kind::float32) {
+                    // Summed in order, like the generic sum, to get the same result.
+                    for (auto v : c.floats) {
+                        a.float_sum += v;
+                    }
+                    a.count += c.floats.size();
+                } else if (c.kind == value_kind::float64) {
+                    for (auto v : c.doubles) {
+                        a.double_sum += v;
+                    }
+                    a.count += c.doubles.size();
+                } else if (c.kind == value_kind::int64) {
+                    for (auto v : c.ints) {
+                        a.int_sum += v;
+                    }
+                    a.count += c.ints.size();
+                } else {
+                    // The sum of a block of narrower integers fits in 64 bits.
+                    int64_t sum = 0;
+                    for (auto v : c.ints) {
+                        sum += v;
+                    }
+                    a.int_sum += sum;
+                    a.count += c.ints.size();
+                }
+                break;
+            case aggregate_kind::min:
+            case aggregate_kind::max:
+                if (!c.ints.empty()) {
+                    auto v = a.kind == aggregate_kind::min ? std::ranges::min(c.ints) : std::ranges::max(c.ints);
+                    if (!a.int_extremum) {
+                        a.int_extremum = v;
+                    } else {
+                        a.int_extremum = a.kind == aggregate_kind::min ? std::min(*a.int_extremum, v) : std::max(*a.int_extremum, v);
+                    }
+                }
+                break;
+            case aggregate_kind::count_rows:
+            case aggregate_kind::count:
+                break;
+            }
+        }
+        for (auto& c : _columns) {
+            c.ints.clear();
+            c.floats.clear();
+            c.doubles.clear();
+        }
+        _block_rows = 0;
+    }
+
+    static utils::multiprecision_int to_varint(__int128 v) {
+        return (utils::multiprecision_int(int64_t(v >> 64)) << 64) + utils::multiprecision_int(uint64_t(v));
+    }
+
+    data_value sum_value(const aggregate& a, value_kind k) const {
+        if (k == value_kind::float32) {
+            return data_value(a.float_sum);
+        } else if (k == value_kind::float64) {
+            return data_value(a.double_sum);
+        }
+        return data_value(to_varint(a.int_sum));
+    }
+
+    static data_value integer_value(int64_t v, value_kind k) {
+        switch (k) {
+        case value_kind::int8: return data_value(int8_t(v));
+        case value_kind::int16: return data_value(int16_t(v));
+        case value_kind::int32: return data_value(int32_t(v));
+        default: return data_value(v);
+        }
+    }
+
+public:
+    // Returns a disengaged optional if some of the aggregates of the request
+    // can't be computed natively.
+    static std::optional<native_aggregates> make(const query::mapreduce_request& req, const schema& s, const cql3::selection::selection& sel) {
+        using db::functions::function_name;
+        static const std::pair<function_name, aggregate_kind> supported[] = {
+            {function_name::native_function("count"), aggregate_kind::count},
+            {function_name::native_function("sum"), aggregate_kind::sum},
+            {function_name::native_function("avg"), aggregate_kind::avg},
+            {function_name::native_function("min"), aggregate_kind::min},
+            {function_name::native_function("max"), aggregate_kind::max},
+        };
+
+        native_aggregates n;
+        n._selected_columns.assign(sel.get_columns().size(), -1);
+        for (size_t i = 0; i < req.reduction_types.size(); ++i) {
+            if (req.reduction_types[i] == query::mapreduce_request::reduction_type::count) {
+                n._aggregates.push_back(aggregate{aggregate_kind::count_rows});
+                continue;
+            }
+            if (!req.aggregation_infos || req.aggregation_infos->at(i).column_names.size() != 1) {
+                return std::nullopt;
+            }
+            auto& info = req.aggregation_infos->at(i);
+            auto it = std::ranges::find(supported, info.name, &std::pair<function_name, aggregate_kind>::first);
+            if (it == std::end(supported)) {
+                return std::nullopt;
+            }
+            auto kind = it->second;
+            auto def = s.get_column_definition(to_bytes(info.column_names[0]));
+            if (!def || !(def->is_regular() || def->is_static())) {
+                return std::nullopt;
+            }
+            auto idx = sel.index_of(*def);
+            if (idx < 0) {
+                return std::nullopt;
+            }
+            auto vk = value_kind::none;
+            if (kind != aggregate_kind::count) {
+                vk = def->type->is_multi_cell() ? value_kind::none : value_kind_of(*def->type->without_reversed().underlying_type());
+                if (vk == value_kind::none || ((kind == aggregate_kind::min || kind == aggregate_kind::max) && !is_integer(vk))) {
+                    return std::nullopt;
+                }
+            }
+            if (n._selected_columns[idx] < 0) {
+                n._selected_columns[idx] = n._columns.size();
+                n._columns.emplace_back();
+            }
+            auto& c = n._columns[n._selected_columns[idx]];
+            if (vk != value_kind::none) {
+                c.kind = vk;
+            }
+            n._aggregates.push_back(aggregate{kind, n._selected_columns[idx]});
+        }
+        for (auto& c : n._columns) {
+            if (is_integer(c.kind)) {
+                c.ints.reserve(block_size);
+            } else if (c.kind == value_kind::float32) {
+                c.floats.reserve(block_size);
+            } else if (c.kind == value_kind::float64) {
+                c.doubles.reserve(block_size);
+            }
+        }
+        return n;
+    }
+
+    // Whether a value couldn't be aggregated natively, in which case the
+    // request has to be executed with the generic path.
+    bool failed() const {
+        return _failed;
+    }
+
+    void start_row() {
+        _next_selected = 0;
+    }
+
+    void accept_value(managed_bytes_view_opt v) {
+        auto idx = _selected_columns[_next_selected++];
+        if (idx < 0 || !v) {
+            return;
+        }
+        auto& c = _columns[idx];
+        ++c.non_null;
+        switch (c.kind) {
+        case value_kind::none:
+            break;
+        case value_kind::int8:
+            decode<int8_t, int8_t>(*v, c.ints);
+            break;
+        case value_kind::int16:
+            decode<int16_t, int16_t>(*v, c.ints);
+            break;
+        case value_kind::int32:
+            decode<int32_t, int32_t>(*v, c.ints);
+            break;
+        case value_kind::int64:
+            decode<int64_t, int64_t>(*v, c.ints);
+            break;
+        case value_kind::float32:
+            decode<float, int32_t>(*v, c.floats);
+            break;
+        case value_kind::float64:
+            decode<double, int64_t>(*v, c.doubles);
+            break;
+        }
+    }
+
+    void end_row() {
+        ++_rows;
+        if (++_block_rows == block_size) {
+            flush_block();
+        }
+    }
+
+    std::vector<bytes_opt> states() {
+        flush_block();
+        std::vector<bytes_opt> ret;
+        ret.reserve(_aggregates.size());
+        for (auto& a : _aggregates) {
+            auto k = a.column >= 0 ? _columns[a.column].kind : value_kind::none;
+            switch (a.kind) {
+            case aggregate_kind::count_rows:
+                ret.push_back(data_value(int64_t(_rows)).serialize());
+                break;
+            case aggregate_kind::count:
+                ret.push_back(data_value(int64_t(_columns[a.column].non_null)).serialize());
+                break;
+            case aggregate_kind::sum:
+                ret.push_back(sum_value(a, k).serialize());
+                break;
+            case aggregate_kind::avg: {
+                auto v = sum_value(a, k);
+                auto type = tuple_type_impl::get_instance({v.type(), long_type});
+                ret.push_back(make_tuple_value(type, std::vector<data_value>{std::move(v), data_value(int64_t(a.count))}).serialize());
+                break;
+            }
+            case aggregate_kind::min:
+            case aggregate_kind::max:
+                ret.push_back(a.int_extremum ? integer_value(*a.int_extremum, k).serialize() : bytes_opt());
+                break;
+            }
+        }
+        return ret;
+    }
+};
+
 future<query::mapreduce_result> mapreduce_service::dispatch_to_shards(
     query::mapreduce_request req,
     std::optional<tracing::trace_info> tr_info
@@ -440,61 +758,95 @@ future<query::mapreduce_result> mapreduce_service::execute_on_this_shard(
         cql3::query_options::specific_options::DEFAULT
     );
 
-    auto rs_builder = cql3::selection::result_set_builder(
-        *selection,
-        now,
-        std::vector<size_t>() // Represents empty GROUP BY indices.
-    );
-
-    // We serve up to 256 ranges at a time to avoid allocating a huge vector for ranges
-    static constexpr size_t max_ranges = 256;
-    dht::partition_range_vector ranges_owned_by_this_shard;
-    ranges_owned_by_this_shard.reserve(std::min(max_ranges, req.pr.size()));
-    partition_ranges_owned_by_this_shard owned_iter(schema, std::move(req.pr));
-
-    std::optional<dht::partition_range> current_range;
-    do {
-        while ((current_range = owned_iter.next(*schema))) {
-            ranges_owned_by_this_shard.push_back(std::move(*current_range));
-            if (ranges_owned_by_this_shard.size() >= max_ranges) {
+    // Queries the ranges owned by this shard, calling fetch_page() for each
+    // page.
+    auto query_owned_ranges = [&] (dht::partition_range_vector pr, noncopyable_function<future<> (service::pager::query_pager&)> fetch_page) -> future<> {
+        // We serve up to 256 ranges at a time to avoid allocating a huge vector for ranges
+        static constexpr size_t max_ranges = 256;
+        dht::partition_range_vector ranges_owned_by_this_shard;
+        ranges_owned_by_this_shard.reserve(std::min(max_ranges, pr.size()));
+        partition_ranges_owned_by_this_shard owned_iter(schema, std::move(pr));
+
+        std::optional<dht::partition_range> current_range;
+        do {
+            while ((current_range = owned_iter.next(*schema))) {
+                ranges_owned_by_this_shard.push_back(std::move(*current_range));
+                if (ranges_owned_by_this_shard.size() >= max_ranges) {
+                    break;
+                }
+            }
+            if (ranges_owned_by_this_shard.empty()) {
                 break;
             }
-        }
-        if (ranges_owned_by_this_shard.empty()) {
-            break;
-        }
-        flogger.trace("Forwarding to {} ranges owned by this shard", ranges_owned_by_this_shard.size());
-
-        auto pager = service::pager::query_pagers::pager(
-            _proxy,
-            schema,
-            selection,
-            *query_state,
-            *query_options,
-            make_lw_shared<query::read_command>(req.cmd),
-            std::move(ranges_owned_by_this_shard),
-            nullptr // No filtering restrictions
-        );
+            flogger.trace("Forwarding to {} ranges owned by this shard", ranges_owned_by_this_shard.size());
+
+            auto pager = service::pager::query_pagers::pager(
+                _proxy,
+                schema,
+                selection,
+                *query_state,
+                *query_options,
+                make_lw_shared<query::read_command>(req.cmd),
+                std::move(ranges_owned_by_this_shard),
+                nullptr // No filtering restrictions
+            );
 
-        // Execute query.
-        while (!pager->is_exhausted()) {
-            // It is necessary to check for a shutdown request before each
-            // fetch_page operation. During the drain process, the messaging
-            // service is shut down early (but not earlier than the
-            // mapreduce_service::shutdown invocation), so by performing this
-            // check, we can prevent hanging on the RPC call (which can be made
-            // during fetching a page).
-            if (_shutdown) {
-                throw std::runtime_error("mapreduce_service is shutting down");
+            // Execute query.
+            while (!pager->is_exhausted()) {
+                // It is necessary to check for a shutdown request before each
+                // fetch_page operation. During the drain process, the messaging
+                // service is shut down early (but not earlier than the
+                // mapreduce_service::shutdown invocation), so by performing this
+                // check, we can prevent hanging on the RPC call (which can be made
+                // during fetching a page).
+                if (_shutdown) {
+                    throw std::runtime_error("mapreduce_service is shutting down");
+                }
+
+                co_await fetch_page(*pager);
             }
 
-            co_await pager->fetch_page(rs_builder, DEFAULT_INTERNAL_PAGING_SIZE, now, timeout);
+            ranges_owned_by_this_shard.clear();
+        } while (current_range);
+    };
+
+    auto log_result = [&req, &tr_state] (const query::mapreduce_result& res) {
+        auto printer = seastar::value_of([&req, &res] {
+            return query::mapreduce_result::printer {
+                .functions = get_functions(req),
+                .res = res
+            };
+        });
+        tracing::trace(tr_state, "On shard execution result is {}", printer);
+        flogger.debug("on shard execution result is {}", printer);
+    };
+
+    if (auto native = native_aggregates::make(req, *schema, *selection)) {
+        cql3::cql_stats stats;
+        co_await query_owned_ranges(req.pr, [&] (service::pager::query_pager& pager) -> future<> {
+            auto page = co_await pager.fetch_page_generator(DEFAULT_INTERNAL_PAGING_SIZE, now, timeout, stats);
+            page.visit(*native);
+        });
+        if (!native->failed()) {
+            _stats.requests_executed_natively += 1;
+            query::mapreduce_result res = { .query_results = native->states() };
+            log_result(res);
+            co_return res;
         }
+        flogger.debug("Values not aggregated natively, executing the request with the selectors");
+    }
 
-        ranges_owned_by_this_shard.clear();
-    } while (current_range);
+    auto rs_builder = cql3::selection::result_set_builder(
+        *selection,
+        now,
+        std::vector<size_t>() // Represents empty GROUP BY indices.
+    );
 
-    co_return co_await rs_builder.with_thread_if_needed([&req, &rs_builder, reductions = req.reduction_types, tr_state = std::move(tr_state)] {
+    co_await query_owned_ranges(std::move(req.pr), [&] (service::pager::query_pager& pager) {
+        return pager.fetch_page(rs_builder, DEFAULT_INTERNAL_PAGING_SIZE, now, timeout);
+    });
+
+    co_return co_await rs_builder.with_thread_if_needed([&req, &rs_builder, &log_result, reductions = req.reduction_types] {
         auto rs = rs_builder.build();
         auto& rows = rs->rows();
         if (rows.size() != 1) {
@@ -506,16 +858,7 @@ future<query::mapreduce_result> mapreduce_service::execute_on_this_shard(
             throw std::runtime_error("aggregation result column count does not match requested column count");
         }
         query::mapreduce_result res = { .query_results = boost::copy_range<std::vector<bytes_opt>>(rows[0] | boost::adaptors::transformed([] (const managed_bytes_opt& x) { return to_bytes_opt(x); })) };
-
-        auto printer = seastar::value_of([&req, &res] {
-            return query::mapreduce_result::printer {
-                .functions = get_functions(req),
-                .res = res
-            };
-        });
-        tracing::trace(tr_state, "On shard execution result is {}", printer);
-        flogger.debug("on shard execution result is {}", printer);
-
+        log_result(res);
         return res;
     });
 }
@@ -635,6 +978,8 @@ void mapreduce_service::register_metrics() {
              sm::description("how many mapreduce requests were dispatched to local shards"), {}),
         sm::make_total_operations("requests_executed", _stats.requests_executed,
              sm::description("how many mapreduce requests were executed"), {}),
+        sm::make_total_operations("requests_executed_natively", _stats.requests_executed_natively,
+             sm::description("how many of the executed mapreduce requests had their aggregates computed natively, rather than with the selectors"), {}),
     });
 }
 
@@ -128,6 +128,7 @@ class mapreduce_service : public seastar::peering_sharded_service<mapreduce_serv
         uint64_t requests_dispatched_to_other_nodes = 0;
         uint64_t requests_dispatched_to_own_shards = 0;
         uint64_t requests_executed = 0;
+        uint64_t requests_executed_natively = 0;
     } _stats;
     seastar::metrics::metric_groups _metrics;
 
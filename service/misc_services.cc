@@ -184,16 +184,19 @@ future<lowres_clock::duration> cache_hitrate_calculator::recalculate_hitrates()
         // Publish CACHE_HITRATES in case:
         //
         // - We haven't published it at all
-        // - The diff is bigger than 1% and we haven't published in the last 5 seconds
-        // - The diff is really big 10%
+        // - The diff is bigger than 1% and we haven't published in the last 60 seconds
+        // - The diff is really big 10% and we haven't published in the last 5 seconds
         //
-        // Note: A peer node can know the cache hitrate through read_data
-        // read_mutation_data and read_digest RPC verbs which have
-        // cache_temperature in the response. So there is no need to update
-        // CACHE_HITRATES through gossip in high frequency.
+        // Note: A peer node knows the cache hitrate and the load of the
+        // replicas it reads from through the read_data, read_mutation_data
+        // and read_digest RPC verbs, which have cache_temperature and
+        // replica_load in the response, and refreshes stale values by
+        // sending reads. CACHE_HITRATES only gives the initial hit rates to
+        // the coordinators which haven't read from us yet, so there is no
+        // need to update it through gossip in high frequency.
         bool do_publish = (_published_nr == 0) ||
-                          (_diff > 0.1) ||
-                          ( _diff > 0.01 && (now - _published_time) > 5000ms);
+                          (_diff > 0.1 && (now - _published_time) > 5000ms) ||
+                          (_diff > 0.01 && (now - _published_time) > 60000ms);
 
         // We do the recalculation faster if the diff is bigger than 0.01. It
         // is useful to do the calculation even if we do not publish the
@@ -94,7 +94,9 @@ future<result<service::storage_proxy::coordinator_query_result>> query_pager::do
         _rows_fetched_for_last_partition = state->get_rows_fetched_for_last_partition();
     }
 
-    _cmd->is_first_page = query::is_first_page(!_query_uuid);
+    // A paging state without a query id still continues a query, replicas
+    // can look up a cached querier by its position.
+    _cmd->is_first_page = query::is_first_page(!_query_uuid && !_last_pkey);
     if (!_query_uuid) {
         _query_uuid = query_id::create_random_id();
     }
@@ -8,6 +8,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 #include <exception>
+#include <list>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/all.hh>
 #include "seastar/coroutine/exception.hh"
@@ -28,6 +29,135 @@ logging::logger paxos_state::logger("paxos");
 thread_local paxos_state::key_lock_map paxos_state::_paxos_table_lock;
 thread_local paxos_state::key_lock_map paxos_state::_coordinator_lock;
 
+// The cells of system.paxos are written with the ballot timestamps, so the
+// cache merges the state it keeps the same way the table does, by picking the
+// cell with the higher timestamp. When the timestamps are equal and the table
+// would pick by value, the entry is simply dropped.
+//
+// The cache may only keep a state which is at least as recent as the one in
+// the table, so the entry of a key is dropped whenever a write of it fails, and
+// a state loaded from the table is only cached if no write which doesn't take
+// the replica lock (learn, prune) has started in the meantime.
+class paxos_state::state_cache {
+public:
+    using key_type = std::pair<table_id, bytes>;
+private:
+    struct key_hash {
+        size_t operator()(const key_type& k) const {
+            return std::hash<table_id>()(k.first) ^ std::hash<bytes>()(k.second);
+        }
+    };
+    struct entry {
+        paxos_state state;
+        std::list<key_type>::iterator lru_it;
+        size_t memory_usage;
+    };
+
+    static constexpr size_t max_entries = 10000;
+    static constexpr size_t max_memory = 4 * 1024 * 1024;
+
+    std::unordered_map<key_type, entry, key_hash> _entries;
+    // Most recently used at the front.
+    std::list<key_type> _lru;
+    size_t _memory_usage = 0;
+    uint64_t _unlocked_writes = 0;
+
+    static size_t memory_usage_of(const key_type& k, const paxos_state& state) {
+        size_t ret = sizeof(entry) + sizeof(key_type) + k.second.size();
+        if (state._accepted_proposal) {
+            ret += state._accepted_proposal->update.representation().size();
+        }
+        if (state._most_recent_commit) {
+            ret += state._most_recent_commit->update.representation().size();
+        }
+        return ret;
+    }
+
+    void erase(std::unordered_map<key_type, entry, key_hash>::iterator it) {
+        _memory_usage -= it->second.memory_usage;
+        _lru.erase(it->second.lru_it);
+        _entries.erase(it);
+    }
+
+    void evict() {
+        while (!_lru.empty() && (_entries.size() > max_entries || _memory_usage > max_memory)) {
+            erase(_entries.find(_lru.back()));
+        }
+    }
+public:
+    static key_type make_key(const schema& s, const partition_key& key) {
+        return key_type(s.id(), to_bytes(key.representation()));
+    }
+
+    static api::timestamp_type timestamp_of(const utils::UUID& ballot) {
+        return utils::UUID_gen::micros_timestamp(ballot);
+    }
+
+    std::optional<paxos_state> find(const key_type& k) {
+        auto it = _entries.find(k);
+        if (it == _entries.end()) {
+            return std::nullopt;
+        }
+        _lru.splice(_lru.begin(), _lru, it->second.lru_it);
+        return it->second.state;
+    }
+
+    uint64_t unlocked_writes() const noexcept {
+        return _unlocked_writes;
+    }
+
+    void insert(key_type k, paxos_state state) {
+        if (auto it = _entries.find(k); it != _entries.end()) {
+            erase(it);
+        }
+        auto usage = memory_usage_of(k, state);
+        if (usage > max_memory) {
+            return;
+        }
+        _lru.push_front(k);
+        _entries.emplace(std::move(k), entry{std::move(state), _lru.begin(), usage});
+        _memory_usage += usage;
+        evict();
+    }
+
+    void erase(const key_type& k) {
+        if (auto it = _entries.find(k); it != _entries.end()) {
+            erase(it);
+        }
+    }
+
+    // Waits for a write of the key's state to system.paxos and then applies it
+    // to the cached entry, if there is any, with update(state), which returns
+    // false if the entry has to be dropped instead.
+    template <typename Func>
+    requires std::is_invocable_r_v<bool, Func, paxos_state&>
+    future<> apply(key_type k, future<> write, bool locked, Func update) {
+        if (!locked) {
+            ++_unlocked_writes;
+        }
+        try {
+            co_await std::move(write);
+        } catch (...) {
+            erase(k);
+            throw;
+        }
+        auto it = _entries.find(k);
+        if (it == _entries.end()) {
+            co_return;
+        }
+        if (!update(it->second.state)) {
+            erase(it);
+            co_return;
+        }
+        auto usage = memory_usage_of(k, it->second.state);
+        _memory_usage = _memory_usage - it->second.memory_usage + usage;
+        it->second.memory_usage = usage;
+        evict();
+    }
+};
+
+thread_local paxos_state::state_cache paxos_state::_cache;
+
 paxos_state::key_lock_map::semaphore& paxos_state::key_lock_map::get_semaphore_for_key(const dht::token& key) {
     return _locks.try_emplace(key, 1).first->second;
 }
@@ -51,6 +181,20 @@ future<paxos_state::guard> paxos_state::get_cas_lock(const dht::token& key, cloc
     co_return m;
 }
 
+future<paxos_state> paxos_state::load(db::system_keyspace& sys_ks, const partition_key& key, schema_ptr schema, gc_clock::time_point now,
+        clock_type::time_point timeout) {
+    auto k = state_cache::make_key(*schema, key);
+    if (auto state = _cache.find(k)) {
+        co_return std::move(*state);
+    }
+    auto unlocked_writes = _cache.unlocked_writes();
+    paxos_state state = co_await sys_ks.load_paxos_state(key, schema, now, timeout);
+    if (_cache.unlocked_writes() == unlocked_writes) {
+        _cache.insert(std::move(k), state);
+    }
+    co_return std::move(state);
+}
+
 future<prepare_response> paxos_state::prepare(storage_proxy& sp, db::system_keyspace& sys_ks, tracing::trace_state_ptr tr_state, schema_ptr schema,
         const query::read_command& cmd, const partition_key& key, utils::UUID ballot,
         bool only_digest, query::digest_algorithm da, clock_type::time_point timeout) {
@@ -77,7 +221,7 @@ future<prepare_response> paxos_state::prepare(storage_proxy& sp, db::system_keys
     // tombstone that hides any re-submit). See CASSANDRA-12043 for details.
     auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(ballot);
 
-    paxos_state state = co_await sys_ks.load_paxos_state(key, schema, gc_clock::time_point(now_in_sec), timeout);
+    paxos_state state = co_await load(sys_ks, key, schema, gc_clock::time_point(now_in_sec), timeout);
     // If received ballot is newer that the one we already accepted it has to be accepted as well,
     // but we will return the previously accepted proposal so that the new coordinator will use it instead of
     // its own.
@@ -92,7 +236,15 @@ future<prepare_response> paxos_state::prepare(storage_proxy& sp, db::system_keys
         // If querying the result fails we continue without read round optimization
         auto [data_or_digest] = co_await coroutine::all(
             [&] {
-                return sys_ks.save_paxos_promise(*schema, std::ref(key), ballot, timeout);
+                return _cache.apply(state_cache::make_key(*schema, key), sys_ks.save_paxos_promise(*schema, std::ref(key), ballot, timeout), true,
+                        [&] (paxos_state& s) {
+                    auto ts = state_cache::timestamp_of(ballot);
+                    auto promised_ts = state_cache::timestamp_of(s._promised_ballot);
+                    if (ts > promised_ts) {
+                        s._promised_ballot = ballot;
+                    }
+                    return ts != promised_ts || s._promised_ballot == ballot;
+                });
             },
             [&] () -> future<std::optional<std::variant<foreign_ptr<lw_shared_ptr<query::result>>, query::result_digest>>> {
                 try {
@@ -163,7 +315,7 @@ future<bool> paxos_state::accept(storage_proxy& sp, db::system_keyspace& sys_ks,
     auto guard = co_await get_replica_lock(token, timeout);
 
     auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(proposal.ballot);
-    paxos_state state = co_await sys_ks.load_paxos_state(proposal.update.key(), schema, gc_clock::time_point(now_in_sec), timeout);
+    paxos_state state = co_await load(sys_ks, proposal.update.key(), schema, gc_clock::time_point(now_in_sec), timeout);
 
     // Accept the proposal if we promised to accept it or the proposal is newer than the one we promised.
     // Otherwise the proposal was cutoff by another Paxos proposer and has to be rejected.
@@ -175,7 +327,24 @@ future<bool> paxos_state::accept(storage_proxy& sp, db::system_keyspace& sys_ks,
             co_await coroutine::return_exception(utils::injected_error("injected_error_before_save_proposal"));
         }
 
-        co_await sys_ks.save_paxos_proposal(*schema, proposal, timeout);
+        co_await _cache.apply(state_cache::make_key(*schema, proposal.update.key()), sys_ks.save_paxos_proposal(*schema, proposal, timeout), true,
+                [&] (paxos_state& s) {
+            auto ts = state_cache::timestamp_of(proposal.ballot);
+            auto promised_ts = state_cache::timestamp_of(s._promised_ballot);
+            auto accepted_ts = s._accepted_proposal ? state_cache::timestamp_of(s._accepted_proposal->ballot) : api::missing_timestamp;
+            // The decision erased the proposal cells up to its own timestamp.
+            auto commit_ts = s._most_recent_commit ? state_cache::timestamp_of(s._most_recent_commit->ballot) : api::missing_timestamp;
+            if ((ts == promised_ts && s._promised_ballot != proposal.ballot) || (ts == accepted_ts && s._accepted_proposal->ballot != proposal.ballot)) {
+                return false;
+            }
+            if (ts > promised_ts) {
+                s._promised_ballot = proposal.ballot;
+            }
+            if (ts > accepted_ts && ts > commit_ts) {
+                s._accepted_proposal = proposal;
+            }
+            return true;
+        });
 
         if (utils::get_local_injector().enter("paxos_error_after_save_proposal")) {
             co_await coroutine::return_exception(utils::injected_error("injected_error_after_save_proposal"));
@@ -242,14 +411,35 @@ future<> paxos_state::learn(storage_proxy& sp, db::system_keyspace& sys_ks, sche
     // We don't need to lock the partition key if there is no gap between loading paxos
     // state and saving it, and here we're just blindly updating.
     co_await utils::get_local_injector().inject("paxos_timeout_after_save_decision", timeout);
-    co_return co_await sys_ks.save_paxos_decision(*schema, decision, timeout);
+    co_return co_await _cache.apply(state_cache::make_key(*schema, decision.update.key()), sys_ks.save_paxos_decision(*schema, decision, timeout), false,
+            [&] (paxos_state& s) {
+        auto ts = state_cache::timestamp_of(decision.ballot);
+        auto commit_ts = s._most_recent_commit ? state_cache::timestamp_of(s._most_recent_commit->ballot) : api::missing_timestamp;
+        if (ts == commit_ts && s._most_recent_commit->ballot != decision.ballot) {
+            return false;
+        }
+        if (ts >= commit_ts) {
+            s._most_recent_commit = decision;
+        }
+        if (s._accepted_proposal && state_cache::timestamp_of(s._accepted_proposal->ballot) <= ts) {
+            s._accepted_proposal.reset();
+        }
+        return true;
+    });
 }
 
 future<> paxos_state::prune(db::system_keyspace& sys_ks, schema_ptr schema, const partition_key& key, utils::UUID ballot, clock_type::time_point timeout,
         tracing::trace_state_ptr tr_state) {
     logger.debug("Delete paxos state for ballot {}", ballot);
     tracing::trace(tr_state, "Delete paxos state for ballot {}", ballot);
-    return sys_ks.delete_paxos_decision(*schema, key, ballot, timeout);
+    return _cache.apply(state_cache::make_key(*schema, key), sys_ks.delete_paxos_decision(*schema, key, ballot, timeout), false,
+            [schema, key, ballot] (paxos_state& s) {
+        // Mirror load_paxos_state(), which supplies an empty value for a pruned commit.
+        if (s._most_recent_commit && state_cache::timestamp_of(s._most_recent_commit->ballot) <= state_cache::timestamp_of(ballot)) {
+            s._most_recent_commit->update = freeze(mutation(schema, key));
+        }
+        return true;
+    });
 }
 
 } // end of namespace "service::paxos"
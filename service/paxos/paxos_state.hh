@@ -12,6 +12,7 @@
 #include "utils/log.hh"
 #include "utils/digest_algorithm.hh"
 #include "db/timeout_clock.hh"
+#include "gc_clock.hh"
 #include <unordered_map>
 #include "utils/UUID_gen.hh"
 #include "service/paxos/prepare_response.hh"
@@ -73,6 +74,15 @@ class paxos_state {
 
     static future<guard> get_replica_lock(const dht::token& key, clock_type::time_point timeout);
 
+    // Keeps the state of the keys recently used on this shard, to save reading
+    // it back from system.paxos in the prepare and accept phases.
+    class state_cache;
+    static thread_local state_cache _cache;
+
+    // Loads the state of the key, from the cache if it's there.
+    static future<paxos_state> load(db::system_keyspace& sys_ks, const partition_key& key, schema_ptr schema, gc_clock::time_point now,
+            clock_type::time_point timeout);
+
     utils::UUID _promised_ballot = utils::UUID_gen::min_time_UUID();
     std::optional<proposal> _accepted_proposal;
     std::optional<proposal> _most_recent_commit;
@@ -93,9 +93,11 @@ static mutation extract_history_mutation(std::vector<canonical_mutation>& muts,
 
 static future<> mutate_locally(utils::chunked_vector<canonical_mutation> muts, storage_proxy& sp) {
     auto db = sp.data_dictionary();
+    // Snapshots may hold large partitions (e.g. of the auth tables), convert
+    // them without stalling.
     co_await max_concurrent_for_each(muts, 128, [&sp, &db] (const canonical_mutation& cmut) -> future<> {
         auto schema = db.find_schema(cmut.column_family_id());
-        return sp.mutate_locally(cmut.to_mutation(schema), nullptr, db::commitlog::force_sync::yes);
+        co_await sp.mutate_locally(co_await to_mutation_gently(cmut, std::move(schema)), nullptr, db::commitlog::force_sync::yes);
     });
 }
 
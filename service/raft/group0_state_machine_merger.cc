@@ -5,6 +5,8 @@
 /*
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
+#include <algorithm>
+
 #include "db/config.hh"
 #include "db/system_keyspace.hh"
 #include "service/raft/group0_state_machine_merger.hh"
@@ -31,10 +33,22 @@ size_t group0_state_machine_merger::cmd_size(group0_command& cmd) {
     return std::accumulate(std::begin(r), std::end(r), size_t(0));
 }
 
+// Schema changes are applied by merging them into the schema, and mixed changes by
+// merging them into the schema and reloading the topology. So a schema change can be
+// applied as part of a mixed change.
+static bool is_schema_or_mixed_change(const group0_command& cmd) {
+    return holds_alternative<schema_change>(cmd.change) || holds_alternative<mixed_change>(cmd.change);
+}
+
 bool group0_state_machine_merger::can_merge(group0_command& cmd, size_t s) const {
     if (!_cmd_to_merge.empty()) {
-        // broadcast table commands or different type of commands cannot be merged
-        if (_cmd_to_merge[0].change.index() != cmd.change.index() || holds_alternative<broadcast_table_query>(cmd.change)) {
+        // broadcast table commands or different type of commands cannot be merged,
+        // except for schema and mixed changes
+        if (holds_alternative<broadcast_table_query>(cmd.change)) {
+            return false;
+        }
+        if (_cmd_to_merge[0].change.index() != cmd.change.index()
+                && !(is_schema_or_mixed_change(_cmd_to_merge[0]) && is_schema_or_mixed_change(cmd))) {
             return false;
         }
     }
@@ -116,7 +130,11 @@ std::pair<group0_command, mutation> group0_state_machine_merger::merge() {
             }
         }
 
-        get_command_mutations(cmd) = std::move(ms);
+        if (std::ranges::any_of(_cmd_to_merge, [] (const group0_command& c) { return holds_alternative<mixed_change>(c.change); })) {
+            cmd.change = mixed_change{std::move(ms)};
+        } else {
+            get_command_mutations(cmd) = std::move(ms);
+        }
     }
     auto res = std::make_pair(std::move(cmd), std::move(_merged_history_mutation).value());
     _cmd_to_merge.clear();
@@ -30,6 +30,10 @@ namespace service {
  * there are dependencies between subsystems managed by group0, so the order
  * matters. It may be not the case now, but we prefer to be on a safe side.
  *
+ * Schema changes are combined with mixed changes (schema and topology changes
+ * applied together) into a mixed change, so interleaved DDL statements of which
+ * only some also change the topology (e.g. tablets) are still applied in bulk.
+ *
  * Broadcast table commands are not mutations, so they are never combined.
  */
 class group0_state_machine_merger {
@@ -49,8 +53,8 @@ class group0_state_machine_merger {
     static size_t cmd_size(group0_command& cmd);
 
     // Returns true if the command can be merged with the current batch.
-    // Command can be merged if it is of the same type as commands in the current batch
-    // and the size of the batch will not exceed the limit.
+    // Command can be merged if it is of the same type as commands in the current batch,
+    // or if both are schema or mixed changes, and the size of the batch will not exceed the limit.
     // Broadcast table commands cannot be merged with any other type of commands.
     bool can_merge(group0_command& cmd, size_t s) const;
 
@@ -62,7 +66,7 @@ class group0_state_machine_merger {
     static std::vector<canonical_mutation>& get_command_mutations(group0_command& cmd);
 
     // Returns a command that contains all mutations from the current batch and
-    // merged history mutation.
+    // merged history mutation. The command is a mixed change if any command in the batch is.
     // Empties the current batch.
     std::pair<group0_command, mutation> merge();
 
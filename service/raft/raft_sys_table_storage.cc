@@ -24,7 +24,10 @@
 
 #include "gms/inet_address_serializer.hh"
 
+#include <boost/range/adaptor/transformed.hpp>
+
 #include <seastar/core/loop.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 
@@ -187,7 +190,7 @@ future<> raft_sys_table_storage::store_snapshot_descriptor(const raft::snapshot_
     });
 }
 
-future<size_t> raft_sys_table_storage::do_store_log_entries_one_batch(const std::vector<raft::log_entry_ptr>& entries, size_t start_idx) {
+future<size_t> raft_sys_table_storage::do_store_log_entries_one_batch(const std::vector<log_entry_ref>& entries, size_t start_idx) {
     std::vector<cql3::statements::batch_statement::single_statement> batch_stmts;
     // statement values that can be allocated at once (one contiguous allocation)
     std::vector<std::vector<cql3::raw_value>> stmt_values;
@@ -205,7 +208,7 @@ future<size_t> raft_sys_table_storage::do_store_log_entries_one_batch(const std:
     size_t idx = start_idx;
 
     for (; idx < entries_size; idx++) {
-        auto& eptr = entries[idx];
+        auto& [group_id, eptr] = entries[idx];
         auto data_tmp_buf = fragmented_temporary_buffer::allocate_to_fit(ser::get_sizeof(eptr->data));
         auto data_out_str = data_tmp_buf.get_ostream();
         ser::serialize(data_out_str, eptr->data);
@@ -219,7 +222,7 @@ future<size_t> raft_sys_table_storage::do_store_log_entries_one_batch(const std:
         std::vector<cql3::raw_value> single_stmt_values;
         // Silly workaround for https://bugs.llvm.org/show_bug.cgi?id=51515
         single_stmt_values.reserve(3);
-        single_stmt_values.emplace_back(cql3::raw_value::make_value(timeuuid_type->decompose(_group_id.id)));
+        single_stmt_values.emplace_back(cql3::raw_value::make_value(timeuuid_type->decompose(group_id->id)));
         single_stmt_values.emplace_back(cql3::raw_value::make_value(long_type->decompose(int64_t(eptr->term.value()))));
         single_stmt_values.emplace_back(cql3::raw_value::make_value(long_type->decompose(int64_t(eptr->idx.value()))));
 
@@ -266,7 +269,7 @@ future<size_t> raft_sys_table_storage::do_store_log_entries_one_batch(const std:
     co_return 0;
 }
 
-future<> raft_sys_table_storage::do_store_log_entries(const std::vector<raft::log_entry_ptr>& entries) {
+future<> raft_sys_table_storage::do_store_log_entries(std::vector<log_entry_ref> entries) {
     if (entries.empty()) {
         co_return;
     }
@@ -277,9 +280,87 @@ future<> raft_sys_table_storage::do_store_log_entries(const std::vector<raft::lo
     } while (idx != 0);
 }
 
+// Coalesces the log appends of the Raft groups on a shard.
+//
+// Every append of every Raft group is a separate write to system.raft, which
+// lives in the schema commitlog and so pays for its own sync. When
+// raft_log_group_commit_window_in_us is set, an append waits up to that long for
+// the appends of other groups and all of them are stored with a single batch,
+// sharing the sync. The batch is written as soon as it reaches _max_mutation_size.
+//
+// Appends are queued from within execute_with_linearization_point(), so the
+// appends of a single group are still persisted in order.
+class raft_sys_table_storage::group_commit {
+    struct pending_append {
+        raft_sys_table_storage* storage;
+        const std::vector<raft::log_entry_ptr>* entries;
+        promise<> done;
+    };
+    std::vector<pending_append> _pending;
+    size_t _pending_bytes = 0;
+    timer<> _timer;
+
+    void flush() {
+        _timer.cancel();
+        _pending_bytes = 0;
+        // The result is reported to the appenders through their promises.
+        (void)write(std::exchange(_pending, {}));
+    }
+
+    static future<> write(std::vector<pending_append> appends) {
+        std::vector<log_entry_ref> refs;
+        for (auto& a : appends) {
+            for (auto& eptr : *a.entries) {
+                refs.push_back(log_entry_ref{&a.storage->_group_id, eptr.get()});
+            }
+        }
+        std::exception_ptr ex;
+        try {
+            // Every storage on the shard writes through the same query processor, so use the first one.
+            // It's alive until its append is resolved.
+            co_await appends.front().storage->do_store_log_entries(std::move(refs));
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        for (auto& a : appends) {
+            if (ex) {
+                a.done.set_exception(ex);
+            } else {
+                a.done.set_value();
+            }
+        }
+    }
+public:
+    group_commit() : _timer([this] { flush(); }) {}
+
+    future<> append(raft_sys_table_storage& storage, const std::vector<raft::log_entry_ptr>& entries, std::chrono::microseconds window) {
+        auto& a = _pending.emplace_back(pending_append{&storage, &entries, promise<>()});
+        auto f = a.done.get_future();
+        for (auto& eptr : entries) {
+            _pending_bytes += ser::get_sizeof(eptr->data);
+        }
+        if (_pending_bytes >= storage._max_mutation_size) {
+            flush();
+        } else if (!_timer.armed()) {
+            _timer.arm(window);
+        }
+        return f;
+    }
+};
+
+static raft_sys_table_storage::group_commit& local_group_commit() {
+    static thread_local raft_sys_table_storage::group_commit instance;
+    return instance;
+}
+
 future<> raft_sys_table_storage::store_log_entries(const std::vector<raft::log_entry_ptr>& entries) {
     return execute_with_linearization_point([this, &entries] {
-        return do_store_log_entries(entries);
+        auto window = std::chrono::microseconds(_qp.db().get_config().raft_log_group_commit_window_in_us());
+        if (window.count() && !entries.empty()) {
+            return local_group_commit().append(*this, entries, window);
+        }
+        return do_store_log_entries(boost::copy_range<std::vector<log_entry_ref>>(entries
+                | boost::adaptors::transformed([this] (const raft::log_entry_ptr& eptr) { return log_entry_ref{&_group_id, eptr.get()}; })));
     });
 }
 
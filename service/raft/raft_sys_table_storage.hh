@@ -54,6 +54,13 @@ class raft_sys_table_storage : public raft::persistence {
     const size_t _max_mutation_size;
 
 public:
+    // A log entry of some Raft group, to be stored in system.raft.
+    struct log_entry_ref {
+        const raft::group_id* group_id;
+        const raft::log_entry* entry;
+    };
+    class group_commit;
+
     explicit raft_sys_table_storage(cql3::query_processor& qp, raft::group_id gid, raft::server_id server_id);
 
     future<> store_term_and_vote(raft::term_t term, raft::server_id vote) override;
@@ -83,8 +90,10 @@ class raft_sys_table_storage : public raft::persistence {
     future<> bootstrap(raft::configuration initial_configuation, bool nontrivial_snapshot);
 private:
 
-    future<size_t> do_store_log_entries_one_batch(const std::vector<raft::log_entry_ptr>& entries, size_t start_idx);
-    future<> do_store_log_entries(const std::vector<raft::log_entry_ptr>& entries);
+    // Stores entries starting from start_idx in a single batch, up to _max_mutation_size bytes.
+    // Returns the index of the first entry which wasn't stored, or 0 if all were stored.
+    future<size_t> do_store_log_entries_one_batch(const std::vector<log_entry_ref>& entries, size_t start_idx);
+    future<> do_store_log_entries(const std::vector<log_entry_ref>& entries);
     // Truncate all entries from the persisted log with indices <= idx
     // Called from the `store_snapshot` function.
     future<> update_snapshot_and_truncate_log_tail(const raft::snapshot_descriptor &snap, size_t preserve_log_entries);
@@ -14,6 +14,8 @@
 
 #include <fmt/ranges.h>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/util/defer.hh>
 #include "partition_range_compat.hh"
 #include "db/consistency_level.hh"
@@ -56,6 +58,7 @@
 #include "service/migration_manager.hh"
 #include "service/client_state.hh"
 #include "service/paxos/proposal.hh"
+#include "service/batched_mutation.hh"
 #include "locator/token_metadata.hh"
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
@@ -71,6 +74,7 @@
 #include "idl/frozen_schema.dist.hh"
 #include "idl/frozen_schema.dist.impl.hh"
 #include "idl/storage_proxy.dist.hh"
+#include "idl/read_command.dist.impl.hh"
 #include "utils/result_combinators.hh"
 #include "utils/result_loop.hh"
 #include "utils/result_try.hh"
@@ -215,6 +219,21 @@ class storage_proxy::remote {
 
     bool _stopped{false};
 
+    // Mutations gathered for one replica, to be sent in a single
+    // MUTATION_BATCH message, see send_mutation().
+    struct mutation_batch {
+        scheduling_group sg;
+        fencing_token fence;
+        storage_proxy::clock_type::time_point timeout = storage_proxy::clock_type::time_point::min();
+        std::vector<batched_mutation> mutations;
+        size_t size = 0;
+        shared_promise<> sent;
+        timer<> flush_timer;
+
+        mutation_batch(scheduling_group sg, fencing_token fence) : sg(sg), fence(fence) {}
+    };
+    std::unordered_map<gms::inet_address, std::unique_ptr<mutation_batch>> _mutation_batches;
+
 public:
     remote(storage_proxy& sp, netw::messaging_service& ms, gms::gossiper& g, migration_manager& mm, sharded<db::system_keyspace>& sys_ks)
         : _sp(sp), _ms(ms), _gossiper(g), _mm(mm), _sys_ks(sys_ks)
@@ -223,6 +242,7 @@ class storage_proxy::remote {
     {
         ser::storage_proxy_rpc_verbs::register_counter_mutation(&_ms, std::bind_front(&remote::handle_counter_mutation, this));
         ser::storage_proxy_rpc_verbs::register_mutation(&_ms, std::bind_front(&remote::receive_mutation_handler, this, _sp._write_smp_service_group));
+        ser::storage_proxy_rpc_verbs::register_mutation_batch(&_ms, std::bind_front(&remote::receive_mutation_batch_handler, this));
         ser::storage_proxy_rpc_verbs::register_hint_mutation(&_ms, std::bind_front(&remote::receive_hint_mutation_handler, this));
         ser::storage_proxy_rpc_verbs::register_paxos_learn(&_ms, std::bind_front(&remote::handle_paxos_learn, this));
         ser::storage_proxy_rpc_verbs::register_mutation_done(&_ms, std::bind_front(&remote::handle_mutation_done, this));
@@ -243,6 +263,9 @@ class storage_proxy::remote {
 
     // Must call before destroying the `remote` object.
     future<> stop() {
+        while (!_mutation_batches.empty()) {
+            flush_mutation_batch(_mutation_batches.begin()->first);
+        }
         co_await ser::storage_proxy_rpc_verbs::unregister(&_ms);
         _stopped = true;
     }
@@ -271,12 +294,84 @@ class storage_proxy::remote {
             const frozen_mutation& m, const inet_address_vector_replica_set& forward, gms::inet_address reply_to, unsigned shard,
             storage_proxy::response_id_type response_id, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) {
+        // Mutations of this shard's own writes can be coalesced; forwarded
+        // ones aren't, since their responses go to another coordinator.
+        if (forward.empty() && shard == this_shard_id() && reply_to == _sp.my_address()) {
+            auto& cfg = _sp.local_db().get_config();
+            if (auto window = cfg.internode_write_coalescing_window_in_us(); window && _sp.features().mutation_batch_verb) {
+                return send_batched_mutation(addr.addr, timeout, trace_info, m, response_id, rate_limit_info, fence,
+                        std::chrono::microseconds(window), cfg.internode_write_coalescing_max_bytes());
+            }
+        }
         return ser::storage_proxy_rpc_verbs::send_mutation(
                 &_ms, std::move(addr), timeout,
                 m, forward, std::move(reply_to), shard,
                 response_id, trace_info, rate_limit_info, fence);
     }
 
+private:
+    // Adds the mutation to the batch of mutations for the replica, starting
+    // one if needed. The batch is sent when its window expires, or earlier
+    // if it grows above max_size. The returned future resolves when the
+    // batch is sent, like the one of a single mutation's send.
+    //
+    // A batch only holds mutations of one scheduling group, so that it is
+    // sent over the connection of their service level, and with the same
+    // fencing token.
+    future<> send_batched_mutation(gms::inet_address ep, storage_proxy::clock_type::time_point timeout,
+            const std::optional<tracing::trace_info>& trace_info, const frozen_mutation& m,
+            storage_proxy::response_id_type response_id, db::per_partition_rate_limit::info rate_limit_info,
+            fencing_token fence, std::chrono::microseconds window, size_t max_size) {
+        auto sg = current_scheduling_group();
+        auto it = _mutation_batches.find(ep);
+        if (it != _mutation_batches.end() && (it->second->sg != sg || it->second->fence.topology_version != fence.topology_version)) {
+            flush_mutation_batch(ep);
+            it = _mutation_batches.end();
+        }
+        if (it == _mutation_batches.end()) {
+            it = _mutation_batches.emplace(ep, std::make_unique<mutation_batch>(sg, fence)).first;
+            it->second->flush_timer.set_callback(sg, [this, ep] { flush_mutation_batch(ep); });
+            it->second->flush_timer.arm(window);
+        }
+        auto& b = *it->second;
+        b.mutations.push_back(batched_mutation{m, response_id, trace_info, rate_limit_info});
+        b.size += m.representation().size();
+        b.timeout = std::max(b.timeout, timeout);
+        auto f = b.sent.get_shared_future();
+        if (b.size >= max_size) {
+            flush_mutation_batch(ep);
+        }
+        return f;
+    }
+
+    void flush_mutation_batch(gms::inet_address ep) {
+        auto it = _mutation_batches.find(ep);
+        if (it == _mutation_batches.end()) {
+            return;
+        }
+        auto b = std::move(it->second);
+        _mutation_batches.erase(it);
+        b->flush_timer.cancel();
+        // The timeout of the batch is the latest of its mutations', so that
+        // none of them is dropped before its own timeout.
+        (void)with_scheduling_group(b->sg, [this, ep, &b = *b] {
+            auto& stats = _sp.get_stats();
+            stats.coalesced_mutations += b.mutations.size();
+            ++stats.coalesced_mutation_batches;
+            return ser::storage_proxy_rpc_verbs::send_mutation_batch(
+                    &_ms, netw::messaging_service::msg_addr{ep, 0}, b.timeout,
+                    b.mutations, _sp.my_address(), this_shard_id(), b.fence);
+        }).then_wrapped([b = std::move(b)] (future<> f) {
+            if (f.failed()) {
+                b->sent.set_exception(f.get_exception());
+            } else {
+                b->sent.set_value();
+            }
+        });
+    }
+
+public:
+
     future<> send_hint_mutation(
             netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
             const frozen_mutation& m, const inet_address_vector_replica_set& forward, gms::inet_address reply_to, unsigned shard,
@@ -319,16 +414,33 @@ class storage_proxy::remote {
                 shard, response_id, num_failed, std::move(backlog), std::move(exception));
     }
 
+    // Keeps the load piggybacked on a read response, which replicas from
+    // before it was added don't send, for balancing the next reads.
+    void note_replica_load(table_id id, gms::inet_address addr, const rpc::optional<replica_load>& load) {
+        if (!load) {
+            return;
+        }
+        if (auto t = _sp.local_db().get_tables_metadata().get_table_if_exists(id)) {
+            t->set_replica_load(addr, *load);
+        }
+    }
+
+    // The load of this shard, sent back with the read responses.
+    replica_load local_replica_load() {
+        return replica_load(_sp.local_db().get_reader_concurrency_semaphore().get_stats().waiters);
+    }
+
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>>
     send_read_mutation_data(
             netw::msg_addr addr, storage_proxy::clock_type::time_point timeout, tracing::trace_state_ptr tr_state,
             const query::read_command& cmd, const dht::partition_range& pr,
             fencing_token fence) {
         tracing::trace(tr_state, "read_mutation_data: sending a message to /{}", addr.addr);
-        auto&& [result, hit_rate, opt_exception] = co_await ser::storage_proxy_rpc_verbs::send_read_mutation_data(&_ms, addr, timeout, cmd, pr, fence);
+        auto&& [result, hit_rate, opt_exception, opt_load] = co_await ser::storage_proxy_rpc_verbs::send_read_mutation_data(&_ms, addr, timeout, cmd, pr, fence);
         if (opt_exception.has_value() && *opt_exception) {
             co_await coroutine::return_exception_ptr((*opt_exception).into_exception_ptr());
         }
+        note_replica_load(cmd.cf_id, addr.addr, opt_load);
 
         tracing::trace(tr_state, "read_mutation_data: got response from /{}", addr.addr);
         co_return rpc::tuple{make_foreign(::make_lw_shared<reconcilable_result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())};
@@ -341,11 +453,12 @@ class storage_proxy::remote {
             query::digest_algorithm digest_algo, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) {
         tracing::trace(tr_state, "read_data: sending a message to /{}", addr.addr);
-        auto&& [result, hit_rate, opt_exception] =
+        auto&& [result, hit_rate, opt_exception, opt_load] =
             co_await ser::storage_proxy_rpc_verbs::send_read_data(&_ms, addr, timeout, cmd, pr, digest_algo, rate_limit_info, fence);
         if (opt_exception.has_value() && *opt_exception) {
             co_await coroutine::return_exception_ptr((*opt_exception).into_exception_ptr());
         }
+        note_replica_load(cmd.cf_id, addr.addr, opt_load);
 
         tracing::trace(tr_state, "read_data: got response from /{}", addr.addr);
         co_return rpc::tuple{make_foreign(::make_lw_shared<query::result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())};
@@ -358,11 +471,12 @@ class storage_proxy::remote {
             query::digest_algorithm digest_algo, db::per_partition_rate_limit::info rate_limit_info,
             fencing_token fence) {
         tracing::trace(tr_state, "read_digest: sending a message to /{}", addr.addr);
-        auto&& [d, t, hit_rate, opt_exception, opt_last_pos] =
+        auto&& [d, t, hit_rate, opt_exception, opt_last_pos, opt_load] =
             co_await ser::storage_proxy_rpc_verbs::send_read_digest(&_ms, addr, timeout, cmd, pr, digest_algo, rate_limit_info, fence);
         if (opt_exception.has_value() && *opt_exception) {
             co_await coroutine::return_exception_ptr((*opt_exception).into_exception_ptr());
         }
+        note_replica_load(cmd.cf_id, addr.addr, opt_load);
 
         tracing::trace(tr_state, "read_digest: got response from /{}", addr.addr);
         co_return rpc::tuple{d, t ? t.value() : api::missing_timestamp, hit_rate.value_or(cache_temperature::invalid()), opt_last_pos ? std::move(*opt_last_pos) : std::nullopt};
@@ -622,6 +736,17 @@ class storage_proxy::remote {
                 });
     }
 
+    future<rpc::no_wait_type> receive_mutation_batch_handler(
+            const rpc::client_info& cinfo, rpc::opt_time_point t,
+            std::vector<batched_mutation> mutations, gms::inet_address reply_to, unsigned shard,
+            fencing_token fence) {
+        co_await coroutine::parallel_for_each(mutations, [&] (batched_mutation& bm) {
+            return receive_mutation_handler(_sp._write_smp_service_group, cinfo, t, std::move(bm.fm), {}, reply_to, shard,
+                    bm.response_id, std::move(bm.trace_info), bm.rate_limit_info, fence).discard_result();
+        });
+        co_return netw::messaging_service::no_wait();
+    }
+
     future<rpc::no_wait_type> receive_hint_mutation_handler(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
             frozen_mutation in, inet_address_vector_replica_set forward, gms::inet_address reply_to,
@@ -692,6 +817,9 @@ class storage_proxy::remote {
                     } else if constexpr (std::is_same_v<Ex, replica::abort_requested_exception>) {
                         msg = e.what();
                         return error::FAILURE;
+                    } else if constexpr (std::is_same_v<Ex, replica::not_cached_exception>) {
+                        msg = e.what();
+                        return error::FAILURE;
                     }
                 }, exception->reason);
             }
@@ -835,34 +963,40 @@ class storage_proxy::remote {
     }
 
     using read_data_result_t = rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature, replica::exception_variant>;
-    future<read_data_result_t> handle_read_data(
+    using read_data_reply_t = rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature, replica::exception_variant, replica_load>;
+    future<read_data_reply_t> handle_read_data(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
             query::read_command cmd1, ::compat::wrapping_partition_range pr,
             rpc::optional<query::digest_algorithm> oda,
             rpc::optional<db::per_partition_rate_limit::info> rate_limit_info_opt,
             rpc::optional<service::fencing_token> fence) {
-        return handle_read<read_data_result_t, read_verb::read_data>(cinfo, t, std::move(cmd1),
+        auto result = co_await handle_read<read_data_result_t, read_verb::read_data>(cinfo, t, std::move(cmd1),
             std::move(pr), oda, rate_limit_info_opt, fence);
+        co_return utils::tuple_insert<read_data_reply_t>(std::move(result), local_replica_load());
     }
 
     using read_mutation_data_result_t = rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature, replica::exception_variant>;
-    future<read_mutation_data_result_t> handle_read_mutation_data(
+    using read_mutation_data_reply_t = rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature, replica::exception_variant, replica_load>;
+    future<read_mutation_data_reply_t> handle_read_mutation_data(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
             query::read_command cmd1, ::compat::wrapping_partition_range pr,
             rpc::optional<service::fencing_token> fence) {
-        return handle_read<read_mutation_data_result_t, read_verb::read_mutation_data>(cinfo, t, std::move(cmd1),
+        auto result = co_await handle_read<read_mutation_data_result_t, read_verb::read_mutation_data>(cinfo, t, std::move(cmd1),
             std::move(pr), std::nullopt, std::nullopt, fence);
+        co_return utils::tuple_insert<read_mutation_data_reply_t>(std::move(result), local_replica_load());
     }
 
     using read_digest_result_t = rpc::tuple<query::result_digest, long, cache_temperature, replica::exception_variant, std::optional<full_position>>;
-    future<read_digest_result_t> handle_read_digest(
+    using read_digest_reply_t = rpc::tuple<query::result_digest, long, cache_temperature, replica::exception_variant, std::optional<full_position>, replica_load>;
+    future<read_digest_reply_t> handle_read_digest(
             const rpc::client_info& cinfo, rpc::opt_time_point t,
             query::read_command cmd1, ::compat::wrapping_partition_range pr,
             rpc::optional<query::digest_algorithm> oda,
             rpc::optional<db::per_partition_rate_limit::info> rate_limit_info_opt,
             rpc::optional<service::fencing_token> fence) {
-        return handle_read<read_digest_result_t, read_verb::read_digest>(cinfo, t, std::move(cmd1),
+        auto result = co_await handle_read<read_digest_result_t, read_verb::read_digest>(cinfo, t, std::move(cmd1),
             std::move(pr), oda, rate_limit_info_opt, fence);
+        co_return utils::tuple_insert<read_digest_reply_t>(std::move(result), local_replica_load());
     }
 
     future<> handle_truncate(rpc::opt_time_point timeout, sstring ksname, sstring cfname) {
@@ -982,7 +1116,9 @@ using namespace exceptions;
 
 static inline
 query::digest_algorithm digest_algorithm(service::storage_proxy& proxy) {
-    return query::digest_algorithm::xxHash;
+    // Replicas compute the digests with the algorithm of the request, so all
+    // of them must support it.
+    return proxy.features().xxh3_digest ? query::digest_algorithm::xxh3 : query::digest_algorithm::xxHash;
 }
 
 static inline
@@ -1149,7 +1285,7 @@ class per_destination_mutation : public mutation_holder {
 };
 
 // same mutation for each destination
-class shared_mutation : public mutation_holder {
+class shared_mutation : public mutation_holder, public utils::pooled_allocation<shared_mutation> {
 protected:
     lw_shared_ptr<const frozen_mutation> _mutation;
 public:
@@ -1275,6 +1411,9 @@ class paxos_response_handler : public enable_shared_from_this<paxos_response_han
         utils::UUID ballot;
         // Current value of the requested key or none.
         foreign_ptr<lw_shared_ptr<query::result>> data;
+        // True if no round was found in progress and all the replicas which
+        // promised the ballot had already learned the most recent commit.
+        bool settled = false;
     };
 
     // Steps of the Paxos protocol
@@ -1669,7 +1808,9 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
     void update_cancellable_live_iterators();
 };
 
-class datacenter_write_response_handler : public abstract_write_response_handler {
+// The handlers of the data path writes are allocated and freed for every
+// write, their memory is recycled (see utils::pooled_allocation).
+class datacenter_write_response_handler : public abstract_write_response_handler, public utils::pooled_allocation<datacenter_write_response_handler> {
     bool waited_for(gms::inet_address from) override {
         const auto& topo = _effective_replication_map_ptr->get_topology();
         return topo.is_me(from) || (topo.get_datacenter(from) == topo.get_datacenter());
@@ -1689,7 +1830,7 @@ class datacenter_write_response_handler : public abstract_write_response_handler
     }
 };
 
-class write_response_handler : public abstract_write_response_handler {
+class write_response_handler : public abstract_write_response_handler, public utils::pooled_allocation<write_response_handler> {
     bool waited_for(gms::inet_address from) override {
         return true;
     }
@@ -1954,6 +2095,7 @@ paxos_response_handler::begin_and_repair_paxos(client_state& cs, unsigned& conte
         auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(ballot);
 
         inet_address_vector_replica_set missing_mrc = summary.replicas_missing_most_recent_commit(_schema, now_in_sec);
+        bool settled = missing_mrc.empty();
         if (missing_mrc.size() > 0) {
             paxos::paxos_state::logger.debug("CAS[{}] Repairing replicas that missed the most recent commit", _id);
             tracing::trace(tr_state, "Repairing replicas that missed the most recent commit");
@@ -1975,7 +2117,7 @@ paxos_response_handler::begin_and_repair_paxos(client_state& cs, unsigned& conte
                 continue;
             }
         }
-        co_return ballot_and_data{ballot, std::move(summary.data)};
+        co_return ballot_and_data{ballot, std::move(summary.data), settled};
     }
 }
 
@@ -2510,6 +2652,38 @@ void storage_proxy::update_view_update_backlog() {
     _max_view_update_backlog.add(get_db().local().get_view_update_backlog());
 }
 
+bool storage_proxy::tracks_replica_read_latencies() const {
+    auto& cfg = _db.local().get_config();
+    return cfg.speculative_retry_per_replica() || cfg.read_latency_read_balancing();
+}
+
+void storage_proxy::register_replica_read_latency(gms::inet_address ep, bool digest, std::chrono::steady_clock::duration latency) {
+    auto& l = _replica_read_latencies[ep];
+    auto now = clock_type::now();
+    // Decay the recorded latencies a little, as the latencies of tables are,
+    // to give the recent ones more weight.
+    if (now - l.last_decay > std::chrono::seconds(1)) {
+        l.data *= 0.9;
+        l.digest *= 0.9;
+        l.last_decay = now;
+    }
+    (digest ? l.digest : l.data).add(latency);
+}
+
+std::optional<std::chrono::microseconds> storage_proxy::get_replica_read_latency_quantile(gms::inet_address ep, bool digest, double quantile) const {
+    // With fewer reads, the quantiles of a replica are too noisy to go by.
+    static constexpr uint64_t min_reads = 100;
+    auto it = _replica_read_latencies.find(ep);
+    if (it == _replica_read_latencies.end()) {
+        return std::nullopt;
+    }
+    auto& h = digest ? it->second.digest : it->second.data;
+    if (h.count() < min_reads) {
+        return std::nullopt;
+    }
+    return std::chrono::microseconds(h.quantile(quantile));
+}
+
 db::view::update_backlog storage_proxy::get_view_update_backlog() {
     return _max_view_update_backlog.fetch();
 }
@@ -2651,6 +2825,10 @@ void storage_proxy_stats::write_stats::register_stats() {
                     sm::description("number of CQL read requests which arrived to a non-replica and had to be forwarded to a replica"),
                     {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+            sm::make_total_operations("coalesced_reads", coalesced_reads,
+                    sm::description("number of single partition reads which got the result of an identical read in progress instead of being executed"),
+                    {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
             sm::make_total_operations("writes_failed_due_to_too_many_in_flight_hints", writes_failed_due_to_too_many_in_flight_hints,
                     sm::description("number of CQL write requests which failed because the hinted handoff mechanism is overloaded "
                     "and cannot store any more in-flight hints"),
@@ -2718,6 +2896,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of background read repairs"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("range_read_digest_mismatch_splits", range_read_digest_mismatch_splits,
+                       sm::description("number of range reads of merged ranges whose digests didn't match, and whose ranges were read again separately"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("read_timeouts", [this]{return read_timeouts.count(); },
                        sm::description("number of read request failed due to a timeout"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
@@ -2798,6 +2980,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("CAS read rounds issued only if previous value is missing on some replica"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("cas_skipped_empty_proposal", cas_skipped_empty_proposal,
+                       sm::description("CAS operations which didn't apply an update and completed without proposing an empty one"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_histogram("cas_read_contention", sm::description("how many contended reads were encountered"),
                        {storage_proxy_stats::current_scheduling_group_label()},
                        [this]{ return cas_read_contention.get_histogram(1, 8);}).set_skip_when_empty(),
@@ -2844,6 +3030,14 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of errors during forwarding mutations to other replica Nodes"),
                        {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
 
+        sm::make_total_operations("coalesced_mutations", coalesced_mutations,
+                       sm::description("number of mutations sent to replica Nodes coalesced with other mutations in a single message"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
+        sm::make_total_operations("coalesced_mutation_batches", coalesced_mutation_batches,
+                       sm::description("number of messages carrying coalesced mutations sent to replica Nodes"),
+                       {storage_proxy_stats::current_scheduling_group_label()}).set_skip_when_empty(),
+
         sm::make_total_operations("reads", replica_data_reads,
                        sm::description("number of remote data read requests this Node received"),
                        {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("data")}).set_skip_when_empty(),
@@ -4323,12 +4517,20 @@ future<result<>> storage_proxy::schedule_repair(locator::effective_replication_m
     return mutate_internal(diffs | std::views::values | std::views::transform([ermp] (auto& v) { return read_repair_mutation{std::move(v), ermp}; }), cl, false, std::move(trace_state), std::move(permit));
 }
 
+// CACHE ONLY reads which miss the cache are reported to the client as read
+// failures, told apart from the other ones by the message.
+static read_failure_exception make_not_cached_exception(const schema& s, db::consistency_level cl, int32_t received, int32_t failures, int32_t block_for, bool data_present) {
+    return read_failure_exception(seastar::format("Not cached: CACHE ONLY read of {}.{} missed the cache of {} replicas", s.ks_name(), s.cf_name(), failures),
+            cl, received, failures, block_for, data_present);
+}
+
 class abstract_read_resolver {
 protected:
     enum class error_kind : uint8_t {
         FAILURE,
         DISCONNECT,
         RATE_LIMIT,
+        NOT_CACHED,
     };
     db::consistency_level _cl;
     size_t _targets_count;
@@ -4371,6 +4573,9 @@ class abstract_read_resolver {
         if (try_catch<replica::rate_limit_exception>(eptr)) {
             // There might be a lot of those, so ignore
             kind = error_kind::RATE_LIMIT;
+        } else if (try_catch<replica::not_cached_exception>(eptr)) {
+            // expected by CACHE ONLY reads, not a replica failure
+            kind = error_kind::NOT_CACHED;
         } else if (try_catch<rpc::closed_error>(eptr)) {
             // do not report connection closed exception, gossiper does that
             kind = error_kind::DISCONNECT;
@@ -4522,6 +4727,9 @@ class digest_read_resolver : public abstract_read_resolver {
             case error_kind::RATE_LIMIT:
                 fail_request(exceptions::rate_limit_exception(_schema->ks_name(), _schema->cf_name(), db::operation_type::read, false));
                 break;
+            case error_kind::NOT_CACHED:
+                fail_request(make_not_cached_exception(*_schema, _cl, _cl_responses, _failed, _block_for, _data_result));
+                break;
             case error_kind::DISCONNECT:
             case error_kind::FAILURE:
                 fail_request(read_failure_exception(_schema->ks_name(), _schema->cf_name(), _cl, _cl_responses, _failed, _block_for, _data_result));
@@ -4846,6 +5054,9 @@ class data_read_resolver : public abstract_read_resolver {
         case error_kind::RATE_LIMIT:
             fail_request(exceptions::rate_limit_exception(_schema->ks_name(), _schema->cf_name(), db::operation_type::read, false));
             break;
+        case error_kind::NOT_CACHED:
+            fail_request(make_not_cached_exception(*_schema, _cl, response_count(), 1, _targets_count, response_count() != 0));
+            break;
         case error_kind::DISCONNECT:
         case error_kind::FAILURE:
             fail_request(read_failure_exception(_schema->ks_name(), _schema->cf_name(), _cl, response_count(), 1, _targets_count, response_count() != 0));
@@ -5064,6 +5275,9 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     bool _foreground = true;
     service_permit _permit; // holds admission permit until operation completes
     db::per_partition_rate_limit::info _rate_limit_info;
+    // Set by execute_split_on_digest_mismatch().
+    bool _split_on_digest_mismatch = false;
+    bool _digest_mismatch = false;
 
 private:
     const bool _native_reversed_queries_enabled;
@@ -5201,6 +5415,9 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     ++_proxy->get_stats().data_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
                     register_request_latency(latency_clock::now() - start);
+                    if (_proxy->tracks_replica_read_latencies()) {
+                        _proxy->register_replica_read_latency(ep, false, latency_clock::now() - start);
+                    }
                     return;
                   } else {
                     ex = f.get_exception();
@@ -5228,6 +5445,9 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     ++_proxy->get_stats().digest_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
                     register_request_latency(latency_clock::now() - start);
+                    if (_proxy->tracks_replica_read_latencies()) {
+                        _proxy->register_replica_read_latency(ep, true, latency_clock::now() - start);
+                    }
                     return;
                   } else {
                     ex = f.get_exception();
@@ -5434,6 +5654,11 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                         background_repair_check = true;
                     }
                     exec->on_read_resolved();
+                } else if (exec->_split_on_digest_mismatch) {
+                    tracing::trace(exec->_trace_state, "digest mismatch, reading the merged ranges separately");
+                    exec->_digest_mismatch = true;
+                    exec->_result_promise.set_value(std::move(result));
+                    exec->on_read_resolved();
                 } else { // digest mismatch
                     // Do not optimize cross-dc repair if read_timestamp is missing (or just negative)
                     // We're interested in reads that happen within write_timeout of a write,
@@ -5492,7 +5717,37 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         return _max_request_latency;
     }
 
+    // Executes the read of a range merged from several sub-ranges. When the
+    // digests of the replicas don't match, rather than reconciling the whole
+    // range, the sub-ranges are read again separately, so that only those
+    // whose digests don't match are reconciled, with their full data fetched
+    // from all the replicas.
+    future<result<foreign_ptr<lw_shared_ptr<query::result>>>> execute_split_on_digest_mismatch(storage_proxy::clock_type::time_point timeout,
+            dht::partition_range_vector subranges) {
+        auto exec = shared_from_this();
+        _split_on_digest_mismatch = true;
+        auto res = co_await execute(timeout);
+        if (!res || !_digest_mismatch) {
+            co_return res;
+        }
+        _proxy->get_stats().range_read_digest_mismatch_splits++;
+        std::vector<::shared_ptr<abstract_read_executor>> split_exec;
+        split_exec.reserve(subranges.size());
+        for (auto& r : subranges) {
+            split_exec.push_back(make_split_executor(std::move(r)));
+        }
+        query::result_merger merger(_cmd->get_row_limit(), _cmd->partition_limit);
+        merger.reserve(split_exec.size());
+        co_return co_await utils::result_map_reduce(split_exec.begin(), split_exec.end(), [timeout] (::shared_ptr<abstract_read_executor>& rex) {
+            return rex->execute(timeout);
+        }, std::move(merger));
+    }
+
 private:
+    // Makes an executor reading the given sub-range of the range of this one,
+    // from the same targets.
+    ::shared_ptr<abstract_read_executor> make_split_executor(dht::partition_range pr) const;
+
     void register_request_latency(latency_clock::duration d) {
         _max_request_latency = std::max(_max_request_latency, d);
     }
@@ -5512,6 +5767,11 @@ class never_speculating_read_executor : public abstract_read_executor {
     }
 };
 
+::shared_ptr<abstract_read_executor> abstract_read_executor::make_split_executor(dht::partition_range pr) const {
+    return ::make_shared<never_speculating_read_executor>(_schema, _cf, _proxy, _effective_replication_map_ptr, _cmd, std::move(pr), _cl, _targets,
+            _trace_state, _permit, _rate_limit_info);
+}
+
 // this executor always asks for one additional data reply
 class always_speculating_read_executor : public abstract_read_executor {
 public:
@@ -5563,7 +5823,7 @@ class speculating_read_executor : public abstract_read_executor {
         });
         auto& sr = _schema->speculative_retry();
         auto t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
-            std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
+            std::min(speculation_threshold(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
             std::chrono::milliseconds(unsigned(sr.get_value()));
         _speculate_timer.arm(t);
 
@@ -5591,6 +5851,29 @@ class speculating_read_executor : public abstract_read_executor {
     virtual void adjust_targets_for_reconciliation() override {
         _targets = used_targets();
     }
+private:
+    // The time after which the responses of the replicas read from are
+    // overdue: the highest of their own latency quantiles, for the kind of
+    // read each of them is sent. Falls back to the latency quantile of the
+    // table while some of them have too few reads recorded.
+    std::chrono::milliseconds speculation_threshold(double quantile) const {
+        if (_proxy->get_db().local().get_config().speculative_retry_per_replica()) {
+            // Mirrors make_requests(): with read repair, all the targets are
+            // read from, the first two with data reads.
+            bool read_repair = _block_for < _targets.size() - 1;
+            size_t data_targets = read_repair ? 2 : 1;
+            size_t read_targets = read_repair ? _targets.size() : _targets.size() - 1;
+            std::optional<std::chrono::microseconds> threshold = std::chrono::microseconds(0);
+            for (size_t i = 0; i < read_targets && threshold; ++i) {
+                auto q = _proxy->get_replica_read_latency_quantile(_targets[i], i >= data_targets, quantile);
+                threshold = q ? std::make_optional(std::max(*threshold, *q)) : std::nullopt;
+            }
+            if (threshold) {
+                return std::max(std::chrono::duration_cast<std::chrono::milliseconds>(*threshold), std::chrono::milliseconds(1));
+            }
+        }
+        return _cf->get_coordinator_read_latency_percentile(quantile);
+    }
 };
 
 result<::shared_ptr<abstract_read_executor>> storage_proxy::get_read_executor(lw_shared_ptr<query::read_command> cmd,
@@ -5608,6 +5891,9 @@ result<::shared_ptr<abstract_read_executor>> storage_proxy::get_read_executor(lw
     std::optional<gms::inet_address> extra_replica;
 
     inet_address_vector_replica_set all_replicas = get_endpoints_for_reading(schema->ks_name(), *erm, token);
+    if (all_replicas.size() > 1 && _db.local().get_config().read_latency_read_balancing()) {
+        sort_endpoints_by_read_latency(erm->get_topology(), all_replicas);
+    }
     // Check for a non-local read before heat-weighted load balancing
     // reordering of endpoints happens. The local endpoint, if
     // present, is always first in the list, as get_endpoints_for_reading()
@@ -5855,6 +6141,69 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
     co_return coordinator_query_result(std::move(result).value(), std::move(used_replicas), repair_decision);
 }
 
+// Reads return the same result if they have the same command, except for
+// the query id, which only names the readers saved by the replicas for the
+// next page, and are of the same partition, with the same consistency level.
+// The command includes the query time, in seconds.
+static bytes coalesced_read_key(const query::read_command& cmd, const dht::partition_range& pr, db::consistency_level cl) {
+    auto key_cmd = cmd;
+    key_cmd.query_uuid = query_id::create_null_id();
+    bytes_ostream out;
+    ser::serialize(out, key_cmd);
+    ser::serialize(out, uint8_t(cl));
+    out.write(to_bytes(pr.start()->value().key()->representation()));
+    return to_bytes(out.linearize());
+}
+
+static query::result copy_query_result(const query::result& r) {
+    return query::result(bytes_ostream(r.buf()), r.digest(), r.last_modified(), r.is_short_read(),
+            r.row_count_low_bits(), r.partition_count(), r.row_count_high_bits(), r.last_position());
+}
+
+future<result<storage_proxy::coordinator_query_result>>
+storage_proxy::query_singular_coalesced(lw_shared_ptr<query::read_command> cmd,
+        dht::partition_range_vector&& partition_ranges,
+        db::consistency_level cl,
+        storage_proxy::coordinator_query_options query_options) {
+    auto key = coalesced_read_key(*cmd, partition_ranges.front(), cl);
+    if (auto it = _coalesced_reads.find(key); it != _coalesced_reads.end()) {
+        auto read = it->second;
+        ++read->waiters;
+        get_stats().coalesced_reads++;
+        co_await read->done.get_shared_future();
+        if (read->exception) {
+            co_return coroutine::exception(read->exception);
+        }
+        if (read->error) {
+            co_return bo::failure(read->error->clone());
+        }
+        co_return coordinator_query_result(make_foreign(make_lw_shared<query::result>(copy_query_result(*read->result))),
+                read->last_replicas, read->read_repair_decision);
+    }
+
+    auto read = make_lw_shared<coalesced_read>();
+    read->key = std::move(key);
+    _coalesced_reads.emplace(read->key, read);
+    auto f = co_await coroutine::as_future(query_singular(std::move(cmd), std::move(partition_ranges), cl, std::move(query_options)));
+    _coalesced_reads.erase(read->key);
+    if (f.failed()) {
+        read->exception = f.get_exception();
+        read->done.set_value();
+        co_return coroutine::exception(read->exception);
+    }
+    auto res = f.get();
+    if (!res) {
+        read->error = res.error().clone();
+    } else if (read->waiters) {
+        // The result may be owned by another shard.
+        read->result = make_lw_shared<query::result>(copy_query_result(*res.value().query_result));
+        read->last_replicas = res.value().last_replicas;
+        read->read_repair_decision = res.value().read_repair_decision;
+    }
+    read->done.set_value();
+    co_return std::move(res);
+}
+
 bool storage_proxy::is_worth_merging_for_range_query(
         const locator::topology& topo,
         inet_address_vector_replica_set& merged,
@@ -5913,6 +6262,7 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
     for (;;) {
         std::vector<::shared_ptr<abstract_read_executor>> exec;
         std::unordered_map<abstract_read_executor*, std::vector<dht::token_range>> ranges_per_exec;
+        std::unordered_map<abstract_read_executor*, dht::partition_range_vector> subranges_per_exec;
         dht::partition_range_vector ranges = ranges_to_vnodes(concurrency_factor);
         dht::partition_range_vector::iterator i = ranges.begin();
 
@@ -5928,6 +6278,7 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
             inet_address_vector_replica_set merged_preferred_replicas = preferred_replicas_for_range(*i);
             inet_address_vector_replica_set filtered_endpoints = filter_replicas_for_read(cl, *erm, live_endpoints, merged_preferred_replicas, pcf);
             std::vector<dht::token_range> merged_ranges{to_token_range(range)};
+            dht::partition_range_vector merged_partition_ranges{range};
             ++i;
 
             co_await coroutine::maybe_yield();
@@ -6033,6 +6384,7 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
                     filtered_endpoints = std::move(filtered_merged);
                     ++i;
                     merged_ranges.push_back(to_token_range(next_range));
+                    merged_partition_ranges.push_back(next_range);
                     co_await coroutine::maybe_yield();
                 }
             }
@@ -6048,12 +6400,19 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
 
             exec.push_back(::make_shared<never_speculating_read_executor>(schema, cf.shared_from_this(), p, erm, cmd, std::move(range), cl, std::move(filtered_endpoints), trace_state, permit, std::monostate()));
             ranges_per_exec.emplace(exec.back().get(), std::move(merged_ranges));
+            if (merged_partition_ranges.size() > 1) {
+                subranges_per_exec.emplace(exec.back().get(), std::move(merged_partition_ranges));
+            }
         }
 
         query::result_merger merger(cmd->get_row_limit(), cmd->partition_limit);
         merger.reserve(exec.size());
 
-        auto wrapped_result = co_await utils::result_map_reduce(exec.begin(), exec.end(), [timeout] (::shared_ptr<abstract_read_executor>& rex) {
+        auto wrapped_result = co_await utils::result_map_reduce(exec.begin(), exec.end(), [timeout, &subranges_per_exec] (::shared_ptr<abstract_read_executor>& rex) {
+            auto it = subranges_per_exec.find(rex.get());
+            if (it != subranges_per_exec.end()) {
+                return rex->execute_split_on_digest_mismatch(timeout, std::move(it->second));
+            }
             return rex->execute(timeout);
         }, std::move(merger));
 
@@ -6231,10 +6590,12 @@ storage_proxy::do_query(schema_ptr s,
 
         if (query::is_single_partition(partition_ranges[0])) { // do not support mixed partitions (yet?)
             try {
-                return query_singular(cmd,
-                        std::move(partition_ranges),
-                        cl,
-                        std::move(query_options)).finally([lc, p] () mutable {
+                bool coalesce = partition_ranges.size() == 1 && !cmd->trace_info && !query_options.trace_state
+                        && _db.local().get_config().coalesce_concurrent_reads();
+                auto f = coalesce
+                        ? query_singular_coalesced(cmd, std::move(partition_ranges), cl, std::move(query_options))
+                        : query_singular(cmd, std::move(partition_ranges), cl, std::move(query_options));
+                return std::move(f).finally([lc, p] () mutable {
                     p->get_stats().read.mark(lc.stop().latency());
                 });
             } catch (const replica::no_such_column_family&) {
@@ -6418,7 +6779,8 @@ future<bool> storage_proxy::cas(schema_ptr schema, shared_ptr<cas_request> reque
             // Finish the previous PAXOS round, if any, and, as a side effect, compute
             // a ballot (round identifier) which is a) unique b) has good chances of being
             // recent enough.
-            auto [ballot, qr] = co_await handler->begin_and_repair_paxos(query_options.cstate, contentions, write);
+            auto [ballot, qr, settled] = co_await handler->begin_and_repair_paxos(query_options.cstate, contentions, write);
+            const bool prefetched = bool(qr);
             // Read the current values and check they validate the conditions.
             if (qr) {
                 paxos::paxos_state::logger.debug("CAS[{}]: Using prefetched values for CAS precondition",
@@ -6444,6 +6806,15 @@ future<bool> storage_proxy::cas(schema_ptr schema, shared_ptr<cas_request> reque
                     ++get_stats().cas_write_condition_not_met;
                     condition_met = false;
                 }
+                // The value was read by the prepare round itself and all the replicas in the
+                // quorum agree on it, with no round in progress: any later round will see it,
+                // or a newer one, so there is nothing for an empty update to complete.
+                if (settled && prefetched && _db.local().get_config().cas_skip_empty_proposal()) {
+                    paxos::paxos_state::logger.debug("CAS[{}] no round in progress; skipping the proposal of an empty update", handler->id());
+                    tracing::trace(handler->tr_state, "No round in progress; skipping the proposal of an empty update");
+                    ++get_stats().cas_skipped_empty_proposal;
+                    break;
+                }
                 // If a condition is not met we still need to complete paxos round to achieve
                 // linearizability otherwise next write attempt may read different value as described
                 // in https://github.com/scylladb/scylla/issues/6299
@@ -6538,6 +6909,26 @@ void storage_proxy::sort_endpoints_by_proximity(const locator::topology& topo, i
     }
 }
 
+// Orders the replicas by the median latency of the data reads sent to them,
+// keeping this node first and the replicas of the local datacenter ahead of
+// the remote ones. The latencies are compared by histogram bucket, so the
+// replicas of a similar latency keep their order by proximity, and the
+// replicas with too few reads recorded go first, so that their latency is
+// learned (again, once the recorded reads decayed) and a recovered replica
+// gets its share of the reads back.
+void storage_proxy::sort_endpoints_by_read_latency(const locator::topology& topo, inet_address_vector_replica_set& eps) const {
+    const auto& local_dc = topo.get_datacenter();
+    using key = std::tuple<bool, bool, std::chrono::microseconds>;
+    utils::small_vector<std::pair<key, gms::inet_address>, 3> keyed;
+    keyed.reserve(eps.size());
+    for (auto ep : eps) {
+        auto latency = get_replica_read_latency_quantile(ep, false, 0.5);
+        keyed.emplace_back(key(ep != my_address(), topo.get_datacenter(ep) != local_dc, latency.value_or(std::chrono::microseconds(0))), ep);
+    }
+    std::ranges::stable_sort(keyed, std::less<>(), &std::pair<key, gms::inet_address>::first);
+    std::ranges::copy(keyed | std::views::values, eps.begin());
+}
+
 inet_address_vector_replica_set storage_proxy::get_endpoints_for_reading(const sstring& ks_name, const locator::effective_replication_map& erm, const dht::token& token) const {
     auto endpoints = erm.get_endpoints_for_reading(token);
     validate_read_replicas(erm, endpoints);
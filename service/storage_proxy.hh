@@ -15,6 +15,7 @@
 #include "message/messaging_service_fwd.hh"
 #include <seastar/core/distributed.hh>
 #include <seastar/core/execution_stage.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/scheduling_specific.hh>
 #include "db/read_repair_decision.hh"
 #include "db/write_type.hh"
@@ -31,6 +32,7 @@
 #include "db/hints/host_filter.hh"
 #include "utils/phased_barrier.hh"
 #include "utils/small_vector.hh"
+#include "utils/pooled_allocation.hh"
 #include "service/endpoint_lifecycle_subscriber.hh"
 #include <seastar/core/circular_buffer.hh>
 #include "exceptions/coordinator_result.hh"
@@ -191,7 +193,10 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
         response_id_type release();
     };
     using unique_response_handler_vector = utils::small_vector<unique_response_handler, 1>;
-    using response_handlers_map = std::unordered_map<response_id_type, ::shared_ptr<abstract_write_response_handler>>;
+    // The entries live as long as the writes, recycle them.
+    using response_handlers_map = std::unordered_map<response_id_type, ::shared_ptr<abstract_write_response_handler>,
+            std::hash<response_id_type>, std::equal_to<response_id_type>,
+            utils::pooled_allocator<std::pair<const response_id_type, ::shared_ptr<abstract_write_response_handler>>>>;
 
 public:
     static const sstring COORDINATOR_STATS_CATEGORY;
@@ -293,6 +298,33 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     db::view::node_update_backlog& _max_view_update_backlog;
     std::unordered_map<gms::inet_address, view_update_backlog_timestamped> _view_update_backlogs;
 
+    // Latencies of the data and digest reads this shard sent to each replica,
+    // from which the speculative retry thresholds of percentile-based tables
+    // are computed per replica (see speculative_retry_per_replica), and by
+    // which the replicas to read from are ordered (see read_latency_read_balancing).
+    struct replica_read_latency {
+        utils::time_estimated_histogram data;
+        utils::time_estimated_histogram digest;
+        clock_type::time_point last_decay;
+    };
+    std::unordered_map<gms::inet_address, replica_read_latency> _replica_read_latencies;
+
+    // A single partition read in progress, whose result identical reads
+    // issued meanwhile wait for rather than being executed again (see
+    // coalesce_concurrent_reads).
+    struct coalesced_read {
+        bytes key;
+        unsigned waiters = 0;
+        shared_promise<> done;
+        // The result of the read, copied to this shard, or its error.
+        lw_shared_ptr<query::result> result;
+        replicas_per_token_range last_replicas;
+        db::read_repair_decision read_repair_decision = db::read_repair_decision::NONE;
+        std::optional<exceptions::coordinator_exception_container> error;
+        std::exception_ptr exception;
+    };
+    std::unordered_map<bytes, lw_shared_ptr<coalesced_read>> _coalesced_reads;
+
     //NOTICE(sarna): This opaque pointer is here just to avoid moving write handler class definitions from .cc to .hh. It's slow path.
     class cancellable_write_handlers_list;
     std::unique_ptr<cancellable_write_handlers_list> _cancellable_write_handlers_list;
@@ -322,6 +354,12 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
             dht::partition_range_vector&& partition_ranges,
             db::consistency_level cl,
             coordinator_query_options optional_params);
+    // As query_singular() for a single partition, but shares the execution
+    // with the identical reads in progress.
+    future<result<coordinator_query_result>> query_singular_coalesced(lw_shared_ptr<query::read_command> cmd,
+            dht::partition_range_vector&& partition_ranges,
+            db::consistency_level cl,
+            coordinator_query_options optional_params);
     response_id_type register_response_handler(shared_ptr<abstract_write_response_handler>&& h);
     void remove_response_handler(response_id_type id);
     void remove_response_handler_entry(response_handlers_map::iterator entry);
@@ -354,6 +392,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     bool hints_enabled(db::write_type type) const noexcept;
     db::hints::manager& hints_manager_for(db::write_type type);
     void sort_endpoints_by_proximity(const locator::topology& topo, inet_address_vector_replica_set& eps) const;
+    void sort_endpoints_by_read_latency(const locator::topology& topo, inet_address_vector_replica_set& eps) const;
     inet_address_vector_replica_set get_endpoints_for_reading(const sstring& ks_name, const locator::effective_replication_map& erm, const dht::token& token) const;
     inet_address_vector_replica_set filter_replicas_for_read(db::consistency_level, const locator::effective_replication_map&, inet_address_vector_replica_set live_endpoints, const inet_address_vector_replica_set& preferred_endpoints, db::read_repair_decision, std::optional<gms::inet_address>* extra, replica::column_family*) const;
     // As above with read_repair_decision=NONE, extra=nullptr.
@@ -706,6 +745,13 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     future<db::hints::sync_point> create_hint_sync_point(std::vector<gms::inet_address> target_hosts) const;
     future<> wait_for_hint_sync_point(const db::hints::sync_point spoint, clock_type::time_point deadline);
 
+    // Whether the latencies of the reads sent to each replica are recorded.
+    bool tracks_replica_read_latencies() const;
+    void register_replica_read_latency(gms::inet_address ep, bool digest, std::chrono::steady_clock::duration latency);
+    // Returns the given quantile of the latencies of data or digest reads sent
+    // to the replica, or nothing if too few of them completed yet.
+    std::optional<std::chrono::microseconds> get_replica_read_latency_quantile(gms::inet_address ep, bool digest, double quantile) const;
+
     const stats& get_stats() const {
         return scheduling_group_get_specific<storage_proxy_stats::stats>(_stats_key);
     }
@@ -97,6 +97,9 @@ struct write_stats {
     // A CQL read query arrived to a non-replica node and was
     // forwarded by a coordinator to a replica
     uint64_t reads_coordinator_outside_replica_set = 0;
+    // A single partition read waited for an identical read in
+    // progress instead of being executed
+    uint64_t coalesced_reads = 0;
     uint64_t background_writes = 0; // client no longer waits for the write
     uint64_t throttled_writes = 0; // total number of writes ever delayed due to throttling
     uint64_t throttled_base_writes = 0; // current number of base writes delayed due to view update backlog
@@ -108,6 +111,7 @@ struct write_stats {
     uint64_t cas_write_condition_not_met = 0;
     uint64_t cas_write_timeout_due_to_uncertainty = 0;
     uint64_t cas_failed_read_round_optimization = 0;
+    uint64_t cas_skipped_empty_proposal = 0;
     uint16_t cas_now_pruning = 0;
     uint64_t cas_prune = 0;
     uint64_t cas_coordinator_dropped_prune = 0;
@@ -142,6 +146,7 @@ struct stats : public write_stats {
     uint64_t read_repair_attempts = 0;
     uint64_t read_repair_repaired_blocking = 0;
     uint64_t read_repair_repaired_background = 0;
+    uint64_t range_read_digest_mismatch_splits = 0;
     uint64_t global_read_repairs_canceled_due_to_concurrent_write = 0;
 
     // number of mutations received as a coordinator
@@ -154,6 +159,11 @@ struct stats : public write_stats {
     uint64_t forwarded_mutations = 0;
     uint64_t forwarding_errors = 0;
 
+    // number of mutations sent to replicas coalesced in MUTATION_BATCH
+    // messages, and the number of those messages
+    uint64_t coalesced_mutations = 0;
+    uint64_t coalesced_mutation_batches = 0;
+
     // number of read requests received as a replica
     uint64_t replica_data_reads = 0;
     uint64_t replica_digest_reads = 0;
@@ -93,6 +93,7 @@
 #include "utils/error_injection.hh"
 #include "locator/util.hh"
 #include "idl/storage_service.dist.hh"
+#include "idl/streaming.dist.hh"
 #include "service/storage_proxy.hh"
 #include "service/raft/raft_address_map.hh"
 #include "service/raft/join_node.hh"
@@ -913,14 +914,15 @@ future<> storage_service::merge_topology_snapshot(raft_snapshot snp) {
     }
 
     // Apply system.topology and system.topology_requests mutations atomically
-    // to have a consistent state after restart
-    std::vector<mutation> muts;
+    // to have a consistent state after restart. Only the application needs to
+    // be atomic, the conversion yields so that large topologies don't stall.
+    std::vector<frozen_mutation> muts;
     muts.reserve(std::distance(snp.mutations.begin(), it));
-    std::transform(snp.mutations.begin(), it, std::back_inserter(muts), [this] (const canonical_mutation& m) {
-        auto s = _db.local().find_schema(m.column_family_id());
-        return m.to_mutation(s);
-    });
-    co_await _db.local().apply(freeze(muts), db::no_timeout);
+    for (auto i = snp.mutations.begin(); i != it; ++i) {
+        auto s = _db.local().find_schema(i->column_family_id());
+        muts.push_back(co_await freeze_gently(co_await to_mutation_gently(*i, std::move(s))));
+    }
+    co_await _db.local().apply(muts, db::no_timeout);
 }
 
 future<> storage_service::update_service_levels_cache(qos::update_both_cache_levels update_only_effective_cache) {
@@ -5994,6 +5996,37 @@ future<> storage_service::clone_locally_tablet_storage(locator::global_tablet_id
     rtlogger.debug("Successfully loaded storage of tablet {} into pending replica {}", tablet, pending);
 }
 
+future<bool> storage_service::stream_tablet_files(locator::global_tablet_id tablet, dht::token_range range,
+        locator::tablet_replica leaving, locator::tablet_replica pending, abort_source& as) {
+    auto ops_id = streaming::plan_id{utils::make_random_uuid()};
+    auto req = streaming::stream_files_request{
+        .ops_id = ops_id,
+        .table = tablet.table,
+        .range = range,
+        .src_shard_id = leaving.shard,
+        .dst_shard_id = pending.shard,
+    };
+    rtlogger.info("[Stream #{}] Streaming sstables of tablet {} from {} to {} as files", ops_id, tablet, leaving, pending);
+    std::exception_ptr ex;
+    streaming::stream_files_response resp{};
+    try {
+        resp = co_await ser::streaming_rpc_verbs::send_tablet_stream_files(&_messaging.local(), netw::msg_addr(host2ip(leaving.host)), as, req);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    // Load what was received, or remove it if the tablet is to be streamed again.
+    co_await _stream_manager.invoke_on(pending.shard, [ops_id, table = tablet.table, failed = ex || !resp.streamed] (streaming::stream_manager& sm) {
+        return sm.finish_received_files(ops_id, table, failed);
+    });
+    if (ex) {
+        co_return coroutine::exception(std::move(ex));
+    }
+    if (resp.streamed) {
+        rtlogger.info("[Stream #{}] Finished streaming sstables of tablet {} as files, {} bytes", ops_id, tablet, resp.stream_bytes);
+    }
+    co_return resp.streamed;
+}
+
 // Streams data to the pending tablet replica of a given tablet on this node.
 // The source tablet replica is determined from the current transition info of the tablet.
 future<> storage_service::stream_tablet(locator::global_tablet_id tablet) {
@@ -6060,6 +6093,16 @@ future<> storage_service::stream_tablet(locator::global_tablet_id tablet) {
                 throw std::runtime_error(fmt::format("Cannot stream within the same node using regular migration, tablet: {}, shard {} -> {}",
                                                      tablet, leaving_replica->shard, trinfo->pending_replica->shard));
             }
+            bool streamed_as_files = false;
+            if (trinfo->transition == locator::tablet_transition_kind::migration && leaving_replica
+                    && _feature_service.file_stream && _db.local().get_config().enable_file_stream()) {
+                tm = nullptr;
+                streamed_as_files = co_await stream_tablet_files(tablet, range, *leaving_replica, *pending_replica, guard.get_abort_source());
+            }
+          if (!streamed_as_files) {
+            if (!tm) {
+                tm = guard.get_token_metadata();
+            }
             auto& table = _db.local().find_column_family(tablet.table);
             std::vector<sstring> tables = {table.schema()->cf_name()};
             auto my_id = tm->get_my_id();
@@ -6080,6 +6123,7 @@ future<> storage_service::stream_tablet(locator::global_tablet_id tablet) {
             }
             streamer->add_rx_ranges(table.schema()->ks_name(), std::move(ranges_per_endpoint));
             co_await streamer->stream_async();
+          }
         }
 
         // If new pending tablet replica needs splitting, streaming waits for it to complete.
@@ -395,12 +395,23 @@ class load_balancer {
     // due to the average size dropping below the merge threshold, as tablet count doubles.
     const uint64_t _target_tablet_size = default_target_tablet_size;
 
+    // The same thresholds apply to the average load of tablets, in reads and
+    // writes per second, if set. A table is split if its tablets are either too
+    // large or too hot, and it's merged only if they are both small and cold.
+    // The load is a moving average over several minutes, so that the tablet
+    // count doesn't follow short bursts, which the load balancer handles by
+    // moving tablets around.
+    double _target_tablet_ops_rate = 0;
+
     static constexpr uint64_t target_max_tablet_size(uint64_t target_tablet_size) {
         return target_tablet_size * 2;
     }
     static constexpr uint64_t target_min_tablet_size(uint64_t max_tablet_size) {
         return double(max_tablet_size / 2) * 0.5;
     }
+    static constexpr double target_max_tablet_ops_rate(double target_tablet_ops_rate) {
+        return target_tablet_ops_rate * 2;
+    }
 
     struct table_size_desc {
         uint64_t target_max_tablet_size;
@@ -408,10 +419,19 @@ class load_balancer {
         locator::resize_decision resize_decision;
         size_t tablet_count;
         size_t shard_count;
+        // Zero if the tablet count isn't driven by load.
+        double target_max_tablet_ops_rate = 0;
+        double avg_tablet_ops_rate = 0;
 
         uint64_t target_min_tablet_size() const noexcept {
             return load_balancer::target_min_tablet_size(target_max_tablet_size);
         }
+        double target_min_tablet_ops_rate() const noexcept {
+            return target_max_tablet_ops_rate / 4;
+        }
+        bool load_driven() const noexcept {
+            return target_max_tablet_ops_rate > 0;
+        }
     };
 
     struct cluster_resize_load {
@@ -421,10 +441,12 @@ class load_balancer {
 
         static bool table_needs_merge(const table_size_desc& d) {
             // FIXME: ignore merge request if tablet_count == initial_tablets.
-            return d.tablet_count > 1 && d.avg_tablet_size < d.target_min_tablet_size();
+            return d.tablet_count > 1 && d.avg_tablet_size < d.target_min_tablet_size()
+                    && (!d.load_driven() || d.avg_tablet_ops_rate < d.target_min_tablet_ops_rate());
         }
         static bool table_needs_split(const table_size_desc& d) {
-            return d.avg_tablet_size > d.target_max_tablet_size;
+            return d.avg_tablet_size > d.target_max_tablet_size
+                    || (d.load_driven() && d.avg_tablet_ops_rate > d.target_max_tablet_ops_rate);
         }
 
         bool table_needs_resize(const table_size_desc& d) const {
@@ -439,9 +461,11 @@ class load_balancer {
         bool table_needs_resize_cancellation(const table_size_desc& d) const {
             auto& way = d.resize_decision.way;
             if (std::holds_alternative<locator::resize_decision::split>(way)) {
-                return d.avg_tablet_size < d.target_max_tablet_size / 2;
+                return d.avg_tablet_size < d.target_max_tablet_size / 2
+                        && (!d.load_driven() || d.avg_tablet_ops_rate < d.target_max_tablet_ops_rate / 2);
             } else if (std::holds_alternative<locator::resize_decision::merge>(way)) {
-                return d.avg_tablet_size > d.target_min_tablet_size() * 2;
+                return d.avg_tablet_size > d.target_min_tablet_size() * 2
+                        || (d.load_driven() && d.avg_tablet_ops_rate > d.target_min_tablet_ops_rate() * 2);
             }
             return false;
         }
@@ -468,7 +492,11 @@ class load_balancer {
             return [] (const table_id_and_size_desc& a, const table_id_and_size_desc& b) {
                 auto urgency = [] (const table_size_desc& d) -> double {
                     // FIXME: only takes into account split today.
-                    return double(d.avg_tablet_size) / d.target_max_tablet_size;
+                    auto size_urgency = double(d.avg_tablet_size) / d.target_max_tablet_size;
+                    if (!d.load_driven()) {
+                        return size_urgency;
+                    }
+                    return std::max(size_urgency, d.avg_tablet_ops_rate / d.target_max_tablet_ops_rate);
                 };
                 return urgency(a.second) < urgency(b.second);
             };
@@ -527,6 +555,7 @@ class load_balancer {
     size_t _total_capacity_shards; // Total number of non-drained shards in the balanced node set.
     size_t _total_capacity_nodes; // Total number of non-drained nodes in the balanced node set.
     locator::load_stats_ptr _table_load_stats;
+    absl::flat_hash_map<table_id, size_t> _tablet_weight; // Cache of tablet_weight().
     load_balancer_stats_manager& _stats;
     std::unordered_set<host_id> _skiplist;
     bool _use_table_aware_balancing = true;
@@ -596,6 +625,12 @@ class load_balancer {
         _use_table_aware_balancing = use_table_aware_balancing;
     }
 
+    // Average reads and writes per second of a tablet above which tables are
+    // split, see _target_tablet_ops_rate. Zero disables it.
+    void set_target_tablet_ops_rate(double target_tablet_ops_rate) {
+        _target_tablet_ops_rate = target_tablet_ops_rate;
+    }
+
     const locator::table_load_stats* load_stats_for_table(table_id id) const {
         if (!_table_load_stats) {
             return nullptr;
@@ -622,6 +657,7 @@ class load_balancer {
             }
 
             auto avg_tablet_size = table_stats->size_in_bytes / std::max(tmap.tablet_count(), size_t(1));
+            auto avg_tablet_ops_rate = table_stats->ops_per_second / std::max(tmap.tablet_count(), size_t(1));
             // shard presence of a table across the cluster
             size_t shard_count = std::accumulate(tmap.tablets().begin(), tmap.tablets().end(), size_t(0),
                 [] (size_t shard_count, const locator::tablet_info& info) {
@@ -633,11 +669,14 @@ class load_balancer {
                 .avg_tablet_size = avg_tablet_size,
                 .resize_decision = tmap.resize_decision(),
                 .tablet_count = tmap.tablet_count(),
-                .shard_count = shard_count
+                .shard_count = shard_count,
+                .target_max_tablet_ops_rate = target_max_tablet_ops_rate(_target_tablet_ops_rate),
+                .avg_tablet_ops_rate = avg_tablet_ops_rate,
             };
 
             resize_load.update(table, std::move(size_desc));
-            lblogger.info("Table {} with tablet_count={} has an average tablet size of {}", table, tmap.tablet_count(), avg_tablet_size);
+            lblogger.info("Table {} with tablet_count={} has an average tablet size of {} and an average tablet load of {:.1f} ops/s",
+                          table, tmap.tablet_count(), avg_tablet_size, avg_tablet_ops_rate);
             co_await coroutine::maybe_yield();
         }
 
@@ -672,8 +711,8 @@ class load_balancer {
             }
 
             auto resize_decision = cluster_resize_load::to_resize_decision(size_desc);
-            lblogger.info("Emitting resize decision of type {} for table {} due to avg tablet size of {}",
-                          resize_decision.type_name(), table, size_desc.avg_tablet_size);
+            lblogger.info("Emitting resize decision of type {} for table {} due to avg tablet size of {} and avg tablet load of {:.1f} ops/s",
+                          resize_decision.type_name(), table, size_desc.avg_tablet_size, size_desc.avg_tablet_ops_rate);
             resize_plan.resize[table] = std::move(resize_decision);
             _stats.for_cluster().resizes_emitted++;
 
@@ -690,7 +729,8 @@ class load_balancer {
             if (resize_load.table_needs_resize_cancellation(size_desc)) {
                 resize_plan.resize[table] = cluster_resize_load::revoke_resize_decision();
                 _stats.for_cluster().resizes_revoked++;
-                lblogger.info("Revoking resize decision for table {} due to avg tablet size of {}", table, size_desc.avg_tablet_size);
+                lblogger.info("Revoking resize decision for table {} due to avg tablet size of {} and avg tablet load of {:.1f} ops/s",
+                              table, size_desc.avg_tablet_size, size_desc.avg_tablet_ops_rate);
                 continue;
             }
 
@@ -765,17 +805,44 @@ class load_balancer {
         return rand_int() % shard_count;
     }
 
+    // Relative cost of migrating away a single tablet of a given table, used to prefer
+    // moving tablets which carry more data off overloaded shards.
+    // A tablet of average target size weighs tablet_weight_scale + 1, a tablet of
+    // an empty table, or of a table with no load stats, weighs 1.
+    static constexpr size_t tablet_weight_scale = 8;
+
+    size_t tablet_weight(table_id table) {
+        auto it = _tablet_weight.find(table);
+        if (it != _tablet_weight.end()) {
+            return it->second;
+        }
+        size_t weight = 1;
+        if (const auto* table_stats = load_stats_for_table(table)) {
+            auto tablet_count = _tm->tablets().get_tablet_map(table).tablet_count();
+            auto avg_tablet_size = table_stats->size_in_bytes / std::max(tablet_count, size_t(1));
+            auto unit = std::max<uint64_t>(_target_tablet_size / tablet_weight_scale, 1);
+            weight += std::min<uint64_t>(avg_tablet_size / unit, tablet_weight_scale * 4);
+        }
+        _tablet_weight.emplace(table, weight);
+        return weight;
+    }
+
+    // Picks a table randomly, with the probability proportional to the total weight
+    // of its candidate tablets.
     table_id pick_table(const std::unordered_map<table_id, std::unordered_set<global_tablet_id>>& candidates) {
         if (!_use_table_aware_balancing) {
             on_internal_error(lblogger, "pick_table() called when table-aware balancing is disabled");
         }
         size_t total = 0;
         for (auto&& [table, tablets] : candidates) {
-            total += tablets.size();
+            total += tablets.size() * tablet_weight(table);
+        }
+        if (!total) {
+            on_internal_error(lblogger, "No candidate table");
         }
         ssize_t candidate_index = rand_int() % total;
         for (auto&& [table, tablets] : candidates) {
-            candidate_index -= tablets.size();
+            candidate_index -= tablets.size() * tablet_weight(table);
             if (candidate_index <= 0 && !tablets.empty()) {
                 return table;
             }
@@ -1957,6 +2024,7 @@ class tablet_allocator_impl : public tablet_allocator::impl
     future<migration_plan> balance_tablets(token_metadata_ptr tm, locator::load_stats_ptr table_load_stats, std::unordered_set<host_id> skiplist) {
         load_balancer lb(tm, std::move(table_load_stats), _load_balancer_stats, _db.get_config().target_tablet_size_in_bytes(), std::move(skiplist));
         lb.set_use_table_aware_balancing(_use_tablet_aware_balancing);
+        lb.set_target_tablet_ops_rate(_db.get_config().target_tablet_ops_per_second());
         co_return co_await lb.make_plan();
     }
 
@@ -48,6 +48,13 @@ class column_translation {
         bool is_collection;
         bool is_counter;
         bool schema_mismatch;
+        // The type of the column in the current schema, null if the column
+        // is missing from it.
+        data_type schema_type;
+        // Cells of the column not newer than this were dropped with it.
+        // For a column missing from the current schema which was never
+        // dropped, api::missing_timestamp, so that all its cells are bad.
+        api::timestamp_type dropped_at = api::missing_timestamp;
     };
 
 private:
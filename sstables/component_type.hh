@@ -26,6 +26,9 @@ enum class component_type {
     TemporaryTOC,
     TemporaryStatistics,
     Scylla,
+    CompressionDictionary,
+    PromotedIndexSummary,
+    Postings,
     Unknown,
 };
 
@@ -63,6 +66,12 @@ struct fmt::formatter<sstables::component_type> : fmt::formatter<string_view> {
             return formatter<string_view>::format("TemporaryStatistics", ctx);
         case Scylla:
             return formatter<string_view>::format("Scylla", ctx);
+        case CompressionDictionary:
+            return formatter<string_view>::format("CompressionDictionary", ctx);
+        case PromotedIndexSummary:
+            return formatter<string_view>::format("PromotedIndexSummary", ctx);
+        case Postings:
+            return formatter<string_view>::format("Postings", ctx);
         case Unknown:
             return formatter<string_view>::format("Unknown", ctx);
         }
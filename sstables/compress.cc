@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <array>
 #include <stdexcept>
 #include <cstdlib>
 
@@ -15,6 +16,9 @@
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/fstream.hh>
 #include <seastar/core/on_internal_error.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/as_future.hh>
+#include <seastar/coroutine/exception.hh>
 
 #include "../compress.hh"
 #include "compress.hh"
@@ -274,7 +278,11 @@ local_compression::local_compression(const compression& c)
             return std::nullopt;
         });
     }())
-{}
+{
+    if (_compressor && !c.dictionary().empty()) {
+        _compressor = _compressor->with_dictionary(c.dictionary());
+    }
+}
 
 size_t local_compression::uncompress(const char* input,
                 size_t input_len, char* output, size_t output_len) const {
@@ -526,32 +534,43 @@ inline input_stream<char> make_compressed_file_input_stream(
 template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_sink_impl : public data_sink_impl {
+    static constexpr size_t max_training_bytes = 256 * 1024;
+
     output_stream<char> _out;
     sstables::compression* _compression_metadata;
     sstables::compression::segmented_offsets::writer _offsets;
     sstables::local_compression _compression;
     size_t _pos = 0;
     uint32_t _full_checksum;
-public:
-    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
-            : _out(std::move(out))
-            , _compression_metadata(cm)
-            , _offsets(_compression_metadata->offsets.get_writer())
-            , _compression(lc)
-            , _full_checksum(ChecksumType::init_checksum())
-    {}
-
-    virtual future<> put(net::packet data) override { abort(); }
-    virtual future<> put(temporary_buffer<char> buf) override {
+    // When the compressor wants a dictionary, the leading chunks are held
+    // back until enough of them were collected to train it, and only then
+    // compressed (with the dictionary) and written out.
+    bool _training;
+    std::vector<temporary_buffer<char>> _training_chunks;
+    size_t _training_bytes = 0;
+
+    // Chunks are compressed into these buffers, alternately, so that a chunk
+    // can be compressed (and the next one serialized by the writer) while the
+    // previous one is still being written to _out.
+    std::array<temporary_buffer<char>, 2> _compressed;
+    unsigned _next_compressed = 0;
+    // Write of the previous chunk to _out, at most one is in flight.
+    future<> _pending_write = make_ready_future<>();
+
+    future<> do_put(temporary_buffer<char> buf) {
         auto output_len = _compression.compress_max_size(buf.size());
 
-        // account space for checksum that goes after compressed data.
-        temporary_buffer<char> compressed(output_len + 4);
+        // The buffer was last used by the write before the pending one, which
+        // is complete. Account space for checksum that goes after compressed data.
+        auto& compressed = _compressed[std::exchange(_next_compressed, _next_compressed ^ 1)];
+        if (compressed.size() < output_len + 4) {
+            compressed = temporary_buffer<char>(output_len + 4);
+        }
 
         // compress flushed data.
         auto len = _compression.compress(buf.get(), buf.size(), compressed.get_write(), output_len);
         if (len > output_len) {
-            return make_exception_future(std::runtime_error("possible overflow during compression"));
+            co_await coroutine::return_exception(std::runtime_error("possible overflow during compression"));
         }
 
         // total length of the uncompressed data.
@@ -577,13 +596,75 @@ class compressed_file_data_sink_impl : public data_sink_impl {
 
         _compression_metadata->set_full_checksum(_full_checksum);
 
-        compressed.trim(len + 4);
+        co_await std::exchange(_pending_write, make_ready_future<>());
+        _pending_write = _out.write(compressed.get(), len + 4);
+    }
 
-        auto f = _out.write(compressed.get(), compressed.size());
-        return f.then([compressed = std::move(compressed)] {});
+    future<> train_and_flush() {
+        _training = false;
+        std::vector<bytes_view> samples;
+        samples.reserve(_training_chunks.size());
+        for (auto& c : _training_chunks) {
+            samples.emplace_back(reinterpret_cast<const int8_t*>(c.get()), c.size());
+        }
+        auto dict = _compression.compressor()->train_dictionary(samples);
+        if (!dict.empty()) {
+            _compression_metadata->set_dictionary(std::move(dict));
+            _compression = sstables::local_compression(_compression.compressor()->with_dictionary(_compression_metadata->dictionary()));
+        } else {
+            sstables::sstlog.debug("Could not train a compression dictionary from {} bytes of data, compressing without one", _training_bytes);
+        }
+        auto chunks = std::exchange(_training_chunks, {});
+        for (auto& c : chunks) {
+            co_await do_put(std::move(c));
+        }
+    }
+public:
+    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
+            : _out(std::move(out))
+            , _compression_metadata(cm)
+            , _offsets(_compression_metadata->offsets.get_writer())
+            , _compression(lc)
+            , _full_checksum(ChecksumType::init_checksum())
+            , _training(_compression && _compression.compressor()->dictionary_size() != 0)
+    {}
+
+    virtual future<> put(net::packet data) override { abort(); }
+    virtual future<> put(temporary_buffer<char> buf) override {
+        if (!_training) [[likely]] {
+            return do_put(std::move(buf));
+        }
+        _training_bytes += buf.size();
+        _training_chunks.push_back(std::move(buf));
+        // zstd suggests training on ~100 times the dictionary size, but we
+        // cap it to keep both the held back data and the training cost small.
+        if (_training_bytes >= std::min(_compression.compressor()->dictionary_size() * 100, max_training_bytes)) {
+            return train_and_flush();
+        }
+        return make_ready_future<>();
+    }
+    virtual future<> flush() override {
+        return std::exchange(_pending_write, make_ready_future<>());
     }
     virtual future<> close() override {
-        return _out.close();
+        std::exception_ptr ex;
+        if (_training) {
+            try {
+                co_await train_and_flush();
+            } catch (...) {
+                ex = std::current_exception();
+            }
+        }
+        // Don't leave the pending write behind, it refers to _out.
+        auto f = co_await coroutine::as_future(std::exchange(_pending_write, make_ready_future<>()));
+        if (ex) {
+            f.ignore_ready_future();
+            std::rethrow_exception(std::move(ex));
+        }
+        if (f.failed()) {
+            co_await coroutine::return_exception_ptr(f.get_exception());
+        }
+        co_await _out.close();
     }
 
     virtual size_t buffer_size() const noexcept override {
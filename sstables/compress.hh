@@ -299,6 +299,9 @@ struct compression {
     // Variables *not* found in the "Compression Info" file (added by update()):
     uint64_t _compressed_file_length = 0;
     uint32_t _full_checksum = 0;
+    // Trained dictionary the chunks were compressed with, if any.
+    // Stored in its own component (CompressionDictionary.db).
+    bytes _dictionary;
 public:
     // Set the compressor algorithm, please check the definition of enum compressor.
     void set_compressor(compressor_ptr c);
@@ -356,6 +359,14 @@ struct compression {
         _full_checksum = checksum;
     }
 
+    const bytes& dictionary() const noexcept {
+        return _dictionary;
+    }
+
+    void set_dictionary(bytes dictionary) {
+        _dictionary = std::move(dictionary);
+    }
+
     friend class sstable;
 };
 
@@ -272,6 +272,18 @@ class primitive_consumer_impl {
                 prestate::READING_SIGNED_VINT,
                 prestate::READING_SIGNED_VINT_WITH_LEN>(data, _i64);
     }
+    // Reads n consecutive unsigned vints into dest if they are all in the buffer.
+    // Otherwise returns false without consuming anything, and the caller should
+    // read them one by one.
+    inline bool try_read_unsigned_vints(Buffer& data, uint64_t* dest, size_t n) {
+        auto size = unsigned_vint::deserialize_n(
+                bytes_view(reinterpret_cast<bytes::value_type*>(data.get_write()), data.size()), dest, n);
+        if (!size) {
+            return false;
+        }
+        data.trim_front(*size);
+        return true;
+    }
     inline read_status read_unsigned_vint_length_bytes_contiguous(Buffer& data, temporary_buffer<char>& where) {
         if (data.empty()) {
             _prestate = prestate::READING_UNSIGNED_VINT_LENGTH_BYTES_CONTIGUOUS;
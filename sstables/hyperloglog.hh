@@ -44,6 +44,7 @@
  * @author Hideaki Ohno
  */
 
+#include <optional>
 #include <vector>
 #include <cmath>
 #include <sstream>
@@ -128,11 +129,49 @@ class HyperLogLog {
         alphaMM_ = alpha * m_ * m_;
     }
 
-    static HyperLogLog from_bytes(temporary_buffer<uint8_t> bytes) {
-        // FIXME: implement class that creates a HyperLogLog from an array of bytes.
-        // This will useful if we need to work with the cardinality data from the
-        // compaction metadata.
-        abort();
+    /**
+     * Creates a HyperLogLog from the output of get_bytes(), e.g. the cardinality
+     * of the compaction metadata.
+     *
+     * @param[in] bytes random access range of the serialized bytes
+     *
+     * @return std::nullopt if the bytes aren't in the format written by get_bytes()
+     *         (e.g. sparse or packed registers, as written by Cassandra).
+     */
+    template <typename Bytes>
+    static std::optional<HyperLogLog> from_bytes(const Bytes& bytes) {
+        size_t offset = 0;
+        auto read_unsigned_var_int = [&] () -> std::optional<uint32_t> {
+            uint32_t value = 0;
+            for (unsigned shift = 0; shift < 32 && offset < bytes.size(); shift += 7) {
+                uint8_t b = bytes[offset++];
+                value |= uint32_t(b & 0x7F) << shift;
+                if (!(b & 0x80)) {
+                    return value;
+                }
+            }
+            return std::nullopt;
+        };
+        if (bytes.size() < sizeof(int32_t)) {
+            return std::nullopt;
+        }
+        int32_t version = 0;
+        for (; offset < sizeof(int32_t); ++offset) {
+            version = (version << 8) | bytes[offset];
+        }
+        auto b = read_unsigned_var_int();
+        auto sp = read_unsigned_var_int();
+        auto type = read_unsigned_var_int();
+        auto size = read_unsigned_var_int();
+        if (version != -2 || !b || !sp || !type || !size || *b < 4 || *b > 16 || *type != 0
+                || *size != (1u << *b) || bytes.size() - offset != *size) {
+            return std::nullopt;
+        }
+        HyperLogLog hll(*b);
+        for (uint32_t i = 0; i < *size; ++i) {
+            hll.M_[i] = bytes[offset + i];
+        }
+        return hll;
     }
 
     /**
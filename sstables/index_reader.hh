@@ -335,7 +335,7 @@ class index_consume_entry_context : public data_consumer::continuous_data_consum
 inline file make_tracked_index_file(sstable& sst, reader_permit permit, tracing::trace_state_ptr trace_state,
                                     use_caching caching) {
     auto f = caching ? sst.index_file() : sst.uncached_index_file();
-    f = make_tracked_file(std::move(f), std::move(permit));
+    f = make_tracked_file(std::move(f), std::move(permit), tracked_file_kind::index);
     if (!trace_state) {
         return f;
     }
@@ -366,7 +366,8 @@ std::unique_ptr<clustered_index_cursor> promoted_index::make_cursor(shared_sstab
         return std::make_unique<mc::bsearch_clustered_cursor>(*sst->get_schema(),
             _promoted_index_start, _promoted_index_size,
             promoted_index_cache_metrics, permit,
-            *ck_values_fixed_lengths, cached_file_ptr, _num_blocks, trace_state);
+            *ck_values_fixed_lengths, cached_file_ptr, _num_blocks, trace_state,
+            sst->_components->promoted_index_summary ? sst->_components->promoted_index_summary->find(_promoted_index_start) : nullptr);
     }
 
     auto file = make_tracked_index_file(*sst, permit, std::move(trace_state), caching);
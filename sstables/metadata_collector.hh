@@ -119,9 +119,15 @@ class metadata_collector {
 public:
     static constexpr double NO_COMPRESSION_RATIO = -1.0;
 
+    // The precision of the cardinality estimator written to the statistics,
+    // 2^10 one byte registers, with a standard error of about 3%. Statistics
+    // are kept in memory for every sstable, so the precision is capped below
+    // the one Cassandra uses.
+    static constexpr int max_cardinality_precision = 10;
+
     static hll::HyperLogLog hyperloglog(int p, int sp) {
-        // FIXME: hll::HyperLogLog doesn't support sparse format, so ignoring parameters by the time being.
-        return hll::HyperLogLog();
+        // FIXME: hll::HyperLogLog doesn't support sparse format, so ignoring sp by the time being.
+        return hll::HyperLogLog(std::min(p, max_cardinality_precision));
     }
 private:
     const schema& _schema;
@@ -401,6 +401,19 @@ future<> cached_promoted_index::read_block(promoted_index_block& block, tracing:
     });
 }
 
+/// \brief Returns the start position of the promoted index block the sample was taken of.
+///
+/// Matches the position parsed from the promoted index by clustering_parser.
+inline position_in_partition promoted_index_sample_position(const promoted_index_sample& sample) {
+    auto key = clustering_key_prefix::from_bytes(sample.clustering.value);
+    auto kind = bound_kind_m(sample.kind);
+    if (kind == bound_kind_m::clustering) {
+        return position_in_partition::for_key(std::move(key));
+    }
+    auto bk = is_bound_kind(kind) ? to_bound_kind(kind) : boundary_to_start_bound(kind);
+    return position_in_partition(position_in_partition::range_tag_t{}, bk, std::move(key));
+}
+
 /// Cursor implementation which does binary search over index entries.
 ///
 /// Memory consumption: O(log(N))
@@ -412,6 +425,10 @@ future<> cached_promoted_index::read_block(promoted_index_block& block, tracing:
 ///
 /// N = number of index entries
 ///
+/// With the samples of the partition from the PromotedIndexSummary component,
+/// the search is narrowed down, without I/O, to the blocks between two
+/// adjacent samples, which are close in the index file.
+///
 class bsearch_clustered_cursor : public clustered_index_cursor {
     using pi_offset_type = cached_promoted_index::pi_offset_type;
     using pi_index_type = cached_promoted_index::pi_index_type;
@@ -431,8 +448,28 @@ class bsearch_clustered_cursor : public clustered_index_cursor {
     // Points to the upper bound of the cursor.
     std::optional<position_in_partition> _current_pos;
 
+    const partition_promoted_index_summary* _summary;
+
     tracing::trace_state_ptr _trace_state;
 private:
+    // Narrows [_current_idx, _upper_idx] down to the blocks between the samples
+    // around pos, keeping the invariants of advance_to_upper_bound().
+    void narrow_with_summary(position_in_partition_view pos) {
+        auto& samples = _summary->samples.elements;
+        position_in_partition::less_compare less(_s);
+        auto it = std::partition_point(samples.begin(), samples.end(), [&] (const promoted_index_sample& sample) {
+            return !less(pos, promoted_index_sample_position(sample));
+        });
+        if (it != samples.end() && it->block >= _current_idx && it->block < _upper_idx) {
+            _upper_idx = it->block;
+            _current_pos = promoted_index_sample_position(*it);
+        }
+        if (it != samples.begin()) {
+            _current_idx = std::max(_current_idx, std::prev(it)->block + 1);
+        }
+        sstlog.trace("mc_bsearch_clustered_cursor {}: narrowed by summary to [{}, {}]", fmt::ptr(this), _current_idx, _upper_idx);
+    }
+
     // Advances the cursor to the nearest block whose start position is > pos.
     //
     // upper_idx should be the index of the block which is known to have start position > pos.
@@ -459,6 +496,9 @@ class bsearch_clustered_cursor : public clustered_index_cursor {
         // Eventually _current_idx will reach _upper_idx.
 
         _upper_idx = _blocks_count;
+        if (_summary) {
+            narrow_with_summary(pos);
+        }
         return repeat([this, pos] {
             if (_current_idx >= _upper_idx) {
                 if (_current_idx == _blocks_count) {
@@ -496,7 +536,8 @@ class bsearch_clustered_cursor : public clustered_index_cursor {
             column_values_fixed_lengths cvfl,
             seastar::shared_ptr<cached_file> f,
             pi_index_type blocks_count,
-            tracing::trace_state_ptr trace_state)
+            tracing::trace_state_ptr trace_state,
+            const partition_promoted_index_summary* summary = nullptr)
         : _s(s)
         , _blocks_count(blocks_count)
         , _cached_file(std::move(f))
@@ -508,6 +549,7 @@ class bsearch_clustered_cursor : public clustered_index_cursor {
             std::move(cvfl),
             *_cached_file,
             blocks_count)
+        , _summary(summary)
         , _trace_state(std::move(trace_state))
     { }
 
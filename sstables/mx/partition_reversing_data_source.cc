@@ -350,7 +350,8 @@ static temporary_buffer<char> end_of_partition() {
 // range was the original.
 //
 // Because vast majority of the data consumed in our parsers is later reused
-// in the sstable reader, we cache the read buffer. The size of the buffer
+// in the sstable reader, we cache the read buffer. The last promoted index
+// block, scanned to find the last row, is read into the cache in one go. The size of the buffer
 // starts at 4KB and is doubled after each read up to 128KB. We set the
 // range of our reads so that the current row that will be returned to the
 // sstable reader is at the end of the buffer. After returning a row, we
@@ -526,7 +527,10 @@ class partition_reversing_data_source_impl final : public data_source_impl {
                     _row_start = _clustering_range_start;
                 }
                 uint64_t last_row_start = _row_start;
-                co_await emplace_row_skipping_context(data_stream(_row_start, _partition_end), _row_start, _partition_end);
+                // The rows found while scanning the block are the first ones to be returned,
+                // so read the block once into the cache and scan it from there.
+                _cached_read = co_await data_read(_row_start, _partition_end);
+                co_await emplace_row_skipping_context(make_buffer_input_stream(_cached_read.share()), _row_start, _partition_end);
                 co_await _row_skipping_context->consume_input();
                 while (!_row_skipping_context->end_of_partition()) {
                     last_row_start = _row_start;
@@ -535,6 +539,8 @@ class partition_reversing_data_source_impl final : public data_source_impl {
                 }
                 _row_end = _row_start;
                 _row_start = last_row_start;
+                // Keep the cache ending at _row_end, dropping the partition end flag.
+                _cached_read.trim(_cached_read.size() - (_partition_end - _row_end));
                 if (_row_start == _row_end) {
                     // empty partition
                     _state = state::FINISHED;
@@ -181,8 +181,12 @@ class mp_row_consumer_m {
         _mf_filter.reset();
     }
 
-    void check_schema_mismatch(const column_translation::column_info& column_info, const column_definition& column_def) const {
+    // The per-cell checks below use only what column_translation computed
+    // for the column when the sstable was first read with this schema version,
+    // the schema is looked at only to report an error.
+    void check_schema_mismatch(const column_translation::column_info& column_info) const {
         if (column_info.schema_mismatch) {
+            const column_definition& column_def = get_column_definition(column_info.id);
             throw malformed_sstable_exception(
                     format("{} definition in serialization header does not match schema. Expected {} but got {}",
                         column_def.name_as_text(),
@@ -193,12 +197,8 @@ class mp_row_consumer_m {
 
     void check_column_missing_in_current_schema(const column_translation::column_info& column_info,
                                                 api::timestamp_type timestamp) const {
-        if (!column_info.id) {
-            sstring name = sstring(to_sstring_view(*column_info.name));
-            auto it = _schema->dropped_columns().find(name);
-            if (it == _schema->dropped_columns().end() || timestamp > it->second.timestamp) {
-                throw malformed_sstable_exception(format("Column {} missing in current schema", name));
-            }
+        if (!column_info.id && timestamp > column_info.dropped_at) {
+            throw malformed_sstable_exception(format("Column {} missing in current schema", to_sstring_view(*column_info.name)));
         }
     }
 
@@ -402,13 +402,13 @@ class mp_row_consumer_m {
         if (!column_id) {
             return data_consumer::proceed::yes;
         }
-        const column_definition& column_def = get_column_definition(column_id);
-        if (timestamp <= column_def.dropped_at()) {
+        if (timestamp <= column_info.dropped_at) {
             return data_consumer::proceed::yes;
         }
-        check_schema_mismatch(column_info, column_def);
-        if (column_def.is_multi_cell()) {
-            auto& value_type = visit(*column_def.type, make_visitor(
+        check_schema_mismatch(column_info);
+        const abstract_type& column_type = *column_info.schema_type;
+        if (column_info.is_collection) {
+            auto& value_type = visit(column_type, make_visitor(
                 [] (const collection_type_impl& ctype) -> const abstract_type& { return *ctype.value_comparator(); },
                 [&] (const user_type_impl& utype) -> const abstract_type& {
                     if (cell_path.size() != sizeof(int16_t)) {
@@ -438,7 +438,7 @@ class mp_row_consumer_m {
             _cm.cells.emplace_back(to_bytes(cell_path), std::move(ac));
         } else {
             auto ac = is_deleted ? atomic_cell::make_dead(timestamp, local_deletion_time)
-                                 : make_atomic_cell(*column_def.type, timestamp, value, ttl, local_deletion_time,
+                                 : make_atomic_cell(column_type, timestamp, value, ttl, local_deletion_time,
                                        atomic_cell::collection_member::no);
             _cells.push_back({*column_id, atomic_cell_or_collection(std::move(ac))});
         }
@@ -460,10 +460,9 @@ class mp_row_consumer_m {
             check_column_missing_in_current_schema(column_info, _cm.tomb.timestamp);
         }
         if (column_id) {
-            const column_definition& column_def = get_column_definition(column_id);
-            if (!_cm.cells.empty() || (_cm.tomb && _cm.tomb.timestamp > column_def.dropped_at())) {
-                check_schema_mismatch(column_info, column_def);
-                _cells.push_back({column_def.id, _cm.serialize(*column_def.type)});
+            if (!_cm.cells.empty() || (_cm.tomb && _cm.tomb.timestamp > column_info.dropped_at)) {
+                check_schema_mismatch(column_info);
+                _cells.push_back({*column_id, _cm.serialize(*column_info.schema_type)});
             }
         }
         _cm.tomb = {};
@@ -480,11 +479,10 @@ class mp_row_consumer_m {
         if (!column_id) {
             return data_consumer::proceed::yes;
         }
-        const column_definition& column_def = get_column_definition(column_id);
-        if (timestamp <= column_def.dropped_at()) {
+        if (timestamp <= column_info.dropped_at) {
             return data_consumer::proceed::yes;
         }
-        check_schema_mismatch(column_info, column_def);
+        check_schema_mismatch(column_info);
         auto ac = make_counter_cell(timestamp, value);
         _cells.push_back({*column_id, atomic_cell_or_collection(std::move(ac))});
         return data_consumer::proceed::yes;
@@ -755,7 +753,11 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
     gc_clock::time_point _column_local_deletion_time;
     gc_clock::duration _column_ttl;
     fragmented_temporary_buffer _column_value;
+    // Length of the value of the current cell, if it was decoded along with its liveness.
+    std::optional<uint32_t> _column_value_length;
     temporary_buffer<char> _cell_path;
+    // Consecutive vints decoded in one go.
+    std::array<uint64_t, 4> _vints;
     uint64_t _ck_blocks_header;
     uint32_t _ck_blocks_header_offset;
     bool _null_component_occured;
@@ -808,6 +810,33 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
     std::optional<uint32_t> get_column_value_length() const {
         return _row->_columns.front().value_length;
     }
+    // The timestamp, local deletion time and TTL of a cell, whichever aren't
+    // inherited from the row, are consecutive vints, followed by the length of
+    // the value if it isn't fixed. If they're all in the buffer, which is the
+    // common case, decodes them in one go and returns true.
+    bool try_read_cell_header() {
+        const bool has_timestamp = !_column_flags.use_row_timestamp();
+        const bool has_expiry = !_column_flags.use_row_ttl() && (_column_flags.is_deleted() || _column_flags.is_expiring());
+        const bool has_ttl = !_column_flags.use_row_ttl() && _column_flags.is_expiring();
+        const bool has_length = is_column_simple() && _column_flags.has_value() && !get_column_value_length();
+        const size_t n = has_timestamp + has_expiry + has_ttl + has_length;
+        if (n < 2 || !this->try_read_unsigned_vints(*_processing_data, _vints.data(), n)) {
+            return false;
+        }
+        size_t i = 0;
+        _column_timestamp = has_timestamp ? parse_timestamp(_header, _vints[i++]) : _liveness.timestamp();
+        if (_column_flags.use_row_ttl()) {
+            _column_local_deletion_time = _liveness.local_deletion_time();
+            _column_ttl = _liveness.ttl();
+        } else {
+            _column_local_deletion_time = has_expiry ? parse_expiry(_header, _vints[i++]) : gc_clock::time_point::max();
+            _column_ttl = has_ttl ? parse_ttl(_header, _vints[i++]) : gc_clock::duration::zero();
+        }
+        if (has_length) {
+            _column_value_length = static_cast<uint32_t>(_vints[i++]);
+        }
+        return true;
+    }
     void setup_ck(const std::vector<std::optional<uint32_t>>& column_value_fix_lengths) {
         _row_key.clear();
         _row_key.reserve(column_value_fix_lengths.size());
@@ -988,7 +1017,11 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
                         _flags.has_timestamp(), _flags.has_ttl(), _flags.has_deletion()));
                 }
             } else {
-                if (_flags.has_timestamp()) {
+                if (_flags.has_timestamp() && _flags.has_ttl() && this->try_read_unsigned_vints(*_processing_data, _vints.data(), 3)) {
+                    _liveness.set_timestamp(parse_timestamp(_header, _vints[0]));
+                    _liveness.set_ttl(parse_ttl(_header, _vints[1]));
+                    _liveness.set_local_deletion_time(parse_expiry(_header, _vints[2]));
+                } else if (_flags.has_timestamp()) {
                     co_yield this->read_unsigned_vint(*_processing_data);
 
                     _liveness.set_timestamp(parse_timestamp(_header, this->_u64));
@@ -1085,6 +1118,9 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
             co_yield this->read_8(*_processing_data);
             _column_flags = column_flags_m(this->_u8);
 
+            if (try_read_cell_header()) {
+                goto cell_path_label;
+            }
             if (_column_flags.use_row_timestamp()) {
                 _column_timestamp = _liveness.timestamp();
             } else {
@@ -1107,6 +1143,7 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
                 co_yield this->read_unsigned_vint(*_processing_data);
                 _column_ttl = parse_ttl(_header, this->_u64);
             }
+        cell_path_label:
             if (!is_column_simple()) {
                 co_yield this->read_unsigned_vint_length_bytes_contiguous(*_processing_data, _cell_path);
             } else {
@@ -1118,6 +1155,8 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
                 read_status status = read_status::waiting;
                 if (auto len = get_column_value_length()) {
                     status = this->read_bytes(*_processing_data, *len, _column_value);
+                } else if (auto len = std::exchange(_column_value_length, std::nullopt)) {
+                    status = this->read_bytes(*_processing_data, *len, _column_value);
                 } else {
                     status = this->read_unsigned_vint_length_bytes(*_processing_data, _column_value);
                 }
@@ -19,6 +19,8 @@
 #include "utils/assert.hh"
 #include "utils/exceptions.hh"
 #include "db/large_data_handler.hh"
+#include "index/target_parser.hh"
+#include "cql3/statements/index_target.hh"
 
 #include <functional>
 #include <boost/iterator/iterator_facade.hpp>
@@ -585,6 +587,9 @@ class writer : public sstable_writer::writer_impl {
         uint64_t block_next_start_offset;
         std::optional<clustering_info> first_clustering;
         std::optional<clustering_info> last_clustering;
+        // Samples of the block starts, for the PromotedIndexSummary component.
+        std::vector<promoted_index_sample> samples;
+        uint32_t sample_stride = 1;
 
         // for this partition
         size_t desired_block_size;
@@ -594,6 +599,15 @@ class writer : public sstable_writer::writer_impl {
         size_t promoted_index_block_size;
         size_t promoted_index_auto_scale_threshold;
     } _pi_write_m;
+    // The partitions holding each value of an indexed column, for the
+    // Postings component. Given up on when the column has too many values.
+    struct column_postings_builder {
+        const column_definition* cdef;
+        std::unordered_map<bytes, std::vector<uint64_t>> values;
+        size_t entries = 0;
+        bool overflow = false;
+    };
+    std::unordered_map<column_id, column_postings_builder> _postings;
     run_id _run_identifier;
     bool _write_regular_as_static; // See #4139
     large_data_stats_entry _partition_size_entry;
@@ -632,6 +646,10 @@ class writer : public sstable_writer::writer_impl {
     void maybe_add_pi_block();
     void add_pi_block();
     void write_pi_block(const pi_block&);
+    void maybe_sample_pi_block(uint32_t index, const clustering_info& start);
+    void init_postings();
+    void maybe_add_posting(const column_definition& cdef, atomic_cell_view cell);
+    void seal_postings();
 
     uint64_t get_data_offset() const {
         if (_sst.has_component(component_type::CompressionInfo)) {
@@ -798,6 +816,13 @@ class writer : public sstable_writer::writer_impl {
         // exactly what callers used to do anyway.
         estimated_partitions = std::max(uint64_t(1), estimated_partitions);
 
+        if (cfg.promoted_index_summary) {
+            _sst._recognized_components.insert(component_type::PromotedIndexSummary);
+            _sst._components->promoted_index_summary.emplace();
+        }
+        if (cfg.postings) {
+            init_postings();
+        }
         _sst.open_sstable(cfg.origin);
         _sst.create_data().get();
         _compression_enabled = !_sst.has_component(component_type::CRC);
@@ -805,7 +830,8 @@ class writer : public sstable_writer::writer_impl {
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
-        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), utils::filter_format::m_format);
+        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _sst._schema->bloom_filter_fp_chance(), utils::filter_format::m_format,
+                _sst.filter_layout_for_write());
         _pi_write_m.promoted_index_block_size = cfg.promoted_index_block_size;
         _pi_write_m.promoted_index_auto_scale_threshold = cfg.promoted_index_auto_scale_threshold;
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
@@ -845,6 +871,111 @@ void writer::maybe_set_pi_first_clustering(const writer::clustering_info& info)
     }
 }
 
+// Partitions with fewer promoted index blocks are searched within a few pages
+// of the index file anyway.
+static constexpr uint64_t promoted_index_summary_min_blocks = 64;
+static constexpr size_t promoted_index_summary_max_samples = 256;
+
+void writer::maybe_sample_pi_block(uint32_t index, const clustering_info& start) {
+    auto& samples = _pi_write_m.samples;
+    if (!_sst.has_component(component_type::PromotedIndexSummary) || index % _pi_write_m.sample_stride) {
+        return;
+    }
+    samples.push_back(promoted_index_sample{index, uint8_t(start.kind), {to_bytes(start.clustering.representation())}});
+    if (samples.size() > promoted_index_summary_max_samples) {
+        // Keep every other sample, so they stay evenly spaced.
+        size_t n = 0;
+        for (size_t i = 0; i < samples.size(); i += 2) {
+            samples[n++] = std::move(samples[i]);
+        }
+        samples.resize(n);
+        _pi_write_m.sample_stride *= 2;
+    }
+}
+
+// Postings are meant for low-cardinality columns: they are loaded in memory
+// along the other metadata of the sstable.
+static constexpr size_t postings_max_values = 1024;
+static constexpr size_t postings_max_value_size = 256;
+static constexpr size_t postings_max_entries = 256 * 1024;
+
+void writer::init_postings() {
+    using cql3::statements::index_target;
+    for (auto& im : _schema.indices()) {
+        auto it = im.options().find(index_target::target_option_name);
+        if (it == im.options().end()) {
+            continue;
+        }
+        auto target = secondary_index::target_parser::get_target_column_name_from_string(it->second);
+        if (index_target::from_target_string(target) != index_target::target_type::regular_values) {
+            continue;
+        }
+        auto* cdef = _schema.get_column_definition(to_bytes(index_target::column_name_from_target_string(target)));
+        if (cdef && cdef->is_regular() && cdef->is_atomic() && !cdef->is_counter()) {
+            _postings.try_emplace(cdef->id, column_postings_builder{cdef});
+        }
+    }
+    if (!_postings.empty()) {
+        _sst._recognized_components.insert(component_type::Postings);
+        _sst._components->postings.emplace();
+    }
+}
+
+void writer::maybe_add_posting(const column_definition& cdef, atomic_cell_view cell) {
+    auto it = _postings.find(cdef.id);
+    if (it == _postings.end() || it->second.overflow || !cell.is_live()) {
+        return;
+    }
+    auto& p = it->second;
+    auto give_up = [&] {
+        p.overflow = true;
+        p.values = {};
+    };
+    auto value = cell.value();
+    if (value.size_bytes() > postings_max_value_size) {
+        return give_up();
+    }
+    auto [vit, inserted] = p.values.try_emplace(to_bytes(value));
+    if (inserted && p.values.size() > postings_max_values) {
+        return give_up();
+    }
+    auto& partitions = vit->second;
+    if (partitions.empty() || partitions.back() != _c_stats.start_offset) {
+        partitions.push_back(_c_stats.start_offset);
+        if (++p.entries > postings_max_entries) {
+            return give_up();
+        }
+    }
+}
+
+void writer::seal_postings() {
+    if (!_sst.has_component(component_type::Postings)) {
+        return;
+    }
+    auto& columns = _sst._components->postings->columns.elements;
+    for (auto& [id, p] : _postings) {
+        if (p.overflow) {
+            continue;
+        }
+        column_postings cp{{p.cdef->name()}};
+        std::vector<std::pair<bytes, std::vector<uint64_t>>> values(std::make_move_iterator(p.values.begin()), std::make_move_iterator(p.values.end()));
+        std::ranges::sort(values, [] (const auto& a, const auto& b) {
+            return compare_unsigned(a.first, b.first) < 0;
+        });
+        for (auto& [value, partitions] : values) {
+            value_postings vp{{std::move(value)}};
+            vp.partitions.elements.reserve(partitions.size());
+            std::ranges::copy(partitions, std::back_inserter(vp.partitions.elements));
+            cp.values.elements.push_back(std::move(vp));
+        }
+        columns.push_back(std::move(cp));
+    }
+    std::ranges::sort(columns, [] (const column_postings& a, const column_postings& b) {
+        return compare_unsigned(a.column_name.value, b.column_name.value) < 0;
+    });
+    _postings.clear();
+}
+
 void writer::add_pi_block() {
     auto block = pi_block{
         *_pi_write_m.first_clustering,
@@ -853,6 +984,8 @@ void writer::add_pi_block() {
         _data_writer->offset() - _pi_write_m.block_start_offset,
         (_current_tombstone ? std::make_optional(_current_tombstone) : std::optional<tombstone>{})};
 
+    maybe_sample_pi_block(_pi_write_m.promoted_index_size, block.first);
+
     if (_pi_write_m.blocks.empty()) {
         if (!_pi_write_m.first_entry) {
             _pi_write_m.first_entry.emplace(std::move(block));
@@ -945,6 +1078,8 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
     _pi_write_m.tomb = {};
     _pi_write_m.first_clustering.reset();
     _pi_write_m.last_clustering.reset();
+    _pi_write_m.samples.clear();
+    _pi_write_m.sample_stride = 1;
     _pi_write_m.desired_block_size = _pi_write_m.promoted_index_block_size;
     _pi_write_m.auto_scale_threshold = _pi_write_m.promoted_index_auto_scale_threshold;
 
@@ -977,7 +1112,7 @@ void writer::maybe_record_large_partitions(const sstables::sstable& sst, const s
     auto& row_count_entry = _rows_in_partition_entry;
     size_entry.max_value = std::max(size_entry.max_value, partition_size);
     row_count_entry.max_value = std::max(row_count_entry.max_value, rows);
-    auto ret = _sst.get_large_data_handler().maybe_record_large_partitions(sst, partition_key, partition_size, rows, range_rombstones, dead_rows).get();
+    auto ret = _sst.get_large_data_handler().maybe_record_large_partitions(sst, partition_key, partition_size, rows, range_rombstones, dead_rows);
     size_entry.above_threshold += unsigned(bool(ret.size));
     row_count_entry.above_threshold += unsigned(bool(ret.rows));
 }
@@ -988,7 +1123,7 @@ void writer::maybe_record_large_rows(const sstables::sstable& sst, const sstable
     if (entry.max_value < row_size) {
         entry.max_value = row_size;
     }
-    if (_sst.get_large_data_handler().maybe_record_large_rows(sst, partition_key, clustering_key, row_size).get()) {
+    if (_sst.get_large_data_handler().maybe_record_large_rows(sst, partition_key, clustering_key, row_size)) {
         entry.above_threshold++;
     };
 }
@@ -1003,7 +1138,7 @@ void writer::maybe_record_large_cells(const sstables::sstable& sst, const sstabl
     if (collection_elements_entry.max_value < collection_elements) {
         collection_elements_entry.max_value = collection_elements;
     }
-    if (_sst.get_large_data_handler().maybe_record_large_cells(_sst, *_partition_key, clustering_key, cdef, cell_size, collection_elements).get()) {
+    if (_sst.get_large_data_handler().maybe_record_large_cells(_sst, *_partition_key, clustering_key, cdef, cell_size, collection_elements)) {
         if (cell_size > cell_size_entry.threshold) {
             cell_size_entry.above_threshold++;
         }
@@ -1175,6 +1310,9 @@ void writer::write_cells(bytes_ostream& writer, const clustering_key_prefix* clu
         atomic_cell_view cell = c.as_atomic_cell(column_definition);
         ++_c_stats.cells_count;
         ++_c_stats.column_count;
+        if (kind == column_kind::regular_column && !_postings.empty()) {
+            maybe_add_posting(column_definition, cell);
+        }
         write_cell(writer, clustering_key, cell, column_definition, properties);
     });
 
@@ -1365,6 +1503,13 @@ void writer::write_promoted_index() {
     uint64_t pi_size = _tmp_bufs.size() + _pi_write_m.blocks.size() + _pi_write_m.offsets.size();
     write_vint(*_index_writer, pi_size);
     flush_tmp_bufs(*_index_writer);
+    if (_sst.has_component(component_type::PromotedIndexSummary) && _pi_write_m.promoted_index_size >= promoted_index_summary_min_blocks) {
+        partition_promoted_index_summary entry{_index_writer->offset()};
+        for (auto& sample : _pi_write_m.samples) {
+            entry.samples.elements.push_back(std::move(sample));
+        }
+        _sst._components->promoted_index_summary->partitions.elements.push_back(std::move(entry));
+    }
     write(_sst.get_version(), *_index_writer, _pi_write_m.blocks);
     write(_sst.get_version(), *_index_writer, _pi_write_m.offsets);
 }
@@ -1483,6 +1628,9 @@ void writer::consume_end_of_stream() {
     _sst.write_filter();
     _sst.write_statistics();
     _sst.write_compression();
+    _sst.write_promoted_index_summary();
+    seal_postings();
+    _sst.write_postings();
     auto features = sstable_enabled_features::all();
     run_identifier identifier{_run_identifier};
     std::optional<scylla_metadata::large_data_stats> ld_stats(scylla_metadata::large_data_stats{
@@ -0,0 +1,476 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <charconv>
+
+#include <fmt/format.h>
+
+#include <seastar/core/align.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/util/closeable.hh>
+
+#include "sstables/object_block_cache.hh"
+#include "utils/lister.hh"
+#include "utils/log.hh"
+#include "utils/xx_hasher.hh"
+
+namespace sstables {
+
+static logging::logger oblog("object_block_cache");
+
+// Block files are named "<object key>-<block index>-<p|u>", p for pinned.
+static sstring block_file_name(object_block_cache::object_key object, uint64_t index, object_block_cache::pinned p) {
+    return fmt::format("{:016x}-{}-{}", object, index, p ? 'p' : 'u');
+}
+
+struct parsed_block_file_name {
+    object_block_cache::object_key object;
+    uint64_t index;
+    object_block_cache::pinned is_pinned;
+};
+
+static std::optional<parsed_block_file_name> parse_block_file_name(std::string_view name) {
+    parsed_block_file_name ret;
+    auto end = name.data() + name.size();
+    auto [p, ec] = std::from_chars(name.data(), end, ret.object, 16);
+    if (ec != std::errc() || p == end || *p++ != '-') {
+        return std::nullopt;
+    }
+    std::tie(p, ec) = std::from_chars(p, end, ret.index);
+    if (ec != std::errc() || end - p != 2 || *p++ != '-' || (*p != 'p' && *p != 'u')) {
+        return std::nullopt;
+    }
+    ret.is_pinned = object_block_cache::pinned(*p == 'p');
+    return ret;
+}
+
+object_block_cache::object_block_cache(config cfg)
+    : _cfg(std::move(cfg))
+    // Reads miss and nothing is cached until the blocks left by the previous
+    // run are loaded.
+    , _load(with_gate(_gate, [this] {
+        return load().handle_exception([this] (std::exception_ptr ep) {
+            oblog.warn("Failed to load the object block cache from {}, caching is disabled: {}", _cfg.directory, ep);
+        });
+    }))
+{
+    namespace sm = seastar::metrics;
+    _metrics.add_group("object_block_cache", {
+        sm::make_counter("hits", [this] { return _stats.hits; },
+            sm::description("Block reads served from the local cache")),
+        sm::make_counter("misses", [this] { return _stats.misses; },
+            sm::description("Block reads which had to go to object storage")),
+        sm::make_counter("insertions", [this] { return _stats.insertions; },
+            sm::description("Blocks written to the local cache")),
+        sm::make_counter("evictions", [this] { return _stats.evictions; },
+            sm::description("Blocks evicted from the local cache")),
+        sm::make_counter("errors", [this] { return _stats.errors; },
+            sm::description("Failed reads and writes of local cache files")),
+        sm::make_counter("skipped_insertions", [this] { return _stats.skipped_insertions; },
+            sm::description("Blocks which were not cached, because of concurrent writes or pinned blocks filling the cache")),
+        sm::make_gauge("bytes", [this] { return _stats.bytes; },
+            sm::description("Size of the cached blocks")),
+        sm::make_gauge("pinned_bytes", [this] { return _stats.pinned_bytes; },
+            sm::description("Size of the cached blocks which are pinned")),
+    });
+}
+
+future<> object_block_cache::stop() {
+    _loaded = false;
+    co_await _gate.close();
+}
+
+object_block_cache::object_key object_block_cache::make_object_key(std::string_view endpoint, std::string_view object_name) {
+    xx_hasher h;
+    h.update(endpoint.data(), endpoint.size());
+    h.update("", 1);
+    h.update(object_name.data(), object_name.size());
+    return h.finalize_uint64();
+}
+
+object_block_cache::block* object_block_cache::find(object_key object, uint64_t index) {
+    auto it = _objects.find(object);
+    if (it == _objects.end()) {
+        return nullptr;
+    }
+    auto bit = it->second.find(index);
+    return bit == it->second.end() ? nullptr : &bit->second;
+}
+
+void object_block_cache::erase(object_key object, uint64_t index) {
+    auto it = _objects.find(object);
+    if (it == _objects.end()) {
+        return;
+    }
+    auto bit = it->second.find(index);
+    if (bit == it->second.end()) {
+        return;
+    }
+    _stats.bytes -= bit->second.size;
+    if (bit->second.is_pinned) {
+        _stats.pinned_bytes -= bit->second.size;
+    }
+    it->second.erase(bit);
+    if (it->second.empty()) {
+        _objects.erase(it);
+    }
+}
+
+void object_block_cache::remove_block_file(sstring name) {
+    (void)try_with_gate(_gate, [this, name = std::move(name)] {
+        return remove_file((_cfg.directory / name.c_str()).native()).handle_exception([name] (std::exception_ptr ep) {
+            oblog.debug("Failed to remove block file {}: {}", name, ep);
+        });
+    });
+}
+
+void object_block_cache::evict(block& b) {
+    // The key of the block is in its name.
+    auto parsed = parse_block_file_name(b.name);
+    remove_block_file(b.name);
+    ++_stats.evictions;
+    erase(parsed->object, parsed->index);
+}
+
+bool object_block_cache::make_room(size_t size) {
+    while (_stats.bytes + size > _cfg.capacity) {
+        if (_lru.empty()) {
+            return false;
+        }
+        evict(_lru.front());
+    }
+    return true;
+}
+
+bool object_block_cache::contains(object_key object, uint64_t index) {
+    auto* b = find(object, index);
+    return b && b->ready;
+}
+
+future<std::optional<temporary_buffer<uint8_t>>> object_block_cache::read_block(object_key object, uint64_t index) {
+    auto* b = find(object, index);
+    if (!_loaded || !b || !b->ready) {
+        ++_stats.misses;
+        co_return std::nullopt;
+    }
+    if (!b->is_pinned) {
+        b->lru_link.unlink();
+        _lru.push_back(*b);
+    }
+    auto name = b->name;
+    auto size = b->size;
+    std::exception_ptr ex;
+    try {
+        auto holder = _gate.hold();
+        auto f = co_await open_file_dma((_cfg.directory / name.c_str()).native(), open_flags::ro);
+        auto buf = co_await with_closeable(std::move(f), [size] (file& f) {
+            return f.dma_read_bulk<uint8_t>(0, size);
+        });
+        if (buf.size() == size) {
+            ++_stats.hits;
+            co_return std::move(buf);
+        }
+        ex = std::make_exception_ptr(std::runtime_error(fmt::format("read {} bytes out of {}", buf.size(), size)));
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    // The block might have been evicted, and its file removed, while it was
+    // being read.
+    b = find(object, index);
+    if (b && b->name == name) {
+        oblog.debug("Failed to read block file {}, dropping it: {}", name, ex);
+        ++_stats.errors;
+        remove_block_file(name);
+        erase(object, index);
+    }
+    ++_stats.misses;
+    co_return std::nullopt;
+}
+
+void object_block_cache::insert_block(object_key object, uint64_t index, pinned p, temporary_buffer<uint8_t> data) {
+    if (!_loaded || data.empty() || find(object, index)) {
+        return;
+    }
+    auto units = try_get_units(_write_sem, 1);
+    if (!units || !make_room(data.size())) {
+        ++_stats.skipped_insertions;
+        return;
+    }
+    auto name = block_file_name(object, index, p);
+    _objects[object].emplace(index, block{.name = name, .size = data.size(), .is_pinned = p});
+    _stats.bytes += data.size();
+    if (p) {
+        _stats.pinned_bytes += data.size();
+    }
+    (void)with_gate(_gate, [this, object, index, name = std::move(name), data = std::move(data), units = std::move(*units)] () mutable {
+        return write_block(object, index, std::move(name), std::move(data));
+    });
+}
+
+future<> object_block_cache::write_block(object_key object, uint64_t index, sstring name, temporary_buffer<uint8_t> data) {
+    auto path = (_cfg.directory / name.c_str()).native();
+    auto tmp_path = path + ".tmp";
+    std::exception_ptr ex;
+    try {
+        auto f = co_await open_file_dma(tmp_path, open_flags::wo | open_flags::create | open_flags::truncate);
+        co_await with_closeable(std::move(f), [&data] (file& f) -> future<> {
+            auto len = align_up<size_t>(data.size(), f.disk_write_dma_alignment());
+            auto buf = temporary_buffer<uint8_t>::aligned(f.memory_dma_alignment(), len);
+            std::copy_n(data.get(), data.size(), buf.get_write());
+            std::fill(buf.get_write() + data.size(), buf.get_write() + len, 0);
+            co_await f.dma_write(0, buf.get(), len);
+            co_await f.truncate(data.size());
+            // The file has to be complete before it is renamed, a block
+            // file found on start is trusted.
+            co_await f.flush();
+        });
+        co_await rename_file(tmp_path, path);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    auto* b = find(object, index);
+    if (ex) {
+        oblog.debug("Failed to write block file {}: {}", name, ex);
+        ++_stats.errors;
+        if (b && !b->ready) {
+            erase(object, index);
+        }
+        co_await remove_file(tmp_path).handle_exception([] (std::exception_ptr) {});
+        co_return;
+    }
+    if (!b || b->ready) {
+        // The object was invalidated while the block was written.
+        remove_block_file(std::move(name));
+        co_return;
+    }
+    b->ready = true;
+    if (!b->is_pinned) {
+        _lru.push_back(*b);
+    }
+    ++_stats.insertions;
+}
+
+void object_block_cache::invalidate(object_key object) {
+    auto it = _objects.find(object);
+    if (it == _objects.end()) {
+        return;
+    }
+    for (auto& [index, b] : it->second) {
+        _stats.bytes -= b.size;
+        if (b.is_pinned) {
+            _stats.pinned_bytes -= b.size;
+        }
+        // The file of a block being written is removed by the write.
+        if (b.ready) {
+            remove_block_file(b.name);
+        }
+    }
+    _objects.erase(it);
+}
+
+future<> object_block_cache::load() {
+    co_await recursive_touch_directory(_cfg.directory.native());
+
+    struct found_block {
+        parsed_block_file_name key;
+        sstring name;
+        size_t size;
+        std::chrono::system_clock::time_point modified;
+    };
+    std::vector<found_block> found;
+    directory_lister lister(_cfg.directory, lister::dir_entry_types::of<directory_entry_type::regular>());
+    co_await with_closeable(std::move(lister), [this, &found] (directory_lister& lister) -> future<> {
+        while (auto de = co_await lister.get()) {
+            auto path = (_cfg.directory / de->name.c_str()).native();
+            auto parsed = parse_block_file_name(de->name);
+            if (!parsed) {
+                // Left by a write interrupted by the restart.
+                oblog.debug("Removing unrecognized file {}", path);
+                co_await remove_file(path);
+                continue;
+            }
+            auto st = co_await file_stat(path, follow_symlink::no);
+            found.push_back(found_block{*parsed, de->name, st.size, st.time_modified});
+        }
+    });
+
+    // The blocks written last are the last to be evicted. Pinned blocks are
+    // loaded first, but only up to the capacity, which might have shrunk
+    // since the blocks were written.
+    std::ranges::sort(found, [] (const found_block& a, const found_block& b) {
+        return std::make_tuple(bool(b.key.is_pinned), b.modified) < std::make_tuple(bool(a.key.is_pinned), a.modified);
+    });
+    size_t loaded = 0;
+    for (auto& fb : found) {
+        if (_stats.bytes + fb.size > _cfg.capacity) {
+            co_await remove_file((_cfg.directory / fb.name.c_str()).native());
+            continue;
+        }
+        auto [bit, _] = _objects[fb.key.object].emplace(fb.key.index,
+                block{.name = fb.name, .size = fb.size, .is_pinned = fb.key.is_pinned, .ready = true});
+        _stats.bytes += fb.size;
+        if (fb.key.is_pinned) {
+            _stats.pinned_bytes += fb.size;
+        } else {
+            _lru.push_front(bit->second);
+        }
+        ++loaded;
+    }
+    oblog.info("Loaded {} blocks ({} bytes, {} pinned) from {}", loaded, _stats.bytes, _stats.pinned_bytes, _cfg.directory);
+    _loaded = !_gate.is_closed();
+}
+
+class caching_object_file_impl : public file_impl {
+    object_block_cache& _cache;
+    object_block_cache::object_key _object;
+    object_block_cache::pinned _pinned;
+    file _file;
+    std::optional<uint64_t> _size;
+
+    future<uint64_t> object_size() {
+        if (!_size) {
+            _size = co_await _file.size();
+        }
+        co_return *_size;
+    }
+
+    // Reads [pos, pos + len) of the object, block by block, fetching the runs
+    // of missing blocks with single reads of the underlying file.
+    future<temporary_buffer<uint8_t>> read(uint64_t pos, size_t len, io_intent* intent) {
+        auto size = co_await object_size();
+        if (pos >= size) {
+            co_return temporary_buffer<uint8_t>();
+        }
+        len = std::min<uint64_t>(len, size - pos);
+        const auto bs = _cache.block_size();
+        temporary_buffer<uint8_t> ret(len);
+        auto copy = [&] (uint64_t block_pos, const temporary_buffer<uint8_t>& data) {
+            auto start = std::max(pos, block_pos);
+            auto end = std::min(pos + len, block_pos + data.size());
+            if (start < end) {
+                std::copy_n(data.get() + (start - block_pos), end - start, ret.get_write() + (start - pos));
+            }
+        };
+        auto last = (pos + len - 1) / bs;
+        for (auto index = pos / bs; index <= last;) {
+            if (auto data = co_await _cache.read_block(_object, index)) {
+                copy(index * bs, *data);
+                ++index;
+                continue;
+            }
+            auto run_end = index + 1;
+            while (run_end <= last && !_cache.contains(_object, run_end)) {
+                ++run_end;
+            }
+            auto start = index * bs;
+            auto end = std::min(run_end * bs, size);
+            auto data = co_await get_file_impl(_file)->dma_read_bulk(start, end - start, intent);
+            if (data.size() != end - start) {
+                throw std::runtime_error(fmt::format("short read of object: {} bytes at {} out of {}", data.size(), start, end - start));
+            }
+            for (; index < run_end; ++index) {
+                auto off = index * bs - start;
+                auto block = data.share(off, std::min<uint64_t>(bs, data.size() - off));
+                copy(index * bs, block);
+                _cache.insert_block(_object, index, _pinned, std::move(block));
+            }
+        }
+        co_return ret;
+    }
+
+public:
+    caching_object_file_impl(object_block_cache& cache, object_block_cache::object_key object, object_block_cache::pinned p, file f)
+        : _cache(cache)
+        , _object(object)
+        , _pinned(p)
+        , _file(std::move(f))
+    {}
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, io_intent* intent) override {
+        return get_file_impl(_file)->write_dma(pos, buffer, len, intent);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, io_intent* intent) override {
+        return get_file_impl(_file)->write_dma(pos, std::move(iov), intent);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent* intent) override {
+        auto buf = co_await read(pos, len, intent);
+        std::copy_n(buf.get(), buf.size(), reinterpret_cast<uint8_t*>(buffer));
+        co_return buf.size();
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent* intent) override {
+        size_t len = 0;
+        for (auto& v : iov) {
+            len += v.iov_len;
+        }
+        auto buf = co_await read(pos, len, intent);
+        size_t off = 0;
+        for (auto& v : iov) {
+            auto sz = std::min(v.iov_len, buf.size() - off);
+            if (sz == 0) {
+                break;
+            }
+            std::copy_n(buf.get() + off, sz, reinterpret_cast<uint8_t*>(v.iov_base));
+            off += sz;
+        }
+        co_return off;
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, io_intent* intent) override {
+        return read(offset, range_size, intent);
+    }
+
+    virtual future<> flush(void) override {
+        return get_file_impl(_file)->flush();
+    }
+
+    virtual future<struct stat> stat(void) override {
+        return get_file_impl(_file)->stat();
+    }
+
+    virtual future<> truncate(uint64_t length) override {
+        return get_file_impl(_file)->truncate(length);
+    }
+
+    virtual future<> discard(uint64_t offset, uint64_t length) override {
+        return get_file_impl(_file)->discard(offset, length);
+    }
+
+    virtual future<> allocate(uint64_t position, uint64_t length) override {
+        return get_file_impl(_file)->allocate(position, length);
+    }
+
+    virtual future<uint64_t> size(void) override {
+        return object_size();
+    }
+
+    virtual future<> close() override {
+        return get_file_impl(_file)->close();
+    }
+
+    // Returns a handle of the underlying file, reads of the duplicate bypass
+    // the cache.
+    virtual std::unique_ptr<seastar::file_handle_impl> dup() override {
+        return get_file_impl(_file)->dup();
+    }
+
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override {
+        return get_file_impl(_file)->list_directory(std::move(next));
+    }
+};
+
+file object_block_cache::make_caching_file(object_key object, pinned p, file f) {
+    return file(make_shared<caching_object_file_impl>(*this, object, p, std::move(f)));
+}
+
+} // namespace sstables
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include <boost/intrusive/list.hpp>
+
+#include <seastar/core/file.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
+#include <seastar/util/bool_class.hh>
+
+#include "seastarx.hh"
+
+namespace sstables {
+
+/// A cache of blocks of object storage objects, kept on local disk.
+///
+/// Reads of sstables on object storage which miss the in-memory caches turn
+/// into range GETs, which cost tens of milliseconds each. This cache keeps the
+/// blocks read from the objects in files of a local directory (meant to be on
+/// a fast local disk), so that the next reads of them are served locally, also
+/// after a restart: the blocks found in the directory on start are loaded back.
+///
+/// sstable objects are immutable, so a cached block never goes stale. The
+/// blocks of an object are dropped when it is deleted (\ref invalidate()), or
+/// evicted, in LRU order, when the cache grows above its capacity. The blocks
+/// of pinned objects (the Index and Summary components, by default) are never
+/// evicted, they take their part of the capacity for as long as the sstable
+/// lives. When pinned blocks fill the whole capacity, no more blocks are cached.
+///
+/// Each block is a file in the cache directory, named after the hash of the
+/// object's name, the index of the block and whether it is pinned. Blocks are
+/// written in the background, and a block the write of which didn't finish
+/// yet is a miss.
+class object_block_cache {
+public:
+    struct config {
+        std::filesystem::path directory;
+        uint64_t capacity = 0;
+        size_t block_size = 128 * 1024;
+    };
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t insertions = 0;
+        uint64_t evictions = 0;
+        // Failed reads and writes of the local files, which fall back to the
+        // object storage.
+        uint64_t errors = 0;
+        // Blocks not cached because the writes of other blocks were in
+        // progress, or because pinned blocks filled the capacity.
+        uint64_t skipped_insertions = 0;
+        uint64_t bytes = 0;
+        uint64_t pinned_bytes = 0;
+    };
+
+    using pinned = bool_class<class pinned_tag>;
+    using object_key = uint64_t;
+
+private:
+    using lru_link_type = boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+
+    struct block {
+        sstring name;
+        size_t size;
+        pinned is_pinned;
+        // Set once the file of the block is written.
+        bool ready = false;
+        lru_link_type lru_link;
+    };
+
+    using lru_type = boost::intrusive::list<block,
+        boost::intrusive::member_hook<block, lru_link_type, &block::lru_link>,
+        boost::intrusive::constant_time_size<false>>;
+
+    config _cfg;
+    std::unordered_map<object_key, std::map<uint64_t, block>> _objects;
+    // Ready, unpinned blocks, least recently used first.
+    lru_type _lru;
+    stats _stats;
+    bool _loaded = false;
+    gate _gate;
+    shared_future<> _load;
+    // Limits the concurrency of background writes of blocks.
+    semaphore _write_sem{16};
+    seastar::metrics::metric_groups _metrics;
+
+    block* find(object_key object, uint64_t index);
+    void erase(object_key object, uint64_t index);
+    void evict(block& b);
+    bool make_room(size_t size);
+    void remove_block_file(sstring name);
+    future<> write_block(object_key object, uint64_t index, sstring name, temporary_buffer<uint8_t> data);
+    future<> load();
+
+public:
+    explicit object_block_cache(config cfg);
+    object_block_cache(const object_block_cache&) = delete;
+    object_block_cache& operator=(const object_block_cache&) = delete;
+
+    /// Waits for the background writes and stops caching.
+    future<> stop();
+
+    /// Resolves once the blocks left by the previous run are loaded.
+    future<> wait_for_load() {
+        return _load.get_future();
+    }
+
+    static object_key make_object_key(std::string_view endpoint, std::string_view object_name);
+
+    size_t block_size() const noexcept {
+        return _cfg.block_size;
+    }
+
+    /// Whether the block is cached (a block being written is not).
+    bool contains(object_key object, uint64_t index);
+
+    /// Returns the contents of the block if it is cached.
+    future<std::optional<temporary_buffer<uint8_t>>> read_block(object_key object, uint64_t index);
+
+    /// Caches the block of an object, writing it in the background.
+    /// The block can be shorter than block_size() only if it is the last one.
+    void insert_block(object_key object, uint64_t index, pinned p, temporary_buffer<uint8_t> data);
+
+    /// Drops the cached blocks of the object.
+    void invalidate(object_key object);
+
+    /// Wraps a readable file of an object of object storage, so that its reads
+    /// go through the cache.
+    file make_caching_file(object_key object, pinned p, file f);
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
+
+} // namespace sstables
@@ -61,6 +61,8 @@ struct foreign_sstable_open_info {
     sstable_format_types format;
     uint64_t uncompressed_data_size;
     uint64_t metadata_size_on_disk;
+    // The bloom filter wasn't loaded yet, see sstable_open_config::defer_bloom_filter_loading.
+    bool bloom_filter_deferred = false;
 };
 
 struct sstable_open_config {
@@ -76,6 +78,12 @@ struct sstable_open_config {
     // filter, meaning that the SSTable will be opened on every single-partition
     // read.
     bool load_bloom_filter = true;
+    // Open the SSTable without reading its bloom filter, which is loaded later
+    // in the background, by the components reloader of the sstables manager,
+    // when memory allows. Until then the SSTable uses an always-present filter.
+    // Speeds up startup with many SSTables, at the cost of single-partition
+    // reads touching every SSTable until the filters are loaded.
+    bool defer_bloom_filter_loading = false;
     // Mimics behavior when a SSTable is streamed to a given shard, where SSTable
     // writer considers the shard that created the SSTable as its owner.
     bool current_shard_as_sstable_owner = false;
@@ -64,6 +64,10 @@ class partition_index_cache {
 
         void on_evicted() noexcept override;
 
+        void on_second_chance() noexcept override {
+            ++_parent->_stats.second_chances;
+        }
+
         // Returns the amount of memory owned by this entry.
         // Always returns the same value for a given state of _page.
         size_t size_in_allocator() const { return _size_in_allocator; }
@@ -191,6 +195,7 @@ class partition_index_cache {
             auto ptr = share(cp);
             if (cp.ready()) {
                 ++_stats.hits;
+                cp.mark_referenced();
                 return make_ready_future<entry_ptr>(std::move(ptr));
             } else {
                 ++_stats.blocks;
@@ -239,6 +244,13 @@ class partition_index_cache {
         });
     }
 
+    // Returns true iff the page for given key is loaded, i.e. get_or_load()
+    // would resolve without I/O.
+    bool is_cached(const key_type& key) const noexcept {
+        auto i = _cache.find(key);
+        return i != _cache.end() && i->ready();
+    }
+
     void on_evicted(entry& p) {
         _stats.used_bytes -= p.size_in_allocator();
         ++_stats.evictions;
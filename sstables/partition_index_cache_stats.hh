@@ -16,5 +16,6 @@ struct partition_index_cache_stats {
     uint64_t blocks = 0; // Number of times entry was not ready (>= misses)
     uint64_t evictions = 0; // Number of times entry was evicted
     uint64_t populations = 0; // Number of times entry was inserted
+    uint64_t second_chances = 0; // Number of times a hit entry was spared from eviction
     uint64_t used_bytes = 0; // Number of bytes entries occupy in memory
 };
@@ -24,6 +24,8 @@ struct shareable_components {
     sstables::summary summary;
     sstables::statistics statistics;
     std::optional<sstables::scylla_metadata> scylla_metadata;
+    std::optional<sstables::promoted_index_summary> promoted_index_summary;
+    std::optional<sstables::postings> postings;
     weak_ptr<sstables::checksum> checksum;
     std::optional<uint32_t> digest;
 };
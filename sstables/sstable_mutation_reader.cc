@@ -125,7 +125,9 @@ std::vector<column_translation::column_info> column_translation::state::build(
             col.type->value_length_if_fixed(),
             col.is_multi_cell(),
             col.is_counter(),
-            false
+            false,
+            col.type,
+            col.dropped_at(),
         });
     } else {
         cols.reserve(src.size());
@@ -139,11 +141,17 @@ std::vector<column_translation::column_info> column_translation::state::build(
             const column_definition* def = s.get_column_definition(desc.name.value);
             std::optional<column_id> id;
             bool schema_mismatch = false;
+            data_type schema_type;
+            api::timestamp_type dropped_at = api::missing_timestamp;
             if (def) {
                 id = def->id;
                 schema_mismatch = def->is_multi_cell() != type->is_multi_cell() ||
                                   def->is_counter() != type->is_counter() ||
                                   !def->type->is_value_compatible_with(*type);
+                schema_type = def->type;
+                dropped_at = def->dropped_at();
+            } else if (auto it = s.dropped_columns().find(sstring(to_sstring_view(desc.name.value))); it != s.dropped_columns().end()) {
+                dropped_at = it->second.timestamp;
             }
             cols.push_back(column_info{
                 &desc.name.value,
@@ -152,7 +160,9 @@ std::vector<column_translation::column_info> column_translation::state::build(
                 type->value_length_if_fixed(),
                 type->is_multi_cell(),
                 type->is_counter(),
-                schema_mismatch
+                schema_mismatch,
+                std::move(schema_type),
+                dropped_at,
             });
         }
         boost::range::stable_partition(cols, [](const column_info& column) { return !column.is_collection; });
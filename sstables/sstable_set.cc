@@ -646,7 +646,8 @@ class sstable_position_reader_queue : public position_reader_queue {
     // Assumes that `create_reader` returns readers that emit only fragments from partition `pk`.
     //
     // For reversed reads `query_schema` must be reversed (see docs/dev/reverse-reads.md).
-    sstable_position_reader_queue(const time_series_sstable_set& set,
+    // `sstables` must be ordered by the lower bounds of the sstables in query order.
+    sstable_position_reader_queue(lw_shared_ptr<const container_t> sstables,
             schema_ptr query_schema,
             std::function<mutation_reader(sstable&)> create_reader,
             std::function<bool(const sstable&)> filter,
@@ -655,7 +656,7 @@ class sstable_position_reader_queue : public position_reader_queue {
             streamed_mutation::forwarding fwd_sm,
             bool reversed)
         : _query_schema(std::move(query_schema))
-        , _sstables(reversed ? set._sstables_reversed : set._sstables)
+        , _sstables(std::move(sstables))
         , _it(_sstables->begin())
         , _end(_sstables->end())
         , _cmp(*_query_schema)
@@ -739,12 +740,33 @@ std::unique_ptr<position_reader_queue> time_series_sstable_set::make_position_re
         std::function<mutation_reader(sstable&)> create_reader,
         std::function<bool(const sstable&)> filter,
         partition_key pk, schema_ptr query_schema, reader_permit permit,
-        streamed_mutation::forwarding fwd_sm, bool reversed) const {
-    return std::make_unique<sstable_position_reader_queue>(*this,
+        streamed_mutation::forwarding fwd_sm, bool reversed,
+        lw_shared_ptr<const container_t> sstables) const {
+    if (!sstables) {
+        sstables = reversed ? _sstables_reversed : _sstables;
+    }
+    return std::make_unique<sstable_position_reader_queue>(std::move(sstables),
             std::move(query_schema), std::move(create_reader), std::move(filter),
             std::move(pk), std::move(permit), fwd_sm, reversed);
 }
 
+lw_shared_ptr<const time_series_sstable_set::container_t>
+time_series_sstable_set::sstables_ending_after(position_in_partition_view start, bool reversed) const {
+    // Ordered by the upper bounds of the sstables, decreasing in query order.
+    const auto& by_upper_bound = reversed ? *_sstables : *_sstables_reversed;
+    auto end = by_upper_bound.upper_bound(position_in_partition(start.reversed()));
+    auto count = size_t(std::distance(by_upper_bound.begin(), end));
+    if (count > by_upper_bound.size() / 2) {
+        return nullptr;
+    }
+    auto ret = make_lw_shared<container_t>(position_in_partition::less_compare(reversed ? *_reversed_schema : *_schema));
+    for (auto it = by_upper_bound.begin(); it != end; ++it) {
+        const auto& sst = it->second;
+        ret->emplace(reversed ? sst->max_position().reversed() : sst->min_position(), sst);
+    }
+    return ret;
+}
+
 sstable_set_impl::selector_and_schema_t partitioned_sstable_set::make_incremental_selector() const {
     return std::make_tuple(std::make_unique<incremental_selector>(_schema, _unleveled_sstables, _leveled_sstables, _leveled_sstables_change_cnt), std::cref(*_schema));
 }
@@ -1046,12 +1068,21 @@ time_series_sstable_set::create_single_key_sstable_reader(
     };
 
     auto reversed = slice.is_reversed();
+
+    // Sstables which end before the first queried range have no rows for the query, so leaving them
+    // out of the queue saves checking each of them against the filter. Reads of the most recent rows
+    // of a partition spanning many time windows then open only the sstables of the last windows.
+    lw_shared_ptr<const container_t> sstables;
+    if (auto& ranges = slice.row_ranges(*schema, *pos.key()); !ranges.empty()) {
+        sstables = sstables_ending_after(position_in_partition_view::for_range_start(ranges.front()), reversed);
+    }
+
     // Note that `sstable_position_reader_queue` always includes a reader which emits a `partition_start` fragment,
     // guaranteeing that the reader we return emits it as well; this helps us avoid the problem from #3552.
     return make_clustering_combined_reader(
             schema, permit, fwd_sm,
             make_position_reader_queue(
-                std::move(create_reader), std::move(filter), *pos.key(), schema, permit, fwd_sm, reversed));
+                std::move(create_reader), std::move(filter), *pos.key(), schema, permit, fwd_sm, reversed, std::move(sstables)));
 }
 
 compound_sstable_set::compound_sstable_set(schema_ptr schema, std::vector<lw_shared_ptr<sstable_set>> sets)
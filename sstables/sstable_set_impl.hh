@@ -85,6 +85,11 @@ class time_series_sstable_set : public sstable_set_impl {
     // s.max_position().reversed() -> s, ordered using _reversed_schema; the set of values is the same as in _sstables
     lw_shared_ptr<container_t> _sstables_reversed;
 
+    // Returns the sstables whose upper bound (in query order) is not before `start`, keyed
+    // like the container iterated over by reads in that order, or null if they are more
+    // than half of the set.
+    lw_shared_ptr<const container_t> sstables_ending_after(position_in_partition_view start, bool reversed) const;
+
 public:
     time_series_sstable_set(schema_ptr schema, bool enable_optimized_twcs_queries);
     time_series_sstable_set(const time_series_sstable_set& s);
@@ -104,7 +109,8 @@ class time_series_sstable_set : public sstable_set_impl {
         std::function<bool(const sstable&)> filter,
         partition_key pk, schema_ptr schema, reader_permit permit,
         streamed_mutation::forwarding fwd_sm,
-        bool reversed) const;
+        bool reversed,
+        lw_shared_ptr<const container_t> sstables = {}) const;
 
     virtual mutation_reader create_single_key_sstable_reader(
         replica::column_family*,
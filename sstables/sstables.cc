@@ -862,10 +862,13 @@ void sstable::generate_toc() {
     if (_schema->bloom_filter_fp_chance() != 1.0) {
         _recognized_components.insert(component_type::Filter);
     }
-    if (_schema->get_compressor_params().get_compressor() == nullptr) {
+    if (auto c = _schema->get_compressor_params().get_compressor(); c == nullptr) {
         _recognized_components.insert(component_type::CRC);
     } else {
         _recognized_components.insert(component_type::CompressionInfo);
+        if (c->dictionary_size() != 0) {
+            _recognized_components.insert(component_type::CompressionDictionary);
+        }
     }
     _recognized_components.insert(component_type::Scylla);
 }
@@ -1062,10 +1065,20 @@ template void sstable::write_simple<component_type::Summary>(const sstables::sum
 future<> sstable::read_compression() {
      // FIXME: If there is no compression, we should expect a CRC file to be present.
     if (!has_component(component_type::CompressionInfo)) {
-        return make_ready_future<>();
+        co_return;
     }
 
-    return read_simple<component_type::CompressionInfo>(_components->compression);
+    co_await read_simple<component_type::CompressionInfo>(_components->compression);
+
+    if (has_component(component_type::CompressionDictionary)) {
+        co_await do_read_simple(component_type::CompressionDictionary, [this] (version_types v, file f) -> future<> {
+            auto in = make_file_input_stream(f);
+            auto dict = co_await util::read_entire_stream_contiguous(in);
+            co_await in.close();
+            // An empty dictionary means the writer couldn't train one.
+            _components->compression.set_dictionary(bytes(reinterpret_cast<const int8_t*>(dict.data()), dict.size()));
+        });
+    }
 }
 
 void sstable::write_compression() {
@@ -1074,6 +1087,52 @@ void sstable::write_compression() {
     }
 
     write_simple<component_type::CompressionInfo>(_components->compression);
+
+    if (has_component(component_type::CompressionDictionary)) {
+        do_write_simple(component_type::CompressionDictionary, [this] (version_types v, file_writer& w) {
+            write(v, w, _components->compression.dictionary());
+        }, sstable_buffer_size);
+    }
+}
+
+future<> sstable::read_promoted_index_summary() {
+    if (!has_component(component_type::PromotedIndexSummary)) {
+        co_return;
+    }
+    _components->promoted_index_summary.emplace();
+    co_await read_simple<component_type::PromotedIndexSummary>(*_components->promoted_index_summary);
+}
+
+void sstable::write_promoted_index_summary() {
+    if (!has_component(component_type::PromotedIndexSummary)) {
+        return;
+    }
+    if (!_components->promoted_index_summary) {
+        _components->promoted_index_summary.emplace();
+    }
+    write_simple<component_type::PromotedIndexSummary>(*_components->promoted_index_summary);
+}
+
+future<> sstable::read_postings() {
+    if (!has_component(component_type::Postings)) {
+        co_return;
+    }
+    _components->postings.emplace();
+    co_await read_simple<component_type::Postings>(*_components->postings);
+}
+
+void sstable::write_postings() {
+    if (!has_component(component_type::Postings)) {
+        return;
+    }
+    if (!_components->postings) {
+        _components->postings.emplace();
+    }
+    write_simple<component_type::Postings>(*_components->postings);
+}
+
+const column_postings* sstable::get_column_postings(const column_definition& cdef) const {
+    return _components->postings ? _components->postings->find(cdef.name()) : nullptr;
 }
 
 void sstable::validate_partitioner() {
@@ -1364,6 +1423,9 @@ future<> sstable::open_data(sstable_open_config cfg) noexcept {
 
     _total_reclaimable_memory.reset();
     _manager.increment_total_reclaimable_memory_and_maybe_reclaim(this);
+    if (_bloom_filter_deferred) {
+        defer_bloom_filter_loading();
+    }
 }
 
 future<> sstable::update_info_for_opened_data(sstable_open_config cfg) {
@@ -1424,24 +1486,54 @@ future<> sstable::read_filter(sstable_open_config cfg) {
         return make_ready_future<>();
     }
 
+    if (cfg.defer_bloom_filter_loading) {
+        // Loaded in the background once the sstable is open, see defer_bloom_filter_loading().
+        _components->filter = std::make_unique<utils::filter::always_present_filter>();
+        _bloom_filter_deferred = true;
+        return make_ready_future<>();
+    }
+
     return seastar::async([this] () mutable {
         sstables::filter filter;
         read_simple<component_type::Filter>(filter).get();
         auto nr_bits = filter.buckets.elements.size() * std::numeric_limits<typename decltype(filter.buckets.elements)::value_type>::digits;
         large_bitset bs(nr_bits, std::move(filter.buckets.elements));
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), get_filter_format(_version));
+        if (filter.hashes & sstables::filter::split_block_layout_flag) {
+            _components->filter = utils::filter::create_split_block_filter(std::move(bs), get_filter_format(_version));
+        } else if (filter.hashes & sstables::filter::xor_layout_flag) {
+            _components->filter = utils::filter::create_xor_filter(filter.hashes & ~sstables::filter::xor_layout_flag, std::move(bs));
+        } else {
+            _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), get_filter_format(_version));
+        }
     });
 }
 
+utils::filter_layout sstable::filter_layout_for_write() const {
+    auto layout = _schema->bloom_filter_layout();
+    // XOR filters are built in token order, which is the order of their
+    // hashes only with the murmur3 partitioner.
+    if (layout == utils::filter_layout::xor_filter && _schema->get_partitioner().name() != "org.apache.cassandra.dht.Murmur3Partitioner") {
+        return utils::filter_layout::classic;
+    }
+    return layout;
+}
+
 void sstable::write_filter() {
+    _components->filter->finish();
     if (!has_component(component_type::Filter)) {
         return;
     }
 
-    auto f = downcast_ptr<utils::filter::murmur3_bloom_filter>(_components->filter.get());
+    auto f = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get());
 
     auto&& bs = f->bits();
-    auto filter_ref = sstables::filter_ref(f->num_hashes(), bs.get_storage());
+    uint32_t hashes = f->num_hashes();
+    if (f->layout() == utils::filter_layout::split_block) {
+        hashes |= sstables::filter::split_block_layout_flag;
+    } else if (f->layout() == utils::filter_layout::xor_filter) {
+        hashes |= sstables::filter::xor_layout_flag;
+    }
+    auto filter_ref = sstables::filter_ref(hashes, bs.get_storage());
     write_simple<component_type::Filter>(filter_ref);
 }
 
@@ -1453,12 +1545,24 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     // Skip rebuilding the bloom filter if the false positive rate based
     // on the current bitset size is within 75% to 125% of the configured
     // false positive rate.
-    auto curr_bitset_size = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get())->bits().memory_size();
-    auto bitset_size_lower_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 1.25);
-    auto bitset_size_upper_bound = utils::i_filter::get_filter_size(num_partitions,
-                                                                    _schema->bloom_filter_fp_chance() * 0.75);
-    if (bitset_size_lower_bound <= curr_bitset_size && curr_bitset_size <= bitset_size_upper_bound) {
+    _components->filter->finish();
+    auto curr_filter = downcast_ptr<utils::filter::bloom_filter>(_components->filter.get());
+    auto layout = curr_filter->layout();
+    auto curr_bitset_size = curr_filter->bits().memory_size();
+    bool good_size;
+    if (layout == utils::filter_layout::xor_filter) {
+        // The blocks of an XOR filter hold the keys actually added, only
+        // their number comes from the estimate, and too many of them waste
+        // some words each.
+        good_size = curr_bitset_size <= utils::i_filter::get_filter_size(num_partitions, _schema->bloom_filter_fp_chance(), layout) * 5 / 4;
+    } else {
+        auto bitset_size_lower_bound = utils::i_filter::get_filter_size(num_partitions,
+                                                                        _schema->bloom_filter_fp_chance() * 1.25, layout);
+        auto bitset_size_upper_bound = utils::i_filter::get_filter_size(num_partitions,
+                                                                        _schema->bloom_filter_fp_chance() * 0.75, layout);
+        good_size = bitset_size_lower_bound <= curr_bitset_size && curr_bitset_size <= bitset_size_upper_bound;
+    }
+    if (good_size) {
         return;
     }
 
@@ -1473,7 +1577,7 @@ void sstable::maybe_rebuild_filter_from_index(uint64_t num_partitions) {
     };
 
     // Create a new filter that can optimally represent the given num_partitions.
-    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version));
+    auto optimal_filter = utils::i_filter::get_filter(num_partitions, _schema->bloom_filter_fp_chance(), get_filter_format(_version), layout);
     sstlog.info("Rebuilding bloom filter {}: resizing bitset from {} bytes to {} bytes. sstable origin: {}", filename(component_type::Filter), curr_bitset_size,
                 downcast_ptr<utils::filter::bloom_filter>(optimal_filter.get())->bits().memory_size(), _origin);
 
@@ -1557,10 +1661,19 @@ future<> sstable::reload_reclaimed_components() {
 
     co_await read_filter();
     _total_reclaimable_memory.reset();
-    _total_memory_reclaimed -= _components->filter->memory_size();
+    // The size of a deferred filter was only estimated.
+    _total_memory_reclaimed -= std::exchange(_bloom_filter_deferred, false)
+            ? _total_memory_reclaimed
+            : _components->filter->memory_size();
     sstlog.info("Reloaded bloom filter of {}", get_filename());
 }
 
+void sstable::defer_bloom_filter_loading() {
+    auto estimated_keys = std::max<uint64_t>(get_estimated_key_count(), 1);
+    _total_memory_reclaimed = utils::i_filter::get_filter_size(estimated_keys, _schema->bloom_filter_fp_chance());
+    _manager.defer_reclaimable_components_loading(this);
+}
+
 future<> sstable::load_metadata(sstable_open_config cfg, bool validate) noexcept {
     co_await read_toc();
     // read scylla-meta after toc. Might need it to parse
@@ -1572,7 +1685,9 @@ future<> sstable::load_metadata(sstable_open_config cfg, bool validate) noexcept
     co_await coroutine::all(
             [&] { return read_compression(); },
             [&] { return read_filter(cfg); },
-            [&] { return read_summary(); });
+            [&] { return read_summary(); },
+            [&] { return read_promoted_index_summary(); },
+            [&] { return read_postings(); });
     if (validate) {
         validate_min_max_metadata();
         validate_max_local_deletion_time();
@@ -1590,6 +1705,7 @@ future<> sstable::load(const dht::sharder& sharder, sstable_open_config cfg) noe
                 std::vector<unsigned>{this_shard_id()} : compute_shards_for_this_sstable(sharder);
     }
     co_await open_data(cfg);
+    co_await maybe_downsample_summary();
 }
 
 future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
@@ -1606,12 +1722,16 @@ future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
     co_await update_info_for_opened_data();
     _total_reclaimable_memory.reset();
     _manager.increment_total_reclaimable_memory_and_maybe_reclaim(this);
+    if (info.bloom_filter_deferred) {
+        _bloom_filter_deferred = true;
+        defer_bloom_filter_loading();
+    }
 }
 
 future<foreign_sstable_open_info> sstable::get_open_info() & {
     return _components.copy().then([this] (auto c) mutable {
         return foreign_sstable_open_info{std::move(c), this->get_shards_for_this_sstable(), _data_file.dup(), _index_file.dup(),
-            _generation, _version, _format, data_size(), _metadata_size_on_disk};
+            _generation, _version, _format, data_size(), _metadata_size_on_disk, _bloom_filter_deferred};
     });
 }
 
@@ -1694,6 +1814,48 @@ future<> seal_summary(summary& s,
     });
 }
 
+future<> downsample_summary(summary& s, size_t factor) {
+    SCYLLA_ASSERT(factor >= 1);
+    summary ds;
+    ds.header = s.header;
+    ds.first_key = std::move(s.first_key);
+    ds.last_key = std::move(s.last_key);
+    ds.entries.reserve((s.entries.size() + factor - 1) / factor);
+    // Copy the keys which are kept, so the buffers holding the dropped ones are freed.
+    for (size_t i = 0; i < s.entries.size(); i += factor) {
+        auto& e = s.entries[i];
+        ds.entries.push_back(summary_entry{e.get_token(), ds.add_summary_data(e.key), e.position});
+        co_await coroutine::maybe_yield();
+    }
+    ds.header.size = ds.entries.size();
+    ds.header.memory_size = ds.header.size * sizeof(uint32_t);
+    ds.positions.reserve(ds.entries.size());
+    for (auto& e : ds.entries) {
+        ds.positions.push_back(ds.header.memory_size);
+        ds.header.memory_size += e.key.size() + sizeof(e.position);
+    }
+    s = std::move(ds);
+}
+
+future<> sstable::maybe_downsample_summary() {
+    auto& s = _components->summary;
+    if (!_manager.config().enable_sstable_summary_downsampling() || s.entries.size() < 2) {
+        co_return;
+    }
+    // The summary size the writer aims at, see maybe_add_summary_entry().
+    uint64_t target_size = std::max(uint64_t(1), data_size() / summary_byte_cost(_manager.config().sstable_summary_ratio()));
+    uint64_t size = s.header.memory_size;
+    // Leave summaries which are close enough alone, the writer only
+    // approximates the target size.
+    if (size < 2 * target_size) {
+        co_return;
+    }
+    auto factor = std::min<uint64_t>(size / target_size, s.entries.size());
+    auto old_footprint = s.memory_footprint();
+    co_await downsample_summary(s, factor);
+    sstlog.debug("Downsampled the summary of {} by {}, from {} to {} bytes", get_filename(), factor, old_footprint, s.memory_footprint());
+}
+
 static
 void
 populate_statistics_offsets(sstable_version_types v, statistics& s) {
@@ -2295,7 +2457,7 @@ std::vector<std::pair<component_type, sstring>> sstable::all_components() const
 }
 
 future<> sstable::snapshot(const sstring& dir) const {
-    return _storage->snapshot(*this, dir, storage::absolute_path::yes);
+    return _storage->link_to_snapshot(*this, dir);
 }
 
 future<> sstable::change_state(sstable_state to, delayed_commit_changes* delay_commit) {
@@ -2476,7 +2638,7 @@ input_stream<char> sstable::data_stream(uint64_t pos, size_t len,
     options.read_ahead = 4;
     options.dynamic_adjustments = std::move(history);
 
-    file f = make_tracked_file(_data_file, permit);
+    file f = make_tracked_file(_data_file, permit, tracked_file_kind::data);
     if (trace_state) {
         f = tracing::make_traced_file(std::move(f), std::move(trace_state), format("{}:", get_filename()));
     }
@@ -2936,6 +3098,17 @@ future<sstring> make_toc_temporary(sstring sstable_toc_name, storage::sync_dir s
     co_return new_toc_name;
 }
 
+bool sstable::is_index_page_cached(dht::ring_position_view pos) const {
+    const auto& entries = _components->summary.entries;
+    if (entries.empty()) {
+        return false;
+    }
+    // Same page selection as index_reader::advance_to().
+    auto i = std::lower_bound(entries.begin(), entries.end(), pos, index_comparator(*_schema));
+    auto summary_idx = i == entries.begin() ? 0 : std::distance(entries.begin(), i) - 1;
+    return _index_cache->is_cached(summary_idx);
+}
+
 /**
  * Returns a pair of positions [p1, p2) in the summary file corresponding to
  * pages which may include keys covered by the specified range, or a disengaged
@@ -3109,6 +3282,8 @@ void register_index_page_cache_metrics(seastar::metrics::metric_groups& metrics,
             sm::description("Total number of index page cache pages which have been evicted")),
         sm::make_counter("index_page_cache_populations", [&m] { return m.page_populations; },
             sm::description("Total number of index page cache pages which were inserted into the cache")),
+        sm::make_counter("index_page_cache_second_chances", [&m] { return m.page_second_chances; },
+            sm::description("Index page cache pages which were spared from eviction, because they were hit since they were last considered for it")),
         sm::make_gauge("index_page_cache_bytes", [&m] { return m.cached_bytes; },
             sm::description("Total number of bytes cached in the index page cache")),
         sm::make_gauge("index_page_cache_bytes_in_std", [&m] { return m.bytes_in_std; },
@@ -3129,6 +3304,8 @@ void register_index_page_metrics(seastar::metrics::metric_groups& metrics, parti
             sm::description("Index pages which got evicted from memory")),
         sm::make_counter("index_page_populations", [&m] { return m.populations; },
             sm::description("Index pages which got populated into memory")),
+        sm::make_counter("index_page_second_chances", [&m] { return m.second_chances; },
+            sm::description("Index pages which were spared from eviction, because they were hit since they were last considered for it")),
         sm::make_gauge("index_page_used_bytes", [&m] { return m.used_bytes; },
             sm::description("Amount of bytes used by index pages in memory")),
 
@@ -3216,6 +3393,13 @@ future<> init_metrics() {
 
         sm::make_gauge("bloom_filter_memory_size", [] { return utils::filter::bloom_filter::get_shard_stats().memory_size; },
             sm::description("Bloom filter memory usage in bytes.")),
+
+        sm::make_counter("validation_partitions_full", [] { return mutation_fragment_stream_validation_stats::shard_stats().partitions_fully_validated; },
+            sm::description("Number of partitions whose fragments were validated down to the clustering keys")),
+        sm::make_counter("validation_partitions_partial", [] { return mutation_fragment_stream_validation_stats::shard_stats().partitions_partially_validated; },
+            sm::description("Number of partitions which weren't sampled for clustering key validation, and only had their partition key validated")),
+        sm::make_counter("validation_errors", [] { return mutation_fragment_stream_validation_stats::shard_stats().errors; },
+            sm::description("Number of mutation fragment stream validation errors")),
     });
   });
 }
@@ -102,11 +102,18 @@ struct sstable_writer_config {
     uint64_t max_sstable_size = std::numeric_limits<uint64_t>::max();
     bool backup = false;
     mutation_fragment_stream_validation_level validation_level;
+    // Fraction of partitions validated at validation_level, see
+    // mutation_fragment_stream_validating_filter::set_full_validation_ratio().
+    double full_validation_ratio = 1.0;
     std::optional<db::replay_position> replay_position;
     std::optional<int> sstable_level;
     write_monitor* monitor = &default_write_monitor();
     run_id run_identifier = run_id::create_random_id();
     size_t summary_byte_cost;
+    // Write the PromotedIndexSummary component.
+    bool promoted_index_summary = false;
+    // Write the Postings component, for the columns the table has indexes on.
+    bool postings = false;
     sstring origin;
 
 private:
@@ -422,6 +429,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     std::vector<std::pair<component_type, sstring>> all_components() const;
 
+    // Links the sstable into the existing snapshot directory dir, which the
+    // caller syncs when all the sstables of the snapshot are linked.
     future<> snapshot(const sstring& dir) const;
 
     // Delete the sstable by unlinking all sstable files
@@ -603,6 +612,11 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     mutable std::optional<size_t> _total_reclaimable_memory{0};
     // Total memory reclaimed so far from this sstable
     size_t _total_memory_reclaimed{0};
+    // The bloom filter was not read on open, see sstable_open_config::defer_bloom_filter_loading.
+    bool _bloom_filter_deferred = false;
+    // Lookups of the bloom filter, decayed by the sstables manager, which
+    // reclaims the filters of the least read tables first.
+    mutable uint64_t _filter_lookups = 0;
 public:
     bool has_component(component_type f) const;
     sstables_manager& manager() { return _manager; }
@@ -643,6 +657,12 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     future<> read_compression();
     void write_compression();
 
+    future<> read_promoted_index_summary();
+    void write_promoted_index_summary();
+
+    future<> read_postings();
+    void write_postings();
+
     future<> read_scylla_metadata() noexcept;
 
     void write_scylla_metadata(shard_id shard,
@@ -654,6 +674,9 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     future<> read_filter(sstable_open_config cfg = {});
 
     void write_filter();
+    // The layout of the filter of a new sstable, as configured for the table
+    // unless it can't be used with the table's partitioner.
+    utils::filter_layout filter_layout_for_write() const;
     // Rebuild a bloom filter from the index with the given number of
     // partitions, if the partition estimate provided during bloom
     // filter initialisation was not good.
@@ -670,6 +693,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // happen if old tools are being used.
     future<> generate_summary();
 
+    // Shrinks a summary which is much larger than sstable_summary_ratio
+    // allows, e.g. one written with a higher ratio or by Cassandra.
+    future<> maybe_downsample_summary();
+
     future<> read_statistics();
     void write_statistics();
     // Rewrite statistics component by creating a temporary Statistics and
@@ -708,6 +735,13 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     size_t total_memory_reclaimed() const;
     // Reload components from which memory was previously reclaimed
     future<> reload_reclaimed_components();
+    // Returns the recent lookups of the bloom filter and halves them.
+    uint64_t decay_filter_lookups() noexcept {
+        return std::exchange(_filter_lookups, _filter_lookups / 2);
+    }
+    // Hands the loading of a deferred bloom filter over to the sstables manager,
+    // accounting the filter as reclaimed memory, with an estimated size.
+    void defer_bloom_filter_loading();
 
 public:
     // Finds first position_in_partition in a given partition.
@@ -824,6 +858,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     }
 
     bool filter_has_key(const key& key) const {
+        ++_filter_lookups;
         return _components->filter->is_present(bytes_view(key));
     }
 
@@ -836,6 +871,7 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     future<bool> has_partition_key(const utils::hashed_key& hk, const dht::decorated_key& dk);
 
     bool filter_has_key(utils::hashed_key key) const {
+        ++_filter_lookups;
         return _components->filter->is_present(key);
     }
 
@@ -843,6 +879,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return filter_has_key(key::from_partition_key(s, key));
     }
 
+    // Returns true iff the partition index page which the lookup of the given
+    // position would read is in the index cache.
+    bool is_index_page_cached(dht::ring_position_view pos) const;
+
     static utils::hashed_key make_hashed_key(const schema& s, const partition_key& key);
 
     filter_tracker& get_filter_tracker() { return _filter_tracker; }
@@ -973,6 +1013,11 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // Some or all entries may be missing if not present in scylla_metadata
     scylla_metadata::ext_timestamp_stats::map_type get_ext_timestamp_stats() const noexcept;
 
+    // Return the postings of the column from the Postings component, or
+    // nullptr if the sstable has none for it: the component wasn't written,
+    // the column isn't indexed, or it had too many values.
+    const column_postings* get_column_postings(const column_definition& cdef) const;
+
     const sstring& get_origin() const noexcept {
         return _origin;
     }
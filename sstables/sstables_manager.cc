@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <unordered_map>
+
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/switch_to.hh>
 #include "utils/log.hh"
@@ -55,10 +57,17 @@ sstables_manager::~sstables_manager() {
 storage_manager::storage_manager(const db::config& cfg, config stm_cfg)
     : _s3_clients_memory(stm_cfg.s3_clients_memory)
     , _config_updater(this_shard_id() == 0 ? std::make_unique<config_updater>(cfg, *this) : nullptr)
+    , _pin_index_in_object_cache(cfg.object_storage_cache_pin_index())
 {
     for (auto [ep, ecfg] : cfg.object_storage_config()) {
         _s3_endpoints.emplace(std::make_pair(std::move(ep), make_lw_shared<s3::endpoint_config>(std::move(ecfg))));
     }
+    if (!cfg.object_storage_cache_directory().empty() && cfg.object_storage_cache_size_in_mb() > 0) {
+        _object_cache = std::make_unique<object_block_cache>(object_block_cache::config{
+            .directory = std::filesystem::path(cfg.object_storage_cache_directory()) / fmt::format("shard-{}", this_shard_id()),
+            .capacity = (cfg.object_storage_cache_size_in_mb() << 20) / smp::count,
+        });
+    }
 }
 
 future<> storage_manager::stop() {
@@ -66,6 +75,10 @@ future<> storage_manager::stop() {
         co_await _config_updater->action.join();
     }
 
+    if (_object_cache) {
+        co_await _object_cache->stop();
+    }
+
     for (auto ep : _s3_endpoints) {
         if (ep.second.client != nullptr) {
             co_await ep.second.client->close();
@@ -145,7 +158,10 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
     cfg.validation_level = _db_config.enable_sstable_key_validation()
             ? mutation_fragment_stream_validation_level::clustering_key
             : mutation_fragment_stream_validation_level::token;
+    cfg.full_validation_ratio = _db_config.sstable_key_validation_ratio();
     cfg.summary_byte_cost = summary_byte_cost(_db_config.sstable_summary_ratio());
+    cfg.promoted_index_summary = _db_config.enable_sstable_promoted_index_summary();
+    cfg.postings = _db_config.enable_sstable_postings();
 
     cfg.origin = std::move(origin);
 
@@ -161,17 +177,70 @@ void sstables_manager::increment_total_reclaimable_memory_and_maybe_reclaim(ssta
         return;
     }
 
-    // Memory consumption has crossed threshold. Reclaim from the SSTable that
-    // has the most reclaimable memory to get the total consumption under limit.
-    auto sst_with_max_memory = std::max_element(_active.begin(), _active.end(), [](const sstable& sst1, const sstable& sst2) {
-        return sst1.total_reclaimable_memory_size() < sst2.total_reclaimable_memory_size();
-    });
+    // Memory consumption has crossed threshold. Reclaim from the coldest SSTable
+    // to get the total consumption under limit.
+    auto sst_to_reclaim = pick_filter_to_reclaim();
+    if (!sst_to_reclaim) {
+        return;
+    }
 
-    auto memory_reclaimed = sst_with_max_memory->reclaim_memory_from_components();
+    auto memory_reclaimed = sst_to_reclaim->reclaim_memory_from_components();
     _total_memory_reclaimed += memory_reclaimed;
     _total_reclaimable_memory -= memory_reclaimed;
-    _reclaimed.insert(*sst_with_max_memory);
-    smlogger.info("Reclaimed {} bytes of memory from SSTable components. Total memory reclaimed so far is {} bytes", memory_reclaimed, _total_memory_reclaimed);
+    _reclaimed.insert(*sst_to_reclaim);
+    smlogger.info("Reclaimed {} bytes of memory from SSTable components of {}.{}. Total memory reclaimed so far is {} bytes",
+            memory_reclaimed, sst_to_reclaim->get_schema()->ks_name(), sst_to_reclaim->get_schema()->cf_name(), _total_memory_reclaimed);
+}
+
+// Filters of rarely read tables are the cheapest to lose: reads of their
+// sstables which would have been filtered out cost an index lookup instead.
+// So pick the table with the fewest filter lookups per byte of filter memory,
+// and in it the sstable with the largest filter. The lookups are decayed with
+// every pick, so that the choice follows the recent reads of the tables.
+// Tables rather than sstables are compared to protect the freshly written
+// sstables of hot tables, which have no lookups yet.
+sstable* sstables_manager::pick_filter_to_reclaim() {
+    struct table_filters {
+        uint64_t lookups = 0;
+        size_t memory = 0;
+        sstable* largest = nullptr;
+        size_t largest_memory = 0;
+    };
+    std::unordered_map<table_id, table_filters> tables;
+    for (auto& sst : _active) {
+        auto& t = tables[sst.get_schema()->id()];
+        t.lookups += sst.decay_filter_lookups();
+        auto memory = sst.total_reclaimable_memory_size();
+        t.memory += memory;
+        if (memory > t.largest_memory) {
+            t.largest = &sst;
+            t.largest_memory = memory;
+        }
+    }
+
+    const table_filters* coldest = nullptr;
+    for (const auto& [id, t] : tables) {
+        if (!t.largest) {
+            continue;
+        }
+        if (!coldest) {
+            coldest = &t;
+            continue;
+        }
+        // Compares t.lookups / t.memory with coldest->lookups / coldest->memory.
+        auto heat = double(t.lookups) * coldest->memory;
+        auto coldest_heat = double(coldest->lookups) * t.memory;
+        if (heat < coldest_heat || (heat == coldest_heat && t.largest_memory > coldest->largest_memory)) {
+            coldest = &t;
+        }
+    }
+    return coldest ? coldest->largest : nullptr;
+}
+
+void sstables_manager::defer_reclaimable_components_loading(sstable* sst) {
+    _total_memory_reclaimed += sst->total_memory_reclaimed();
+    _reclaimed.insert(*sst);
+    _sstable_deleted_event.signal();
 }
 
 size_t sstables_manager::get_memory_available_for_reclaimable_components() {
@@ -219,6 +288,8 @@ future<> sstables_manager::components_reloader_fiber() {
                 break;
             }
 
+            // The memory of deferred bloom filters is only estimated before they are loaded.
+            _total_reclaimable_memory = _total_reclaimable_memory - reclaimed_memory + sstable_ptr->total_reclaimable_memory_size();
             _total_memory_reclaimed -= reclaimed_memory;
             memory_available = get_memory_available_for_reclaimable_components();
         }
@@ -17,6 +17,7 @@
 #include "gc_clock.hh"
 #include "sstables/sstables.hh"
 #include "sstables/shareable_components.hh"
+#include "sstables/object_block_cache.hh"
 #include "sstables/shared_sstable.hh"
 #include "sstables/version.hh"
 #include "db/cache_tracker.hh"
@@ -60,6 +61,9 @@ class storage_manager : public peering_sharded_service<storage_manager> {
     semaphore _s3_clients_memory;
     std::unordered_map<sstring, s3_endpoint> _s3_endpoints;
     std::unique_ptr<config_updater> _config_updater;
+    // Local cache of blocks of sstables on object storage, if configured.
+    std::unique_ptr<object_block_cache> _object_cache;
+    bool _pin_index_in_object_cache;
 
     void update_config(const db::config&);
 
@@ -71,6 +75,13 @@ class storage_manager : public peering_sharded_service<storage_manager> {
     storage_manager(const db::config&, config cfg);
     shared_ptr<s3::client> get_endpoint_client(sstring endpoint);
     bool is_known_endpoint(sstring endpoint) const;
+    object_block_cache* object_cache() noexcept {
+        return _object_cache.get();
+    }
+    // Whether blocks of the Index and Summary components are pinned in the object cache.
+    bool pin_index_in_object_cache() const noexcept {
+        return _pin_index_in_object_cache;
+    }
     future<> stop();
 };
 
@@ -108,7 +119,8 @@ class sstables_manager {
     size_t _total_memory_reclaimed{0};
     // Set of sstables from which memory has been reclaimed
     set_type _reclaimed;
-    // Condition variable that gets notified when an sstable is deleted
+    // Condition variable that gets notified when an sstable is deleted, or
+    // when the loading of its bloom filter is deferred
     seastar::condition_variable _sstable_deleted_event;
     future<> _components_reloader_status = make_ready_future<>();
 
@@ -153,6 +165,14 @@ class sstables_manager {
         return _storage->is_known_endpoint(std::move(endpoint));
     }
 
+    object_block_cache* object_cache() const noexcept {
+        return _storage ? _storage->object_cache() : nullptr;
+    }
+
+    bool pin_index_in_object_cache() const noexcept {
+        return _storage && _storage->pin_index_in_object_cache();
+    }
+
     virtual sstable_writer_config configure_writer(sstring origin) const;
     bool uuid_sstable_identifiers() const;
     const db::config& config() const { return _db_config; }
@@ -216,6 +236,12 @@ class sstables_manager {
     // memory and if the total memory usage exceeds the pre-defined threshold,
     // reclaim it from the SSTable that has the most reclaimable memory.
     void increment_total_reclaimable_memory_and_maybe_reclaim(sstable* sst);
+    // Picks the sstable to reclaim the bloom filter from, see the definition.
+    sstable* pick_filter_to_reclaim();
+    // Queues the deferred bloom filter of the sstable (see
+    // sstable_open_config::defer_bloom_filter_loading) for loading by the
+    // components reloader, as if its memory was reclaimed.
+    void defer_reclaimable_components_loading(sstable* sst);
     // Fiber to reload reclaimed components back into memory when memory becomes available.
     future<> components_reloader_fiber();
     size_t get_memory_available_for_reclaimable_components();
@@ -76,6 +76,7 @@ class filesystem_storage final : public sstables::storage {
 
     virtual future<> seal(const sstable& sst) override;
     virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen) const override;
+    virtual future<> link_to_snapshot(const sstable& sst, sstring dir) const override;
     virtual future<> change_state(const sstable& sst, sstable_state state, generation_type generation, delayed_commit_changes* delay) override;
     // runs in async context
     virtual void open(sstable& sst) override;
@@ -369,6 +370,23 @@ future<> filesystem_storage::snapshot(const sstable& sst, sstring dir, absolute_
     co_await create_links_common(sst, snapshot_dir, std::move(gen));
 }
 
+// Syncing the directory a few times per sstable (see create_links_common())
+// makes snapshots of tables with many sstables take minutes, so the links are
+// only synced by the caller once all of them are created.
+future<> filesystem_storage::link_to_snapshot(const sstable& sst, sstring dir) const {
+    auto link = [this, &sst, &dir] (component_type type) {
+        auto src = sstable::filename(_dir.native(), sst._schema->ks_name(), sst._schema->cf_name(), sst._version, sst._generation, sst._format, type);
+        auto dst = sstable::filename(dir, sst._schema->ks_name(), sst._schema->cf_name(), sst._version, sst._generation, sst._format, type);
+        return sst.sstable_write_io_check(idempotent_link_file, std::move(src), std::move(dst));
+    };
+    // The TOC is linked last, so that an sstable of an incomplete snapshot
+    // which has one usually has all its components too.
+    co_await parallel_for_each(sst.all_components(), [&link] (const auto& p) {
+        return p.first == component_type::TOC ? make_ready_future<>() : link(p.first);
+    });
+    co_await link(component_type::TOC);
+}
+
 future<> filesystem_storage::move(const sstable& sst, sstring new_dir, generation_type new_generation, delayed_commit_changes* delay_commit) {
     co_await touch_directory(new_dir);
     sstring old_dir = _dir.native();
@@ -505,8 +523,11 @@ future<> filesystem_storage::remove_by_registry_entry(entry_descriptor desc) {
 
 class s3_storage : public sstables::storage {
     shared_ptr<s3::client> _client;
+    sstring _endpoint;
     sstring _bucket;
     std::variant<sstring, table_id> _location;
+    object_block_cache* _cache;
+    bool _pin_index;
 
     static constexpr auto status_creating = "creating";
     static constexpr auto status_sealed = "sealed";
@@ -514,6 +535,12 @@ class s3_storage : public sstables::storage {
 
     sstring make_s3_object_name(const sstable& sst, component_type type) const;
 
+    void invalidate_cached(const sstring& object_name) {
+        if (_cache) {
+            _cache->invalidate(object_block_cache::make_object_key(_endpoint, object_name));
+        }
+    }
+
     table_id owner() const {
         if (std::holds_alternative<sstring>(_location)) {
             on_internal_error(sstlog, format("Storage holds {} prefix, but registry owner is expected", std::get<sstring>(_location)));
@@ -522,10 +549,13 @@ class s3_storage : public sstables::storage {
     }
 
 public:
-    s3_storage(shared_ptr<s3::client> client, sstring bucket, std::variant<sstring, table_id> loc)
+    s3_storage(shared_ptr<s3::client> client, sstring endpoint, sstring bucket, std::variant<sstring, table_id> loc, object_block_cache* cache, bool pin_index)
         : _client(std::move(client))
+        , _endpoint(std::move(endpoint))
         , _bucket(std::move(bucket))
         , _location(std::move(loc))
+        , _cache(cache)
+        , _pin_index(pin_index)
     {
     }
 
@@ -585,7 +615,13 @@ void s3_storage::open(sstable& sst) {
 }
 
 future<file> s3_storage::open_component(const sstable& sst, component_type type, open_flags flags, file_open_options options, bool check_integrity) {
-    co_return _client->make_readable_file(make_s3_object_name(sst, type));
+    auto name = make_s3_object_name(sst, type);
+    auto f = _client->make_readable_file(name);
+    if (_cache) {
+        auto pin = object_block_cache::pinned(_pin_index && (type == component_type::Index || type == component_type::Summary));
+        f = _cache->make_caching_file(object_block_cache::make_object_key(_endpoint, name), pin, std::move(f));
+    }
+    co_return f;
 }
 
 future<data_sink> s3_storage::make_data_or_index_sink(sstable& sst, component_type type) {
@@ -618,7 +654,9 @@ future<> s3_storage::wipe(const sstable& sst, sync_dir) noexcept {
     co_await sstables_registry.update_entry_status(owner(), sst.generation(), status_removing);
 
     co_await coroutine::parallel_for_each(sst._recognized_components, [this, &sst] (auto type) -> future<> {
-        co_await _client->delete_object(make_s3_object_name(sst, type));
+        auto name = make_s3_object_name(sst, type);
+        invalidate_cached(name);
+        co_await _client->delete_object(std::move(name));
     });
 
     co_await sstables_registry.delete_entry(owner(), sst.generation());
@@ -650,9 +688,11 @@ future<> s3_storage::remove_by_registry_entry(entry_descriptor desc) {
 
     co_await coroutine::parallel_for_each(components, [this, &prefix] (sstring comp) -> future<> {
         if (comp != sstable_version_constants::TOC_SUFFIX) {
+            invalidate_cached(prefix + "/" + comp);
             co_await _client->delete_object(prefix + "/" + comp);
         }
     });
+    invalidate_cached(prefix + "/" + sstable_version_constants::TOC_SUFFIX);
     co_await _client->delete_object(prefix + "/" + sstable_version_constants::TOC_SUFFIX);
 }
 
@@ -676,7 +716,8 @@ std::unique_ptr<sstables::storage> make_storage(sstables_manager& manager, const
                     }, os.location)) {
                 on_internal_error(sstlog, "S3 storage options is missing 'location'");
             }
-            return std::make_unique<sstables::s3_storage>(manager.get_endpoint_client(os.endpoint), os.bucket, os.location);
+            return std::make_unique<sstables::s3_storage>(manager.get_endpoint_client(os.endpoint), os.endpoint, os.bucket, os.location,
+                    manager.object_cache(), manager.pin_index_in_object_cache());
         }
     }, s_opts.value);
 }
@@ -98,6 +98,13 @@ class storage {
 
     virtual future<> seal(const sstable& sst) = 0;
     virtual future<> snapshot(const sstable& sst, sstring dir, absolute_path abs, std::optional<generation_type> gen = {}) const = 0;
+    // Links the sstable into the existing snapshot directory dir. Unlike
+    // snapshot(), the links aren't made atomic with a TemporaryTOC nor
+    // synced: the caller syncs the directory once all sstables are linked,
+    // and the manifest written after that marks the snapshot as complete.
+    virtual future<> link_to_snapshot(const sstable& sst, sstring dir) const {
+        return snapshot(sst, std::move(dir), absolute_path::yes);
+    }
     virtual future<> change_state(const sstable& sst, sstable_state to, generation_type generation, delayed_commit_changes* delay) = 0;
     // runs in async context
     virtual void open(sstable& sst) = 0;
@@ -21,6 +21,7 @@
 #include "sstables/file_writer.hh"
 #include "db/commitlog/replay_position.hh"
 #include "version.hh"
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <type_traits>
@@ -87,6 +88,13 @@ struct option {
 };
 
 struct filter {
+    // Filter.db format version marker: split-block filters
+    // (utils::filter_layout::split_block) set this bit in the hash count.
+    static constexpr uint32_t split_block_layout_flag = 0x80000000;
+    // XOR filters (utils::filter_layout::xor_filter) set this bit in the
+    // hash count, which holds their fingerprint size.
+    static constexpr uint32_t xor_layout_flag = 0x40000000;
+
     uint32_t hashes;
     disk_array<uint32_t, uint64_t> buckets;
 
@@ -649,6 +657,101 @@ struct scylla_metadata {
     auto describe_type(sstable_version_types v, Describer f) { return f(data); }
 };
 
+// The start position of a promoted index block of a partition, as written in
+// the promoted index, sampled into the PromotedIndexSummary component.
+struct promoted_index_sample {
+    uint32_t block;
+    uint8_t kind; // bound_kind_m of the block start
+    disk_string<uint16_t> clustering; // the clustering_key_prefix
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(block, kind, clustering); }
+};
+
+struct partition_promoted_index_summary {
+    // The position of the promoted index blocks of the partition in the index file.
+    uint64_t promoted_index_start;
+    // Evenly spaced over the blocks of the promoted index, increasing by block.
+    disk_array<uint32_t, promoted_index_sample> samples;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(promoted_index_start, samples); }
+};
+
+// Scylla-specific summary of the promoted indexes of the wide partitions of an
+// sstable. Binary search over the promoted index of a wide partition reads
+// promoted index blocks scattered over many pages of the index file, and the
+// promoted index cache only holds them while the sstable is open. The samples
+// narrow the search down to a range of adjacent blocks, which share few pages,
+// without I/O: the component is loaded along the other metadata once the
+// sstable opens.
+struct promoted_index_summary {
+    // Sorted by promoted_index_start.
+    disk_array<uint32_t, partition_promoted_index_summary> partitions;
+
+    const partition_promoted_index_summary* find(uint64_t promoted_index_start) const {
+        auto& p = partitions.elements;
+        auto it = std::lower_bound(p.begin(), p.end(), promoted_index_start, [] (const partition_promoted_index_summary& e, uint64_t pos) {
+            return e.promoted_index_start < pos;
+        });
+        return it != p.end() && it->promoted_index_start == promoted_index_start ? &*it : nullptr;
+    }
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(partitions); }
+};
+
+// The partitions of an sstable with a live cell of a column holding a value.
+struct value_postings {
+    disk_string<uint32_t> value;
+    // The positions of the partitions in the data file, increasing.
+    disk_array<uint32_t, uint64_t> partitions;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(value, partitions); }
+};
+
+struct column_postings {
+    disk_string<uint16_t> column_name;
+    // Sorted by value, as unsigned bytes.
+    disk_array<uint32_t, value_postings> values;
+
+    // Returns nullptr if no partition of the sstable holds the value.
+    const value_postings* find(bytes_view value) const {
+        auto& v = values.elements;
+        auto it = std::lower_bound(v.begin(), v.end(), value, [] (const value_postings& e, bytes_view value) {
+            return compare_unsigned(e.value.value, value) < 0;
+        });
+        return it != v.end() && it->value.value == value ? &*it : nullptr;
+    }
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(column_name, values); }
+};
+
+// Scylla-specific posting lists of the indexed columns of an sstable: for each
+// value of the column, the partitions holding it. A query restricting the
+// column to a value only needs to read these partitions of the sstable,
+// instead of scanning all of it, without the write cost of a view. Columns
+// with too many values are left out, so the postings of low-cardinality
+// columns stay small enough to be loaded along the other metadata.
+struct postings {
+    // Sorted by column_name.
+    disk_array<uint32_t, column_postings> columns;
+
+    // Returns nullptr if the sstable has no postings for the column.
+    const column_postings* find(bytes_view column_name) const {
+        auto& c = columns.elements;
+        auto it = std::lower_bound(c.begin(), c.end(), column_name, [] (const column_postings& e, bytes_view name) {
+            return compare_unsigned(e.column_name.value, name) < 0;
+        });
+        return it != c.end() && it->column_name.value == column_name ? &*it : nullptr;
+    }
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(columns); }
+};
+
 static constexpr int DEFAULT_CHUNK_SIZE = 65536;
 
 // checksums are generated using adler32 algorithm.
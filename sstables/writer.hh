@@ -558,6 +558,10 @@ future<> seal_summary(summary& s,
     std::optional<key>&& last_key,
     const index_sampling_state& state);
 
+// Keeps only every factor-th entry of the summary, starting with the first one.
+// Each index page then spans the pages of the dropped entries which follow it.
+future<> downsample_summary(summary& s, size_t factor);
+
 void seal_statistics(sstable_version_types, statistics&, metadata_collector&,
     const sstring partitioner, double bloom_filter_fp_chance, schema_ptr,
     const dht::decorated_key& first_key, const dht::decorated_key& last_key,
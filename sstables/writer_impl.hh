@@ -33,7 +33,9 @@ struct sstable_writer::writer_impl {
         , _cfg(cfg)
         , _collector(_schema, sst.get_filename(), sst.manager().get_local_host_id())
         , _validator(format("sstable writer {}", _sst.get_filename()), _schema, _cfg.validation_level)
-    {}
+    {
+        _validator.set_full_validation_ratio(_cfg.full_validation_ratio);
+    }
 
     virtual void consume_new_partition(const dht::decorated_key& dk) = 0;
     virtual void consume(tombstone t) = 0;
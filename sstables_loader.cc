@@ -20,6 +20,8 @@
 #include "streaming/stream_mutation_fragments_cmd.hh"
 #include "streaming/stream_reason.hh"
 #include "readers/mutation_fragment_v1_stream.hh"
+#include "mutation/mutation_source_metadata.hh"
+#include "mutation_writer/multishard_writer.hh"
 #include "locator/abstract_replication_strategy.hh"
 #include "message/messaging_service.hh"
 
@@ -454,6 +456,91 @@ future<> sstables_loader::load_new_sstables(sstring ks_name, sstring cf_name,
     co_return;
 }
 
+future<> sstables_loader::write_sstable(lw_shared_ptr<replica::table> cf, utils::UUID ops_uuid, mutation_reader reader, uint64_t estimated_partitions) {
+    std::exception_ptr ex;
+    try {
+        auto sst = cf->make_streaming_sstable_for_write();
+        // Registered before writing, so that a partially written sstable is removed as well.
+        _written_sstables[ops_uuid].push_back(sst);
+        auto s = reader.schema();
+        auto cfg = cf->get_sstables_manager().configure_writer("load_mutations");
+        co_await sst->write_components(std::move(reader), estimated_partitions, s, cfg, encoding_stats{});
+        co_await sst->open_data();
+        co_return;
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await reader.close();
+    std::rethrow_exception(std::move(ex));
+}
+
+future<> sstables_loader::write_sstables(utils::UUID ops_uuid, mutation_reader reader, uint64_t estimated_partitions) {
+    auto cf = _db.local().find_column_family(reader.schema()).shared_from_this();
+    auto metadata = mutation_source_metadata{};
+    auto& cs = cf->get_compaction_strategy();
+    auto adjusted_estimated_partitions = cs.adjust_partition_estimate(metadata, estimated_partitions, cf->schema());
+    reader_consumer_v2 consumer = [this, cf, ops_uuid, adjusted_estimated_partitions] (mutation_reader reader) {
+        return write_sstable(cf, ops_uuid, std::move(reader), adjusted_estimated_partitions);
+    };
+    co_await cs.make_interposer_consumer(metadata, std::move(consumer))(std::move(reader));
+}
+
+future<> sstables_loader::unlink_written_sstables(utils::UUID ops_uuid) {
+    auto it = _written_sstables.find(ops_uuid);
+    if (it == _written_sstables.end()) {
+        co_return;
+    }
+    auto sstables = std::move(it->second);
+    _written_sstables.erase(it);
+    for (auto& sst : sstables) {
+        llog.debug("load_mutations: ops_uuid={}, remove sst={}", ops_uuid, sst->toc_filename());
+        co_await sst->unlink();
+    }
+}
+
+future<> sstables_loader::load_mutations(mutation_reader reader, uint64_t estimated_partitions) {
+    co_await coroutine::switch_to(_sched_group);
+
+    auto s = reader.schema();
+    std::exception_ptr ex;
+    auto ops_uuid = utils::make_random_uuid();
+    uint64_t partitions = 0;
+    try {
+        auto& t = _db.local().find_column_family(s);
+        if (!t.views().empty()) {
+            throw std::invalid_argument(format("Cannot load mutations into table {}.{}: it has materialized views or secondary indexes",
+                    s->ks_name(), s->cf_name()));
+        }
+        llog.info("load_mutations: started ops_uuid={}, ks={}, table={}", ops_uuid, s->ks_name(), s->cf_name());
+        auto erm = t.get_effective_replication_map();
+        partitions = co_await mutation_writer::distribute_reader_and_consume_on_shards(s, erm->get_sharder(*s), std::move(reader),
+                [&loaders = container(), ops_uuid, estimated_partitions] (mutation_reader reader) {
+            return loaders.local().write_sstables(ops_uuid, std::move(reader), estimated_partitions);
+        });
+        // The sstables are only made visible once all of them are written.
+        co_await container().invoke_on_all([ops_uuid, table_id = s->id()] (sstables_loader& loader) -> future<> {
+            auto it = loader._written_sstables.find(ops_uuid);
+            if (it == loader._written_sstables.end()) {
+                co_return;
+            }
+            auto sstables = std::move(it->second);
+            loader._written_sstables.erase(it);
+            co_await loader._db.local().find_column_family(table_id).add_sstables_and_update_cache(sstables);
+        });
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        llog.warn("load_mutations: ops_uuid={}, ks={}, table={}, status=failed: {}", ops_uuid, s->ks_name(), s->cf_name(), ex);
+        co_await reader.close();
+        co_await container().invoke_on_all([ops_uuid] (sstables_loader& loader) {
+            return loader.unlink_written_sstables(ops_uuid);
+        });
+        std::rethrow_exception(std::move(ex));
+    }
+    llog.info("load_mutations: finished ops_uuid={}, ks={}, table={}, partitions={}", ops_uuid, s->ks_name(), s->cf_name(), partitions);
+}
+
 class sstables_loader::download_task_impl : public tasks::task_manager::task::impl {
     sharded<sstables_loader>& _loader;
     sstring _endpoint;
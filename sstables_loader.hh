@@ -8,16 +8,20 @@
 
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 #include <seastar/core/sharded.hh>
+#include "readers/mutation_reader_fwd.hh"
 #include "schema/schema_fwd.hh"
 #include "sstables/shared_sstable.hh"
 #include "tasks/task_manager.hh"
+#include "utils/UUID.hh"
 
 using namespace seastar;
 
 namespace replica {
 class database;
+class table;
 }
 
 namespace sstables { class storage_manager; }
@@ -56,10 +60,18 @@ class sstables_loader : public seastar::peering_sharded_service<sstables_loader>
     // ever arise.
     bool _loading_new_sstables = false;
 
+    // The sstables written by load_mutations() on this shard, by operation,
+    // not yet added to their table.
+    std::unordered_map<utils::UUID, std::vector<sstables::shared_sstable>> _written_sstables;
+
     future<> load_and_stream(sstring ks_name, sstring cf_name,
             table_id, std::vector<sstables::shared_sstable> sstables,
             bool primary_replica_only, bool unlink_sstables);
 
+    future<> write_sstable(lw_shared_ptr<replica::table> cf, utils::UUID ops_uuid, mutation_reader reader, uint64_t estimated_partitions);
+    future<> write_sstables(utils::UUID ops_uuid, mutation_reader reader, uint64_t estimated_partitions);
+    future<> unlink_written_sstables(utils::UUID ops_uuid);
+
 public:
     sstables_loader(sharded<replica::database>& db,
             netw::messaging_service& messaging,
@@ -85,6 +97,22 @@ class sstables_loader : public seastar::peering_sharded_service<sstables_loader>
     future<> load_new_sstables(sstring ks_name, sstring cf_name,
             bool load_and_stream, bool primary_replica_only);
 
+    /**
+     * Write a partition-sorted stream of mutations of a table straight into new SSTables
+     *
+     * The mutations are distributed to the shards owning them, each of which writes its part
+     * into SSTables of its own, bypassing the commitlog and memtables. The new SSTables are added
+     * to the table only once all shards are done writing, so a failed load leaves no data behind.
+     *
+     * Only local replicas are written to; tables with materialized views or secondary indexes
+     * are not supported, since their view updates would be skipped.
+     *
+     * @param reader the mutations to load, the table is determined by its schema.
+     * @param estimated_partitions the expected number of partitions, used to size the SSTables' filters.
+     * @return a future<> when the operation finishes.
+     */
+    future<> load_mutations(mutation_reader reader, uint64_t estimated_partitions);
+
     /**
      * Download new SSTables not currently tracked by the system from object store
      */
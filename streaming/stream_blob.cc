@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/coroutine/exception.hh>
+#include <seastar/util/closeable.hh>
+#include <boost/range/adaptor/map.hpp>
+
+#include "streaming/stream_blob.hh"
+#include "streaming/stream_manager.hh"
+#include "message/messaging_service.hh"
+#include "replica/database.hh"
+#include "sstables/sstables.hh"
+#include "idl/streaming.dist.hh"
+#include "utils/log.hh"
+
+namespace streaming {
+
+extern logging::logger sslog;
+
+static constexpr size_t stream_blob_buffer_size = 128 * 1024;
+
+// Sends the file over a STREAM_BLOB stream and waits for the receiver to write it.
+// Returns the number of bytes sent.
+static future<uint64_t> send_blob(netw::messaging_service& ms, netw::msg_addr dst, stream_blob_meta meta, file f) {
+    auto in = make_file_input_stream(std::move(f), file_input_stream_options{
+        .buffer_size = stream_blob_buffer_size,
+        .read_ahead = 4,
+    });
+    auto close_in = deferred_close(in);
+    auto [sink, source] = co_await ms.make_sink_and_source_for_stream_blob(meta, dst);
+    uint64_t sent = 0;
+    std::exception_ptr ex;
+    try {
+        while (auto buf = co_await in.read()) {
+            sent += buf.size();
+            co_await sink(stream_blob_cmd::data, bytes(reinterpret_cast<const bytes::value_type*>(buf.get()), buf.size()));
+        }
+        co_await sink(stream_blob_cmd::end_of_stream, bytes());
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        try {
+            co_await sink(stream_blob_cmd::error, bytes());
+        } catch (...) {
+            // The sink may be broken already, the original error is reported.
+        }
+    }
+    co_await sink.close();
+    if (ex) {
+        co_return coroutine::exception(std::move(ex));
+    }
+    auto status = co_await source();
+    if (!status || std::get<0>(*status) != 0) {
+        throw std::runtime_error(format("[Stream #{}] Receiver {} failed to write {}", meta.ops_id, dst.addr, meta.filename));
+    }
+    co_return sent;
+}
+
+future<stream_files_response> stream_manager::tablet_stream_files(netw::msg_addr dst, stream_files_request req) {
+    auto& table = _db.local().find_column_family(req.table);
+    auto holder = table.async_gate().hold();
+    auto s = table.schema();
+    if (!std::holds_alternative<data_dictionary::storage_options::local>(table.get_storage_options().value)) {
+        sslog.info("[Stream #{}] Table {}.{} is not stored locally, it can't be streamed as files", req.ops_id, s->ks_name(), s->cf_name());
+        co_return stream_files_response{ .streamed = false, .stream_bytes = 0 };
+    }
+
+    auto snapshot = co_await table.take_storage_snapshot(req.range);
+    auto contained = std::ranges::all_of(snapshot, [&] (const sstables::sstable_files_snapshot& f) {
+        return req.range.contains(f.sst->get_first_decorated_key().token(), dht::token_comparator())
+                && req.range.contains(f.sst->get_last_decorated_key().token(), dht::token_comparator());
+    });
+
+    uint64_t bytes_sent = 0;
+    std::exception_ptr ex;
+    if (contained) {
+        sslog.info("[Stream #{}] Streaming {} sstables of {}.{} in range {} to {} as files",
+                req.ops_id, snapshot.size(), s->ks_name(), s->cf_name(), req.range, dst.addr);
+        try {
+            for (auto& f : snapshot) {
+                // The TOC is sent last, so that an sstable whose transfer was interrupted is never complete.
+                auto components = boost::copy_range<std::vector<sstables::component_type>>(f.files | boost::adaptors::map_keys);
+                std::ranges::stable_partition(components, [] (sstables::component_type c) { return c != sstables::component_type::TOC; });
+                for (auto c : components) {
+                    auto meta = stream_blob_meta{
+                        .ops_id = req.ops_id,
+                        .table = req.table,
+                        .filename = f.sst->component_basename(c),
+                        .dst_shard_id = req.dst_shard_id,
+                    };
+                    // The input stream closes the file.
+                    auto n = co_await send_blob(_ms.local(), dst, std::move(meta), std::exchange(f.files[c], file()));
+                    bytes_sent += n;
+                    _total_outgoing_bytes += n;
+                }
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+    } else {
+        sslog.info("[Stream #{}] Some sstables of {}.{} cross range {}, they can't be streamed as files", req.ops_id, s->ks_name(), s->cf_name(), req.range);
+    }
+
+    for (auto& f : snapshot) {
+        for (auto& [c, file] : f.files) {
+            if (file) {
+                co_await file.close();
+            }
+        }
+    }
+    if (ex) {
+        sslog.warn("[Stream #{}] Failed to stream sstables of {}.{} in range {} to {} as files: {}", req.ops_id, s->ks_name(), s->cf_name(), req.range, dst.addr, ex);
+        co_return coroutine::exception(std::move(ex));
+    }
+    co_return stream_files_response{ .streamed = contained, .stream_bytes = bytes_sent };
+}
+
+// Writes the file received over STREAM_BLOB into the upload directory of the table.
+// Returns the status code to be sent back to the sender.
+static future<int32_t> receive_blob(sharded<stream_manager>& sm, replica::database& db, gms::inet_address from,
+        stream_blob_meta meta, rpc::source<stream_blob_cmd, bytes> source, uint64_t& bytes_received) {
+    std::optional<output_stream<char>> out;
+    std::exception_ptr ex;
+    try {
+        auto& table = db.find_column_family(meta.table);
+        auto s = table.schema();
+        auto* local = std::get_if<data_dictionary::storage_options::local>(&table.get_storage_options().value);
+        if (!local) {
+            throw std::runtime_error(format("Table {}.{} is not stored locally", s->ks_name(), s->cf_name()));
+        }
+        auto name = std::filesystem::path(meta.filename);
+        if (name.filename() != name) {
+            throw std::runtime_error(format("Invalid sstable component name {}", meta.filename));
+        }
+        // Throws if it isn't a component of an sstable of the table.
+        sstables::parse_path(name, s->ks_name(), s->cf_name());
+
+        auto dir = local->dir / sstables::upload_dir;
+        co_await recursive_touch_directory(dir.native());
+        auto path = dir / name;
+        // Registered before the file is created, so that a partially written one is removed as well.
+        co_await sm.invoke_on(meta.dst_shard_id, [ops_id = meta.ops_id, path] (stream_manager& sm) {
+            sm.add_received_file(ops_id, path);
+        });
+        auto f = co_await open_file_dma(path.native(), open_flags::wo | open_flags::create | open_flags::exclusive);
+        out = co_await make_file_output_stream(std::move(f), file_output_stream_options{ .buffer_size = stream_blob_buffer_size });
+
+        bool got_end_of_stream = false;
+        while (auto opt = co_await source()) {
+            auto& [cmd, data] = *opt;
+            switch (cmd) {
+            case stream_blob_cmd::data:
+                co_await out->write(reinterpret_cast<const char*>(data.data()), data.size());
+                bytes_received += data.size();
+                break;
+            case stream_blob_cmd::error:
+                throw std::runtime_error("Sender failed");
+            case stream_blob_cmd::end_of_stream:
+                got_end_of_stream = true;
+                break;
+            default:
+                throw std::runtime_error("Sender sent wrong cmd");
+            }
+        }
+        if (!got_end_of_stream) {
+            throw std::runtime_error("Sender did not send end_of_stream");
+        }
+        co_await out->flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (out) {
+        try {
+            co_await out->close();
+        } catch (...) {
+            if (!ex) {
+                ex = std::current_exception();
+            }
+        }
+    }
+    if (ex) {
+        sslog.warn("[Stream #{}] Failed to receive {} from {}: {}", meta.ops_id, meta.filename, from, ex);
+        co_return -1;
+    }
+    co_return 0;
+}
+
+void stream_manager::add_received_file(plan_id ops_id, std::filesystem::path path) {
+    _received_files[ops_id].push_back(std::move(path));
+}
+
+future<> stream_manager::finish_received_files(plan_id ops_id, table_id table, bool failed) {
+    auto it = _received_files.find(ops_id);
+    if (it == _received_files.end()) {
+        co_return;
+    }
+    auto files = std::move(it->second);
+    _received_files.erase(it);
+
+    std::exception_ptr ex;
+    if (!failed) {
+        try {
+            auto& t = _db.local().find_column_family(table);
+            auto s = t.schema();
+            std::vector<sstables::entry_descriptor> descs;
+            for (auto& path : files) {
+                auto desc = sstables::parse_path(path, s->ks_name(), s->cf_name());
+                if (desc.component == sstables::component_type::TOC) {
+                    descs.push_back(std::move(desc));
+                }
+            }
+            sslog.info("[Stream #{}] Loading {} sstables received as files into {}.{}", ops_id, descs.size(), s->ks_name(), s->cf_name());
+            co_await t.load_uploaded_sstables(std::move(descs));
+        } catch (...) {
+            ex = std::current_exception();
+        }
+    }
+    // Whatever was loaded was moved out of the upload directory.
+    for (auto& path : files) {
+        try {
+            co_await remove_file(path.native());
+        } catch (const std::system_error& e) {
+            if (e.code() != std::error_code(ENOENT, std::system_category())) {
+                sslog.warn("[Stream #{}] Failed to remove {}: {}", ops_id, path, e);
+            }
+        }
+    }
+    if (ex) {
+        co_return coroutine::exception(std::move(ex));
+    }
+}
+
+void stream_manager::init_stream_blob_handlers() {
+    auto& ms = _ms.local();
+    ms.register_stream_blob([this] (const rpc::client_info& cinfo, stream_blob_meta meta, rpc::source<stream_blob_cmd, bytes> source) {
+        auto from = netw::messaging_service::get_source(cinfo).addr;
+        auto sink = _ms.local().make_sink_for_stream_blob(source);
+        // The file is written in the background, the sender waits for the status code.
+        (void)do_with(uint64_t(0), [this, from, meta = std::move(meta), source = std::move(source), sink] (uint64_t& bytes_received) mutable {
+            return receive_blob(container(), _db.local(), from, std::move(meta), std::move(source), bytes_received).then([this, sink, &bytes_received] (int32_t status) mutable {
+                _total_incoming_bytes += bytes_received;
+                return sink(status).finally([sink] () mutable {
+                    return sink.close();
+                });
+            });
+        }).handle_exception([from] (std::exception_ptr ep) {
+            sslog.debug("Failed to respond to STREAM_BLOB from {}: {}", from, ep);
+        });
+        return make_ready_future<rpc::sink<int32_t>>(sink);
+    });
+    ser::streaming_rpc_verbs::register_tablet_stream_files(&ms, [this] (const rpc::client_info& cinfo, stream_files_request req) {
+        auto from = netw::messaging_service::get_source(cinfo);
+        return container().invoke_on(req.src_shard_id, [dst = netw::msg_addr(from.addr), req = std::move(req)] (stream_manager& sm) mutable {
+            return sm.tablet_stream_files(dst, std::move(req));
+        });
+    });
+}
+
+future<> stream_manager::uninit_stream_blob_handlers() {
+    auto& ms = _ms.local();
+    co_await ms.unregister_stream_blob();
+    co_await ser::streaming_rpc_verbs::unregister_tablet_stream_files(&ms);
+}
+
+} // namespace streaming
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "dht/i_partitioner_fwd.hh"
+#include "dht/token.hh"
+#include "schema/schema_fwd.hh"
+#include "streaming/stream_fwd.hh"
+
+// File-based streaming of tablets.
+//
+// Instead of reading the sstables of a migrating tablet into mutation fragments
+// on the leaving replica and writing them again on the pending one, the pending
+// replica asks the leaving one (TABLET_STREAM_FILES) to send it the component
+// files of the tablet's sstables as they are. The leaving replica flushes the
+// tablet and sends each component file of each sstable which lies within the
+// tablet range over a STREAM_BLOB rpc stream, the TOC last. The pending replica
+// writes them into the upload directory of the table and, once all were
+// received, picks the sstables up from there the way refresh does and adds
+// them to the table.
+//
+// If some sstable crosses the tablet range, e.g. because the tablet was split
+// but not all of its sstables yet, nothing is sent and the tablet is streamed
+// as mutations instead.
+
+namespace streaming {
+
+enum class stream_blob_cmd : uint8_t {
+    error,
+    data,
+    end_of_stream,
+};
+
+// Identifies the file sent over a STREAM_BLOB stream.
+struct stream_blob_meta {
+    plan_id ops_id;
+    ::table_id table;
+    // Basename of the sstable component file.
+    sstring filename;
+    // The shard of the pending replica, which loads the sstables.
+    uint32_t dst_shard_id;
+};
+
+struct stream_files_request {
+    plan_id ops_id;
+    ::table_id table;
+    dht::token_range range;
+    uint32_t src_shard_id;
+    uint32_t dst_shard_id;
+};
+
+struct stream_files_response {
+    // False if the files can't be streamed and the range has to be streamed as mutations.
+    bool streamed;
+    uint64_t stream_bytes;
+};
+
+} // namespace streaming
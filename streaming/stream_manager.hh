@@ -12,6 +12,8 @@
 #include "streaming/stream_fwd.hh"
 #include "streaming/progress_info.hh"
 #include "streaming/stream_reason.hh"
+#include "streaming/stream_blob.hh"
+#include "message/msg_addr.hh"
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/distributed.hh>
 #include "utils/updateable_value.hh"
@@ -96,6 +98,8 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
     semaphore _mutation_send_limiter{256};
     seastar::metrics::metric_groups _metrics;
     std::unordered_map<streaming::stream_reason, float> _finished_percentage;
+    // Files received over STREAM_BLOB for the sstables to be loaded on this shard, by operation.
+    std::unordered_map<plan_id, std::vector<std::filesystem::path>> _received_files;
 
     scheduling_group _streaming_group;
     utils::updateable_value<uint32_t> _io_throughput_mbs;
@@ -170,6 +174,14 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
 
     std::function<future<>(mutation_reader)> make_streaming_consumer(
             uint64_t estimated_partitions, stream_reason, service::frozen_topology_guard);
+
+    // File-based streaming of tablets, see stream_blob.hh.
+    //
+    // Sends the sstables of the table in the requested range on this shard to dst as files.
+    future<stream_files_response> tablet_stream_files(netw::msg_addr dst, stream_files_request req);
+    // Adds the sstables received for the operation on this shard to the table, or removes
+    // their files if failed is set.
+    future<> finish_received_files(plan_id ops_id, table_id table, bool failed);
 public:
     virtual future<> on_join(inet_address endpoint, endpoint_state_ptr ep_state, gms::permit_id) override { return make_ready_future(); }
     virtual future<> on_change(gms::inet_address, const gms::application_state_map& states, gms::permit_id) override  { return make_ready_future(); }
@@ -185,10 +197,14 @@ class stream_manager : public gms::i_endpoint_state_change_subscriber, public en
 
     void init_messaging_service_handler(abort_source& as);
     future<> uninit_messaging_service_handler();
+    void init_stream_blob_handlers();
+    future<> uninit_stream_blob_handlers();
     future<> update_io_throughput(uint32_t value_mbs);
 
 public:
     void update_finished_percentage(streaming::stream_reason reason, float percentage);
+    // Registers a file received over STREAM_BLOB for the operation on this shard.
+    void add_received_file(plan_id ops_id, std::filesystem::path path);
 };
 
 } // namespace streaming
@@ -274,6 +274,7 @@ void stream_manager::init_messaging_service_handler(abort_source& as) {
             return make_ready_future<>();
         }
     });
+    init_stream_blob_handlers();
 }
 
 future<> stream_manager::uninit_messaging_service_handler() {
@@ -283,7 +284,8 @@ future<> stream_manager::uninit_messaging_service_handler() {
         ms.unregister_prepare_done_message(),
         ms.unregister_stream_mutation_fragments(),
         ms.unregister_stream_mutation_done(),
-        ms.unregister_complete_message()).discard_result();
+        ms.unregister_complete_message(),
+        uninit_stream_blob_handlers()).discard_result();
 }
 
 stream_session::stream_session(stream_manager& mgr, inet_address peer_)
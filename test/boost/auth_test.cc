@@ -171,6 +171,21 @@ SEASTAR_TEST_CASE(test_password_authenticator_operations) {
     }, auth_on(false));
 }
 
+SEASTAR_TEST_CASE(test_verified_credentials_follow_password_changes) {
+    return do_with_cql_env_thread([] (cql_test_env& env) {
+        cquery_nofail(env, "CREATE ROLE fisk WITH PASSWORD = 'notter' AND LOGIN = true");
+        // The second time is served by the verified credentials.
+        authenticate(env, "fisk", "notter").get();
+        authenticate(env, "fisk", "notter").get();
+        require_throws<exceptions::authentication_exception>(authenticate(env, "fisk", "hejkotte")).get();
+
+        cquery_nofail(env, "ALTER ROLE fisk WITH PASSWORD = 'hejkotte'");
+        require_throws<exceptions::authentication_exception>(authenticate(env, "fisk", "notter")).get();
+        authenticate(env, "fisk", "hejkotte").get();
+        authenticate(env, "fisk", "hejkotte").get();
+    }, auth_on(false));
+}
+
 namespace {
 
 /// Asserts that table is protected from alterations that can brick a node.
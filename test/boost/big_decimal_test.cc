@@ -176,6 +176,8 @@ BOOST_AUTO_TEST_CASE(test_big_decimal_add) {
     test_add("-1.0", "-1.000", "-2.000");
     test_add("0000123456789012345678901234", "19e3", "00123456789012345678920234");
     test_add("000000000012345678901234.5678901234e-1", "0777.555555555555555555555e2", "1234567967879.0123445678955555555");
+    test_add("1e-25", "1", "1.0000000000000000000000001");
+    test_add("1", "1e-25", "1.0000000000000000000000001");
 }
 
 BOOST_AUTO_TEST_CASE(test_big_decimal_assignsub) {
@@ -188,6 +190,8 @@ BOOST_AUTO_TEST_CASE(test_big_decimal_assignsub) {
     test_assignsub("0.0", "0.000", "0.000");
     test_assignsub("1.0", "1.000", "0.000");
     test_assignsub("-1.0", "1.000", "-2.000");
+    test_assignsub("2.5", "1e-20", "2.49999999999999999999");
+    test_assignsub("1e-20", "2.5", "-2.49999999999999999999");
 }
 
 BOOST_AUTO_TEST_CASE(test_big_decimal_sub) {
@@ -14,6 +14,7 @@
 #include "test/lib/sstable_utils.hh"
 
 #include "readers/from_mutations_v2.hh"
+#include "schema/schema_builder.hh"
 #include "utils/bloom_filter.hh"
 #include "utils/error_injection.hh"
 
@@ -109,6 +110,32 @@ SEASTAR_TEST_CASE(test_sstable_manager_auto_reclaim_and_reload_of_bloom_filter)
     });
 }
 
+SEASTAR_TEST_CASE(test_sstable_manager_reclaims_bloom_filter_of_cold_table) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema hot("ks", "hot");
+        simple_schema cold("ks", "cold");
+        auto& sst_mgr = env.manager();
+
+        auto [hot_sst, hot_bf_memory] = create_sstable_with_bloom_filter(env, sst_mgr, hot.schema(), 70);
+        for (auto& pk : hot.make_pkeys(10)) {
+            hot_sst->filter_has_key(*hot.schema(), pk);
+        }
+        auto [cold_sst, cold_bf_memory] = create_sstable_with_bloom_filter(env, sst_mgr, cold.schema(), 20);
+        BOOST_REQUIRE_EQUAL(sst_mgr.get_total_memory_reclaimed(), 0);
+
+        // Crossing the threshold reclaims the filter of the cold table, even
+        // though the sstable of the hot table has the larger filter.
+        auto [cold_sst2, cold_bf_memory2] = create_sstable_with_bloom_filter(env, sst_mgr, cold.schema(), 50);
+        BOOST_REQUIRE_EQUAL(hot_sst->filter_memory_size(), hot_bf_memory);
+        BOOST_REQUIRE_EQUAL(cold_sst->filter_memory_size(), cold_bf_memory);
+        BOOST_REQUIRE_EQUAL(cold_sst2->filter_memory_size(), 0);
+        BOOST_REQUIRE_EQUAL(sst_mgr.get_total_memory_reclaimed(), cold_bf_memory2);
+    }, {
+        // this will set the reclaim threshold to 100 bytes.
+        .available_memory = 500
+    });
+}
+
 // Reproducer for https://github.com/scylladb/scylladb/issues/18398.
 SEASTAR_TEST_CASE(test_reclaimed_bloom_filter_deletion_from_disk) {
     return test_env::do_with_async([] (test_env& env) {
@@ -283,3 +310,161 @@ SEASTAR_TEST_CASE(test_bloom_filter_reload_after_unlink) {
         .available_memory = 0
     });
 };
+
+SEASTAR_TEST_CASE(test_deferred_bloom_filter_loading) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto schema = ss.schema();
+        auto pks = ss.make_pkeys(10);
+
+        std::vector<mutation> muts;
+        for (auto& pk : pks) {
+            auto mut = mutation(schema, pk);
+            mut.partition().apply_insert(*schema, ss.make_ckey(0), ss.new_timestamp());
+            muts.push_back(std::move(mut));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(schema), std::move(muts));
+        auto bf_memory = sst->filter_memory_size();
+        BOOST_REQUIRE_GT(bf_memory, 0);
+
+        auto& sst_mgr = env.manager();
+        auto reclaimable_memory = sst_mgr.get_total_reclaimable_memory();
+        auto deferred_sst = env.reusable_sst(schema, env.tempdir().path().native(), sst->generation(), sst->get_version(),
+                sstable::format_types::big, { .defer_bloom_filter_loading = true }).get();
+
+        // The filter is loaded in the background by the components reloader.
+        REQUIRE_EVENTUALLY_EQUAL(deferred_sst->filter_memory_size(), bf_memory);
+        REQUIRE_EVENTUALLY_EQUAL(sst_mgr.get_total_memory_reclaimed(), 0);
+        BOOST_REQUIRE_EQUAL(sst_mgr.get_total_reclaimable_memory(), reclaimable_memory + bf_memory);
+        BOOST_REQUIRE(sst_mgr.get_reclaimed_set().empty());
+        for (auto& pk : pks) {
+            BOOST_REQUIRE(deferred_sst->filter_has_key(*schema, pk));
+        }
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_split_block_bloom_filter) {
+    constexpr int nr_keys = 10000;
+    constexpr double fp_chance = 0.01;
+    auto key = [] (int i) {
+        return to_bytes(format("key{}", i));
+    };
+
+    auto f = utils::i_filter::get_filter(nr_keys, fp_chance, utils::filter_format::m_format, utils::filter_layout::split_block);
+    auto& sbf = dynamic_cast<utils::filter::bloom_filter&>(*f);
+    BOOST_REQUIRE(sbf.layout() == utils::filter_layout::split_block);
+    BOOST_REQUIRE_EQUAL(sbf.bits().size() % utils::filter::split_block_bloom_filter::bits_per_block, 0);
+    BOOST_REQUIRE_EQUAL(sbf.bits().size() / 8,
+            utils::i_filter::get_filter_size(nr_keys, fp_chance, utils::filter_layout::split_block));
+
+    for (int i = 0; i < nr_keys; ++i) {
+        f->add(key(i));
+    }
+    for (int i = 0; i < nr_keys; ++i) {
+        BOOST_REQUIRE(f->is_present(key(i)));
+        BOOST_REQUIRE(f->is_present(utils::make_hashed_key(key(i))));
+    }
+
+    int false_positives = 0;
+    for (int i = nr_keys; i < 11 * nr_keys; ++i) {
+        false_positives += f->is_present(key(i));
+    }
+    // Allow for some slack over the requested rate.
+    BOOST_REQUIRE_LT(double(false_positives) / (10 * nr_keys), 2 * fp_chance);
+
+    // Reloading the bits gives back an equivalent filter.
+    auto& storage = sbf.bits().get_storage();
+    auto copy = utils::chunked_vector<uint64_t>(storage.begin(), storage.end());
+    auto reloaded = utils::filter::create_split_block_filter(large_bitset(sbf.bits().size(), std::move(copy)), utils::filter_format::m_format);
+    for (int i = 0; i < nr_keys; ++i) {
+        BOOST_REQUIRE(reloaded->is_present(key(i)));
+    }
+}
+
+SEASTAR_TEST_CASE(test_split_block_bloom_filter_persistence) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = schema_builder(ss.schema()).set_bloom_filter_layout(utils::filter_layout::split_block).build();
+        BOOST_REQUIRE(s->bloom_filter_layout() == utils::filter_layout::split_block);
+
+        auto pks = ss.make_pkeys(100);
+        std::vector<mutation> muts;
+        for (auto& pk : pks) {
+            auto m = mutation(s, pk);
+            m.partition().apply_insert(*s, ss.make_ckey(0), ss.new_timestamp());
+            muts.push_back(std::move(m));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(s), muts);
+        auto reopened = env.reusable_sst(s, sst).get();
+        for (auto& pk : pks) {
+            BOOST_REQUIRE(reopened->filter_has_key(*s, pk.key()));
+        }
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(test_xor_filter) {
+    constexpr int nr_keys = 10000;
+    constexpr double fp_chance = 0.01;
+    // Keys are added in token order, as the sstable writer does.
+    std::vector<bytes> keys;
+    for (int i = 0; i < 11 * nr_keys; ++i) {
+        keys.push_back(to_bytes(format("key{}", i)));
+    }
+    auto token_less = [] (const bytes& a, const bytes& b) {
+        return int64_t(utils::make_hashed_key(a).hash()[0]) < int64_t(utils::make_hashed_key(b).hash()[0]);
+    };
+    std::sort(keys.begin(), keys.begin() + nr_keys, token_less);
+
+    auto f = utils::i_filter::get_filter(nr_keys, fp_chance, utils::filter_format::m_format, utils::filter_layout::xor_filter);
+    auto& xf = dynamic_cast<utils::filter::bloom_filter&>(*f);
+    BOOST_REQUIRE(xf.layout() == utils::filter_layout::xor_filter);
+
+    for (int i = 0; i < nr_keys; ++i) {
+        f->add(keys[i]);
+    }
+    // Nothing is missed before the filter is complete.
+    BOOST_REQUIRE(f->is_present(keys[nr_keys]));
+    f->finish();
+    for (int i = 0; i < nr_keys; ++i) {
+        BOOST_REQUIRE(f->is_present(keys[i]));
+        BOOST_REQUIRE(f->is_present(utils::make_hashed_key(keys[i])));
+    }
+
+    int false_positives = 0;
+    for (int i = nr_keys; i < 11 * nr_keys; ++i) {
+        false_positives += f->is_present(keys[i]);
+    }
+    BOOST_REQUIRE_LT(double(false_positives) / (10 * nr_keys), 2 * fp_chance);
+
+    // Smaller than the classic bloom filter with the same false-positive chance.
+    BOOST_REQUIRE_LT(xf.bits().memory_size(), utils::i_filter::get_filter_size(nr_keys, fp_chance));
+
+    // Reloading the bits gives back an equivalent filter.
+    auto& storage = xf.bits().get_storage();
+    auto copy = utils::chunked_vector<uint64_t>(storage.begin(), storage.end());
+    auto reloaded = utils::filter::create_xor_filter(xf.num_hashes(), large_bitset(xf.bits().size(), std::move(copy)));
+    for (int i = 0; i < nr_keys; ++i) {
+        BOOST_REQUIRE(reloaded->is_present(keys[i]));
+    }
+}
+
+SEASTAR_TEST_CASE(test_xor_filter_persistence) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = schema_builder(ss.schema()).set_bloom_filter_layout(utils::filter_layout::xor_filter).build();
+        BOOST_REQUIRE(s->bloom_filter_layout() == utils::filter_layout::xor_filter);
+
+        auto pks = ss.make_pkeys(100);
+        std::vector<mutation> muts;
+        for (auto& pk : pks) {
+            auto m = mutation(s, pk);
+            m.partition().apply_insert(*s, ss.make_ckey(0), ss.new_timestamp());
+            muts.push_back(std::move(m));
+        }
+        auto sst = make_sstable_containing(env.make_sstable(s), muts);
+        auto reopened = env.reusable_sst(s, sst).get();
+        for (auto& pk : pks) {
+            BOOST_REQUIRE(reopened->filter_has_key(*s, pk.key()));
+        }
+    });
+}
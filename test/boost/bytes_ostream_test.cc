@@ -335,3 +335,18 @@ BOOST_AUTO_TEST_CASE(test_conversion_to_managed_bytes) {
     buf2.write(to_bytes(mb));
     assert_sequence(buf2, 1024);
 }
+
+BOOST_AUTO_TEST_CASE(test_reserve) {
+    bytes_ostream buf;
+    buf.reserve(10 * 1024);
+    for (int i = 0; i < 10; ++i) {
+        buf.write(bytes(bytes::initialized_later(), 1024));
+    }
+    BOOST_REQUIRE_EQUAL(buf.size(), 10 * 1024);
+    BOOST_REQUIRE(buf.is_linearized());
+
+    bytes_ostream big;
+    big.reserve(1'000'000);
+    append_sequence(big, 1'000'000 / sizeof(int));
+    assert_sequence(big, 1'000'000 / sizeof(int));
+}
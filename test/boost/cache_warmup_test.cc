@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "test/lib/scylla_test_case.hh"
+#include "test/lib/cql_test_env.hh"
+#include "test/lib/eventually.hh"
+#include "test/lib/tmpdir.hh"
+
+#include "db/cache_warmup.hh"
+#include "db/hot_key_sampler.hh"
+#include "replica/database.hh"
+
+SEASTAR_TEST_CASE(test_cache_warmup_save_and_replay) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t (k int, c int, v int, PRIMARY KEY (k, c));").get();
+        e.execute_cql("INSERT INTO t (k, c, v) VALUES (1, 1, 1);").get();
+        e.execute_cql("INSERT INTO t (k, c, v) VALUES (2, 1, 1);").get();
+        auto id = e.local_db().find_uuid("ks", "t");
+        replica::database::flush_table_on_all_shards(e.db(), id).get();
+
+        // Only partition 1 is hot.
+        for (unsigned i = 0; i < 4 * db::hot_key_sampler::sample_period; ++i) {
+            e.execute_cql("SELECT * FROM t WHERE k = 1;").get();
+        }
+
+        auto s = e.local_db().find_schema(id);
+        auto key_of = [&] (int32_t k) {
+            return dht::decorate_key(*s, partition_key::from_singular(*s, k));
+        };
+        auto is_resident_on_all_shards = [&] (int32_t k) {
+            return e.db().map_reduce0([id, dk = key_of(k)] (replica::database& db) {
+                auto& t = db.find_column_family(id);
+                return t.shard_for_reads(dk.token()) != this_shard_id()
+                        || t.get_row_cache().is_resident(dk, query::clustering_row_ranges{query::full_clustering_range}, true);
+            }, true, std::logical_and<bool>()).get();
+        };
+
+        tmpdir dir;
+        auto cfg = db::cache_warmup::config{
+            .directory = dir.path(),
+            .save_period = std::chrono::hours(1),
+            .scheduling_group = default_scheduling_group(),
+        };
+        sharded<db::cache_warmup> saver;
+        saver.start(std::ref(e.db()), cfg).get();
+        saver.invoke_on_all(&db::cache_warmup::save).get();
+        saver.stop().get();
+
+        e.db().invoke_on_all([id] (replica::database& db) {
+            db.find_column_family(id).get_row_cache().evict();
+        }).get();
+        BOOST_REQUIRE(!is_resident_on_all_shards(1));
+
+        sharded<db::cache_warmup> warmup;
+        warmup.start(std::ref(e.db()), cfg).get();
+        warmup.invoke_on_all(&db::cache_warmup::start).get();
+        BOOST_REQUIRE(eventually_true([&] { return is_resident_on_all_shards(1); }));
+        BOOST_REQUIRE(!is_resident_on_all_shards(2));
+        warmup.stop().get();
+    });
+}
@@ -45,3 +45,27 @@ BOOST_AUTO_TEST_CASE(test_cartesian_product) {
         {2, 3, 5}
     }));
 }
+
+BOOST_AUTO_TEST_CASE(test_cartesian_product_reuses_element) {
+    using vec = std::vector<std::vector<std::string>>;
+    auto product = vec({{"a", "b"}, {"c"}, {"d", "e", "f"}});
+    auto cp = make_cartesian_product(product);
+    auto it = cp.begin();
+    // Dereferencing twice gives the same element.
+    BOOST_REQUIRE(*it == std::vector<std::string>({"a", "c", "d"}));
+    BOOST_REQUIRE(*it == std::vector<std::string>({"a", "c", "d"}));
+    ++it;
+    BOOST_REQUIRE(*it == std::vector<std::string>({"a", "c", "e"}));
+    ++it;
+    // An element can be skipped without being dereferenced.
+    ++it;
+    BOOST_REQUIRE(*it == std::vector<std::string>({"b", "c", "d"}));
+    ++it;
+    ++it;
+    BOOST_REQUIRE(*it == std::vector<std::string>({"b", "c", "f"}));
+    ++it;
+    BOOST_REQUIRE(it == cp.end());
+
+    auto empty = vec({{"a", "b"}, {}});
+    BOOST_REQUIRE(to_vec(make_cartesian_product(empty)).empty());
+}
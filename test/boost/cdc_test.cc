@@ -15,6 +15,9 @@
 
 #include "cdc/log.hh"
 #include "cdc/cdc_options.hh"
+#include "cdc/stats.hh"
+#include "replica/database.hh"
+#include "service/storage_proxy.hh"
 #include "schema/schema_builder.hh"
 #include "test/lib/cql_assertions.hh"
 #include "test/lib/cql_test_env.hh"
@@ -628,6 +631,48 @@ SEASTAR_THREAD_TEST_CASE(test_pre_post_image_logging) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_preimage_served_from_cache) {
+    do_with_cql_env_thread([](cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE ks.tbl (pk int, ck int, val int, PRIMARY KEY(pk, ck)) "
+                "WITH cdc = {'enabled':'true', 'preimage':'true', 'preimage_source':'cache'}");
+        auto& stats = e.get_storage_proxy().local().get_cdc_stats().counters_total;
+        const auto hits = stats.preimage_cache_hits;
+        const auto misses = stats.preimage_cache_misses;
+
+        // The cache of a new table knows that it's empty.
+        cquery_nofail(e, "INSERT INTO ks.tbl(pk, ck, val) VALUES(1, 1, 1)");
+        cquery_nofail(e, "UPDATE ks.tbl SET val = 2 WHERE pk = 1 AND ck = 1");
+        auto rows = select_log(e, "tbl");
+        auto val_index = column_index(*rows, cdc::log_data_column_name("val"));
+        auto pre_image = to_bytes_filtered(*rows, cdc::operation::pre_image);
+        BOOST_REQUIRE_EQUAL(pre_image.size(), 1);
+        BOOST_REQUIRE_EQUAL(int32_type->decompose(1), *pre_image[0][val_index]);
+        BOOST_REQUIRE(to_bytes_filtered(*rows, cdc::operation::pre_image_unknown).empty());
+        BOOST_REQUIRE_EQUAL(stats.preimage_cache_hits, hits + 2);
+        BOOST_REQUIRE_EQUAL(stats.preimage_cache_misses, misses);
+
+        // Once the data is only in sstables, the preimage is recorded as unknown.
+        e.db().invoke_on_all([] (replica::database& db) -> future<> {
+            auto& cf = db.find_column_family("ks", "tbl");
+            co_await cf.flush();
+            co_await cf.get_row_cache().invalidate(row_cache::external_updater([] {}));
+        }).get();
+        cquery_nofail(e, "UPDATE ks.tbl SET val = 3 WHERE pk = 1 AND ck = 1");
+        rows = select_log(e, "tbl");
+        BOOST_REQUIRE_EQUAL(to_bytes_filtered(*rows, cdc::operation::pre_image).size(), 1);
+        BOOST_REQUIRE_EQUAL(to_bytes_filtered(*rows, cdc::operation::pre_image_unknown).size(), 1);
+        BOOST_REQUIRE_EQUAL(stats.preimage_cache_misses, misses + 1);
+
+        // Reading the partition brings it back to cache.
+        cquery_nofail(e, "SELECT * FROM ks.tbl WHERE pk = 1");
+        cquery_nofail(e, "UPDATE ks.tbl SET val = 4 WHERE pk = 1 AND ck = 1");
+        rows = select_log(e, "tbl");
+        pre_image = to_bytes_filtered(*rows, cdc::operation::pre_image);
+        BOOST_REQUIRE_EQUAL(pre_image.size(), 2);
+        BOOST_REQUIRE_EQUAL(stats.preimage_cache_misses, misses + 1);
+    }).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_pre_post_image_logging_static_row) {
     do_with_cql_env_thread([](cql_test_env& e) {
         auto test = [&e] (bool enabled, bool with_ttl) {
@@ -46,6 +46,8 @@
 #include "test/lib/mutation_source_test.hh"
 #include "test/lib/key_utils.hh"
 #include "test/lib/test_utils.hh"
+#include "test/lib/random_utils.hh"
+#include "schema/schema_builder.hh"
 
 using namespace db;
 
@@ -624,8 +626,7 @@ SEASTAR_TEST_CASE(test_commitlog_chunk_corruption3){
     });
 }
 
-SEASTAR_TEST_CASE(test_commitlog_replay_single_large_mutation){
-    commitlog::config cfg;
+static future<> test_commitlog_replay_single_large_mutation(commitlog::config cfg) {
     cfg.commitlog_segment_size_in_mb = 4;
     cfg.commitlog_total_space_in_mb = 2 * cfg.commitlog_segment_size_in_mb * smp::count;
     cfg.allow_going_over_size_limit = false;
@@ -681,6 +682,18 @@ SEASTAR_TEST_CASE(test_commitlog_replay_single_large_mutation){
     });
 }
 
+SEASTAR_TEST_CASE(test_commitlog_replay_single_large_mutation){
+    return test_commitlog_replay_single_large_mutation(commitlog::config{});
+}
+
+// The large mutation spans many buffer fragments, all of which are written
+// in a single submission.
+SEASTAR_TEST_CASE(test_commitlog_replay_single_large_mutation_vectored_writes){
+    commitlog::config cfg;
+    cfg.use_vectored_writes = true;
+    return test_commitlog_replay_single_large_mutation(cfg);
+}
+
 /**
  * Checks same thing as above, but will also ensure the seek mechanism in 
  * replayer is working, since we will span multiple chunks.
@@ -1102,6 +1115,62 @@ SEASTAR_TEST_CASE(test_commitlog_add_entries) {
 
 // #16298 - check entry offsets so that we report the correct file positions both
 // when reading and writing CL data.
+SEASTAR_TEST_CASE(test_commitlog_compressed_entries) {
+    commitlog::config cfg;
+    cfg.entry_compression_threshold = 4096;
+    return cl_test(cfg, [](commitlog& log) {
+        return seastar::async([&] {
+            auto s = schema_builder("ks", "cf")
+                .with_column("pk", bytes_type, column_kind::partition_key)
+                .with_column("v", bytes_type)
+                .build();
+            auto make_mutation = [&] (size_t value_size, bool compressible) {
+                bytes value(bytes::initialized_later(), value_size);
+                for (auto& b : value) {
+                    b = compressible ? 'a' : tests::random::get_int<int>(-128, 127);
+                }
+                auto md = tests::data_model::mutation_description({to_bytes(format("key{}", value_size))});
+                md.add_clustered_cell({}, "v", std::move(value));
+                return freeze(md.build(s));
+            };
+
+            // Large and compressible, small, and large but incompressible.
+            std::vector<frozen_mutation> mutations;
+            mutations.emplace_back(make_mutation(512 * 1024, true));
+            mutations.emplace_back(make_mutation(100, true));
+            mutations.emplace_back(make_mutation(64 * 1024, false));
+            const bool expect_compressed[] = { true, false, false };
+
+            std::vector<replay_position> rps;
+            for (size_t i = 0; i < mutations.size(); ++i) {
+                commitlog_entry_writer w(s, mutations[i], db::commitlog::force_sync::no);
+                w.set_compression_threshold(cfg.entry_compression_threshold);
+                w.set_with_schema(true);
+                BOOST_REQUIRE_EQUAL(w.compressed(), expect_compressed[i]);
+                if (w.compressed()) {
+                    BOOST_REQUIRE_LT(w.size(), mutations[i].representation().size() / 10);
+                }
+                rps.emplace_back(log.add_entry(s->id(), w, db::timeout_clock::now() + 60s).get().release());
+            }
+
+            log.sync_all_segments().get();
+            size_t n = 0;
+            for (auto& seg : log.get_active_segment_names()) {
+                db::commitlog::read_log_file(seg, db::commitlog::descriptor::FILENAME_PREFIX, [&](db::commitlog::buffer_and_replay_position buf_rp) {
+                    auto i = std::ranges::find(rps, buf_rp.position);
+                    BOOST_REQUIRE(i != rps.end());
+                    commitlog_entry_reader r(buf_rp.buffer);
+                    BOOST_REQUIRE(r.get_column_mapping());
+                    BOOST_CHECK_EQUAL(r.mutation().unfreeze(s), mutations.at(i - rps.begin()).unfreeze(s));
+                    ++n;
+                    return make_ready_future<>();
+                }).get();
+            }
+            BOOST_CHECK_EQUAL(n, mutations.size());
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_commitlog_entry_offsets) {
     commitlog::config cfg;
     cfg.commitlog_segment_size_in_mb = 1;
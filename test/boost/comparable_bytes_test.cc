@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+
+#include "test/lib/random_utils.hh"
+
+#include "clustering_bounds_comparator.hh"
+#include "keys.hh"
+#include "schema/schema_builder.hh"
+#include "types/comparable_bytes.hh"
+
+// Returns a random value of the type, small enough to make equal values
+// (and so the comparison of the next components) likely.
+static bytes random_value(const abstract_type& type) {
+    if (tests::random::with_probability(0.1)) {
+        return bytes();
+    }
+    const abstract_type& t = type.is_reversed() ? *static_cast<const reversed_type_impl&>(type).underlying_type() : type;
+    switch (t.get_kind()) {
+    case abstract_type::kind::boolean:
+        return t.decompose(tests::random::get_bool());
+    case abstract_type::kind::int32:
+        return t.decompose(tests::random::get_int<int32_t>(-3, 3));
+    case abstract_type::kind::long_kind:
+        return t.decompose(tests::random::get_int<int64_t>(-3, 3) * (int64_t(1) << 40));
+    case abstract_type::kind::bytes: {
+        // Zero bytes are escaped by the encoding, make them common.
+        bytes b(bytes::initialized_later(), tests::random::get_int<size_t>(0, 3));
+        for (auto& c : b) {
+            c = tests::random::get_int<int>(-1, 1);
+        }
+        return b;
+    }
+    default:
+        BOOST_FAIL(format("unexpected type {}", t.name()));
+        return bytes();
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_clustering_prefix_encoding_preserves_order) {
+    auto s = schema_builder("ks", "cf")
+        .with_column("pk", int32_type, column_kind::partition_key)
+        .with_column("ck1", int32_type, column_kind::clustering_key)
+        .with_column("ck2", reversed_type_impl::get_instance(bytes_type), column_kind::clustering_key)
+        .with_column("ck3", bytes_type, column_kind::clustering_key)
+        .with_column("ck4", reversed_type_impl::get_instance(long_type), column_kind::clustering_key)
+        .with_column("ck5", boolean_type, column_kind::clustering_key)
+        .with_column("v", int32_type)
+        .build();
+    auto& type = *s->clustering_key_prefix_type();
+    BOOST_REQUIRE(comparable_bytes::is_supported(type.types()));
+
+    struct position {
+        clustering_key_prefix prefix;
+        int weight;
+        managed_bytes encoded;
+    };
+    std::vector<position> positions;
+    for (int i = 0; i < 500; ++i) {
+        std::vector<bytes> components;
+        auto size = tests::random::get_int<size_t>(0, type.types().size());
+        for (size_t j = 0; j < size; ++j) {
+            components.push_back(random_value(*type.types()[j]));
+        }
+        auto prefix = clustering_key_prefix::from_exploded(*s, components);
+        auto weight = size == type.types().size() ? 0 : tests::random::get_int(-1, 1);
+        auto encoded = comparable_bytes::encode_clustering_prefix(type, prefix.representation(), weight);
+        positions.push_back(position{std::move(prefix), weight, std::move(encoded)});
+    }
+
+    bound_view::tri_compare cmp(*s);
+    for (auto& a : positions) {
+        for (auto& b : positions) {
+            auto expected = cmp(a.prefix, a.weight, b.prefix, b.weight);
+            auto actual = compare_unsigned(managed_bytes_view(a.encoded), managed_bytes_view(b.encoded));
+            if (actual != expected) {
+                BOOST_FAIL(format("{} (weight {}) vs {} (weight {}): the encodings are ordered differently",
+                        a.prefix, a.weight, b.prefix, b.weight));
+            }
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_partition_key_encoding_preserves_order) {
+    auto s = schema_builder("ks", "cf")
+        .with_column("pk1", bytes_type, column_kind::partition_key)
+        .with_column("pk2", int32_type, column_kind::partition_key)
+        .with_column("v", int32_type)
+        .build();
+    auto& type = *s->partition_key_type();
+    BOOST_REQUIRE(comparable_bytes::is_supported(type.types()));
+
+    std::vector<std::pair<partition_key, managed_bytes>> keys;
+    for (int i = 0; i < 200; ++i) {
+        auto key = partition_key::from_exploded(*s, {random_value(*bytes_type), random_value(*int32_type)});
+        auto encoded = comparable_bytes::encode_partition_key(type, key.representation());
+        keys.emplace_back(std::move(key), std::move(encoded));
+    }
+
+    partition_key::tri_compare cmp(*s);
+    for (auto& [k1, e1] : keys) {
+        for (auto& [k2, e2] : keys) {
+            BOOST_REQUIRE(cmp(k1, k2) == compare_unsigned(managed_bytes_view(e1), managed_bytes_view(e2)));
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_unsupported_types) {
+    BOOST_REQUIRE(comparable_bytes::is_supported(*reversed_type_impl::get_instance(utf8_type)));
+    BOOST_REQUIRE(!comparable_bytes::is_supported(*timeuuid_type));
+    BOOST_REQUIRE(!comparable_bytes::is_supported(*reversed_type_impl::get_instance(decimal_type)));
+    BOOST_REQUIRE(!comparable_bytes::is_supported(std::vector<data_type>{int32_type, double_type}));
+}
@@ -11,6 +11,8 @@
 #include <boost/test/unit_test.hpp>
 
 #include "sstables/compress.hh"
+#include "compress.hh"
+#include "message/rpc_zstd_compressor.hh"
 
 BOOST_AUTO_TEST_CASE(segmented_offsets_basic_functionality) {
     sstables::compression::segmented_offsets offsets;
@@ -143,3 +145,137 @@ BOOST_AUTO_TEST_CASE(segmented_offsets_corner_cases) {
     BOOST_REQUIRE(accessor.at(4079) == 4079);
     BOOST_REQUIRE(accessor.at(4080) == 4080);
 }
+
+BOOST_AUTO_TEST_CASE(zstd_dictionary_round_trip) {
+    auto plain = compressor::create({
+        {compression_parameters::SSTABLE_COMPRESSION, "ZstdCompressor"},
+    });
+    BOOST_REQUIRE_EQUAL(plain->dictionary_size(), 0);
+
+    auto c = compressor::create({
+        {compression_parameters::SSTABLE_COMPRESSION, "ZstdCompressor"},
+        {"dictionary_size_in_kb", "4"},
+    });
+    BOOST_REQUIRE_EQUAL(c->dictionary_size(), 4096);
+
+    // Many small, similar values - the case dictionaries are meant for.
+    std::vector<bytes> chunks;
+    for (int i = 0; i < 200; ++i) {
+        sstring s;
+        for (int j = 0; j < 16; ++j) {
+            s += format("{{\"user_id\": {}, \"name\": \"user-{}\", \"active\": {}}}", i * 16 + j, (i * 7 + j) % 91, j % 2 == 0);
+        }
+        chunks.emplace_back(reinterpret_cast<const int8_t*>(s.data()), s.size());
+    }
+    std::vector<bytes_view> samples(chunks.begin(), chunks.end());
+
+    auto dict = c->train_dictionary(samples);
+    BOOST_REQUIRE(!dict.empty());
+    BOOST_REQUIRE_LE(dict.size(), c->dictionary_size());
+
+    auto dc = c->with_dictionary(dict);
+    BOOST_REQUIRE_EQUAL(dc->dictionary_size(), 0);
+    size_t plain_total = 0;
+    size_t dict_total = 0;
+    for (auto& chunk : chunks) {
+        auto input = reinterpret_cast<const char*>(chunk.data());
+        std::vector<char> compressed(dc->compress_max_size(chunk.size()));
+        std::vector<char> decompressed(chunk.size());
+
+        auto len = plain->compress(input, chunk.size(), compressed.data(), compressed.size());
+        plain_total += len;
+
+        len = dc->compress(input, chunk.size(), compressed.data(), compressed.size());
+        dict_total += len;
+        auto out_len = dc->uncompress(compressed.data(), len, decompressed.data(), decompressed.size());
+        BOOST_REQUIRE_EQUAL(out_len, chunk.size());
+        BOOST_REQUIRE(std::equal(decompressed.begin(), decompressed.end(), input));
+    }
+    BOOST_REQUIRE_LT(dict_total, plain_total);
+
+    // Too little sample data yields no dictionary rather than an error.
+    BOOST_REQUIRE(c->train_dictionary({samples.front()}).empty());
+}
+
+static std::vector<temporary_buffer<char>> rpc_message_fragments(size_t count) {
+    std::vector<temporary_buffer<char>> fragments;
+    for (size_t i = 0; i < count; ++i) {
+        sstring s;
+        while (s.size() < rpc::snd_buf::chunk_size / 2) {
+            s += format("{{\"pk\": {}, \"ck\": {}, \"v\": \"value-{}\"}}", i, s.size(), s.size() % 17);
+        }
+        fragments.emplace_back(s.data(), s.size());
+    }
+    return fragments;
+}
+
+BOOST_AUTO_TEST_CASE(zstd_rpc_compressor_round_trip) {
+    sstring dictionary;
+    for (int i = 0; i < 64; ++i) {
+        dictionary += format("{{\"pk\": , \"ck\": , \"v\": \"value-{}\"}}", i);
+    }
+    for (auto dict : {sstring(), dictionary}) {
+        netw::zstd_rpc_compressor_factory factory(3, dict);
+        BOOST_REQUIRE_EQUAL(factory.supported() == "ZSTD", dict.empty());
+        BOOST_REQUIRE(!factory.negotiate("LZ4", false));
+        auto c = factory.negotiate(factory.supported(), false);
+        BOOST_REQUIRE(c);
+
+        for (size_t count : {1, 5}) {
+            auto fragments = rpc_message_fragments(count);
+            rpc::snd_buf data;
+            data.size = 0;
+            for (auto& f : fragments) {
+                data.size += f.size();
+            }
+            if (count == 1) {
+                data.bufs = fragments.front().share();
+            } else {
+                std::vector<temporary_buffer<char>> bufs;
+                for (auto& f : fragments) {
+                    bufs.push_back(f.share());
+                }
+                data.bufs = std::move(bufs);
+            }
+            auto size = data.size;
+
+            const size_t head_space = 4;
+            auto compressed = c->compress(head_space, std::move(data));
+            BOOST_REQUIRE_LT(compressed.size, size);
+
+            // Drop the head space, as the RPC layer does before decompressing.
+            rpc::rcv_buf received;
+            received.size = compressed.size - head_space;
+            if (auto* b = std::get_if<temporary_buffer<char>>(&compressed.bufs)) {
+                b->trim_front(head_space);
+                received.bufs = std::move(*b);
+            } else {
+                auto& bufs = std::get<std::vector<temporary_buffer<char>>>(compressed.bufs);
+                bufs.front().trim_front(head_space);
+                received.bufs = std::move(bufs);
+            }
+
+            auto decompressed = c->decompress(std::move(received));
+            BOOST_REQUIRE_EQUAL(decompressed.size, size);
+            sstring expected;
+            for (auto& f : fragments) {
+                expected += sstring(f.get(), f.size());
+            }
+            sstring actual;
+            if (auto* b = std::get_if<temporary_buffer<char>>(&decompressed.bufs)) {
+                actual = sstring(b->get(), b->size());
+            } else {
+                for (auto& b : std::get<std::vector<temporary_buffer<char>>>(decompressed.bufs)) {
+                    actual += sstring(b.get(), b.size());
+                }
+            }
+            BOOST_REQUIRE(actual == expected);
+        }
+    }
+
+    // Nodes with different dictionaries don't agree on the algorithm.
+    netw::zstd_rpc_compressor_factory a(3, dictionary);
+    netw::zstd_rpc_compressor_factory b(3, dictionary + "x");
+    BOOST_REQUIRE(a.supported() != b.supported());
+    BOOST_REQUIRE(!b.negotiate(a.supported(), true));
+}
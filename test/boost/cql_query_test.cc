@@ -38,6 +38,7 @@
 #include "db/config.hh"
 #include "db/extensions.hh"
 #include "cql3/cql_config.hh"
+#include "cql3/unprepared_statements_cache.hh"
 #include "test/lib/exception_utils.hh"
 #include "utils/rjson.hh"
 #include "utils/fmt-compat.hh"
@@ -3676,6 +3677,32 @@ SEASTAR_TEST_CASE(test_cache_bypass) {
     });
 }
 
+SEASTAR_TEST_CASE(test_cache_only) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t (pk int, ck int, v int, PRIMARY KEY (pk, ck))").get();
+        e.execute_cql("INSERT INTO t (pk, ck, v) VALUES (0, 0, 0)").get();
+        e.execute_cql("INSERT INTO t (pk, ck, v) VALUES (0, 1, 1)").get();
+        e.db().invoke_on_all([] (replica::database& db) -> future<> {
+            co_await db.flush_all_memtables();
+            db.find_column_family("ks", "t").get_row_cache().evict();
+        }).get();
+
+        const auto select = "SELECT v FROM t WHERE pk = 0 CACHE ONLY";
+        BOOST_REQUIRE_THROW(e.execute_cql(select).get(), exceptions::read_failure_exception);
+
+        // A regular read populates the cache.
+        e.execute_cql("SELECT v FROM t WHERE pk = 0").get();
+        assert_that(e.execute_cql(select).get())
+                .is_rows()
+                .with_rows({{int32_type->decompose(0)}, {int32_type->decompose(1)}});
+        assert_that(e.execute_cql("SELECT v FROM t WHERE pk = 0 ORDER BY ck DESC CACHE ONLY").get())
+                .is_rows()
+                .with_rows({{int32_type->decompose(1)}, {int32_type->decompose(0)}});
+
+        BOOST_REQUIRE_THROW(e.execute_cql("SELECT v FROM t CACHE ONLY").get(), exceptions::invalid_request_exception);
+    });
+}
+
 SEASTAR_TEST_CASE(test_describe_varchar) {
    // Test that, like cassandra, a varchar column is represented as a text column.
    return do_with_cql_env_thread([] (cql_test_env& e) {
@@ -4986,6 +5013,24 @@ SEASTAR_TEST_CASE(test_counter_column_added_into_non_counter_table) {
     });
 }
 
+SEASTAR_TEST_CASE(test_concurrent_counter_updates_of_partition) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE t (pk int, ck int, c1 counter, c2 counter, PRIMARY KEY(pk, ck))");
+
+        // Concurrent updates of a partition are merged on the leader replica,
+        // none of them may be lost or applied twice.
+        auto updates = std::views::iota(0, 100);
+        parallel_for_each(updates.begin(), updates.end(), [&e] (int i) {
+            return e.execute_cql(format("UPDATE t SET c1 = c1 + {}, c2 = c2 - 1 WHERE pk = 0 AND ck = {}", i, i % 2)).discard_result();
+        }).get();
+
+        assert_that(e.execute_cql("SELECT ck, c1, c2 FROM t WHERE pk = 0").get()).is_rows().with_rows({
+            {int32_type->decompose(0), long_type->decompose(int64_t(2450)), long_type->decompose(int64_t(-50))},
+            {int32_type->decompose(1), long_type->decompose(int64_t(2500)), long_type->decompose(int64_t(-50))},
+        });
+    });
+}
+
 SEASTAR_THREAD_TEST_CASE(test_invalid_using_timestamps) {
     do_with_cql_env_thread([] (cql_test_env& e) {
         auto now_nano = std::chrono::duration_cast<std::chrono::nanoseconds>(db_clock::now().time_since_epoch()).count();
@@ -5429,6 +5474,36 @@ static future<> with_udf_and_parallel_aggregation_enabled_thread(std::function<v
     return do_with_cql_env_thread(std::forward<std::function<void(cql_test_env&)>>(func), db_cfg_ptr);
 }
 
+SEASTAR_TEST_CASE(test_single_partition_aggregation_is_parallelized_when_enabled) {
+    auto db_cfg_ptr = make_shared<db::config>();
+    db_cfg_ptr->enable_parallelized_aggregation({true}, db::config::config_source::CommandLine);
+    db_cfg_ptr->enable_parallelized_aggregation_for_single_partition({true}, db::config::config_source::CommandLine);
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        auto& qp = e.local_qp();
+        const auto stat_parallelized = qp.get_cql_stats().select_parallelized;
+
+        e.execute_cql("CREATE TABLE tbl (pk int, ck int, col int, PRIMARY KEY (pk, ck));").get();
+        const int value_count = 10;
+        for (int pk = 0; pk < 2; pk++) {
+            for (int c = 0; c < value_count; c++) {
+                e.execute_cql(format("INSERT INTO tbl (pk, ck, col) VALUES ({:d}, {:d}, {:d});", pk, c, c)).get();
+            }
+        }
+
+        const auto result1 = e.execute_cql("SELECT COUNT(*) FROM tbl WHERE pk = 1;").get();
+        assert_that(result1).is_rows().with_rows({
+            {long_type->decompose(int64_t(value_count))}
+        });
+        BOOST_CHECK_EQUAL(stat_parallelized + 1, qp.get_cql_stats().select_parallelized);
+
+        const auto result2 = e.execute_cql("SELECT SUM(col) FROM tbl WHERE pk = 1 AND ck < 4;").get();
+        assert_that(result2).is_rows().with_rows({
+            {int32_type->decompose(int32_t(0 + 1 + 2 + 3))}
+        });
+        BOOST_CHECK_EQUAL(stat_parallelized + 2, qp.get_cql_stats().select_parallelized);
+    }, db_cfg_ptr);
+}
+
 SEASTAR_TEST_CASE(test_parallelized_select_uda) {
     return with_udf_and_parallel_aggregation_enabled_thread([](cql_test_env& e) {
         auto& qp = e.local_qp();
@@ -5889,6 +5964,45 @@ SEASTAR_TEST_CASE(test_sending_tablet_info_insert) {
     }, tablet_cql_test_config());
 }
 
+SEASTAR_TEST_CASE(test_sending_tablet_info_batch) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        e.execute_cql("create keyspace ks_tablet with replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 1 } and tablets = {'initial': 8};").get();
+        e.execute_cql("create table ks_tablet.test_tablet (pk int, ck int, v int, PRIMARY KEY (pk, ck));").get();
+
+        auto execute_batch = [&] (std::vector<int32_t> pks) {
+            std::vector<sstring_view> queries;
+            std::vector<cql3::raw_value_vector_with_unset> values;
+            for (auto pk : pks) {
+                queries.push_back("insert into ks_tablet.test_tablet (pk, ck, v) VALUES (?, ?, ?);");
+                values.push_back(cql3::raw_value_vector_with_unset({
+                        cql3::raw_value::make_value(int32_type->decompose(pk)),
+                        cql3::raw_value::make_value(int32_type->decompose(int32_t(values.size()))),
+                        cql3::raw_value::make_value(int32_type->decompose(int32_t{3}))}));
+            }
+            auto qo = std::make_unique<cql3::query_options>(cql3::query_options::make_batch_options(
+                    cql3::query_options(db::consistency_level::ONE, std::vector<cql3::raw_value>()), std::move(values)));
+            return e.execute_batch(queries, std::move(qo)).get();
+        };
+
+        const auto sptr = e.local_db().find_schema("ks_tablet", "test_tablet");
+        auto pk = partition_key::from_singular(*sptr, int32_t(1));
+        unsigned local_shard = sptr->table().shard_for_reads(dht::get_token(*sptr, pk.view()));
+        unsigned foreign_shard = (local_shard + 1) % smp::count;
+
+        smp::submit_to(local_shard, [&] {
+            return seastar::async([&] {
+                BOOST_ASSERT(!has_tablet_routing(execute_batch({1, 1})));
+            });
+        }).get();
+
+        smp::submit_to(foreign_shard, [&] {
+            return seastar::async([&] {
+                BOOST_ASSERT(has_tablet_routing(execute_batch({1, 1})));
+            });
+        }).get();
+    }, tablet_cql_test_config());
+}
+
 SEASTAR_TEST_CASE(test_sending_tablet_info_select) {
     return do_with_cql_env_thread([](cql_test_env& e) {
         e.execute_cql("create keyspace ks_tablet with replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 1} and tablets = {'initial': 8};").get();
@@ -5952,3 +6066,30 @@ SEASTAR_TEST_CASE(test_schema_change_events) {
         BOOST_REQUIRE(dynamic_pointer_cast<event_t>(res));
      });
 }
+
+SEASTAR_TEST_CASE(test_unprepared_statements_cache) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        auto& stats = cql3::unprepared_statements_cache::shard_stats();
+        e.execute_cql("create table t (pk int primary key, v int);").get();
+        e.execute_cql("insert into t (pk, v) values (1, 1);").get();
+
+        const auto hits = stats.hits;
+        const auto misses = stats.misses;
+        for (int i = 0; i < 3; ++i) {
+            assert_that(e.execute_cql("select v from t where pk = 1;").get()).is_rows().with_rows({{int32_type->decompose(1)}});
+        }
+        BOOST_REQUIRE_EQUAL(stats.misses, misses + 1);
+        BOOST_REQUIRE_EQUAL(stats.hits, hits + 2);
+
+        // A schema change invalidates the cached statement, which sees the
+        // new column once prepared again.
+        assert_that(e.execute_cql("select * from t where pk = 1;").get()).is_rows()
+            .with_rows({{int32_type->decompose(1), int32_type->decompose(1)}});
+        e.execute_cql("alter table t add w int;").get();
+        e.execute_cql("update t set w = 2 where pk = 1;").get();
+        assert_that(e.execute_cql("select * from t where pk = 1;").get()).is_rows()
+            .with_rows({{int32_type->decompose(1), int32_type->decompose(1), int32_type->decompose(2)}});
+        e.execute_cql("alter table t drop v;").get();
+        BOOST_REQUIRE_THROW(e.execute_cql("select v from t where pk = 1;").get(), exceptions::invalid_request_exception);
+    });
+}
@@ -10,10 +10,13 @@
 
 #include "test/lib/scylla_test_case.hh"
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/cql_assertions.hh"
 #include "test/lib/log.hh"
 #include "readers/filtering.hh"
 
 #include "db/data_listeners.hh"
+#include "db/hot_key_sampler.hh"
+#include "replica/database.hh"
 
 using namespace std::chrono_literals;
 
@@ -111,3 +114,23 @@ SEASTAR_TEST_CASE(test_dlistener_t2) {
         BOOST_REQUIRE_EQUAL(0, res.write);
     });
 }
+
+SEASTAR_TEST_CASE(test_hot_key_sampler) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t1 (k int, c int, PRIMARY KEY (k, c));").get();
+        constexpr unsigned writes = 8 * db::hot_key_sampler::sample_period;
+        for (unsigned i = 0; i < writes; ++i) {
+            e.execute_cql(format("INSERT INTO t1 (k, c) VALUES (1, {});", i)).get();
+        }
+
+        auto id = e.local_db().find_uuid("ks", "t1");
+        auto count = e.db().map_reduce0([id] (replica::database& db) {
+            auto top = db.find_column_family(id).get_stats().hot_keys.top_writes(1);
+            return top.empty() ? uint64_t(0) : top.front().count;
+        }, uint64_t(0), std::plus<uint64_t>()).get();
+        BOOST_REQUIRE_EQUAL(count, writes);
+
+        auto msg = e.execute_cql("SELECT count FROM system.hot_partitions WHERE keyspace_name = 'ks' AND table_name = 't1' AND operation = 'write';").get();
+        assert_that(msg).is_rows().with_rows({{long_type->decompose(int64_t(writes))}});
+    });
+}
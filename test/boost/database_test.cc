@@ -21,6 +21,7 @@
 
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/result_set_assertions.hh"
+#include "test/lib/cql_assertions.hh"
 #include "test/lib/log.hh"
 #include "test/lib/random_utils.hh"
 #include "test/lib/simple_schema.hh"
@@ -263,6 +264,93 @@ SEASTAR_TEST_CASE(test_querying_with_limits) {
     });
 }
 
+SEASTAR_TEST_CASE(test_multi_key_read) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        e.execute_cql("create table ks.cf (k text, v int, primary key (k));").get();
+        auto& db = e.local_db();
+        auto s = db.find_schema("ks", "cf");
+        auto&& table = db.find_column_family(s);
+        auto uuid = s->id();
+        std::vector<size_t> keys_per_shard(smp::count);
+        std::vector<dht::partition_range_vector> pranges_per_shard(smp::count);
+        for (uint32_t i = 0; i < 16 * smp::count; ++i) {
+            auto pkey = partition_key::from_single_value(*s, to_bytes(format("key{:d}", i)));
+            mutation m(s, pkey);
+            m.set_clustered_cell(clustering_key_prefix::make_empty(), "v", int32_t(i), 1);
+            apply_mutation(e.db(), uuid, m).get();
+            // Every other key is absent, so that the read has to skip over it.
+            if (i % 2) {
+                continue;
+            }
+            auto shard = table.shard_for_reads(m.token());
+            keys_per_shard[shard]++;
+            pranges_per_shard[shard].emplace_back(dht::partition_range::make_singular(dht::decorate_key(*s, std::move(pkey))));
+        }
+        e.db().invoke_on_all([] (replica::database& db) {
+            return db.flush_all_memtables();
+        }).get();
+        for (auto& ranges : pranges_per_shard) {
+            std::ranges::sort(ranges, [&] (const dht::partition_range& a, const dht::partition_range& b) {
+                return dht::ring_position_comparator(*s)(a.start()->value(), b.start()->value()) < 0;
+            });
+        }
+
+        auto cmd = query::read_command(s->id(), s->version(), partition_slice_builder(*s).build(),
+                query::max_result_size(std::numeric_limits<size_t>::max()), query::tombstone_limit::max);
+        e.db().invoke_on_all([&] (replica::database& db) -> future<> {
+            auto shard = this_shard_id();
+            auto s = db.find_schema(uuid);
+            auto& stats = db.find_column_family(s).get_stats();
+            const auto multi_key_reads = stats.multi_key_reads;
+            auto result = std::get<0>(co_await db.query(s, cmd, query::result_options::only_result(), pranges_per_shard[shard], nullptr, db::no_timeout));
+            assert_that(query::result_set::from_raw_result(s, cmd.slice, *result)).has_size(keys_per_shard[shard]);
+            BOOST_REQUIRE_EQUAL(stats.multi_key_reads, multi_key_reads + (keys_per_shard[shard] > 1));
+        }).get();
+    });
+}
+
+SEASTAR_TEST_CASE(test_small_memtables_are_relogged_instead_of_flushed) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        e.execute_cql("create table ks.cf (k int primary key, v int);").get();
+        e.execute_cql("insert into ks.cf (k, v) values (1, 1);").get();
+
+        struct counts {
+            int64_t relogs = 0;
+            size_t sstables = 0;
+        };
+        auto release_commitlog_segments = [&] {
+            return e.db().map_reduce0([] (replica::database& db) -> future<counts> {
+                auto& t = db.find_column_family("ks", "cf");
+                if (!db.commitlog()) {
+                    co_return counts{};
+                }
+                auto relogs = t.get_stats().memtable_relog_count;
+                co_await t.release_commitlog_segments(db::replay_position());
+                co_return counts{t.get_stats().memtable_relog_count - relogs, t.sstables_count()};
+            }, counts{}, [] (counts a, counts b) {
+                return counts{a.relogs + b.relogs, a.sstables + b.sstables};
+            }).get();
+        };
+
+        auto relogged = release_commitlog_segments();
+        if (!e.local_db().commitlog()) {
+            return;
+        }
+        // Only the shard owning the partition has something to relog.
+        BOOST_REQUIRE_EQUAL(relogged.relogs, 1);
+        BOOST_REQUIRE_EQUAL(relogged.sstables, 0);
+        assert_that(e.execute_cql("select v from ks.cf where k = 1;").get()).is_rows().with_rows({{int32_type->decompose(1)}});
+
+        smp::invoke_on_all([&] {
+            e.db_config().commitlog_relog_memtable_max_size_in_kb.set(0);
+        }).get();
+        auto flushed = release_commitlog_segments();
+        BOOST_REQUIRE_EQUAL(flushed.relogs, 0);
+        BOOST_REQUIRE_EQUAL(flushed.sstables, 1);
+        assert_that(e.execute_cql("select v from ks.cf where k = 1;").get()).is_rows().with_rows({{int32_type->decompose(1)}});
+    });
+}
+
 static void test_database(void (*run_tests)(populate_fn_ex, bool), unsigned cgs) {
     do_with_cql_env_and_compaction_groups_cgs(cgs, [run_tests] (cql_test_env& e) {
         run_tests([&] (schema_ptr s, const std::vector<mutation>& partitions, gc_clock::time_point) -> mutation_source {
@@ -638,3 +638,48 @@ SEASTAR_THREAD_TEST_CASE(test_size_tracked_region_move_assign) {
     r1 = std::move(r0);
     r1.allocator().free(std::exchange(p, nullptr));
 }
+
+SEASTAR_THREAD_TEST_CASE(test_region_group_memory_budgets) {
+    raii_region_group rg({
+        .unspooled_hard_limit = 10 * logalloc::segment_size,
+        .unspooled_soft_limit = 2 * logalloc::segment_size,
+        .unspooled_budget_limit = 2 * logalloc::segment_size,
+    });
+    memory_budget bulk("bulk");
+    memory_budget latency_critical("latency_critical");
+
+    auto bulk_region = std::make_unique<test_region>();
+    bulk_region->_budget = &bulk;
+    bulk_region->listen(&rg);
+    test_region latency_critical_region;
+    latency_critical_region._budget = &latency_critical;
+    latency_critical_region.listen(&rg);
+
+    latency_critical_region.alloc_small();
+    BOOST_REQUIRE(!rg.over_unspooled_soft_limit());
+    BOOST_REQUIRE(rg.run_when_memory_available([] {}, db::no_timeout, &bulk).available());
+    BOOST_REQUIRE(!rg.get_largest_region_over_budget());
+
+    for (int i = 0; i < 3; ++i) {
+        bulk_region->alloc();
+    }
+    BOOST_REQUIRE_EQUAL(bulk.unspooled_memory_used() + latency_critical.unspooled_memory_used(), rg.unspooled_memory_used());
+    BOOST_REQUIRE(rg.over_unspooled_soft_limit());
+    BOOST_REQUIRE(!rg.under_unspooled_pressure());
+    BOOST_REQUIRE(rg.get_largest_region_over_budget() == bulk_region.get());
+
+    // Only the writes to the table over its budget are delayed.
+    auto bulk_fut = rg.run_when_memory_available([] {}, db::no_timeout, &bulk);
+    BOOST_REQUIRE(!bulk_fut.available());
+    BOOST_REQUIRE_EQUAL(bulk.blocked_requests(), 1);
+    BOOST_REQUIRE_EQUAL(rg.blocked_requests(), 0);
+    BOOST_REQUIRE(rg.run_when_memory_available([] {}, db::no_timeout, &latency_critical).available());
+    BOOST_REQUIRE(rg.run_when_memory_available([] {}, db::no_timeout).available());
+    BOOST_REQUIRE_EQUAL(rg.budget_blocked_requests_counter(), 1);
+
+    // Flushing the table releases its writes.
+    bulk_region.reset();
+    BOOST_REQUIRE_EQUAL(bulk.unspooled_memory_used(), 0);
+    quiesce(std::move(bulk_fut));
+    BOOST_REQUIRE_EQUAL(bulk.blocked_requests(), 0);
+}
@@ -1390,7 +1390,8 @@ BOOST_AUTO_TEST_CASE(prepare_cast_int_int) {
 
     expression prepared = prepare_expression(cast_expr, db, "test_ks", table_schema.get(), receiver);
 
-    expression expected = cast{.arg = make_int_const(123), .type = int32_type};
+    // Casts of constants are folded.
+    expression expected = make_int_const(123);
     BOOST_REQUIRE_EQUAL(prepared, expected);
 }
 
@@ -1406,7 +1407,23 @@ BOOST_AUTO_TEST_CASE(prepare_cast_int_short) {
 
     expression prepared = prepare_expression(cast_expr, db, "test_ks", table_schema.get(), receiver);
 
-    expression expected = cast{.arg = make_smallint_const(123), .type = short_type};
+    // Casts of constants are folded.
+    expression expected = make_smallint_const(123);
+    BOOST_REQUIRE_EQUAL(prepared, expected);
+}
+
+BOOST_AUTO_TEST_CASE(prepare_sql_cast_constant_is_folded) {
+    schema_ptr table_schema = make_simple_test_schema();
+    auto [db, db_data] = make_data_dictionary_database(table_schema);
+
+    expression cast_expr =
+        cast{.style = cast::cast_style::sql,
+             .arg = make_int_const(123),
+             .type = cql3_type::raw::from(long_type)};
+
+    expression prepared = prepare_expression(cast_expr, db, "test_ks", table_schema.get(), nullptr);
+
+    expression expected = make_bigint_const(123);
     BOOST_REQUIRE_EQUAL(prepared, expected);
 }
 
@@ -1152,3 +1152,42 @@ SEASTAR_TEST_CASE(test_filtering) {
 
     });
 }
+
+// Comparisons of fixed-width columns with constants are evaluated on serialized values,
+// check that they agree with the type's ordering, also for negative, empty and null values.
+SEASTAR_TEST_CASE(test_filtering_on_fixed_width_columns) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE t (p int, c bigint, v int, s smallint, ts timestamp, u uuid, PRIMARY KEY (p, c));");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, s, ts, u) VALUES (1, -10, -1, -300, '2020-01-01 00:00:00+0000', 2b09d46d-6dd4-4d5b-a6c6-28cb5a6c2a1a);");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, s, ts, u) VALUES (1, 0, 0, 0, '1960-01-01 00:00:00+0000', 7e8b557c-d8d8-44a1-bb44-8a0bccdfd4b6);");
+        cquery_nofail(e, "INSERT INTO t (p, c, v, s) VALUES (1, 10, 300, 300);");
+        cquery_nofail(e, "INSERT INTO t (p, c, v) VALUES (1, 20, blobAsInt(0x));");
+
+        // Returns the clustering keys of the result rows, the first column of the result set.
+        auto keys_of = [] (shared_ptr<cql_transport::messages::result_message> msg) {
+            std::vector<int64_t> keys;
+            for (auto& row : dynamic_cast<cql_transport::messages::result_message::rows&>(*msg).rs().result_set().rows()) {
+                keys.push_back(value_cast<int64_t>(long_type->deserialize(*row[0])));
+            }
+            return keys;
+        };
+        auto check = [&] (sstring query, std::vector<int64_t> expected) {
+            BOOST_TEST_CONTEXT(query) {
+                BOOST_REQUIRE(keys_of(cquery_nofail(e, query)) == expected);
+            }
+        };
+
+        check("SELECT c FROM t WHERE v < 0 ALLOW FILTERING;", {-10, 20});
+        check("SELECT c FROM t WHERE v >= 0 ALLOW FILTERING;", {0, 10});
+        check("SELECT c FROM t WHERE v != 0 ALLOW FILTERING;", {-10, 10, 20});
+        check("SELECT c FROM t WHERE c > -20 AND c <= 0 ALLOW FILTERING;", {-10, 0});
+        check("SELECT c FROM t WHERE s > -1 AND v > 0 ALLOW FILTERING;", {10});
+        check("SELECT c FROM t WHERE ts < '2000-01-01 00:00:00+0000' ALLOW FILTERING;", {0});
+        check("SELECT c FROM t WHERE u = 7e8b557c-d8d8-44a1-bb44-8a0bccdfd4b6 ALLOW FILTERING;", {0});
+        check("SELECT c FROM t WHERE u != 7e8b557c-d8d8-44a1-bb44-8a0bccdfd4b6 ALLOW FILTERING;", {-10});
+
+        auto prepared = e.prepare("SELECT c FROM t WHERE v > ? ALLOW FILTERING;").get();
+        auto msg = e.execute_prepared(prepared, {cql3::raw_value::make_value(int32_type->decompose(0))}).get();
+        BOOST_REQUIRE(keys_of(msg) == std::vector<int64_t>{10});
+    });
+}
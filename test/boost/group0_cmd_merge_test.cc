@@ -71,6 +71,34 @@ SEASTAR_TEST_CASE(test_group0_state_machine_merger_timeuuid_order) {
     BOOST_REQUIRE_EQUAL(merger.last_id(), t1);
 }
 
+SEASTAR_TEST_CASE(test_group0_state_machine_merger_schema_and_mixed_changes) {
+    auto [db, db_impl] = cql3::expr::test_utils::make_data_dictionary_database(db::system_keyspace::group0_history());
+
+    semaphore s{1};
+    auto mutex_holder = co_await get_units(s, 1);
+
+    auto with_change = [] (service::group0_command cmd, auto change) {
+        change.mutations = std::move(service::group0_state_machine_merger::get_command_mutations(cmd));
+        cmd.change = std::move(change);
+        return cmd;
+    };
+    auto schema_cmd = with_change(create_command(utils::UUID_gen::get_time_UUID()), service::schema_change{});
+    auto mixed_cmd = with_change(create_command(utils::UUID_gen::get_time_UUID()), service::mixed_change{});
+    auto write_cmd = create_command(utils::UUID_gen::get_time_UUID());
+
+    service::group0_state_machine_merger merger{OLD_TIMEUUID, std::move(mutex_holder), 1024 * 1024, db};
+    size_t size = merger.cmd_size(schema_cmd);
+
+    merger.add(std::move(schema_cmd), size);
+    BOOST_REQUIRE(merger.can_merge(mixed_cmd, size));
+    merger.add(std::move(mixed_cmd), size);
+    BOOST_REQUIRE(!merger.can_merge(write_cmd, size));
+
+    auto [cmd, history] = merger.merge();
+    BOOST_REQUIRE(holds_alternative<service::mixed_change>(cmd.change));
+    BOOST_REQUIRE(merger.empty());
+}
+
 SEASTAR_TEST_CASE(test_group0_cmd_merge) {
 #ifndef SCYLLA_ENABLE_ERROR_INJECTION
     fmt::print("Skipping test as it depends on error injection. Please run in mode where it's enabled (debug,dev).\n");
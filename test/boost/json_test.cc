@@ -54,3 +54,26 @@ BOOST_AUTO_TEST_CASE(test_parsing_map_from_null) {
     BOOST_REQUIRE(map1 == map2);
     BOOST_REQUIRE(map1 == empty_map);
 }
+
+BOOST_AUTO_TEST_CASE(test_parsing_chunked_content) {
+    const std::string_view doc = R"({"Item": {"p": {"S": "a string longer than the short string optimization"}, "n": {"N": "12"}}, "l": [1, 2.5, true, null]})";
+    const auto expected = rjson::parse(doc);
+
+    auto make_chunk = [] (std::string_view sv) {
+        return temporary_buffer<char>(sv.data(), sv.size());
+    };
+    // Split the document at every position.
+    for (size_t split = 1; split < doc.size(); ++split) {
+        rjson::chunked_content content;
+        content.push_back(make_chunk(doc.substr(0, split)));
+        content.push_back(make_chunk(doc.substr(split)));
+        BOOST_REQUIRE_EQUAL(rjson::print(rjson::parse(std::move(content))), rjson::print(expected));
+    }
+
+    rjson::chunked_content content;
+    content.push_back(make_chunk("{\"a\": "));
+    content.push_back(make_chunk("[1, }"));
+    BOOST_REQUIRE_EXCEPTION(rjson::parse(std::move(content)), rjson::error, [] (const rjson::error& e) {
+        return std::string_view(e.what()).find("at 10") != std::string_view::npos;
+    });
+}
@@ -186,6 +186,30 @@ BOOST_AUTO_TEST_CASE(test_percent_multiple) {
     BOOST_TEST(!matches(bookends, u8"dark"));
 }
 
+BOOST_AUTO_TEST_CASE(test_percent_both_ends) {
+    auto infix = matcher(u8"%aab%");
+    BOOST_TEST(matches(infix, u8"aab"));
+    BOOST_TEST(matches(infix, u8"aaab"));
+    BOOST_TEST(matches(infix, u8"ababaabab"));
+    BOOST_TEST(matches(infix, u8"ШaabШ"));
+    BOOST_TEST(!matches(infix, u8""));
+    BOOST_TEST(!matches(infix, u8"aa"));
+    BOOST_TEST(!matches(infix, u8"abab"));
+    BOOST_TEST(!matches(infix, u8"aaШb"));
+
+    auto multibyte = matcher(u8"%%Шx%");
+    BOOST_TEST(matches(multibyte, u8"Шx"));
+    BOOST_TEST(matches(multibyte, u8"ШШx"));
+    BOOST_TEST(matches(multibyte, u8"aШxШ"));
+    BOOST_TEST(!matches(multibyte, u8"Ш"));
+    BOOST_TEST(!matches(multibyte, u8"xШ"));
+
+    auto any = matcher(u8"%%");
+    BOOST_TEST(matches(any, u8""));
+    BOOST_TEST(matches(any, u8"a"));
+    BOOST_TEST(matches(any, u8"ШШШ"));
+}
+
 BOOST_AUTO_TEST_CASE(test_escape_underscore) {
     auto last = matcher(u8R"(a\_)");
     BOOST_TEST(matches(last, u8"a_"));
@@ -15,6 +15,7 @@
 #include "test/lib/scylla_test_case.hh"
 #include <seastar/testing/thread_test_case.hh>
 #include "schema/schema_builder.hh"
+#include "partition_slice_builder.hh"
 #include <seastar/util/closeable.hh>
 #include "service/migration_manager.hh"
 
@@ -962,6 +963,65 @@ SEASTAR_THREAD_TEST_CASE(test_collecting_encoding_stats) {
 }
 
 
+SEASTAR_THREAD_TEST_CASE(test_single_partition_reads_outside_of_memtable_clustering_bounds) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    simple_schema ss;
+    auto s = ss.schema();
+    auto mt = make_lw_shared<replica::memtable>(s);
+
+    auto pk = ss.make_pkey(0);
+    auto pr = dht::partition_range::make_singular(pk);
+
+    auto read = [&] (schema_ptr query_schema, const query::partition_slice& slice) {
+        return assert_that(mt->make_flat_reader(query_schema, semaphore.make_permit(), pr, slice,
+                nullptr, streamed_mutation::forwarding::no, mutation_reader::forwarding::no));
+    };
+    auto slice_of = [&] (query::clustering_range range) {
+        return partition_slice_builder(*s).with_range(std::move(range)).with_no_static_columns().build();
+    };
+
+    // Nothing written yet.
+    read(s, slice_of(ss.make_ckey_range(0, 10))).produces_end_of_stream();
+
+    mutation m(s, pk);
+    for (uint32_t i = 100; i < 110; ++i) {
+        ss.add_row(m, ss.make_ckey(i), "v");
+    }
+    ss.delete_range(m, ss.make_ckey_range(200, 210));
+    mt->apply(m);
+
+    auto before = slice_of(ss.make_ckey_range(0, 10));
+    auto between = slice_of(ss.make_ckey_range(150, 160));
+    auto after = slice_of(ss.make_ckey_range(300, 310));
+    for (auto* slice : {&before, &between, &after}) {
+        read(s, *slice)
+            .produces_partition_start(pk)
+            .produces_partition_end()
+            .produces_end_of_stream();
+    }
+
+    auto rows = slice_of(ss.make_ckey_range(105, 150));
+    read(s, rows).produces(m, rows.row_ranges(*s, pk.key())).produces_end_of_stream();
+    auto tombstones = slice_of(ss.make_ckey_range(205, 300));
+    read(s, tombstones).produces(m, tombstones.row_ranges(*s, pk.key())).produces_end_of_stream();
+
+    auto rev_s = s->make_reversed();
+    read(rev_s, query::reverse_slice(*s, before))
+        .produces_partition_start(pk)
+        .produces_partition_end()
+        .produces_end_of_stream();
+    read(rev_s, query::reverse_slice(*s, rows))
+        .produces_partition_start(pk)
+        .produces_row_with_key(ss.make_ckey(109))
+        .produces_row_with_key(ss.make_ckey(108));
+
+    // Partition tombstones cover all clustering ranges.
+    mutation m2(s, pk);
+    m2.partition().apply(ss.new_tombstone());
+    mt->apply(m2);
+    read(s, before).produces(m + m2, before.row_ranges(*s, pk.key())).produces_end_of_stream();
+}
+
 SEASTAR_TEST_CASE(memtable_flush_compresses_mutations) {
     auto db_config = make_shared<db::config>();
     db_config->enable_cache.set(false);
@@ -702,3 +702,46 @@ SEASTAR_THREAD_TEST_CASE(test_mutation_fragment_stream_validator_validation_leve
         BOOST_REQUIRE(validation_level < vl::token || !validator(dk0));
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_mutation_fragment_stream_validator_full_validation_ratio) {
+    simple_schema ss;
+
+    const auto dkeys = ss.make_pkeys(8);
+    const auto ck0 = ss.make_ckey(0);
+    const auto ck1 = ss.make_ckey(1);
+
+    using mf_kind = mutation_fragment_v2::kind;
+
+    const auto ps_pos = position_in_partition_view(position_in_partition_view::partition_start_tag_t{});
+    const auto sr_pos = position_in_partition_view(position_in_partition_view::static_row_tag_t{});
+    const auto pe_pos = position_in_partition_view(position_in_partition_view::end_of_partition_tag_t{});
+
+    // Returns which of the partitions had their out-of-order clustering rows detected.
+    auto validate = [&] (double ratio) {
+        mutation_fragment_stream_validating_filter validator("test", *ss.schema(), mutation_fragment_stream_validation_level::clustering_key, false);
+        validator.set_full_validation_ratio(ratio);
+        const auto stats_before = mutation_fragment_stream_validation_stats::shard_stats();
+        std::vector<bool> detected;
+        for (const auto& dk : dkeys) {
+            BOOST_REQUIRE(validator(mf_kind::partition_start, ps_pos, {}));
+            BOOST_REQUIRE(validator(dk));
+            BOOST_REQUIRE(validator(mf_kind::clustering_row, position_in_partition::for_key(ck1), {}));
+            detected.push_back(!validator(mf_kind::clustering_row, position_in_partition::for_key(ck0), {}));
+            // The cheap checks are always done.
+            BOOST_REQUIRE(!validator(mf_kind::static_row, sr_pos, {}));
+            BOOST_REQUIRE(validator(mf_kind::partition_end, pe_pos, {}));
+        }
+        BOOST_REQUIRE(!validator(dkeys.front()));
+        const auto& stats = mutation_fragment_stream_validation_stats::shard_stats();
+        const uint64_t full = std::ranges::count(detected, true);
+        BOOST_REQUIRE_EQUAL(stats.partitions_fully_validated - stats_before.partitions_fully_validated, full);
+        BOOST_REQUIRE_EQUAL(stats.partitions_partially_validated - stats_before.partitions_partially_validated, dkeys.size() - full);
+        return detected;
+    };
+
+    BOOST_REQUIRE(std::ranges::all_of(validate(1), std::identity{}));
+    BOOST_REQUIRE_EQUAL(validate(0.5), std::vector<bool>({true, false, true, false, true, false, true, false}));
+    BOOST_REQUIRE_EQUAL(validate(0.25), std::vector<bool>({true, false, false, false, true, false, false, false}));
+    // The first partition is always fully validated.
+    BOOST_REQUIRE_EQUAL(validate(0), std::vector<bool>({true, false, false, false, false, false, false, false}));
+}
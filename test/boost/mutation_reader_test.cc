@@ -58,6 +58,7 @@
 #include "readers/mutation_fragment_v1_stream.hh"
 #include "readers/generating_v2.hh"
 #include "readers/empty_v2.hh"
+#include "readers/shared_scan.hh"
 #include "readers/next_partition_adaptor.hh"
 #include "readers/combined.hh"
 #include "readers/compacting.hh"
@@ -3708,6 +3709,118 @@ SEASTAR_THREAD_TEST_CASE(test_evictable_reader_next_pos_is_partition_start) {
     BOOST_REQUIRE_LE(buf1.size(), 10);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_shared_scan) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto gen = random_mutation_generator(random_mutation_generator::generate_counters::no);
+    const auto muts = gen(20);
+    auto schema = muts.front().schema();
+    auto mt = make_memtable(schema, muts);
+
+    size_t readers_created = 0;
+    auto ms = mutation_source([&] (
+            schema_ptr s,
+            reader_permit permit,
+            const dht::partition_range& range,
+            const query::partition_slice& slice,
+            tracing::trace_state_ptr trace_state,
+            streamed_mutation::forwarding fwd_sm,
+            mutation_reader::forwarding fwd_mr) {
+        ++readers_created;
+        return mt->as_data_source().make_reader_v2(std::move(s), std::move(permit), range, slice, std::move(trace_state), fwd_sm, fwd_mr);
+    });
+
+    shared_scan_registry registry;
+    auto make_reader = [&] (size_t window_size) {
+        return assert_that(registry.make_reader(ms, schema, semaphore.make_permit(), query::full_partition_range, schema->full_slice(), nullptr,
+                window_size));
+    };
+
+    // Scans reading side by side share the underlying reader.
+    {
+        std::deque<flat_reader_assertions_v2> readers;
+        for (int i = 0; i < 3; ++i) {
+            readers.emplace_back(make_reader(std::numeric_limits<size_t>::max()));
+        }
+        for (const auto& m : muts) {
+            for (auto& rd : readers) {
+                rd.produces(m);
+            }
+        }
+        for (auto& rd : readers) {
+            rd.produces_end_of_stream();
+        }
+    }
+    BOOST_REQUIRE_EQUAL(readers_created, 1);
+    BOOST_REQUIRE_EQUAL(registry.get_stats().scans, 1);
+    BOOST_REQUIRE_EQUAL(registry.get_stats().joined_readers, 2);
+    BOOST_REQUIRE_EQUAL(registry.get_stats().detached_readers, 0);
+
+    // A scan which didn't keep up with the others reads all the data still.
+    {
+        auto leader = make_reader(0);
+        auto laggard = make_reader(0);
+        for (const auto& m : muts) {
+            leader.produces(m);
+        }
+        leader.produces_end_of_stream();
+        for (const auto& m : muts) {
+            laggard.produces(m);
+        }
+        laggard.produces_end_of_stream();
+    }
+
+    // A scan can join only while the shared scan is at its start.
+    {
+        auto first = make_reader(std::numeric_limits<size_t>::max());
+        first.produces(muts.front());
+        auto second = make_reader(std::numeric_limits<size_t>::max());
+        for (const auto& m : muts) {
+            second.produces(m);
+        }
+        second.produces_end_of_stream();
+    }
+    BOOST_REQUIRE_EQUAL(registry.get_stats().scans, 4);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_shared_scan_detached_mid_partition) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    simple_schema s;
+    auto pkey = s.make_pkey();
+    mutation m(s.schema(), pkey);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        s.add_row(m, s.make_ckey(i), "v");
+    }
+    auto mt = make_memtable(s.schema(), {m});
+
+    shared_scan_registry registry;
+    auto make_reader = [&] {
+        auto rd = registry.make_reader(mt->as_data_source(), s.schema(), semaphore.make_permit(), query::full_partition_range,
+                s.schema()->full_slice(), nullptr, 1);
+        rd.set_max_buffer_size(1);
+        return assert_that(std::move(rd));
+    };
+
+    auto leader = make_reader();
+    auto laggard = make_reader();
+
+    laggard.produces_partition_start(pkey);
+    for (uint32_t i = 0; i < 5; ++i) {
+        laggard.produces_row_with_key(s.make_ckey(i));
+    }
+
+    // The leader reads past the window, detaching the laggard, which has to
+    // continue with its own reader from the middle of the partition.
+    leader.produces(m);
+    leader.produces_end_of_stream();
+    BOOST_REQUIRE_EQUAL(registry.get_stats().detached_readers, 1);
+
+    for (uint32_t i = 5; i < 1000; ++i) {
+        laggard.produces_row_with_key(s.make_ckey(i));
+    }
+    laggard.produces_partition_end();
+    laggard.produces_end_of_stream();
+}
+
 struct mutation_bounds {
     std::optional<mutation> m;
     position_in_partition lower;
@@ -1449,13 +1449,15 @@ SEASTAR_TEST_CASE(test_query_digest) {
         auto check_digests_equal = [now] (const mutation& m1, const mutation& m2) {
             auto ps1 = partition_slice_builder(*m1.schema()).build();
             auto ps2 = partition_slice_builder(*m2.schema()).build();
-            auto digest1 = *query_mutation(mutation(m1), ps1, query::max_rows, now,
-                    query::result_options::only_digest(query::digest_algorithm::xxHash)).digest();
-            auto digest2 = *query_mutation( mutation(m2), ps2, query::max_rows, now,
-                    query::result_options::only_digest(query::digest_algorithm::xxHash)).digest();
-
-            if (digest1 != digest2) {
-                BOOST_FAIL(format("Digest should be the same for {} and {}", m1, m2));
+            for (auto algo : {query::digest_algorithm::xxHash, query::digest_algorithm::xxh3}) {
+                auto digest1 = *query_mutation(mutation(m1), ps1, query::max_rows, now,
+                        query::result_options::only_digest(algo)).digest();
+                auto digest2 = *query_mutation( mutation(m2), ps2, query::max_rows, now,
+                        query::result_options::only_digest(algo)).digest();
+
+                if (digest1 != digest2) {
+                    BOOST_FAIL(format("Digest ({}) should be the same for {} and {}", static_cast<int>(algo), m1, m2));
+                }
             }
         };
 
@@ -2005,6 +2007,47 @@ SEASTAR_TEST_CASE(test_collection_cell_diff) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_merge_few_elements_into_large_collection) {
+    auto map_type = map_type_impl::get_instance(int32_type, int32_type, true);
+    auto make_cell = [&] (int32_t value, api::timestamp_type ts) {
+        return atomic_cell::make_live(*int32_type, ts, int32_type->decompose(value), atomic_cell::collection_member::yes);
+    };
+
+    collection_mutation_description large;
+    for (int32_t k = 0; k < 1000; k += 2) {
+        large.cells.emplace_back(int32_type->decompose(k), make_cell(k, 1));
+    }
+    // Keys before, between, equal to and after the keys of the large collection.
+    collection_mutation_description small;
+    for (int32_t k : {-1, 0, 499, 500, 2000}) {
+        small.cells.emplace_back(int32_type->decompose(k), make_cell(-k, 2));
+    }
+
+    auto check = [&] (collection_mutation_view a, collection_mutation_view b) {
+        auto merged = merge(*map_type, a, b);
+        collection_mutation_view(merged).with_deserialized(*map_type, [&] (collection_mutation_view_description d) {
+            std::map<int32_t, int32_t> expected;
+            for (int32_t k = 0; k < 1000; k += 2) {
+                expected[k] = k;
+            }
+            for (int32_t k : {-1, 0, 499, 500, 2000}) {
+                expected[k] = -k;
+            }
+            BOOST_REQUIRE_EQUAL(d.cells.size(), expected.size());
+            auto it = expected.begin();
+            for (auto& [key, cell] : d.cells) {
+                BOOST_REQUIRE_EQUAL(value_cast<int32_t>(int32_type->deserialize(key)), it->first);
+                BOOST_REQUIRE_EQUAL(value_cast<int32_t>(int32_type->deserialize(cell.value().linearize())), it->second);
+                ++it;
+            }
+        });
+    };
+    auto large_serialized = large.serialize(*map_type);
+    auto small_serialized = small.serialize(*map_type);
+    check(large_serialized, small_serialized);
+    check(small_serialized, large_serialized);
+}
+
 SEASTAR_TEST_CASE(test_apply_is_commutative) {
     return seastar::async([] {
         for_each_mutation_pair([] (auto&& m1, auto&& m2, are_equal eq) {
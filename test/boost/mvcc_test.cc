@@ -1749,6 +1749,57 @@ SEASTAR_TEST_CASE(test_versions_are_merged_when_snapshots_go_away) {
     });
 }
 
+SEASTAR_TEST_CASE(test_reads_of_partitions_waiting_for_merging) {
+    return seastar::async([] {
+        logalloc::region r;
+        mutation_application_stats cleaner_stats;
+        mutation_cleaner cleaner(r, nullptr, cleaner_stats);
+        with_allocator(r.allocator(), [&] {
+            random_mutation_generator gen(random_mutation_generator::generate_counters::no);
+            auto s = gen.schema();
+
+            auto make_entry = [&] {
+                mutation m1 = gen();
+                mutation m2 = gen();
+                m1.partition().make_fully_continuous();
+                m2.partition().make_fully_continuous();
+                auto e = std::make_unique<partition_entry>(*s, mutation_partition_v2(*s, m1.partition()));
+                auto snp = e->read(r, cleaner, nullptr);
+                {
+                    mutation_application_stats app_stats;
+                    logalloc::reclaim_lock rl(r);
+                    e->apply(r, cleaner, *s, m2.partition(), *s, app_stats);
+                }
+                return std::make_pair(std::move(e), std::move(snp));
+            };
+
+            auto [e1, snp1] = make_entry();
+            auto [e2, snp2] = make_entry();
+            auto reads = cleaner_stats.partition_reads;
+            auto versions_read = cleaner_stats.partition_versions_read;
+            BOOST_REQUIRE_EQUAL(reads, 2);
+            BOOST_REQUIRE_EQUAL(versions_read, 2);
+
+            {
+                auto pause = cleaner.pause();
+                snp1 = {};
+                snp2 = {};
+                BOOST_REQUIRE_EQUAL(2, boost::size(e1->versions()));
+                BOOST_REQUIRE_EQUAL(2, boost::size(e2->versions()));
+
+                // Moves the merging of e2 ahead of e1.
+                e2->read(r, cleaner, nullptr);
+                BOOST_REQUIRE_EQUAL(cleaner_stats.partition_reads, reads + 1);
+                BOOST_REQUIRE_EQUAL(cleaner_stats.partition_versions_read, versions_read + 2);
+            }
+
+            cleaner.drain().get();
+            BOOST_REQUIRE_EQUAL(1, boost::size(e1->versions()));
+            BOOST_REQUIRE_EQUAL(1, boost::size(e2->versions()));
+        });
+    });
+}
+
 // Reproducer of #4030
 SEASTAR_TEST_CASE(test_snapshot_merging_after_container_is_destroyed) {
     return seastar::async([] {
@@ -158,6 +158,9 @@ void full_ring_check(const std::vector<ring_point>& ring_points,
     strategy_sanity_check(ars_ptr, tmptr, options);
 
     auto erm = calculate_effective_replication_map(ars_ptr, tmptr).get();
+    // The same replication map, with the natural endpoints resolved up front.
+    auto built_erm = calculate_effective_replication_map(ars_ptr, tmptr).get();
+    built_erm->build_natural_endpoints().get();
 
     for (auto& rp : ring_points) {
         double cur_point1 = rp.point - 0.5;
@@ -180,6 +183,7 @@ void full_ring_check(const std::vector<ring_point>& ring_points,
         endpoints_check(ars_ptr, tmptr, endpoints2, topo);
         check_ranges_are_sorted(erm, rp.host).get();
         BOOST_CHECK(endpoints1 == endpoints2);
+        BOOST_CHECK(built_erm->get_natural_endpoints(t1) == endpoints1);
     }
 }
 
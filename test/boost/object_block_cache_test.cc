@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "test/lib/scylla_test_case.hh"
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/sleep.hh>
+
+#include "test/lib/random_utils.hh"
+#include "test/lib/tmpdir.hh"
+
+#include "sstables/object_block_cache.hh"
+
+using namespace seastar;
+using namespace sstables;
+
+// An in-memory object, which counts the reads of it.
+class object_file_impl : public file_impl {
+    sstring _contents;
+    size_t& _reads;
+
+    [[noreturn]] void unsupported() {
+        throw_with_backtrace<std::logic_error>("unsupported operation");
+    }
+public:
+    object_file_impl(sstring contents, size_t& reads) : _contents(std::move(contents)), _reads(reads) {}
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, io_intent*) override { unsupported(); }
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override { unsupported(); }
+    virtual future<> flush(void) override { unsupported(); }
+    virtual future<> truncate(uint64_t length) override { unsupported(); }
+    virtual future<> discard(uint64_t offset, uint64_t length) override { unsupported(); }
+    virtual future<> allocate(uint64_t position, uint64_t length) override { unsupported(); }
+    virtual subscription<directory_entry> list_directory(std::function<future<>(directory_entry)>) override { unsupported(); }
+    virtual future<struct stat> stat(void) override { unsupported(); }
+    virtual std::unique_ptr<seastar::file_handle_impl> dup() override { unsupported(); }
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, io_intent*) override { unsupported(); }
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, io_intent*) override { unsupported(); }
+
+    virtual future<uint64_t> size(void) override {
+        return make_ready_future<uint64_t>(_contents.size());
+    }
+
+    virtual future<> close() override { return make_ready_future<>(); }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t size, io_intent*) override {
+        ++_reads;
+        size = std::min<size_t>(size, _contents.size() - std::min<size_t>(offset, _contents.size()));
+        temporary_buffer<uint8_t> buf(size);
+        std::copy_n(_contents.data() + offset, size, buf.get_write());
+        return make_ready_future<temporary_buffer<uint8_t>>(std::move(buf));
+    }
+};
+
+static sstring read(file& f, uint64_t pos, size_t len) {
+    auto buf = f.dma_read_bulk<char>(pos, len).get();
+    return sstring(buf.get(), buf.size());
+}
+
+static object_block_cache::config make_config(const tmpdir& dir, uint64_t capacity) {
+    return object_block_cache::config{
+        .directory = dir.path(),
+        .capacity = capacity,
+        .block_size = 4096,
+    };
+}
+
+SEASTAR_THREAD_TEST_CASE(test_object_block_cache_survives_restart) {
+    tmpdir dir;
+    auto contents = tests::random::get_sstring(4096 * 5 + 100);
+    auto key = object_block_cache::make_object_key("endpoint", "/bucket/object");
+    size_t reads = 0;
+
+    {
+        object_block_cache cache(make_config(dir, 1 << 20));
+        cache.wait_for_load().get();
+        auto f = cache.make_caching_file(key, object_block_cache::pinned::no, file(make_shared<object_file_impl>(contents, reads)));
+        // The two blocks spanned by the read are fetched with one read.
+        BOOST_REQUIRE_EQUAL(read(f, 4000, 200), contents.substr(4000, 200));
+        BOOST_REQUIRE_EQUAL(reads, 1);
+        BOOST_REQUIRE_EQUAL(read(f, 4096 * 5, 200), contents.substr(4096 * 5, 100));
+        BOOST_REQUIRE_EQUAL(reads, 2);
+        cache.stop().get();
+        BOOST_REQUIRE_EQUAL(cache.get_stats().insertions, 3);
+        BOOST_REQUIRE_EQUAL(cache.get_stats().bytes, 4096 * 2 + 100);
+    }
+
+    object_block_cache cache(make_config(dir, 1 << 20));
+    cache.wait_for_load().get();
+    BOOST_REQUIRE_EQUAL(cache.get_stats().bytes, 4096 * 2 + 100);
+    auto f = cache.make_caching_file(key, object_block_cache::pinned::no, file(make_shared<object_file_impl>(contents, reads)));
+    BOOST_REQUIRE_EQUAL(read(f, 0, 4096 * 2), contents.substr(0, 4096 * 2));
+    BOOST_REQUIRE_EQUAL(read(f, 4096 * 5, 4096), contents.substr(4096 * 5));
+    BOOST_REQUIRE_EQUAL(reads, 2);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 3);
+
+    // Only the missing blocks are read from the object.
+    BOOST_REQUIRE_EQUAL(read(f, 0, contents.size()), contents);
+    BOOST_REQUIRE_EQUAL(reads, 3);
+
+    cache.invalidate(key);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().bytes, 0);
+    BOOST_REQUIRE_EQUAL(read(f, 0, 100), contents.substr(0, 100));
+    BOOST_REQUIRE_EQUAL(reads, 4);
+    cache.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_object_block_cache_eviction_spares_pinned_blocks) {
+    tmpdir dir;
+    auto index = tests::random::get_sstring(4096 * 2);
+    auto data = tests::random::get_sstring(4096 * 4);
+    size_t reads = 0;
+
+    object_block_cache cache(make_config(dir, 4096 * 4));
+    cache.wait_for_load().get();
+    auto index_file = cache.make_caching_file(object_block_cache::make_object_key("endpoint", "/bucket/Index.db"),
+            object_block_cache::pinned::yes, file(make_shared<object_file_impl>(index, reads)));
+    auto data_file = cache.make_caching_file(object_block_cache::make_object_key("endpoint", "/bucket/Data.db"),
+            object_block_cache::pinned::no, file(make_shared<object_file_impl>(data, reads)));
+
+    // Lets the writes of the blocks finish, so that they can be evicted.
+    auto wait_for_insertions = [&] (uint64_t n) {
+        while (cache.get_stats().insertions < n) {
+            sleep(std::chrono::milliseconds(1)).get();
+        }
+    };
+    read(index_file, 0, index.size());
+    wait_for_insertions(2);
+    for (size_t i = 0; i < 4; ++i) {
+        read(data_file, 4096 * i, 4096);
+        wait_for_insertions(3 + i);
+    }
+    BOOST_REQUIRE_LE(cache.get_stats().bytes, 4096 * 4);
+    BOOST_REQUIRE_EQUAL(cache.get_stats().pinned_bytes, 4096 * 2);
+    BOOST_REQUIRE_GT(cache.get_stats().evictions, 0);
+
+    reads = 0;
+    BOOST_REQUIRE_EQUAL(read(index_file, 0, index.size()), index);
+    BOOST_REQUIRE_EQUAL(reads, 0);
+    cache.stop().get();
+}
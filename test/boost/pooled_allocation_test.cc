@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE pooled_allocation_test
+
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/pooled_allocation.hh"
+
+namespace {
+
+struct base {
+    virtual ~base() = default;
+};
+
+struct pooled : public base, public utils::pooled_allocation<pooled, 2> {
+    int64_t value[4] = {};
+};
+
+struct derived : public pooled {
+    int64_t more[4] = {};
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(test_pooled_allocation_recycles_memory) {
+    BOOST_REQUIRE_EQUAL(pooled::cached(), 0);
+
+    auto a = std::make_unique<pooled>();
+    auto* a_address = a.get();
+    a.reset();
+    BOOST_REQUIRE_EQUAL(pooled::cached(), 1);
+    a = std::make_unique<pooled>();
+    BOOST_REQUIRE_EQUAL(a.get(), a_address);
+    BOOST_REQUIRE_EQUAL(pooled::cached(), 0);
+
+    // Deleting through a base class recycles too, up to the limit.
+    std::vector<std::unique_ptr<base>> objects;
+    for (int i = 0; i < 4; ++i) {
+        objects.push_back(std::make_unique<pooled>());
+    }
+    objects.clear();
+    BOOST_REQUIRE_EQUAL(pooled::cached(), 2);
+
+    // Objects of derived classes aren't pooled.
+    std::unique_ptr<base> d = std::make_unique<derived>();
+    BOOST_REQUIRE_EQUAL(pooled::cached(), 2);
+    d.reset();
+    BOOST_REQUIRE_EQUAL(pooled::cached(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_pooled_allocator) {
+    std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, utils::pooled_allocator<std::pair<const int, int>>> map;
+    for (int i = 0; i < 100; ++i) {
+        map.emplace(i, i);
+    }
+    for (int i = 0; i < 100; i += 2) {
+        map.erase(i);
+    }
+    for (int i = 0; i < 100; i += 2) {
+        map.emplace(i, -i);
+    }
+    BOOST_REQUIRE_EQUAL(map.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        BOOST_REQUIRE_EQUAL(map.at(i), i % 2 ? i : -i);
+    }
+}
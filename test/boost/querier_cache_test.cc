@@ -195,6 +195,10 @@ class test_querier_cache {
         return _sem;
     }
 
+    query::querier_cache& get_cache() {
+        return _cache;
+    }
+
     dht::partition_range make_partition_range(bound begin, bound end) const {
         return dht::partition_range::make({_mutations.at(begin.value()).decorated_key(), begin.is_inclusive()},
                 {_mutations.at(end.value()).decorated_key(), end.is_inclusive()});
@@ -392,6 +396,31 @@ SEASTAR_THREAD_TEST_CASE(lookup_with_wrong_key_misses) {
         .no_evictions();
 }
 
+SEASTAR_THREAD_TEST_CASE(lookup_with_wrong_key_by_position) {
+    test_querier_cache t;
+    t.get_cache().set_lookup_by_position(utils::updateable_value<bool>(true));
+
+    const auto entry = t.produce_first_page_and_save_data_querier();
+
+    // The start of the original range doesn't match the position of the querier.
+    t.assert_cache_lookup_data_querier(90, *t.get_schema(), entry.original_range, entry.expected_slice)
+        .misses()
+        .no_drops()
+        .no_evictions();
+
+    t.assert_cache_lookup_data_querier(90, *t.get_schema(), entry.expected_range, entry.expected_slice)
+        .no_misses()
+        .no_drops()
+        .no_evictions();
+    BOOST_REQUIRE_EQUAL(t.get_cache().get_stats().position_hits, 1);
+
+    // The querier was taken out of the cache by the previous lookup.
+    t.assert_cache_lookup_data_querier(entry.key, *t.get_schema(), entry.expected_range, entry.expected_slice)
+        .misses()
+        .no_drops()
+        .no_evictions();
+}
+
 SEASTAR_THREAD_TEST_CASE(lookup_data_querier_as_mutation_querier_misses) {
     test_querier_cache t;
 
@@ -127,3 +127,78 @@ SEASTAR_TEST_CASE(test_rate_limiter_account_operation) {
     }
     BOOST_REQUIRE(encountered_rejection);
 }
+
+SEASTAR_TEST_CASE(test_rate_limiter_sketch_no_rejections_on_sequential) {
+    const uint64_t token_count = 1000 * 1000;
+    test_rate_limiter::label lbl;
+
+    test_rate_limiter limiter;
+
+    // Lossy counting keeps the collisions of many cold partitions from
+    // accumulating in the sketch counters.
+    for (uint64_t token = 0; token < token_count; token++) {
+        BOOST_REQUIRE_LE(limiter.increase_and_get_counter(lbl, token, test_rate_limiter::accounting::sketch), 2);
+        co_await maybe_yield();
+    }
+}
+
+SEASTAR_TEST_CASE(test_rate_limiter_sketch_partition_label_separation) {
+    const uint64_t token_count = 30;
+    const uint64_t repeat_count = 10;
+    std::vector<test_rate_limiter::label> labels{3};
+
+    test_rate_limiter limiter;
+
+    for (uint64_t i = 0; i < repeat_count; i++) {
+        for (uint64_t token = 0; token < token_count; token++) {
+            for (auto& l : labels) {
+                BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(l, token, test_rate_limiter::accounting::sketch), i + 1);
+                co_await maybe_yield();
+            }
+        }
+    }
+}
+
+SEASTAR_TEST_CASE(test_rate_limiter_sketch_halving_over_time) {
+    test_rate_limiter::label lbl;
+    test_rate_limiter limiter;
+    const auto sketch = test_rate_limiter::accounting::sketch;
+
+    for (int i = 0; i < 16; i++) {
+        limiter.increase_and_get_counter(lbl, 0, sketch);
+    }
+
+    co_await step_seconds(1);
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl, 0, sketch), (16 / 2) + 1);
+
+    co_await step_seconds(2);
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl, 0, sketch), (9 / 4) + 1);
+
+    co_await step_seconds(10);
+    BOOST_REQUIRE_EQUAL(limiter.increase_and_get_counter(lbl, 0, sketch), 1);
+
+    // See test_rate_limiter_time_window_wraparound_handling.
+    co_await seastar::sleep(std::chrono::seconds(1));
+}
+
+SEASTAR_TEST_CASE(test_rate_limiter_sketch_account_operation) {
+    const uint64_t limit = 1;
+    const int ops_per_loop = 1000;
+    test_rate_limiter::label lbl;
+
+    test_rate_limiter limiter;
+
+    db::per_partition_rate_limit::account_and_enforce info {
+        .random_variable = UINT32_MAX,
+    };
+
+    bool encountered_rejection = false;
+    for (int i = 0; i < ops_per_loop; i++) {
+        if (limiter.account_operation(lbl, 0, limit, info, test_rate_limiter::accounting::sketch) == test_rate_limiter::can_proceed::no) {
+            encountered_rejection = true;
+            break;
+        }
+        co_await maybe_yield();
+    }
+    BOOST_REQUIRE(encountered_rejection);
+}
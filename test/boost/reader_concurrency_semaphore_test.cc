@@ -2139,3 +2139,81 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_live_update_cpu_concu
     }
     require_can_admit(true, "!need_cpu");
 }
+
+// Check that permits of the cache lane don't consume count resources and are
+// not queued behind permits waiting for count resources, but are still
+// limited by memory.
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_cache_admission_lane) {
+    using admission_lane = reader_concurrency_semaphore::admission_lane;
+    const auto initial_resources = reader_concurrency_semaphore::resources{1, 4 * 1024};
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), initial_resources.count, initial_resources.memory);
+    auto stop_sem = deferred_stop(semaphore);
+
+    auto disk_permit1 = std::optional(semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get());
+    BOOST_REQUIRE_EQUAL(semaphore.available_resources().count, 0);
+
+    // Waits for count resources.
+    auto disk_permit2_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {});
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 1);
+
+    // Admitted right away, without consuming count resources.
+    auto cache_permit1 = std::optional(semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}, {.lane = admission_lane::cache}).get());
+    BOOST_REQUIRE_EQUAL(semaphore.available_resources().count, 0);
+    BOOST_REQUIRE_EQUAL(semaphore.available_resources().memory, 2 * 1024);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().reads_admitted_via_cache_lane, 1);
+
+    // Waits for memory resources.
+    auto cache_permit2_fut = semaphore.obtain_permit(nullptr, get_name(), 3 * 1024, db::no_timeout, {}, {.lane = admission_lane::cache});
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 2);
+    BOOST_REQUIRE(!cache_permit2_fut.available());
+
+    cache_permit1.reset();
+    auto cache_permit2 = cache_permit2_fut.get();
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().reads_admitted_via_cache_lane, 2);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 1);
+    BOOST_REQUIRE(!disk_permit2_fut.available());
+
+    disk_permit1.reset();
+    disk_permit2_fut.get();
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 0);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().reads_admitted_via_cache_lane, 2);
+}
+
+// Check that reads waiting for admission are ordered by their estimated I/O
+// cost, but reads waiting for long enough are admitted first regardless.
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_io_cost_ordering) {
+    const auto initial_resources = reader_concurrency_semaphore::resources{1, 4 * 1024};
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), initial_resources.count, initial_resources.memory);
+    auto stop_sem = deferred_stop(semaphore);
+
+    auto check_order = [&] (uint64_t expensive_cost, std::chrono::milliseconds wait_between, bool expect_cheap_first) {
+        auto permit = std::optional(semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}).get());
+
+        auto expensive_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}, {.io_cost = expensive_cost});
+        sleep(wait_between).get();
+        auto cheap_fut = semaphore.obtain_permit(nullptr, get_name(), 1024, db::no_timeout, {}, {.io_cost = 0});
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 2);
+
+        permit.reset();
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().waiters, 1);
+        auto [first, second] = expect_cheap_first ? std::pair(&cheap_fut, &expensive_fut) : std::pair(&expensive_fut, &cheap_fut);
+        BOOST_REQUIRE(first->available());
+        BOOST_REQUIRE(!second->available());
+        first->get();
+        second->get();
+    };
+
+    // No delay: FIFO.
+    check_order(100, std::chrono::milliseconds(0), false);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().reads_queued_ahead_by_io_cost, 0);
+
+    // 100 * 1s delay: the cheap read goes first.
+    semaphore.set_io_cost_delay(utils::updateable_value<uint32_t>(1'000'000));
+    check_order(100, std::chrono::milliseconds(0), true);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().reads_queued_ahead_by_io_cost, 1);
+
+    // 1 * 1us delay: the expensive read waited for longer than that.
+    semaphore.set_io_cost_delay(utils::updateable_value<uint32_t>(1));
+    check_order(1, std::chrono::milliseconds(10), false);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().reads_queued_ahead_by_io_cost, 1);
+}
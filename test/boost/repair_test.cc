@@ -13,6 +13,7 @@
 #include "repair/writer.hh"
 #include "repair/reader.hh"
 #include "repair/row_level.hh"
+#include "repair/range_summary.hh"
 #include "test/lib/mutation_source_test.hh"
 #include "test/lib/random_utils.hh"
 #include "test/lib/cql_test_env.hh"
@@ -269,3 +270,67 @@ SEASTAR_TEST_CASE(repair_rows_size_considers_external_memory) {
         BOOST_REQUIRE_EQUAL(row_with_boundary.size(), fmf_size + boundary.pk.external_memory_usage() + boundary.position.external_memory_usage() + sizeof(repair_row));
     });
 }
+
+SEASTAR_THREAD_TEST_CASE(test_range_summary_splitter) {
+    auto range = dht::token_range::make({dht::token(-1000), false}, {dht::token(1000), true});
+    repair_range_summary::splitter splitter(range, 8);
+    BOOST_REQUIRE_EQUAL(splitter.leaves_count(), 8);
+
+    // The leaves cover the range without gaps or overlaps, and each token
+    // belongs to the leaf its range contains.
+    auto cmp = dht::token_comparator();
+    for (int64_t t = -999; t <= 1000; ++t) {
+        auto leaf = splitter.leaf_of(dht::token(t));
+        BOOST_REQUIRE_LT(leaf, splitter.leaves_count());
+        for (size_t i = 0; i < splitter.leaves_count(); ++i) {
+            BOOST_REQUIRE_EQUAL(splitter.leaves_range(i, i).contains(dht::token(t), cmp), i == leaf);
+        }
+    }
+    BOOST_REQUIRE(splitter.leaves_range(0, splitter.leaves_count() - 1) == range);
+
+    // A range too narrow to be split has a single leaf.
+    auto narrow = dht::token_range::make({dht::token(1), true}, {dht::token(3), true});
+    BOOST_REQUIRE_EQUAL(repair_range_summary::splitter(narrow, 8).leaves_count(), 1);
+
+    // The full ring can be split as well.
+    repair_range_summary::splitter full(dht::token_range::make_open_ended_both_sides(), 4);
+    BOOST_REQUIRE_EQUAL(full.leaves_count(), 4);
+    BOOST_REQUIRE_EQUAL(full.leaf_of(dht::first_token()), 0);
+    BOOST_REQUIRE_EQUAL(full.leaf_of(dht::last_token()), 3);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_range_summary_differing_leaves) {
+    std::vector<repair_hash> leaves;
+    for (uint64_t i = 0; i < 13; ++i) {
+        leaves.emplace_back(tests::random::get_int<uint64_t>());
+    }
+    auto summary = repair_range_summary::build(leaves);
+    // 13 leaves are padded to 16.
+    BOOST_REQUIRE_EQUAL(summary.nodes().size(), 31);
+
+    auto same = repair_range_summary::build(leaves);
+    BOOST_REQUIRE_EQUAL(summary.root(), same.root());
+    BOOST_REQUIRE(repair_range_summary::differing_leaves({summary, same}, leaves.size()).empty());
+
+    auto other_leaves = leaves;
+    other_leaves[2].add(repair_hash(1));
+    other_leaves[3].add(repair_hash(1));
+    other_leaves[12].add(repair_hash(1));
+    auto other = repair_range_summary::build(other_leaves);
+    BOOST_REQUIRE_NE(summary.root(), other.root());
+    auto differing = repair_range_summary::differing_leaves({summary, same, other}, leaves.size());
+    BOOST_REQUIRE(differing == (std::vector<size_t>{2, 3, 12}));
+
+    // Summaries of a different shape can't be compared.
+    auto smaller = repair_range_summary::build(std::vector<repair_hash>(leaves.begin(), leaves.begin() + 5));
+    BOOST_REQUIRE_EQUAL(repair_range_summary::differing_leaves({summary, smaller}, leaves.size()).size(), leaves.size());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_range_summary_merge_leaves_into_runs) {
+    using runs = std::vector<std::pair<size_t, size_t>>;
+    BOOST_REQUIRE(merge_leaves_into_runs({}, 4).empty());
+    BOOST_REQUIRE(merge_leaves_into_runs({1, 2, 3, 7, 9, 10}, 4) == (runs{{1, 3}, {7, 7}, {9, 10}}));
+    // The runs separated by the smallest gaps are merged first.
+    BOOST_REQUIRE(merge_leaves_into_runs({1, 2, 3, 7, 9, 10}, 2) == (runs{{1, 3}, {7, 10}}));
+    BOOST_REQUIRE(merge_leaves_into_runs({0, 5, 20}, 1) == (runs{{0, 20}}));
+}
@@ -1773,6 +1773,116 @@ SEASTAR_TEST_CASE(test_lru) {
     });
 }
 
+SEASTAR_TEST_CASE(test_scan_resistant_admission) {
+    return seastar::async([] {
+        simple_schema s;
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto cache_mt = make_lw_shared<replica::memtable>(s.schema());
+
+        std::vector<mutation> partitions;
+        for (auto& pk : s.make_pkeys(5)) {
+            mutation m(s.schema(), pk);
+            for (int ck = 0; ck < 3; ++ck) {
+                s.add_row(m, s.make_ckey(ck), "v");
+            }
+            cache_mt->apply(m);
+            partitions.push_back(std::move(m));
+        }
+
+        cache_tracker tracker;
+        tracker.set_scan_resistant_admission(utils::updateable_value<bool>(true));
+        row_cache cache(s.schema(), snapshot_source_from_snapshot(cache_mt->as_data_source()), tracker);
+
+        auto& hot = partitions[2];
+        auto hot_range = dht::partition_range::make_singular(hot.decorated_key());
+        assert_that(cache.make_reader(s.schema(), semaphore.make_permit(), hot_range))
+            .produces(hot)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().row_probationary_insertions, 0);
+
+        auto scan = assert_that(cache.make_reader(s.schema(), semaphore.make_permit()));
+        for (auto& m : partitions) {
+            scan.produces(m);
+        }
+        scan.produces_end_of_stream();
+        auto probationary = tracker.get_stats().row_probationary_insertions;
+        BOOST_REQUIRE_GT(probationary, 0);
+
+        // Evicting as many rows as the scan admitted leaves the hot partition alone.
+        auto target = tracker.get_stats().rows - probationary;
+        while (tracker.get_stats().rows > target) {
+            BOOST_REQUIRE(tracker.region().evict_some() == memory::reclaiming_result::reclaimed_something);
+        }
+        auto row_misses = tracker.get_stats().row_misses;
+        auto partition_misses = tracker.get_stats().partition_misses;
+        assert_that(cache.make_reader(s.schema(), semaphore.make_permit(), hot_range))
+            .produces(hot)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().row_misses, row_misses);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_misses, partition_misses);
+    });
+}
+
+SEASTAR_TEST_CASE(test_low_priority_table_admission) {
+    return seastar::async([] {
+        simple_schema hot_s("ks", "hot");
+        simple_schema cold_s(schema_builder(simple_schema("ks", "cold").schema())
+                .set_caching_options(caching_options::from_map({{"priority", "low"}}))
+                .build(), api::new_timestamp());
+        BOOST_REQUIRE(cold_s.schema()->caching_options().low_priority());
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+
+        auto make_partitions = [] (simple_schema& s, replica::memtable& mt) {
+            std::vector<mutation> partitions;
+            for (auto& pk : s.make_pkeys(5)) {
+                mutation m(s.schema(), pk);
+                for (int ck = 0; ck < 3; ++ck) {
+                    s.add_row(m, s.make_ckey(ck), "v");
+                }
+                mt.apply(m);
+                partitions.push_back(std::move(m));
+            }
+            return partitions;
+        };
+        auto hot_mt = make_lw_shared<replica::memtable>(hot_s.schema());
+        auto hot_partitions = make_partitions(hot_s, *hot_mt);
+        auto cold_mt = make_lw_shared<replica::memtable>(cold_s.schema());
+        auto cold_partitions = make_partitions(cold_s, *cold_mt);
+
+        // Scan-resistant admission is off, it doesn't matter for low priority tables.
+        cache_tracker tracker;
+        row_cache hot_cache(hot_s.schema(), snapshot_source_from_snapshot(hot_mt->as_data_source()), tracker);
+        row_cache cold_cache(cold_s.schema(), snapshot_source_from_snapshot(cold_mt->as_data_source()), tracker);
+
+        auto read = [&] (row_cache& cache, const mutation& m) {
+            assert_that(cache.make_reader(m.schema(), semaphore.make_permit(), dht::partition_range::make_singular(m.decorated_key())))
+                .produces(m)
+                .produces_end_of_stream();
+        };
+        for (auto& m : hot_partitions) {
+            read(hot_cache, m);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().row_probationary_insertions, 0);
+        for (auto& m : cold_partitions) {
+            read(cold_cache, m);
+        }
+        BOOST_REQUIRE_GT(tracker.get_stats().row_probationary_insertions, 0);
+        BOOST_REQUIRE_EQUAL(tracker.partitions(), hot_partitions.size() + cold_partitions.size());
+
+        // The cold table is evicted first, even though it was read last.
+        while (tracker.partitions() > hot_partitions.size()) {
+            BOOST_REQUIRE(tracker.region().evict_some() == memory::reclaiming_result::reclaimed_something);
+        }
+        auto row_misses = tracker.get_stats().row_misses;
+        auto partition_misses = tracker.get_stats().partition_misses;
+        for (auto& m : hot_partitions) {
+            read(hot_cache, m);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().row_misses, row_misses);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_misses, partition_misses);
+    });
+}
+
 SEASTAR_TEST_CASE(test_update_invalidating) {
     return seastar::async([] {
         simple_schema s;
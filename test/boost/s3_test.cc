@@ -109,12 +109,14 @@ static auto deferred_delete_object(shared_ptr<s3::client> client, sstring name)
     });
 }
 
-void do_test_client_multipart_upload(bool with_copy_upload) {
+void do_test_client_multipart_upload(bool with_copy_upload, unsigned upload_concurrency = 4) {
     const sstring name(fmt::format("/{}/test{}object-{}", tests::getenv_safe("S3_BUCKET_FOR_TEST"), with_copy_upload ? "jumbo" : "large", ::getpid()));
 
     testlog.info("Make client\n");
     semaphore mem(16<<20);
-    auto cln = s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), make_minio_config(), mem);
+    auto cfg = make_minio_config();
+    cfg->upload_concurrency = upload_concurrency;
+    auto cln = s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), std::move(cfg), mem);
     auto close_client = deferred_close(*cln);
 
     testlog.info("Upload object (with copy = {})\n", with_copy_upload);
@@ -169,6 +171,10 @@ SEASTAR_THREAD_TEST_CASE(test_client_multipart_copy_upload) {
     do_test_client_multipart_upload(true);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_client_multipart_upload_one_part_in_flight) {
+    do_test_client_multipart_upload(false, 1);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_client_multipart_upload_fallback) {
     const sstring name(fmt::format("/{}/testfbobject-{}", tests::getenv_safe("S3_BUCKET_FOR_TEST"), ::getpid()));
 
@@ -350,6 +356,46 @@ SEASTAR_THREAD_TEST_CASE(test_client_readable_file_stream) {
     BOOST_REQUIRE_EQUAL(res, sample);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_client_parallel_download) {
+    const sstring name(fmt::format("/{}/testdownloadobject-{}", tests::getenv_safe("S3_BUCKET_FOR_TEST"), ::getpid()));
+
+    testlog.info("Make client\n");
+    semaphore mem(16<<20);
+    auto cfg = make_minio_config();
+    cfg->download_part_size = 1000;
+    cfg->download_concurrency = 3;
+    auto cln = s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), std::move(cfg), mem);
+    auto close_client = deferred_close(*cln);
+
+    testlog.info("Put object {}\n", name);
+    auto sample = tests::random::get_sstring(10 * 1000 + 123);
+    cln->put_object(name, temporary_buffer<char>(sample.c_str(), sample.size())).get();
+    auto delete_object = deferred_delete_object(cln, name);
+
+    testlog.info("Check parallel ranged read\n");
+    auto buf = cln->get_object_parallel(name, s3::range{ 500, 5432 }).get();
+    BOOST_REQUIRE_EQUAL(to_sstring(std::move(buf)), sample.substr(500, 5432));
+
+    testlog.info("Check download of the whole object\n");
+    {
+        auto in = input_stream<char>(cln->make_download_source(name));
+        auto close_stream = deferred_close(in);
+        auto res = seastar::util::read_entire_stream_contiguous(in).get();
+        BOOST_REQUIRE_EQUAL(res, sample);
+    }
+
+    testlog.info("Check download of a range with a skip\n");
+    {
+        auto in = input_stream<char>(cln->make_download_source(name, s3::range{ 100, 8000 }));
+        auto close_stream = deferred_close(in);
+        auto head = in.read_exactly(1500).get();
+        BOOST_REQUIRE_EQUAL(to_sstring(std::move(head)), sample.substr(100, 1500));
+        in.skip(3000).get();
+        auto res = seastar::util::read_entire_stream_contiguous(in).get();
+        BOOST_REQUIRE_EQUAL(res, sample.substr(4600, 3500));
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_client_put_get_tagging) {
     const sstring name(fmt::format("/{}/testobject-{}",
                                    tests::getenv_safe("S3_BUCKET_FOR_TEST"), ::getpid()));
@@ -42,6 +42,62 @@ SEASTAR_TEST_CASE(test_secondary_index_regular_column_query) {
     });
 }
 
+SEASTAR_TEST_CASE(test_secondary_index_included_columns) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE users (userid int, name text, email text, country text, PRIMARY KEY (userid));").get();
+
+        using ire = exceptions::invalid_request_exception;
+        using exception_predicate::message_contains;
+        BOOST_REQUIRE_EXCEPTION(e.execute_cql("CREATE INDEX ON users (country) WITH OPTIONS = {'include': 'nosuch'};").get(), ire,
+                message_contains("No column definition found"));
+        BOOST_REQUIRE_EXCEPTION(e.execute_cql("CREATE INDEX ON users (country) WITH OPTIONS = {'include': 'userid'};").get(), ire,
+                message_contains("only regular columns can be included"));
+        BOOST_REQUIRE_EXCEPTION(e.execute_cql("CREATE INDEX ON users (country) WITH OPTIONS = {'include': 'country'};").get(), ire,
+                message_contains("Cannot include the indexed column"));
+        BOOST_REQUIRE_EXCEPTION(e.execute_cql("CREATE INDEX ON users (country) WITH OPTIONS = {'other': 'name'};").get(), ire,
+                message_contains("for a non-CUSTOM index"));
+
+        e.execute_cql("CREATE INDEX ON users (country) WITH OPTIONS = {'include': 'name, email'};").get();
+        e.execute_cql("INSERT INTO users (userid, name, email, country) VALUES (0, 'Bondie Easseby', 'beassebyv@house.gov', 'France');").get();
+        e.execute_cql("INSERT INTO users (userid, name, email, country) VALUES (1, 'Demetri Curror', 'dcurrorw@techcrunch.com', 'France');").get();
+        e.execute_cql("INSERT INTO users (userid, name, country) VALUES (2, 'Langston Paulisch', 'United States');").get();
+
+        auto& stats = e.local_qp().get_cql_stats();
+        auto covered_reads = stats.secondary_index_covered_reads;
+
+        auto msg = e.execute_cql("SELECT name, email FROM users WHERE country = 'France';").get();
+        assert_that(msg).is_rows().with_rows({
+            { utf8_type->decompose(sstring("Demetri Curror")), utf8_type->decompose(sstring("dcurrorw@techcrunch.com")) },
+            { utf8_type->decompose(sstring("Bondie Easseby")), utf8_type->decompose(sstring("beassebyv@house.gov")) },
+        });
+        msg = e.execute_cql("SELECT userid, email FROM users WHERE country = 'United States';").get();
+        assert_that(msg).is_rows().with_rows({
+            { int32_type->decompose(2), std::nullopt },
+        });
+        BOOST_REQUIRE_EQUAL(stats.secondary_index_covered_reads, covered_reads + 2);
+
+        // Updates of the included columns reach the index.
+        e.execute_cql("UPDATE users SET email = 'lpaulischm@reverbnation.com' WHERE userid = 2;").get();
+        msg = e.execute_cql("SELECT email FROM users WHERE country = 'United States';").get();
+        assert_that(msg).is_rows().with_rows({
+            { utf8_type->decompose(sstring("lpaulischm@reverbnation.com")) },
+        });
+
+        // Selecting a column which isn't included reads the base table.
+        covered_reads = stats.secondary_index_covered_reads;
+        e.execute_cql("ALTER TABLE users ADD age int;").get();
+        e.execute_cql("UPDATE users SET age = 30 WHERE userid = 2;").get();
+        msg = e.execute_cql("SELECT age FROM users WHERE country = 'United States';").get();
+        assert_that(msg).is_rows().with_rows({
+            { int32_type->decompose(30) },
+        });
+        BOOST_REQUIRE_EQUAL(stats.secondary_index_covered_reads, covered_reads);
+
+        // Included columns can't be dropped while the index exists.
+        BOOST_REQUIRE_THROW(e.execute_cql("ALTER TABLE users DROP email;").get(), ire);
+    });
+}
+
 SEASTAR_TEST_CASE(test_secondary_index_clustering_key_query) {
     return do_with_cql_env([] (cql_test_env& e) -> future<> {
         co_await e.execute_cql("CREATE TABLE users (userid int, name text, email text, country text, PRIMARY KEY (userid, country));");
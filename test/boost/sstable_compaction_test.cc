@@ -786,6 +786,113 @@ SEASTAR_TEST_CASE(leveled_06) {
   });
 }
 
+SEASTAR_TEST_CASE(leveled_level_up_passes_through_sstable) {
+    // Test that promoting an sstable with nothing to purge to the next level doesn't rewrite it.
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "leveled_level_up_passes_through_sstable")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type);
+        builder.set_compaction_strategy(sstables::compaction_strategy_type::leveled);
+        auto s = builder.build();
+
+        auto cf = env.make_table_for_tests(s);
+        auto stop_cf = deferred_stop(cf);
+        auto sst_gen = env.make_sst_factory(s);
+
+        std::vector<mutation> muts;
+        for (int32_t pk = 0; pk < 10; ++pk) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(pk)));
+            m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(0)), to_bytes("v"), int32_t(pk), api::new_timestamp());
+            muts.push_back(std::move(m));
+        }
+        std::ranges::sort(muts, mutation_decorated_key_less_comparator());
+        auto sst = make_sstable_containing(sst_gen, muts);
+        auto data_size = sst->data_size();
+
+        auto ret = compact_sstables(env, sstables::compaction_descriptor({sst}, /*level*/ 1), cf, sst_gen).get();
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1u);
+        auto new_sst = ret.new_sstables.front();
+        BOOST_REQUIRE_NE(new_sst->generation(), sst->generation());
+        BOOST_REQUIRE_EQUAL(new_sst->get_sstable_level(), 1u);
+        BOOST_REQUIRE_EQUAL(new_sst->data_size(), data_size);
+        // The input keeps its level.
+        BOOST_REQUIRE_EQUAL(sst->get_sstable_level(), 0u);
+
+        auto reader = assert_that(new_sst->as_mutation_source().make_reader_v2(s, env.make_reader_permit()));
+        for (auto& m : muts) {
+            reader.produces(m);
+        }
+        reader.produces_end_of_stream();
+
+        // The level survives reloading the sstable.
+        auto reloaded = env.reusable_sst(new_sst).get();
+        BOOST_REQUIRE_EQUAL(reloaded->get_sstable_level(), 1u);
+    });
+}
+
+SEASTAR_TEST_CASE(leveled_reshape_passes_through_disjoint_sstables) {
+    // Test that reshaping disjoint sstables into a level, like off-strategy does with
+    // sstables streamed by node operations, doesn't rewrite them.
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "leveled_reshape_passes_through_disjoint_sstables")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type);
+        builder.set_compaction_strategy(sstables::compaction_strategy_type::leveled);
+        auto s = builder.build();
+
+        auto cf = env.make_table_for_tests(s);
+        auto stop_cf = deferred_stop(cf);
+        auto sst_gen = env.make_sst_factory(s);
+
+        std::vector<mutation> muts;
+        for (int32_t pk = 0; pk < 20; ++pk) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(pk)));
+            m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(0)), to_bytes("v"), int32_t(pk), api::new_timestamp());
+            muts.push_back(std::move(m));
+        }
+        std::ranges::sort(muts, mutation_decorated_key_less_comparator());
+        auto half = muts.size() / 2;
+        auto sst1 = make_sstable_containing(sst_gen, std::vector<mutation>(muts.begin(), muts.begin() + half));
+        auto sst2 = make_sstable_containing(sst_gen, std::vector<mutation>(muts.begin() + half, muts.end()));
+        auto max_sstable_bytes = std::max(sst1->data_size(), sst2->data_size());
+
+        auto reshape = [&] (std::vector<shared_sstable> ssts) {
+            auto desc = sstables::compaction_descriptor(std::move(ssts), /*level*/ 2, max_sstable_bytes);
+            desc.options = compaction_type_options::make_reshape();
+            return compact_sstables(env, std::move(desc), cf, sst_gen).get();
+        };
+
+        auto ret = reshape({sst1, sst2});
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 2u);
+        for (auto& new_sst : ret.new_sstables) {
+            BOOST_REQUIRE_EQUAL(new_sst->get_sstable_level(), 2u);
+        }
+        BOOST_REQUIRE_EQUAL(ret.new_sstables[0]->data_size() + ret.new_sstables[1]->data_size(), sst1->data_size() + sst2->data_size());
+        auto new_ssts = ret.new_sstables;
+        std::ranges::sort(new_ssts, [&] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_first_decorated_key().less_compare(*s, b->get_first_decorated_key());
+        });
+        auto reader = assert_that(make_combined_reader(s, env.make_reader_permit(), {
+                new_ssts[0]->as_mutation_source().make_reader_v2(s, env.make_reader_permit()),
+                new_ssts[1]->as_mutation_source().make_reader_v2(s, env.make_reader_permit())}));
+        for (auto& m : muts) {
+            reader.produces(m);
+        }
+        reader.produces_end_of_stream();
+
+        // Overlapping sstables are merged as usual: sst1 is contained in sst3.
+        auto sst3 = make_sstable_containing(sst_gen, muts);
+        ret = reshape({sst1, sst3});
+        uint64_t merged_size = 0;
+        for (auto& new_sst : ret.new_sstables) {
+            merged_size += new_sst->data_size();
+        }
+        BOOST_REQUIRE_LT(merged_size, sst1->data_size() + sst3->data_size());
+    });
+}
+
 SEASTAR_TEST_CASE(leveled_07) {
   return test_env::do_with_async([] (test_env& env) {
     auto cf = env.make_table_for_tests();
@@ -954,6 +1061,28 @@ SEASTAR_TEST_CASE(check_overlapping) {
   });
 }
 
+SEASTAR_TEST_CASE(check_sublevel_count) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto s = table_for_tests::make_default_schema();
+    const auto keys = tests::generate_partition_keys(6, s);
+
+    auto sst = [&] (size_t first, size_t last) {
+        return sstable_for_overlapping_test(env, s, keys[first].key(), keys[last].key());
+    };
+
+    BOOST_REQUIRE_EQUAL(leveled_manifest::sublevel_count(*s, {}), 0u);
+    // disjoint sstables make a single sub-level, in any order
+    BOOST_REQUIRE_EQUAL(leveled_manifest::sublevel_count(*s, { sst(4, 5), sst(0, 1), sst(2, 3) }), 1u);
+    // sstables sharing a boundary key overlap
+    BOOST_REQUIRE_EQUAL(leveled_manifest::sublevel_count(*s, { sst(0, 2), sst(2, 3) }), 2u);
+    // full-range sstables, like flushed ones, each need its own sub-level
+    BOOST_REQUIRE_EQUAL(leveled_manifest::sublevel_count(*s, { sst(0, 5), sst(0, 5), sst(0, 5) }), 3u);
+    // a wide sstable overlapping disjoint ones adds a single sub-level
+    BOOST_REQUIRE_EQUAL(leveled_manifest::sublevel_count(*s, { sst(0, 5), sst(0, 1), sst(2, 3), sst(4, 5) }), 2u);
+    BOOST_REQUIRE_EQUAL(leveled_manifest::sublevel_count(*s, { sst(0, 2), sst(1, 3), sst(3, 4), sst(4, 5) }), 2u);
+  });
+}
+
 SEASTAR_TEST_CASE(tombstone_purge_test) {
     BOOST_REQUIRE(smp::count == 1);
     return test_env::do_with_async([] (test_env& env) {
@@ -1483,6 +1612,20 @@ SEASTAR_TEST_CASE(get_fully_expired_sstables_test) {
         auto expired_sst = *expired.begin();
         BOOST_REQUIRE(expired_sst == sst1);
     }
+
+    {
+        auto cf = env.make_table_for_tests();
+        auto close_cf = deferred_stop(cf);
+
+        // sst2 holds older live data, but its token range is disjoint from the expired sst1's.
+        auto sst1 = add_sstable_for_overlapping_test(env, cf, min_key.key(), keys[1].key(), build_stats(t1, t2, t1));
+        auto sst2 = add_sstable_for_overlapping_test(env, cf, keys[2].key(), max_key.key(), build_stats(t0, t1, std::numeric_limits<int32_t>::max()));
+        auto sst3 = add_sstable_for_overlapping_test(env, cf, min_key.key(), max_key.key(), build_stats(t3, t4, std::numeric_limits<int32_t>::max()));
+        std::vector<sstables::shared_sstable> compacting = { sst1, sst2 };
+        auto expired = get_fully_expired_sstables(cf.as_table_state(), compacting, /*gc before*/gc_clock::from_time_t(15) + cf->schema()->gc_grace_seconds());
+        BOOST_REQUIRE(expired.size() == 1);
+        BOOST_REQUIRE(*expired.begin() == sst1);
+    }
   });
 }
 
@@ -1843,6 +1986,43 @@ SEASTAR_TEST_CASE(size_tiered_beyond_max_threshold_test) {
   });
 }
 
+SEASTAR_TEST_CASE(incremental_compaction_strategy_compacts_whole_runs) {
+  return test_env::do_with_async([] (test_env& env) {
+    auto builder = schema_builder("tests", "incremental_compaction_strategy_compacts_whole_runs")
+            .with_column("id", utf8_type, column_kind::partition_key)
+            .with_column("value", int32_type);
+    builder.set_compaction_strategy(sstables::compaction_strategy_type::incremental);
+    builder.set_compaction_strategy_options({{"sstable_size_in_mb", "1"}});
+    auto s = builder.build();
+
+    auto cf = env.make_table_for_tests(s);
+    auto stop_cf = deferred_stop(cf);
+    auto sst_gen = env.make_sst_factory(s);
+    auto cs = sstables::make_compaction_strategy(s->compaction_strategy(), s->compaction_strategy_options());
+
+    constexpr size_t runs = 4;
+    constexpr size_t fragments_per_run = 2;
+    auto keys = tests::generate_partition_keys(fragments_per_run, s);
+    for (size_t i = 0; i < runs; i++) {
+        auto run_identifier = run_id::create_random_id();
+        for (auto& key : keys) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(i)), api::new_timestamp());
+            auto sst = make_sstable_containing(sst_gen, {std::move(m)});
+            sstables::test(sst).set_run_identifier(run_identifier);
+            column_family_test(cf).add_sstable(sst).get();
+        }
+    }
+    BOOST_REQUIRE_EQUAL(cf->get_sstables()->size(), runs * fragments_per_run);
+
+    // All runs are of the same size, so they are compacted together, with all of their fragments.
+    auto desc = get_sstables_for_compaction(cs, cf.as_table_state(), {});
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), runs * fragments_per_run);
+    BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, uint64_t(1) << 20);
+    BOOST_REQUIRE_EQUAL(desc.fan_in(), runs);
+  });
+}
+
 SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     return test_env::do_with_async([] (test_env& env) {
         auto make_schema = [&] (std::string_view cf, sstables::compaction_strategy_type cst) {
@@ -1913,6 +2093,16 @@ SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
         BOOST_REQUIRE(descriptor.sstables.size() == 1);
         BOOST_REQUIRE(descriptor.sstables.front() == sst);
 
+        // an older sstable overlapping with it would keep its tombstones from being purged, so it's compacted too
+        {
+            auto older = env.make_sstable(stcs_schema);
+            sstables::test(older).set_values(sst->get_first_decorated_key().key(), sst->get_first_decorated_key().key(), build_stats(0, 1, 0));
+            auto descriptor = get_sstables_for_compaction(cs, stcs_table.as_table_state(), { sst, older });
+            BOOST_REQUIRE_EQUAL(descriptor.sstables.size(), 2u);
+            BOOST_REQUIRE(descriptor.sstables.front() == sst);
+            BOOST_REQUIRE(descriptor.sstables.back() == older);
+        }
+
         // Makes sure that get_sstables_for_compaction() is called with a table_state which will provide
         // the correct LCS state.
         auto lcs_table = env.make_table_for_tests(make_schema("lcs", sstables::compaction_strategy_type::leveled));
@@ -4621,6 +4811,74 @@ SEASTAR_TEST_CASE(test_twcs_single_key_reader_filtering) {
     });
 }
 
+SEASTAR_TEST_CASE(test_twcs_single_key_reader_skips_sstables_ending_before_slice) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "twcs_single_key_reader_skips_sstables_ending_before_slice")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type);
+        builder.set_compaction_strategy(sstables::compaction_strategy_type::time_window);
+        auto s = builder.build();
+
+        auto sst_gen = env.make_sst_factory(s);
+
+        auto make_ck = [&] (int32_t ck) {
+            return clustering_key::from_single_value(*s, int32_type->decompose(ck));
+        };
+
+        auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::time_window, {});
+        auto set = cs.make_sstable_set(s);
+
+        // One sstable per time window, each holding a single row of the partition.
+        const int32_t windows = 10;
+        std::optional<dht::decorated_key> dkey;
+        for (int32_t ck = 0; ck < windows; ++ck) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(0)));
+            m.set_clustered_cell(make_ck(ck), to_bytes("v"), int32_t(0), api::new_timestamp());
+            dkey = m.decorated_key();
+            set.insert(make_sstable_containing(sst_gen, {std::move(m)}));
+        }
+
+        auto cf = env.make_table_for_tests(s);
+        auto close_cf = deferred_stop(cf);
+        cf->start();
+
+        reader_permit permit = env.make_reader_permit();
+        utils::estimated_histogram eh;
+        auto pr = dht::partition_range::make_singular(*dkey);
+        auto& cf_stats = cf.cf_stats();
+
+        auto check = [&] (schema_ptr query_schema, const query::partition_slice& slice, std::vector<int32_t> expected_rows) {
+            auto checked_by_ck = cf_stats.sstables_checked_by_clustering_filter;
+
+            auto reader = set.create_single_key_sstable_reader(
+                    &*cf, query_schema, permit, eh, pr, slice,
+                    tracing::trace_state_ptr(), ::streamed_mutation::forwarding::no,
+                    ::mutation_reader::forwarding::no);
+            auto assertions = assert_that(std::move(reader));
+            assertions.produces_partition_start(*dkey);
+            for (auto ck : expected_rows) {
+                assertions.produces_row_with_key(make_ck(ck));
+            }
+            assertions.produces_partition_end().produces_end_of_stream();
+
+            // Only the sstables which don't end before the queried range are considered.
+            BOOST_REQUIRE_LE(cf_stats.sstables_checked_by_clustering_filter - checked_by_ck, expected_rows.size());
+        };
+
+        auto slice = partition_slice_builder(*s)
+                    .with_range(query::clustering_range::make(make_ck(windows - 2), make_ck(windows - 1)))
+                    .build();
+        check(s, slice, {windows - 2, windows - 1});
+
+        // In reverse, the sstables holding the lowest rows are the last ones.
+        auto reversed_slice = query::reverse_slice(*s, partition_slice_builder(*s)
+                    .with_range(query::clustering_range::make(make_ck(0), make_ck(1)))
+                    .build());
+        check(s->make_reversed(), reversed_slice, {1, 0});
+    });
+}
+
 SEASTAR_TEST_CASE(max_ongoing_compaction_test) {
     return test_env::do_with_async([] (test_env& env) {
         BOOST_REQUIRE(smp::count == 1);
@@ -5096,6 +5354,10 @@ SEASTAR_TEST_CASE(simple_backlog_controller_test_leveled) {
     return run_controller_test(sstables::compaction_strategy_type::leveled);
 }
 
+SEASTAR_TEST_CASE(simple_backlog_controller_test_incremental) {
+    return run_controller_test(sstables::compaction_strategy_type::incremental);
+}
+
 SEASTAR_TEST_CASE(test_compaction_strategy_cleanup_method) {
     return test_env::do_with_async([] (test_env& env) {
         constexpr size_t all_files = 64;
@@ -5182,6 +5444,8 @@ SEASTAR_TEST_CASE(test_compaction_strategy_cleanup_method) {
         // LCS: Check that 1 jobs is returned for all non-overlapping files in level 1, as incremental compaction can be employed
         // to limit memory usage and space requirement.
         run_cleanup_strategy_test(sstables::compaction_strategy_type::leveled, 64, empty_opts, 0ms, 1);
+        // ICS: Check that it will return one job for each run, and every file is a run of its own here.
+        run_cleanup_strategy_test(sstables::compaction_strategy_type::incremental, 1);
     });
 }
 
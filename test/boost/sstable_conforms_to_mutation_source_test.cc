@@ -89,10 +89,11 @@ void test_cache_population_with_range_tombstone_adjacent_to_population_range(pop
             .produces_end_of_stream();
 }
 
-static future<> test_sstable_conforms_to_mutation_source(sstable_version_types version, int index_block_size) {
-    return sstables::test_env::do_with_async([version, index_block_size] (sstables::test_env& env) {
+static future<> test_sstable_conforms_to_mutation_source(sstable_version_types version, int index_block_size, bool promoted_index_summary = false) {
+    return sstables::test_env::do_with_async([version, index_block_size, promoted_index_summary] (sstables::test_env& env) {
         sstable_writer_config cfg = env.manager().configure_writer();
         cfg.promoted_index_block_size = index_block_size;
+        cfg.promoted_index_summary = promoted_index_summary;
 
         std::vector<tmpdir> dirs;
         auto populate = [&env, &dirs, &cfg, version] (schema_ptr s, const std::vector<mutation>& partitions,
@@ -126,6 +127,10 @@ SEASTAR_TEST_CASE(test_sstable_conforms_to_mutation_source_mc_large) {
     return test_sstable_conforms_to_mutation_source(writable_sstable_versions[0], block_sizes[2]);
 }
 
+SEASTAR_TEST_CASE(test_sstable_conforms_to_mutation_source_mc_tiny_with_promoted_index_summary) {
+    return test_sstable_conforms_to_mutation_source(writable_sstable_versions[0], block_sizes[0], true);
+}
+
 SEASTAR_TEST_CASE(test_sstable_conforms_to_mutation_source_md_tiny) {
     return test_sstable_conforms_to_mutation_source(writable_sstable_versions[1], block_sizes[0]);
 }
@@ -2320,6 +2320,54 @@ SEASTAR_TEST_CASE(summary_rebuild_sanity) {
     });
 }
 
+SEASTAR_TEST_CASE(summary_downsampling_on_load) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "test")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", utf8_type);
+        builder.set_compressor_params(compression_parameters::no_compression());
+        auto s = builder.build(schema_builder::compact_storage::no);
+        const column_definition& col = *s->get_column_definition("value");
+
+        std::vector<mutation> mutations;
+        for (auto i = 0; i < s->min_index_interval() * 4; i++) {
+            mutation m(s, partition_key::from_exploded(*s, {to_bytes("key" + to_sstring(i))}));
+            m.set_clustered_cell(clustering_key::make_empty(), col, make_atomic_cell(utf8_type, bytes(100, 'a')));
+            mutations.push_back(std::move(m));
+        }
+
+        // Write a summary with many more entries than the default ratio allows.
+        env.db_config().sstable_summary_ratio.set(0.1);
+        auto sst = make_sstable_containing(env.make_sstable(s), mutations);
+        auto entries = sst->get_summary().entries.size();
+        BOOST_REQUIRE_GT(entries, 16);
+
+        env.db_config().sstable_summary_ratio.set(0.0005);
+        sst = env.reusable_sst(sst).get();
+        BOOST_REQUIRE_EQUAL(sst->get_summary().entries.size(), entries);
+
+        env.db_config().enable_sstable_summary_downsampling.set(true);
+        sst = env.reusable_sst(sst).get();
+        const auto& summary = sst->get_summary();
+        BOOST_REQUIRE_LT(summary.entries.size(), entries);
+        BOOST_REQUIRE_EQUAL(summary.header.size, summary.entries.size());
+        BOOST_REQUIRE_EQUAL(summary.positions.size(), summary.entries.size());
+
+        std::sort(mutations.begin(), mutations.end(), mutation_decorated_key_less_comparator());
+        auto rd = assert_that(sst->as_mutation_source().make_reader_v2(s, env.make_reader_permit(), query::full_partition_range));
+        for (auto& m : mutations) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+        for (auto& m : mutations) {
+            auto pr = dht::partition_range::make_singular(m.decorated_key());
+            assert_that(sst->as_mutation_source().make_reader_v2(s, env.make_reader_permit(), pr))
+                .produces(m)
+                .produces_end_of_stream();
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(sstable_partition_estimation_sanity_test) {
     return test_env::do_with_async([] (test_env& env) {
         auto builder = schema_builder("tests", "test")
@@ -3201,3 +3249,70 @@ SEASTAR_TEST_CASE(sstable_identifier_correctness) {
         BOOST_REQUIRE_EQUAL(sst->sstable_identifier()->uuid(), sst->generation().as_uuid());
     });
 }
+
+SEASTAR_TEST_CASE(test_sstable_postings) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("ks", "cf")
+                .with_column("p", int32_type, column_kind::partition_key)
+                .with_column("c", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type)
+                .with_column("w", int32_type)
+                .with_column("x", int32_type)
+                .with_index(index_metadata("v_idx", {{"target", "v"}}, index_metadata_kind::composites, index_metadata::is_local_index::no))
+                .with_index(index_metadata("w_idx", {{"target", "w"}}, index_metadata_kind::composites, index_metadata::is_local_index::no))
+                .build();
+        const auto& v_def = *s->get_column_definition("v");
+        const auto& w_def = *s->get_column_definition("w");
+        const auto& x_def = *s->get_column_definition("x");
+
+        // v has 3 values, w has a value per partition, too many for postings,
+        // and x isn't indexed.
+        const int partitions = 1100;
+        std::vector<mutation> muts;
+        for (int p = 0; p < partitions; ++p) {
+            mutation m(s, partition_key::from_single_value(*s, int32_type->decompose(p)));
+            for (int c = 0; c < 2; ++c) {
+                auto ck = clustering_key::from_single_value(*s, int32_type->decompose(c));
+                m.set_clustered_cell(ck, v_def, atomic_cell::make_live(*v_def.type, 1, int32_type->decompose(p % 3)));
+                m.set_clustered_cell(ck, w_def, atomic_cell::make_live(*w_def.type, 1, int32_type->decompose(p)));
+                m.set_clustered_cell(ck, x_def, atomic_cell::make_live(*x_def.type, 1, int32_type->decompose(0)));
+            }
+            // A deleted cell doesn't hold its value.
+            auto ck = clustering_key::from_single_value(*s, int32_type->decompose(2));
+            m.set_clustered_cell(ck, v_def, atomic_cell::make_dead(1, gc_clock::now()));
+            muts.push_back(std::move(m));
+        }
+        std::ranges::sort(muts, mutation_decorated_key_less_comparator());
+
+        auto cfg = env.manager().configure_writer();
+        cfg.postings = true;
+        auto sst = make_sstable_easy(env, make_mutation_reader_from_mutations_v2(s, env.make_reader_permit(), muts), cfg,
+                sstables::get_highest_sstable_version(), partitions);
+
+        BOOST_REQUIRE(!sst->get_column_postings(w_def));
+        BOOST_REQUIRE(!sst->get_column_postings(x_def));
+        auto* v_postings = sst->get_column_postings(v_def);
+        BOOST_REQUIRE(v_postings);
+        BOOST_REQUIRE_EQUAL(v_postings->values.elements.size(), 3);
+        BOOST_REQUIRE(!v_postings->find(int32_type->decompose(3)));
+
+        std::set<uint64_t> positions;
+        for (int v = 0; v < 3; ++v) {
+            auto* vp = v_postings->find(int32_type->decompose(v));
+            BOOST_REQUIRE(vp);
+            auto& pos = vp->partitions.elements;
+            BOOST_REQUIRE_EQUAL(pos.size(), (partitions - v + 2) / 3);
+            BOOST_REQUIRE(std::ranges::is_sorted(pos));
+            positions.insert(pos.begin(), pos.end());
+        }
+        // Every partition holds one of the values, once.
+        BOOST_REQUIRE_EQUAL(positions.size(), partitions);
+        BOOST_REQUIRE_EQUAL(*positions.begin(), 0);
+
+        // Without the option, the component isn't written.
+        auto sst2 = make_sstable_easy(env, make_mutation_reader_from_mutations_v2(s, env.make_reader_permit(), muts), env.manager().configure_writer(),
+                sstables::get_highest_sstable_version(), partitions);
+        BOOST_REQUIRE(!sst2->has_component(component_type::Postings));
+        BOOST_REQUIRE(!sst2->get_column_postings(v_def));
+    });
+}
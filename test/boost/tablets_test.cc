@@ -2706,6 +2706,84 @@ SEASTAR_THREAD_TEST_CASE(test_load_balancing_resize_requests) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_load_balancing_resize_requests_driven_by_load) {
+    cql_test_config cfg;
+    const uint64_t target_tablet_ops_rate = 1000;
+    cfg.db_config->target_tablet_ops_per_second(target_tablet_ops_rate);
+    do_with_cql_env_thread([&] (auto& e) {
+        inet_address ip1("192.168.0.1");
+        auto host1 = host_id(next_uuid());
+        auto table1 = table_id(next_uuid());
+        unsigned shard_count = 2;
+
+        semaphore sem(1);
+        shared_token_metadata stm([&sem] () noexcept { return get_units(sem, 1); }, locator::token_metadata::config{
+                locator::topology::config{
+                        .this_endpoint = ip1,
+                        .local_dc_rack = locator::endpoint_dc_rack::default_location
+                }
+        });
+
+        stm.mutate_token_metadata([&] (token_metadata& tm) {
+            tm.update_host_id(host1, ip1);
+            tm.update_topology(host1, locator::endpoint_dc_rack::default_location, node::state::normal, shard_count);
+
+            tablet_map tmap(2);
+            for (auto tid : tmap.tablet_ids()) {
+                tmap.set_tablet(tid, tablet_info {
+                        tablet_replica_set {
+                                tablet_replica {host1, tests::random::get_int<shard_id>(0, shard_count - 1)},
+                        }
+                });
+            }
+            tablet_metadata tmeta;
+            tmeta.set_tablet_map(table1, std::move(tmap));
+            tm.set_tablets(std::move(tmeta));
+            return make_ready_future<>();
+        }).get();
+
+        auto tablet_count = [&] {
+            return stm.get()->tablets().get_tablet_map(table1).tablet_count();
+        };
+        auto resize_decision = [&] {
+            return stm.get()->tablets().get_tablet_map(table1).resize_decision();
+        };
+        auto do_rebalance_tablets = [&] (double ops_rate_pctg) {
+            // Small tablets, which would be merged if they weren't hot.
+            locator::load_stats load_stats = {
+                .tables = {
+                    { table1, table_load_stats{
+                        .size_in_bytes = 0,
+                        .split_ready_seq_number = std::numeric_limits<locator::resize_decision::seq_number_t>::min(),
+                        .ops_per_second = ops_rate_pctg * target_tablet_ops_rate * 2 * tablet_count() }},
+                }
+            };
+            rebalance_tablets(e.get_tablet_allocator().local(), stm, make_lw_shared(std::move(load_stats)));
+        };
+
+        // The tablets are small, but too hot to be merged.
+        do_rebalance_tablets(0.3);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision().way));
+
+        // The tablets are small and cold.
+        do_rebalance_tablets(0.1);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::merge>(resize_decision().way));
+
+        // The load grew while merging.
+        do_rebalance_tablets(0.6);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::none>(resize_decision().way));
+
+        // The tablets are small, but too hot.
+        do_rebalance_tablets(1.1);
+        BOOST_REQUIRE_EQUAL(tablet_count(), 2);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::split>(resize_decision().way));
+
+        // The split isn't cancelled due to the size of the tablets as long as they are hot.
+        do_rebalance_tablets(0.6);
+        BOOST_REQUIRE(std::holds_alternative<locator::resize_decision::split>(resize_decision().way));
+    }, cfg).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_tablet_range_splitter) {
     simple_schema ss;
 
@@ -8,10 +8,18 @@
 
 #include "test/lib/scylla_test_case.hh"
 
+#include <seastar/core/file.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/util/closeable.hh>
+
+#include "reader_concurrency_semaphore.hh"
 #include "tracing/tracing.hh"
 #include "tracing/trace_state.hh"
 
+#include "test/lib/cql_assertions.hh"
 #include "test/lib/cql_test_env.hh"
+#include "test/lib/tmpdir.hh"
 
 future<> do_with_tracing_env(std::function<future<>(cql_test_env&)> func, cql_test_config cfg_in = {}) {
     return do_with_cql_env_thread([func](auto &env) {
@@ -80,3 +88,142 @@ SEASTAR_TEST_CASE(tracing_slow_query_fast_mode) {
         return make_ready_future<>();
     });
 }
+
+SEASTAR_TEST_CASE(tracing_read_cost) {
+    return do_with_tracing_env([](auto &e) {
+        using namespace std::chrono_literals;
+        tracing::tracing &t = tracing::tracing::get_local_tracing_instance();
+
+        tracing::trace_state_props_set trace_props;
+        trace_props.set(tracing::trace_state_props::full_tracing);
+
+        tracing::trace_state_ptr trace_state = t.create_session(tracing::trace_type::QUERY, trace_props);
+        tracing::begin(trace_state, "begin", gms::inet_address());
+
+        reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::no_limits{}, "tracing_read_cost", reader_concurrency_semaphore::register_metrics::no);
+        auto stop_semaphore = deferred_stop(semaphore);
+        auto permit = semaphore.make_tracking_only_permit(nullptr, "test", db::no_timeout, trace_state);
+        BOOST_REQUIRE_EQUAL(permit.read_cost(), &trace_state->get_read_cost());
+        BOOST_REQUIRE(trace_state->get_read_cost().empty());
+
+        tmpdir dir;
+        const auto path = (dir.path() / "data").native();
+        {
+            auto f = open_file_dma(path, open_flags::wo | open_flags::create).get();
+            auto close_f = deferred_close(f);
+            auto buf = temporary_buffer<char>::aligned(4096, 4096);
+            std::fill_n(buf.get_write(), buf.size(), 'x');
+            f.dma_write(0, buf.get(), buf.size()).get();
+        }
+        {
+            auto f = make_tracked_file(open_file_dma(path, open_flags::ro).get(), permit, tracked_file_kind::data);
+            auto close_f = deferred_close(f);
+            BOOST_REQUIRE_EQUAL(f.dma_read_bulk<char>(0, 4096).get().size(), 4096);
+        }
+
+        {
+            reader_permit::need_cpu_guard need_cpu(permit);
+            seastar::sleep(10ms).get();
+            reader_permit::awaits_guard awaits(permit);
+            // Time spent waiting for I/O is not accounted as need_cpu time.
+            seastar::sleep(100ms).get();
+        }
+
+        const auto& cost = trace_state->get_read_cost();
+        BOOST_REQUIRE_EQUAL(cost.data_reads, 1);
+        BOOST_REQUIRE_EQUAL(cost.data_bytes_read, 4096);
+        BOOST_REQUIRE_EQUAL(cost.index_reads, 0);
+        BOOST_REQUIRE_EQUAL(cost.index_bytes_read, 0);
+        BOOST_REQUIRE_GE(cost.need_cpu_time.count(), 10000);
+        BOOST_REQUIRE_LT(cost.need_cpu_time.count(), 100000);
+
+        return make_ready_future<>();
+    });
+}
+
+SEASTAR_TEST_CASE(tracing_slow_query_max_events) {
+    return do_with_tracing_env([](auto &e) {
+        using namespace std::chrono_literals;
+        tracing::tracing &t = tracing::tracing::get_local_tracing_instance();
+
+        t.set_ignore_trace_events(false);
+        t.set_slow_query_threshold(std::chrono::duration_cast<std::chrono::microseconds>(1h));
+        t.set_slow_query_max_events(3);
+
+        tracing::trace_state_props_set trace_props;
+        trace_props.set(tracing::trace_state_props::log_slow_query);
+
+        // A query which is not known to be slow keeps only its latest events.
+        tracing::trace_state_ptr trace_state1 = t.create_session(tracing::trace_type::QUERY, trace_props);
+        tracing::begin(trace_state1, "begin", gms::inet_address());
+        for (int i = 0; i < 5; ++i) {
+            tracing::trace(trace_state1, "trace {}", i);
+        }
+        BOOST_CHECK_EQUAL(trace_state1->events_size(), 3);
+
+        // Failures are ignored unless they are to be logged.
+        tracing::set_failed(trace_state1, "error");
+        tracing::trace(trace_state1, "trace 5");
+        BOOST_CHECK_EQUAL(trace_state1->events_size(), 3);
+
+        // A failed query is logged, so it keeps all of its events from then on.
+        t.set_slow_query_log_failures(true);
+        tracing::trace_state_ptr trace_state2 = t.create_session(tracing::trace_type::QUERY, trace_props);
+        tracing::begin(trace_state2, "begin", gms::inet_address());
+        for (int i = 0; i < 5; ++i) {
+            tracing::trace(trace_state2, "trace {}", i);
+        }
+        tracing::set_failed(trace_state2, "error");
+        tracing::trace(trace_state2, "trace 5");
+        tracing::trace(trace_state2, "trace 6");
+        BOOST_CHECK_EQUAL(trace_state2->events_size(), 5);
+
+        // Full tracing is not limited.
+        trace_props.set(tracing::trace_state_props::full_tracing);
+        tracing::trace_state_ptr trace_state3 = t.create_session(tracing::trace_type::QUERY, trace_props);
+        tracing::begin(trace_state3, "begin", gms::inet_address());
+        for (int i = 0; i < 5; ++i) {
+            tracing::trace(trace_state3, "trace {}", i);
+        }
+        BOOST_CHECK_EQUAL(trace_state3->events_size(), 5);
+
+        return make_ready_future<>();
+    });
+}
+
+SEASTAR_TEST_CASE(tracing_log_backend) {
+    auto dir = make_lw_shared<tmpdir>();
+    cql_test_config cfg;
+    cfg.db_config->tracing_log_directory.set(dir->path().native());
+    return do_with_cql_env_thread([dir] (cql_test_env& e) {
+        sharded<tracing::tracing>& tracing = tracing::tracing::tracing_instance();
+        tracing.start(sstring("trace_log_helper")).get();
+        auto stop = defer([&tracing] { tracing.stop().get(); });
+        tracing.invoke_on_all(&tracing::tracing::start, std::ref(e.qp()), std::ref(e.migration_manager())).get();
+
+        utils::UUID session_id;
+        {
+            tracing::trace_state_props_set trace_props;
+            trace_props.set(tracing::trace_state_props::full_tracing);
+            auto trace_state = tracing.local().create_session(tracing::trace_type::QUERY, trace_props);
+            tracing::begin(trace_state, "begin", gms::inet_address("127.0.0.1"));
+            tracing::trace(trace_state, "trace 1");
+            tracing::trace(trace_state, "trace 2");
+            session_id = trace_state->session_id();
+        }
+        // Writes the records of the session.
+        stop.cancel();
+        tracing.stop().get();
+
+        auto res = e.execute_cql(format("SELECT activity FROM system.trace_log_events WHERE session_id = {}", session_id)).get();
+        assert_that(res).is_rows().with_rows({
+            {utf8_type->decompose("trace 1")},
+            {utf8_type->decompose("trace 2")},
+        });
+
+        res = e.execute_cql(format("SELECT request, command FROM system.trace_log_sessions WHERE session_id = {}", session_id)).get();
+        assert_that(res).is_rows().with_rows({
+            {utf8_type->decompose("begin"), utf8_type->decompose("QUERY")},
+        });
+    }, std::move(cfg));
+}
@@ -11,6 +11,7 @@
 #include <fmt/ranges.h>
 #include <fmt/std.h>
 
+#include "transport/queueing_delay_controller.hh"
 #include "transport/request.hh"
 #include "transport/response.hh"
 
@@ -171,3 +172,41 @@ SEASTAR_THREAD_TEST_CASE(test_response_request_reader) {
     BOOST_CHECK_EQUAL(req.read_short(), 1);
     BOOST_CHECK_EQUAL(req.read_string(), "zed");
 }
+
+SEASTAR_THREAD_TEST_CASE(test_queueing_delay_controller) {
+    using namespace std::chrono_literals;
+    using clock = cql_transport::queueing_delay_controller::clock;
+    cql_transport::queueing_delay_controller controller(10ms, 100ms);
+    auto now = clock::now();
+
+    // A burst of delayed requests shorter than the interval is not shed.
+    controller.on_request_started(20ms, now);
+    controller.on_request_started(20ms, now + 50ms);
+    BOOST_REQUIRE(!controller.should_shed(now + 50ms));
+
+    // A request below the target restarts the interval.
+    controller.on_request_started(5ms, now + 60ms);
+    controller.on_request_started(20ms, now + 70ms);
+    controller.on_request_started(20ms, now + 150ms);
+    BOOST_REQUIRE(!controller.should_shed(now + 150ms));
+
+    // The delay stayed above the target for a whole interval.
+    controller.on_request_started(20ms, now + 170ms);
+    BOOST_REQUIRE(controller.should_shed(now + 170ms));
+    BOOST_REQUIRE(controller.should_shed(now + 260ms));
+
+    // No delayed request was seen for an interval, e.g. the queue drained.
+    BOOST_REQUIRE(!controller.should_shed(now + 270ms));
+
+    controller.on_request_started(20ms, now + 300ms);
+    controller.on_request_started(20ms, now + 400ms);
+    BOOST_REQUIRE(controller.should_shed(now + 400ms));
+    controller.on_request_started(1ms, now + 410ms);
+    BOOST_REQUIRE(!controller.should_shed(now + 410ms));
+
+    // A zero target disables shedding.
+    controller.set_target(clock::duration::zero());
+    controller.on_request_started(1s, now + 500ms);
+    controller.on_request_started(1s, now + 700ms);
+    BOOST_REQUIRE(!controller.should_shed(now + 700ms));
+}
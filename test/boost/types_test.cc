@@ -495,6 +495,32 @@ BOOST_AUTO_TEST_CASE(test_decimal) {
     BOOST_REQUIRE(!decimal_type->equal(decimal_type->from_string("1.23e-2"), decimal_type->from_string("0.01231")));
 }
 
+BOOST_AUTO_TEST_CASE(test_value_comparator) {
+    auto check = [] (data_type t, std::vector<data_value> values) {
+        std::vector<bytes> serialized;
+        for (auto& v : values) {
+            serialized.push_back(t->decompose(v));
+        }
+        serialized.push_back(bytes());
+        for (auto& type : std::vector<data_type>{t, reversed_type_impl::get_instance(t)}) {
+            value_comparator cmp(*type);
+            for (auto& a : serialized) {
+                for (auto& b : serialized) {
+                    BOOST_REQUIRE(cmp(managed_bytes_view(a), managed_bytes_view(b)) == type->compare(a, b));
+                }
+            }
+        }
+    };
+    check(int32_type, {int32_t(-1), int32_t(0), int32_t(7)});
+    check(long_type, {int64_t(std::numeric_limits<int64_t>::min()), int64_t(1), int64_t(-5)});
+    check(boolean_type, {false, true});
+    check(double_type, {-0.0, 0.0, std::numeric_limits<double>::quiet_NaN(), 1.5});
+    check(utf8_type, {sstring("a"), sstring(""), sstring("ab")});
+    check(timeuuid_type, {timeuuid_native_type{utils::UUID_gen::get_time_UUID()}, timeuuid_native_type{utils::UUID_gen::get_time_UUID()}});
+    auto list_type = list_type_impl::get_instance(int32_type, false);
+    check(list_type, {make_list_value(list_type, {int32_t(2)}), make_list_value(list_type, {int32_t(1), int32_t(3)})});
+}
+
 BOOST_AUTO_TEST_CASE(test_compound_type_compare) {
     compound_type<> type({utf8_type, utf8_type, utf8_type});
 
@@ -871,6 +897,22 @@ BOOST_AUTO_TEST_CASE(test_map_to_json) {
     BOOST_REQUIRE_EQUAL(to_json_string(*m, map_v.serialize()), "{\"42\": \"abc\", \"42\": \"abc\"}");
 }
 
+BOOST_AUTO_TEST_CASE(test_write_json_string) {
+    auto map_type = map_type_impl::get_instance(int32_type, utf8_type, false);
+    auto map_v = make_map_value(map_type, {{data_value(int32_t(1)), data_value("a\"b")}, {data_value(int32_t(2)), data_value("c")}});
+    auto list_type = list_type_impl::get_instance(map_type, false);
+    auto tuple_type = tuple_type_impl::get_instance({list_type, int32_type});
+    auto tuple_v = make_tuple_value(tuple_type, {make_list_value(list_type, {map_v, map_v}), data_value::make_null(int32_type)});
+
+    const auto expected = "[[{\"1\": \"a\\\"b\", \"2\": \"c\"}, {\"1\": \"a\\\"b\", \"2\": \"c\"}], null]";
+    BOOST_REQUIRE_EQUAL(to_json_string(*tuple_type, tuple_v.serialize()), expected);
+    bytes_ostream out;
+    write_json_string(*tuple_type, bytes_opt(tuple_v.serialize()), out);
+    write_json_string(*int32_type, bytes_opt(), out);
+    auto written = out.linearize();
+    BOOST_REQUIRE_EQUAL(std::string_view(reinterpret_cast<const char*>(written.data()), written.size()), fmt::format("{}null", expected));
+}
+
 BOOST_AUTO_TEST_CASE(test_set_to_string) {
     auto m = set_type_impl::get_instance(int32_type, true);
     using native_type = std::vector<data_value>;
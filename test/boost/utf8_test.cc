@@ -13,6 +13,7 @@
 #include <boost/test/unit_test.hpp>
 #include <random>
 
+#include "utils/ascii.hh"
 #include "utils/utf8.hh"
 #include "utils/fragmented_temporary_buffer.hh"
 
@@ -223,3 +224,50 @@ BOOST_AUTO_TEST_CASE(test_utf8_fragmented) {
         BOOST_REQUIRE(result == bad_pos);
     }
 }
+
+// The vectorized validators process the input in blocks, check them against
+// the scalar ones on inputs with long ASCII runs (which skip the range checks),
+// at all offsets, and with errors and truncations at random positions.
+BOOST_AUTO_TEST_CASE(test_utf8_vectorized_matches_scalar) {
+    auto random_engine = std::default_random_engine(std::random_device()());
+    std::vector<uint8_t> buf;
+    for (unsigned i = 0; i < 20000; ++i) {
+        buf.clear();
+        auto nr_strs = std::uniform_int_distribution(0, 40)(random_engine);
+        for (int j = 0; j < nr_strs; ++j) {
+            if (std::uniform_int_distribution(0, 3)(random_engine) == 0) {
+                buf.insert(buf.end(), std::uniform_int_distribution(1, 70)(random_engine), 'x');
+            }
+            auto& t = positive[std::uniform_int_distribution<size_t>(0, positive.size() - 1)(random_engine)];
+            auto data = reinterpret_cast<const uint8_t*>(t.data);
+            buf.insert(buf.end(), data, data + t.len);
+        }
+        if (!buf.empty() && std::uniform_int_distribution(0, 1)(random_engine)) {
+            auto pos = std::uniform_int_distribution<size_t>(0, buf.size() - 1)(random_engine);
+            if (std::uniform_int_distribution(0, 1)(random_engine)) {
+                buf[pos] = std::uniform_int_distribution(0, 255)(random_engine);
+            } else {
+                buf.resize(pos);
+            }
+        }
+        for (size_t offset = 0; offset < std::min<size_t>(buf.size(), 4); ++offset) {
+            auto data = buf.data() + offset;
+            auto len = buf.size() - offset;
+            auto expected = utils::utf8::internal::validate_partial_scalar(data, len);
+            BOOST_REQUIRE_EQUAL(utils::utf8::validate(data, len), !expected.error && !expected.unvalidated_tail);
+            BOOST_REQUIRE_EQUAL(utils::ascii::validate(data, len), utils::ascii::internal::validate_scalar(data, len));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ascii) {
+    std::vector<uint8_t> buf(300, 'a');
+    for (size_t len = 0; len <= buf.size(); ++len) {
+        BOOST_REQUIRE(utils::ascii::validate(buf.data(), len));
+        for (size_t pos = 0; pos < len; ++pos) {
+            buf[pos] = 0x80;
+            BOOST_REQUIRE(!utils::ascii::validate(buf.data(), len));
+            buf[pos] = 'a';
+        }
+    }
+}
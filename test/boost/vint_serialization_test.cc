@@ -17,6 +17,7 @@
 #include <array>
 #include <cstdint>
 #include <random>
+#include <vector>
 
 using namespace seastar;
 
@@ -137,3 +138,28 @@ BOOST_AUTO_TEST_CASE(sanity_signed_examples) {
 BOOST_AUTO_TEST_CASE(sanity_signed_sweep) {
     check_roundtrip_sweep<signed_vint>(100'000, random_engine());
 }
+
+BOOST_AUTO_TEST_CASE(deserialize_n_sweep) {
+    auto& rng = random_engine();
+    // Mix single-byte vints, which are decoded in runs, with longer ones.
+    auto size_distribution = std::uniform_int_distribution<unsigned>(0, 63);
+    for (unsigned i = 0; i < 10'000; ++i) {
+        const auto count = std::uniform_int_distribution<size_t>(1, 40)(rng);
+        std::vector<uint64_t> values;
+        bytes serialized(bytes::initialized_later{}, count * max_vint_length);
+        auto out = serialized.begin();
+        for (size_t j = 0; j < count; ++j) {
+            const auto bits = size_distribution(rng) < 48 ? 7 : size_distribution(rng) + 1;
+            values.push_back(std::uniform_int_distribution<uint64_t>()(rng) >> (64 - bits));
+            out += unsigned_vint::serialize(values.back(), out);
+        }
+        const auto size = vint_size_type(out - serialized.begin());
+
+        std::vector<uint64_t> deserialized(count);
+        BOOST_REQUIRE_EQUAL(unsigned_vint::deserialize_n(bytes_view(serialized.data(), size), deserialized.data(), count), size);
+        BOOST_REQUIRE(deserialized == values);
+
+        // A truncated buffer doesn't hold the last vint.
+        BOOST_REQUIRE(!unsigned_vint::deserialize_n(bytes_view(serialized.data(), size - 1), deserialized.data(), count));
+    }
+}
@@ -50,6 +50,33 @@ class test_table : public virtual_table {
 
         BOOST_CHECK_THROW(set_cell(cr, "nonexistent_column", 20), std::runtime_error);
     }
+
+    void test_may_contain_rows() {
+        struct restrictions : public query_restrictions {
+            dht::partition_range pr = dht::partition_range::make_open_ended_both_sides();
+            query::partition_slice s;
+            restrictions(query::clustering_row_ranges ranges) : s(std::move(ranges), {}, {}, {}) {}
+            const dht::partition_range& partition_range() const override { return pr; }
+            const query::partition_slice& slice() const override { return s; }
+        };
+        auto ck = [this] (int v) {
+            return clustering_key::from_single_value(*_s, data_value(v).serialize_nonnull());
+        };
+        auto dk = dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(1).serialize_nonnull()));
+
+        restrictions all({query::clustering_range::make_open_ended_both_sides()});
+        BOOST_REQUIRE(may_contain_rows(all, dk, ck(5)));
+        BOOST_REQUIRE(may_contain_rows(all, dk, clustering_key_prefix::make_empty()));
+
+        restrictions some({query::clustering_range::make_singular(ck(2)), query::clustering_range::make({ck(4)}, {ck(6), false})});
+        BOOST_REQUIRE(may_contain_rows(some, dk, ck(2)));
+        BOOST_REQUIRE(!may_contain_rows(some, dk, ck(3)));
+        BOOST_REQUIRE(may_contain_rows(some, dk, ck(5)));
+        BOOST_REQUIRE(!may_contain_rows(some, dk, ck(7)));
+
+        restrictions none({});
+        BOOST_REQUIRE(!may_contain_rows(none, dk, ck(2)));
+    }
 };
 
 }
@@ -61,6 +88,22 @@ SEASTAR_TEST_CASE(test_set_cell) {
     return make_ready_future<>();
 }
 
+SEASTAR_TEST_CASE(test_may_contain_rows) {
+    auto table = db::test_table();
+    table.test_may_contain_rows();
+
+    return make_ready_future<>();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_system_runtime_info_table_restricted_read) {
+    do_with_cql_env_thread([] (cql_test_env& env) {
+        auto res = env.execute_cql("SELECT item FROM system.runtime_info WHERE group = 'generic' AND item = 'uptime';").get();
+        assert_that(res).is_rows().with_rows({{ utf8_type->decompose(sstring("uptime")) }});
+        res = env.execute_cql("SELECT item FROM system.runtime_info WHERE group = 'memory';").get();
+        assert_that(res).is_rows().with_size(3);
+    }).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_system_config_table_read) {
     do_with_cql_env_thread([] (cql_test_env& env) {
         auto res = env.execute_cql("SELECT * FROM system.config WHERE name = 'partitioner';").get();
@@ -13,6 +13,7 @@
 #include <chrono>
 #include <seastar/core/lowres_clock.hh>
 #include "test/lib/scylla_test_case.hh"
+#include "test/lib/tmpdir.hh"
 #include <seastar/core/coroutine.hh>
 
 SEASTAR_TEST_CASE(test_long_udf_yields) {
@@ -101,3 +102,48 @@ SEASTAR_TEST_CASE(test_long_udf_yields) {
     BOOST_CHECK_EQUAL(rets->pop_val()->i64(), 267914296);
     co_return;
 }
+
+SEASTAR_TEST_CASE(test_precompiled_module_cache) {
+    static constexpr auto script = R"(
+(module
+  (type (;0;) (func (param i64) (result i64)))
+  (func (;0;) (type 0) (param i64) (result i64)
+    local.get 0)
+  (memory (;0;) 2)
+  (global (;0;) i32 (i32.const 1))
+  (export "memory" (memory 0))
+  (export "id" (func 0))
+  (export "_scylla_abi" (global 0)))
+)";
+    tmpdir dir;
+    auto wasm_engine = wasmtime::create_engine(1024 * 1024);
+    wasm::alien_thread_runner alien_runner;
+    auto wasm_cache = std::make_unique<wasm::instance_cache>(100 * 1024 * 1024, 1024 * 1024, std::chrono::seconds(1));
+
+    wasm::module_cache modules(dir.path());
+    co_await modules.load();
+    auto key = wasm::module_cache::make_key(script);
+    BOOST_REQUIRE(!modules.find(key));
+    auto wasm_ctx = wasm::context(*wasm_engine, "id", *wasm_cache, 100000, 100000000000);
+    co_await wasm::precompile(alien_runner, wasm_ctx, {}, script, &modules);
+
+    // The module is found after a restart, and used without compiling it.
+    wasm::module_cache reloaded(dir.path());
+    co_await reloaded.load();
+    auto precompiled = reloaded.find(key);
+    BOOST_REQUIRE(precompiled);
+    auto original = wasm_ctx.module.value()->precompiled();
+    BOOST_REQUIRE(std::equal(original.begin(), original.end(), precompiled->begin(), precompiled->end(),
+            [] (uint8_t a, char b) { return a == uint8_t(b); }));
+    auto cached_ctx = wasm::context(*wasm_engine, "id", *wasm_cache, 100000, 100000000000);
+    co_await wasm::precompile(alien_runner, cached_ctx, {}, script, &reloaded);
+    BOOST_REQUIRE(cached_ctx.module);
+
+    // A corrupted module is compiled again.
+    co_await wasm::module_cache(dir.path()).store(key, temporary_buffer<char>("garbage", 7));
+    wasm::module_cache corrupted(dir.path());
+    co_await corrupted.load();
+    auto recompiled_ctx = wasm::context(*wasm_engine, "id", *wasm_cache, 100000, 100000000000);
+    co_await wasm::precompile(alien_runner, recompiled_ctx, {}, script, &corrupted);
+    BOOST_REQUIRE(recompiled_ctx.module.value()->raw_size() == original.size());
+}
@@ -7,7 +7,9 @@
 #############################################################################
 
 import contextlib
+import csv
 import glob
+import io
 import itertools
 import functools
 import json
@@ -205,6 +207,101 @@ def test_scylla_sstable_dump_data(cql, test_keyspace, scylla_path, scylla_data_d
         assert json.loads(out)
 
 
+def query_test_table(cql, keyspace):
+    table = util.unique_name()
+    schema = f"CREATE TABLE {keyspace}.{table} (pk int, ck int, v int, PRIMARY KEY (pk, ck)) WITH compaction = {{'class': 'NullCompactionStrategy'}}"
+
+    cql.execute(schema)
+
+    for pk in range(0, 4):
+        for ck in range(0, 4):
+            cql.execute(f"INSERT INTO {keyspace}.{table} (pk, ck, v) VALUES ({pk}, {ck}, {ck % 2})")
+        nodetool.flush(cql, f"{keyspace}.{table}")
+
+    return table, schema
+
+
+def test_scylla_sstable_query(cql, test_keyspace, scylla_path, scylla_data_dir):
+    with scylla_sstable(query_test_table, cql, test_keyspace, scylla_data_dir) as (schema_file, sstables):
+        def query(*args):
+            out = subprocess.check_output([scylla_path, "sstable", "query", "--schema-file", schema_file, "--merge"] + list(args) + sstables)
+            partitions = json.loads(out)["sstables"]["anonymous"]
+            return {p["key"]["value"]: [r["key"]["value"] for r in p.get("clustering_elements", [])] for p in partitions}
+
+        pk1 = _serialize_value(scylla_path, 1)
+        pk2 = _serialize_value(scylla_path, 2)
+        ck2 = _serialize_value(scylla_path, 2)
+
+        assert query("--partition", pk1) == {"1": ["0", "1", "2", "3"]}
+        assert query("--partition", pk1, "--partition", pk2, "--row", ck2) == {"1": ["2"], "2": ["2"]}
+        assert query("--partition", pk1, "--filter", "v=1") == {"1": ["1", "3"]}
+        assert query("--filter", "v=1", "--row", ck2) == {}
+        assert len(query("--filter", "v=0")) == 4
+
+
+def export_test_table(cql, keyspace):
+    table = util.unique_name()
+    schema = f"CREATE TABLE {keyspace}.{table} (pk int, ck int, v text, s int STATIC, l list<int>, PRIMARY KEY (pk, ck)) WITH compaction = {{'class': 'NullCompactionStrategy'}}"
+
+    cql.execute(schema)
+
+    for pk in range(0, 4):
+        cql.execute(f"UPDATE {keyspace}.{table} SET s = {pk} WHERE pk = {pk}")
+        for ck in range(0, 4):
+            cql.execute(f"INSERT INTO {keyspace}.{table} (pk, ck, v, l) VALUES ({pk}, {ck}, 'a,\"{ck}\"', [{ck}, {pk}])")
+    nodetool.flush(cql, f"{keyspace}.{table}")
+
+    # Shadow and overwrite data of the first sstable in the second one.
+    cql.execute(f"DELETE FROM {keyspace}.{table} WHERE pk = 0")
+    cql.execute(f"DELETE FROM {keyspace}.{table} WHERE pk = 1 AND ck = 1")
+    cql.execute(f"DELETE FROM {keyspace}.{table} WHERE pk = 2 AND ck >= 0 AND ck <= 4")
+    cql.execute(f"UPDATE {keyspace}.{table} SET v = '' WHERE pk = 3 AND ck = 0")
+    cql.execute(f"DELETE l FROM {keyspace}.{table} WHERE pk = 3 AND ck = 1")
+    nodetool.flush(cql, f"{keyspace}.{table}")
+
+    return table, schema
+
+
+def test_scylla_sstable_export(cql, test_keyspace, scylla_path, scylla_data_dir):
+    with scylla_sstable(export_test_table, cql, test_keyspace, scylla_data_dir) as (schema_file, sstables):
+        def export(*args):
+            out = subprocess.check_output([scylla_path, "sstable", "export", "--schema-file", schema_file] + list(args) + sstables)
+            rows = list(csv.reader(io.StringIO(out.decode())))
+            return rows[0], sorted(rows[1:])
+
+        header, rows = export()
+        assert header == ["pk", "ck", "s", "l", "v"]
+        assert rows == sorted([
+            ["1", "0", "1", "[0, 1]", 'a,"0"'],
+            ["1", "2", "1", "[2, 1]", 'a,"2"'],
+            ["1", "3", "1", "[3, 1]", 'a,"3"'],
+            # The static row of a partition without live rows.
+            ["2", "", "2", "", ""],
+            ["3", "0", "3", "[0, 3]", ""],
+            ["3", "1", "3", "", 'a,"1"'],
+            ["3", "2", "3", "[2, 3]", 'a,"2"'],
+            ["3", "3", "3", "[3, 3]", 'a,"3"'],
+        ])
+        # Empty values are quoted, unlike missing ones.
+        assert '3,0,3,"[0, 3]",""' in subprocess.check_output([scylla_path, "sstable", "export", "--schema-file", schema_file] + sstables).decode().splitlines()
+
+        header, rows = export("--column", "v", "--column", "pk")
+        assert header == ["v", "pk"]
+        assert len(rows) == 8
+
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            subprocess.check_call([scylla_path, "sstable", "export", "--schema-file", schema_file, "--output-dir", tmp_dir, "--parallel", "--smp", "2"] + sstables)
+            files = sorted(os.listdir(tmp_dir))
+            assert len(files) == 2
+            parallel_rows = []
+            for f in files:
+                with open(os.path.join(tmp_dir, f)) as csv_file:
+                    file_rows = list(csv.reader(csv_file))
+                assert file_rows[0] == ["pk", "ck", "s", "l", "v"]
+                parallel_rows += file_rows[1:]
+            assert sorted(parallel_rows) == export()[1]
+
+
 @pytest.mark.parametrize("table_factory", [
         simple_no_clustering_table,
         simple_clustering_table,
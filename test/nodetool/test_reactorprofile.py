@@ -0,0 +1,64 @@
+#
+# Copyright 2024-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+from test.nodetool.rest_api_mock import expected_request
+from test.nodetool.utils import check_nodetool_fails_with
+
+
+def make_profile(stacks):
+    return {
+        "duration_ms": 2000,
+        "shards": 2,
+        "scheduling_groups": [
+            {"name": "compaction", "runtime_ms": 300, "tasks_processed": 1000, "task_quota_violations_ms": 120,
+             "waittime_ms": 10, "starvetime_ms": 0},
+            {"name": "statement", "runtime_ms": 900, "tasks_processed": 50000, "task_quota_violations_ms": 5,
+             "waittime_ms": 80, "starvetime_ms": 2},
+        ],
+        "samples": sum(s["count"] for s in stacks),
+        "dropped_samples": 0,
+        "stacks": stacks,
+    }
+
+
+def test_reactorprofile(nodetool, scylla_only, tmp_path):
+    stacks = [{"stack": "0x1234;0x5678", "count": 3}, {"stack": "0x1234;libc.so.6+0x42", "count": 1}]
+    flamegraph_file = tmp_path / "profile.folded"
+
+    res = nodetool("reactorprofile", "-d", "2000", "--sample-period", "500", "--flamegraph-file", str(flamegraph_file),
+                   expected_requests=[
+                       expected_request("GET", "/system/reactor_profile", params={"duration": "2000", "sample_period": "500"},
+                                        response=make_profile(stacks))])
+
+    # The table pads its last column too.
+    assert [line.rstrip() for line in res.stdout.splitlines()] == [
+        "Profiled 2 shards for 2000 ms",
+        "",
+        "Scheduling group Runtime (ms) Share  Tasks Quota violations (ms) Wait (ms) Starve (ms)",
+        "statement        900          75.00% 50000 5                     80        2",
+        "compaction       300          25.00% 1000  120                   10        0",
+        "",
+        "Samples: 4 (0 dropped)",
+        f"Folded stacks written to {flamegraph_file}",
+    ]
+    assert flamegraph_file.read_text() == "0x1234;0x5678 3\n0x1234;libc.so.6+0x42 1\n"
+
+
+def test_reactorprofile_no_sampling(nodetool, scylla_only):
+    res = nodetool("reactorprofile", "--sample-period", "0", expected_requests=[
+        expected_request("GET", "/system/reactor_profile", params={"duration": "10000", "sample_period": "0"},
+                         response=make_profile([]))])
+
+    assert "Samples" not in res.stdout
+    assert res.stdout.splitlines()[3].startswith("statement")
+
+
+def test_reactorprofile_invalid_duration(nodetool, scylla_only):
+    check_nodetool_fails_with(
+            nodetool,
+            ("reactorprofile", "-d", "0"),
+            {},
+            ["error processing arguments: duration must be positive"])
@@ -125,6 +125,49 @@ async def test_backup_is_abortable(manager: ManagerClient, s3_server):
     assert uploaded_count > 0 and uploaded_count < len(files)
 
 
+@pytest.mark.asyncio
+async def test_incremental_backup(manager: ManagerClient, s3_server):
+    '''check that sstables already in a backup are copied from it or skipped instead of being uploaded'''
+
+    cfg = {'enable_user_defined_functions': False,
+           'object_storage_config_file': str(s3_server.config_file),
+           'experimental_features': ['keyspace-storage-options'],
+           'task_ttl_in_seconds': 300
+           }
+    cmd = [ '--logger-log-level', 'snapshots=trace:task_manager=trace' ]
+    server = await manager.server_add(config=cfg, cmdline=cmd)
+    ks, cf = await prepare_snapshot_for_backup(manager, server)
+
+    workdir = await manager.server_get_workdir(server.server_id)
+    cf_dir = os.listdir(f'{workdir}/data/{ks}')[0]
+    files = set(os.listdir(f'{workdir}/data/{ks}/{cf_dir}/snapshots/backup'))
+    log = await manager.server_open_log(server.server_id)
+
+    async def backup(prefix, base_prefix = None):
+        mark = await log.mark()
+        tid = await manager.api.backup(server.ip_addr, ks, cf, 'backup', s3_server.address, s3_server.bucket_name, prefix, base_prefix)
+        status = await manager.api.wait_task(server.ip_addr, tid)
+        assert (status is not None) and (status['state'] == 'done')
+        objects = set([ o.key for o in get_s3_resource(s3_server).Bucket(s3_server.bucket_name).objects.all() ])
+        for f in files:
+            assert f'{prefix}/{f}' in objects
+        res = await log.grep(r'Backup of .*: uploaded (\d+), copied (\d+), skipped (\d+) components', from_mark=mark)
+        assert len(res) == 1
+        return [int(res[0][1].group(i)) for i in (1, 2, 3)]
+
+    uploaded, copied, skipped = await backup(f'{cf}/day1')
+    assert uploaded == len(files) and copied == 0 and skipped == 0
+
+    print('Backup the same snapshot on top of the previous backup')
+    uploaded, copied, skipped = await backup(f'{cf}/day2', base_prefix=f'{cf}/day1')
+    assert copied > 0 and uploaded + copied == len(files) and skipped == 0
+
+    print('Repeat the backup to the same prefix')
+    uploaded, copied, skipped = await backup(f'{cf}/day2')
+    assert skipped > 0
+    assert copied == 0 and uploaded + skipped == len(files)
+
+
 @pytest.mark.asyncio
 async def test_simple_backup_and_restore(manager: ManagerClient, s3_server):
     '''check that restoring from backed up snapshot for a keyspace:table works'''
@@ -7,6 +7,8 @@
  */
 
 #include "perf.hh"
+#include <bit>
+#include <cmath>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/memory.hh>
 #include "seastarx.hh"
@@ -125,6 +127,84 @@ auto fmt::formatter<perf_result_with_aio_writes>::format(const perf_result_with_
             result.throughput, result.mallocs_per_op, result.logallocs_per_op, result.tasks_per_op, result.instructions_per_op, result.cpu_cycles_per_op, result.errors, result.aio_write_bytes, result.aio_writes);
 }
 
+latency_histogram::latency_histogram()
+    : _counts(64 * sub_bucket_count)
+{}
+
+size_t latency_histogram::index_of(uint64_t value) noexcept {
+    if (value < sub_bucket_count) {
+        return value;
+    }
+    const unsigned shift = std::bit_width(value) - 1 - sub_bucket_bits;
+    return shift * sub_bucket_count + (value >> shift);
+}
+
+uint64_t latency_histogram::value_of(size_t index) noexcept {
+    if (index < sub_bucket_count) {
+        return index;
+    }
+    const unsigned shift = index / sub_bucket_count - 1;
+    const uint64_t lowest = (index - shift * sub_bucket_count) << shift;
+    // The middle of the sub-bucket.
+    return lowest + ((uint64_t(1) << shift) >> 1);
+}
+
+void latency_histogram::record(std::chrono::nanoseconds latency) noexcept {
+    const uint64_t value = std::max<int64_t>(latency.count(), 0);
+    ++_counts[index_of(value)];
+    ++_count;
+    _max = std::max(_max, value);
+}
+
+latency_histogram& latency_histogram::operator+=(const latency_histogram& o) noexcept {
+    for (size_t i = 0; i < _counts.size(); ++i) {
+        _counts[i] += o._counts[i];
+    }
+    _count += o._count;
+    _max = std::max(_max, o._max);
+    return *this;
+}
+
+std::chrono::nanoseconds latency_histogram::percentile(double fraction) const noexcept {
+    const auto rank = uint64_t(std::ceil(fraction * _count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < _counts.size(); ++i) {
+        seen += _counts[i];
+        if (seen && seen >= rank) {
+            return std::chrono::nanoseconds(std::min(value_of(i), _max));
+        }
+    }
+    return max();
+}
+
+auto fmt::formatter<arrival_process>::format(arrival_process arrival, fmt::format_context& ctx) const
+        -> decltype(ctx.out()) {
+    switch (arrival) {
+    case arrival_process::constant: return fmt::format_to(ctx.out(), "constant");
+    case arrival_process::poisson: return fmt::format_to(ctx.out(), "poisson");
+    }
+    std::abort();
+}
+
+auto fmt::formatter<open_loop_shard_result>::format(const open_loop_shard_result& result, fmt::format_context& ctx) const
+        -> decltype(ctx.out()) {
+    auto to_ms = [] (std::chrono::nanoseconds latency) {
+        return std::chrono::duration<double, std::milli>(latency).count();
+    };
+    const auto& l = result.latencies;
+    return fmt::format_to(ctx.out(), "{:.2f} tps (p50: {:.3f} [ms], p99: {:.3f} [ms], p999: {:.3f} [ms], max: {:.3f} [ms], {} errors)",
+            result.throughput, to_ms(l.percentile(0.5)), to_ms(l.percentile(0.99)), to_ms(l.percentile(0.999)), to_ms(l.max()), result.errors);
+}
+
+auto fmt::formatter<open_loop_result>::format(const open_loop_result& result, fmt::format_context& ctx) const
+        -> decltype(ctx.out()) {
+    auto out = fmt::format_to(ctx.out(), "open loop at {:.0f} requests/s per shard, {} arrivals\n", result.rate_per_shard, result.arrival);
+    for (size_t shard = 0; shard < result.shards.size(); ++shard) {
+        out = fmt::format_to(out, "shard {:>3}: {}\n", shard, result.shards[shard]);
+    }
+    return fmt::format_to(out, "    total: {}", result.total);
+}
+
 namespace perf {
 
 reader_concurrency_semaphore_wrapper::reader_concurrency_semaphore_wrapper(sstring name)
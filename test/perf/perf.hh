@@ -13,7 +13,11 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/coroutine/as_future.hh>
+#include <seastar/testing/random.hh>
 #include "seastarx.hh"
 #include "utils/extremum_tracking.hh"
 #include "utils/estimated_histogram.hh"
@@ -23,6 +27,7 @@
 
 #include <chrono>
 #include <iosfwd>
+#include <random>
 #include <boost/range/irange.hpp>
 #include <vector>
 
@@ -263,6 +268,167 @@ std::vector<perf_result> time_parallel(Func func, unsigned concurrency_per_core,
     return time_parallel_ex<perf_result>(std::move(func), concurrency_per_core, iterations, operations_per_shard, stop_on_error);
 }
 
+// A histogram of latencies with the layout of HdrHistogram: the values are
+// bucketed by their power of two, and each of those buckets is split into
+// 2^sub_bucket_bits linear sub-buckets, so percentiles are exact to within
+// 1/2^sub_bucket_bits of the value, whatever its magnitude.
+class latency_histogram {
+    static constexpr unsigned sub_bucket_bits = 7;
+    static constexpr uint64_t sub_bucket_count = uint64_t(1) << sub_bucket_bits;
+
+    std::vector<uint64_t> _counts;
+    uint64_t _count = 0;
+    uint64_t _max = 0;
+private:
+    static size_t index_of(uint64_t value) noexcept;
+    static uint64_t value_of(size_t index) noexcept;
+public:
+    latency_histogram();
+
+    void record(std::chrono::nanoseconds latency) noexcept;
+    latency_histogram& operator+=(const latency_histogram& o) noexcept;
+
+    uint64_t count() const noexcept {
+        return _count;
+    }
+    std::chrono::nanoseconds max() const noexcept {
+        return std::chrono::nanoseconds(_max);
+    }
+    // The latency below which the given fraction of the recorded ones are.
+    std::chrono::nanoseconds percentile(double fraction) const noexcept;
+};
+
+enum class arrival_process { constant, poisson };
+
+struct open_loop_shard_result {
+    double throughput = 0;
+    uint64_t invocations = 0;
+    uint64_t errors = 0;
+    latency_histogram latencies;
+};
+
+struct open_loop_result {
+    double rate_per_shard;
+    arrival_process arrival;
+    std::vector<open_loop_shard_result> shards;
+    open_loop_shard_result total;
+};
+
+// Issues the given asynchronous action at a fixed arrival rate until a
+// deadline, no matter how long the previous invocations take. The latency of
+// each invocation is measured from the time it was due to be issued, so that
+// the stalls of the system under test show up in the latencies instead of
+// just slowing down the load (coordinated omission).
+//
+// At most max_in_flight invocations run at a time, to bound the memory the
+// load takes when the system can't keep up. Invocations delayed by the limit
+// still measure their latency from their due time.
+template <typename Func>
+class open_loop_executor {
+    using clk = std::chrono::steady_clock;
+
+    const Func _func;
+    const clk::duration _duration;
+    const double _rate;
+    const arrival_process _arrival;
+    const bool _stop_on_error;
+    semaphore _in_flight;
+    gate _gate;
+    open_loop_shard_result _result;
+    std::exception_ptr _error;
+private:
+    clk::duration next_interval() {
+        std::chrono::duration<double> interval(1 / _rate);
+        if (_arrival == arrival_process::poisson) {
+            interval = std::chrono::duration<double>(std::exponential_distribution<double>(_rate)(seastar::testing::local_random_engine));
+        }
+        return std::chrono::duration_cast<clk::duration>(interval);
+    }
+
+    future<> invoke(clk::time_point due, semaphore_units<> units) {
+        future<> f = co_await coroutine::as_future(futurize_invoke(_func));
+        _result.latencies.record(clk::now() - due);
+        if (f.failed()) {
+            ++_result.errors;
+            if (_stop_on_error && !_error) {
+                _error = f.get_exception();
+            } else {
+                f.ignore_ready_future();
+            }
+        }
+    }
+public:
+    open_loop_executor(Func func, clk::duration duration, double rate, arrival_process arrival, unsigned max_in_flight, bool stop_on_error)
+            : _func(std::move(func))
+            , _duration(duration)
+            , _rate(rate)
+            , _arrival(arrival)
+            , _stop_on_error(stop_on_error)
+            , _in_flight(max_in_flight)
+    { }
+
+    future<open_loop_shard_result> run() {
+        const auto start = clk::now();
+        const auto end_at = start + _duration;
+        auto due = start;
+        for (;;) {
+            // Issues all invocations which are due at once, so that high rates
+            // don't need a timer per invocation.
+            while (due <= clk::now() && due < end_at && !_error) {
+                auto units = co_await get_units(_in_flight, 1);
+                ++_result.invocations;
+                (void)with_gate(_gate, [this, due, units = std::move(units)] () mutable {
+                    return invoke(due, std::move(units));
+                });
+                due += next_interval();
+            }
+            if (due >= end_at || _error) {
+                break;
+            }
+            co_await sleep(due - clk::now());
+        }
+        co_await _gate.close();
+        if (_error) {
+            co_return coroutine::exception(std::move(_error));
+        }
+        _result.throughput = _result.invocations / std::chrono::duration<double>(clk::now() - start).count();
+        co_return std::move(_result);
+    }
+
+    future<> stop() {
+        return make_ready_future<>();
+    }
+};
+
+/**
+ * Measures the latency of an asynchronous action under a given load. Executes
+ * the action on all cores in parallel, each issuing it rate_per_shard times
+ * per second, whether the previous executions completed or not.
+ *
+ * Returns the latencies of each shard and of all of them.
+ */
+template <typename Func>
+static
+open_loop_result time_open_loop(Func func, double rate_per_shard, arrival_process arrival, unsigned duration_in_seconds, unsigned max_in_flight, bool stop_on_error = true) {
+    distributed<open_loop_executor<Func>> exec;
+    exec.start(func, std::chrono::seconds(duration_in_seconds), rate_per_shard, arrival, max_in_flight, stop_on_error).get();
+    auto stop_exec = defer([&exec] {
+        exec.stop().get();
+    });
+    open_loop_result result{
+        .rate_per_shard = rate_per_shard,
+        .arrival = arrival,
+        .shards = exec.map(std::mem_fn(&open_loop_executor<Func>::run)).get(),
+    };
+    for (const auto& shard : result.shards) {
+        result.total.throughput += shard.throughput;
+        result.total.invocations += shard.invocations;
+        result.total.errors += shard.errors;
+        result.total.latencies += shard.latencies;
+    }
+    return result;
+}
+
 template<typename Func>
 auto duration_in_seconds(Func&& f) {
     using clk = std::chrono::steady_clock;
@@ -328,3 +494,15 @@ template <> struct fmt::formatter<scheduling_latency_measurer> : fmt::formatter<
 template <> struct fmt::formatter<perf_result> : fmt::formatter<string_view> {
     auto format(const perf_result&, fmt::format_context& ctx) const -> decltype(ctx.out());
 };
+
+template <> struct fmt::formatter<arrival_process> : fmt::formatter<string_view> {
+    auto format(arrival_process, fmt::format_context& ctx) const -> decltype(ctx.out());
+};
+
+template <> struct fmt::formatter<open_loop_shard_result> : fmt::formatter<string_view> {
+    auto format(const open_loop_shard_result&, fmt::format_context& ctx) const -> decltype(ctx.out());
+};
+
+template <> struct fmt::formatter<open_loop_result> : fmt::formatter<string_view> {
+    auto format(const open_loop_result&, fmt::format_context& ctx) const -> decltype(ctx.out());
+};
@@ -36,3 +36,36 @@ PERF_TEST_F(big_decimal_test, from_string) {
     perf_tests::do_not_optimize(big_decimal{neg_data_fraction_neg_exponent});
 }
 
+struct big_decimal_sum_test {
+    std::vector<big_decimal> same_scale;
+    std::vector<big_decimal> mixed_scales;
+
+    big_decimal_sum_test() {
+        std::mt19937 gen(0);
+        std::uniform_int_distribution<int64_t> unscaled(-1'000'000'000, 1'000'000'000);
+        std::uniform_int_distribution<int32_t> scale(0, 6);
+        for (int i = 0; i < 1000; ++i) {
+            same_scale.emplace_back(2, unscaled(gen));
+            mixed_scales.emplace_back(scale(gen), unscaled(gen));
+        }
+    }
+};
+
+// Like sum() over a decimal column.
+PERF_TEST_F(big_decimal_sum_test, sum_same_scale) {
+    big_decimal acc;
+    for (auto& v : same_scale) {
+        acc += v;
+    }
+    perf_tests::do_not_optimize(acc);
+    return same_scale.size();
+}
+
+PERF_TEST_F(big_decimal_sum_test, sum_mixed_scales) {
+    big_decimal acc;
+    for (auto& v : mixed_scales) {
+        acc += v;
+    }
+    perf_tests::do_not_optimize(acc);
+    return mixed_scales.size();
+}
@@ -47,6 +47,8 @@ int main(int argc, char** argv) {
     app.add_options()
         ("trace", "Enables trace-level logging for the test actions")
         ("no-reads", "Disable reads during the test")
+        ("scan", "Run full scans of a second table during the test, to measure how they affect the hit rate of the reads")
+        ("scan-partitions", bpo::value<unsigned>()->default_value(100000), "Number of partitions of the scanned table")
         ("seconds", bpo::value<unsigned>()->default_value(60), "Duration [s] after which the test terminates with a success")
         ;
 
@@ -62,6 +64,7 @@ int main(int argc, char** argv) {
 
         return do_with_cql_env_thread([&app] (cql_test_env& env) {
             auto reads_enabled = !app.configuration().contains("no-reads");
+            auto scans_enabled = app.configuration().contains("scan");
             auto seconds = app.configuration()["seconds"].as<unsigned>();
 
             engine().at_exit([] {
@@ -82,8 +85,24 @@ int main(int argc, char** argv) {
             replica::column_family& cf = db.find_column_family(s->id());
             cf.set_compaction_strategy(sstables::compaction_strategy_type::null);
 
+            if (scans_enabled) {
+                env.execute_cql("CREATE TABLE ks.scanned (pk int, v text, PRIMARY KEY (pk))").get();
+                auto id = env.prepare("INSERT INTO ks.scanned (pk, v) VALUES (?, ?)").get();
+                auto scanned_value = sstring(1024, 'x');
+                auto nr_partitions = app.configuration()["scan-partitions"].as<unsigned>();
+                for (unsigned i = 0; i < nr_partitions; ++i) {
+                    env.execute_prepared(id, {
+                        cql3::raw_value::make_value(int32_type->decompose(int32_t(i))),
+                        cql3::raw_value::make_value(utf8_type->decompose(scanned_value)),
+                    }).get();
+                }
+                env.db().invoke_on_all(&replica::database::flush_all_memtables).get();
+                testlog.info("Populated the scanned table with {} partitions", nr_partitions);
+            }
+
             uint64_t mutations = 0;
             uint64_t reads = 0;
+            uint64_t scans = 0;
             utils::estimated_histogram reads_hist;
             utils::estimated_histogram writes_hist;
 
@@ -95,6 +114,9 @@ int main(int argc, char** argv) {
             monotonic_counter<uint64_t> pmerges_ctr([&] { return tracker.get_stats().partition_merges; });
             monotonic_counter<uint64_t> eviction_ctr([&] { return tracker.get_stats().row_evictions; });
             monotonic_counter<uint64_t> miss_ctr([&] { return tracker.get_stats().reads_with_misses; });
+            monotonic_counter<uint64_t> scans_ctr([&] { return scans; });
+            monotonic_counter<uint64_t> row_hits_ctr([&] { return tracker.get_stats().row_hits; });
+            monotonic_counter<uint64_t> row_misses_ctr([&] { return tracker.get_stats().row_misses; });
             stats_printer.set_callback([&] {
                 auto MB = 1024 * 1024;
                 std::cout << format("rd/s: {:d}, wr/s: {:d}, ev/s: {:d}, pmerge/s: {:d}, miss/s: {:d}, cache: {:d}/{:d} [MB], LSA: {:d}/{:d} [MB], std free: {:d} [MB]",
@@ -120,6 +142,11 @@ int main(int argc, char** argv) {
                     );
                 };
 
+                auto row_hits = row_hits_ctr.change();
+                auto row_lookups = row_hits + row_misses_ctr.change();
+                std::cout << format("scans/s: {:d}, row hit rate: {:.1f}%", scans_ctr.change(),
+                    row_lookups ? 100.0 * row_hits / row_lookups : 100.0) << "\n";
+
                 std::cout << "reads : " << print_percentiles(reads_hist) << "\n";
                 std::cout << "writes: " << print_percentiles(writes_hist) << "\n";
                 std::cout << "\n";
@@ -152,6 +179,16 @@ int main(int argc, char** argv) {
                 }
             });
 
+            auto scanner = seastar::async([&] {
+                if (!scans_enabled) {
+                    return;
+                }
+                while (!cancelled) {
+                    env.execute_cql("select pk from ks.scanned;").get();
+                    ++scans;
+                }
+            });
+
             auto mutator = seastar::async([&] {
                 int32_t ckey_seq = 0;
                 while (!cancelled) {
@@ -168,6 +205,7 @@ int main(int argc, char** argv) {
 
             mutator.get();
             reader.get();
+            scanner.get();
             stats_printer.cancel();
             completion_timer.cancel();
         }, cfg_ptr);
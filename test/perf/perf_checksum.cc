@@ -12,6 +12,8 @@
 
 #include <seastar/testing/perf_tests.hh>
 
+#include <vector>
+
 struct crc_test {
     const sstring data = make_random_string(64*1024);
     const sstring data2 = make_random_string(64*1024);
@@ -53,3 +55,44 @@ PERF_TEST_F(crc_test, perf_zlib_crc32_checksum) {
     perf_tests::do_not_optimize(
         zlib_crc32_checksummer::checksum(data.data(), data.size()));
 }
+
+// Computes the per-chunk checksums and the full checksum of a file, the way
+// checksum validation does, either by feeding the chunks once more to the full
+// checksum or by combining the chunk checksums into it.
+struct crc_file_test {
+    static constexpr size_t chunk_size = 64 * 1024;
+    const std::vector<sstring> chunks = [] {
+        std::vector<sstring> chunks;
+        for (int i = 0; i < 16; ++i) {
+            chunks.push_back(make_random_string(chunk_size));
+        }
+        return chunks;
+    }();
+
+    template <typename ChecksumType, bool combine>
+    uint32_t full_checksum() const {
+        uint32_t full = ChecksumType::init_checksum();
+        for (auto& c : chunks) {
+            auto sum = ChecksumType::checksum(c.data(), c.size());
+            perf_tests::do_not_optimize(sum);
+            if constexpr (combine) {
+                full = ChecksumType::checksum_combine(full, sum, c.size());
+            } else {
+                full = ChecksumType::checksum(full, c.data(), c.size());
+            }
+        }
+        return full;
+    }
+};
+
+PERF_TEST_F(crc_file_test, perf_crc32_full_checksum_feed) {
+    perf_tests::do_not_optimize(full_checksum<crc32_utils, false>());
+}
+
+PERF_TEST_F(crc_file_test, perf_crc32_full_checksum_combine) {
+    perf_tests::do_not_optimize(full_checksum<crc32_utils, true>());
+}
+
+PERF_TEST_F(crc_file_test, perf_adler_full_checksum_combine) {
+    perf_tests::do_not_optimize(full_checksum<adler32_utils, true>());
+}
@@ -167,6 +167,7 @@ int main(int argc, char** argv) {
         ("commitlog-total-space-in-mb", bpo::value<unsigned>(), "total commitlog size")
         ("commitlog-sync-period-in-ms", bpo::value<unsigned>(), "how long the system waits for other writes before performing a sync in \"periodic\" mode")
         ("commitlog-use-o-dsync", bpo::value<bool>()->default_value(true), "whether or not to use O_DSYNC mode for commitlog segments io")
+        ("commitlog-use-vectored-writes", bpo::value<bool>()->default_value(false), "whether or not to submit each commitlog buffer as a single vectored write")
         ("commitlog-use-hard-size-limit", bpo::value<bool>()->default_value(true), "whether or not to use a hard size limit for commitlog disk usage")
 
         ("min-data-size", bpo::value<size_t>()->default_value(200), "minimum size of data element added")
@@ -208,6 +209,9 @@ int main(int argc, char** argv) {
         if (app.configuration().contains("commitlog-use-o-dsync")) {
             db_cfg->commitlog_use_o_dsync(app.configuration()["commitlog-use-o-dsync"].as<bool>());
         }
+        if (app.configuration().contains("commitlog-use-vectored-writes")) {
+            db_cfg->commitlog_use_vectored_writes(app.configuration()["commitlog-use-vectored-writes"].as<bool>());
+        }
         if (app.configuration().contains("commitlog-use-hard-size-limit")) {
             db_cfg->commitlog_use_hard_size_limit(app.configuration()["commitlog-use-hard-size-limit"].as<bool>());
         }
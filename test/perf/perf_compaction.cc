@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <filesystem>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/closeable.hh>
+
+#include "compaction/compaction.hh"
+#include "compaction/compaction_strategy.hh"
+#include "readers/combined.hh"
+#include "readers/compacting.hh"
+#include "schema/schema_builder.hh"
+#include "sstables/checksum_utils.hh"
+#include "sstables/sstables.hh"
+#include "test/lib/random_utils.hh"
+#include "test/lib/sstable_test_env.hh"
+#include "test/lib/sstable_utils.hh"
+#include "test/lib/tmpdir.hh"
+#include "tools/schema_loader.hh"
+
+/// Measures the throughput of compacting a given set of sstables, e.g. ones
+/// copied from a production node, with each of the compaction strategies, and
+/// breaks the CPU time of the compaction down by stage.
+///
+/// The stages of the compaction run interleaved on the same reactor thread, so
+/// they can't be timed directly. Instead, the pipeline is built up stage by
+/// stage, each prefix of it run on its own, and the CPU (reactor busy) time of
+/// a stage is the difference between the runs with and without it:
+///
+///   read       each sstable read on its own: I/O, decompression, checksum
+///              verification and parsing
+///   merge      the combined reader over all of the sstables
+///   compactor  the mutation_compactor applied to the merged stream
+///   serialize  the compaction writing uncompressed sstables, minus the above
+///              and the checksumming
+///   compress   the compaction writing compressed sstables, minus the one
+///              writing uncompressed sstables
+///   checksum   crc32 of the data written by the uncompressed compaction,
+///              measured on its own
+///
+/// The stages are small differences of large numbers, so use -c1 and enough
+/// data for the runs to take seconds.
+///
+/// Example run:
+///
+///    $ build/release/test/perf/perf_compaction_g -c1 -m4G --sstables-dir /path/to/ks/table-uuid
+///
+
+using namespace sstables;
+
+using clk = std::chrono::steady_clock;
+
+struct run_stats {
+    std::chrono::duration<double> wall{0};
+    std::chrono::duration<double> busy{0};
+};
+
+template <typename Func>
+static run_stats measure(Func&& func) {
+    auto wall_start = clk::now();
+    auto busy_start = engine().total_busy_time();
+    func();
+    return run_stats{
+        .wall = clk::now() - wall_start,
+        .busy = engine().total_busy_time() - busy_start,
+    };
+}
+
+static void consume(mutation_reader r) {
+    auto close_r = deferred_close(r);
+    while (r().get()) {
+        thread::maybe_yield();
+    }
+}
+
+static schema_ptr load_schema(test_env& env, const sstring& dir, const sstring& schema_file) {
+    if (!schema_file.empty()) {
+        return tools::load_one_schema_from_file(env.db_config(), std::filesystem::path(schema_file)).get();
+    }
+    for (auto& de : std::filesystem::directory_iterator(std::filesystem::path(dir))) {
+        if (de.path().native().ends_with("-Data.db")) {
+            return tools::load_schema_from_sstable(env.db_config(), de.path()).get();
+        }
+    }
+    throw std::runtime_error(format("No sstables found in {}", dir));
+}
+
+static std::vector<shared_sstable> load_sstables(test_env& env, schema_ptr s, const sstring& dir) {
+    std::vector<shared_sstable> ssts;
+    for (auto& de : std::filesystem::directory_iterator(std::filesystem::path(dir))) {
+        if (!de.is_regular_file() || !de.path().native().ends_with("-TOC.txt")) {
+            continue;
+        }
+        auto entry = parse_path(de.path(), s->ks_name(), s->cf_name());
+        auto sst = env.make_sstable(s, dir, entry.generation, entry.version, entry.format);
+        sst->load(s->get_sharder()).get();
+        ssts.push_back(std::move(sst));
+    }
+    if (ssts.empty()) {
+        throw std::runtime_error(format("No sstables found in {}", dir));
+    }
+    return ssts;
+}
+
+static void drop_caches(const std::vector<shared_sstable>& ssts) {
+    for (auto& sst : ssts) {
+        sst->drop_caches().get();
+    }
+}
+
+static mutation_reader make_merged_reader(test_env& env, schema_ptr s, const std::vector<shared_sstable>& ssts) {
+    std::vector<mutation_reader> readers;
+    for (auto& sst : ssts) {
+        readers.push_back(sst->make_reader(s, env.make_reader_permit(), query::full_partition_range, s->full_slice(), {},
+                streamed_mutation::forwarding::no, mutation_reader::forwarding::no));
+    }
+    return make_combined_reader(s, env.make_reader_permit(), std::move(readers),
+            streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+}
+
+struct compaction_run {
+    run_stats stats;
+    uint64_t input_bytes = 0;
+    uint64_t output_bytes = 0;
+    uint64_t output_data_bytes = 0;
+    size_t output_sstables = 0;
+};
+
+// Runs the major compaction job of the strategy of the schema over ssts. The
+// output goes to a temporary directory, removed afterwards.
+static compaction_run run_compaction(test_env& env, schema_ptr s, std::vector<shared_sstable> ssts) {
+    tmpdir out;
+    auto t = env.make_table_for_tests(s, out.path().native());
+    auto stop_t = deferred_stop(t);
+    auto cs = make_compaction_strategy(s->compaction_strategy(), s->compaction_strategy_options());
+    auto descriptor = cs.get_major_compaction_job(t.as_table_state(), std::move(ssts));
+    auto creator = [&] {
+        return env.make_sstable(s, out.path().native(), env.new_generation());
+    };
+
+    compaction_run run;
+    compaction_result res;
+    run.stats = measure([&] {
+        res = compact_sstables(env, std::move(descriptor), t, creator).get();
+    });
+    run.input_bytes = res.stats.start_size;
+    run.output_bytes = res.stats.end_size;
+    run.output_sstables = res.new_sstables.size();
+    for (auto& sst : res.new_sstables) {
+        run.output_data_bytes += sst->ondisk_data_size();
+    }
+    return run;
+}
+
+static std::chrono::duration<double> checksum_time(uint64_t bytes) {
+    auto buf = tests::random::get_bytes(128 * 1024);
+    uint32_t checksum = crc32_utils::init_checksum();
+    auto stats = measure([&] {
+        for (uint64_t done = 0; done < bytes; done += buf.size()) {
+            checksum = crc32_utils::checksum(checksum, reinterpret_cast<const char*>(buf.data()), buf.size());
+            thread::maybe_yield();
+        }
+    });
+    return stats.busy;
+}
+
+static void run_strategy(test_env& env, schema_ptr base, compaction_strategy_type type, const sstring& dir) {
+    auto s = schema_builder(base).set_compaction_strategy(type).build();
+    auto s_uncompressed = schema_builder(s).set_compressor_params(compression_parameters::no_compression()).build();
+    auto ssts = load_sstables(env, s, dir);
+
+    drop_caches(ssts);
+    auto read = measure([&] {
+        for (auto& sst : ssts) {
+            consume(sst->make_reader(s, env.make_reader_permit(), query::full_partition_range, s->full_slice(), {},
+                    streamed_mutation::forwarding::no, mutation_reader::forwarding::no));
+        }
+    });
+
+    drop_caches(ssts);
+    auto merge = measure([&] {
+        consume(make_merged_reader(env, s, ssts));
+    });
+
+    drop_caches(ssts);
+    auto t = env.make_table_for_tests(s);
+    auto stop_t = deferred_stop(t);
+    auto compact = measure([&] {
+        consume(make_compacting_reader(make_merged_reader(env, s, ssts), gc_clock::now(), can_always_purge,
+                t.as_table_state().get_tombstone_gc_state()));
+    });
+
+    drop_caches(ssts);
+    auto uncompressed = run_compaction(env, s_uncompressed, load_sstables(env, s_uncompressed, dir));
+    auto checksum = checksum_time(uncompressed.output_data_bytes);
+
+    drop_caches(ssts);
+    auto compressed = run_compaction(env, s, ssts);
+
+    const double MB = 1024 * 1024;
+    std::cout << format("{}: {} sstables, {:.1f} MB -> {} sstables, {:.1f} MB in {:.2f}s: {:.1f} MB/s in, {:.1f} MB/s out\n",
+            compaction_strategy::name(type), ssts.size(), compressed.input_bytes / MB, compressed.output_sstables,
+            compressed.output_bytes / MB, compressed.stats.wall.count(), compressed.input_bytes / MB / compressed.stats.wall.count(),
+            compressed.output_bytes / MB / compressed.stats.wall.count());
+
+    auto total = compressed.stats.busy.count();
+    auto print_stage = [&] (std::string_view name, double busy) {
+        std::cout << format("  {:<10} {:8.3f}s {:6.1f}%\n", name, busy, total ? 100 * busy / total : 0);
+    };
+    print_stage("read", read.busy.count());
+    print_stage("merge", (merge.busy - read.busy).count());
+    print_stage("compactor", (compact.busy - merge.busy).count());
+    print_stage("serialize", (uncompressed.stats.busy - compact.busy - checksum).count());
+    print_stage("compress", (compressed.stats.busy - uncompressed.stats.busy).count());
+    print_stage("checksum", checksum.count());
+    print_stage("total", total);
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("sstables-dir", bpo::value<sstring>()->required(), "directory of the sstables to compact")
+        ("schema-file", bpo::value<sstring>()->default_value(""), "file with the CQL schema of the sstables, "
+             "loaded from the sstables if not given")
+        ("strategies", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy,LeveledCompactionStrategy,"
+             "TimeWindowCompactionStrategy,IncrementalCompactionStrategy"), "comma-separated list of the compaction strategies to run");
+
+    return app.run(argc, argv, [&app] {
+        auto dir = app.configuration()["sstables-dir"].as<sstring>();
+        auto schema_file = app.configuration()["schema-file"].as<sstring>();
+        std::vector<sstring> strategies;
+        boost::split(strategies, app.configuration()["strategies"].as<sstring>(), boost::is_any_of(","));
+
+        return test_env::do_with_async([&] (test_env& env) {
+            auto s = load_schema(env, dir, schema_file);
+            std::cout << format("Compacting the sstables of {}.{} from {}\n", s->ks_name(), s->cf_name(), dir);
+            for (auto& name : strategies) {
+                run_strategy(env, s, compaction_strategy::type(name), dir);
+            }
+        });
+    });
+}
@@ -13,6 +13,10 @@
 
 #include "mutation/frozen_mutation.hh"
 #include "mutation/mutation_partition_view.hh"
+#include "db/commitlog/replay_position.hh"
+#include "idl/replay_position.dist.hh"
+#include "idl/replay_position.dist.impl.hh"
+#include "bytes_ostream.hh"
 
 namespace tests {
 
@@ -57,4 +61,30 @@ PERF_TEST_F(frozen_mutation, apply_one_small_row)
     perf_tests::do_not_optimize(m);
 }
 
+class fixed_size_structs {
+    std::vector<db::replay_position> _positions;
+public:
+    fixed_size_structs() {
+        for (unsigned i = 0; i < 1000; ++i) {
+            _positions.emplace_back(i, i * 7);
+        }
+    }
+    const std::vector<db::replay_position>& positions() const { return _positions; }
+};
+
+PERF_TEST_F(fixed_size_structs, serialize_vector_of_fixed_size_structs)
+{
+    bytes_ostream out;
+    ser::serialize(out, positions());
+    perf_tests::do_not_optimize(out);
+    return positions().size();
+}
+
+PERF_TEST_F(fixed_size_structs, measure_vector_of_fixed_size_structs)
+{
+    auto size = ser::get_sizeof(positions());
+    perf_tests::do_not_optimize(size);
+    return positions().size();
+}
+
 }
@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <cmath>
+#include <random>
+
+#include <boost/range/irange.hpp>
+#include <fmt/ranges.h>
+#include <seastar/core/app-template.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/sleep.hh>
+
+#include "seastarx.hh"
+#include "test/lib/cql_test_env.hh"
+#include "test/lib/log.hh"
+#include "test/lib/random_utils.hh"
+#include "test/perf/perf.hh"
+#include "replica/database.hh"
+#include "compaction/compaction_manager.hh"
+#include "db/config.hh"
+#include "dht/token.hh"
+
+// A mix of point reads, writes and range scans on one table, with flushes and
+// compactions running in the background, to measure how the operations affect
+// the latency of each other.
+
+using namespace std::chrono_literals;
+
+enum class key_distribution { uniform, zipfian, latest };
+
+struct workload_config {
+    double read_weight;
+    double write_weight;
+    double scan_weight;
+    key_distribution distribution;
+    double zipfian_theta;
+    uint64_t partitions;
+    unsigned concurrency;
+    unsigned duration_in_seconds;
+    unsigned scan_rows;
+    size_t value_size;
+    std::chrono::milliseconds flush_period;
+    std::chrono::seconds major_compaction_period;
+};
+
+// Generates ranks in [0, n) with the zipfian distribution, 0 being the most
+// popular, with the method of Gray et al., "Quickly Generating Billion-Record
+// Synthetic Databases", as YCSB does.
+class zipfian_generator {
+    uint64_t _n;
+    double _theta;
+    double _alpha;
+    double _zetan;
+    double _eta;
+    std::uniform_real_distribution<double> _uniform{0, 1};
+private:
+    static double zeta(uint64_t n, double theta) {
+        double sum = 0;
+        for (uint64_t i = 1; i <= n; ++i) {
+            sum += 1 / std::pow(double(i), theta);
+        }
+        return sum;
+    }
+public:
+    zipfian_generator(uint64_t n, double theta)
+        : _n(n)
+        , _theta(theta)
+        , _alpha(1 / (1 - theta))
+        , _zetan(zeta(n, theta))
+        , _eta((1 - std::pow(2.0 / n, 1 - theta)) / (1 - zeta(2, theta) / _zetan))
+    { }
+
+    uint64_t operator()(std::default_random_engine& gen) {
+        const double u = _uniform(gen);
+        const double uz = u * _zetan;
+        if (uz < 1) {
+            return 0;
+        }
+        if (uz < 1 + std::pow(0.5, _theta)) {
+            return 1;
+        }
+        return std::min<uint64_t>(_n * std::pow(_eta * u - _eta + 1, _alpha), _n - 1);
+    }
+};
+
+enum class op_type { read, write, scan };
+static constexpr size_t op_types = 3;
+
+static std::string_view op_name(op_type op) {
+    switch (op) {
+    case op_type::read: return "read";
+    case op_type::write: return "write";
+    case op_type::scan: return "scan";
+    }
+    std::abort();
+}
+
+struct op_stats {
+    latency_histogram latencies;
+    uint64_t errors = 0;
+};
+
+struct shard_stats {
+    std::array<op_stats, op_types> ops;
+    std::chrono::nanoseconds busy_time{0};
+    std::chrono::nanoseconds idle_time{0};
+    int64_t compactions = 0;
+    uint64_t flushes = 0;
+
+    shard_stats& operator+=(const shard_stats& o) {
+        for (size_t i = 0; i < op_types; ++i) {
+            ops[i].latencies += o.ops[i].latencies;
+            ops[i].errors += o.ops[i].errors;
+        }
+        busy_time += o.busy_time;
+        idle_time += o.idle_time;
+        compactions += o.compactions;
+        flushes += o.flushes;
+        return *this;
+    }
+
+    double utilization() const {
+        auto total = busy_time + idle_time;
+        return total.count() ? double(busy_time.count()) / total.count() : 0;
+    }
+};
+
+struct statements {
+    cql3::prepared_cache_key_type read;
+    cql3::prepared_cache_key_type write;
+    cql3::prepared_cache_key_type scan;
+};
+
+// The workload of one shard: concurrency workers issuing the operations in
+// the configured ratios, and the fiber which flushes and compacts the table.
+class shard_workload {
+    cql_test_env& _env;
+    const workload_config& _cfg;
+    const statements& _stmts;
+    std::discrete_distribution<int> _ops;
+    std::optional<zipfian_generator> _zipfian;
+    // In the latest distribution the writes insert new partitions, past the
+    // initial ones. Shards insert at about the same rate, so the newest key
+    // is estimated from the insertions of this shard.
+    uint64_t _inserted = 0;
+    bytes _value;
+    shard_stats _stats;
+    bool _stopped = false;
+private:
+    uint64_t newest_key() const {
+        return _cfg.partitions + _inserted * smp::count;
+    }
+
+    uint64_t next_key() {
+        auto& gen = tests::random::gen();
+        switch (_cfg.distribution) {
+        case key_distribution::uniform:
+            return tests::random::get_int<uint64_t>(_cfg.partitions - 1);
+        case key_distribution::zipfian:
+            return (*_zipfian)(gen);
+        case key_distribution::latest:
+            return newest_key() - 1 - std::min(newest_key() - 1, (*_zipfian)(gen));
+        }
+        std::abort();
+    }
+
+    future<> execute(op_type op) {
+        switch (op) {
+        case op_type::read: {
+            auto key = int64_t(next_key());
+            return _env.execute_prepared(_stmts.read, {{cql3::raw_value::make_value(long_type->decompose(key))}}).discard_result();
+        }
+        case op_type::write: {
+            int64_t key;
+            if (_cfg.distribution == key_distribution::latest) {
+                key = newest_key() + this_shard_id();
+                ++_inserted;
+            } else {
+                key = next_key();
+            }
+            return _env.execute_prepared(_stmts.write, {
+                cql3::raw_value::make_value(long_type->decompose(key)),
+                cql3::raw_value::make_value(_value),
+            }).discard_result();
+        }
+        case op_type::scan: {
+            auto start = dht::token::to_int64(dht::token::get_random_token());
+            return _env.execute_prepared(_stmts.scan, {{cql3::raw_value::make_value(long_type->decompose(start))}}).discard_result();
+        }
+        }
+        std::abort();
+    }
+
+    future<> run_worker(lowres_clock::time_point end_at) {
+        using clk = std::chrono::steady_clock;
+        while (lowres_clock::now() < end_at) {
+            auto op = op_type(_ops(tests::random::gen()));
+            auto& stats = _stats.ops[size_t(op)];
+            auto start = clk::now();
+            auto f = co_await coroutine::as_future(execute(op));
+            stats.latencies.record(clk::now() - start);
+            if (f.failed()) {
+                ++stats.errors;
+                testlog.debug("{} failed: {}", op_name(op), f.get_exception());
+            }
+        }
+    }
+
+    future<> run_background(lowres_clock::time_point end_at) {
+        auto& t = _env.local_db().find_column_family("ks", "mixed");
+        auto next_major = lowres_clock::now() + _cfg.major_compaction_period;
+        while (lowres_clock::now() < end_at && !_stopped) {
+            co_await sleep(_cfg.flush_period);
+            co_await t.flush();
+            ++_stats.flushes;
+            if (_cfg.major_compaction_period.count() && lowres_clock::now() >= next_major) {
+                co_await t.compact_all_sstables(tasks::task_info{});
+                next_major = lowres_clock::now() + _cfg.major_compaction_period;
+            }
+        }
+    }
+public:
+    shard_workload(cql_test_env& env, const workload_config& cfg, const statements& stmts)
+        : _env(env)
+        , _cfg(cfg)
+        , _stmts(stmts)
+        , _ops({cfg.read_weight, cfg.write_weight, cfg.scan_weight})
+        , _value(tests::random::get_bytes(cfg.value_size))
+    {
+        if (cfg.distribution != key_distribution::uniform) {
+            _zipfian.emplace(cfg.partitions, cfg.zipfian_theta);
+        }
+    }
+
+    future<shard_stats> run() {
+        auto& r = engine();
+        auto& cm = _env.local_db().get_compaction_manager();
+        const auto busy_before = r.total_busy_time();
+        const auto idle_before = r.total_idle_time();
+        const auto compactions_before = cm.get_stats().completed_tasks;
+
+        const auto end_at = lowres_clock::now() + std::chrono::seconds(_cfg.duration_in_seconds);
+        auto background = _cfg.flush_period.count() ? run_background(end_at) : make_ready_future<>();
+        co_await parallel_for_each(boost::irange(0u, _cfg.concurrency), [this, end_at] (unsigned) {
+            return run_worker(end_at);
+        });
+        _stopped = true;
+        co_await std::move(background);
+
+        _stats.busy_time = r.total_busy_time() - busy_before;
+        _stats.idle_time = r.total_idle_time() - idle_before;
+        _stats.compactions = cm.get_stats().completed_tasks - compactions_before;
+        co_return std::move(_stats);
+    }
+
+    future<> stop() {
+        return make_ready_future<>();
+    }
+};
+
+static void print_stats(std::string_view name, const shard_stats& stats, unsigned duration_in_seconds) {
+    auto to_ms = [] (std::chrono::nanoseconds latency) {
+        return std::chrono::duration<double, std::milli>(latency).count();
+    };
+    fmt::print("{}: reactor utilization: {:.1f}%, flushes: {}, compactions: {}\n",
+            name, stats.utilization() * 100, stats.flushes, stats.compactions);
+    for (size_t i = 0; i < op_types; ++i) {
+        const auto& op = stats.ops[i];
+        const auto& l = op.latencies;
+        if (!l.count()) {
+            continue;
+        }
+        fmt::print("  {:>5}: {:10.2f} ops/s, p50: {:8.3f} [ms], p99: {:8.3f} [ms], p999: {:8.3f} [ms], max: {:8.3f} [ms], {} errors\n",
+                op_name(op_type(i)), double(l.count()) / duration_in_seconds,
+                to_ms(l.percentile(0.5)), to_ms(l.percentile(0.99)), to_ms(l.percentile(0.999)), to_ms(l.max()), op.errors);
+    }
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("reads", bpo::value<double>()->default_value(70), "weight of point reads in the mix")
+        ("writes", bpo::value<double>()->default_value(25), "weight of writes in the mix")
+        ("scans", bpo::value<double>()->default_value(5), "weight of range scans in the mix")
+        ("distribution", bpo::value<std::string>()->default_value("uniform"),
+                "distribution of the keys of reads and writes: uniform, zipfian or latest (zipfian over the most recently inserted keys, "
+                "writes insert new keys)")
+        ("zipfian-theta", bpo::value<double>()->default_value(0.99), "skew of the zipfian and latest distributions, in (0, 1)")
+        ("partitions", bpo::value<uint64_t>()->default_value(100000), "number of partitions to populate the table with")
+        ("value-size", bpo::value<size_t>()->default_value(1024), "size of the values written")
+        ("scan-rows", bpo::value<unsigned>()->default_value(100), "number of rows read by each range scan")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per shard")
+        ("duration", bpo::value<unsigned>()->default_value(30), "test duration in seconds")
+        ("compaction-strategy", bpo::value<std::string>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy of the table")
+        ("flush-period-ms", bpo::value<unsigned>()->default_value(1000),
+                "flush the memtables this often, so that compaction has new sstables to compact; 0 disables the flushes")
+        ("major-compaction-period", bpo::value<unsigned>()->default_value(0),
+                "run a major compaction this often [s], on top of the regular compactions; 0 disables them")
+        ("enable-cache", bpo::value<bool>()->default_value(true), "enable row cache")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        auto db_cfg = make_shared<db::config>();
+        db_cfg->enable_commitlog(false);
+        db_cfg->enable_cache(app.configuration()["enable-cache"].as<bool>());
+
+        return do_with_cql_env_thread([&app] (cql_test_env& env) {
+            const auto& opts = app.configuration();
+            workload_config cfg{
+                .read_weight = opts["reads"].as<double>(),
+                .write_weight = opts["writes"].as<double>(),
+                .scan_weight = opts["scans"].as<double>(),
+                .zipfian_theta = opts["zipfian-theta"].as<double>(),
+                .partitions = opts["partitions"].as<uint64_t>(),
+                .concurrency = opts["concurrency"].as<unsigned>(),
+                .duration_in_seconds = opts["duration"].as<unsigned>(),
+                .scan_rows = opts["scan-rows"].as<unsigned>(),
+                .value_size = opts["value-size"].as<size_t>(),
+                .flush_period = std::chrono::milliseconds(opts["flush-period-ms"].as<unsigned>()),
+                .major_compaction_period = std::chrono::seconds(opts["major-compaction-period"].as<unsigned>()),
+            };
+            const auto distribution = opts["distribution"].as<std::string>();
+            if (distribution == "uniform") {
+                cfg.distribution = key_distribution::uniform;
+            } else if (distribution == "zipfian") {
+                cfg.distribution = key_distribution::zipfian;
+            } else if (distribution == "latest") {
+                cfg.distribution = key_distribution::latest;
+            } else {
+                throw std::invalid_argument(fmt::format("unknown key distribution: {}", distribution));
+            }
+            if (cfg.zipfian_theta <= 0 || cfg.zipfian_theta >= 1) {
+                throw std::invalid_argument("--zipfian-theta must be in (0, 1)");
+            }
+            if (cfg.read_weight < 0 || cfg.write_weight < 0 || cfg.scan_weight < 0
+                    || cfg.read_weight + cfg.write_weight + cfg.scan_weight <= 0) {
+                throw std::invalid_argument("the weights of the operations must be non-negative, and not all zero");
+            }
+            if (cfg.partitions < 2) {
+                throw std::invalid_argument("--partitions must be at least 2");
+            }
+
+            env.execute_cql(fmt::format("CREATE TABLE ks.mixed (pk bigint PRIMARY KEY, v blob) WITH compaction = {{'class': '{}'}}",
+                    opts["compaction-strategy"].as<std::string>())).get();
+
+            statements stmts{
+                .read = env.prepare("SELECT v FROM ks.mixed WHERE pk = ?").get(),
+                .write = env.prepare("INSERT INTO ks.mixed (pk, v) VALUES (?, ?)").get(),
+                .scan = env.prepare(fmt::format("SELECT pk, v FROM ks.mixed WHERE token(pk) >= ? LIMIT {}", cfg.scan_rows)).get(),
+            };
+
+            testlog.info("Populating {} partitions", cfg.partitions);
+            auto value = tests::random::get_bytes(cfg.value_size);
+            max_concurrent_for_each(boost::irange(uint64_t(0), cfg.partitions), 100, [&] (uint64_t key) {
+                return env.execute_prepared(stmts.write, {
+                    cql3::raw_value::make_value(long_type->decompose(int64_t(key))),
+                    cql3::raw_value::make_value(value),
+                }).discard_result();
+            }).get();
+            env.db().invoke_on_all(&replica::database::flush_all_memtables).get();
+
+            fmt::print("Running for {} s: reads/writes/scans = {}/{}/{}, {} keys, {} workers per shard\n",
+                    cfg.duration_in_seconds, cfg.read_weight, cfg.write_weight, cfg.scan_weight, distribution, cfg.concurrency);
+            sharded<shard_workload> workload;
+            workload.start(std::ref(env), std::cref(cfg), std::cref(stmts)).get();
+            auto stop_workload = defer([&workload] {
+                workload.stop().get();
+            });
+            auto results = workload.map(std::mem_fn(&shard_workload::run)).get();
+
+            shard_stats total;
+            for (unsigned shard = 0; shard < results.size(); ++shard) {
+                print_stats(fmt::format("shard {}", shard), results[shard], cfg.duration_in_seconds);
+                total += results[shard];
+            }
+            print_stats("total", total, cfg.duration_in_seconds);
+        }, cql_test_config(db_cfg));
+    });
+}
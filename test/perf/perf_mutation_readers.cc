@@ -35,12 +35,14 @@ class combined {
     std::vector<std::vector<mutation>> _disjoint_interleaved;
     std::vector<std::vector<mutation>> _disjoint_ranges;
     std::vector<std::vector<mutation>> _overlapping_partitions_disjoint_rows;
+    std::vector<std::vector<mutation>> _high_fan_in_disjoint_rows;
 private:
     static std::vector<mutation> create_one_row(simple_schema&, reader_permit);
     static std::vector<mutation> create_single_stream(simple_schema&, reader_permit);
     static std::vector<std::vector<mutation>> create_disjoint_interleaved_streams(simple_schema&, reader_permit);
     static std::vector<std::vector<mutation>> create_disjoint_ranges_streams(simple_schema&, reader_permit);
-    static std::vector<std::vector<mutation>> create_overlapping_partitions_disjoint_rows_streams(simple_schema&, reader_permit);
+    static std::vector<std::vector<mutation>> create_overlapping_partitions_disjoint_rows_streams(simple_schema&, reader_permit,
+            int streams = 4, int rows = 32);
 protected:
     simple_schema& schema() const { return _schema; }
     reader_permit permit() const { return _permit; }
@@ -55,6 +57,9 @@ class combined {
     const std::vector<std::vector<mutation>>& overlapping_partitions_disjoint_rows_streams() const {
         return _overlapping_partitions_disjoint_rows;
     }
+    const std::vector<std::vector<mutation>>& high_fan_in_disjoint_rows_streams() const {
+        return _high_fan_in_disjoint_rows;
+    }
     future<> consume_all(mutation_reader mr) const;
 public:
     combined()
@@ -65,7 +70,12 @@ class combined {
         , _disjoint_interleaved(create_disjoint_interleaved_streams(_schema, _permit))
         , _disjoint_ranges(create_disjoint_ranges_streams(_schema, _permit))
         , _overlapping_partitions_disjoint_rows(create_overlapping_partitions_disjoint_rows_streams(_schema, _permit))
+        , _high_fan_in_disjoint_rows(create_overlapping_partitions_disjoint_rows_streams(_schema, _permit, high_fan_in, 4))
     { }
+
+    // The number of readers of the high fan-in cases, e.g. a compaction of
+    // many overlapping size-tiered sstables.
+    static constexpr int high_fan_in = 32;
 };
 
 std::vector<mutation> combined::create_one_row(simple_schema& s, reader_permit permit)
@@ -122,16 +132,17 @@ std::vector<std::vector<mutation>> combined::create_disjoint_ranges_streams(simp
     return mss;
 }
 
-std::vector<std::vector<mutation>> combined::create_overlapping_partitions_disjoint_rows_streams(simple_schema& s, reader_permit permit) {
+std::vector<std::vector<mutation>> combined::create_overlapping_partitions_disjoint_rows_streams(simple_schema& s, reader_permit permit,
+        int streams, int rows) {
     auto keys = s.make_pkeys(4);
     std::vector<std::vector<mutation>> mss;
-    for (int i = 0; i < 4; i++) {
+    for (int i = 0; i < streams; i++) {
         mss.emplace_back(boost::copy_range<std::vector<mutation>>(
             keys
             | boost::adaptors::transformed([&] (auto& dkey) {
                 auto m = mutation(s.schema(), dkey);
-                for (int j = 0; j < 32; j++) {
-                    m.apply(s.make_row(permit, s.make_ckey(32 * i + j), "value"));
+                for (int j = 0; j < rows; j++) {
+                    m.apply(s.make_row(permit, s.make_ckey(rows * i + j), "value"));
                 }
                 return m;
             })
@@ -224,6 +235,47 @@ PERF_TEST_F(combined, overlapping_partitions_disjoint_rows)
     ));
 }
 
+PERF_TEST_F(combined, high_fan_in_overlapping)
+{
+    std::vector<mutation_reader> mrs;
+    mrs.reserve(high_fan_in);
+    for (auto i = 0; i < high_fan_in; i++) {
+        mrs.emplace_back(make_mutation_reader_from_mutations_v2(schema().schema(), permit(), single_stream()));
+    }
+    return consume_all(make_combined_reader(schema().schema(), permit(), std::move(mrs)));
+}
+
+PERF_TEST_F(combined, high_fan_in_disjoint_rows)
+{
+    return consume_all(make_combined_reader(schema().schema(), permit(),
+        boost::copy_range<std::vector<mutation_reader>>(
+            high_fan_in_disjoint_rows_streams()
+            | boost::adaptors::transformed([this] (auto&& ms) {
+                return make_mutation_reader_from_mutations_v2(schema().schema(), permit(), std::move(ms));
+            })
+        )
+    ));
+}
+
+// One reader has all the rows of the partitions, the others only a row at
+// their end, so the merger gallops over the rows of the first one.
+PERF_TEST_F(combined, high_fan_in_one_ahead)
+{
+    std::vector<mutation_reader> mrs;
+    mrs.reserve(high_fan_in);
+    mrs.emplace_back(make_mutation_reader_from_mutations_v2(schema().schema(), permit(), single_stream()));
+    for (auto i = 1; i < high_fan_in; i++) {
+        auto ms = boost::copy_range<std::vector<mutation>>(single_stream()
+            | boost::adaptors::transformed([&] (const mutation& m) {
+                auto last = mutation(m.schema(), m.decorated_key());
+                last.apply(schema().make_row(permit(), schema().make_ckey(16), "value"));
+                return last;
+            }));
+        mrs.emplace_back(make_mutation_reader_from_mutations_v2(schema().schema(), permit(), std::move(ms)));
+    }
+    return consume_all(make_combined_reader(schema().schema(), permit(), std::move(mrs)));
+}
+
 struct mutation_bounds {
     mutation m;
     position_in_partition lower;
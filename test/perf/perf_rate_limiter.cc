@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/perf_tests.hh>
+
+#include "db/rate_limiter.hh"
+
+// Measures the cost of accounting an operation in the per-partition rate
+// limiter, with operations spread over many distinct partitions.
+class rate_limiter_ops {
+public:
+    static constexpr uint64_t distinct_keys = 10'000'000;
+    static constexpr size_t ops_per_iteration = 1000;
+private:
+    db::rate_limiter _limiter;
+    db::rate_limiter::label _label;
+    db::per_partition_rate_limit::account_and_enforce _info{.random_variable = 0};
+    uint64_t _next_key = 0;
+
+    uint64_t next_token() noexcept {
+        auto key = _next_key;
+        _next_key = (_next_key + 1) % distinct_keys;
+        // A bijection, so the tokens are distinct but not sequential.
+        return key * 0x9e3779b97f4a7c15ull;
+    }
+public:
+    size_t run(db::rate_limiter::accounting acc) {
+        for (size_t i = 0; i < ops_per_iteration; i++) {
+            perf_tests::do_not_optimize(_limiter.account_operation(_label, next_token(), 1000, _info, acc));
+        }
+        return ops_per_iteration;
+    }
+};
+
+PERF_TEST_F(rate_limiter_ops, hash_table) {
+    return run(db::rate_limiter::accounting::hash_table);
+}
+
+PERF_TEST_F(rate_limiter_ops, sketch) {
+    return run(db::rate_limiter::accounting::sketch);
+}
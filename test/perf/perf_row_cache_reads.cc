@@ -221,13 +221,18 @@ void test_scan_with_range_delete_over_rows() {
 
 int main(int argc, char** argv) {
     app_template app;
-    return app.run(argc, argv, [] {
+    app.add_options()
+        ("lsa-huge-pages", "Back LSA segments with transparent huge pages");
+    return app.run(argc, argv, [&app] {
         return seastar::async([&] {
             engine().at_exit([] {
                 cancelled = true;
                 return make_ready_future();
             });
             logalloc::prime_segment_pool(memory::stats().total_memory(), memory::min_free_memory()).get();
+            if (app.configuration().contains("lsa-huge-pages")) {
+                logalloc::use_huge_pages_for_segment_pool().get();
+            }
             test_scans_with_dummy_entries();
             test_scan_with_range_delete_over_rows();
         });
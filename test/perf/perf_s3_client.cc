@@ -24,14 +24,19 @@ class tester {
     std::string _object_name;
     size_t _object_size;
     semaphore _mem;
+    bool _download;
     shared_ptr<s3::client> _client;
     utils::estimated_histogram _reads_hist;
     unsigned _errors = 0;
+    uint64_t _downloaded_bytes = 0;
+    std::chrono::steady_clock::duration _download_time{};
 
-    static s3::endpoint_config_ptr make_config() {
+    static s3::endpoint_config_ptr make_config(size_t part_size, unsigned concurrency) {
         s3::endpoint_config cfg;
         cfg.port = 443;
         cfg.use_https = true;
+        cfg.download_part_size = part_size;
+        cfg.download_concurrency = concurrency;
         cfg.aws.emplace();
         cfg.aws->access_key_id = tests::getenv_safe("AWS_ACCESS_KEY_ID");
         cfg.aws->secret_access_key = tests::getenv_safe("AWS_SECRET_ACCESS_KEY");
@@ -48,13 +53,14 @@ class tester {
     std::chrono::steady_clock::time_point now() const { return std::chrono::steady_clock::now(); }
 
 public:
-    tester(std::chrono::seconds dur, unsigned prl, size_t obj_size)
+    tester(std::chrono::seconds dur, unsigned prl, size_t obj_size, bool download, size_t part_size, unsigned concurrency)
             : _duration(dur)
             , _parallel(prl)
             , _object_name(fmt::format("/{}/perfobject-{}-{}", tests::getenv_safe("S3_BUCKET_FOR_TEST"), ::getpid(), this_shard_id()))
             , _object_size(obj_size)
             , _mem(memory::stats().total_memory())
-            , _client(s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), make_config(), _mem))
+            , _download(download)
+            , _client(s3::client::make(tests::getenv_safe("S3_SERVER_ADDRESS_FOR_TEST"), make_config(part_size, concurrency), _mem))
     {}
 
     future<> start() {
@@ -82,7 +88,33 @@ class tester {
 
 private:
 
+    // Reads the whole object through a download source, over and over.
+    future<> do_download() {
+        auto until = now() + _duration;
+        do {
+            auto start = now();
+            auto in = input_stream<char>(_client->make_download_source(_object_name));
+            try {
+                while (auto buf = co_await in.read()) {
+                    _downloaded_bytes += buf.size();
+                }
+                _reads_hist.add(std::chrono::duration_cast<std::chrono::milliseconds>(now() - start).count());
+            } catch (...) {
+                _errors++;
+            }
+            co_await in.close();
+            _download_time += now() - start;
+        } while (now() < until);
+    }
+
     future<> do_run() {
+        if (_download) {
+            return do_download();
+        }
+        return do_read_chunks();
+    }
+
+    future<> do_read_chunks() {
         auto until = now() + _duration;
         uint64_t off = 0;
         do {
@@ -122,6 +154,10 @@ class tester {
             );
         };
         plog.info("reads total: {:5}, errors: {:5}; latencies: {}", _reads_hist._count, _errors, print_percentiles(_reads_hist));
+        if (_download) {
+            auto secs = std::chrono::duration<double>(_download_time).count() / _parallel;
+            plog.info("downloaded: {} bytes, throughput: {:.1f} MB/s", _downloaded_bytes, secs > 0 ? _downloaded_bytes / secs / (1 << 20) : 0.0);
+        }
     }
 };
 
@@ -132,15 +168,21 @@ int main(int argc, char** argv) {
         ("duration", bpo::value<unsigned>()->default_value(10), "seconds to run")
         ("parallel", bpo::value<unsigned>()->default_value(1), "number of parallel fibers")
         ("object_size", bpo::value<size_t>()->default_value(1 << 20), "size of test object")
+        ("download", bpo::value<bool>()->default_value(false), "read the whole object with a download source, instead of reading small chunks of it")
+        ("part_size", bpo::value<size_t>()->default_value(8 << 20), "size of the ranged GETs of the download source")
+        ("concurrency", bpo::value<unsigned>()->default_value(4), "number of parallel ranged GETs of the download source")
     ;
 
     return app.run(argc, argv, [&app] () -> future<> {
         auto dur = std::chrono::seconds(app.configuration()["duration"].as<unsigned>());
         auto prl = app.configuration()["parallel"].as<unsigned>();
         auto osz = app.configuration()["object_size"].as<size_t>();
+        auto download = app.configuration()["download"].as<bool>();
+        auto part_size = app.configuration()["part_size"].as<size_t>();
+        auto concurrency = app.configuration()["concurrency"].as<unsigned>();
         sharded<tester> test;
         plog.info("Creating");
-        co_await test.start(dur, prl, osz);
+        co_await test.start(dur, prl, osz, download, part_size, concurrency);
         plog.info("Starting");
         co_await test.invoke_on_all(&tester::start);
         try {
@@ -24,6 +24,7 @@
 #include "schema/schema_builder.hh"
 #include "release.hh"
 #include <fstream>
+#include <variant>
 #include "service/storage_proxy.hh"
 #include "cql3/query_processor.hh"
 #include "db/config.hh"
@@ -78,8 +79,25 @@ struct test_config {
     sstring timeout;
     bool bypass_cache;
     std::optional<unsigned> initial_tablets;
+    // Requests per second per shard of the open-loop mode, which runs
+    // instead of the closed loop of concurrency workers when set.
+    std::optional<double> rate;
+    arrival_process arrival = arrival_process::poisson;
+    unsigned max_in_flight = 0;
 };
 
+// The throughput of each iteration of a closed-loop run, or the latencies of an
+// open-loop one.
+using test_results = std::variant<std::vector<perf_result>, open_loop_result>;
+
+template <typename Func>
+static test_results run_test(const test_config& cfg, Func func) {
+    if (cfg.rate) {
+        return time_open_loop(std::move(func), *cfg.rate, cfg.arrival, cfg.duration_in_seconds, cfg.max_in_flight, cfg.stop_on_error);
+    }
+    return time_parallel(std::move(func), cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+}
+
 std::ostream& operator<<(std::ostream& os, const test_config::run_mode& m) {
     switch (m) {
         case test_config::run_mode::write: return os << "write";
@@ -98,8 +116,13 @@ std::ostream& operator<<(std::ostream& os, const test_config::frontend_type& f)
 }
 
 std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
-    return os << "{partitions=" << cfg.partitions
-           << ", concurrency=" << cfg.concurrency
+    os << "{partitions=" << cfg.partitions;
+    if (cfg.rate) {
+        os << ", rate=" << *cfg.rate << ", arrival=" << fmt::to_string(cfg.arrival);
+    } else {
+        os << ", concurrency=" << cfg.concurrency;
+    }
+    return os
            << ", mode=" << cfg.mode
            << ", frontend=" << cfg.frontend
            << ", query_single_key=" << (cfg.query_single_key ? "yes" : "no")
@@ -136,7 +159,7 @@ static bytes make_random_key(test_config& cfg) {
     return make_key(make_random_seq(cfg));
 }
 
-static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
+static test_results test_read(cql_test_env& env, test_config& cfg) {
     create_partitions(env, cfg);
     sstring query = "select \"C0\", \"C1\", \"C2\", \"C3\", \"C4\" from cf where \"KEY\" = ?";
     if (cfg.bypass_cache) {
@@ -146,13 +169,13 @@ static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
         query += " using timeout " + cfg.timeout;
     }
     auto id = env.prepare(query).get();
-    return time_parallel([&env, &cfg, id] {
+    return run_test(cfg, [&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        });
 }
 
-static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg) {
+static test_results test_write(cql_test_env& env, test_config& cfg) {
     sstring usings;
     if (!cfg.timeout.empty()) {
         usings += "USING TIMEOUT " + cfg.timeout;
@@ -165,13 +188,13 @@ static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg)
             "\"C4\" = 0x222fcbe31ffa1e689540e1499b87fa3f9c781065fccd10e4772b4c7039c2efd0fb27 "
             "WHERE \"KEY\" = ?", usings);
     auto id = env.prepare(query).get();
-    return time_parallel([&env, &cfg, id] {
+    return run_test(cfg, [&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        });
 }
 
-static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg) {
+static test_results test_delete(cql_test_env& env, test_config& cfg) {
     create_partitions(env, cfg);
     sstring usings;
     if (!cfg.timeout.empty()) {
@@ -179,13 +202,13 @@ static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg)
     }
     sstring query = format("DELETE \"C0\", \"C1\", \"C2\", \"C3\", \"C4\" FROM cf {}WHERE \"KEY\" = ?", usings);
     auto id = env.prepare(query).get();
-    return time_parallel([&env, &cfg, id] {
+    return run_test(cfg, [&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        });
 }
 
-static std::vector<perf_result> test_counter_update(cql_test_env& env, test_config& cfg) {
+static test_results test_counter_update(cql_test_env& env, test_config& cfg) {
     sstring usings;
     if (!cfg.timeout.empty()) {
         usings += "USING TIMEOUT " + cfg.timeout;
@@ -198,10 +221,10 @@ static std::vector<perf_result> test_counter_update(cql_test_env& env, test_conf
             "\"C4\" = \"C4\" + 5 "
             "WHERE \"KEY\" = ?", usings);
     auto id = env.prepare(query).get();
-    return time_parallel([&env, &cfg, id] {
+    return run_test(cfg, [&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+        });
 }
 
 static schema_ptr make_counter_schema(std::string_view ks_name) {
@@ -289,7 +312,7 @@ static void create_alternator_partitions(service::client_state& state, noncopyab
     }
 }
 
-static std::vector<perf_result> test_alternator_read(service::client_state& state, noncopyable_function<void()> flush_memtables,
+static test_results test_alternator_read(service::client_state& state, noncopyable_function<void()> flush_memtables,
         alternator::executor& executor, test_config& cfg) {
     create_alternator_partitions(state, std::move(flush_memtables), executor, cfg);
     std::string prefix = R"(
@@ -305,7 +328,7 @@ static std::vector<perf_result> test_alternator_read(service::client_state& stat
                 "ReturnConsumedCapacity": "TOTAL"
             }
         )";
-    return time_parallel([&] {
+    return run_test(cfg, [&] {
         auto key = std::to_string(make_random_seq(cfg));
         // Chunked content is used to minimize string copying, and thus extra allocations
         rjson::chunked_content content;
@@ -314,11 +337,11 @@ static std::vector<perf_result> test_alternator_read(service::client_state& stat
         content.emplace_back(key.data(), key.size(), deleter{});
         content.emplace_back(postfix.data(), postfix.size(), deleter{});
         return executor.get_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    });
 }
 
-static std::vector<perf_result> test_alternator_write(service::client_state& state, alternator::executor& executor, test_config& cfg) {
-    return time_parallel([&] {
+static test_results test_alternator_write(service::client_state& state, alternator::executor& executor, test_config& cfg) {
+    return run_test(cfg, [&] {
         std::string prefix = R"(
             {
                 "TableName": "alternator_table",
@@ -357,13 +380,13 @@ static std::vector<perf_result> test_alternator_write(service::client_state& sta
         content.emplace_back(key.data(), key.size(), deleter{});
         content.emplace_back(postfix.data(), postfix.size(), deleter{});
         return executor.update_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    });
 }
 
-static std::vector<perf_result> test_alternator_delete(service::client_state& state, noncopyable_function<void()> flush_memtables,
+static test_results test_alternator_delete(service::client_state& state, noncopyable_function<void()> flush_memtables,
         alternator::executor& executor, test_config& cfg) {
     create_alternator_partitions(state, std::move(flush_memtables), executor, cfg);
-    return time_parallel([&] {
+    return run_test(cfg, [&] {
         std::string json = R"(
             {
                 "TableName": "alternator_table",
@@ -376,10 +399,10 @@ static std::vector<perf_result> test_alternator_delete(service::client_state& st
             }
         )";
         return executor.delete_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(json)).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
+    });
 }
 
-static std::vector<perf_result> do_alternator_test(std::string isolation_level,
+static test_results do_alternator_test(std::string isolation_level,
         service::client_state& state,
         sharded<cql3::query_processor>& qp,
         sharded<service::migration_manager>& mm,
@@ -417,7 +440,7 @@ static std::vector<perf_result> do_alternator_test(std::string isolation_level,
     abort();
 }
 
-static std::vector<perf_result> do_cql_test(cql_test_env& env, test_config& cfg) {
+static test_results do_cql_test(cql_test_env& env, test_config& cfg) {
     SCYLLA_ASSERT(cfg.frontend == test_config::frontend_type::cql);
 
     std::cout << "Running test with config: " << cfg << std::endl;
@@ -456,20 +479,7 @@ static std::vector<perf_result> do_cql_test(cql_test_env& env, test_config& cfg)
     abort();
 }
 
-void write_json_result(std::string result_file, const test_config& cfg, const aggregated_perf_results& agg) {
-    Json::Value results;
-
-    Json::Value params;
-    params["concurrency"] = cfg.concurrency;
-    params["partitions"] = cfg.partitions;
-    params["cpus"] = smp::count;
-    params["duration"] = cfg.duration_in_seconds;
-    params["concurrency,partitions,cpus,duration"] = fmt::format("{},{},{},{}", cfg.concurrency, cfg.partitions, smp::count, cfg.duration_in_seconds);
-    if (cfg.initial_tablets) {
-        params["initial_tablets"] = cfg.initial_tablets.value();
-    }
-    results["parameters"] = std::move(params);
-
+static Json::Value make_json_stats(const aggregated_perf_results& agg) {
     Json::Value stats;
     auto med = agg.median_by_throughput;
     stats["median tps"] = med.throughput;
@@ -482,6 +492,52 @@ void write_json_result(std::string result_file, const test_config& cfg, const ag
     stats["mad tps"] = tps.median_absolute_deviation;
     stats["max tps"] = tps.max;
     stats["min tps"] = tps.min;
+    return stats;
+}
+
+static Json::Value make_json_latency_stats(const open_loop_shard_result& result) {
+    auto to_us = [] (std::chrono::nanoseconds latency) {
+        return std::chrono::duration<double, std::micro>(latency).count();
+    };
+    Json::Value stats;
+    stats["tps"] = result.throughput;
+    stats["requests"] = Json::UInt64(result.invocations);
+    stats["errors"] = Json::UInt64(result.errors);
+    stats["p50 latency us"] = to_us(result.latencies.percentile(0.5));
+    stats["p99 latency us"] = to_us(result.latencies.percentile(0.99));
+    stats["p999 latency us"] = to_us(result.latencies.percentile(0.999));
+    stats["max latency us"] = to_us(result.latencies.max());
+    return stats;
+}
+
+static Json::Value make_json_stats(const open_loop_result& result) {
+    auto stats = make_json_latency_stats(result.total);
+    Json::Value shards(Json::arrayValue);
+    for (const auto& shard : result.shards) {
+        shards.append(make_json_latency_stats(shard));
+    }
+    stats["shards"] = std::move(shards);
+    return stats;
+}
+
+void write_json_result(std::string result_file, const test_config& cfg, Json::Value stats) {
+    Json::Value results;
+
+    Json::Value params;
+    params["concurrency"] = cfg.concurrency;
+    params["partitions"] = cfg.partitions;
+    params["cpus"] = smp::count;
+    params["duration"] = cfg.duration_in_seconds;
+    params["concurrency,partitions,cpus,duration"] = fmt::format("{},{},{},{}", cfg.concurrency, cfg.partitions, smp::count, cfg.duration_in_seconds);
+    if (cfg.initial_tablets) {
+        params["initial_tablets"] = cfg.initial_tablets.value();
+    }
+    if (cfg.rate) {
+        params["rate"] = *cfg.rate;
+        params["arrival"] = fmt::to_string(cfg.arrival);
+        params["max_in_flight"] = cfg.max_in_flight;
+    }
+    results["parameters"] = std::move(params);
     results["stats"] = std::move(stats);
 
     std::string test_type;
@@ -493,6 +549,9 @@ void write_json_result(std::string result_file, const test_config& cfg, const ag
     if (cfg.counters) {
         test_type += "_counters";
     }
+    if (cfg.rate) {
+        test_type += "_open_loop";
+    }
     results["test_properties"]["type"] = test_type;
 
     // <version>-<release>
@@ -546,6 +605,10 @@ int scylla_simple_query_main(int argc, char** argv) {
         ("stop-on-error", bpo::value<bool>()->default_value(true), "stop after encountering the first error")
         ("timeout", bpo::value<std::string>()->default_value(""), "use timeout")
         ("bypass-cache", "use bypass cache when querying")
+        ("rate", bpo::value<double>(), "run open-loop instead of with concurrency workers: issue this many requests per second per shard, "
+                "and report the latencies")
+        ("arrival", bpo::value<std::string>()->default_value("poisson"), "arrival process of the open-loop requests: poisson or constant")
+        ("max-in-flight", bpo::value<unsigned>()->default_value(10000), "limit of in-flight open-loop requests per shard")
         ;
 
     set_abort_on_internal_error(true);
@@ -601,14 +664,36 @@ int scylla_simple_query_main(int argc, char** argv) {
             cfg.stop_on_error = app.configuration()["stop-on-error"].as<bool>();
             cfg.timeout = app.configuration()["timeout"].as<std::string>();
             cfg.bypass_cache = app.configuration().contains("bypass-cache");
+            if (app.configuration().contains("rate")) {
+                cfg.rate = app.configuration()["rate"].as<double>();
+                if (*cfg.rate <= 0) {
+                    throw std::invalid_argument("--rate must be positive");
+                }
+                const auto arrival = app.configuration()["arrival"].as<std::string>();
+                if (arrival == "poisson") {
+                    cfg.arrival = arrival_process::poisson;
+                } else if (arrival == "constant") {
+                    cfg.arrival = arrival_process::constant;
+                } else {
+                    throw std::invalid_argument(fmt::format("unknown arrival process: {}", arrival));
+                }
+                cfg.max_in_flight = app.configuration()["max-in-flight"].as<unsigned>();
+            }
             auto results = cfg.frontend == test_config::frontend_type::cql
                     ? do_cql_test(env, cfg)
                     : do_alternator_test(app.configuration()["alternator"].as<std::string>(),
                             env.local_client_state(), env.qp(), env.migration_manager(), env.gossiper(), cfg);
-            aggregated_perf_results agg(results);
-            std::cout << agg << std::endl;
+            Json::Value stats;
+            if (auto* open_loop = std::get_if<open_loop_result>(&results)) {
+                fmt::print("{}\n", *open_loop);
+                stats = make_json_stats(*open_loop);
+            } else {
+                aggregated_perf_results agg(std::get<std::vector<perf_result>>(results));
+                std::cout << agg << std::endl;
+                stats = make_json_stats(agg);
+            }
             if (app.configuration().contains("json-result")) {
-                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, agg);
+                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, std::move(stats));
             }
           }, std::move(cfg));
         });
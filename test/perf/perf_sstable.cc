@@ -11,6 +11,7 @@
 #include <seastar/core/app-template.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/reactor.hh>
+#include <fcntl.h>
 #include <random>
 
 // hack: perf_sstable falsely depends on Boost.Test, but we can't include it with
@@ -19,6 +20,9 @@
 #define BOOST_CHECK_NO_THROW(x) (void)(x)
 
 #include "test/perf/perf_sstable.hh"
+#include "test/perf/perf.hh"
+#include "readers/combined.hh"
+#include "tools/schema_loader.hh"
 
 using namespace sstables;
 
@@ -61,6 +65,238 @@ future<> test_partitioned_streaming(distributed<perf_sstable_test_env>& dt) {
     return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::partitioned_streaming);
 }
 
+// Reads sstables which weren't written by this tool, e.g. ones copied from a
+// production node, so that the partition sizes, the promoted indexes and the
+// on-disk layout are realistic. Each phase starts with cold caches, unless
+// asked otherwise, and reports the latency of the reads and the I/O they did.
+class existing_sstables_test {
+public:
+    struct conf {
+        sstring dir;
+        // CQL statements describing the table (e.g. from DESCRIBE TABLE). If
+        // not given, the schema is loaded from the serialization header of
+        // one of the sstables.
+        sstring schema_file;
+        unsigned reads;
+        unsigned slice_rows;
+        unsigned parallelism;
+        bool drop_caches;
+    };
+
+private:
+    struct phase_result {
+        uint64_t reads = 0;
+        uint64_t partitions = 0;
+        uint64_t rows = 0;
+        std::chrono::duration<double> duration{0};
+        uint64_t aio_reads = 0;
+        uint64_t aio_read_bytes = 0;
+        latency_histogram latencies;
+    };
+
+    struct read_stats {
+        uint64_t partitions = 0;
+        uint64_t rows = 0;
+    };
+
+    using clk = std::chrono::steady_clock;
+
+    test_env& _env;
+    conf _cfg;
+    schema_ptr _s;
+    std::vector<shared_sstable> _sst;
+    lw_shared_ptr<sstable_set> _set;
+    // The targets of the partition reads, sampled from the summaries.
+    std::vector<dht::decorated_key> _keys;
+
+    schema_ptr load_schema() {
+        if (!_cfg.schema_file.empty()) {
+            return tools::load_one_schema_from_file(_env.db_config(), std::filesystem::path(_cfg.schema_file)).get();
+        }
+        for (auto& de : std::filesystem::directory_iterator(std::filesystem::path(_cfg.dir))) {
+            if (de.path().native().ends_with("-Data.db")) {
+                return tools::load_schema_from_sstable(_env.db_config(), de.path()).get();
+            }
+        }
+        throw std::runtime_error(format("No sstables found in {}", _cfg.dir));
+    }
+
+    void load_sstables() {
+        for (auto& de : std::filesystem::directory_iterator(std::filesystem::path(_cfg.dir))) {
+            if (!de.is_regular_file() || !de.path().native().ends_with("-TOC.txt")) {
+                continue;
+            }
+            auto entry = parse_path(de.path(), _s->ks_name(), _s->cf_name());
+            auto sst = _env.make_sstable(_s, _cfg.dir, entry.generation, entry.version, entry.format);
+            sst->load(_s->get_sharder()).get();
+            _sst.push_back(std::move(sst));
+        }
+        if (_sst.empty()) {
+            throw std::runtime_error(format("No sstables found in {}", _cfg.dir));
+        }
+        _set = make_lw_shared<sstable_set>(make_partitioned_sstable_set(_s, false));
+        for (auto& sst : _sst) {
+            _set->insert(sst);
+        }
+    }
+
+    void sample_keys() {
+        std::vector<std::pair<shared_sstable, size_t>> entries;
+        for (auto& sst : _sst) {
+            for (size_t i = 0; i < sst->get_summary().entries.size(); ++i) {
+                entries.emplace_back(sst, i);
+            }
+        }
+        if (entries.empty()) {
+            throw std::runtime_error("The sstables have no summary entries to sample the keys from");
+        }
+        for (unsigned i = 0; i < _cfg.reads; ++i) {
+            auto& [sst, idx] = entries[tests::random::get_int<size_t>(0, entries.size() - 1)];
+            auto pk = sstables::key_view(sst->get_summary().entries[idx].key).to_partition_key(*_s);
+            _keys.push_back(dht::decorate_key(*_s, std::move(pk)));
+        }
+    }
+
+    // Drops everything which could serve the reads from memory: the index
+    // caches of the sstables and the pages the OS keeps of their files.
+    // sstables are read with O_DIRECT, so the page cache matters only on
+    // file systems which don't honour it, or for the pages left by copying
+    // the files in. There is no row cache in the way, the reads go directly
+    // to the sstables.
+    void drop_caches() {
+        for (auto& sst : _sst) {
+            sst->drop_caches().get();
+            for (auto& name : sst->component_filenames()) {
+                // Blocks the reactor, but this happens between the phases only.
+                auto fd = ::open(name.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    continue;
+                }
+                ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+                ::close(fd);
+            }
+        }
+    }
+
+    // Like the single partition read path of the table: only the sstables
+    // the bloom filter of which has the key are read.
+    mutation_reader make_partition_reader(const dht::decorated_key& key, const dht::partition_range& range) {
+        std::vector<mutation_reader> readers;
+        for (auto& sst : _set->select(range)) {
+            if (sst->filter_has_key(*_s, key)) {
+                readers.push_back(sst->make_reader(_s, _env.make_reader_permit(), range, _s->full_slice(), {},
+                        streamed_mutation::forwarding::no, mutation_reader::forwarding::no));
+            }
+        }
+        return make_combined_reader(_s, _env.make_reader_permit(), std::move(readers),
+                streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+    }
+
+    // Reads at most row_limit rows of each partition, all of them if 0.
+    static future<read_stats> consume(mutation_reader r, unsigned row_limit) {
+        read_stats stats;
+        std::exception_ptr ex;
+        try {
+            uint64_t partition_rows = 0;
+            while (auto mf = co_await r()) {
+                if (mf->is_partition_start()) {
+                    ++stats.partitions;
+                    partition_rows = 0;
+                } else if (mf->is_clustering_row()) {
+                    ++stats.rows;
+                    if (row_limit && ++partition_rows == row_limit) {
+                        co_await r.next_partition();
+                    }
+                }
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await r.close();
+        if (ex) {
+            std::rethrow_exception(std::move(ex));
+        }
+        co_return stats;
+    }
+
+    template <typename Func>
+    phase_result run_phase(Func func) {
+        if (_cfg.drop_caches) {
+            drop_caches();
+        }
+        phase_result res;
+        auto io_before = engine().get_io_stats();
+        auto start = clk::now();
+        func(res);
+        res.duration = clk::now() - start;
+        auto io_after = engine().get_io_stats();
+        res.aio_reads = io_after.aio_reads - io_before.aio_reads;
+        res.aio_read_bytes = io_after.aio_read_bytes - io_before.aio_read_bytes;
+        return res;
+    }
+
+    future<> partition_reads_worker(phase_result& res, size_t& next, unsigned row_limit) {
+        while (next < _keys.size()) {
+            auto& key = _keys[next++];
+            auto range = dht::partition_range::make_singular(key);
+            auto start = clk::now();
+            auto stats = co_await consume(make_partition_reader(key, range), row_limit);
+            res.latencies.record(clk::now() - start);
+            ++res.reads;
+            res.partitions += stats.partitions;
+            res.rows += stats.rows;
+        }
+    }
+
+    phase_result partition_reads(unsigned row_limit) {
+        return run_phase([&] (phase_result& res) {
+            size_t next = 0;
+            parallel_for_each(std::views::iota(0u, _cfg.parallelism), [&] (unsigned) {
+                return partition_reads_worker(res, next, row_limit);
+            }).get();
+        });
+    }
+
+    phase_result full_scan() {
+        return run_phase([&] (phase_result& res) {
+            auto start = clk::now();
+            auto stats = consume(_set->make_range_sstable_reader(_s, _env.make_reader_permit(), query::full_partition_range,
+                    _s->full_slice(), {}, streamed_mutation::forwarding::no, mutation_reader::forwarding::no), 0).get();
+            res.latencies.record(clk::now() - start);
+            res.reads = 1;
+            res.partitions = stats.partitions;
+            res.rows = stats.rows;
+        });
+    }
+
+    static void print(std::string_view name, const phase_result& r) {
+        auto to_ms = [] (std::chrono::nanoseconds d) { return std::chrono::duration<double, std::milli>(d).count(); };
+        auto reads = std::max<uint64_t>(r.reads, 1);
+        std::cout << format("{}: {} reads in {:.2f}s ({:.0f} reads/s), {} partitions, {} rows\n",
+                name, r.reads, r.duration.count(), r.reads / r.duration.count(), r.partitions, r.rows);
+        std::cout << format("  latency [ms]: p50 {:.3f} p99 {:.3f} p999 {:.3f} max {:.3f}\n",
+                to_ms(r.latencies.percentile(0.5)), to_ms(r.latencies.percentile(0.99)), to_ms(r.latencies.percentile(0.999)), to_ms(r.latencies.max()));
+        std::cout << format("  I/O: {} reads, {} bytes ({:.1f} reads, {:.1f} KiB per read)\n",
+                r.aio_reads, r.aio_read_bytes, double(r.aio_reads) / reads, double(r.aio_read_bytes) / reads / 1024);
+    }
+
+public:
+    existing_sstables_test(test_env& env, conf cfg) : _env(env), _cfg(std::move(cfg)) {}
+
+    void run() {
+        _s = load_schema();
+        load_sstables();
+        sample_keys();
+        std::cout << format("Loaded {} sstables of {}.{} from {}, {} caches between phases\n", _sst.size(), _s->ks_name(), _s->cf_name(),
+                _cfg.dir, _cfg.drop_caches ? "dropping" : "keeping");
+        print("single_partition", partition_reads(0));
+        print("slice", partition_reads(_cfg.slice_rows));
+        print("full_scan", full_scan());
+        _set = {};
+        _sst.clear();
+    }
+};
+
 enum class test_modes {
     sequential_read,
     index_read,
@@ -69,6 +305,7 @@ enum class test_modes {
     compaction,
     full_scan_streaming,
     partitioned_streaming,
+    existing_read,
 };
 
 static const std::unordered_map<sstring, test_modes> test_mode = {
@@ -79,6 +316,7 @@ static const std::unordered_map<sstring, test_modes> test_mode = {
     {"compaction", test_modes::compaction },
     {"full_scan_streaming", test_modes::full_scan_streaming },
     {"parititioned_streaming", test_modes::partitioned_streaming },
+    {"existing_read", test_modes::existing_read },
 };
 
 std::istream& operator>>(std::istream& is, test_modes& mode) {
@@ -115,13 +353,39 @@ int scylla_sstable_main(int argc, char** argv) {
         ("num_columns", bpo::value<unsigned>()->default_value(5), "number of columns per row")
         ("column_size", bpo::value<unsigned>()->default_value(64), "size in bytes for each column")
         ("sstables", bpo::value<unsigned>()->default_value(1), "number of sstables (valid only for compaction mode)")
-        ("mode", bpo::value<test_modes>()->default_value(test_modes::index_write), "one of: sequential_read, index_read, write, compaction, index_write, full_scan_streaming, partitioned_streaming")
+        ("mode", bpo::value<test_modes>()->default_value(test_modes::index_write), "one of: sequential_read, index_read, write, compaction, index_write, full_scan_streaming, partitioned_streaming, existing_read")
         ("testdir", bpo::value<sstring>()->default_value("/var/lib/scylla/perf-tests"), "directory in which to store the sstables")
         ("compaction-strategy", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy to use, one of "
              "(SizeTieredCompactionStrategy, LeveledCompactionStrategy, DateTieredCompactionStrategy, TimeWindowCompactionStrategy)")
-        ("timestamp-range", bpo::value<api::timestamp_type>()->default_value(0), "Timestamp values to use, chosen uniformly from: [-x, +x]");
+        ("timestamp-range", bpo::value<api::timestamp_type>()->default_value(0), "Timestamp values to use, chosen uniformly from: [-x, +x]")
+        ("sstables-dir", bpo::value<sstring>(), "directory of the existing sstables to read (existing_read mode)")
+        ("schema-file", bpo::value<sstring>()->default_value(""), "file with the CQL schema of the sstables in --sstables-dir, "
+             "loaded from the sstables if not given (existing_read mode)")
+        ("reads", bpo::value<unsigned>()->default_value(1000), "number of single partition and slice reads (existing_read mode)")
+        ("slice-rows", bpo::value<unsigned>()->default_value(100), "number of rows read by the slice reads (existing_read mode)")
+        ("keep-caches", "don't drop the caches between the phases (existing_read mode)");
 
     return app.run_deprecated(argc, argv, [&app] {
+        if (app.configuration()["mode"].as<test_modes>() == test_modes::existing_read) {
+            if (!app.configuration().contains("sstables-dir")) {
+                std::cerr << "--sstables-dir is required by the existing_read mode" << std::endl;
+                return engine().exit(1);
+            }
+            auto cfg = existing_sstables_test::conf{
+                .dir = app.configuration()["sstables-dir"].as<sstring>(),
+                .schema_file = app.configuration()["schema-file"].as<sstring>(),
+                .reads = app.configuration()["reads"].as<unsigned>(),
+                .slice_rows = app.configuration()["slice-rows"].as<unsigned>(),
+                .parallelism = std::max(app.configuration()["parallelism"].as<unsigned>(), 1u),
+                .drop_caches = !app.configuration().contains("keep-caches"),
+            };
+            return test_env::do_with_async([cfg = std::move(cfg)] (test_env& env) {
+                existing_sstables_test(env, cfg).run();
+            }).then([] {
+                return engine().exit(0);
+            }).or_terminate();
+        }
+
         auto test = make_lw_shared<distributed<perf_sstable_test_env>>();
 
         auto cfg = perf_sstable_test_env::conf();
@@ -170,7 +434,10 @@ int scylla_sstable_main(int argc, char** argv) {
                 [[fallthrough]];
             case compaction:
                 return test_setup::create_empty_test_dir(dir);
+            case existing_read:
+                break;
             }
+            std::abort();
         }).then([test, mode] {
             switch (mode) {
             using enum test_modes;
@@ -188,7 +455,10 @@ int scylla_sstable_main(int argc, char** argv) {
                 return test_write(*test).then([test] {});
             case compaction:
                 return test_compaction(*test).then([test] {});
+            case existing_read:
+                break;
             }
+            std::abort();
         }).then([] {
             return engine().exit(0);
         }).or_terminate();
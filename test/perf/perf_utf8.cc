@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "test/lib/make_random_string.hh"
+#include "utils/ascii.hh"
+#include "utils/utf8.hh"
+
+#include <seastar/testing/perf_tests.hh>
+
+struct text_validation {
+    static constexpr size_t size = 64 * 1024;
+    const sstring ascii = make_random_string(size);
+    // Latin text with an occasional 2, 3 and 4 byte code point,
+    // the interesting case for the range checks.
+    const sstring mixed = [] {
+        static constexpr std::string_view words[] = {"lorem ", "ipsum ", "dolor ", "caf\xc3\xa9 ", "\xe2\x82\xac" "5 ", "\xf0\x9f\x98\x80 "};
+        sstring s;
+        for (size_t i = 0; s.size() < size; ++i) {
+            s += sstring(words[i * 7 % std::size(words)]);
+        }
+        return s;
+    }();
+
+    static const uint8_t* data(const sstring& s) {
+        return reinterpret_cast<const uint8_t*>(s.data());
+    }
+};
+
+PERF_TEST_F(text_validation, ascii_validate) {
+    perf_tests::do_not_optimize(utils::ascii::validate(data(ascii), ascii.size()));
+}
+
+PERF_TEST_F(text_validation, ascii_validate_scalar) {
+    perf_tests::do_not_optimize(utils::ascii::internal::validate_scalar(data(ascii), ascii.size()));
+}
+
+PERF_TEST_F(text_validation, utf8_validate_ascii) {
+    perf_tests::do_not_optimize(utils::utf8::validate(data(ascii), ascii.size()));
+}
+
+PERF_TEST_F(text_validation, utf8_validate_ascii_scalar) {
+    perf_tests::do_not_optimize(utils::utf8::internal::validate_partial_scalar(data(ascii), ascii.size()));
+}
+
+PERF_TEST_F(text_validation, utf8_validate_mixed) {
+    perf_tests::do_not_optimize(utils::utf8::validate(data(mixed), mixed.size()));
+}
+
+PERF_TEST_F(text_validation, utf8_validate_mixed_scalar) {
+    perf_tests::do_not_optimize(utils::utf8::internal::validate_partial_scalar(data(mixed), mixed.size()));
+}
@@ -37,7 +37,7 @@ class vint {
     }
 
     const std::vector<uint64_t>& integers() const { return _integers; }
-    bytes_view serialized() const { return bytes_view(_serialized.data()); }
+    bytes_view serialized() const { return bytes_view(_serialized.data(), _serialized.size()); }
 };
 
 PERF_TEST_F(vint, serialize) {
@@ -59,3 +59,49 @@ PERF_TEST_F(vint, deserialize) {
     }
     return count;
 }
+
+PERF_TEST_F(vint, deserialize_n) {
+    std::array<uint64_t, count> output;
+    perf_tests::do_not_optimize(unsigned_vint::deserialize_n(serialized(), output.data(), count));
+    perf_tests::do_not_optimize(output);
+    return count;
+}
+
+// Cell headers are mostly made of small vints (timestamp deltas, TTLs, lengths),
+// which deserialize_n() decodes in runs.
+class small_vint {
+public:
+    static constexpr size_t count = 1000;
+private:
+    bytes _serialized;
+public:
+    small_vint()
+        : _serialized(bytes::initialized_later{}, count * max_vint_length)
+    {
+        auto eng = seastar::testing::local_random_engine;
+        auto dist = std::uniform_int_distribution<uint64_t>{0, 127};
+        auto dst = _serialized.data();
+        for (size_t i = 0; i < count; ++i) {
+            dst += unsigned_vint::serialize(dist(eng), dst);
+        }
+    }
+
+    bytes_view serialized() const { return bytes_view(_serialized.data(), _serialized.size()); }
+};
+
+PERF_TEST_F(small_vint, deserialize) {
+    auto src = serialized();
+    for (auto i = 0u; i < count; i++) {
+        auto len = unsigned_vint::serialized_size_from_first_byte(src.front());
+        perf_tests::do_not_optimize(unsigned_vint::deserialize(src));
+        src.remove_prefix(len);
+    }
+    return count;
+}
+
+PERF_TEST_F(small_vint, deserialize_n) {
+    std::array<uint64_t, count> output;
+    perf_tests::do_not_optimize(unsigned_vint::deserialize_n(serialized(), output.data(), count));
+    perf_tests::do_not_optimize(output);
+    return count;
+}
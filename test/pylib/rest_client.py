@@ -311,7 +311,7 @@ class ScyllaRESTAPIClient():
         """Flush all keyspaces"""
         await self.client.post(f"/storage_service/flush", host=node_ip)
 
-    async def backup(self, node_ip: str, ks: str, table: str, tag: str, dest: str, bucket: str, prefix: str) -> str:
+    async def backup(self, node_ip: str, ks: str, table: str, tag: str, dest: str, bucket: str, prefix: str, base_prefix: Optional[str] = None) -> str:
         """Backup keyspace's snapshot"""
         params = {"keyspace": ks,
                   "table": table,
@@ -319,6 +319,8 @@ class ScyllaRESTAPIClient():
                   "bucket": bucket,
                   "prefix": prefix,
                   "snapshot": tag}
+        if base_prefix is not None:
+            params["base_prefix"] = base_prefix
         return await self.client.post_json(f"/storage_service/backup", host=node_ip, params=params)
 
     async def restore(self, node_ip: str, ks: str, cf: str, dest: str, bucket: str, prefix: str, sstables: list[str]) -> str:
@@ -8,6 +8,7 @@
 
 #include <seastar/testing/test_case.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/when_all.hh>
 
 #include "utils/UUID_gen.hh"
 
@@ -15,6 +16,7 @@
 
 #include "test/lib/cql_test_env.hh"
 #include "cql3/query_processor.hh"
+#include "db/config.hh"
 
 #include "gms/inet_address_serializer.hh"
 
@@ -136,6 +138,31 @@ SEASTAR_TEST_CASE(test_store_load_log_entries) {
     });
 }
 
+SEASTAR_TEST_CASE(test_group_commit_log_entries) {
+    cql_test_config cfg;
+    cfg.db_config->raft_log_group_commit_window_in_us.set(1000);
+    return do_with_cql_env([] (cql_test_env& env) -> future<> {
+        cql3::query_processor& qp = env.local_qp();
+        raft::group_id other_gid{utils::UUID_gen::get_time_UUID()};
+        raft_sys_table_storage storage(qp, gid, raft::server_id::create_random_id());
+        raft_sys_table_storage other_storage(qp, other_gid, raft::server_id::create_random_id());
+
+        // Appends of both groups are queued together and stored in a single batch.
+        std::vector<raft::log_entry_ptr> entries = create_test_log();
+        std::vector<raft::log_entry_ptr> other_entries = create_test_log();
+        other_entries.pop_back();
+        co_await when_all_succeed(storage.store_log_entries(entries), other_storage.store_log_entries(other_entries)).discard_result();
+
+        for (auto& [s, expected] : {std::pair(&storage, &entries), std::pair(&other_storage, &other_entries)}) {
+            raft::log_entries loaded_entries = co_await s->load_log();
+            BOOST_REQUIRE_EQUAL(expected->size(), loaded_entries.size());
+            for (size_t i = 0, end = expected->size(); i != end; ++i) {
+                BOOST_CHECK(*(*expected)[i] == *loaded_entries[i]);
+            }
+        }
+    }, std::move(cfg));
+}
+
 SEASTAR_TEST_CASE(test_truncate_log) {
     return do_with_cql_env([] (cql_test_env& env) -> future<> {
         cql3::query_processor& qp = env.local_qp();
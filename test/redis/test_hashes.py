@@ -36,7 +36,6 @@ def test_hset_hget_delete(redis_host, redis_port):
     assert r.delete(key) == 1
     assert r.hget(key, field) == None 
 
-@pytest.mark.xfail(reason="HSET command does not support multiple key/field")
 def test_hset_multiple_key_field(redis_host, redis_port):
     # This test requires the library to support multiple mappings in one
     # command, or we cannot test this feature. This was added to redis-py
@@ -52,7 +51,6 @@ def test_hset_multiple_key_field(redis_host, redis_port):
 
     assert r.hset(key, None, None, {field: val, field2: val2}) == 2
 
-@pytest.mark.xfail(reason="HSET command does not support return of changes, it always return 1")
 def test_hset_return_changes(redis_host, redis_port):
     r = connect(redis_host, redis_port)
     key = random_string(10)
@@ -97,7 +95,6 @@ def test_hset_hdel_hgetall(redis_host, redis_port):
         r.execute_command("HGETALL testkey testfield")
     assert "wrong number of arguments for 'hgetall' command" in str(excinfo.value)
 
-@pytest.mark.xfail(reason="HDEL command does not support return of changes, it always return 1")
 def test_hdel_return_changes(redis_host, redis_port):
     r = connect(redis_host, redis_port)
     key = random_string(10)
@@ -151,3 +148,18 @@ def test_hexists(redis_host, redis_port):
     assert r.hexists(key, field) == 0
     assert r.hset(key, field, random_string(10)) == 1
     assert r.hexists(key, field) == 1
+
+def test_hmget(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    field = random_string(10)
+    val = random_string(10)
+    other_field = random_string(10)
+
+    assert r.hmget(key, field, other_field) == [None, None]
+    assert r.hset(key, field, val) == 1
+    assert r.hmget(key, other_field, field, field) == [None, val, val]
+
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command("HMGET testkey")
+    assert "wrong number of arguments for 'hmget' command" in str(excinfo.value)
@@ -0,0 +1,86 @@
+#
+# Copyright (C) 2024-present ScyllaDB
+#
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_zadd_zscore(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.zscore(key, "a") == None
+    assert r.zadd(key, {"a": 1, "b": 2.5}) == 2
+    assert r.zscore(key, "a") == 1
+    assert r.zscore(key, "b") == 2.5
+    assert r.zcard(key) == 2
+
+    # Updating the score of a member doesn't add it.
+    assert r.zadd(key, {"a": 3, "c": -1}) == 1
+    assert r.zscore(key, "a") == 3
+    assert r.zcard(key) == 3
+    assert r.zrange(key, 0, -1, withscores=True) == [("c", -1), ("b", 2.5), ("a", 3)]
+
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command(f"ZADD {key} notafloat a")
+    assert "value is not a valid float" in str(excinfo.value)
+
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command(f"ZADD {key} 1")
+    assert "wrong number of arguments for 'zadd' command" in str(excinfo.value)
+
+def test_zrem(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.zadd(key, {"a": 1, "b": 2, "c": 3}) == 3
+    assert r.zrem(key, "a", "c", "d") == 2
+    assert r.zrem(key, "a") == 0
+    assert r.zrange(key, 0, -1) == ["b"]
+    assert r.zscore(key, "a") == None
+
+def test_zrange(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.zrange(key, 0, -1) == []
+    # Members with the same score are ordered by name.
+    assert r.zadd(key, {"a": 1, "c": 2, "b": 2, "d": 4}) == 4
+    assert r.zrange(key, 0, -1) == ["a", "b", "c", "d"]
+    assert r.zrange(key, 1, 2) == ["b", "c"]
+    assert r.zrange(key, -2, -1) == ["c", "d"]
+    assert r.zrange(key, 2, 100) == ["c", "d"]
+    assert r.zrange(key, 3, 1) == []
+    assert r.zrange(key, 0, 0, withscores=True) == [("a", 1)]
+
+def test_zrangebyscore_zcount(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.zadd(key, {"a": 1, "b": 2, "c": 2, "d": 3, "e": float("inf")}) == 5
+    assert r.zrangebyscore(key, 2, 3) == ["b", "c", "d"]
+    assert r.zrangebyscore(key, "(2", 3) == ["d"]
+    assert r.zrangebyscore(key, 1, "(2") == ["a"]
+    assert r.zrangebyscore(key, "-inf", "+inf") == ["a", "b", "c", "d", "e"]
+    assert r.zrangebyscore(key, "(3", "+inf", withscores=True) == [("e", float("inf"))]
+    assert r.zrangebyscore(key, 3, 2) == []
+    assert r.zrangebyscore(key, "-inf", "+inf", start=1, num=2) == ["b", "c"]
+    assert r.zrangebyscore(key, "-inf", "+inf", start=3, num=-1) == ["d", "e"]
+    assert r.zcount(key, 2, 3) == 3
+    assert r.zcount(key, "(1", "(3") == 2
+
+def test_delete_zset(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    assert r.zadd(key, {"a": 1}) == 1
+    assert r.delete(key) == 1
+    assert r.zcard(key) == 0
+    assert r.zrange(key, 0, -1) == []
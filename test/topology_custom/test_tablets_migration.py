@@ -289,3 +289,41 @@ async def test_tablet_back_and_forth_migration(manager: ManagerClient):
     await assert_rows(2)
     await cql.run_async(f"INSERT INTO test.test (pk, c) VALUES ({3}, {3});")
     await assert_rows(3)
+
+
+@pytest.mark.parametrize("enable_file_stream", [True, False])
+@pytest.mark.asyncio
+async def test_tablet_migration_file_stream(manager: ManagerClient, enable_file_stream):
+    logger.info("Bootstrapping cluster")
+    cfg = {'enable_user_defined_functions': False, 'enable_tablets': True, 'enable_file_stream': enable_file_stream}
+    servers = [await manager.server_add(config=cfg), await manager.server_add(config=cfg)]
+    host_ids = [await manager.get_host_id(s.server_id) for s in servers]
+    for s in servers:
+        await manager.api.disable_tablet_balancing(s.ip_addr)
+
+    cql = manager.get_cql()
+    await cql.run_async("CREATE KEYSPACE test WITH replication = {'class': 'NetworkTopologyStrategy', 'replication_factor': 1} AND tablets = {'initial': 1}")
+    await cql.run_async("CREATE TABLE test.test (pk int PRIMARY KEY, c int);")
+    keys = range(256)
+    await asyncio.gather(*[cql.run_async(f"INSERT INTO test.test (pk, c) VALUES ({k}, {k});") for k in keys])
+    for s in servers:
+        await manager.api.keyspace_flush(s.ip_addr, "test", "test")
+    # Left in the memtable, it's flushed by the leaving replica when streaming.
+    await cql.run_async(f"INSERT INTO test.test (pk, c) VALUES ({len(keys)}, {len(keys)});")
+
+    replicas = await get_all_tablet_replicas(manager, servers[0], 'test', 'test')
+    assert len(replicas) == 1 and len(replicas[0].replicas) == 1
+    old_replica = replicas[0].replicas[0]
+    dst = 1 if old_replica[0] == host_ids[0] else 0
+    new_replica = (host_ids[dst], 0)
+
+    log = await manager.server_open_log(servers[dst].server_id)
+    mark = await log.mark()
+    logger.info(f"Moving tablet {old_replica} -> {new_replica}")
+    await manager.api.move_tablet(servers[0].ip_addr, "test", "test", old_replica[0], old_replica[1], new_replica[0], new_replica[1], 0)
+
+    streamed_as_files = await log.grep("Finished streaming sstables of tablet .* as files", from_mark=mark)
+    assert bool(streamed_as_files) == enable_file_stream
+
+    rows = await cql.run_async("SELECT * FROM test.test")
+    assert sorted(r.pk for r in rows) == list(range(len(keys) + 1))
@@ -20,7 +20,48 @@
 
 extern logging::logger dblog;
 
-seastar::lw_shared_ptr<repair_history_map> tombstone_gc_state::get_or_create_repair_history_for_table(const table_id& id) {
+void repair_history::update(const dht::token_range& range, gc_clock::time_point repair_time) {
+    _map += std::make_pair(locator::token_metadata::range_to_interval(range), repair_time);
+    _flat_valid = false;
+}
+
+void repair_history::rebuild_flat() const {
+    _flat.clear();
+    _flat.reserve(_map.iterative_size());
+    for (const auto& [interval, repair_time] : _map) {
+        auto r = locator::token_metadata::interval_to_range(interval);
+        _flat.push_back(entry{
+            .start = r.start() ? r.start()->value() : dht::minimum_token(),
+            .end = r.end() ? r.end()->value() : dht::maximum_token(),
+            .start_inclusive = !r.start() || r.start()->is_inclusive(),
+            .end_inclusive = !r.end() || r.end()->is_inclusive(),
+            .repair_time = repair_time,
+        });
+    }
+    _flat_valid = true;
+}
+
+std::optional<gc_clock::time_point> repair_history::find(const dht::token& t) const {
+    if (!_flat_valid) {
+        rebuild_flat();
+    }
+    // The intervals are disjoint and sorted, so the first one which doesn't end
+    // before t is the only one which may contain it.
+    auto it = std::partition_point(_flat.begin(), _flat.end(), [&t] (const entry& e) {
+        auto c = e.end <=> t;
+        return c < 0 || (c == 0 && !e.end_inclusive);
+    });
+    if (it == _flat.end()) {
+        return std::nullopt;
+    }
+    auto c = it->start <=> t;
+    if (c < 0 || (c == 0 && it->start_inclusive)) {
+        return it->repair_time;
+    }
+    return std::nullopt;
+}
+
+seastar::lw_shared_ptr<repair_history> tombstone_gc_state::get_or_create_repair_history_for_table(const table_id& id) {
     if (!_reconcile_history_maps) {
         return {};
     }
@@ -29,11 +70,11 @@ seastar::lw_shared_ptr<repair_history_map> tombstone_gc_state::get_or_create_rep
     if (it != reconcile_history_maps.end()) {
         return it->second;
     }
-    reconcile_history_maps[id] = seastar::make_lw_shared<repair_history_map>();
+    reconcile_history_maps[id] = seastar::make_lw_shared<repair_history>();
     return reconcile_history_maps[id];
 }
 
-seastar::lw_shared_ptr<repair_history_map> tombstone_gc_state::get_repair_history_for_table(const table_id& id) const {
+seastar::lw_shared_ptr<repair_history> tombstone_gc_state::get_repair_history_for_table(const table_id& id) const {
     if (!_reconcile_history_maps) {
         return {};
     }
@@ -126,7 +167,7 @@ tombstone_gc_state::get_gc_before_for_range_result tombstone_gc_state::get_gc_be
             auto min = gc_clock::time_point::max();
             auto max = gc_clock::time_point::min();
             bool contains_all = false;
-            for (auto& x : boost::make_iterator_range(m->equal_range(interval))) {
+            for (auto& x : boost::make_iterator_range(m->map().equal_range(interval))) {
                 auto r = locator::token_metadata::interval_to_range(x.first);
                 min = std::min(x.second, min);
                 max = std::max(x.second, max);
@@ -192,11 +233,8 @@ gc_clock::time_point tombstone_gc_state::get_gc_before_for_key(schema_ptr s, con
         auto repair_timestamp = gc_clock::time_point::min();
         auto m = get_repair_history_for_table(s->id());
         if (m) {
-            const auto it = m->find(dk.token());
-            if (it == m->end()) {
-                gc_before = gc_clock::time_point::min();
-            } else {
-                repair_timestamp = it->second;
+            if (auto t = m->find(dk.token())) {
+                repair_timestamp = *t;
                 gc_before = saturating_subtract(repair_timestamp, propagation_delay);
             }
         }
@@ -213,7 +251,7 @@ void tombstone_gc_state::update_repair_time(table_id id, const dht::token_range&
     if (!m) {
         on_fatal_internal_error(dblog, "repair_history_map not found/created");
     }
-    *m += std::make_pair(locator::token_metadata::range_to_interval(range), repair_time);
+    m->update(range, repair_time);
 }
 
 void tombstone_gc_state::update_group0_refresh_time(gc_clock::time_point refresh_time) {
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
 #include <boost/icl/interval_map.hpp>
 
 #include <seastar/core/shared_ptr.hh>
@@ -37,9 +39,40 @@ class database;
 // the "repair" tombstone GC mode).
 using repair_history_map = boost::icl::interval_map<dht::token, gc_clock::time_point, boost::icl::partial_absorber, std::less, boost::icl::inplace_max>;
 
+// The repair history of a table.
+//
+// Single tokens are looked up for every partition compacted or read, so on top
+// of the interval map, the history keeps a flat, sorted copy of its intervals,
+// which is binary searched instead of walking the map's tree. The copy is
+// rebuilt on the first lookup after an update.
+class repair_history {
+    struct entry {
+        dht::token start;
+        dht::token end;
+        bool start_inclusive;
+        bool end_inclusive;
+        gc_clock::time_point repair_time;
+    };
+
+    repair_history_map _map;
+    mutable std::vector<entry> _flat;
+    mutable bool _flat_valid = true;
+
+    void rebuild_flat() const;
+public:
+    const repair_history_map& map() const noexcept {
+        return _map;
+    }
+
+    void update(const dht::token_range& range, gc_clock::time_point repair_time);
+
+    // Returns the repair time of the token, if it's in a repaired range.
+    std::optional<gc_clock::time_point> find(const dht::token& t) const;
+};
+
 class per_table_history_maps {
 public:
-    std::unordered_map<table_id, seastar::lw_shared_ptr<repair_history_map>> _repair_maps;
+    std::unordered_map<table_id, seastar::lw_shared_ptr<repair_history>> _repair_maps;
 
     // Separating the group0 GC time - it is not kept per table, but for the whole group0:
     // - the state_id of the last mutation applies to all group0 tables wrt. the tombstone GC
@@ -56,8 +89,8 @@ class tombstone_gc_state {
     per_table_history_maps* _reconcile_history_maps;
     [[nodiscard]] gc_clock::time_point check_min(schema_ptr, gc_clock::time_point) const;
 
-    [[nodiscard]] seastar::lw_shared_ptr<repair_history_map> get_repair_history_for_table(const table_id& id) const;
-    [[nodiscard]] seastar::lw_shared_ptr<repair_history_map> get_or_create_repair_history_for_table(const table_id& id);
+    [[nodiscard]] seastar::lw_shared_ptr<repair_history> get_repair_history_for_table(const table_id& id) const;
+    [[nodiscard]] seastar::lw_shared_ptr<repair_history> get_or_create_repair_history_for_table(const table_id& id);
 
     [[nodiscard]] seastar::lw_shared_ptr<gc_clock::time_point> get_group0_gc_time() const;
     [[nodiscard]] seastar::lw_shared_ptr<gc_clock::time_point> get_or_create_group0_gc_time();
@@ -11,6 +11,7 @@
 #include <chrono>
 #include <concepts>
 #include <cstdlib>
+#include <fstream>
 #include <future>
 #include <limits>
 #include <iterator>
@@ -1342,6 +1343,70 @@ void help_operation(const tool_app_template::config& cfg, const bpo::variables_m
     }
 }
 
+void reactorprofile_operation(scylla_rest_client& client, const bpo::variables_map& vm) {
+    const auto duration = vm["duration"].as<int>();
+    const auto sample_period = vm["sample-period"].as<int>();
+    if (duration <= 0) {
+        throw std::invalid_argument("duration must be positive");
+    }
+    if (sample_period < 0) {
+        throw std::invalid_argument("sample period must not be negative");
+    }
+    auto res = client.get("/system/reactor_profile", {
+        {"duration", fmt::to_string(duration)},
+        {"sample_period", fmt::to_string(sample_period)},
+    });
+    const auto& profile = res.GetObject();
+
+    struct group {
+        std::string_view name;
+        uint64_t runtime_ms;
+        uint64_t tasks_processed;
+        uint64_t task_quota_violations_ms;
+        uint64_t waittime_ms;
+        uint64_t starvetime_ms;
+    };
+    std::vector<group> groups;
+    uint64_t total_runtime_ms = 0;
+    for (const auto& g : profile["scheduling_groups"].GetArray()) {
+        groups.push_back(group{
+            .name = rjson::to_string_view(g["name"]),
+            .runtime_ms = g["runtime_ms"].GetUint64(),
+            .tasks_processed = g["tasks_processed"].GetUint64(),
+            .task_quota_violations_ms = g["task_quota_violations_ms"].GetUint64(),
+            .waittime_ms = g["waittime_ms"].GetUint64(),
+            .starvetime_ms = g["starvetime_ms"].GetUint64(),
+        });
+        total_runtime_ms += groups.back().runtime_ms;
+    }
+    std::ranges::sort(groups, std::greater<>(), &group::runtime_ms);
+
+    fmt::print("Profiled {} shards for {} ms\n\n", profile["shards"].GetUint64(), profile["duration_ms"].GetUint64());
+    Tabulate table;
+    table.add("Scheduling group", "Runtime (ms)", "Share", "Tasks", "Quota violations (ms)", "Wait (ms)", "Starve (ms)");
+    for (const auto& g : groups) {
+        table.add(g.name, g.runtime_ms, format_percent(g.runtime_ms, total_runtime_ms), g.tasks_processed,
+                g.task_quota_violations_ms, g.waittime_ms, g.starvetime_ms);
+    }
+    table.print();
+
+    if (!sample_period) {
+        return;
+    }
+    fmt::print("\nSamples: {} ({} dropped)\n", profile["samples"].GetUint64(), profile["dropped_samples"].GetUint64());
+    if (vm.contains("flamegraph-file")) {
+        const auto path = vm["flamegraph-file"].as<sstring>();
+        std::ofstream out(path);
+        for (const auto& s : profile["stacks"].GetArray()) {
+            fmt::print(out, "{} {}\n", rjson::to_string_view(s["stack"]), s["count"].GetUint64());
+        }
+        if (!out) {
+            throw std::runtime_error(fmt::format("failed to write the folded stacks to {}", path));
+        }
+        fmt::print("Folded stacks written to {}\n", path);
+    }
+}
+
 void rebuild_operation(scylla_rest_client& client, const bpo::variables_map& vm) {
     std::unordered_map<sstring, sstring> params;
     if (vm.contains("source-dc")) {
@@ -3771,6 +3836,36 @@ For more information, see: {}"
                 proxyhistograms_operation
             }
         },
+        {
+            {
+                "reactorprofile",
+                "Profile the reactors, showing the time spent by each scheduling group",
+fmt::format(R"(
+Profiles the reactors of all shards of the node for the given duration and
+prints the time spent by each scheduling group (statement, compaction,
+streaming, memtable flush, gossip, ...) during it: the time its tasks ran, the
+number of tasks, the time its tasks ran beyond the task quota (which delays the
+tasks of the other groups and shows up as reactor stalls), the time it was
+ready to run but other groups ran, and the time its shares held it back.
+
+The reactors also sample backtraces during the profiling, at the given average
+period. The sampled backtraces can be written, in the folded format of
+flamegraph.pl, to a file with --flamegraph-file. The addresses can be resolved
+with seastar-addr2line, like those of stall reports.
+
+For more information, see: {}"
+)", doc_link("operating-scylla/nodetool-commands/reactorprofile.html")),
+                {
+                    typed_option<int>("duration,d", 10000, "Duration of the profiling, in milliseconds"),
+                    typed_option<int>("sample-period", 1000, "Average period of the backtrace sampling, in microseconds, 0 disables the sampling"),
+                    typed_option<sstring>("flamegraph-file,f", "Write the sampled backtraces, in folded format, to this file"),
+                },
+                { },
+            },
+            {
+                reactorprofile_operation
+            }
+        },
         {
             {
                 "rebuild",
@@ -10,29 +10,39 @@
 #include <boost/algorithm/string/join.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <filesystem>
+#include <fstream>
+#include <random>
 #include <set>
+#include <variant>
 #include <fmt/chrono.h>
 #include <fmt/ostream.h>
 #include <fmt/ranges.h>
+#include <seastar/core/bitops.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/queue.hh>
 #include <seastar/util/closeable.hh>
 #include <seastar/core/queue.hh>
 
 #include "compaction/compaction.hh"
+#include "compaction/compaction_garbage_collector.hh"
 #include "compaction/compaction_strategy.hh"
 #include "compaction/compaction_strategy_state.hh"
+#include "counters.hh"
 #include "db/config.hh"
 #include "db/large_data_handler.hh"
 #include "gms/feature_service.hh"
+#include "partition_slice_builder.hh"
 #include "reader_concurrency_semaphore.hh"
 #include "readers/combined.hh"
+#include "readers/compacting.hh"
 #include "readers/generating_v2.hh"
+#include "readers/multi_range.hh"
 #include "schema/schema_builder.hh"
 #include "sstables/index_reader.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/sstable_directory.hh"
 #include "sstables/open_info.hh"
+#include "sstables/segmented_compress_params.hh"
 #include "tools/json_writer.hh"
 #include "tools/load_system_tablets.hh"
 #include "tools/lua_sstable_consumer.hh"
@@ -204,7 +214,7 @@ struct schema_with_source {
     sstring obtained_from;
 };
 
-std::optional<schema_with_source> try_load_schema_from_user_provided_source(const bpo::variables_map& app_config, db::config& cfg) {
+std::optional<schema_with_source> try_load_schema_from_user_provided_source(const bpo::variables_map& app_config, const db::config& cfg) {
     sstring schema_source_opt;
     try {
         if (!app_config["schema-file"].defaulted()) {
@@ -248,7 +258,7 @@ std::optional<schema_with_source> try_load_schema_from_user_provided_source(cons
     return {};
 }
 
-std::optional<schema_with_source> try_load_schema_autodetect(const bpo::variables_map& app_config, db::config& cfg) {
+std::optional<schema_with_source> try_load_schema_autodetect(const bpo::variables_map& app_config, const db::config& cfg) {
     try {
         const auto schema_file_path = std::filesystem::path(app_config["schema-file"].as<sstring>());
         return schema_with_source{.schema = tools::load_one_schema_from_file(cfg, schema_file_path).get(),
@@ -308,6 +318,26 @@ std::optional<schema_with_source> try_load_schema_autodetect(const bpo::variable
     return {};
 }
 
+std::optional<schema_with_source> load_schema(const bpo::variables_map& app_config, const db::config& cfg) {
+    unsigned schema_sources = 0;
+    schema_sources += !app_config["schema-file"].defaulted();
+    schema_sources += app_config.contains("system-schema");
+    schema_sources += app_config.contains("scylla-data-dir");
+    schema_sources += app_config.contains("scylla-yaml-file");
+
+    if (!schema_sources) {
+        sst_log.debug("No user-provided schema source, attempting to auto-detect it");
+        return try_load_schema_autodetect(app_config, cfg);
+    } else if (schema_sources == 1 || (schema_sources == 2 && app_config.contains("scylla-yaml-file"))) {
+        // We make an exception for the case where 2 schema sources are provided, but one of them is scylla-yaml file.
+        // We want to always accept the --scylla-yaml-file option.
+        sst_log.debug("Single schema source provided");
+        return try_load_schema_from_user_provided_source(app_config, cfg);
+    }
+    fmt::print(std::cerr, "Multiple schema sources provided, please provide exactly one of: --schema-file, --system-schema, --scylla-data-dir or --scylla-yaml-file (with the accompanying --keyspace and --table if necessary)\n");
+    return {};
+}
+
 const std::vector<sstables::shared_sstable> load_sstables(schema_ptr schema, sstables::sstables_manager& sst_man, const std::vector<sstring>& sstable_names) {
     std::vector<sstables::shared_sstable> sstables;
     sstables.resize(sstable_names.size());
@@ -347,6 +377,100 @@ const std::vector<sstables::shared_sstable> load_sstables(schema_ptr schema, sst
     return sstables;
 }
 
+// Assigns the sstables to the shards, largest first, each to the shard with
+// the least data so far. Returns the indexes of the sstables of each shard.
+std::vector<std::vector<size_t>> distribute_sstables(const std::vector<sstables::shared_sstable>& sstables) {
+    auto order = std::views::iota(size_t(0), sstables.size()) | std::ranges::to<std::vector>();
+    std::ranges::sort(order, std::greater<>(), [&] (size_t i) { return sstables[i]->data_size(); });
+    std::vector<std::vector<size_t>> assignment(smp::count);
+    std::vector<uint64_t> load(smp::count, 0);
+    for (auto i : order) {
+        auto shard = std::distance(load.begin(), std::ranges::min_element(load));
+        assignment[shard].push_back(i);
+        load[shard] += sstables[i]->data_size();
+    }
+    return assignment;
+}
+
+template <typename Result>
+using shard_sstables_func = std::function<Result(schema_ptr, reader_permit, const std::vector<sstables::shared_sstable>&, sstables::sstables_manager&)>;
+
+// Runs func on each shard with the sstables assigned to it, given as indexes
+// into sstables, returning the results of the shards.
+//
+// The schema, the sstables and the services needed to read them are all
+// shard-local, so the other shards load the schema and their sstables again,
+// with their own sstables manager and reader concurrency semaphore. Shard 0
+// uses the ones of the caller. func is called from all shards concurrently.
+template <typename Result>
+std::vector<Result> run_on_all_shards(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm, const std::vector<std::vector<size_t>>& assignment,
+        shard_sstables_func<Result> func) {
+    std::vector<std::vector<sstring>> sstable_names(smp::count);
+    for (unsigned shard = 0; shard < smp::count; ++shard) {
+        for (auto i : assignment[shard]) {
+            sstable_names[shard].push_back(sstables[i]->get_filename());
+        }
+    }
+
+    std::vector<Result> results(smp::count);
+    parallel_for_each(std::views::iota(0u, smp::count), [&] (unsigned shard) {
+        if (shard == 0) {
+            return async([&] {
+                auto local_sstables = assignment[0] | std::views::transform([&] (size_t i) { return sstables[i]; }) | std::ranges::to<std::vector>();
+                results[0] = func(schema, permit, local_sstables, sst_man);
+            });
+        }
+        return smp::submit_to(shard, [&, shard] {
+            return async([&, shard] {
+                const auto& dbcfg = sst_man.config();
+                auto local_schema = load_schema(vm, dbcfg);
+                if (!local_schema) {
+                    throw std::runtime_error(fmt::format("failed to load the schema on shard {}", shard));
+                }
+                db::nop_large_data_handler local_large_data_handler;
+                gms::feature_service feature_service(gms::feature_config_from_db_config(dbcfg));
+                cache_tracker tracker;
+                sstables::directory_semaphore dir_sem(1);
+                abort_source abort;
+                sstables::sstables_manager local_sst_man("scylla_sstable", local_large_data_handler, dbcfg, feature_service, tracker,
+                    memory::stats().total_memory(), dir_sem,
+                    [host_id = locator::host_id::create_random_id()] { return host_id; }, abort);
+                auto close_sst_man = deferred_close(local_sst_man);
+
+                reader_concurrency_semaphore rcs_sem(reader_concurrency_semaphore::no_limits{}, app_name, reader_concurrency_semaphore::register_metrics::no);
+                auto stop_semaphore = deferred_stop(rcs_sem);
+                const auto local_permit = rcs_sem.make_tracking_only_permit(local_schema->schema, app_name, db::no_timeout, {});
+
+                auto local_sstables = load_sstables(local_schema->schema, local_sst_man, sstable_names[shard]);
+                auto res = func(local_schema->schema, local_permit, local_sstables, local_sst_man);
+                local_sstables.clear();
+                return res;
+            });
+        }).then([&, shard] (Result res) {
+            results[shard] = std::move(res);
+        });
+    }).get();
+    return results;
+}
+
+// Spreads the sstables across all shards and runs func on each shard with
+// its share of them, see above.
+template <typename Result>
+std::vector<Result> run_on_all_shards(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm, shard_sstables_func<Result> func) {
+    return run_on_all_shards<Result>(std::move(schema), std::move(permit), sstables, sst_man, vm, distribute_sstables(sstables), std::move(func));
+}
+
+void run_on_all_shards(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm, shard_sstables_func<void> func) {
+    run_on_all_shards<std::monostate>(schema, std::move(permit), sstables, sst_man, vm,
+            [&func] (schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager& sst_man) {
+        func(std::move(schema), std::move(permit), sstables, sst_man);
+        return std::monostate{};
+    });
+}
+
 class consumer_wrapper {
 public:
     using filter_type = std::function<bool(const dht::decorated_key&)>;
@@ -699,6 +823,15 @@ class writetime_histogram_collecting_consumer : public sstable_consumer {
     }
 
 public:
+    // What a consumer collected on one shard, see merge().
+    struct partial_result {
+        std::map<api::timestamp_type, uint64_t> histogram;
+        uint64_t partitions = 0;
+        uint64_t rows = 0;
+        uint64_t cells = 0;
+        uint64_t timestamps = 0;
+    };
+
     explicit writetime_histogram_collecting_consumer(schema_ptr s, reader_permit, const bpo::variables_map& vm) : _schema(std::move(s)) {
         auto it = vm.find("bucket");
         if (it != vm.end()) {
@@ -718,6 +851,24 @@ class writetime_histogram_collecting_consumer : public sstable_consumer {
             }
         }
     }
+    partial_result release_partial_result() {
+        return partial_result{
+            .histogram = std::exchange(_histogram, {}),
+            .partitions = std::exchange(_partitions, 0),
+            .rows = std::exchange(_rows, 0),
+            .cells = std::exchange(_cells, 0),
+            .timestamps = std::exchange(_timestamps, 0),
+        };
+    }
+    void merge(partial_result res) {
+        for (const auto& [ts, count] : res.histogram) {
+            _histogram[ts] += count;
+        }
+        _partitions += res.partitions;
+        _rows += res.rows;
+        _cells += res.cells;
+        _timestamps += res.timestamps;
+    }
     virtual future<> consume_stream_start() override {
         return make_ready_future<>();
     }
@@ -958,14 +1109,31 @@ void validate_operation(schema_ptr schema, reader_permit permit, const std::vect
         throw std::invalid_argument("no sstables specified on the command line");
     }
 
-    abort_source abort;
+    using validation_results = std::unordered_map<sstring, uint64_t>;
+    auto validate = [] (schema_ptr, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager&) {
+        abort_source abort;
+        validation_results errors;
+        for (const auto& sst : sstables) {
+            errors[sst->get_filename()] = sst->validate(permit, abort, [] (sstring what) { sst_log.info("{}", what); }).get();
+        }
+        return errors;
+    };
+    validation_results errors_by_sstable;
+    if (vm.count("parallel")) {
+        for (auto& res : run_on_all_shards<validation_results>(schema, permit, sstables, sst_man, vm, validate)) {
+            errors_by_sstable.merge(res);
+        }
+    } else {
+        errors_by_sstable = validate(schema, permit, sstables, sst_man);
+    }
+
     // Collect JSON output and print after validation is done, to prevent
     // interleaving with error messages from validation.
     std::stringstream json_output_stream;
     json_writer writer(json_output_stream);
     writer.StartStream();
     for (const auto& sst : sstables) {
-        const auto errors = sst->validate(permit, abort, [] (sstring what) { sst_log.info("{}", what); }).get();
+        const auto errors = errors_by_sstable.at(sst->get_filename());
         writer.Key(sst->get_filename());
         writer.StartObject();
         writer.Key("errors");
@@ -1009,17 +1177,28 @@ void scrub_operation(schema_ptr schema, reader_permit permit, const std::vector<
         validate_output_dir(output_dir, vm.count("unsafe-accept-nonempty-output-dir"));
     }
 
-    scylla_sstable_table_state table_state(schema, permit, sst_man, output_dir);
+    // The generations of the output sstables are unique across the shards.
+    auto scrub = [&] (schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager& sst_man) {
+        if (sstables.empty()) {
+            return;
+        }
+        scylla_sstable_table_state table_state(schema, permit, sst_man, output_dir);
 
-    auto compaction_descriptor = sstables::compaction_descriptor(std::move(sstables));
-    compaction_descriptor.options = sstables::compaction_type_options::make_scrub(scrub_mode, sstables::compaction_type_options::scrub::quarantine_invalid_sstables::no);
-    compaction_descriptor.creator = [&table_state] (shard_id) { return table_state.make_sstable(); };
-    compaction_descriptor.replacer = [] (sstables::compaction_completion_desc) { };
+        auto compaction_descriptor = sstables::compaction_descriptor(sstables);
+        compaction_descriptor.options = sstables::compaction_type_options::make_scrub(scrub_mode, sstables::compaction_type_options::scrub::quarantine_invalid_sstables::no);
+        compaction_descriptor.creator = [&table_state] (shard_id) { return table_state.make_sstable(); };
+        compaction_descriptor.replacer = [] (sstables::compaction_completion_desc) { };
 
-    auto compaction_data = sstables::compaction_data{};
+        auto compaction_data = sstables::compaction_data{};
 
-    compaction_progress_monitor progress_monitor;
-    sstables::compact_sstables(std::move(compaction_descriptor), compaction_data, table_state, progress_monitor).get();
+        compaction_progress_monitor progress_monitor;
+        sstables::compact_sstables(std::move(compaction_descriptor), compaction_data, table_state, progress_monitor).get();
+    };
+    if (vm.count("parallel")) {
+        run_on_all_shards(schema, permit, sstables, sst_man, vm, scrub);
+    } else {
+        scrub(schema, permit, sstables, sst_man);
+    }
 }
 
 void dump_index_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
@@ -1662,6 +1841,225 @@ void decompress_operation(schema_ptr schema, reader_permit permit, const std::ve
     }
 }
 
+struct compression_candidate {
+    std::map<sstring, sstring> options;
+    uint32_t chunk_len;
+    compressor_ptr compressor;
+    // The compressor references its dictionary.
+    bytes dictionary;
+};
+
+// Parses the candidates of estimate-compression: a comma-separated list of
+// compressors, each optionally followed by colon-separated options, e.g.
+// ZstdCompressor:compression_level=3:dictionary_size_in_kb=64, combined with
+// each of the chunk lengths.
+std::vector<compression_candidate> parse_compression_candidates(const sstring& compressors, const sstring& chunk_lengths) {
+    std::vector<sstring> compressor_specs;
+    std::vector<sstring> chunk_length_specs;
+    boost::split(compressor_specs, compressors, boost::is_any_of(","));
+    boost::split(chunk_length_specs, chunk_lengths, boost::is_any_of(","));
+
+    std::vector<compression_candidate> candidates;
+    for (const auto& spec : compressor_specs) {
+        std::vector<sstring> parts;
+        boost::split(parts, spec, boost::is_any_of(":"));
+        std::map<sstring, sstring> options{{compression_parameters::SSTABLE_COMPRESSION, parts.front()}};
+        for (const auto& opt : parts | std::views::drop(1)) {
+            auto eq = opt.find('=');
+            if (eq == sstring::npos) {
+                throw std::invalid_argument(fmt::format("invalid compressor option {} in {}, expected key=value", opt, spec));
+            }
+            options[opt.substr(0, eq)] = opt.substr(eq + 1);
+        }
+        for (const auto& chunk_length : chunk_length_specs) {
+            options[compression_parameters::CHUNK_LENGTH_KB] = chunk_length;
+            compression_parameters params(options);
+            params.validate();
+            candidates.push_back(compression_candidate{
+                .options = options,
+                .chunk_len = uint32_t(params.chunk_length()),
+                .compressor = params.get_compressor(),
+            });
+        }
+    }
+    return candidates;
+}
+
+// Reads n regions of the given size of the uncompressed data, from random
+// positions, picking the sstables in proportion to their data size.
+std::vector<temporary_buffer<char>> sample_data(const std::vector<sstables::shared_sstable>& sstables, reader_permit permit, size_t n, uint64_t region_size) {
+    std::vector<uint64_t> sizes = sstables | std::views::transform([] (const sstables::shared_sstable& sst) { return sst->data_size(); }) | std::ranges::to<std::vector>();
+    std::discrete_distribution<size_t> pick_sstable(sizes.begin(), sizes.end());
+    std::mt19937_64 rng(std::random_device{}());
+
+    std::vector<temporary_buffer<char>> regions;
+    for (size_t i = 0; i < n; ++i) {
+        const auto& sst = sstables[pick_sstable(rng)];
+        const auto len = std::min(region_size, sst->data_size());
+        const auto pos = std::uniform_int_distribution<uint64_t>(0, sst->data_size() - len)(rng);
+        auto istream = sst->data_stream(pos, len, permit, nullptr, nullptr);
+        auto close_istream = defer([&istream] { istream.close().get(); });
+        regions.push_back(istream.read_exactly(len).get());
+    }
+    return regions;
+}
+
+// The regions cut into chunks of chunk_len.
+std::vector<std::string_view> split_into_chunks(const std::vector<temporary_buffer<char>>& regions, uint32_t chunk_len) {
+    std::vector<std::string_view> chunks;
+    for (const auto& region : regions) {
+        for (size_t pos = 0; pos < region.size(); pos += chunk_len) {
+            chunks.emplace_back(region.get() + pos, std::min<size_t>(chunk_len, region.size() - pos));
+        }
+    }
+    return chunks;
+}
+
+// The memory taken by the chunk offsets of the given number of chunks, see
+// compression::segmented_offsets.
+std::optional<uint64_t> compression_offsets_memory(uint32_t chunk_len, uint64_t chunks) {
+    const auto chunk_size_log2 = log2ceil(chunk_len);
+    auto bi = std::ranges::find(sstables::bucket_infos, chunk_size_log2, &sstables::bucket_info::chunk_size_log2);
+    if (bi == sstables::bucket_infos.end()) {
+        return std::nullopt;
+    }
+    auto si = std::ranges::find_if(sstables::segment_infos, [&] (const sstables::segment_info& si) {
+        return si.data_size_log2 == bi->best_data_size_log2 && si.chunk_size_log2 == bi->chunk_size_log2;
+    });
+    const auto offsets_per_bucket = bi->segments_per_bucket * si->grouped_offsets;
+    return (chunks + offsets_per_bucket - 1) / offsets_per_bucket * sstables::bucket_size;
+}
+
+void estimate_compression_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
+    if (sstables.empty()) {
+        throw std::invalid_argument("no sstables specified on the command line");
+    }
+
+    auto candidates = parse_compression_candidates(vm["compressors"].as<sstring>(), vm["chunk-lengths"].as<sstring>());
+    const auto region_size = std::ranges::max(candidates | std::views::transform(&compression_candidate::chunk_len));
+    const auto samples = vm["samples"].as<unsigned>();
+
+    uint64_t data_size = 0;
+    uint64_t partitions = 0;
+    for (const auto& sst : sstables) {
+        data_size += sst->data_size();
+        partitions += sst->get_estimated_key_count();
+    }
+    const uint64_t read_size = vm.count("read-size") ? vm["read-size"].as<uint64_t>() : std::max<uint64_t>(data_size / std::max<uint64_t>(partitions, 1), 1);
+
+    const auto regions = sample_data(sstables, permit, samples, region_size);
+    // Dictionaries are trained on different data than they are evaluated on,
+    // like the writer, which trains them on the first chunks of the sstable
+    // and uses them for all of them.
+    std::vector<temporary_buffer<char>> training_regions;
+    if (std::ranges::any_of(candidates, [] (const compression_candidate& c) { return c.compressor && c.compressor->dictionary_size(); })) {
+        training_regions = sample_data(sstables, permit, samples, region_size);
+    }
+
+    json_writer writer;
+    writer.StartStream();
+    writer.Key("sampled_bytes");
+    writer.Uint64(std::ranges::fold_left(regions | std::views::transform(&temporary_buffer<char>::size), uint64_t(0), std::plus<>()));
+    writer.Key("read_size");
+    writer.Uint64(read_size);
+    writer.Key("current");
+    writer.StartObject();
+    for (const auto& [key, value] : schema->get_compressor_params().get_options()) {
+        writer.Key(key);
+        writer.String(value);
+    }
+    writer.EndObject();
+    writer.Key("candidates");
+    writer.StartArray();
+
+    for (auto& c : candidates) {
+        if (!c.compressor) {
+            continue;
+        }
+        if (c.compressor->dictionary_size()) {
+            std::vector<bytes_view> training_samples;
+            for (auto chunk : split_into_chunks(training_regions, c.chunk_len)) {
+                training_samples.emplace_back(reinterpret_cast<const int8_t*>(chunk.data()), chunk.size());
+            }
+            c.dictionary = c.compressor->train_dictionary(training_samples);
+            if (!c.dictionary.empty()) {
+                c.compressor = c.compressor->with_dictionary(c.dictionary);
+            }
+        }
+
+        const auto chunks = split_into_chunks(regions, c.chunk_len);
+        std::vector<temporary_buffer<char>> compressed;
+        compressed.reserve(chunks.size());
+        uint64_t uncompressed_bytes = 0;
+        uint64_t compressed_bytes = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (auto chunk : chunks) {
+            temporary_buffer<char> buf(c.compressor->compress_max_size(chunk.size()));
+            buf.trim(c.compressor->compress(chunk.data(), chunk.size(), buf.get_write(), buf.size()));
+            uncompressed_bytes += chunk.size();
+            compressed_bytes += buf.size();
+            compressed.push_back(std::move(buf));
+            thread::maybe_yield();
+        }
+        const std::chrono::duration<double> compress_time = std::chrono::steady_clock::now() - start;
+
+        temporary_buffer<char> out(c.chunk_len);
+        start = std::chrono::steady_clock::now();
+        for (const auto& buf : compressed) {
+            c.compressor->uncompress(buf.get(), buf.size(), out.get_write(), out.size());
+            thread::maybe_yield();
+        }
+        const std::chrono::duration<double> decompress_time = std::chrono::steady_clock::now() - start;
+
+        // A read of read_size bytes at a random position of the data spans
+        // this many chunks on average, each of which has to be read from
+        // the disk (with a 4 byte checksum and DMA alignment) and
+        // decompressed as a whole.
+        const double ratio = double(compressed_bytes) / uncompressed_bytes;
+        const double chunks_per_read = 1 + double(read_size - 1) / c.chunk_len;
+        const double disk_bytes_per_read = (1 + (chunks_per_read * (ratio * c.chunk_len + 4) - 1) / 4096) * 4096;
+        const double MB = 1024 * 1024;
+
+        writer.StartObject();
+        writer.Key("options");
+        writer.StartObject();
+        for (const auto& [key, value] : c.options) {
+            writer.Key(key);
+            writer.String(value);
+        }
+        writer.EndObject();
+        writer.Key("dictionary_size");
+        writer.Uint64(c.dictionary.size());
+        writer.Key("ratio");
+        writer.Double(ratio);
+        writer.Key("compress_mb_per_s");
+        writer.Double(uncompressed_bytes / MB / compress_time.count());
+        writer.Key("decompress_mb_per_s");
+        writer.Double(uncompressed_bytes / MB / decompress_time.count());
+        writer.Key("read_amplification");
+        writer.StartObject();
+        writer.Key("decompressed_bytes_per_read");
+        writer.Double(chunks_per_read * c.chunk_len);
+        writer.Key("disk_bytes_per_read");
+        writer.Double(disk_bytes_per_read);
+        writer.Key("factor");
+        writer.Double(chunks_per_read * c.chunk_len / read_size);
+        writer.EndObject();
+        writer.Key("offsets_memory_per_gb");
+        if (auto mem = compression_offsets_memory(c.chunk_len, (uint64_t(1) << 30) / c.chunk_len)) {
+            writer.Uint64(*mem);
+        } else {
+            writer.Null();
+        }
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.EndStream();
+}
+
 class json_mutation_stream_parser {
     using reader = rapidjson::GenericReader<rjson::encoding, rjson::encoding, rjson::allocator>;
     class stream {
@@ -2613,16 +3011,453 @@ void sstable_consumer_operation(schema_ptr schema, reader_permit permit, const s
     }
     const auto merge = vm.count("merge");
     const auto no_skips = vm.count("no-skips");
-    const auto partitions = get_partitions(schema, vm);
-    const auto use_full_scan_reader = no_skips || partitions.empty();
+    auto consume = [&] (SstableConsumer& consumer, schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables) {
+        const auto partitions = get_partitions(schema, vm);
+        const auto use_full_scan_reader = no_skips || partitions.empty();
+        consume_sstables(schema, permit, sstables, merge, use_full_scan_reader, [&] (mutation_reader& rd, sstables::sstable* sst) {
+            return consume_reader(std::move(rd), consumer, sst, partitions, no_skips);
+        });
+    };
     auto consumer = std::make_unique<SstableConsumer>(schema, permit, vm);
     consumer->consume_stream_start().get();
-    consume_sstables(schema, permit, sstables, merge, use_full_scan_reader, [&, &consumer = *consumer] (mutation_reader& rd, sstables::sstable* sst) {
-        return consume_reader(std::move(rd), consumer, sst, partitions, no_skips);
-    });
+    // Consumers the results of which can be merged can run on all shards.
+    if constexpr (requires { typename SstableConsumer::partial_result; }) {
+        if (vm.count("parallel")) {
+            using partial_result = typename SstableConsumer::partial_result;
+            auto results = run_on_all_shards<partial_result>(schema, permit, sstables, sst_man, vm,
+                    [&] (schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager&) {
+                SstableConsumer shard_consumer(schema, permit, vm);
+                shard_consumer.consume_stream_start().get();
+                consume(shard_consumer, schema, permit, sstables);
+                return shard_consumer.release_partial_result();
+            });
+            for (auto& res : results) {
+                consumer->merge(std::move(res));
+            }
+            consumer->consume_stream_end().get();
+            return;
+        }
+    }
+    consume(*consumer, schema, permit, sstables);
     consumer->consume_stream_end().get();
 }
 
+// Clustering ranges to read with the query operation, from the full
+// clustering keys passed with --row, in the hex format.
+query::clustering_row_ranges get_clustering_ranges(const schema& schema, const bpo::variables_map& app_config) {
+    if (!app_config.count("row")) {
+        return query::clustering_row_ranges{query::clustering_range::make_open_ended_both_sides()};
+    }
+    auto ck_type = schema.clustering_key_prefix_type();
+    query::clustering_row_ranges ranges;
+    for (const auto& ck_hex : app_config["row"].as<std::vector<sstring>>()) {
+        auto ck = clustering_key_prefix::from_exploded(ck_type->components(managed_bytes_view(from_hex(ck_hex))));
+        if (!ck.is_full(schema)) {
+            throw std::invalid_argument(fmt::format("clustering key {} is not a full clustering key", ck_hex));
+        }
+        ranges.push_back(query::clustering_range::make_singular(std::move(ck)));
+    }
+    return query::clustering_range::deoverlap(std::move(ranges), clustering_key::tri_compare(schema));
+}
+
+struct row_predicate {
+    const column_definition* column;
+    bytes value;
+};
+
+// Predicates on the columns of rows passed with --filter, in the
+// <column>=<value> format. Values are in their CQL text form.
+std::vector<row_predicate> get_row_predicates(const schema& schema, const bpo::variables_map& app_config) {
+    std::vector<row_predicate> predicates;
+    if (!app_config.count("filter")) {
+        return predicates;
+    }
+    for (const auto& filter : app_config["filter"].as<std::vector<sstring>>()) {
+        const auto pos = filter.find('=');
+        if (pos == sstring::npos) {
+            throw std::invalid_argument(fmt::format("invalid filter {}, expected <column>=<value>", filter));
+        }
+        const auto name = filter.substr(0, pos);
+        const auto* column = schema.get_column_definition(to_bytes(name));
+        if (!column) {
+            throw std::invalid_argument(fmt::format("unknown column {} in filter {}", name, filter));
+        }
+        if (!column->is_regular() || !column->is_atomic() || column->is_counter()) {
+            throw std::invalid_argument(fmt::format("cannot filter on column {}, only regular columns of non-collection, non-counter types are supported", name));
+        }
+        predicates.push_back({column, column->type->from_string(filter.substr(pos + 1))});
+    }
+    return predicates;
+}
+
+// Passes on the partitions of the stream which have rows matching all the
+// predicates, with only those rows. Range tombstone changes are dropped.
+class row_filtering_consumer : public sstable_consumer {
+    std::vector<row_predicate> _predicates;
+    std::unique_ptr<sstable_consumer> _consumer;
+    std::optional<partition_start> _partition_start;
+    std::optional<static_row> _static_row;
+    bool _partition_started = false;
+
+    bool matches(const clustering_row& cr) const {
+        return std::ranges::all_of(_predicates, [&] (const row_predicate& p) {
+            const auto* cell = cr.cells().find_cell(p.column->id);
+            if (!cell) {
+                return false;
+            }
+            auto ac = cell->as_atomic_cell(*p.column);
+            return ac.is_live() && p.column->type->equal(ac.value(), bytes_view(p.value));
+        });
+    }
+
+public:
+    row_filtering_consumer(std::vector<row_predicate> predicates, std::unique_ptr<sstable_consumer> consumer)
+        : _predicates(std::move(predicates))
+        , _consumer(std::move(consumer))
+    { }
+    virtual future<> consume_stream_start() override { return _consumer->consume_stream_start(); }
+    virtual future<stop_iteration> consume_sstable_start(const sstables::sstable* const sst) override { return _consumer->consume_sstable_start(sst); }
+    virtual future<stop_iteration> consume(partition_start&& ps) override {
+        _partition_start = std::move(ps);
+        _static_row.reset();
+        _partition_started = false;
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(static_row&& sr) override {
+        _static_row = std::move(sr);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(clustering_row&& cr) override {
+        auto row = std::move(cr);
+        if (!matches(row)) {
+            co_return stop_iteration::no;
+        }
+        if (!_partition_started) {
+            _partition_started = true;
+            if (co_await _consumer->consume(std::move(*_partition_start)) == stop_iteration::yes) {
+                co_return stop_iteration::yes;
+            }
+            if (_static_row && co_await _consumer->consume(std::move(*_static_row)) == stop_iteration::yes) {
+                co_return stop_iteration::yes;
+            }
+        }
+        co_return co_await _consumer->consume(std::move(row));
+    }
+    virtual future<stop_iteration> consume(range_tombstone_change&&) override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_end&& pe) override {
+        if (!std::exchange(_partition_started, false)) {
+            return make_ready_future<stop_iteration>(stop_iteration::no);
+        }
+        return _consumer->consume(std::move(pe));
+    }
+    virtual future<stop_iteration> consume_sstable_end() override { return _consumer->consume_sstable_end(); }
+    virtual future<> consume_stream_end() override { return _consumer->consume_stream_end(); }
+};
+
+void query_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
+    if (sstables.empty()) {
+        throw std::invalid_argument("no sstables specified on the command line");
+    }
+
+    // The requested partitions and rows are read through the index and
+    // promoted index, instead of scanning the data and filtering it.
+    dht::partition_range_vector partition_ranges;
+    if (auto partitions = get_partitions(schema, vm); partitions.empty()) {
+        partition_ranges.push_back(dht::partition_range::make_open_ended_both_sides());
+    } else {
+        auto keys = partitions | std::ranges::to<std::vector<dht::decorated_key>>();
+        std::ranges::sort(keys, dht::decorated_key::less_comparator(schema));
+        for (auto& key : keys) {
+            partition_ranges.push_back(dht::partition_range::make_singular(std::move(key)));
+        }
+    }
+    const auto slice = partition_slice_builder(*schema).with_ranges(get_clustering_ranges(*schema, vm)).build();
+
+    std::unique_ptr<sstable_consumer> consumer = std::make_unique<dumping_consumer>(schema, permit, vm);
+    if (auto predicates = get_row_predicates(*schema, vm); !predicates.empty()) {
+        consumer = std::make_unique<row_filtering_consumer>(std::move(predicates), std::move(consumer));
+    }
+
+    auto make_reader = [&] (const sstables::shared_sstable& sst) {
+        return make_flat_multi_range_reader(schema, permit, sst->as_mutation_source(), partition_ranges, slice);
+    };
+    const partition_set no_partition_filter(0, {}, decorated_key_equal(*schema));
+
+    consumer->consume_stream_start().get();
+    if (vm.count("merge")) {
+        std::vector<mutation_reader> readers;
+        readers.reserve(sstables.size());
+        for (const auto& sst : sstables) {
+            readers.emplace_back(make_reader(sst));
+        }
+        consume_reader(make_combined_reader(schema, permit, std::move(readers)), *consumer, nullptr, no_partition_filter, false);
+    } else {
+        for (const auto& sst : sstables) {
+            if (consume_reader(make_reader(sst), *consumer, sst.get(), no_partition_filter, false) == stop_iteration::yes) {
+                break;
+            }
+        }
+    }
+    consumer->consume_stream_end().get();
+}
+
+// Returns the names of the columns to export, in the order of the --column
+// options, or all of them in the order of the schema by default.
+std::vector<sstring> get_export_columns(const schema& schema, const bpo::variables_map& vm) {
+    if (!vm.count("column")) {
+        return schema.all_columns() | std::views::transform([] (const column_definition& cdef) { return cdef.name_as_text(); }) | std::ranges::to<std::vector>();
+    }
+    auto columns = vm["column"].as<std::vector<sstring>>();
+    for (const auto& name : columns) {
+        if (!schema.get_column_definition(to_bytes(name))) {
+            throw std::invalid_argument(fmt::format("no such column: {}", name));
+        }
+    }
+    return columns;
+}
+
+// Writes the live rows of the stream as CSV (RFC 4180), with a header line
+// and then one line per CQL row, with the values of the given columns in
+// their CQL text form. Columns without a live cell are written as empty
+// fields, while empty values are written as "".
+//
+// The stream is expected to be compacted, so that the data shadowed by
+// tombstones is already dropped and expired cells are already dead. Like in
+// CQL, a partition with a live static row but no live clustering rows is
+// written as a single row, without clustering columns.
+class csv_exporting_consumer : public sstable_consumer {
+    schema_ptr _schema;
+    std::vector<const column_definition*> _columns;
+    std::ostream& _os;
+    gc_clock::time_point _now;
+    std::vector<bytes> _partition_key;
+    std::optional<static_row> _static_row;
+    bool _wrote_rows = false;
+    uint64_t _rows = 0;
+    std::string _line;
+
+    static void append_field(std::string& line, std::string_view value) {
+        if (!value.empty() && value.find_first_of(",\"\r\n") == std::string_view::npos) {
+            line += value;
+            return;
+        }
+        line += '"';
+        for (auto c : value) {
+            if (c == '"') {
+                line += '"';
+            }
+            line += c;
+        }
+        line += '"';
+    }
+
+    std::optional<sstring> cell_value(const column_definition& column, const atomic_cell_or_collection* cell) const {
+        if (!cell) {
+            return std::nullopt;
+        }
+        if (!column.is_atomic()) {
+            auto cmv = cell->as_collection_mutation();
+            if (!cmv.is_any_live(*column.type, tombstone(), _now)) {
+                return std::nullopt;
+            }
+            return column.type->to_string(linearized(serialize_for_cql(*column.type, std::move(cmv))));
+        }
+        auto ac = cell->as_atomic_cell(column);
+        if (!ac.is_live(tombstone(), _now, column.is_counter())) {
+            return std::nullopt;
+        }
+        if (column.is_counter()) {
+            return fmt::to_string(counter_cell_view(ac).total_value());
+        }
+        return column.type->to_string(ac.value().linearize());
+    }
+
+    void write_row(const clustering_row* cr) {
+        const auto clustering_key = cr ? cr->key().explode(*_schema) : std::vector<bytes>();
+        _line.clear();
+        for (auto it = _columns.begin(); it != _columns.end(); ++it) {
+            if (it != _columns.begin()) {
+                _line += ',';
+            }
+            const auto& column = **it;
+            std::optional<sstring> value;
+            switch (column.kind) {
+                case column_kind::partition_key:
+                    value = column.type->to_string(_partition_key.at(column.component_index()));
+                    break;
+                case column_kind::clustering_key:
+                    if (column.component_index() < clustering_key.size()) {
+                        value = column.type->to_string(clustering_key[column.component_index()]);
+                    }
+                    break;
+                case column_kind::static_column:
+                    value = cell_value(column, _static_row ? _static_row->cells().find_cell(column.id) : nullptr);
+                    break;
+                case column_kind::regular_column:
+                    value = cell_value(column, cr ? cr->cells().find_cell(column.id) : nullptr);
+                    break;
+            }
+            if (value) {
+                append_field(_line, *value);
+            }
+        }
+        _line += '\n';
+        _os << _line;
+        ++_rows;
+    }
+
+public:
+    csv_exporting_consumer(schema_ptr schema, std::vector<const column_definition*> columns, std::ostream& os, gc_clock::time_point now)
+        : _schema(std::move(schema))
+        , _columns(std::move(columns))
+        , _os(os)
+        , _now(now)
+    { }
+    uint64_t rows() const { return _rows; }
+    virtual future<> consume_stream_start() override {
+        _line.clear();
+        for (auto it = _columns.begin(); it != _columns.end(); ++it) {
+            if (it != _columns.begin()) {
+                _line += ',';
+            }
+            append_field(_line, (*it)->name_as_text());
+        }
+        _line += '\n';
+        _os << _line;
+        return make_ready_future<>();
+    }
+    virtual future<stop_iteration> consume_sstable_start(const sstables::sstable* const) override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_start&& ps) override {
+        _partition_key = ps.key().key().explode(*_schema);
+        _static_row.reset();
+        _wrote_rows = false;
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(static_row&& sr) override {
+        if (sr.is_live(*_schema, _now)) {
+            _static_row = std::move(sr);
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(clustering_row&& cr) override {
+        if (cr.is_live(*_schema, tombstone(), _now)) {
+            write_row(&cr);
+            _wrote_rows = true;
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(range_tombstone_change&&) override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_end&&) override {
+        if (!_wrote_rows && _static_row) {
+            write_row(nullptr);
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume_sstable_end() override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<> consume_stream_end() override {
+        _os.flush();
+        return make_ready_future<>();
+    }
+};
+
+// Exports the content of the sstables, restricted to the given ranges, as
+// of now.
+//
+// All the sstables are merged and compacted as of now, without purging any
+// tombstone, so that the output has only the data which is live at that
+// time, like a CQL scan would return.
+uint64_t export_sstables(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        const dht::partition_range_vector& ranges, const std::vector<sstring>& column_names, gc_clock::time_point now, std::ostream& os) {
+    std::vector<mutation_reader> readers;
+    readers.reserve(sstables.size());
+    for (const auto& sst : sstables) {
+        readers.emplace_back(make_flat_multi_range_reader(schema, permit, sst->as_mutation_source(), ranges, schema->full_slice()));
+    }
+    const tombstone_gc_state gc_state(nullptr);
+    auto rd = make_compacting_reader(make_combined_reader(schema, permit, std::move(readers)), now, can_never_purge, gc_state);
+
+    auto columns = column_names | std::views::transform([&] (const sstring& name) {
+        return schema->get_column_definition(to_bytes(name));
+    }) | std::ranges::to<std::vector>();
+    csv_exporting_consumer consumer(schema, std::move(columns), os, now);
+    const partition_set no_partition_filter(0, {}, decorated_key_equal(*schema));
+    consumer.consume_stream_start().get();
+    consume_reader(std::move(rd), consumer, nullptr, no_partition_filter, false);
+    consumer.consume_stream_end().get();
+    return consumer.rows();
+}
+
+void export_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
+    if (sstables.empty()) {
+        throw std::invalid_argument("no sstables specified on the command line");
+    }
+    if (vm.count("parallel") && !vm.count("output-dir")) {
+        throw std::invalid_argument("--parallel requires --output-dir, each shard writes its own file");
+    }
+
+    const auto columns = get_export_columns(*schema, vm);
+    // All shards export the data as of the same time, so that their files
+    // together make up a consistent snapshot of the sstables.
+    const auto now = gc_clock::now();
+    const std::optional<std::filesystem::path> output_dir = vm.count("output-dir")
+        ? std::optional(std::filesystem::path(vm["output-dir"].as<sstring>()))
+        : std::nullopt;
+
+    auto export_shard = [&] (schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+            const dht::partition_range_vector& ranges) {
+        if (!output_dir) {
+            return export_sstables(std::move(schema), std::move(permit), sstables, ranges, columns, now, std::cout);
+        }
+        const auto path = *output_dir / fmt::format("{}-{}.csv", schema->cf_name(), this_shard_id());
+        std::ofstream os(path);
+        if (!os) {
+            throw std::runtime_error(fmt::format("failed to open {} for writing", path.native()));
+        }
+        const auto rows = export_sstables(std::move(schema), std::move(permit), sstables, ranges, columns, now, os);
+        if (!os) {
+            throw std::runtime_error(fmt::format("failed to write {}", path.native()));
+        }
+        sst_log.info("Exported {} rows into {}", rows, path.native());
+        return rows;
+    };
+
+    if (!vm.count("parallel")) {
+        export_shard(schema, permit, sstables, {dht::partition_range::make_open_ended_both_sides()});
+        return;
+    }
+
+    // All shards read all the sstables, each of them a disjoint part of the
+    // token ring, so that each partition is merged and compacted by a single
+    // shard.
+    std::vector<dht::partition_range_vector> shard_ranges(smp::count);
+    const auto token_ranges = dht::split_token_range_msb(log2ceil(smp::count));
+    for (size_t i = 0; i < token_ranges.size(); ++i) {
+        shard_ranges[i % smp::count].push_back(dht::to_partition_range(token_ranges[i]));
+    }
+    const std::vector<std::vector<size_t>> assignment(smp::count, std::views::iota(size_t(0), sstables.size()) | std::ranges::to<std::vector>());
+
+    uint64_t total_rows = 0;
+    for (const auto rows : run_on_all_shards<uint64_t>(schema, permit, sstables, sst_man, vm, assignment,
+            [&] (schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager&) {
+        // The readers keep referring to the ranges, have them local to the shard.
+        const auto ranges = shard_ranges[this_shard_id()];
+        return export_shard(std::move(schema), std::move(permit), sstables, ranges);
+    })) {
+        total_rows += rows;
+    }
+    sst_log.info("Exported {} rows in total", total_rows);
+}
+
 void shard_of_with_vnodes(const std::vector<sstables::shared_sstable>& sstables,
                           sstables::sstables_manager& sstable_manager,
                           const bpo::variables_map& vm) {
@@ -2763,6 +3598,68 @@ for more information on this operation, including the schema of the JSON output.
                     typed_option<std::string>("output-format", "json", "the output-format, one of (text, json)"),
             }},
             sstable_consumer_operation<dumping_consumer>},
+/* query */
+    {{"query",
+            "Dump the rows of sstable(s) matching a query",
+R"(
+Dump the partitions and rows of the data component which match the query given
+on the command line, in the same format as dump-data.
+
+Partitions are selected with the --partition or --partitions-file options and
+rows with the --row option, all expecting keys in the hexdump format. Rows have
+to be selected by their full clustering key. The selected partitions and rows
+are located with the index and promoted index, so only those are read, instead
+of the whole sstable.
+
+The rows can be further filtered on the values of their regular columns with
+the --filter option, in the <column>=<value> format, where the value is in its
+CQL text form, e.g. --filter v=12. Rows match if they have a live cell with the
+given value for all the filters. Only the partitions with matching rows are
+dumped, and range tombstones are omitted.
+
+See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#query
+for more information on this operation.
+)",
+            {
+                    typed_option<std::vector<sstring>>("partition", "partition(s) to read, partitions are expected to be in the hex format"),
+                    typed_option<sstring>("partitions-file", "file containing partition(s) to read, partitions are expected to be in the hex format"),
+                    typed_option<std::vector<sstring>>("row", "row(s) to read, full clustering keys are expected to be in the hex format"),
+                    typed_option<std::vector<sstring>>("filter", "filter(s) on the cells of rows, in the <column>=<value> format"),
+                    typed_option<>("merge", "merge all sstables into a single mutation fragment stream (use a combining reader over all sstable readers)"),
+                    typed_option<std::string>("output-format", "json", "the output-format, one of (text, json)"),
+            }},
+            query_operation},
+/* export */
+    {{"export",
+            "Export the live rows of sstable(s) as CSV",
+R"(
+Export the rows of the sstable(s) which are live as of now, in the CSV format,
+with a header line and then one line per CQL row, like a full scan of the
+table would return them. Values are written in their CQL text form, columns
+without a value as empty fields.
+
+All the sstables are merged and compacted, so that data deleted by tombstones
+and expired cells are left out. To export a consistent snapshot of a live
+table, take a snapshot of it with nodetool and export the sstables of the
+snapshot.
+
+By default all columns are exported, in the order of the schema, the --column
+option selects the columns to export and their order instead.
+
+The output is written to the standard output by default, or to
+<table>-<shard>.csv in the directory given with --output-dir. With --parallel,
+all the shards read all the sstables, each of them a distinct part of the token
+ring, which they write into their own file.
+
+See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#export
+for more information on this operation.
+)",
+            {
+                    typed_option<std::vector<sstring>>("column", "column(s) to export, all columns are exported by default"),
+                    typed_option<sstring>("output-dir", "directory to write the output file(s) into, the output is written to the standard output by default"),
+                    typed_option<>("parallel", "split the token ring across all shards, each writing its own file, start the tool with --smp to set the number of shards"),
+            }},
+            export_operation},
 /* dump-index */
     {{"dump-index",
             "Dump content of sstable index(es)",
@@ -2871,7 +3768,10 @@ following example python script:
 
      plt.show()
 )",
-            {typed_option<std::string>("bucket", "months", "the unit of time to use as bucket, one of (years, months, weeks, days, hours)")}},
+            {
+                    typed_option<std::string>("bucket", "months", "the unit of time to use as bucket, one of (years, months, weeks, days, hours)"),
+                    typed_option<>("parallel", "spread the sstables across all shards, start the tool with --smp to set the number of shards"),
+            }},
             sstable_consumer_operation<writetime_histogram_collecting_consumer>},
 /* validate */
     {{"validate",
@@ -2885,7 +3785,10 @@ validation will happen on the fragment level.
 
 See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#validate
 for more information on this operation.
-)"},
+)",
+            {
+                    typed_option<>("parallel", "spread the sstables across all shards, start the tool with --smp to set the number of shards"),
+            }},
             validate_operation},
 /* scrub */
     {{"scrub",
@@ -2910,6 +3813,7 @@ for more information on this operation, including what the different modes do.
                     typed_option<std::string>("scrub-mode", "scrub mode to use, one of (abort, skip, segregate, validate)"),
                     typed_option<std::string>("output-dir", ".", "directory to place the scrubbed sstables to"),
                     typed_option<>("unsafe-accept-nonempty-output-dir", "allow the operation to write into a non-empty output directory, acknowledging the risk that this may result in sstable clash"),
+                    typed_option<>("parallel", "spread the sstables across all shards, start the tool with --smp to set the number of shards"),
             }},
             scrub_operation},
 /* validate-checksums */
@@ -2922,6 +3826,42 @@ See https://docs.scylladb.com/operating-scylla/admin-tools/scylla-sstable#valida
 for more information on this operation.
 )"},
             validate_checksums_operation},
+/* estimate-compression */
+    {{"estimate-compression",
+            "Estimate the effect of different compression settings on the sstable(s)",
+R"(
+Samples chunks of the uncompressed data of the sstable(s) and compresses them
+with each of the candidate compressors and chunk lengths, to predict the effect
+of changing the compression settings of the table without rewriting it.
+
+The candidates are given with --compressors, a comma-separated list of
+compressor names, each optionally followed by colon-separated options, and
+--chunk-lengths, a comma-separated list of chunk lengths in KiB. Each
+compressor is tried with each of the chunk lengths. Compressors which use
+dictionaries are trained on a separate sample of the data.
+
+For each candidate, the following is reported, in JSON:
+* ratio: the compressed size over the uncompressed size;
+* compress_mb_per_s, decompress_mb_per_s: the throughput of (de)compression,
+  in MiB of uncompressed data per second, on a single thread;
+* read_amplification: the data read from the disk and decompressed by a read
+  of --read-size bytes (the average partition size by default) at a random
+  position, and the ratio of the decompressed data to the read size;
+* offsets_memory_per_gb: the memory taken by the chunk offsets of the
+  compression info, per GiB of uncompressed data.
+
+Examples:
+$ scylla sstable estimate-compression /path/to/md-123456-big-Data.db
+$ scylla sstable estimate-compression --compressors LZ4Compressor,ZstdCompressor:compression_level=3:dictionary_size_in_kb=64 --chunk-lengths 4,16 /path/to/md-123456-big-Data.db
+)",
+            {
+                    typed_option<sstring>("compressors", "LZ4Compressor,ZstdCompressor:compression_level=1,ZstdCompressor:compression_level=3",
+                            "the candidate compressors, a comma-separated list of names, each followed by colon-separated key=value options"),
+                    typed_option<sstring>("chunk-lengths", "4,16,64", "the candidate chunk lengths, a comma-separated list of KiB values"),
+                    typed_option<unsigned>("samples", 256, "the number of regions to sample from the data, each as large as the largest chunk length"),
+                    typed_option<uint64_t>("read-size", "the size of the reads to estimate the read amplification for, the average partition size by default"),
+            }},
+            estimate_compression_operation},
 /* decompress */
     {{"decompress",
             "Decompress sstable(s)",
@@ -3139,25 +4079,10 @@ Validate the specified sstables:
         dbcfg.enable_cache(false);
         dbcfg.volatile_system_keyspace_for_testing(true);
 
-        {
-            unsigned schema_sources = 0;
-            schema_sources += !app_config["schema-file"].defaulted();
-            schema_sources += app_config.contains("system-schema");
-            schema_sources += app_config.contains("scylla-data-dir");
-            schema_sources += app_config.contains("scylla-yaml-file");
-
-            if (!schema_sources) {
-                sst_log.debug("No user-provided schema source, attempting to auto-detect it");
-                schema_with_source = try_load_schema_autodetect(app_config, dbcfg);
-            } else if (schema_sources == 1 || (schema_sources == 2 && app_config.contains("scylla-yaml-file"))) {
-                // We make an exception for the case where 2 schema sources are provided, but one of them is scylla-yaml file.
-                // We want to always accept the --scylla-yaml-file option.
-                sst_log.debug("Single schema source provided");
-                schema_with_source = try_load_schema_from_user_provided_source(app_config, dbcfg);
-            } else {
-                fmt::print(std::cerr, "Multiple schema sources provided, please provide exactly one of: --schema-file, --system-schema, --scylla-data-dir or --scylla-yaml-file (with the accompanying --keyspace and --table if necessary)\n");
-            }
-        }
+        // For the operations processing the sstables on all shards.
+        dbcfg.broadcast_to_all_shards().get();
+
+        schema_with_source = load_schema(app_config, dbcfg);
         if (schema_with_source) {
             schema = std::move(schema_with_source->schema);
             sst_log.debug("Succesfully loaded schema from {}{}, obtained from {}",
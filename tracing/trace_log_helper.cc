@@ -0,0 +1,512 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <charconv>
+
+#include <seastar/core/align.hh>
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/util/closeable.hh>
+
+#include "cql3/query_processor.hh"
+#include "db/config.hh"
+#include "service/storage_proxy.hh"
+#include "table_helper.hh"
+#include "tracing/trace_log_helper.hh"
+#include "utils/UUID_gen.hh"
+#include "utils/class_registrator.hh"
+#include "utils/crc.hh"
+#include "utils/lister.hh"
+
+namespace tracing {
+
+static logging::logger tlogger("trace_log_helper");
+
+enum class record_kind : uint8_t {
+    session = 1,
+    event = 2,
+};
+
+// The magic and the u32 format version.
+static constexpr size_t segment_header_size = trace_log_helper::file_magic.size() + sizeof(uint32_t);
+// u32 payload size and u32 crc32 of the payload.
+static constexpr size_t record_header_size = 2 * sizeof(uint32_t);
+
+namespace {
+
+class record_writer {
+    bytes_ostream _out;
+public:
+    template <std::integral T>
+    void write_int(T v) {
+        seastar::write_le<T>(reinterpret_cast<char*>(_out.write_place_holder(sizeof(T))), v);
+    }
+
+    void write_string(std::string_view s) {
+        write_int<uint32_t>(s.size());
+        _out.write(s.data(), s.size());
+    }
+
+    void write_uuid(const utils::UUID& id) {
+        write_int<int64_t>(id.get_most_significant_bits());
+        write_int<int64_t>(id.get_least_significant_bits());
+    }
+
+    // Appends the framed record to the buffer.
+    void append_to(bytes_ostream& buffer) && {
+        utils::crc32 crc;
+        for (auto frag : _out.fragments()) {
+            crc.process(reinterpret_cast<const uint8_t*>(frag.data()), frag.size());
+        }
+        auto header = reinterpret_cast<char*>(buffer.write_place_holder(record_header_size));
+        seastar::write_le<uint32_t>(header, _out.size());
+        seastar::write_le<uint32_t>(header + sizeof(uint32_t), crc.get());
+        buffer.append(_out);
+    }
+};
+
+class record_reader {
+    temporary_buffer<char> _buf;
+    size_t _pos = 0;
+
+    const char* consume(size_t n) {
+        if (_buf.size() - _pos < n) {
+            throw std::runtime_error(format("Truncated trace log record: {} bytes needed at {}, record size is {}", n, _pos, _buf.size()));
+        }
+        auto p = _buf.get() + _pos;
+        _pos += n;
+        return p;
+    }
+public:
+    explicit record_reader(temporary_buffer<char> buf) : _buf(std::move(buf)) {}
+
+    template <std::integral T>
+    T read_int() {
+        return seastar::read_le<T>(consume(sizeof(T)));
+    }
+
+    sstring read_string() {
+        auto size = read_int<uint32_t>();
+        return sstring(consume(size), size);
+    }
+
+    utils::UUID read_uuid() {
+        auto msb = read_int<int64_t>();
+        auto lsb = read_int<int64_t>();
+        return utils::UUID(msb, lsb);
+    }
+};
+
+struct parsed_segment_file_name {
+    unsigned shard;
+    uint64_t sequence;
+};
+
+std::optional<parsed_segment_file_name> parse_segment_file_name(std::string_view name) {
+    constexpr std::string_view prefix = "shard-";
+    constexpr std::string_view suffix = ".log";
+    if (!name.starts_with(prefix) || !name.ends_with(suffix)) {
+        return std::nullopt;
+    }
+    name.remove_prefix(prefix.size());
+    name.remove_suffix(suffix.size());
+    parsed_segment_file_name parsed;
+    auto end = name.data() + name.size();
+    auto [p, ec] = std::from_chars(name.data(), end, parsed.shard);
+    if (ec != std::errc() || p == end || *p != '-') {
+        return std::nullopt;
+    }
+    auto [q, ec2] = std::from_chars(p + 1, end, parsed.sequence);
+    if (ec2 != std::errc() || q != end) {
+        return std::nullopt;
+    }
+    return parsed;
+}
+
+int64_t to_micros(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+}
+
+int64_t to_micros(elapsed_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+} // anonymous namespace
+
+trace_log_helper::trace_log_helper(tracing& tr)
+    : i_tracing_backend_helper(tr)
+{
+    namespace sm = seastar::metrics;
+
+    _metrics.add_group("tracing_log_helper", {
+        sm::make_counter("written_bytes", [this] { return _stats.written_bytes; },
+                        sm::description("Counts the bytes of tracing records written to the trace log.")),
+
+        sm::make_counter("dropped_records", [this] { return _stats.dropped_records; },
+                        sm::description("Counts the tracing records dropped because the trace log writes didn't keep up.")),
+
+        sm::make_counter("errors", [this] { return _stats.errors; },
+                        sm::description("Counts the errors of the writes to the trace log. "
+                                        "One error may cause one or more tracing records to be lost.")),
+
+        sm::make_counter("segments_removed", [this] { return _stats.segments_removed; },
+                        sm::description("Counts the trace log segments removed to keep the number of segments within the limit.")),
+    });
+}
+
+sstring trace_log_helper::segment_file_name(unsigned shard, uint64_t sequence) {
+    return format("shard-{}-{}.log", shard, sequence);
+}
+
+future<> trace_log_helper::start(cql3::query_processor& qp, service::migration_manager& mm) {
+    _qp = &qp;
+    const auto& db_cfg = qp.db().get_config();
+    _cfg.directory = std::filesystem::path(db_cfg.tracing_log_directory());
+    _cfg.segment_size = uint64_t(std::max(1u, db_cfg.tracing_log_segment_size_in_mb())) << 20;
+    _cfg.max_segments = std::max(1u, db_cfg.tracing_log_segments_per_shard());
+
+    co_await recursive_touch_directory(_cfg.directory.native());
+    directory_lister lister(_cfg.directory, lister::dir_entry_types::of<directory_entry_type::regular>());
+    co_await with_closeable(std::move(lister), [this] (directory_lister& lister) -> future<> {
+        while (auto de = co_await lister.get()) {
+            auto parsed = parse_segment_file_name(de->name);
+            if (parsed && parsed->shard == this_shard_id()) {
+                _segments.push_back(parsed->sequence);
+            }
+        }
+    });
+    std::ranges::sort(_segments);
+    tlogger.debug("Writing to {}, found {} segments of the previous run", _cfg.directory, _segments.size());
+}
+
+future<> trace_log_helper::shutdown() {
+    co_await _pending_writes.close();
+    // Writes what was buffered while the last flush was running.
+    co_await flush();
+    co_await close_segment();
+}
+
+std::unique_ptr<backend_session_state_base> trace_log_helper::allocate_session_state() const {
+    return std::make_unique<session_state>();
+}
+
+void trace_log_helper::write_records_bulk(records_bulk& bulk) {
+    tlogger.trace("Writing {} sessions", bulk.size());
+    for (auto& records : bulk) {
+        auto num_records = records->size();
+        if (_buffer.size() < _cfg.segment_size) {
+            try {
+                write_one_session_records(*records);
+            } catch (...) {
+                ++_stats.errors;
+                tlogger.warn("{}: failed to serialize the tracing records: {}", records->session_id, std::current_exception());
+            }
+        } else {
+            _stats.dropped_records += num_records;
+        }
+        records->events_recs.clear();
+        records->data_consumed();
+        _local_tracing.write_complete(num_records);
+    }
+    maybe_flush();
+}
+
+void trace_log_helper::write_one_session_records(one_session_records& records) {
+    auto& state = static_cast<session_state&>(*records.backend_state_ptr);
+    auto my_address = fmt::to_string(_qp->proxy().my_address());
+
+    for (auto& e : records.events_recs) {
+        record_writer w;
+        w.write_int(uint8_t(record_kind::event));
+        w.write_uuid(records.session_id);
+        w.write_uuid(utils::UUID_gen::get_time_UUID(table_helper::make_monotonic_UUID_tp(state.last_nanos, e.event_time_point)));
+        w.write_string(my_address);
+        w.write_int<int64_t>(to_micros(e.elapsed));
+        w.write_string(_local_tracing.get_thread_name());
+        w.write_int<uint64_t>(records.parent_id.get_id());
+        w.write_int<uint64_t>(records.my_span_id.get_id());
+        w.write_string(e.message);
+        std::move(w).append_to(_buffer);
+    }
+
+    const auto& rec = records.session_rec;
+    if (rec.ready()) {
+        record_writer w;
+        w.write_int(uint8_t(record_kind::session));
+        w.write_uuid(records.session_id);
+        w.write_int(uint8_t(rec.command));
+        w.write_string(fmt::to_string(rec.client));
+        w.write_string(my_address);
+        w.write_int<uint32_t>(this_shard_id());
+        w.write_int<int64_t>(to_micros(rec.started_at));
+        w.write_int<int64_t>(to_micros(rec.elapsed));
+        w.write_string(rec.request);
+        w.write_int<uint64_t>(rec.request_size);
+        w.write_int<uint64_t>(rec.response_size);
+        w.write_string(rec.username);
+        w.write_int<uint32_t>(rec.parameters.size());
+        for (auto& [key, value] : rec.parameters) {
+            w.write_string(key);
+            w.write_string(value);
+        }
+        w.write_int<uint32_t>(rec.tables.size());
+        for (auto& table : rec.tables) {
+            w.write_string(table);
+        }
+        std::move(w).append_to(_buffer);
+    }
+}
+
+void trace_log_helper::maybe_flush() {
+    if (_flushing || _buffer.empty() || _pending_writes.is_closed()) {
+        return;
+    }
+    _flushing = true;
+    // Waited on in shutdown() via _pending_writes.
+    (void)with_gate(_pending_writes, [this] {
+        return flush();
+    }).finally([this] {
+        _flushing = false;
+    });
+}
+
+future<> trace_log_helper::flush() {
+    while (!_buffer.empty()) {
+        auto buf = std::exchange(_buffer, bytes_ostream());
+        std::exception_ptr ex;
+        try {
+            if (!_file || _file_pos + _tail.size() >= _cfg.segment_size) {
+                co_await open_next_segment();
+            }
+            co_await write_to_segment(buf);
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        if (ex) {
+            ++_stats.errors;
+            tlogger.warn("Failed to write {} bytes to the trace log: {}", buf.size(), ex);
+            // The next write starts a new segment.
+            co_await close_segment();
+            co_return;
+        }
+        _stats.written_bytes += buf.size();
+    }
+}
+
+// The file is written with aligned writes, so the last, partial block of a
+// write is kept in _tail and written again, followed by more data, by the
+// next write.
+future<> trace_log_helper::write_to_segment(const bytes_ostream& buf) {
+    static constexpr size_t chunk_size = 128 * 1024;
+    const auto alignment = _file.disk_write_dma_alignment();
+    auto staging = temporary_buffer<char>::aligned(_file.memory_dma_alignment(), chunk_size);
+    auto write_fully = [this] (const char* data, size_t size) -> future<> {
+        auto written = co_await _file.dma_write(_file_pos, data, size);
+        if (written != size) {
+            throw std::runtime_error(format("Short write to the trace log: {} of {} bytes", written, size));
+        }
+    };
+
+    size_t staged = _tail.size();
+    std::copy_n(_tail.get(), _tail.size(), staging.get_write());
+    for (auto frag : buf.fragments()) {
+        while (!frag.empty()) {
+            auto n = std::min(frag.size(), chunk_size - staged);
+            std::copy_n(reinterpret_cast<const char*>(frag.data()), n, staging.get_write() + staged);
+            frag.remove_prefix(n);
+            staged += n;
+            if (staged == chunk_size) {
+                co_await write_fully(staging.get(), chunk_size);
+                _file_pos += chunk_size;
+                staged = 0;
+            }
+        }
+    }
+    auto full = align_down<size_t>(staged, alignment);
+    auto padded = align_up<size_t>(staged, alignment);
+    if (padded) {
+        std::fill(staging.get_write() + staged, staging.get_write() + padded, 0);
+        co_await write_fully(staging.get(), padded);
+    }
+    _tail = temporary_buffer<char>(staging.get() + full, staged - full);
+    _file_pos += full;
+}
+
+future<> trace_log_helper::open_next_segment() {
+    co_await close_segment();
+    auto sequence = _segments.empty() ? 0 : _segments.back() + 1;
+    auto path = (_cfg.directory / segment_file_name(this_shard_id(), sequence).c_str()).native();
+    _file = co_await open_file_dma(path, open_flags::wo | open_flags::create | open_flags::truncate);
+    _segments.push_back(sequence);
+    _file_pos = 0;
+    // The header is written along with the first records.
+    _tail = temporary_buffer<char>(segment_header_size);
+    std::copy_n(file_magic.data(), file_magic.size(), _tail.get_write());
+    seastar::write_le<uint32_t>(_tail.get_write() + file_magic.size(), format_version);
+    tlogger.debug("Opened segment {}", path);
+
+    while (_segments.size() > _cfg.max_segments) {
+        auto oldest = (_cfg.directory / segment_file_name(this_shard_id(), _segments.front()).c_str()).native();
+        _segments.pop_front();
+        try {
+            co_await remove_file(oldest);
+            ++_stats.segments_removed;
+        } catch (...) {
+            ++_stats.errors;
+            tlogger.warn("Failed to remove segment {}: {}", oldest, std::current_exception());
+        }
+    }
+}
+
+future<> trace_log_helper::close_segment() noexcept {
+    if (!_file) {
+        co_return;
+    }
+    auto f = std::exchange(_file, file());
+    auto size = _file_pos + _tail.size();
+    _tail = {};
+    try {
+        // Drops the padding of the last write.
+        co_await f.truncate(size);
+    } catch (...) {
+        ++_stats.errors;
+        tlogger.warn("Failed to truncate the trace log segment: {}", std::current_exception());
+    }
+    try {
+        co_await f.close();
+    } catch (...) {
+        ++_stats.errors;
+        tlogger.warn("Failed to close the trace log segment: {}", std::current_exception());
+    }
+}
+
+static trace_log_record decode_record(temporary_buffer<char> payload) {
+    record_reader r(std::move(payload));
+    auto kind = record_kind(r.read_int<uint8_t>());
+    switch (kind) {
+    case record_kind::session: {
+        trace_log_session s;
+        s.session_id = r.read_uuid();
+        s.command = trace_type(r.read_int<uint8_t>());
+        s.client = gms::inet_address(r.read_string());
+        s.coordinator = gms::inet_address(r.read_string());
+        s.shard = r.read_int<uint32_t>();
+        s.started_at = std::chrono::system_clock::time_point(std::chrono::microseconds(r.read_int<int64_t>()));
+        s.duration = std::chrono::microseconds(r.read_int<int64_t>());
+        s.request = r.read_string();
+        s.request_size = r.read_int<uint64_t>();
+        s.response_size = r.read_int<uint64_t>();
+        s.username = r.read_string();
+        for (auto n = r.read_int<uint32_t>(); n; --n) {
+            auto key = r.read_string();
+            s.parameters.emplace(std::move(key), r.read_string());
+        }
+        for (auto n = r.read_int<uint32_t>(); n; --n) {
+            s.tables.emplace(r.read_string());
+        }
+        return s;
+    }
+    case record_kind::event: {
+        trace_log_event e;
+        e.session_id = r.read_uuid();
+        e.event_id = r.read_uuid();
+        e.source = gms::inet_address(r.read_string());
+        e.elapsed = std::chrono::microseconds(r.read_int<int64_t>());
+        e.thread = r.read_string();
+        e.parent_id = span_id(r.read_int<uint64_t>());
+        e.my_span_id = span_id(r.read_int<uint64_t>());
+        e.activity = r.read_string();
+        return e;
+    }
+    }
+    throw std::runtime_error(format("Unknown trace log record kind {}", uint8_t(kind)));
+}
+
+static future<> read_segment(sstring path, noncopyable_function<future<>(trace_log_record)>& func) {
+    file f;
+    try {
+        f = co_await open_file_dma(path, open_flags::ro);
+    } catch (std::system_error& e) {
+        // Removed by the rotation since it was listed.
+        if (e.code().value() == ENOENT) {
+            co_return;
+        }
+        throw;
+    }
+    auto in = make_file_input_stream(std::move(f));
+    auto close_in = deferred_close(in);
+
+    auto header = co_await in.read_exactly(segment_header_size);
+    if (header.size() != segment_header_size
+            || std::string_view(header.get(), trace_log_helper::file_magic.size()) != trace_log_helper::file_magic
+            || seastar::read_le<uint32_t>(header.get() + trace_log_helper::file_magic.size()) != trace_log_helper::format_version) {
+        tlogger.warn("Skipping {}: not a trace log segment of a known format version", path);
+        co_return;
+    }
+
+    while (true) {
+        auto record_header = co_await in.read_exactly(record_header_size);
+        if (record_header.size() != record_header_size) {
+            break;
+        }
+        auto size = seastar::read_le<uint32_t>(record_header.get());
+        auto expected_crc = seastar::read_le<uint32_t>(record_header.get() + sizeof(uint32_t));
+        // The padding of the last write of a segment which is still being
+        // written, or which wasn't closed cleanly.
+        if (size == 0) {
+            break;
+        }
+        auto payload = co_await in.read_exactly(size);
+        if (payload.size() != size) {
+            break;
+        }
+        utils::crc32 crc;
+        crc.process(reinterpret_cast<const uint8_t*>(payload.get()), payload.size());
+        if (crc.get() != expected_crc) {
+            tlogger.debug("Stopping reading {} at a record with a bad checksum", path);
+            break;
+        }
+        co_await func(decode_record(std::move(payload)));
+    }
+}
+
+future<> read_trace_log(std::filesystem::path directory, noncopyable_function<future<>(trace_log_record)> func) {
+    if (!co_await file_exists(directory.native())) {
+        co_return;
+    }
+
+    struct segment {
+        parsed_segment_file_name key;
+        sstring name;
+    };
+    std::vector<segment> segments;
+    directory_lister lister(directory, lister::dir_entry_types::of<directory_entry_type::regular>());
+    co_await with_closeable(std::move(lister), [&segments] (directory_lister& lister) -> future<> {
+        while (auto de = co_await lister.get()) {
+            if (auto parsed = parse_segment_file_name(de->name)) {
+                segments.push_back(segment{*parsed, de->name});
+            }
+        }
+    });
+    std::ranges::sort(segments, [] (const segment& a, const segment& b) {
+        return std::tie(a.key.shard, a.key.sequence) < std::tie(b.key.shard, b.key.sequence);
+    });
+
+    for (auto& s : segments) {
+        co_await read_segment((directory / s.name.c_str()).native(), func);
+    }
+}
+
+using registry_default = class_registrator<i_tracing_backend_helper, trace_log_helper, tracing&>;
+static registry_default registrator_default("trace_log_helper");
+
+} // namespace tracing
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <variant>
+
+#include <seastar/core/file.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include "bytes_ostream.hh"
+#include "tracing/tracing.hh"
+
+namespace tracing {
+
+/// A tracing backend which appends the tracing records to local files rather
+/// than writing them to the system_traces tables.
+///
+/// Each shard appends the records of its sessions to its own segment files in
+/// the trace log directory, named "shard-<shard>-<sequence number>.log". A
+/// segment is closed once it grows above the segment size, and the oldest
+/// segments of the shard are removed when there are more than the configured
+/// number of them, so the trace log takes a bounded amount of disk space and
+/// keeps the most recent records.
+///
+/// The records are serialized into an in-memory buffer, which a single
+/// background fiber of the shard appends to the current segment, so writing
+/// a record doesn't wait for I/O and costs neither memtable space nor
+/// compaction. If the disk doesn't keep up and the buffer grows above the
+/// segment size, new records are dropped.
+///
+/// A segment starts with a header (\ref file_magic and the format version),
+/// followed by the records, each of them being:
+///
+///   u32 payload size | u32 crc32 of the payload | payload
+///
+/// The payload starts with a byte telling the kind of the record (a session
+/// or an event), the fields of it follow. Integers are little endian, strings
+/// and collections are prefixed by their u32 size. A segment being written
+/// may end with a partial record, reading the segment stops on it.
+///
+/// The records are read with \ref read_trace_log(), which is what the
+/// system.trace_log_sessions and system.trace_log_events virtual tables are
+/// built on.
+class trace_log_helper final : public i_tracing_backend_helper {
+public:
+    static constexpr std::string_view file_magic = "SCYLLATRACELOG";
+    static constexpr uint32_t format_version = 1;
+
+    struct config {
+        std::filesystem::path directory;
+        uint64_t segment_size = 32 << 20;
+        unsigned max_segments = 8;
+    };
+
+private:
+    struct stats {
+        uint64_t written_bytes = 0;
+        uint64_t dropped_records = 0;
+        uint64_t errors = 0;
+        uint64_t segments_removed = 0;
+    };
+
+    struct session_state : public backend_session_state_base {
+        int64_t last_nanos = 0;
+    };
+
+    cql3::query_processor* _qp = nullptr;
+    config _cfg;
+    // Serialized records, waiting to be written.
+    bytes_ostream _buffer;
+    // The current segment, _file_pos is the position of the first block which
+    // is not fully written, _tail holds what was written to it.
+    file _file;
+    uint64_t _file_pos = 0;
+    temporary_buffer<char> _tail;
+    // Sequence numbers of the segments of this shard, the oldest first.
+    std::deque<uint64_t> _segments;
+    bool _flushing = false;
+    seastar::gate _pending_writes;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+
+public:
+    trace_log_helper(tracing& tr);
+
+    // Reads the trace log configuration from the query processor's config
+    // and finds the segments left by the previous run.
+    virtual future<> start(cql3::query_processor& qp, service::migration_manager& mm) override;
+    virtual future<> shutdown() override;
+    virtual void write_records_bulk(records_bulk& bulk) override;
+    virtual std::unique_ptr<backend_session_state_base> allocate_session_state() const override;
+
+    static sstring segment_file_name(unsigned shard, uint64_t sequence);
+
+private:
+    void write_one_session_records(one_session_records& records);
+    void maybe_flush();
+    future<> flush();
+    future<> write_to_segment(const bytes_ostream& buf);
+    future<> open_next_segment();
+    future<> close_segment() noexcept;
+};
+
+/// A session record read from the trace log.
+struct trace_log_session {
+    utils::UUID session_id;
+    trace_type command = trace_type::NONE;
+    gms::inet_address client;
+    gms::inet_address coordinator;
+    unsigned shard = 0;
+    std::chrono::system_clock::time_point started_at;
+    std::chrono::microseconds duration{0};
+    sstring request;
+    uint64_t request_size = 0;
+    uint64_t response_size = 0;
+    sstring username;
+    std::map<sstring, sstring> parameters;
+    std::set<sstring> tables;
+};
+
+/// An event record read from the trace log.
+struct trace_log_event {
+    utils::UUID session_id;
+    utils::UUID event_id;
+    gms::inet_address source;
+    std::chrono::microseconds elapsed{0};
+    sstring thread;
+    span_id parent_id;
+    span_id my_span_id;
+    sstring activity;
+};
+
+using trace_log_record = std::variant<trace_log_session, trace_log_event>;
+
+/// Reads the records of all segments in the trace log directory, of all
+/// shards, the segments of each shard in the order they were written.
+/// A missing directory has no records.
+future<> read_trace_log(std::filesystem::path directory, noncopyable_function<future<>(trace_log_record)> func);
+
+} // namespace tracing
@@ -83,6 +83,14 @@ void trace_state::add_session_param(sstring_view key, sstring_view val) {
     _records->session_rec.parameters.emplace(std::move(key), std::move(val));
 }
 
+void trace_state::set_failed(sstring_view error) {
+    if (!log_slow_query() || !_local_tracing_ptr->slow_query_log_failures_enabled() || !is_in_state(state::foreground)) {
+        return;
+    }
+    _failed = true;
+    add_session_param("error", error);
+}
+
 void trace_state::set_user_timestamp(api::timestamp_type val) {
     _params_ptr->user_timestamp.emplace(val);
 }
@@ -104,11 +112,22 @@ void trace_state::add_prepared_query_options(const cql3::query_options& prepared
 }
 
 void trace_state::build_parameters_map() {
+    auto& params_map = _records->session_rec.parameters;
+
+    if (!_read_cost.empty()) {
+        _read_cost.for_each_counter([&params_map] (std::string_view name, uint64_t value) {
+            params_map.emplace(seastar::format("read_cost.{}", name), seastar::format("{:d}", value));
+        });
+    }
+
+    if (_dropped_events) {
+        params_map.emplace("dropped_events", seastar::format("{:d}", _dropped_events));
+    }
+
     if (!_params_ptr) {
         return;
     }
 
-    auto& params_map = _records->session_rec.parameters;
     params_values& vals = *_params_ptr;
 
     if (vals.batchlog_endpoints) {
@@ -206,6 +225,10 @@ void trace_state::stop_foreground_and_write() noexcept {
     }
 
     if (is_in_state(state::foreground)) {
+        if (!_read_cost.empty()) {
+            trace("Read cost: {}", _read_cost);
+        }
+
         auto e = elapsed();
         _records->do_log_slow_query = should_log_slow_query(e);
 
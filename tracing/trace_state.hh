@@ -37,6 +37,51 @@ extern logging::logger trace_state_logger;
 
 using prepared_checked_weak_ptr = seastar::checked_ptr<seastar::weak_ptr<const cql3::statements::prepared_statement>>;
 
+/// The resources used by the reads of a session on one shard, accounted by
+/// their reader_permit.
+///
+/// A primary session records the cost of the reads on its own shard in its
+/// parameters (and so in the slow query log too); every session, including
+/// the secondary ones of the replicas, also traces it as an event when it
+/// stops.
+struct read_cost {
+    uint64_t data_reads = 0;
+    uint64_t data_bytes_read = 0;
+    uint64_t index_reads = 0;
+    uint64_t index_bytes_read = 0;
+    uint64_t cache_partition_hits = 0;
+    uint64_t cache_partition_misses = 0;
+    uint64_t cache_row_hits = 0;
+    uint64_t cache_row_misses = 0;
+    // Time spent waiting on the reader concurrency semaphore: for admission,
+    // for memory and in the execution queue.
+    std::chrono::microseconds semaphore_wait_time{0};
+    // Time the reads were active and needed the CPU, i.e. didn't wait on I/O.
+    // It includes the time they waited for other tasks to yield, so it is an
+    // upper bound of the CPU time of the reads.
+    std::chrono::microseconds need_cpu_time{0};
+
+    template <typename Func>
+    void for_each_counter(Func&& func) const {
+        func("data_reads", data_reads);
+        func("data_bytes_read", data_bytes_read);
+        func("index_reads", index_reads);
+        func("index_bytes_read", index_bytes_read);
+        func("cache_partition_hits", cache_partition_hits);
+        func("cache_partition_misses", cache_partition_misses);
+        func("cache_row_hits", cache_row_hits);
+        func("cache_row_misses", cache_row_misses);
+        func("semaphore_wait_time_us", uint64_t(semaphore_wait_time.count()));
+        func("need_cpu_time_us", uint64_t(need_cpu_time.count()));
+    }
+
+    bool empty() const noexcept {
+        bool ret = true;
+        for_each_counter([&ret] (std::string_view, uint64_t v) { ret &= !v; });
+        return ret;
+    }
+};
+
 class trace_state final {
 public:
     // A primary session may be in 3 states:
@@ -71,6 +116,12 @@ class trace_state final {
     std::optional<uint64_t> _supplied_start_ts_us; // Parent's `_start`, as microseconds from POSIX epoch.
     std::chrono::microseconds _slow_query_threshold;
     state _state = state::inactive;
+    read_cost _read_cost;
+    // Set when the request failed and the failed queries are to be logged as slow ones.
+    bool _failed = false;
+    // The number of the oldest events dropped to keep the events of a not (yet)
+    // slow query within tracing::slow_query_max_events().
+    uint64_t _dropped_events = 0;
 
     struct params_values;
     struct params_values_deleter {
@@ -213,6 +264,10 @@ class trace_state final {
         return _records->events_recs.size();
     }
 
+    read_cost& get_read_cost() noexcept {
+        return _read_cost;
+    }
+
 private:
     /**
      * Stop a foreground state and write pending records to I/O.
@@ -222,7 +277,7 @@ class trace_state final {
     void stop_foreground_and_write() noexcept;
 
     bool should_log_slow_query(elapsed_clock::duration e) const {
-        return log_slow_query() && e > _slow_query_threshold;
+        return log_slow_query() && (e > _slow_query_threshold || _failed);
     }
 
     std::chrono::seconds ttl_by_type(trace_type type, std::chrono::seconds slow_query_ttl) noexcept {
@@ -374,6 +429,18 @@ class trace_state final {
      */
     void add_session_param(sstring_view key, sstring_view val);
 
+    /**
+     * Mark the request as failed.
+     *
+     * If the failed queries are to be logged (see tracing::set_slow_query_log_failures()),
+     * a slow query logging session of a failed request is recorded regardless of
+     * its duration, with the error stored in the params<string, string> map of the
+     * tracing session with an 'error' key.
+     *
+     * @param error the error message
+     */
+    void set_failed(sstring_view error);
+
     /**
      * Store a user provided timestamp.
      *
@@ -487,6 +554,7 @@ class trace_state final {
     friend void set_optional_serial_consistency_level(const trace_state_ptr& p, const std::optional<db::consistency_level>&val);
     friend void add_query(const trace_state_ptr& p, sstring_view val);
     friend void add_session_param(const trace_state_ptr& p, sstring_view key, sstring_view val);
+    friend void set_failed(const trace_state_ptr& p, sstring_view error);
     friend void set_user_timestamp(const trace_state_ptr& p, api::timestamp_type val);
     friend void add_prepared_statement(const trace_state_ptr& p, prepared_checked_weak_ptr& prepared);
     friend void set_username(const trace_state_ptr& p, const std::optional<auth::authenticated_user>& user);
@@ -555,10 +623,17 @@ inline void trace_state::trace_internal(std::string&& message) {
         //
         // We don't want to write records of a tracing session if we trace only
         // slow queries and the elapsed time is still below the slow query
-        // logging threshold.
-        if (_records->events_recs.size() >= tracing::exp_trace_events_per_session && (full_tracing() || should_log_slow_query(e))) {
-            _local_tracing_ptr->schedule_for_write(_records);
-            _local_tracing_ptr->write_maybe();
+        // logging threshold. Such a session keeps only its latest events, if
+        // their number is limited, so that the events of the fast queries (the
+        // majority) cost a bounded amount of memory before they are dropped.
+        if (full_tracing() || should_log_slow_query(e)) {
+            if (_records->events_recs.size() >= tracing::exp_trace_events_per_session) {
+                _local_tracing_ptr->schedule_for_write(_records);
+                _local_tracing_ptr->write_maybe();
+            }
+        } else if (auto max_events = _local_tracing_ptr->slow_query_max_events(); max_events && _records->events_recs.size() > max_events) {
+            _records->drop_oldest_event();
+            ++_dropped_events;
         }
     } catch (...) {
         // Bump up an error counter and ignore
@@ -633,6 +708,12 @@ inline void add_session_param(const trace_state_ptr& p, sstring_view key, sstrin
     }
 }
 
+inline void set_failed(const trace_state_ptr& p, sstring_view error) {
+    if (p) {
+        p->set_failed(std::move(error));
+    }
+}
+
 inline void set_user_timestamp(const trace_state_ptr& p, api::timestamp_type val) {
     if (p) {
         p->set_user_timestamp(val);
@@ -795,3 +876,15 @@ class global_trace_state_ptr {
     operator trace_state_ptr() const { return get(); }
 };
 }
+
+template <> struct fmt::formatter<tracing::read_cost> {
+    constexpr auto parse(format_parse_context& ctx) { return ctx.begin(); }
+    auto format(const tracing::read_cost& c, fmt::format_context& ctx) const {
+        auto out = ctx.out();
+        bool first = true;
+        c.for_each_counter([&] (std::string_view name, uint64_t value) {
+            out = fmt::format_to(out, "{}{}={}", std::exchange(first, false) ? "" : ", ", name, value);
+        });
+        return out;
+    }
+};
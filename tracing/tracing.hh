@@ -260,6 +260,14 @@ class one_session_records {
         session_rec.set_consumed();
     }
 
+    /**
+     * Drop the oldest event record and return its budget.
+     */
+    void drop_oldest_event() {
+        events_recs.pop_front();
+        --(*budget_ptr);
+    }
+
     /**
      * Should be called when a record is scheduled for write.
      * From that point till data_consumed() call all new records will be written
@@ -379,6 +387,13 @@ class tracing : public seastar::async_sharded_service<tracing> {
     // track tracing sessions only. This is used to implement lightweight
     // slow query tracing.
     bool _ignore_trace_events = false;
+    // If _slow_query_max_events is not zero, a slow query logging session
+    // keeps only that many of its latest events for as long as it's not known
+    // to be slow, so that the fast queries cost a bounded amount of memory.
+    uint32_t _slow_query_max_events = 0;
+    // If _slow_query_log_failures is enabled, the failed queries are logged as
+    // slow ones regardless of how long they took.
+    bool _slow_query_log_failures = false;
     std::unique_ptr<i_tracing_backend_helper> _tracing_backend_helper_ptr;
     sstring _thread_name;
     sstring _tracing_backend_helper_class_name;
@@ -581,6 +596,22 @@ class tracing : public seastar::async_sharded_service<tracing> {
         return _ignore_trace_events;
     }
 
+    void set_slow_query_max_events(uint32_t max_events) {
+        _slow_query_max_events = max_events;
+    }
+
+    uint32_t slow_query_max_events() const {
+        return _slow_query_max_events;
+    }
+
+    void set_slow_query_log_failures(bool enable = true) {
+        _slow_query_log_failures = enable;
+    }
+
+    bool slow_query_log_failures_enabled() const {
+        return _slow_query_log_failures;
+    }
+
     /**
      * Set the slow query threshold
      *
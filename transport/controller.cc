@@ -19,6 +19,8 @@
 #include "gms/gossiper.hh"
 #include "utils/log.hh"
 #include "cql3/query_processor.hh"
+#include "service/storage_proxy.hh"
+#include "replica/database.hh"
 
 using namespace seastar;
 
@@ -237,6 +239,7 @@ future<> controller::do_start_server() {
               .shard_aware_transport_port_ssl = shard_aware_transport_port_ssl,
               .allow_shard_aware_drivers = cfg.enable_shard_aware_drivers(),
               .bounce_request_smp_service_group = bounce_request_smp_service_group,
+              .batch_scheduling_group = _qp.local().proxy().local_db().get_batch_statement_scheduling_group(),
             };
         });
 
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <chrono>
+
+namespace cql_transport {
+
+/// Decides when to shed requests based on how long they wait before being
+/// processed, in the spirit of CoDel: a queue which is momentarily long is
+/// fine, but a delay which stays above the target for a whole interval means
+/// requests arrive faster than they can be served, and will only time out
+/// after having consumed resources.
+///
+/// The controller is fed the queueing delay of each request when its
+/// processing starts. It starts shedding once all delays seen during an
+/// interval were above the target, and stops once a request waited less
+/// than the target, or no request was seen above the target for an interval
+/// (e.g. because the queue drained while shedding).
+class queueing_delay_controller {
+public:
+    using clock = std::chrono::steady_clock;
+private:
+    clock::duration _target;
+    clock::duration _interval;
+    // When the delay will have stayed above the target for an interval,
+    // unset if the last delay was below it.
+    clock::time_point _above_target_until{};
+    // Shedding stops at this time, unless extended by delays above target.
+    clock::time_point _shed_until{};
+    bool _shedding = false;
+public:
+    explicit queueing_delay_controller(clock::duration target, clock::duration interval = std::chrono::milliseconds(100))
+        : _target(target)
+        , _interval(interval)
+    { }
+
+    void set_target(clock::duration target) noexcept {
+        _target = target;
+        if (_target == clock::duration::zero()) {
+            reset();
+        }
+    }
+
+    void on_request_started(clock::duration delay, clock::time_point now) noexcept {
+        if (_target == clock::duration::zero() || delay < _target) {
+            reset();
+            return;
+        }
+        if (_above_target_until == clock::time_point{}) {
+            _above_target_until = now + _interval;
+        } else if (now >= _above_target_until) {
+            _shedding = true;
+        }
+        if (_shedding) {
+            _shed_until = now + _interval;
+        }
+    }
+
+    bool should_shed(clock::time_point now) noexcept {
+        if (_shedding && now >= _shed_until) {
+            reset();
+        }
+        return _shedding;
+    }
+
+private:
+    void reset() noexcept {
+        _above_target_until = {};
+        _shedding = false;
+    }
+};
+
+} // namespace cql_transport
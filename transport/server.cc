@@ -242,6 +242,8 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
     , _config(std::move(config))
     , _max_request_size(_config.max_request_size)
     , _max_concurrent_requests(db_cfg.max_concurrent_requests_per_shard)
+    , _queueing_delay_target_ms(db_cfg.cql_queueing_delay_target_ms)
+    , _queueing_delay_controller(std::chrono::milliseconds(_queueing_delay_target_ms()))
     , _cql_duplicate_bind_variable_names_refer_to_same_variable(db_cfg.cql_duplicate_bind_variable_names_refer_to_same_variable)
     , _memory_available(ml.get_semaphore())
     , _notifier(std::make_unique<event_notifier>(*this))
@@ -278,8 +280,11 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
                             seastar::format("Holds an incrementing counter with the requests that ever blocked due to reaching the memory quota limit ({}B). "
                                             "The first derivative of this value shows how often we block due to memory exhaustion in the \"CQL transport\" component.", _max_request_size))),
         sm::make_counter("requests_shed", _stats.requests_shed,
-                        sm::description("Holds an incrementing counter with the requests that were shed due to overload (threshold configured via max_concurrent_requests_per_shard). "
+                        sm::description("Holds an incrementing counter with the requests that were shed due to overload (thresholds configured via max_concurrent_requests_per_shard and cql_queueing_delay_target_ms). "
                                             "The first derivative of this value shows how often we shed requests due to overload in the \"CQL transport\" component.")),
+        sm::make_counter("requests_bounced", _stats.requests_bounced,
+                        sm::description("Counts the requests which were forwarded to another shard to be executed, e.g. lightweight transactions on a partition owned by another shard. "
+                                            "Shard-aware drivers connecting to the shard-aware port keep most of these on the shard they were received on.")),
         sm::make_gauge("requests_memory_available", [this] { return _memory_available.current(); },
                         sm::description(
                             seastar::format("Holds the amount of available memory for admitting new requests (max is {}B)."
@@ -293,13 +298,12 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
 
     sm::label cql_error_label("type");
     for (const auto& e : exceptions::exception_map()) {
-        _stats.errors.insert({e.first, 0});
         auto label_instance = cql_error_label(e.second);
 
         transport_metrics.emplace_back(
             sm::make_counter("cql_errors_total", sm::description("Counts the total number of returned CQL errors."),
                         {label_instance},
-                        [this, code = e.first] { auto it = _stats.errors.find(code); return it != _stats.errors.end() ? it->second : 0; }).set_skip_when_empty()
+                        [this, idx = transport_stats::error_index(e.first)] { return _stats.errors[idx]; }).set_skip_when_empty()
         );
     }
 
@@ -524,47 +528,47 @@ future<foreign_ptr<std::unique_ptr<cql_server::response>>>
         },  utils::result_catch<exceptions::unavailable_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in unavailable_error, stream {}, code {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.code(), ex.what());
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_unavailable_error(stream, ex.code(), ex.what(), ex.consistency, ex.required, ex.alive, trace_state);
         }), utils::result_catch<exceptions::read_timeout_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in read_timeout_error, stream {}, code {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.code(), ex.what());
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_read_timeout_error(stream, ex.code(), ex.what(), ex.consistency, ex.received, ex.block_for, ex.data_present, trace_state);
         }), utils::result_catch<exceptions::read_failure_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in read_failure_error, stream {}, code {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.code(), ex.what());
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_read_failure_error(stream, ex.code(), ex.what(), ex.consistency, ex.received, ex.failures, ex.block_for, ex.data_present, trace_state);
         }), utils::result_catch<exceptions::mutation_write_timeout_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in mutation_write_timeout_error, stream {}, code {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.code(), ex.what());
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_mutation_write_timeout_error(stream, ex.code(), ex.what(), ex.consistency, ex.received, ex.block_for, ex.type, trace_state);
         }), utils::result_catch<exceptions::mutation_write_failure_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in mutation_write_failure_error, stream {}, code {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.code(), ex.what());
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_mutation_write_failure_error(stream, ex.code(), ex.what(), ex.consistency, ex.received, ex.failures, ex.block_for, ex.type, trace_state);
         }), utils::result_catch<exceptions::already_exists_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in already_exists_error, stream {}, code {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.code(), ex.what());
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_already_exists_error(stream, ex.code(), ex.what(), ex.ks_name, ex.cf_name, trace_state);
         }), utils::result_catch<exceptions::prepared_query_not_found_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in unprepared_error, stream {}, code {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.code(), ex.what());
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_unprepared_error(stream, ex.code(), ex.what(), ex.id, trace_state);
         }), utils::result_catch<exceptions::function_execution_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in function_failure_error, stream {}, code {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.code(), ex.what());
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_function_failure_error(stream, ex.code(), ex.what(), ex.ks_name, ex.func_name, ex.args, trace_state);
         }), utils::result_catch<exceptions::rate_limit_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in rate_limit_error, stream {}, code {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.code(), ex.what());
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_rate_limit_error(stream, ex.code(), ex.what(), ex.op_type, ex.rejected_by_coordinator, trace_state, client_state);
         }), utils::result_catch<exceptions::cassandra_exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in cassandra_error, stream {}, code {}, message [{}]",
@@ -576,12 +580,12 @@ future<foreign_ptr<std::unique_ptr<cql_server::response>>>
             // additional information, such as invalid_request_exception.
             // TODO: consider listing those types explicitly, instead of the
             // catch-all type cassandra_exception.
-            try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+            _server._stats.count_error(ex.code());
             return make_error(stream, ex.code(), ex.what(), trace_state);
         }), utils::result_catch<std::exception>([&] (const auto& ex) {
             clogger.debug("{}: request resulted in error, stream {}, message [{}]",
                 _client_state.get_remote_address(), stream, ex.what());
-            try { ++_server._stats.errors[exceptions::exception_code::SERVER_ERROR]; } catch(...) {}
+            _server._stats.count_error(exceptions::exception_code::SERVER_ERROR);
             sstring msg = ex.what();
             try {
                 std::rethrow_if_nested(ex);
@@ -594,7 +598,7 @@ future<foreign_ptr<std::unique_ptr<cql_server::response>>>
         }), utils::result_catch_dots([&] () {
             clogger.debug("{}: request resulted in unknown error, stream {}",
                 _client_state.get_remote_address(), stream);
-            try { ++_server._stats.errors[exceptions::exception_code::SERVER_ERROR]; } catch(...) {}
+            _server._stats.count_error(exceptions::exception_code::SERVER_ERROR);
             return make_error(stream, exceptions::exception_code::SERVER_ERROR, "unknown error", trace_state);
         })));
     });
@@ -651,15 +655,15 @@ void cql_server::connection::handle_error(future<>&& f) {
         f.get();
     } catch (const exceptions::cassandra_exception& ex) {
         clogger.debug("{}: connection error, code {}, message [{}]", _client_state.get_remote_address(), ex.code(), ex.what());
-        try { ++_server._stats.errors[ex.code()]; } catch(...) {}
+        _server._stats.count_error(ex.code());
         write_response(make_error(0, ex.code(), ex.what(), tracing::trace_state_ptr()));
     } catch (std::exception& ex) {
         clogger.debug("{}: connection error, message [{}]", _client_state.get_remote_address(), ex.what());
-        try { ++_server._stats.errors[exceptions::exception_code::SERVER_ERROR]; } catch(...) {}
+        _server._stats.count_error(exceptions::exception_code::SERVER_ERROR);
         write_response(make_error(0, exceptions::exception_code::SERVER_ERROR, ex.what(), tracing::trace_state_ptr()));
     } catch (...) {
         clogger.debug("{}: connection error, unknown error", _client_state.get_remote_address());
-        try { ++_server._stats.errors[exceptions::exception_code::SERVER_ERROR]; } catch(...) {}
+        _server._stats.count_error(exceptions::exception_code::SERVER_ERROR);
         write_response(make_error(0, exceptions::exception_code::SERVER_ERROR, "unknown error", tracing::trace_state_ptr()));
     }
 }
@@ -673,8 +677,19 @@ future<> cql_server::connection::process_request() {
         }
 
         auto& f = *maybe_frame;
+        const auto received_at = queueing_delay_controller::clock::now();
 
         const bool allow_shedding = _client_state.get_workload_type() == service::client_state::workload_type::interactive;
+        if (allow_shedding && _server._queueing_delay_controller.should_shed(received_at)) {
+            ++_server._stats.requests_shed;
+            return _read_buf.skip(f.length).then([this, stream = f.stream] {
+                const char* message = "request shed due to queueing delay above target (configured via cql_queueing_delay_target_ms)";
+                clogger.debug("{}: {}, stream {}", _client_state.get_remote_address(), message, uint16_t(stream));
+                write_response(make_error(stream, exceptions::exception_code::OVERLOADED,
+                    message, tracing::trace_state_ptr()));
+                return make_ready_future<>();
+            });
+        }
         if (allow_shedding && _shed_incoming_requests) {
             ++_server._stats.requests_shed;
             return _read_buf.skip(f.length).then([this, stream = f.stream] {
@@ -744,14 +759,18 @@ future<> cql_server::connection::process_request() {
             ++_server._stats.requests_blocked_memory;
         }
 
-        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested] (auto mem_permit_fut) {
+        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested, received_at] (auto mem_permit_fut) {
           if (mem_permit_fut.failed()) {
               // Ignore semaphore errors - they are expected if load shedding took place
               mem_permit_fut.ignore_ready_future();
               return make_ready_future<>();
           }
           semaphore_units<> mem_permit = mem_permit_fut.get();
-          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
+          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, received_at, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
+            auto& controller = _server._queueing_delay_controller;
+            controller.set_target(std::chrono::milliseconds(_server._queueing_delay_target_ms()));
+            const auto started_at = queueing_delay_controller::clock::now();
+            controller.on_request_started(started_at - received_at, started_at);
 
             ++_server._stats.requests_served;
             ++_server._stats.requests_serving;
@@ -772,9 +791,17 @@ future<> cql_server::connection::process_request() {
                     op == uint8_t (cql_binary_opcode::EXECUTE) ||
                     op == uint8_t(cql_binary_opcode::BATCH));
 
-            future<foreign_ptr<std::unique_ptr<cql_server::response>>> request_process_future = should_paralelize ?
-                    _process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit) :
-                    process_request_one(istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit);
+            auto process = [this, istream, op, stream, tracing_requested, mem_permit, should_paralelize] () mutable {
+                return should_paralelize ?
+                        _process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit) :
+                        process_request_one(istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit);
+            };
+            // Batch workloads run in their own scheduling group, so their CPU and
+            // disk bandwidth can be capped with its shares.
+            const bool is_batch = _client_state.get_workload_type() == service::client_state::workload_type::batch;
+            future<foreign_ptr<std::unique_ptr<cql_server::response>>> request_process_future = is_batch && _server._config.batch_scheduling_group ?
+                    with_scheduling_group(*_server._config.batch_scheduling_group, std::move(process)) :
+                    process();
 
             future<> request_response_future = request_process_future.then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave), stream] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
                 try {
@@ -1019,6 +1046,7 @@ cql_server::connection::process(uint16_t stream, request_reader in, service::cli
     while (auto* bounce_msg = std::get_if<result_with_bounce_to_shard>(&msg)) {
         auto shard = (*bounce_msg)->move_to_shard().value();
         auto&& cached_vals = (*bounce_msg)->take_cached_pk_function_calls();
+        ++_server._stats.requests_bounced;
         msg = co_await process_on_shard(shard, stream, is, client_state, trace_state, dialect, std::move(cached_vals), process_fn);
     }
     co_return std::get<cql_server::result_with_foreign_response_ptr>(std::move(msg));
@@ -1306,9 +1334,16 @@ cql_server::connection::process_register(uint16_t stream, request_reader in, ser
     return make_ready_future<std::unique_ptr<cql_server::response>>(make_ready(stream, std::move(trace_state)));
 }
 
+// All ERROR responses are built here, so that the tracing session of the
+// request learns that it failed.
+static std::unique_ptr<cql_server::response> make_error_response(int16_t stream, const sstring& msg, const tracing::trace_state_ptr& tr_state) {
+    tracing::set_failed(tr_state, msg);
+    return std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+}
+
 std::unique_ptr<cql_server::response> cql_server::connection::make_unavailable_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t required, int32_t alive, const tracing::trace_state_ptr& tr_state) const
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1319,7 +1354,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_unavailable_e
 
 std::unique_ptr<cql_server::response> cql_server::connection::make_read_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, bool data_present, const tracing::trace_state_ptr& tr_state) const
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1334,7 +1369,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_read_failure_
     if (_version < 4) {
         return make_read_timeout_error(stream, exceptions::exception_code::READ_TIMEOUT, std::move(msg), cl, received, blockfor, data_present, tr_state);
     }
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1347,7 +1382,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_read_failure_
 
 std::unique_ptr<cql_server::response> cql_server::connection::make_mutation_write_timeout_error(int16_t stream, exceptions::exception_code err, sstring msg, db::consistency_level cl, int32_t received, int32_t blockfor, db::write_type type, const tracing::trace_state_ptr& tr_state) const
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1362,7 +1397,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_mutation_writ
     if (_version < 4) {
         return make_mutation_write_timeout_error(stream, exceptions::exception_code::WRITE_TIMEOUT, std::move(msg), cl, received, blockfor, type, tr_state);
     }
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_consistency(cl);
@@ -1375,7 +1410,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_mutation_writ
 
 std::unique_ptr<cql_server::response> cql_server::connection::make_already_exists_error(int16_t stream, exceptions::exception_code err, sstring msg, sstring ks_name, sstring cf_name, const tracing::trace_state_ptr& tr_state) const
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_string(ks_name);
@@ -1385,7 +1420,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_already_exist
 
 std::unique_ptr<cql_server::response> cql_server::connection::make_unprepared_error(int16_t stream, exceptions::exception_code err, sstring msg, bytes id, const tracing::trace_state_ptr& tr_state) const
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_short_bytes(id);
@@ -1394,7 +1429,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_unprepared_er
 
 std::unique_ptr<cql_server::response> cql_server::connection::make_function_failure_error(int16_t stream, exceptions::exception_code err, sstring msg, sstring ks_name, sstring func_name, std::vector<sstring> args, const tracing::trace_state_ptr& tr_state) const
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_string(ks_name);
@@ -1409,7 +1444,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_rate_limit_er
         return make_error(stream, exceptions::exception_code::CONFIG_ERROR, std::move(msg), tr_state);
     }
 
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     response->write_byte(static_cast<uint8_t>(op_type));
@@ -1419,7 +1454,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_rate_limit_er
 
 std::unique_ptr<cql_server::response> cql_server::connection::make_error(int16_t stream, exceptions::exception_code err, sstring msg, const tracing::trace_state_ptr& tr_state) const
 {
-    auto response = std::make_unique<cql_server::response>(stream, cql_binary_opcode::ERROR, tr_state);
+    auto response = make_error_response(stream, msg, tr_state);
     response->write_int(static_cast<int32_t>(err));
     response->write_string(msg);
     return response;
@@ -17,6 +17,8 @@
 #include "service/qos/qos_configuration_change_subscriber.hh"
 #include "timeout_config.hh"
 #include <seastar/core/semaphore.hh>
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <type_traits>
 #include <boost/intrusive/list.hpp>
@@ -32,6 +34,7 @@
 #include "cql3/query_options.hh"
 #include "cql3/dialect.hh"
 #include "transport/messages/result_message.hh"
+#include "transport/queueing_delay_controller.hh"
 #include "utils/chunked_vector.hh"
 #include "exceptions/coordinator_result.hh"
 #include "db/operation_type.hh"
@@ -115,6 +118,8 @@ struct cql_server_config {
     std::optional<uint16_t> shard_aware_transport_port_ssl;
     bool allow_shard_aware_drivers = true;
     smp_service_group bounce_request_smp_service_group = default_smp_service_group();
+    // Requests of sessions with the batch workload type run in this group, if set.
+    std::optional<scheduling_group> batch_scheduling_group;
 };
 
 /**
@@ -151,8 +156,46 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         uint32_t requests_serving = 0;
         uint64_t requests_blocked_memory = 0;
         uint64_t requests_shed = 0;
+        uint64_t requests_bounced = 0;
+
+        // The error codes counted separately, sorted. Errors with other codes
+        // are counted in the last element of errors, which isn't exported.
+        static constexpr exceptions::exception_code error_codes[] = {
+            exceptions::exception_code::SERVER_ERROR,
+            exceptions::exception_code::PROTOCOL_ERROR,
+            exceptions::exception_code::BAD_CREDENTIALS,
+            exceptions::exception_code::UNAVAILABLE,
+            exceptions::exception_code::OVERLOADED,
+            exceptions::exception_code::IS_BOOTSTRAPPING,
+            exceptions::exception_code::TRUNCATE_ERROR,
+            exceptions::exception_code::WRITE_TIMEOUT,
+            exceptions::exception_code::READ_TIMEOUT,
+            exceptions::exception_code::READ_FAILURE,
+            exceptions::exception_code::FUNCTION_FAILURE,
+            exceptions::exception_code::WRITE_FAILURE,
+            exceptions::exception_code::CDC_WRITE_FAILURE,
+            exceptions::exception_code::SYNTAX_ERROR,
+            exceptions::exception_code::UNAUTHORIZED,
+            exceptions::exception_code::INVALID,
+            exceptions::exception_code::CONFIG_ERROR,
+            exceptions::exception_code::ALREADY_EXISTS,
+            exceptions::exception_code::UNPREPARED,
+            exceptions::exception_code::RATE_LIMIT_ERROR,
+        };
+        static_assert(std::ranges::is_sorted(error_codes));
+
+        // Counting an error neither hashes nor allocates, unlike a map keyed by
+        // the error code.
+        std::array<uint64_t, std::size(error_codes) + 1> errors{};
+
+        static size_t error_index(exceptions::exception_code code) noexcept {
+            auto it = std::ranges::lower_bound(error_codes, code);
+            return it != std::end(error_codes) && *it == code ? it - std::begin(error_codes) : std::size(error_codes);
+        }
 
-        std::unordered_map<exceptions::exception_code, uint64_t> errors;
+        void count_error(exceptions::exception_code code) noexcept {
+            ++errors[error_index(code)];
+        }
     };
 private:
     class event_notifier;
@@ -163,6 +206,10 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     cql_server_config _config;
     size_t _max_request_size;
     utils::updateable_value<uint32_t> _max_concurrent_requests;
+    utils::updateable_value<uint32_t> _queueing_delay_target_ms;
+    // Sheds requests of interactive workloads while the time they wait for
+    // memory and for their frame stays above the target.
+    queueing_delay_controller _queueing_delay_controller;
     utils::updateable_value<bool> _cql_duplicate_bind_variable_names_refer_to_same_variable;
     semaphore& _memory_available;
     seastar::metrics::metric_groups _metrics;
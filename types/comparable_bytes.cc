@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "types/comparable_bytes.hh"
+
+#include "bytes_ostream.hh"
+#include "utils/log.hh"
+
+namespace comparable_bytes {
+
+static logging::logger cblogger("comparable_bytes");
+
+namespace {
+
+enum class marker : uint8_t {
+    before_all_prefixed = 0x20,
+    equal = 0x38,
+    empty_component = 0x3f,
+    component = 0x40,
+    empty_reversed_component = 0x41,
+    after_all_prefixed = 0x60,
+};
+
+enum class encoding {
+    unsupported,
+    // Compared as unsigned big endian integers or fixed-size blobs.
+    fixed_unsigned,
+    // Compared as signed big endian integers.
+    fixed_signed,
+    boolean,
+    // Compared as unsigned strings of any length.
+    variable,
+};
+
+encoding encoding_of(const abstract_type& type) {
+    switch (type.get_kind()) {
+    case abstract_type::kind::boolean:
+        return encoding::boolean;
+    case abstract_type::kind::byte:
+    case abstract_type::kind::short_kind:
+    case abstract_type::kind::int32:
+    case abstract_type::kind::long_kind:
+    case abstract_type::kind::timestamp:
+    case abstract_type::kind::time:
+        return encoding::fixed_signed;
+    case abstract_type::kind::simple_date:
+    case abstract_type::kind::date:
+        return encoding::fixed_unsigned;
+    case abstract_type::kind::ascii:
+    case abstract_type::kind::utf8:
+    case abstract_type::kind::bytes:
+    case abstract_type::kind::inet:
+        return encoding::variable;
+    default:
+        return encoding::unsupported;
+    }
+}
+
+class encoder {
+    bytes_ostream& _out;
+    bool _reversed = false;
+
+    void put(uint8_t b) {
+        int8_t v = _reversed ? ~b : b;
+        _out.write(bytes_view(&v, 1));
+    }
+    void put_marker(marker m) {
+        int8_t v = int8_t(m);
+        _out.write(bytes_view(&v, 1));
+    }
+    void put_fixed(managed_bytes_view v, bool flip_sign) {
+        bool first = true;
+        for (bytes_view frag : fragment_range(v)) {
+            for (auto b : frag) {
+                put(first && flip_sign ? uint8_t(b) ^ 0x80 : uint8_t(b));
+                first = false;
+            }
+        }
+    }
+    void put_variable(managed_bytes_view v) {
+        for (bytes_view frag : fragment_range(v)) {
+            for (auto b : frag) {
+                put(uint8_t(b));
+                if (b == 0) {
+                    put(0xff);
+                }
+            }
+        }
+        put(0);
+    }
+public:
+    explicit encoder(bytes_ostream& out) : _out(out) {}
+
+    void put_component(const abstract_type& type, managed_bytes_view v) {
+        const abstract_type* t = &type;
+        _reversed = t->is_reversed();
+        if (_reversed) {
+            t = static_cast<const reversed_type_impl&>(*t).underlying_type().get();
+        }
+        if (v.empty()) {
+            put_marker(_reversed ? marker::empty_reversed_component : marker::empty_component);
+            return;
+        }
+        put_marker(marker::component);
+        switch (encoding_of(*t)) {
+        case encoding::boolean:
+            put(v.front() != 0);
+            break;
+        case encoding::fixed_signed:
+            put_fixed(v, true);
+            break;
+        case encoding::fixed_unsigned:
+            put_fixed(v, false);
+            break;
+        case encoding::variable:
+            put_variable(v);
+            break;
+        case encoding::unsupported:
+            on_internal_error(cblogger, format("comparable_bytes: unsupported type {}", t->name()));
+        }
+    }
+
+    void put_end(int weight) {
+        put_marker(weight < 0 ? marker::before_all_prefixed : weight > 0 ? marker::after_all_prefixed : marker::equal);
+    }
+};
+
+template <typename CompoundType>
+void encode(const CompoundType& type, managed_bytes_view key, int weight, bytes_ostream& out) {
+    encoder enc(out);
+    auto t = type.types().begin();
+    for (auto&& component : type.components(key)) {
+        enc.put_component(**t++, component);
+    }
+    enc.put_end(weight);
+}
+
+} // anonymous namespace
+
+bool is_supported(const abstract_type& type) {
+    if (type.is_reversed()) {
+        return is_supported(*static_cast<const reversed_type_impl&>(type).underlying_type());
+    }
+    return encoding_of(type) != encoding::unsupported;
+}
+
+bool is_supported(const std::vector<data_type>& types) {
+    return std::ranges::all_of(types, [] (const data_type& t) { return is_supported(*t); });
+}
+
+void encode_clustering_prefix(const compound_type<allow_prefixes::yes>& type, managed_bytes_view prefix, int weight, bytes_ostream& out) {
+    encode(type, prefix, weight, out);
+}
+
+managed_bytes encode_clustering_prefix(const compound_type<allow_prefixes::yes>& type, managed_bytes_view prefix, int weight) {
+    bytes_ostream out;
+    encode_clustering_prefix(type, prefix, weight, out);
+    return std::move(out).to_managed_bytes();
+}
+
+void encode_partition_key(const compound_type<allow_prefixes::no>& type, managed_bytes_view key, bytes_ostream& out) {
+    encode(type, key, 0, out);
+}
+
+managed_bytes encode_partition_key(const compound_type<allow_prefixes::no>& type, managed_bytes_view key) {
+    bytes_ostream out;
+    encode_partition_key(type, key, out);
+    return std::move(out).to_managed_bytes();
+}
+
+} // namespace comparable_bytes
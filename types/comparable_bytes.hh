@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "compound.hh"
+#include "utils/managed_bytes.hh"
+
+class bytes_ostream;
+
+/// Byte-comparable encoding of keys.
+///
+/// Encodes a key, or a clustering key prefix with a bound weight, into a
+/// string of bytes whose unsigned lexicographical order (\ref compare_unsigned,
+/// i.e. memcmp()) is the same as the order of the keys in the schema:
+///
+///   compare_unsigned(encode_clustering_prefix(t, p1, w1), encode_clustering_prefix(t, p2, w2))
+///       == bound_view::tri_compare(s)(p1, w1, p2, w2)
+///
+/// so that the encoding of a key can be computed once and compared many times
+/// without type-aware per-component comparisons.
+///
+/// Each component is preceded by a separator byte, which is lower for an
+/// empty value than for any other value (higher in a reversed component), and
+/// the key is followed by a terminator byte, which encodes the bound weight:
+///
+///   before_all_prefixed 0x20 < equal 0x38 < separators 0x3f-0x41 < after_all_prefixed 0x60
+///
+/// Fixed-size integers are encoded big endian with the sign bit flipped, and
+/// strings and blobs have their 0x00 bytes escaped as 0x00 0xff and are
+/// terminated by 0x00. The encoding of a reversed component is the
+/// complement of the encoding of the underlying type.
+///
+/// Only some types can be encoded (see \ref is_supported()). Types whose order
+/// isn't a simple function of their bytes (e.g. timeuuid, decimal, floating
+/// point and collections) aren't, and their keys should be compared with the
+/// types as usual.
+///
+/// The encoding is not stable across versions and must not be persisted.
+namespace comparable_bytes {
+
+bool is_supported(const abstract_type& type);
+
+// Whether keys with components of the given types can be encoded.
+bool is_supported(const std::vector<data_type>& types);
+
+// Appends the encoding of a clustering key prefix, given in the serialized
+// form of the prefix type, followed by the bound weight (-1, 0 or 1, see
+// bound_weight), to out.
+// All types of the prefix type must be supported.
+void encode_clustering_prefix(const compound_type<allow_prefixes::yes>& type, managed_bytes_view prefix, int weight, bytes_ostream& out);
+
+managed_bytes encode_clustering_prefix(const compound_type<allow_prefixes::yes>& type, managed_bytes_view prefix, int weight);
+
+// Appends the encoding of a partition key, given in the serialized form of
+// the partition key type, to out. The encodings are ordered the same as the
+// keys by partition_key::tri_compare, i.e. by value rather than by token.
+// All types of the key type must be supported.
+void encode_partition_key(const compound_type<allow_prefixes::no>& type, managed_bytes_view key, bytes_ostream& out);
+
+managed_bytes encode_partition_key(const compound_type<allow_prefixes::no>& type, managed_bytes_view key);
+
+} // namespace comparable_bytes
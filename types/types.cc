@@ -2462,6 +2462,21 @@ struct compare_visitor {
 };
 }
 
+template <typename Type>
+static std::strong_ordering compare_as(const abstract_type& t, managed_bytes_view v1, managed_bytes_view v2) {
+    try {
+        return compare_visitor{v1, v2}(static_cast<const Type&>(t));
+    } catch (const marshal_exception&) {
+        on_types_internal_error(std::current_exception());
+    }
+}
+
+value_comparator::value_comparator(const abstract_type& type)
+    : _type(&type.without_reversed())
+    , _compare(visit(*_type, [] <typename Type> (const Type&) -> compare_fn { return &compare_as<Type>; }))
+    , _reversed(type.is_reversed())
+{ }
+
 std::strong_ordering abstract_type::compare(bytes_view v1, bytes_view v2) const {
     return compare(managed_bytes_view(v1), managed_bytes_view(v2));
 }
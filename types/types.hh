@@ -575,6 +575,31 @@ std::strong_ordering tri_compare(data_type t, managed_bytes_view e1, managed_byt
     return t->compare(e1, e2);
 }
 
+// Compares serialized values of a type, like abstract_type::compare().
+//
+// The comparison is specialized for the type once, when the comparator is
+// created, so comparing many values of the same type (like the components of
+// keys) doesn't dispatch on the type of each of them.
+// The type must outlive the comparator.
+class value_comparator {
+    using compare_fn = std::strong_ordering (*)(const abstract_type&, managed_bytes_view, managed_bytes_view);
+
+    const abstract_type* _type;
+    compare_fn _compare;
+    bool _reversed;
+public:
+    explicit value_comparator(const abstract_type& type);
+
+    std::strong_ordering operator()(managed_bytes_view v1, managed_bytes_view v2) const {
+        return _reversed ? _compare(*_type, v2, v1) : _compare(*_type, v1, v2);
+    }
+};
+
+// A type-aware comparator (see utils/lexicographical_compare.hh) for value_comparator.
+inline constexpr auto tri_compare_with = [] (const value_comparator& cmp, managed_bytes_view v1, managed_bytes_view v2) {
+    return cmp(v1, v2);
+};
+
 inline
 std::strong_ordering
 tri_compare_opt(data_type t, managed_bytes_view_opt v1, managed_bytes_view_opt v2) {
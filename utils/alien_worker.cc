@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <seastar/core/posix.hh>
+
+#include "utils/alien_worker.hh"
+
+namespace utils {
+
+alien_worker::alien_worker(std::string name, int niceness, logging::logger& log)
+    : _thread([this, name = std::move(name), niceness, &log] { run(name, niceness, log); })
+{ }
+
+alien_worker::~alien_worker() {
+    {
+        std::unique_lock lock(_mut);
+        _stopped = true;
+    }
+    _cv.notify_one();
+    _thread.join();
+}
+
+void alien_worker::run(const std::string& name, int niceness, logging::logger& log) noexcept {
+    // Signals are for the reactors to handle.
+    sigset_t mask;
+    sigfillset(&mask);
+    ::pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+    // Thread names are limited to 15 characters.
+    ::pthread_setname_np(::pthread_self(), name.substr(0, 15).c_str());
+
+    errno = 0;
+    if (nice(niceness) == -1 && errno != 0) {
+        log.warn("Unable to renice the {} thread (system error number {}); the thread will compete with the reactor. Try adding CAP_SYS_NICE", name, errno);
+    }
+
+    for (;;) {
+        std::unique_lock lock(_mut);
+        _cv.wait(lock, [this] { return _stopped || !_pending.empty(); });
+        if (_pending.empty()) {
+            break;
+        }
+        auto work = std::move(_pending.front());
+        _pending.pop();
+        lock.unlock();
+        work();
+    }
+}
+
+void alien_worker::push(noncopyable_function<void() noexcept> work) {
+    {
+        std::unique_lock lock(_mut);
+        _pending.push(std::move(work));
+    }
+    _cv.notify_one();
+}
+
+} // namespace utils
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include <seastar/core/alien.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include "seastarx.hh"
+#include "utils/log.hh"
+
+namespace utils {
+
+/// A thread outside of the reactors, running work which would stall the shard
+/// for too long, like CPU-heavy hashing in a third-party library which can't
+/// be preempted.
+///
+/// The work is run in submission order, on a thread running with a lower
+/// priority, so that it competes for the CPU with the reactors as little as
+/// possible. Results are delivered to the submitting shard.
+class alien_worker {
+    std::mutex _mut;
+    std::condition_variable _cv;
+    std::queue<noncopyable_function<void() noexcept>> _pending;
+    bool _stopped = false;
+    std::thread _thread;
+
+    void run(const std::string& name, int niceness, logging::logger& log) noexcept;
+    void push(noncopyable_function<void() noexcept> work);
+public:
+    /// \param niceness is the nice value added to the thread's, see nice(2).
+    alien_worker(std::string name, int niceness, logging::logger& log);
+    /// Runs the pending work, then joins the thread.
+    ~alien_worker();
+
+    alien_worker(const alien_worker&) = delete;
+    alien_worker& operator=(const alien_worker&) = delete;
+
+    /// Runs func() on the worker thread and resolves with its result on the
+    /// calling shard.
+    ///
+    /// func runs outside of the reactor, so it must not use seastar APIs, nor
+    /// touch state which the shard may modify before the returned future is
+    /// resolved. Objects it refers to must outlive the future.
+    template <typename Func>
+    requires std::is_nothrow_move_constructible_v<std::invoke_result_t<Func>>
+    future<std::invoke_result_t<Func>> submit(Func func) {
+        using result_type = std::invoke_result_t<Func>;
+        promise<result_type> pr;
+        // The promise is only touched on this shard, where it is resolved by
+        // a message sent by the worker once done.
+        push([&pr, func = std::move(func), &alien = engine().alien(), shard = this_shard_id()] () mutable noexcept {
+            try {
+                alien::run_on(alien, shard, [&pr, result = func()] () mutable noexcept {
+                    pr.set_value(std::move(result));
+                });
+            } catch (...) {
+                alien::run_on(alien, shard, [&pr, ex = std::current_exception()] () mutable noexcept {
+                    pr.set_exception(std::move(ex));
+                });
+            }
+        });
+        co_return co_await pr.get_future();
+    }
+};
+
+} // namespace utils
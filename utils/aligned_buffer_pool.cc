@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <bit>
+#include <cstdlib>
+
+#include "utils/aligned_buffer_pool.hh"
+
+namespace utils {
+
+aligned_buffer_pool::aligned_buffer_pool(size_t max_pooled_bytes)
+    : _max_pooled_bytes(max_pooled_bytes)
+    , _alive(make_lw_shared<bool>(true))
+{ }
+
+aligned_buffer_pool::~aligned_buffer_pool() {
+    *_alive = false;
+}
+
+size_t aligned_buffer_pool::size_class(size_t size) noexcept {
+    return std::countr_zero(std::bit_ceil(std::max(size, min_size))) - std::countr_zero(min_size);
+}
+
+void aligned_buffer_pool::release(char* p, size_t cls) noexcept {
+    buffer_ptr buf(p);
+    auto size = class_size(cls);
+    if (_stats.pooled_bytes + size > _max_pooled_bytes) {
+        ++_stats.drops;
+        return;
+    }
+    try {
+        _free[cls].push_back(std::move(buf));
+        _stats.pooled_bytes += size;
+    } catch (...) {
+        ++_stats.drops;
+    }
+}
+
+temporary_buffer<char> aligned_buffer_pool::get(size_t size) {
+    if (size > max_size) {
+        return temporary_buffer<char>::aligned(alignment, size);
+    }
+    auto cls = size_class(size);
+    buffer_ptr buf;
+    if (!_free[cls].empty()) {
+        buf = std::move(_free[cls].back());
+        _free[cls].pop_back();
+        _stats.pooled_bytes -= class_size(cls);
+        ++_stats.hits;
+    } else {
+        buf.reset(static_cast<char*>(::aligned_alloc(alignment, class_size(cls))));
+        if (!buf) {
+            throw std::bad_alloc();
+        }
+        ++_stats.misses;
+    }
+    auto p = buf.get();
+    auto d = make_deleter([this, alive = _alive, p, cls] {
+        if (*alive) {
+            release(p, cls);
+        } else {
+            ::free(p);
+        }
+    });
+    buf.release();
+    return temporary_buffer<char>(p, size, std::move(d));
+}
+
+aligned_buffer_pool& aligned_buffer_pool::local() {
+    static thread_local aligned_buffer_pool pool(4 * 1024 * 1024);
+    return pool;
+}
+
+} // namespace utils
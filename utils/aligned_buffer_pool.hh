@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <memory>
+#include <vector>
+
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/temporary_buffer.hh>
+
+#include "seastarx.hh"
+
+namespace utils {
+
+/// A per-shard pool of aligned I/O buffers.
+///
+/// The pool keeps released buffers in power-of-two size classes, from
+/// min_size to max_size, and hands them out again instead of allocating
+/// new ones, so that the reads of index pages, which are small and
+/// frequent, don't churn through the general allocator. Larger buffers
+/// are allocated and freed as usual.
+///
+/// A buffer returns to the pool when the temporary_buffer returned by
+/// get(), and all the buffers shared from it, are destroyed. The pool
+/// keeps at most max_pooled_bytes of free buffers, the rest is freed.
+/// Buffers can outlive the pool, they are freed then.
+class aligned_buffer_pool {
+public:
+    static constexpr size_t alignment = 4096;
+    static constexpr size_t min_size = 4096;
+    static constexpr size_t max_size = 128 * 1024;
+
+    struct stats {
+        // Buffers served from the pool.
+        uint64_t hits = 0;
+        // Buffers of a pooled size class, which had to be allocated.
+        uint64_t misses = 0;
+        // Released buffers which were freed, because the pool was full.
+        uint64_t drops = 0;
+        size_t pooled_bytes = 0;
+    };
+
+private:
+    struct free_deleter {
+        void operator()(char* p) const noexcept {
+            ::free(p);
+        }
+    };
+    using buffer_ptr = std::unique_ptr<char[], free_deleter>;
+
+    static constexpr size_t nr_size_classes = std::countr_zero(max_size) - std::countr_zero(min_size) + 1;
+
+    std::array<std::vector<buffer_ptr>, nr_size_classes> _free;
+    size_t _max_pooled_bytes;
+    stats _stats;
+    // Cleared on destruction, buffers released after it are freed.
+    lw_shared_ptr<bool> _alive;
+
+    static size_t size_class(size_t size) noexcept;
+    static size_t class_size(size_t cls) noexcept {
+        return min_size << cls;
+    }
+    void release(char* p, size_t cls) noexcept;
+
+public:
+    explicit aligned_buffer_pool(size_t max_pooled_bytes);
+    ~aligned_buffer_pool();
+    aligned_buffer_pool(const aligned_buffer_pool&) = delete;
+    aligned_buffer_pool& operator=(const aligned_buffer_pool&) = delete;
+
+    /// Returns a buffer of exactly `size` bytes, aligned to `alignment`,
+    /// with uninitialized contents.
+    temporary_buffer<char> get(size_t size);
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+
+    /// The pool of the current shard.
+    static aligned_buffer_pool& local();
+};
+
+} // namespace utils
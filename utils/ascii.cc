@@ -11,11 +11,18 @@
 #include "ascii.hh"
 #include <seastar/core/byteorder.hh>
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__x86_64__)
+#include <immintrin.h>
+#define arch_target(name) [[gnu::target(name)]]
+#endif
+
 namespace utils {
 
 namespace ascii {
 
-bool validate(const uint8_t *data, size_t len) {
+bool internal::validate_scalar(const uint8_t *data, size_t len) {
     // OR all bytes
     uint8_t orall = 0;
 
@@ -46,6 +53,93 @@ bool validate(const uint8_t *data, size_t len) {
     return orall < 0x80;
 }
 
+#if defined(__aarch64__)
+
+static bool validate_impl(const uint8_t *data, size_t len) {
+    if (len >= 64) {
+        uint8x16_t or1 = vdupq_n_u8(0), or2 = or1, or3 = or1, or4 = or1;
+
+        do {
+            or1 = vorrq_u8(or1, vld1q_u8(data));
+            or2 = vorrq_u8(or2, vld1q_u8(data + 16));
+            or3 = vorrq_u8(or3, vld1q_u8(data + 32));
+            or4 = vorrq_u8(or4, vld1q_u8(data + 48));
+
+            data += 64;
+            len -= 64;
+        } while (len >= 64);
+
+        if (vmaxvq_u8(vorrq_u8(vorrq_u8(or1, or2), vorrq_u8(or3, or4))) >= 0x80) {
+            return false;
+        }
+    }
+    return internal::validate_scalar(data, len);
+}
+
+#elif defined(__x86_64__)
+
+// The 7-th bit of every byte is collected by _mm_movemask_epi8(), so the bytes
+// are only OR-ed together in the loop and checked once at the end.
+arch_target("default") bool validate_impl(const uint8_t *data, size_t len) {
+    if (len >= 64) {
+        __m128i or1 = _mm_setzero_si128(), or2 = or1, or3 = or1, or4 = or1;
+
+        do {
+            or1 = _mm_or_si128(or1, _mm_loadu_si128((const __m128i *)data));
+            or2 = _mm_or_si128(or2, _mm_loadu_si128((const __m128i *)(data + 16)));
+            or3 = _mm_or_si128(or3, _mm_loadu_si128((const __m128i *)(data + 32)));
+            or4 = _mm_or_si128(or4, _mm_loadu_si128((const __m128i *)(data + 48)));
+
+            data += 64;
+            len -= 64;
+        } while (len >= 64);
+
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(or1, or2), _mm_or_si128(or3, or4)))) {
+            return false;
+        }
+    }
+    return internal::validate_scalar(data, len);
+}
+
+arch_target("avx2") bool validate_impl(const uint8_t *data, size_t len) {
+    if (len >= 32) {
+        __m256i or1 = _mm256_setzero_si256(), or2 = or1, or3 = or1, or4 = or1;
+
+        while (len >= 128) {
+            or1 = _mm256_or_si256(or1, _mm256_loadu_si256((const __m256i *)data));
+            or2 = _mm256_or_si256(or2, _mm256_loadu_si256((const __m256i *)(data + 32)));
+            or3 = _mm256_or_si256(or3, _mm256_loadu_si256((const __m256i *)(data + 64)));
+            or4 = _mm256_or_si256(or4, _mm256_loadu_si256((const __m256i *)(data + 96)));
+
+            data += 128;
+            len -= 128;
+        }
+        while (len >= 32) {
+            or1 = _mm256_or_si256(or1, _mm256_loadu_si256((const __m256i *)data));
+
+            data += 32;
+            len -= 32;
+        }
+
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(or1, or2), _mm256_or_si256(or3, or4)))) {
+            return false;
+        }
+    }
+    return internal::validate_scalar(data, len);
+}
+
+#else
+
+static bool validate_impl(const uint8_t *data, size_t len) {
+    return internal::validate_scalar(data, len);
+}
+
+#endif
+
+bool validate(const uint8_t *data, size_t len) {
+    return validate_impl(data, len);
+}
+
 } // namespace ascii
 
 } // namespace utils
@@ -17,6 +17,13 @@ namespace utils {
 
 namespace ascii {
 
+namespace internal {
+
+// Validates 16 bytes at a time with plain integer operations, exposed for tests and benchmarks.
+bool validate_scalar(const uint8_t *data, size_t len);
+
+}
+
 bool validate(const uint8_t *data, size_t len);
 
 inline bool validate(bytes_view string) {
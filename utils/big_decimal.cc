@@ -134,26 +134,49 @@ sstring big_decimal::to_string() const
     return str;
 }
 
+// Multiplies v by 10^n, by machine words, rather than by 10^n built as a cpp_int.
+static void multiply_by_power_of_10(boost::multiprecision::cpp_int& v, int64_t n) {
+    constexpr int max_word_exponent = 19;
+    constexpr uint64_t max_word_power = 10'000'000'000'000'000'000ULL;
+    for (; n >= max_word_exponent; n -= max_word_exponent) {
+        v *= max_word_power;
+    }
+    uint64_t power = 1;
+    for (; n > 0; --n) {
+        power *= 10;
+    }
+    if (power != 1) {
+        v *= power;
+    }
+}
+
 std::strong_ordering big_decimal::operator<=>(const big_decimal& other) const
 {
-    auto max_scale = std::max(_scale, other._scale);
-    boost::multiprecision::cpp_int rescale(10);
-    boost::multiprecision::cpp_int x = _unscaled_value * boost::multiprecision::pow(rescale, max_scale - _scale);
-    boost::multiprecision::cpp_int y = other._unscaled_value * boost::multiprecision::pow(rescale, max_scale - other._scale);
-    return x.compare(y) <=> 0;
+    if (_scale == other._scale) {
+        return _unscaled_value.compare(other._unscaled_value) <=> 0;
+    } else if (_scale < other._scale) {
+        boost::multiprecision::cpp_int x = _unscaled_value;
+        multiply_by_power_of_10(x, int64_t(other._scale) - _scale);
+        return x.compare(other._unscaled_value) <=> 0;
+    } else {
+        boost::multiprecision::cpp_int y = other._unscaled_value;
+        multiply_by_power_of_10(y, int64_t(_scale) - other._scale);
+        return _unscaled_value.compare(y) <=> 0;
+    }
 }
 
 big_decimal& big_decimal::operator+=(const big_decimal& other)
 {
     if (_scale == other._scale) {
         _unscaled_value += other._unscaled_value;
+    } else if (_scale < other._scale) {
+        multiply_by_power_of_10(_unscaled_value, int64_t(other._scale) - _scale);
+        _unscaled_value += other._unscaled_value;
+        _scale = other._scale;
     } else {
-        boost::multiprecision::cpp_int rescale(10);
-        auto max_scale = std::max(_scale, other._scale);
-        boost::multiprecision::cpp_int u = _unscaled_value * boost::multiprecision::pow(rescale,  max_scale - _scale);
-        boost::multiprecision::cpp_int v = other._unscaled_value * boost::multiprecision::pow(rescale, max_scale - other._scale);
-        _unscaled_value = u + v;
-        _scale = max_scale;
+        boost::multiprecision::cpp_int v = other._unscaled_value;
+        multiply_by_power_of_10(v, int64_t(_scale) - other._scale);
+        _unscaled_value += v;
     }
     return *this;
 }
@@ -161,13 +184,14 @@ big_decimal& big_decimal::operator+=(const big_decimal& other)
 big_decimal& big_decimal::operator-=(const big_decimal& other) {
     if (_scale == other._scale) {
         _unscaled_value -= other._unscaled_value;
+    } else if (_scale < other._scale) {
+        multiply_by_power_of_10(_unscaled_value, int64_t(other._scale) - _scale);
+        _unscaled_value -= other._unscaled_value;
+        _scale = other._scale;
     } else {
-        boost::multiprecision::cpp_int rescale(10);
-        auto max_scale = std::max(_scale, other._scale);
-        boost::multiprecision::cpp_int u = _unscaled_value * boost::multiprecision::pow(rescale,  max_scale - _scale);
-        boost::multiprecision::cpp_int v = other._unscaled_value * boost::multiprecision::pow(rescale, max_scale - other._scale);
-        _unscaled_value = u - v;
-        _scale = max_scale;
+        boost::multiprecision::cpp_int v = other._unscaled_value;
+        multiply_by_power_of_10(v, int64_t(_scale) - other._scale);
+        _unscaled_value -= v;
     }
     return *this;
 }
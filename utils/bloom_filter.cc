@@ -9,17 +9,35 @@
  */
 
 #include "i_filter.hh"
+#include "utils/log.hh"
 #include "bytes.hh"
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/align.hh>
 #include <seastar/core/loop.hh>
+#include <seastar/core/on_internal_error.hh>
 #include "utils/large_bitset.hh"
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cmath>
 #include <cstdlib>
 #include "utils/bloom_calculations.hh"
 #include "bloom_filter.hh"
 
+#ifdef __x86_64__
+#include <x86intrin.h>
+#define arch_target(name) [[gnu::target(name)]]
+#else
+#define arch_target(name)
+#endif
+#ifdef __aarch64__
+#include <arm_neon.h>
+#endif
+
 namespace utils {
+
+extern logging::logger filterlog;
+
 namespace filter {
 
 thread_local bloom_filter::stats bloom_filter::_shard_stats;
@@ -49,6 +67,12 @@ bloom_filter::~bloom_filter() noexcept {
     _stats.memory_size -= memory_size();
 }
 
+void bloom_filter::replace_bits(bitmap&& bs) noexcept {
+    _stats.memory_size -= memory_size();
+    _bitset = std::move(bs);
+    _stats.memory_size += memory_size();
+}
+
 bool bloom_filter::is_present(hashed_key key) {
     bool result = true;
     for_each_index(key, _hash_count, _bitset.size(), _format, [this, &result] (auto i) {
@@ -72,6 +96,331 @@ bool bloom_filter::is_present(const bytes_view& key) {
     return is_present(make_hashed_key(key));
 }
 
+// Odd constants used to derive the eight per-lane bit positions of a key
+// from a single 32-bit hash, as in the Parquet and Impala split-block filters.
+alignas(32) static constexpr uint32_t split_block_salt[split_block_bloom_filter::hashes_per_key] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+};
+
+// Lane i of a block is the i%2 half (low half first) of its i/2-th 64-bit
+// word. This matches the in-memory lane order of the vectorized kernels on
+// little-endian machines, while defining the layout independently of the
+// machine byte order.
+static inline unsigned split_block_bit(uint32_t key, unsigned lane) noexcept {
+    return (key * split_block_salt[lane]) >> 27;
+}
+
+arch_target("default") bool split_block_test(const uint64_t* block, uint32_t key) noexcept {
+#ifdef __aarch64__
+    static_assert(std::endian::native == std::endian::little);
+    auto k = vdupq_n_u32(key);
+    auto one = vdupq_n_u32(1);
+    auto lanes = reinterpret_cast<const uint32_t*>(block);
+    auto lo = vshlq_u32(one, vreinterpretq_s32_u32(vshrq_n_u32(vmulq_u32(k, vld1q_u32(split_block_salt)), 27)));
+    auto hi = vshlq_u32(one, vreinterpretq_s32_u32(vshrq_n_u32(vmulq_u32(k, vld1q_u32(split_block_salt + 4)), 27)));
+    // Lanes where the bit is missing from the block end up non-zero.
+    auto missing = vorrq_u32(vbicq_u32(lo, vld1q_u32(lanes)), vbicq_u32(hi, vld1q_u32(lanes + 4)));
+    return vmaxvq_u32(missing) == 0;
+#else
+    for (unsigned lane = 0; lane < split_block_bloom_filter::hashes_per_key; ++lane) {
+        auto bit = split_block_bit(key, lane) + (lane % 2) * 32;
+        if (!((block[lane / 2] >> bit) & 1)) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+#ifdef __x86_64__
+
+arch_target("avx2") bool split_block_test(const uint64_t* block, uint32_t key) noexcept {
+    auto salt = _mm256_load_si256(reinterpret_cast<const __m256i*>(split_block_salt));
+    auto bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(key), salt), 27);
+    auto mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+    auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    // testc computes (~b & mask) == 0, i.e. all bits of mask are set in b.
+    return _mm256_testc_si256(b, mask);
+}
+
+#endif
+
+split_block_bloom_filter::split_block_bloom_filter(bitmap&& bs, filter_format format)
+    : bloom_filter(hashes_per_key, std::move(bs), format)
+    , _nr_blocks(bits().size() / bits_per_block)
+{
+    if (_nr_blocks == 0 || bits().size() % bits_per_block) {
+        throw std::invalid_argument(fmt::format("Invalid split-block bloom filter size: {} bits", bits().size()));
+    }
+}
+
+size_t split_block_bloom_filter::block_of(hashed_key key) const noexcept {
+    // Lemire's fast range reduction of the high half of the first hash.
+    return ((key.hash()[0] >> 32) * _nr_blocks) >> 32;
+}
+
+void split_block_bloom_filter::add(const bytes_view& key) {
+    auto hk = make_hashed_key(key);
+    auto block = bits().word_address(block_of(hk) * words_per_block);
+    uint32_t k = hk.hash()[1];
+    for (unsigned lane = 0; lane < hashes_per_key; ++lane) {
+        block[lane / 2] |= uint64_t(1) << (split_block_bit(k, lane) + (lane % 2) * 32);
+    }
+}
+
+bool split_block_bloom_filter::is_present(hashed_key key) {
+    return split_block_test(bits().word_address(block_of(key) * words_per_block), key.hash()[1]);
+}
+
+bool split_block_bloom_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
+// Block descriptors hold the first slot of the block above the seed.
+static constexpr unsigned xor_seed_bits = 16;
+static constexpr uint64_t xor_seed_mask = (uint64_t(1) << xor_seed_bits) - 1;
+
+static inline uint64_t xor_hash(uint64_t h, uint64_t seed) noexcept {
+    // murmur3's fmix64 of the second half of the key hash; the first half
+    // selects the block.
+    h += seed * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static inline uint32_t xor_reduce(uint32_t h, uint32_t n) noexcept {
+    return (uint64_t(h) * n) >> 32;
+}
+
+// The three slots of a hash in a block of 3 * segment_length slots, one in
+// each segment.
+static inline std::array<uint32_t, 3> xor_slots(uint64_t h, uint32_t segment_length) noexcept {
+    return {
+        xor_reduce(uint32_t(h), segment_length),
+        segment_length + xor_reduce(uint32_t(std::rotl(h, 21)), segment_length),
+        2 * segment_length + xor_reduce(uint32_t(std::rotl(h, 42)), segment_length),
+    };
+}
+
+static inline uint32_t xor_fingerprint(uint64_t h, int fingerprint_bits) noexcept {
+    return (h ^ (h >> 32)) & ((uint64_t(1) << fingerprint_bits) - 1);
+}
+
+static uint32_t xor_segment_length(size_t nr_keys) noexcept {
+    return nr_keys ? (nr_keys * 123 / 100 + 32 + 2) / 3 : 0;
+}
+
+xor_filter::xor_filter(int fingerprint_bits, int64_t num_elements)
+    : bloom_filter(fingerprint_bits, bitmap(0), filter_format::m_format)
+    , _nr_blocks(std::max<uint64_t>((std::max<int64_t>(num_elements, 0) + keys_per_block - 1) / keys_per_block, 1))
+    , _built(false)
+{
+    if (fingerprint_bits < 1 || fingerprint_bits > 32) {
+        throw std::invalid_argument(fmt::format("Invalid XOR filter fingerprint size: {} bits", fingerprint_bits));
+    }
+    _words.resize(fingerprints_start());
+    _words[0] = _nr_blocks;
+    _block_hashes.reserve(keys_per_block);
+}
+
+xor_filter::xor_filter(int fingerprint_bits, bitmap&& bs)
+    : bloom_filter(fingerprint_bits, std::move(bs), filter_format::m_format)
+    , _nr_blocks(0)
+    , _built(true)
+{
+    auto nr_words = bits().size() / 64;
+    if (fingerprint_bits < 1 || fingerprint_bits > 32 || nr_words < 3) {
+        throw std::invalid_argument(fmt::format("Invalid XOR filter: {} fingerprint bits, {} bits", fingerprint_bits, bits().size()));
+    }
+    _nr_blocks = *bits().word_address(0);
+    if (_nr_blocks == 0 || _nr_blocks > nr_words - 2
+            || (*bits().word_address(_nr_blocks + 1) >> xor_seed_bits) * fingerprint_bits > (nr_words - fingerprints_start()) * 64) {
+        throw std::invalid_argument(fmt::format("Invalid XOR filter: {} blocks, {} fingerprint bits, {} bits", _nr_blocks, fingerprint_bits, bits().size()));
+    }
+}
+
+uint64_t xor_filter::fingerprints_start() const noexcept {
+    return _nr_blocks + 2;
+}
+
+uint64_t xor_filter::block_of(hashed_key key) const noexcept {
+    // The first half of the hash is the murmur3 token, flipping the sign bit
+    // makes the blocks ordered like the tokens.
+    auto h = key.hash()[0] ^ (uint64_t(1) << 63);
+    return (static_cast<unsigned __int128>(h) * _nr_blocks) >> 64;
+}
+
+void xor_filter::build_block() {
+    std::ranges::sort(_block_hashes);
+    _block_hashes.erase(std::ranges::unique(_block_hashes).begin(), _block_hashes.end());
+    auto nr_keys = _block_hashes.size();
+    auto segment_length = xor_segment_length(nr_keys);
+    uint64_t seed = 0;
+
+    std::vector<uint32_t> fingerprints;
+    if (nr_keys) {
+        std::vector<uint32_t> counts;
+        std::vector<uint64_t> masks;
+        std::vector<uint32_t> queue;
+        std::vector<std::pair<uint64_t, uint32_t>> stack;
+        for (unsigned attempt = 0;; ++attempt) {
+            // Peeling fails with a low probability, retry with another seed,
+            // and make room if that doesn't help.
+            if (attempt && attempt % 64 == 0) {
+                segment_length += segment_length / 10 + 1;
+            }
+            seed = attempt & xor_seed_mask;
+            auto nr_slots = 3 * segment_length;
+            counts.assign(nr_slots, 0);
+            masks.assign(nr_slots, 0);
+            for (auto key : _block_hashes) {
+                auto h = xor_hash(key, seed);
+                for (auto slot : xor_slots(h, segment_length)) {
+                    ++counts[slot];
+                    masks[slot] ^= h;
+                }
+            }
+            queue.clear();
+            for (uint32_t slot = 0; slot < nr_slots; ++slot) {
+                if (counts[slot] == 1) {
+                    queue.push_back(slot);
+                }
+            }
+            stack.clear();
+            while (!queue.empty()) {
+                auto slot = queue.back();
+                queue.pop_back();
+                if (counts[slot] != 1) {
+                    continue;
+                }
+                auto h = masks[slot];
+                stack.emplace_back(h, slot);
+                for (auto s : xor_slots(h, segment_length)) {
+                    masks[s] ^= h;
+                    if (--counts[s] == 1) {
+                        queue.push_back(s);
+                    }
+                }
+            }
+            if (stack.size() == nr_keys) {
+                break;
+            }
+        }
+        fingerprints.assign(3 * segment_length, 0);
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            auto [h, slot] = *it;
+            auto [s0, s1, s2] = xor_slots(h, segment_length);
+            fingerprints[slot] = xor_fingerprint(h, num_hashes()) ^ fingerprints[s0] ^ fingerprints[s1] ^ fingerprints[s2];
+        }
+    }
+
+    _words[_current_block + 1] = (_nr_slots << xor_seed_bits) | seed;
+    const unsigned f = num_hashes();
+    for (auto fp : fingerprints) {
+        auto pos = _nr_slots * f;
+        auto word = fingerprints_start() + pos / 64;
+        auto offset = pos % 64;
+        while (_words.size() <= word + (offset + f > 64)) {
+            _words.push_back(0);
+        }
+        _words[word] |= uint64_t(fp) << offset;
+        if (offset + f > 64) {
+            _words[word + 1] |= uint64_t(fp) >> (64 - offset);
+        }
+        ++_nr_slots;
+    }
+    _block_hashes.clear();
+}
+
+void xor_filter::add(const bytes_view& key) {
+    if (_built) {
+        on_internal_error(filterlog, "Adding a key to an XOR filter which was already built");
+    }
+    auto hk = make_hashed_key(key);
+    auto block = block_of(hk);
+    if (block < _current_block) {
+        on_internal_error(filterlog, fmt::format("XOR filter keys must be added in token order: block {} after block {}", block, _current_block));
+    }
+    while (_current_block < block) {
+        build_block();
+        ++_current_block;
+    }
+    _block_hashes.push_back(hk.hash()[1]);
+}
+
+void xor_filter::finish() {
+    if (_built) {
+        return;
+    }
+    while (_current_block < _nr_blocks) {
+        build_block();
+        ++_current_block;
+    }
+    _words[_nr_blocks + 1] = _nr_slots << xor_seed_bits;
+    _built = true;
+    _block_hashes = {};
+    auto nr_bits = _words.size() * 64;
+    replace_bits(bitmap(nr_bits, std::exchange(_words, {})));
+}
+
+bool xor_filter::is_present(hashed_key key) {
+    if (!_built) [[unlikely]] {
+        // The keys of the pending blocks aren't in the filter yet.
+        return true;
+    }
+    auto block = block_of(key);
+    auto& bs = bits();
+    auto desc = *bs.word_address(block + 1);
+    auto start = desc >> xor_seed_bits;
+    auto end = *bs.word_address(block + 2) >> xor_seed_bits;
+    if (start == end) {
+        return false;
+    }
+    const unsigned f = num_hashes();
+    auto fingerprint_at = [&] (uint64_t slot) -> uint32_t {
+        auto pos = (start + slot) * f;
+        auto word = fingerprints_start() + pos / 64;
+        auto offset = pos % 64;
+        auto v = *bs.word_address(word) >> offset;
+        if (offset + f > 64) {
+            v |= *bs.word_address(word + 1) << (64 - offset);
+        }
+        return v & ((uint64_t(1) << f) - 1);
+    };
+    auto h = xor_hash(key.hash()[1], desc & xor_seed_mask);
+    auto [s0, s1, s2] = xor_slots(h, (end - start) / 3);
+    return (fingerprint_at(s0) ^ fingerprint_at(s1) ^ fingerprint_at(s2)) == xor_fingerprint(h, f);
+}
+
+bool xor_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
+int xor_filter::fingerprint_bits_for(double max_false_pos_probability) {
+    // The false-positive rate of fingerprints of f bits is 2^-f.
+    return std::clamp<int>(std::ceil(-std::log2(max_false_pos_probability)), 1, 32);
+}
+
+filter_ptr create_xor_filter(int fingerprint_bits, large_bitset&& bitset) {
+    return std::make_unique<xor_filter>(fingerprint_bits, std::move(bitset));
+}
+
+filter_ptr create_xor_filter(int64_t num_elements, double max_false_pos_probability) {
+    return std::make_unique<xor_filter>(xor_filter::fingerprint_bits_for(max_false_pos_probability), num_elements);
+}
+
+size_t get_xor_filter_size(int64_t num_elements, double max_false_pos_probability) {
+    num_elements = std::max<int64_t>(num_elements, 0);
+    int64_t nr_blocks = std::max<int64_t>((num_elements + xor_filter::keys_per_block - 1) / xor_filter::keys_per_block, 1);
+    int64_t nr_slots = num_elements * 123 / 100 + nr_blocks * (32 + 2);
+    return (nr_blocks + 2) * 64 + align_up<int64_t>(nr_slots * xor_filter::fingerprint_bits_for(max_false_pos_probability), 64);
+}
+
 size_t get_bitset_size(int64_t num_elements, int buckets_per) {
     int64_t num_bits = (num_elements * buckets_per) + bloom_calculations::EXCESS;
     num_bits = align_up<int64_t>(num_bits, 64);  // Seems to be implied in origin
@@ -85,5 +434,24 @@ filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format)
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format) {
     return std::make_unique<murmur3_bloom_filter>(hash, large_bitset(get_bitset_size(num_elements, buckets_per)), format);
 }
+
+size_t get_split_block_bitset_size(int64_t num_elements, int buckets_per) {
+    // Confining a key to a single block makes the blocks fill up unevenly,
+    // which raises the false-positive rate of a split-block filter over that
+    // of a classic one with the same number of bits. About 20% more bits
+    // bring it back down to the requested rate for the usual fp chances
+    // (see the analysis in the Putze et al. paper).
+    int64_t num_bits = num_elements * buckets_per * 6 / 5;
+    return std::max<int64_t>(align_up<int64_t>(num_bits, split_block_bloom_filter::bits_per_block),
+            split_block_bloom_filter::bits_per_block);
+}
+
+filter_ptr create_split_block_filter(large_bitset&& bitset, filter_format format) {
+    return std::make_unique<split_block_bloom_filter>(std::move(bitset), format);
+}
+
+filter_ptr create_split_block_filter(int64_t num_elements, int buckets_per, filter_format format) {
+    return std::make_unique<split_block_bloom_filter>(large_bitset(get_split_block_bitset_size(num_elements, buckets_per)), format);
+}
 }
 }
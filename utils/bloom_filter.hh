@@ -14,6 +14,8 @@
 #include "i_filter.hh"
 #include "utils/large_bitset.hh"
 
+#include <vector>
+
 namespace utils {
 namespace filter {
 
@@ -35,6 +37,10 @@ class bloom_filter: public i_filter {
     int num_hashes() { return _hash_count; }
     bitmap& bits() { return _bitset; }
 
+    virtual filter_layout layout() const noexcept {
+        return filter_layout::classic;
+    }
+
     bloom_filter(int hashes, bitmap&& bs, filter_format format) noexcept;
     ~bloom_filter() noexcept;
 
@@ -57,6 +63,8 @@ class bloom_filter: public i_filter {
     static const stats& get_shard_stats() noexcept {
         return _shard_stats;
     }
+protected:
+    void replace_bits(bitmap&& bs) noexcept;
 };
 
 struct murmur3_bloom_filter: public bloom_filter {
@@ -66,6 +74,89 @@ struct murmur3_bloom_filter: public bloom_filter {
     {}
 };
 
+// Split-block bloom filter (see Putze et al., "Cache-, Hash- and
+// Space-Efficient Bloom Filters"). The bitmap is divided into 256-bit blocks
+// of eight 32-bit lanes; a key selects one block and sets one bit in each of
+// its lanes. Probing touches a single cache line and is vectorized where the
+// CPU allows it. For a given false-positive rate it needs somewhat more bits
+// than the classic layout, which get_split_block_bitset_size() accounts for.
+struct split_block_bloom_filter: public bloom_filter {
+    static constexpr int hashes_per_key = 8;
+    static constexpr size_t words_per_block = 4;
+    static constexpr size_t bits_per_block = words_per_block * 64;
+
+    split_block_bloom_filter(bitmap&& bs, filter_format format);
+
+    virtual filter_layout layout() const noexcept override {
+        return filter_layout::split_block;
+    }
+
+    virtual void add(const bytes_view& key) override;
+
+    virtual bool is_present(const bytes_view& key) override;
+
+    virtual bool is_present(hashed_key key) override;
+private:
+    size_t _nr_blocks;
+
+    size_t block_of(hashed_key key) const noexcept;
+};
+
+// Blocked XOR filter (see Graf and Lemire, "Xor Filters: Faster and Smaller
+// Than Bloom and Cuckoo Filters"). Each key has a fingerprint of
+// fingerprint_bits bits, which is the XOR of the three slots of the array the
+// key hashes to. For a false-positive rate p it needs about
+// 1.23 * log2(1/p) bits per key, rather than 1.44 * log2(1/p) for a bloom
+// filter.
+//
+// An XOR filter can only be built knowing all of its keys, so the keys are
+// split into blocks by the high bits of their murmur3 hash, i.e. by token,
+// and the filter of a block is built once the keys of a following block
+// start being added. Keys must therefore be added in token order, as the
+// sstable writer does, and the memory needed to build the filter is that of
+// a single block.
+//
+// It derives from bloom_filter so that it is stored in Filter.db and
+// accounted for the same way. The words of the bitmap hold the number of
+// blocks, then a descriptor of each block (its first slot and its hash seed)
+// followed by the end slot of the last block, then the packed fingerprints.
+struct xor_filter: public bloom_filter {
+    static constexpr size_t keys_per_block = 4096;
+
+    // A filter to be built from num_elements keys, more or less.
+    xor_filter(int fingerprint_bits, int64_t num_elements);
+    // A filter built before, as stored in bs.
+    xor_filter(int fingerprint_bits, bitmap&& bs);
+
+    virtual filter_layout layout() const noexcept override {
+        return filter_layout::xor_filter;
+    }
+
+    virtual void add(const bytes_view& key) override;
+
+    virtual bool is_present(const bytes_view& key) override;
+
+    virtual bool is_present(hashed_key key) override;
+
+    virtual void finish() override;
+
+    // The number of fingerprint bits giving a false-positive rate of at
+    // most max_false_pos_probability.
+    static int fingerprint_bits_for(double max_false_pos_probability);
+private:
+    uint64_t _nr_blocks;
+    bool _built;
+    // Construction state.
+    uint64_t _current_block = 0;
+    std::vector<uint64_t> _block_hashes;
+    utils::chunked_vector<uint64_t> _words;
+    uint64_t _nr_slots = 0;
+
+    uint64_t block_of(hashed_key key) const noexcept;
+    uint64_t fingerprints_start() const noexcept;
+    void build_block();
+};
+
 struct always_present_filter: public i_filter {
 
     virtual bool is_present(const bytes_view& key) override {
@@ -90,7 +181,18 @@ struct always_present_filter: public i_filter {
 // Get the size of the bitset (in bits, not bytes) for the specific parameters.
 size_t get_bitset_size(int64_t num_elements, int buckets_per);
 
+// Get the size of a split-block filter bitset (in bits) giving about the same
+// false-positive rate as a classic one sized by get_bitset_size().
+size_t get_split_block_bitset_size(int64_t num_elements, int buckets_per);
+
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format);
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format);
+filter_ptr create_split_block_filter(large_bitset&& bitset, filter_format format);
+filter_ptr create_split_block_filter(int64_t num_elements, int buckets_per, filter_format format);
+filter_ptr create_xor_filter(int fingerprint_bits, large_bitset&& bitset);
+filter_ptr create_xor_filter(int64_t num_elements, double max_false_pos_probability);
+
+// Get the approximate size of an XOR filter (in bits) for the specific parameters.
+size_t get_xor_filter_size(int64_t num_elements, double max_false_pos_probability);
 }
 }
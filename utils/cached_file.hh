@@ -9,6 +9,7 @@
 #pragma once
 
 #include "reader_permit.hh"
+#include "utils/aligned_buffer_pool.hh"
 #include "utils/assert.hh"
 #include "utils/div_ceil.hh"
 #include "utils/bptree.hh"
@@ -18,6 +19,7 @@
 #include "tracing/trace_state.hh"
 #include "utils/cached_file_stats.hh"
 
+#include <seastar/core/align.hh>
 #include <seastar/core/file.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/maybe_yield.hh>
@@ -107,10 +109,14 @@ class cached_file {
 
         void on_evicted() noexcept override;
 
+        void on_second_chance() noexcept override {
+            ++parent->_metrics.page_second_chances;
+        }
+
         temporary_buffer<char> get_buf() {
             auto self = share();
             if (!_buf) {
-                _buf = temporary_buffer<char>(_lsa_buf.size());
+                _buf = utils::aligned_buffer_pool::local().get(_lsa_buf.size());
                 parent->_metrics.bytes_in_std += _lsa_buf.size();
                 std::copy(_lsa_buf.get(), _lsa_buf.get() + _lsa_buf.size(), _buf.get_write());
             }
@@ -154,6 +160,22 @@ class cached_file {
     offset_type _last_page_size;
     page_idx_type _last_page;
 private:
+    // Reads `size` bytes starting at the given page into a pooled buffer.
+    future<temporary_buffer<char>> read_pages(page_idx_type idx, size_t size) {
+        auto buf = utils::aligned_buffer_pool::local().get(align_up(size, page_size));
+        auto pos = idx * page_size;
+        auto f = _file.dma_read(pos, buf.get_write(), buf.size());
+        return f.then([this, pos, size, buf = std::move(buf)] (size_t read) mutable {
+            if (read < size) {
+                // A short read, which can only happen at the end of the file,
+                // so let dma_read_exactly() sort it out.
+                return _file.dma_read_exactly<char>(pos, size);
+            }
+            buf.trim(size);
+            return make_ready_future<temporary_buffer<char>>(std::move(buf));
+        });
+    }
+
     // Returns (page, true) if the page was cached, and (page, false) if the page was uncached.
     future<std::pair<cached_page::ptr_type, bool>> get_page_ptr(page_idx_type idx,
             page_count_type read_ahead,
@@ -163,6 +185,7 @@ class cached_file {
             ++_metrics.page_hits;
             tracing::trace(trace_state, "page cache hit: file={}, page={}", _file_name, idx);
             cached_page& cp = *i;
+            cp.mark_referenced();
             return make_ready_future<std::pair<cached_page::ptr_type, bool>>(cp.share(), true);
         }
         tracing::trace(trace_state, "page cache miss: file={}, page={}, readahead={}", _file_name, idx, read_ahead);
@@ -170,7 +193,7 @@ class cached_file {
         size_t size = (idx + read_ahead) > _last_page
                 ? (_last_page_size + (_last_page - idx) * page_size)
                 : read_ahead * page_size;
-        return _file.dma_read_exactly<char>(idx * page_size, size)
+        return read_pages(idx, size)
             .then([this, idx] (temporary_buffer<char>&& buf) mutable {
                 cached_page::ptr_type first_page;
                 while (buf.size()) {
@@ -15,6 +15,7 @@ struct cached_file_stats {
     uint64_t page_misses = 0;
     uint64_t page_evictions = 0;
     uint64_t page_populations = 0;
+    uint64_t page_second_chances = 0; // hit pages spared from eviction, see index_evictable
     uint64_t cached_bytes = 0;
     uint64_t bytes_in_std = 0; // memory used by active temporary_buffer:s
 };
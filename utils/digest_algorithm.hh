@@ -15,6 +15,7 @@ namespace query {
 enum class digest_algorithm : uint8_t {
     none = 0,  // digest not required
     xxHash = 3, // default algorithm
+    xxh3 = 4, // 128-bit XXH3, used when the whole cluster supports it
 };
 
 }
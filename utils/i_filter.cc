@@ -15,9 +15,9 @@
 #include <seastar/core/thread.hh>
 
 namespace utils {
-static logging::logger filterlog("bloom_filter");
+logging::logger filterlog("bloom_filter");
 
-filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_probability, filter_format fformat) {
+filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_probability, filter_format fformat, filter_layout layout) {
     SCYLLA_ASSERT(seastar::thread::running_in_thread());
 
     if (max_false_pos_probability > 1.0) {
@@ -28,19 +28,33 @@ filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_proba
         return std::make_unique<filter::always_present_filter>();
     }
 
+    if (layout == filter_layout::xor_filter) {
+        return filter::create_xor_filter(num_elements, max_false_pos_probability);
+    }
+
     int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
     auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
+    if (layout == filter_layout::split_block) {
+        return filter::create_split_block_filter(num_elements, spec.buckets_per_element, fformat);
+    }
     return filter::create_filter(spec.K, num_elements, spec.buckets_per_element, fformat);
 }
 
-size_t i_filter::get_filter_size(int64_t num_elements, double max_false_pos_probability) {
+size_t i_filter::get_filter_size(int64_t num_elements, double max_false_pos_probability, filter_layout layout) {
     if (max_false_pos_probability >= 1.0) {
         return 0;
     }
 
+    if (layout == filter_layout::xor_filter) {
+        return filter::get_xor_filter_size(num_elements, max_false_pos_probability) / 8;
+    }
+
     int buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
     auto spec = bloom_calculations::compute_bloom_spec(buckets_per_element, max_false_pos_probability);
 
+    if (layout == filter_layout::split_block) {
+        return filter::get_split_block_bitset_size(num_elements, spec.buckets_per_element) / 8;
+    }
     return filter::get_bitset_size(num_elements, spec.buckets_per_element) / 8;
 }
 
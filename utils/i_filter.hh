@@ -23,6 +23,20 @@ enum class filter_format {
     m_format,
 };
 
+// How the filter bits of a key are spread over the bitmap.
+enum class filter_layout {
+    // The classic bloom filter: each hash selects a bit anywhere in the bitmap.
+    classic,
+    // Split-block bloom filter: all bits of a key fall into a single 256-bit
+    // block, so probing a key costs a single cache miss.
+    split_block,
+    // Not a bloom filter: a blocked XOR filter, which stores a fingerprint
+    // per key and needs less memory for the same false-positive rate. It is
+    // built from keys added in token order, so it needs the murmur3
+    // partitioner.
+    xor_filter,
+};
+
 class hashed_key {
 private:
     std::array<uint64_t, 2> _hash;
@@ -44,6 +58,10 @@ struct i_filter {
     virtual void clear() = 0;
     virtual void close() = 0;
 
+    // Called once all keys were added, before the filter is used. Filters
+    // which need to know all of their keys complete their construction here.
+    virtual void finish() { }
+
     virtual size_t memory_size() = 0;
 
     /**
@@ -53,11 +71,13 @@ struct i_filter {
      *         Asserts that the given probability can be satisfied using this
      *         filter.
      */
-    static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format);
+    static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format,
+            filter_layout layout = filter_layout::classic);
 
     /**
      * @return the size of the smallest filter (in bytes), according to the conditions described at get_filter()
      */
-    static size_t get_filter_size(int64_t num_elements, double max_false_pos_prob);
+    static size_t get_filter_size(int64_t num_elements, double max_false_pos_prob,
+            filter_layout layout = filter_layout::classic);
 };
 }
@@ -29,6 +29,7 @@ class large_bitset {
     explicit large_bitset(size_t nr_bits, utils::chunked_vector<int_type> storage) : _nr_bits(nr_bits), _storage(std::move(storage)) {}
     large_bitset(large_bitset&&) = default;
     large_bitset(const large_bitset&) = delete;
+    large_bitset& operator=(large_bitset&&) = default;
     large_bitset& operator=(const large_bitset&) = delete;
     size_t size() const {
         return _nr_bits;
@@ -61,4 +62,14 @@ class large_bitset {
     const utils::chunked_vector<int_type>& get_storage() const {
         return _storage;
     }
+
+    // Direct access to the storage words, for filters which lay out their
+    // bits in blocks of words. Storage is fragmented, but a block of n words
+    // (n being a power of two) starting at a multiple of n is contiguous.
+    int_type* word_address(size_t word_idx) {
+        return &_storage[word_idx];
+    }
+    const int_type* word_address(size_t word_idx) const {
+        return &_storage[word_idx];
+    }
 };
@@ -12,7 +12,10 @@
 
 #include <boost/regex/icu.hpp>
 #include <boost/locale/encoding.hpp>
+#include <cstring>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace {
 
@@ -75,17 +78,82 @@ wstring regex_from_pattern(bytes_view pattern) {
     return re;
 }
 
+/// A pattern with no '_' wildcards, and '%' wildcards only at its start and/or end: 'abc',
+/// 'abc%', '%abc' or '%abc%'. Those are the most common patterns, and they are matched by comparing,
+/// or searching for, the bytes of the literal between the wildcards. As UTF-8 is self-synchronizing,
+/// that gives the same result as the regex, without decoding the text.
+struct literal_pattern {
+    std::string literal;
+    bool any_prefix = false;
+    bool any_suffix = false;
+
+    bool operator()(std::string_view text) const {
+        if (any_prefix && any_suffix) {
+            // glibc's memmem() is vectorized, and linear in the size of the text.
+            return literal.empty() || ::memmem(text.data(), text.size(), literal.data(), literal.size());
+        } else if (any_prefix) {
+            return text.ends_with(literal);
+        } else if (any_suffix) {
+            return text.starts_with(literal);
+        }
+        return text == literal;
+    }
+};
+
+/// Returns the literal_pattern equivalent to the given LIKE pattern, or nullopt if the pattern
+/// has other wildcards.
+std::optional<literal_pattern> literal_from_pattern(bytes_view pattern) {
+    literal_pattern lp;
+    size_t i = 0;
+    for (; i < pattern.size() && pattern[i] == '%'; ++i) {
+        lp.any_prefix = true;
+    }
+    bool escaping = false;
+    for (; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (escaping) {
+            lp.literal.push_back(c);
+            escaping = false;
+        } else if (c == '\\') {
+            escaping = true;
+        } else if (c == '_') {
+            return std::nullopt;
+        } else if (c == '%') {
+            // Only the '%' wildcards ending the pattern are allowed.
+            for (; i < pattern.size(); ++i) {
+                if (pattern[i] != '%') {
+                    return std::nullopt;
+                }
+            }
+            lp.any_suffix = true;
+        } else {
+            lp.literal.push_back(c);
+        }
+    }
+    if (escaping) {
+        // An unescaped backslash ending the pattern matches itself, see regex_from_pattern().
+        lp.literal.push_back('\\');
+    }
+    return lp;
+}
+
 } // anonymous namespace
 
 class like_matcher::impl {
     bytes _pattern;
-    boost::u32regex _re; // Performs pattern matching.
+    std::optional<literal_pattern> _literal; // Performs pattern matching, if the pattern is simple enough.
+    boost::u32regex _re; // Performs pattern matching otherwise.
   public:
     explicit impl(bytes_view pattern);
     bool operator()(bytes_view text) const;
     void reset(bytes_view pattern);
   private:
     void init_re() {
+        _literal = literal_from_pattern(_pattern);
+        if (_literal) {
+            _re = boost::u32regex();
+            return;
+        }
         _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
     }
 };
@@ -95,6 +163,9 @@ like_matcher::impl::impl(bytes_view pattern) : _pattern(pattern) {
 }
 
 bool like_matcher::impl::operator()(bytes_view text) const {
+    if (_literal) {
+        return (*_literal)(std::string_view(reinterpret_cast<const char*>(text.data()), text.size()));
+    }
     return boost::u32regex_match(text.begin(), text.end(), _re);
 }
 
@@ -35,6 +35,7 @@
 
 #include <random>
 #include <chrono>
+#include <cstring>
 
 using namespace std::chrono_literals;
 
@@ -396,21 +397,38 @@ static thread_local tracker& tracker_instance = get_tracker_instance();
 
 using clock = std::chrono::steady_clock;
 
+// Keeps free memory above a watermark, so that allocations don't have to compact
+// or evict synchronously. The watermark follows the rate of LSA allocations:
+// it is raised to pacing_periods times the memory allocated during the last
+// adjustment period, so bursts of allocations find the memory already free.
 class background_reclaimer {
     scheduling_group _sg;
     noncopyable_function<void (size_t target)> _reclaim;
+    noncopyable_function<uint64_t ()> _allocated_bytes;
     timer<lowres_clock> _adjust_shares_timer;
     // If engaged, main loop is not running, set_value() to wake it.
     promise<>* _main_loop_wait = nullptr;
     future<> _done;
     bool _stopping = false;
-    static constexpr size_t free_memory_threshold = 60'000'000;
+    static constexpr size_t min_free_memory_threshold = 60'000'000;
+    static constexpr uint64_t pacing_periods = 2;
+    size_t _free_memory_threshold = min_free_memory_threshold;
+    uint64_t _last_allocated_bytes = 0;
 private:
     bool have_work() const {
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
-        return memory::free_memory() < free_memory_threshold;
+        return memory::free_memory() < _free_memory_threshold;
 #else
         return false;
+#endif
+    }
+    void adjust_threshold() {
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+        auto allocated_bytes = _allocated_bytes();
+        auto rate = allocated_bytes - std::exchange(_last_allocated_bytes, allocated_bytes);
+        // Don't let a burst hold back more than a small part of memory from the cache.
+        auto max_threshold = std::max(min_free_memory_threshold, memory::stats().total_memory() / 16);
+        _free_memory_threshold = std::clamp<uint64_t>(rate * pacing_periods, min_free_memory_threshold, max_threshold);
 #endif
     }
     void main_loop_wake() {
@@ -434,14 +452,15 @@ class background_reclaimer {
             if (_stopping) {
                 break;
             }
-            _reclaim(free_memory_threshold - memory::free_memory());
+            _reclaim(_free_memory_threshold - memory::free_memory());
             co_await coroutine::maybe_yield();
         }
         llogger.debug("background_reclaimer::main_loop: exit");
     }
     void adjust_shares() {
+        adjust_threshold();
         if (have_work()) {
-            auto shares = 1 + (1000 * (free_memory_threshold - memory::free_memory())) / free_memory_threshold;
+            auto shares = 1 + (1000 * (_free_memory_threshold - memory::free_memory())) / _free_memory_threshold;
             _sg.set_shares(shares);
             llogger.trace("background_reclaimer::adjust_shares: {}", shares);
             if (_main_loop_wait) {
@@ -450,9 +469,11 @@ class background_reclaimer {
         }
     }
 public:
-    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim)
+    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim,
+            noncopyable_function<uint64_t ()> allocated_bytes)
             : _sg(sg)
             , _reclaim(std::move(reclaim))
+            , _allocated_bytes(std::move(allocated_bytes))
             , _adjust_shares_timer(default_scheduling_group(), [this] { adjust_shares(); })
             , _done(with_scheduling_group(_sg, [this] { return main_loop(); })) {
         if (sg != default_scheduling_group()) {
@@ -541,6 +562,8 @@ class tracker::impl {
         SCYLLA_ASSERT(!_background_reclaimer);
         _background_reclaimer.emplace(sg, [this] (size_t target) {
             reclaim(target, is_preemptible::yes);
+        }, [this] {
+            return _segment_pool->statistics().memory_allocated;
         });
     }
     // const bool&, so interested parties can save a reference and see updates.
@@ -747,6 +770,21 @@ class segment_store_backend {
     virtual void* alloc_segment_memory() noexcept = 0;
     virtual void free_segment_memory(void* seg) noexcept = 0;
     virtual size_t free_memory() const noexcept = 0;
+    // Asks the kernel to back the segments' memory with transparent huge pages.
+    // Memory already backed by hugetlbfs (seastar's --hugepages) is left as is.
+    void advise_huge_pages() const noexcept {
+        static constexpr uintptr_t huge_page_size = 2 << 20;
+        auto start = align_up(_segments_base, huge_page_size);
+        auto end = align_down(_layout.end, huge_page_size);
+        if (start >= end) {
+            return;
+        }
+        if (madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE)) {
+            llogger.warn("Failed to enable transparent huge pages for {} bytes of LSA segment memory: {}", end - start, std::strerror(errno));
+        } else {
+            llogger.debug("Enabled transparent huge pages for {} bytes of LSA segment memory", end - start);
+        }
+    }
     bool can_allocate_more_segments(size_t non_lsa_reserve) const noexcept {
         if (_freed_segment_increases_general_memory_availability) {
             return free_memory() >= non_lsa_reserve + segment::size;
@@ -886,6 +924,9 @@ class contiguous_memory_segment_store {
     bool can_allocate_more_segments() const noexcept {
         return _backend->can_allocate_more_segments(non_lsa_reserve);
     }
+    void advise_huge_pages() const noexcept {
+        _backend->advise_huge_pages();
+    }
 };
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
 using segment_store = contiguous_memory_segment_store;
@@ -988,6 +1029,11 @@ class segment_store {
         auto i = find_empty();
         return i != _segments.end();
     }
+    void advise_huge_pages() const noexcept {
+        if (_delegate_store) {
+            _delegate_store->advise_huge_pages();
+        }
+    }
 };
 #endif
 
@@ -1074,6 +1120,7 @@ class segment_pool {
     logalloc::tracker::impl& tracker() { return _tracker; }
     void prime(size_t available_memory, size_t min_free_memory);
     void use_standard_allocator_segment_pool_backend(size_t available_memory);
+    void advise_huge_pages() const noexcept { _store.advise_huge_pages(); }
     segment* new_segment(region::impl* r);
     const segment_descriptor& descriptor(const segment* seg) const noexcept {
         uintptr_t index = idx_from_segment(seg);
@@ -1133,6 +1180,7 @@ class segment_pool {
     inline void on_memory_allocation(size_t size) noexcept;
     inline void on_memory_deallocation(size_t size) noexcept;
     inline void on_memory_eviction(size_t size) noexcept;
+    inline void on_synchronous_reclaim() noexcept;
     size_t unreserved_free_segments() const noexcept { return _free_segments - std::min(_free_segments, _emergency_reserve_max); }
     size_t free_segments() const noexcept { return _free_segments; }
 };
@@ -1469,6 +1517,10 @@ inline void segment_pool::on_memory_eviction(size_t size) noexcept {
     _stats.memory_evicted += size;
 }
 
+inline void segment_pool::on_synchronous_reclaim() noexcept {
+    ++_stats.synchronous_reclaims;
+}
+
 // RAII wrapper to maintain segment_pool::current_emergency_reserve_goal()
 class segment_pool::reservation_goal {
     segment_pool& _sp;
@@ -2425,6 +2477,9 @@ void tracker::configure(const config& cfg) {
     }
     _impl->setup_background_reclaim(cfg.background_reclaim_sched_group);
     _impl->set_sanitizer_report_backtrace(cfg.sanitizer_report_backtrace);
+    if (cfg.use_huge_pages) {
+        _impl->segment_pool().advise_huge_pages();
+    }
 }
 
 memory::reclaiming_result tracker::reclaim(seastar::memory::reclaimer::request r) {
@@ -2753,6 +2808,9 @@ size_t tracker::impl::compact_and_evict_locked(size_t reserve_segments, size_t m
     // should work just fine even if allocates.
 
     size_t mem_released = 0;
+    if (!preempt) {
+        _segment_pool->on_synchronous_reclaim();
+    }
 
     size_t mem_in_use = _segment_pool->total_memory_in_use();
     memory_to_release += (reserve_segments - std::min(reserve_segments, _segment_pool->free_segments())) * segment::size;
@@ -2912,6 +2970,9 @@ tracker::impl::impl() : _segment_pool(std::make_unique<logalloc::segment_pool>(*
 
         sm::make_counter("memory_freed", [this] { return _segment_pool->statistics().memory_freed; },
                         sm::description("Counts number of bytes which were requested to be freed in LSA.")),
+
+        sm::make_counter("synchronous_reclaims", [this] { return _segment_pool->statistics().synchronous_reclaims; },
+                        sm::description("Counts compactions and evictions which ran synchronously with an allocation, because not enough memory was free.")),
     });
 }
 
@@ -3029,6 +3090,12 @@ future<> prime_segment_pool(size_t available_memory, size_t min_free_memory) {
     });
 }
 
+future<> use_huge_pages_for_segment_pool() {
+    return smp::invoke_on_all([] {
+        shard_tracker().get_impl().segment_pool().advise_huge_pages();
+    });
+}
+
 future<> use_standard_allocator_segment_pool_backend(size_t available_memory) {
     return smp::invoke_on_all([=] {
         shard_tracker().get_impl().segment_pool().use_standard_allocator_segment_pool_backend(available_memory);
@@ -65,6 +65,8 @@ class tracker {
         bool sanitizer_report_backtrace = false; // Better reports but slower
         size_t lsa_reclamation_step;
         scheduling_group background_reclaim_sched_group;
+        // Back segments with transparent huge pages, to reduce TLB misses.
+        bool use_huge_pages = false;
     };
 
     struct stats {
@@ -75,6 +77,9 @@ class tracker {
         uint64_t memory_compacted;
         uint64_t memory_evicted;
         uint64_t num_allocations;
+        // Compactions and evictions which ran synchronously with an allocation,
+        // because the background reclaimer didn't keep enough memory free.
+        uint64_t synchronous_reclaims;
 
         friend stats operator+(const stats& s1, const stats& s2) {
             stats result(s1);
@@ -94,6 +99,7 @@ class tracker {
             memory_compacted += other.memory_compacted;
             memory_evicted += other.memory_evicted;
             num_allocations += other.num_allocations;
+            synchronous_reclaims += other.synchronous_reclaims;
             return *this;
         }
         stats& operator-=(const stats& other) {
@@ -104,6 +110,7 @@ class tracker {
             memory_compacted -= other.memory_compacted;
             memory_evicted -= other.memory_evicted;
             num_allocations -= other.num_allocations;
+            synchronous_reclaims -= other.synchronous_reclaims;
             return *this;
         }
     };
@@ -535,6 +542,9 @@ class allocating_section {
 
 future<> prime_segment_pool(size_t available_memory, size_t min_free_memory);
 
+// Back the segment pool with transparent huge pages on all shards.
+future<> use_huge_pages_for_segment_pool();
+
 // Use the segment pool appropriate for the standard allocator.
 //
 // In debug mode, this will use the release standard allocator store.
@@ -68,12 +68,27 @@ class evictable {
 //
 // To maintain this limit, index entries might have to be evicted outside of the regular LRU order.
 // Therefore they are linked both in the common LRU list and in a separate LRU list for index entries.
+//
+// A miss of an index entry costs a serial I/O before the data I/O can even
+// start, so index entries are also protected from being flushed out by scans:
+// an entry hit since it was last considered for eviction gets a second chance,
+// it is moved to the back of the LRU when it reaches its front. Entries read
+// only once, like those of scans, don't get that protection.
 class index_evictable : public evictable {
     friend class lru;
     evictable::lru_link_type _index_lru_link;
+    bool _referenced = false;
     bool is_index() const noexcept override {
         return true;
     }
+protected:
+    // Called when the entry is spared from eviction.
+    virtual void on_second_chance() noexcept {}
+public:
+    // Marks the entry as hit, see the comment above.
+    void mark_referenced() noexcept {
+        _referenced = true;
+    }
 };
 
 // Implements LRU cache replacement for row cache and sstable index cache.
@@ -115,6 +130,14 @@ class lru {
         }
     }
 
+    // Like add(e) but makes e the next element to evict, in the absence of later touches.
+    void add_probationary(evictable& e) noexcept {
+        _list.push_front(e);
+        if (e.is_index()) {
+            _index_list.push_front(static_cast<index_evictable&>(e));
+        }
+    }
+
     // Like add(e) but makes sure that e is evicted right before "more_recent" in the absence of later touches.
     void add_before(evictable& more_recent, evictable& e) noexcept {
         _list.insert(_list.iterator_to(more_recent), e);
@@ -125,13 +148,34 @@ class lru {
         add(e);
     }
 
+    // Bounds the work of a single eviction, see the comment to index_evictable.
+    static constexpr unsigned max_second_chances_per_eviction = 8;
+
     // Evicts a single element from the LRU
     template <bool Shallow = false>
     reclaiming_result do_evict(bool should_evict_index) noexcept {
         if (_list.empty()) {
             return reclaiming_result::reclaimed_nothing;
         }
-        evictable& e = (should_evict_index && !_index_list.empty()) ? _index_list.front() : _list.front();
+        if (should_evict_index && !_index_list.empty()) {
+            // The index takes more than its share of memory, so it loses its protection.
+            return evict_element<Shallow>(_index_list.front());
+        }
+        for (unsigned i = 0; i < max_second_chances_per_eviction && _list.front().is_index(); ++i) {
+            auto& ie = static_cast<index_evictable&>(_list.front());
+            if (!ie._referenced) {
+                break;
+            }
+            ie._referenced = false;
+            _list.erase(_list.iterator_to(ie));
+            _list.push_back(ie);
+            ie.on_second_chance();
+        }
+        return evict_element<Shallow>(_list.front());
+    }
+
+    template <bool Shallow>
+    reclaiming_result evict_element(evictable& e) noexcept {
         remove(e);
         if constexpr (!Shallow) {
             e.on_evicted();
@@ -165,6 +165,12 @@ struct [[gnu::packed]] single_chunk_blob_storage {
 // of timestamp, so it's 17 bytes in total and that doesn't fit into inline storage.
 // And adding 16 bytes to each 17-byte cell is a big waste.
 //
+// The inline storage is kept at 15 bytes, so that managed_bytes stays 16 bytes. Widening it to
+// fit 8-byte cells (17 bytes) would make every managed_bytes 24 bytes, which costs 8 bytes
+// for each key and each cell that doesn't fit in it anyway to save about 24 bytes for each
+// cell that newly fits. Of the small values, the keys (a bigint clustering key is 10 bytes
+// serialized) and the dead and int-sized cells (13 bytes) are already stored inline.
+//
 // The code of `class managed_bytes` is responsible for allocating and freeing the storage.
 // Code responsible for reading and writing it is in managed_bytes_basic_view.
 // The implementation details of these two classes are entangled.
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2024-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace utils {
+
+namespace internal {
+
+// Per-thread free list of memory blocks of Size bytes, keeping up to
+// MaxCached of them.
+template <size_t Size, size_t MaxCached>
+class block_pool {
+    static_assert(Size >= sizeof(void*));
+
+    struct free_block {
+        free_block* next;
+    };
+
+    free_block* _head = nullptr;
+    size_t _cached = 0;
+
+    block_pool() = default;
+public:
+    ~block_pool() {
+        while (_head) {
+            ::operator delete(std::exchange(_head, _head->next), Size);
+        }
+    }
+
+    static block_pool& local() noexcept {
+        static thread_local block_pool pool;
+        return pool;
+    }
+
+    void* allocate() {
+        if (_head) {
+            --_cached;
+            return std::exchange(_head, _head->next);
+        }
+        return ::operator new(Size);
+    }
+
+    void deallocate(void* p) noexcept {
+        if (_cached < MaxCached) {
+            _head = new (p) free_block{_head};
+            ++_cached;
+            return;
+        }
+        ::operator delete(p, Size);
+    }
+
+    size_t cached() const noexcept {
+        return _cached;
+    }
+};
+
+}
+
+/// Recycles the memory of the objects of a class in a per-shard pool.
+///
+/// Deriving T from pooled_allocation<T> gives it class-specific operator new
+/// and delete, which keep up to MaxCached freed blocks of sizeof(T) bytes in a
+/// free list of the shard and reuse them for the next objects, instead of
+/// going through the allocator. This pays off for objects allocated and freed
+/// at a high rate, like the per-request state of the coordinator.
+///
+/// Pools are per block size, so that classes of the same size share a pool.
+/// Objects of any other size, e.g. of classes derived from T, aren't pooled,
+/// so T should have a virtual destructor if it is deleted through a pointer to
+/// a base class.
+template <typename T, size_t MaxCached = 1024>
+class pooled_allocation {
+public:
+    static void* operator new(size_t size) {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        if (size == sizeof(T)) {
+            return internal::block_pool<sizeof(T), MaxCached>::local().allocate();
+        }
+        return ::operator new(size);
+    }
+
+    static void operator delete(void* p, size_t size) noexcept {
+        if (size == sizeof(T)) {
+            internal::block_pool<sizeof(T), MaxCached>::local().deallocate(p);
+            return;
+        }
+        ::operator delete(p, size);
+    }
+
+    // Number of free blocks kept for objects of T.
+    static size_t cached() noexcept {
+        return internal::block_pool<sizeof(T), MaxCached>::local().cached();
+    }
+};
+
+/// Standard allocator recycling single objects in a per-shard pool.
+///
+/// Suitable for the nodes of node-based containers (e.g. std::unordered_map),
+/// see pooled_allocation. Arrays (e.g. hash table buckets) are allocated
+/// as usual.
+template <typename T, size_t MaxCached = 1024>
+class pooled_allocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = pooled_allocator<U, MaxCached>;
+    };
+
+    pooled_allocator() noexcept = default;
+    template <typename U>
+    pooled_allocator(const pooled_allocator<U, MaxCached>&) noexcept {}
+
+    T* allocate(size_t n) {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        if (n == 1) {
+            return static_cast<T*>(internal::block_pool<sizeof(T), MaxCached>::local().allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (n == 1) {
+            internal::block_pool<sizeof(T), MaxCached>::local().deallocate(p);
+            return;
+        }
+        ::operator delete(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const pooled_allocator<U, MaxCached>&) const noexcept {
+        return true;
+    }
+};
+
+}
@@ -7,9 +7,11 @@
  */
 
 #include <fmt/format.h>
+#include <deque>
 #include <exception>
 #include <initializer_list>
 #include <memory>
+#include <ranges>
 #include <stdexcept>
 #if __has_include(<rapidxml.h>)
 #include <rapidxml.h>
@@ -22,6 +24,7 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/iostream.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/on_internal_error.hh>
 #include <seastar/core/pipe.hh>
 #include <seastar/core/units.hh>
@@ -41,6 +44,8 @@
 #include "utils/chunked_vector.hh"
 #include "utils/aws_sigv4.hh"
 #include "utils/exceptions.hh"
+#include "utils/hashers.hh"
+#include "utils/base64.hh"
 #include "db_clock.hh"
 #include "utils/log.hh"
 
@@ -433,6 +438,28 @@ future<temporary_buffer<char>> client::get_object_contiguous(sstring object_name
     co_return std::move(*ret);
 }
 
+future<temporary_buffer<char>> client::get_object_parallel(sstring object_name, range r) {
+    auto part_size = _cfg->download_part_size;
+    if (part_size == 0 || r.len <= part_size) {
+        co_return co_await get_object_contiguous(std::move(object_name), r);
+    }
+
+    auto nr_parts = div_ceil(r.len, part_size);
+    s3l.trace("GET {} range={}:{} in {} parts", object_name, r.off, r.len, nr_parts);
+    temporary_buffer<char> ret(r.len);
+    size_t len = r.len;
+    co_await max_concurrent_for_each(std::views::iota(size_t(0), nr_parts), std::max(_cfg->download_concurrency, 1u), [&] (size_t part) -> future<> {
+        auto off = part * part_size;
+        auto buf = co_await get_object_contiguous(object_name, range{ r.off + off, std::min(part_size, r.len - off) });
+        std::copy_n(buf.get(), buf.size(), ret.get_write() + off);
+        if (buf.size() < std::min(part_size, r.len - off)) {
+            len = std::min(len, off + buf.size());
+        }
+    });
+    ret.trim(len);
+    co_return ret;
+}
+
 future<> client::put_object(sstring object_name, temporary_buffer<char> buf) {
     s3l.trace("PUT {}", object_name);
     auto req = http::request::make("PUT", _host, object_name);
@@ -489,6 +516,15 @@ future<> client::delete_object(sstring object_name) {
     co_await make_request(std::move(req), ignore_reply, http::reply::status_type::no_content);
 }
 
+future<> client::copy_object(sstring source_object_name, sstring object_name) {
+    // see https://docs.aws.amazon.com/AmazonS3/latest/API/API_CopyObject.html
+    s3l.trace("PUT {} copy of {}", object_name, source_object_name);
+    auto req = http::request::make("PUT", _host, object_name);
+    req._headers["x-amz-copy-source"] = source_object_name;
+    // A failed copy can still be replied to with 200 OK and the error in the body.
+    co_await make_request(std::move(req), look_for_errors);
+}
+
 class client::multipart_upload {
 protected:
     shared_ptr<client> _client;
@@ -496,11 +532,16 @@ class client::multipart_upload {
     sstring _upload_id;
     utils::chunked_vector<sstring> _part_etags;
     gate _bg_flushes;
+    // Bounds the number of parts of the upload sent in parallel.
+    semaphore _parts_in_flight;
     std::optional<tag> _tag;
 
     future<> start_upload();
     future<> finalize_upload();
-    future<> upload_part(memory_data_sink_buffers bufs);
+    // Uploads the part in the background. The memory of the part is claimed
+    // by the call, unless it was already claimed by the caller. The Content-MD5
+    // of the part, when given, makes the server verify the part's integrity.
+    future<> upload_part(memory_data_sink_buffers bufs, std::optional<semaphore_units<>> claim = {}, sstring content_md5 = "");
     future<> upload_part(std::unique_ptr<upload_sink> source);
     future<> abort_upload();
 
@@ -511,6 +552,7 @@ class client::multipart_upload {
     multipart_upload(shared_ptr<client> cln, sstring object_name, std::optional<tag> tag)
         : _client(std::move(cln))
         , _object_name(std::move(object_name))
+        , _parts_in_flight(std::max(_client->_cfg->upload_concurrency, 1u))
         , _tag(std::move(tag))
     {
     }
@@ -636,12 +678,16 @@ future<> client::multipart_upload::start_upload() {
     });
 }
 
-future<> client::multipart_upload::upload_part(memory_data_sink_buffers bufs) {
+future<> client::multipart_upload::upload_part(memory_data_sink_buffers bufs, std::optional<semaphore_units<>> claim_, sstring content_md5) {
     if (!upload_started()) {
         co_await start_upload();
     }
 
-    auto claim = co_await _client->claim_memory(bufs.size());
+    auto claim = claim_ ? std::move(*claim_) : co_await _client->claim_memory(bufs.size());
+    // Parts are sent while the next ones are being filled, but only so many
+    // of them at a time, so that a single upload doesn't occupy all of the
+    // client's connections.
+    auto in_flight = co_await get_units(_parts_in_flight, 1);
 
     unsigned part_number = _part_etags.size();
     _part_etags.emplace_back();
@@ -651,6 +697,9 @@ future<> client::multipart_upload::upload_part(memory_data_sink_buffers bufs) {
     req._headers["Content-Length"] = seastar::format("{}", size);
     req.query_parameters["partNumber"] = seastar::format("{}", part_number + 1);
     req.query_parameters["uploadId"] = _upload_id;
+    if (!content_md5.empty()) {
+        req._headers["Content-MD5"] = std::move(content_md5);
+    }
     req.write_body("bin", size, [this, part_number, bufs = std::move(bufs), p = std::move(claim)] (output_stream<char>&& out_) mutable -> future<> {
         auto out = std::move(out_);
         std::exception_ptr ex;
@@ -692,7 +741,7 @@ future<> client::multipart_upload::upload_part(memory_data_sink_buffers bufs) {
     }).handle_exception([this, part_number] (auto ex) {
         // ... the exact exception only remains in logs
         s3l.warn("couldn't upload part {}: {} (upload id {})", part_number, ex, _upload_id);
-    }).finally([gh = std::move(gh)] {});
+    }).finally([gh = std::move(gh), in_flight = std::move(in_flight)] {});
 }
 
 future<> client::multipart_upload::abort_upload() {
@@ -742,27 +791,58 @@ future<> client::upload_sink_base::close() {
 
 class client::upload_sink final : public client::upload_sink_base {
     memory_data_sink_buffers _bufs;
-    future<> maybe_flush() {
-        if (_bufs.size() >= aws_minimum_part_size) {
-            co_await upload_part(std::move(_bufs));
+    // The memory of the buffered data, claimed as it is put.
+    semaphore_units<> _claim;
+    // The checksum of the buffered data, computed as it is put.
+    md5_hasher _md5;
+
+    // "Part numbers can be any number from 1 to 10,000", so the parts grow
+    // with the object, doubling every 1,000 parts, up to the endpoint's
+    // upload_max_part_size. Objects smaller than 5GB are uploaded in parts
+    // of the minimal size.
+    size_t part_size() const noexcept {
+        auto doublings = std::min(parts_count() / 1000, 10u);
+        return std::max(std::min(aws_minimum_part_size << doublings, _client->_cfg->upload_max_part_size), aws_minimum_part_size);
+    }
+
+    future<> upload_buffered() {
+        auto md5 = base64_encode(_md5.finalize());
+        _md5 = md5_hasher();
+        co_await upload_part(std::move(_bufs), std::move(_claim), std::move(md5));
+    }
+
+    future<> put_one(temporary_buffer<char> buf) {
+        auto claim = try_get_units(_client->_memory, buf.size());
+        if (!claim) {
+            // Memory is tight, don't wait for it holding a part which is
+            // large enough to be sent already.
+            if (_bufs.size() >= aws_minimum_part_size) {
+                co_await upload_buffered();
+            }
+            claim = co_await _client->claim_memory(buf.size());
+        }
+        _claim.adopt(std::move(*claim));
+        _md5.update(buf.get(), buf.size());
+        _bufs.put(std::move(buf));
+        if (_bufs.size() >= part_size()) {
+            co_await upload_buffered();
         }
     }
 
 public:
     upload_sink(shared_ptr<client> cln, sstring object_name, std::optional<tag> tag = {})
         : upload_sink_base(std::move(cln), std::move(object_name), std::move(tag))
+        , _claim(_client->_memory, 0)
     {}
 
     virtual future<> put(temporary_buffer<char> buf) override {
-        _bufs.put(std::move(buf));
-        return maybe_flush();
+        return put_one(std::move(buf));
     }
 
     virtual future<> put(std::vector<temporary_buffer<char>> data) override {
         for (auto&& buf : data) {
-            _bufs.put(std::move(buf));
+            co_await put_one(std::move(buf));
         }
-        return maybe_flush();
     }
 
     virtual future<> flush() override {
@@ -771,10 +851,11 @@ class client::upload_sink final : public client::upload_sink_base {
             // upload happen in one REST call, instead of three (create + PUT + wrap-up)
             if (!upload_started()) {
                 s3l.trace("Sink fallback to plain PUT for {}", _object_name);
+                _claim.return_all();
                 co_return co_await _client->put_object(_object_name, std::move(_bufs));
             }
 
-            co_await upload_part(std::move(_bufs));
+            co_await upload_buffered();
         }
         if (upload_started()) {
             std::exception_ptr ex;
@@ -1111,6 +1192,11 @@ class client::readable_file : public file_impl {
         });
     }
 
+    // The parts of a range past the end of the object would fail the ranged GETs.
+    range clip(uint64_t pos, size_t len) const {
+        return range{ pos, std::min<uint64_t>(len, _stats->size - pos) };
+    }
+
 public:
     readable_file(shared_ptr<client> cln, sstring object_name)
         : _client(std::move(cln))
@@ -1174,7 +1260,7 @@ class client::readable_file : public file_impl {
             co_return 0;
         }
 
-        auto buf = co_await _client->get_object_contiguous(_object_name, range{ pos, len });
+        auto buf = co_await _client->get_object_parallel(_object_name, clip(pos, len));
         std::copy_n(buf.get(), buf.size(), reinterpret_cast<uint8_t*>(buffer));
         co_return buf.size();
     }
@@ -1185,7 +1271,7 @@ class client::readable_file : public file_impl {
             co_return 0;
         }
 
-        auto buf = co_await _client->get_object_contiguous(_object_name, range{ pos, utils::iovec_len(iov) });
+        auto buf = co_await _client->get_object_parallel(_object_name, clip(pos, utils::iovec_len(iov)));
         uint64_t off = 0;
         for (auto& v : iov) {
             auto sz = std::min(v.iov_len, buf.size() - off);
@@ -1204,7 +1290,7 @@ class client::readable_file : public file_impl {
             co_return temporary_buffer<uint8_t>();
         }
 
-        auto buf = co_await _client->get_object_contiguous(_object_name, range{ offset, range_size });
+        auto buf = co_await _client->get_object_parallel(_object_name, clip(offset, range_size));
         co_return temporary_buffer<uint8_t>(reinterpret_cast<uint8_t*>(buf.get_write()), buf.size(), buf.release());
     }
 
@@ -1217,6 +1303,105 @@ file client::make_readable_file(sstring object_name) {
     return file(make_shared<readable_file>(shared_from_this(), std::move(object_name)));
 }
 
+class client::download_source final : public data_source_impl {
+    shared_ptr<client> _client;
+    sstring _object_name;
+    // The next offset to fetch, and the end of the range, known once the
+    // first part is to be fetched.
+    uint64_t _pos;
+    std::optional<uint64_t> _end;
+    struct part {
+        size_t len;
+        future<temporary_buffer<char>> data;
+    };
+    // The parts being fetched, in the order of the range.
+    std::deque<part> _parts;
+    // The parts fetched ahead of the consumer, doubled on every part the
+    // consumer reads, and reset on skips.
+    unsigned _read_ahead = 1;
+    // The parts dropped by skips, to be waited for on close.
+    std::vector<future<temporary_buffer<char>>> _dropped;
+
+    future<> maybe_fetch() {
+        if (!_end) {
+            _end = co_await _client->get_object_size(_object_name);
+        }
+        auto part_size = _client->_cfg->download_part_size ?: std::numeric_limits<size_t>::max();
+        while (_parts.size() < _read_ahead && _pos < *_end) {
+            auto len = std::min<uint64_t>(part_size, *_end - _pos);
+            auto data = _client->claim_memory(len).then([cln = _client, name = _object_name, r = range{ _pos, len }] (auto units) {
+                return cln->get_object_contiguous(name, r).finally([units = std::move(units)] {});
+            });
+            _parts.push_back(part{ len, std::move(data) });
+            _pos += len;
+        }
+    }
+
+public:
+    download_source(shared_ptr<client> cln, sstring object_name, std::optional<range> r)
+        : _client(std::move(cln))
+        , _object_name(std::move(object_name))
+        , _pos(r ? r->off : 0)
+    {
+        if (r) {
+            _end = r->off + r->len;
+        }
+    }
+
+    virtual future<temporary_buffer<char>> get() override {
+        co_await maybe_fetch();
+        if (_parts.empty()) {
+            co_return temporary_buffer<char>();
+        }
+        auto data = std::move(_parts.front().data);
+        _parts.pop_front();
+        _read_ahead = std::min(_read_ahead * 2, std::max(_client->_cfg->download_concurrency, 1u));
+        co_await maybe_fetch();
+        co_return co_await std::move(data);
+    }
+
+    virtual future<temporary_buffer<char>> skip(uint64_t n) override {
+        while (!_parts.empty() && _parts.front().len <= n) {
+            n -= _parts.front().len;
+            _dropped.push_back(std::move(_parts.front().data));
+            _parts.pop_front();
+        }
+        if (!_parts.empty()) {
+            auto data = co_await std::move(_parts.front().data);
+            _parts.pop_front();
+            data.trim_front(std::min<uint64_t>(n, data.size()));
+            co_return data;
+        }
+        if (_end) {
+            _pos = std::min(_pos + n, *_end);
+        } else {
+            _pos += n;
+        }
+        // Not a sequential read, start over with a single part.
+        _read_ahead = 1;
+        co_return temporary_buffer<char>();
+    }
+
+    virtual future<> close() override {
+        for (auto& p : _parts) {
+            _dropped.push_back(std::move(p.data));
+        }
+        _parts.clear();
+        for (auto& f : _dropped) {
+            try {
+                co_await std::move(f);
+            } catch (...) {
+                s3l.debug("Dropped part of {} failed: {}", _object_name, std::current_exception());
+            }
+        }
+        _dropped.clear();
+    }
+};
+
+data_source client::make_download_source(sstring object_name, std::optional<range> range) {
+    return data_source(std::make_unique<download_source>(shared_from_this(), std::move(object_name), range));
+}
+
 future<> client::close() {
     co_await coroutine::parallel_for_each(_https, [] (auto& it) -> future<> {
         co_await it.second.http.close();
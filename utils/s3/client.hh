@@ -9,6 +9,7 @@
 #pragma once
 
 #include <seastar/core/file.hh>
+#include <seastar/core/iostream.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/metrics.hh>
@@ -51,6 +52,7 @@ class client : public enable_shared_from_this<client> {
     class upload_jumbo_sink;
     class do_upload_file;
     class readable_file;
+    class download_source;
     std::string _host;
     endpoint_config_ptr _cfg;
     struct io_stats {
@@ -99,11 +101,24 @@ class client : public enable_shared_from_this<client> {
     future<> put_object_tagging(sstring object_name, tag_set tagging);
     future<> delete_object_tagging(sstring object_name);
     future<temporary_buffer<char>> get_object_contiguous(sstring object_name, std::optional<range> range = {});
+    // Same as get_object_contiguous(), but ranges longer than the endpoint's
+    // download_part_size are fetched with parallel ranged GETs.
+    // The range must not extend past the end of the object.
+    future<temporary_buffer<char>> get_object_parallel(sstring object_name, range range);
     future<> put_object(sstring object_name, temporary_buffer<char> buf);
     future<> put_object(sstring object_name, ::memory_data_sink_buffers bufs);
     future<> delete_object(sstring object_name);
+    // Copies an object within the endpoint, without transferring its data.
+    // Objects larger than 5GiB can't be copied this way.
+    future<> copy_object(sstring source_object_name, sstring object_name);
 
     file make_readable_file(sstring object_name);
+    /// Makes a source reading the range (the whole object by default) in parts
+    /// of download_part_size bytes, which are fetched ahead of the consumer with
+    /// up to download_concurrency ranged GETs in parallel. The read-ahead starts
+    /// at a single part and grows while the consumer reads sequentially, so
+    /// short reads don't fetch much more than they need.
+    data_source make_download_source(sstring object_name, std::optional<range> range = {});
     data_sink make_upload_sink(sstring object_name);
     data_sink make_upload_jumbo_sink(sstring object_name, std::optional<unsigned> max_parts_per_piece = {});
     /// upload a file with specified path to s3
@@ -31,6 +31,17 @@ struct endpoint_config {
 
     std::optional<aws_config> aws;
 
+    // Reads of more than download_part_size bytes are split into ranged GETs
+    // of download_part_size bytes, up to download_concurrency of which are
+    // sent in parallel.
+    size_t download_part_size = 8 << 20;
+    unsigned download_concurrency = 4;
+    // Multipart uploads start with parts of the minimal size (5MiB) and grow
+    // them, for large objects, up to upload_max_part_size. Up to
+    // upload_concurrency parts of an upload are sent in parallel.
+    size_t upload_max_part_size = 64 << 20;
+    unsigned upload_concurrency = 4;
+
     std::strong_ordering operator<=> (const endpoint_config& o) const = default;
 };
 
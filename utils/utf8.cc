@@ -352,7 +352,9 @@ internal::validate_partial(const uint8_t *data, size_t len) {
 } // namespace utils
 
 #elif defined(__x86_64__)
-#include <smmintrin.h>
+#include <immintrin.h>
+
+#define arch_target(name) [[gnu::target(name)]]
 
 namespace utils {
 
@@ -413,8 +415,9 @@ alignas(16) static const int8_t s_ef_fe_tbl[] = {
 };
 
 // 5x faster than naive method
+static
 partial_validation_results
-internal::validate_partial(const uint8_t *data, size_t len) {
+validate_partial_sse4(const uint8_t *data, size_t len) {
     if (len >= 16) {
         __m128i prev_input = _mm_set1_epi8(0);
         __m128i prev_first_len = _mm_set1_epi8(0);
@@ -540,6 +543,141 @@ internal::validate_partial(const uint8_t *data, size_t len) {
     return validate_partial_naive(data, len);
 }
 
+arch_target("default")
+partial_validation_results
+validate_partial_impl(const uint8_t *data, size_t len) {
+    return validate_partial_sse4(data, len);
+}
+
+// Shifts the bytes of (prev, input) left by n bytes across the 128-bit lanes,
+// shifting in the last n bytes of prev.
+template <int n>
+arch_target("avx2")
+static inline __m256i shift_in_last_bytes(__m256i prev, __m256i input) {
+    // lanes = (prev.high, input.low)
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - n);
+}
+
+// Same algorithm as validate_partial_sse4(), 32 bytes at a time. The 128-bit
+// tables are broadcast to both lanes, as _mm256_shuffle_epi8() looks up each
+// lane separately.
+//
+// Blocks of plain ASCII skip the range checks: they are valid as long as the
+// previous block doesn't end with a truncated sequence.
+arch_target("avx2")
+partial_validation_results
+validate_partial_impl(const uint8_t *data, size_t len) {
+    if (len >= 32) {
+        __m256i prev_input = _mm256_setzero_si256();
+        __m256i prev_first_len = _mm256_setzero_si256();
+
+        // Cached tables
+        const __m256i first_len_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_first_len_tbl));
+        const __m256i first_range_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_first_range_tbl));
+        const __m256i range_min_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_range_min_tbl));
+        const __m256i range_max_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_range_max_tbl));
+        const __m256i df_ee_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_df_ee_tbl));
+        const __m256i ef_fe_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_ef_fe_tbl));
+        // The largest first_len of the previous block which an ASCII block can follow,
+        // i.e. no sequence started in the last 3 bytes continues into the block.
+        const __m256i max_first_len_before_ascii = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 1, 0);
+
+        __m256i error = _mm256_setzero_si256();
+
+        while (len >= 32) {
+            const __m256i input = _mm256_lddqu_si256((const __m256i *)data);
+
+            if (_mm256_movemask_epi8(input) == 0) {
+                error = _mm256_or_si256(error, _mm256_subs_epu8(prev_first_len, max_first_len_before_ascii));
+                prev_input = input;
+                prev_first_len = _mm256_setzero_si256();
+
+                data += 32;
+                len -= 32;
+                continue;
+            }
+
+            // high_nibbles = input >> 4
+            const __m256i high_nibbles =
+                _mm256_and_si256(_mm256_srli_epi16(input, 4), _mm256_set1_epi8(0x0F));
+
+            // first_len = legal character length minus 1
+            __m256i first_len = _mm256_shuffle_epi8(first_len_tbl, high_nibbles);
+
+            // First Byte: set range index to 8 for bytes within 0xC0 ~ 0xFF
+            __m256i range = _mm256_shuffle_epi8(first_range_tbl, high_nibbles);
+
+            // Second Byte: range |= (first_len, prev_first_len) << 1 byte
+            range = _mm256_or_si256(range, shift_in_last_bytes<1>(prev_first_len, first_len));
+
+            // Third Byte: range |= (saturate_sub(first_len, 1), ...) << 2 bytes
+            __m256i tmp1, tmp2;
+            tmp1 = _mm256_subs_epu8(first_len, _mm256_set1_epi8(1));
+            tmp2 = _mm256_subs_epu8(prev_first_len, _mm256_set1_epi8(1));
+            range = _mm256_or_si256(range, shift_in_last_bytes<2>(tmp2, tmp1));
+
+            // Fourth Byte: range |= (saturate_sub(first_len, 2), ...) << 3 bytes
+            tmp1 = _mm256_subs_epu8(first_len, _mm256_set1_epi8(2));
+            tmp2 = _mm256_subs_epu8(prev_first_len, _mm256_set1_epi8(2));
+            range = _mm256_or_si256(range, shift_in_last_bytes<3>(tmp2, tmp1));
+
+            // Adjust Second Byte range for special First Bytes(E0,ED,F0,F4),
+            // see validate_partial_sse4() for details.
+            __m256i shift1, pos, range2;
+            shift1 = shift_in_last_bytes<1>(prev_input, input);
+            pos = _mm256_sub_epi8(shift1, _mm256_set1_epi8(0xEF));
+            tmp1 = _mm256_subs_epu8(pos, _mm256_set1_epi8(char(240)));
+            range2 = _mm256_shuffle_epi8(df_ee_tbl, tmp1);
+            tmp2 = _mm256_adds_epu8(pos, _mm256_set1_epi8(112));
+            range2 = _mm256_add_epi8(range2, _mm256_shuffle_epi8(ef_fe_tbl, tmp2));
+
+            range = _mm256_add_epi8(range, range2);
+
+            // Load min and max values per calculated range index
+            __m256i minv = _mm256_shuffle_epi8(range_min_tbl, range);
+            __m256i maxv = _mm256_shuffle_epi8(range_max_tbl, range);
+
+            // Check value range
+            error = _mm256_or_si256(error, _mm256_cmpgt_epi8(minv, input));
+            error = _mm256_or_si256(error, _mm256_cmpgt_epi8(input, maxv));
+
+            prev_input = input;
+            prev_first_len = first_len;
+
+            data += 32;
+            len -= 32;
+        }
+
+        if (!_mm256_testz_si256(error, error)) {
+            return partial_validation_results{.error = true};
+        }
+
+        // Find previous token (not 80~BF)
+        int32_t token4 = _mm256_extract_epi32(prev_input, 7);
+        const int8_t *token = (const int8_t *)&token4;
+        int lookahead = 0;
+        if (token[3] > (int8_t)0xBF) {
+            lookahead = 1;
+        } else if (token[2] > (int8_t)0xBF) {
+            lookahead = 2;
+        } else if (token[1] > (int8_t)0xBF) {
+            lookahead = 3;
+        }
+        data -= lookahead;
+        len += lookahead;
+    }
+
+    // Continue with the remaining bytes 16 at a time
+    return validate_partial_sse4(data, len);
+}
+
+partial_validation_results
+internal::validate_partial(const uint8_t *data, size_t len) {
+    return validate_partial_impl(data, len);
+}
+
 } // namespace utf8
 
 } // namespace utils
@@ -570,6 +708,11 @@ namespace utils {
 
 namespace utf8 {
 
+partial_validation_results
+internal::validate_partial_scalar(const uint8_t* data, size_t len) {
+    return validate_partial_naive(data, len);
+}
+
 bool validate(const uint8_t* data, size_t len) {
     auto pvr = validate_partial(data, len);
     return !pvr.error && !pvr.unvalidated_tail;
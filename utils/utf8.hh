@@ -29,6 +29,9 @@ struct partial_validation_results {
 
 partial_validation_results validate_partial(const uint8_t* data, size_t len);
 
+// Validates a code point at a time, without SIMD, exposed for tests and benchmarks.
+partial_validation_results validate_partial_scalar(const uint8_t* data, size_t len);
+
 }
 
 
@@ -17,6 +17,8 @@
 #pragma GCC diagnostic pop
 
 #include <array>
+#include <cstring>
+#include <memory>
 
 class xx_hasher {
     static constexpr size_t digest_size = 16;
@@ -54,3 +56,111 @@ class xx_hasher {
         serialize_int64(out, finalize_uint64());
     }
 };
+
+// A hasher computing the 128-bit XXH3 hash of the bytes fed to it.
+//
+// XXH3 processes its input in stripes with the widest vector instructions
+// the build targets (SSE2/AVX2 on x86, NEON on ARM), and gathers small updates
+// in a buffer of its state, so it hashes the many small values of query
+// results much faster than XXH64.
+// The state is large and over-aligned, so it is allocated.
+class xxh3_hasher {
+    static constexpr size_t digest_size = 16;
+    struct state_deleter {
+        void operator()(XXH3_state_t* state) const noexcept {
+            XXH3_freeState(state);
+        }
+    };
+    std::unique_ptr<XXH3_state_t, state_deleter> _state;
+
+    static std::unique_ptr<XXH3_state_t, state_deleter> make_state() {
+        std::unique_ptr<XXH3_state_t, state_deleter> state(XXH3_createState());
+        if (!state) {
+            throw std::bad_alloc();
+        }
+        return state;
+    }
+public:
+    explicit xxh3_hasher(uint64_t seed = 0)
+        : _state(make_state())
+    {
+        XXH3_128bits_reset_withSeed(_state.get(), seed);
+    }
+
+    xxh3_hasher(const xxh3_hasher& o)
+        : _state(make_state())
+    {
+        XXH3_copyState(_state.get(), o._state.get());
+    }
+
+    xxh3_hasher(xxh3_hasher&&) noexcept = default;
+
+    xxh3_hasher& operator=(const xxh3_hasher& o) {
+        if (this != &o) {
+            if (!_state) {
+                _state = make_state();
+            }
+            XXH3_copyState(_state.get(), o._state.get());
+        }
+        return *this;
+    }
+
+    xxh3_hasher& operator=(xxh3_hasher&&) noexcept = default;
+
+    void update(const char* ptr, size_t length) noexcept {
+        XXH3_128bits_update(_state.get(), ptr, length);
+    }
+
+    std::array<uint8_t, digest_size> finalize_array() {
+        XXH128_canonical_t canonical;
+        XXH128_canonicalFromHash(&canonical, XXH3_128bits_digest(_state.get()));
+        std::array<uint8_t, digest_size> digest;
+        std::memcpy(digest.data(), canonical.digest, digest_size);
+        return digest;
+    }
+
+    uint64_t finalize_uint64() {
+        return XXH3_128bits_digest(_state.get()).low64;
+    }
+};
+
+// An xx_hasher which gathers small updates in a buffer and hashes them
+// together. The digest is the same as the one of xx_hasher fed the same
+// bytes, but hashing many small values, like the cells of a row, takes far
+// fewer calls into xxhash, each of them working on whole stripes.
+class buffered_xx_hasher {
+    static constexpr size_t buffer_size = 256;
+    xx_hasher _hasher;
+    size_t _size = 0;
+    std::array<char, buffer_size> _buffer;
+
+public:
+    explicit buffered_xx_hasher(uint64_t seed = 0) noexcept
+        : _hasher(seed)
+    { }
+
+    void update(const char* ptr, size_t length) noexcept {
+        if (length > buffer_size - _size) {
+            flush();
+            if (length >= buffer_size) {
+                _hasher.update(ptr, length);
+                return;
+            }
+        }
+        std::memcpy(_buffer.data() + _size, ptr, length);
+        _size += length;
+    }
+
+    uint64_t finalize_uint64() noexcept {
+        flush();
+        return _hasher.finalize_uint64();
+    }
+
+private:
+    void flush() noexcept {
+        if (_size) {
+            _hasher.update(_buffer.data(), _size);
+            _size = 0;
+        }
+    }
+};
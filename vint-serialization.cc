@@ -140,6 +140,46 @@ uint64_t unsigned_vint::deserialize(bytes_view v) {
     return result;
 }
 
+std::optional<vint_size_type> unsigned_vint::deserialize_n(bytes_view v, uint64_t* out, size_t n) {
+    auto src = v.data();
+    auto len = v.size();
+    vint_size_type size = 0;
+    while (n) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        // A single-byte vint has its most significant bit clear, and is its own value.
+        // Find how many of the next 8 bytes are such vints with a single load.
+        if (len >= sizeof(uint64_t) && *src >= 0) {
+            uint64_t word;
+            std::copy_n(src, sizeof(uint64_t), reinterpret_cast<int8_t*>(&word));
+            const auto high_bits = word & 0x8080808080808080ull;
+            const auto run = std::min<size_t>(high_bits ? count_trailing_zeros(high_bits) / 8 : sizeof(uint64_t), n);
+            for (size_t i = 0; i < run; ++i) {
+                out[i] = (word >> (i * 8)) & 0xff;
+            }
+            out += run;
+            src += run;
+            len -= run;
+            size += run;
+            n -= run;
+            continue;
+        }
+#endif
+        if (!len) {
+            return std::nullopt;
+        }
+        const auto vint_size = serialized_size_from_first_byte(*src);
+        if (len < vint_size) {
+            return std::nullopt;
+        }
+        *out++ = deserialize(bytes_view(src, len));
+        src += vint_size;
+        len -= vint_size;
+        size += vint_size;
+        --n;
+    }
+    return size;
+}
+
 vint_size_type unsigned_vint::serialized_size_from_first_byte(bytes::value_type first_byte) {
     int8_t first_byte_casted = first_byte;
     return 1 + (first_byte_casted >= 0 ? 0 : count_extra_bytes(first_byte_casted));
@@ -35,6 +35,7 @@
 #include "bytes.hh"
 
 #include <cstdint>
+#include <optional>
 
 using vint_size_type = bytes::size_type;
 
@@ -49,6 +50,13 @@ struct unsigned_vint final {
 
     static value_type deserialize(bytes_view v);
 
+    // Deserializes the n consecutive vints at the front of v into out. Runs of
+    // single-byte vints are decoded 8 at a time.
+    //
+    // Returns the total size of their serialization, or std::nullopt if v doesn't
+    // hold all of them, in which case the contents of out are unspecified.
+    static std::optional<vint_size_type> deserialize_n(bytes_view v, value_type* out, size_t n);
+
     static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
 };
 
@@ -12,21 +12,36 @@
 // which are available only when the library is linked statically.
 #define ZSTD_STATIC_LINKING_ONLY
 #include <zstd.h>
+#include <zdict.h>
 
 #include "compress.hh"
 #include "exceptions/exceptions.hh"
 #include "utils/class_registrator.hh"
 #include "utils/reusable_buffer.hh"
+#include "bytes_ostream.hh"
 #include <concepts>
 
 static const sstring COMPRESSION_LEVEL = "compression_level";
+static const sstring DICTIONARY_SIZE_KB = "dictionary_size_in_kb";
 static const sstring COMPRESSOR_NAME = compressor::namespace_prefix + "ZstdCompressor";
 static const size_t DCTX_SIZE = ZSTD_estimateDCtxSize();
 
 class zstd_processor : public compressor {
     int _compression_level = 3;
+    size_t _dictionary_size = 0;
+    int _chunk_len;
     size_t _cctx_size;
 
+    // Digested forms of a trained dictionary. They reference the dictionary
+    // bytes rather than copying them, and are built on first use since a
+    // given instance is usually only used for either reading or writing.
+    struct dictionary {
+        bytes_view raw;
+        mutable std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> cdict{nullptr, &ZSTD_freeCDict};
+        mutable std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)> ddict{nullptr, &ZSTD_freeDDict};
+    };
+    std::unique_ptr<dictionary> _dictionary;
+
     static auto with_dctx(std::invocable<ZSTD_DCtx*> auto f) {
         // The decompression context has a fixed size of ~128 KiB,
         // so we don't bother ever resizing it the way we do with
@@ -74,6 +89,7 @@ class zstd_processor : public compressor {
 
 public:
     zstd_processor(const opt_getter&);
+    zstd_processor(const zstd_processor&, bytes_view dictionary);
 
     size_t uncompress(const char* input, size_t input_len, char* output,
                     size_t output_len) const override;
@@ -83,6 +99,10 @@ class zstd_processor : public compressor {
 
     std::set<sstring> option_names() const override;
     std::map<sstring, sstring> options() const override;
+
+    size_t dictionary_size() const override;
+    bytes train_dictionary(const std::vector<bytes_view>& samples) const override;
+    ptr_type with_dictionary(bytes_view dictionary) const override;
 };
 
 zstd_processor::zstd_processor(const opt_getter& opts)
@@ -104,23 +124,60 @@ zstd_processor::zstd_processor(const opt_getter& opts)
         }
     }
 
+    auto dict_size_kb = opts(DICTIONARY_SIZE_KB);
+    if (dict_size_kb) {
+        int kb;
+        try {
+            kb = std::stoi(*dict_size_kb);
+        } catch (const std::exception& e) {
+            throw exceptions::syntax_exception(
+                format("Invalid integer value {} for {}", *dict_size_kb, DICTIONARY_SIZE_KB));
+        }
+        if (kb < 0 || kb > 1024) {
+            throw exceptions::configuration_exception(
+                format("{} must be between 0 and 1024, got {}", DICTIONARY_SIZE_KB, kb));
+        }
+        _dictionary_size = size_t(kb) * 1024;
+    }
+
     auto chunk_len_kb = opts(compression_parameters::CHUNK_LENGTH_KB);
     if (!chunk_len_kb) {
         chunk_len_kb = opts(compression_parameters::CHUNK_LENGTH_KB_ERR);
     }
-    auto chunk_len = chunk_len_kb
+    _chunk_len = chunk_len_kb
        // This parameter has already been validated.
        ? std::stoi(*chunk_len_kb) * 1024
        : compression_parameters::DEFAULT_CHUNK_LENGTH;
 
     // We assume that the uncompressed input length is always <= chunk_len.
-    auto cparams = ZSTD_getCParams(_compression_level, chunk_len, 0);
+    auto cparams = ZSTD_getCParams(_compression_level, _chunk_len, 0);
     _cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams);
 
 }
 
+zstd_processor::zstd_processor(const zstd_processor& o, bytes_view dict)
+    : compressor(COMPRESSOR_NAME)
+    , _compression_level(o._compression_level)
+    , _dictionary_size(o._dictionary_size)
+    , _chunk_len(o._chunk_len)
+    , _dictionary(std::make_unique<dictionary>(dict)) {
+    // The parameters zstd picks for a dictionary compression depend on the
+    // dictionary size, so the context has to be sized for them.
+    auto cparams = ZSTD_getCParams(_compression_level, _chunk_len, dict.size());
+    _cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams);
+}
+
 size_t zstd_processor::uncompress(const char* input, size_t input_len, char* output, size_t output_len) const {
     auto ret = with_dctx([&] (ZSTD_DCtx* dctx) {
+        if (_dictionary) {
+            if (!_dictionary->ddict) {
+                _dictionary->ddict.reset(ZSTD_createDDict_byReference(_dictionary->raw.data(), _dictionary->raw.size()));
+                if (!_dictionary->ddict) {
+                    throw std::runtime_error("Unable to create ZSTD decompression dictionary");
+                }
+            }
+            return ZSTD_decompress_usingDDict(dctx, output, output_len, input, input_len, _dictionary->ddict.get());
+        }
         return ZSTD_decompressDCtx(dctx, output, output_len, input, input_len);
     });
     if (ZSTD_isError(ret)) {
@@ -132,6 +189,17 @@ size_t zstd_processor::uncompress(const char* input, size_t input_len, char* out
 
 size_t zstd_processor::compress(const char* input, size_t input_len, char* output, size_t output_len) const {
     auto ret = with_cctx(_cctx_size, [&] (ZSTD_CCtx* cctx) {
+        if (_dictionary) {
+            if (!_dictionary->cdict) {
+                _dictionary->cdict.reset(ZSTD_createCDict_advanced(_dictionary->raw.data(), _dictionary->raw.size(),
+                        ZSTD_dlm_byRef, ZSTD_dct_auto, ZSTD_getCParams(_compression_level, _chunk_len, _dictionary->raw.size()),
+                        ZSTD_defaultCMem));
+                if (!_dictionary->cdict) {
+                    throw std::runtime_error("Unable to create ZSTD compression dictionary");
+                }
+            }
+            return ZSTD_compress_usingCDict(cctx, output, output_len, input, input_len, _dictionary->cdict.get());
+        }
         return ZSTD_compressCCtx(cctx, output, output_len, input, input_len, _compression_level);
     });
     if (ZSTD_isError(ret)) {
@@ -145,11 +213,43 @@ size_t zstd_processor::compress_max_size(size_t input_len) const {
 }
 
 std::set<sstring> zstd_processor::option_names() const {
-    return {COMPRESSION_LEVEL};
+    return {COMPRESSION_LEVEL, DICTIONARY_SIZE_KB};
 }
 
 std::map<sstring, sstring> zstd_processor::options() const {
-    return {{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    std::map<sstring, sstring> opts{{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    if (_dictionary_size) {
+        opts.emplace(DICTIONARY_SIZE_KB, std::to_string(_dictionary_size / 1024));
+    }
+    return opts;
+}
+
+size_t zstd_processor::dictionary_size() const {
+    return _dictionary ? 0 : _dictionary_size;
+}
+
+bytes zstd_processor::train_dictionary(const std::vector<bytes_view>& samples) const {
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    bytes_ostream flat;
+    for (auto& s : samples) {
+        flat.write(s);
+        sizes.push_back(s.size());
+    }
+    auto input = flat.linearize();
+    bytes dict(bytes::initialized_later(), _dictionary_size);
+    auto ret = ZDICT_trainFromBuffer(dict.data(), dict.size(), input.data(), sizes.data(), sizes.size());
+    if (ZDICT_isError(ret)) {
+        // Typically means there wasn't enough (or diverse enough) sample data,
+        // which is not an error for us: we just compress without a dictionary.
+        return bytes();
+    }
+    dict.resize(ret);
+    return dict;
+}
+
+compressor::ptr_type zstd_processor::with_dictionary(bytes_view dict) const {
+    return ::make_shared<zstd_processor>(*this, dict);
 }
 
 static const class_registrator<compressor, zstd_processor, const compressor::opt_getter&>